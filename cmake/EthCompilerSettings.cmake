@@ -155,6 +155,27 @@ if (("${CMAKE_CXX_COMPILER_ID}" MATCHES "GNU") OR ("${CMAKE_CXX_COMPILER_ID}" MA
 			set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -s ALLOW_TABLE_GROWTH=1")
 			# Disable warnings about not being pure asm.js due to memory growth.
 			set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wno-almost-asm")
+			if (SOLJSON_SIMD)
+				# Let the compiler use 128-bit WebAssembly SIMD instructions, also for the vector
+				# extensions used by the multi-buffer Keccak-256.
+				set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -msimd128")
+			endif()
+			if (SOLJSON_THREADS)
+				# Threads are web workers sharing the heap via SharedArrayBuffer. All object files,
+				# including those of the dependencies, have to be compiled with -pthread.
+				set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -pthread")
+				set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -pthread")
+				# A worker can only be started once control returns to the JavaScript event loop,
+				# which never happens during a compilation. The workers are therefore started
+				# on startup and the compiler never uses more threads than this.
+				set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -s PTHREAD_POOL_SIZE=${SOLJSON_THREAD_POOL_SIZE}")
+				# Growing a shared heap makes all memory accesses from JavaScript slower and
+				# has to be synchronized with the workers. Start with a heap that is large enough
+				# for typical projects and grow in large steps.
+				set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -s INITIAL_MEMORY=128MB -s MEMORY_GROWTH_GEOMETRIC_STEP=1.0")
+				# The analysis and code generation recurse deeply, the default stack of workers is too small.
+				set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS} -s DEFAULT_PTHREAD_STACK_SIZE=8MB")
+			endif()
 		endif()
 	endif()
 
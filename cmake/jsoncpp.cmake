@@ -18,6 +18,10 @@ if(EMSCRIPTEN)
     # but only use -std=c++17. Using all flags causes build failures
     # at the moment.
     set(JSONCPP_CXX_FLAGS -std=c++17)
+    # Objects compiled without thread support cannot be linked into a build with shared memory.
+    if(SOLJSON_THREADS)
+        set(JSONCPP_CXX_FLAGS "${JSONCPP_CXX_FLAGS} -pthread")
+    endif()
 else()
     # jsoncpp uses implicit casts for comparing integer and
     # floating point numbers. This causes clang-10 (used by ossfuzz builder)
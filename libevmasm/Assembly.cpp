@@ -28,18 +28,24 @@
 #include <libevmasm/Inliner.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockIndex.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/TailMerger.h>
 
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/ThreadPool.h>
+#include <libsolutil/TraceEvents.h>
+
 #include <json/json.h>
 
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
 #include <fstream>
+#include <functional>
 #include <limits>
 
 using namespace std;
@@ -61,14 +67,22 @@ AssemblyItem const& Assembly::append(AssemblyItem _i)
 
 unsigned Assembly::codeSize(unsigned subTagSize) const
 {
-	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	// The size of an item depends on the tag size only for the items that push
+	// a tag or data offset, which grow linearly with it, so a single pass suffices.
+	size_t sizeWithoutTags = 1;
+	for (auto const& i: m_data)
+		sizeWithoutTags += i.second.size();
+	size_t tagSizedItems = 0;
+	for (AssemblyItem const& i: m_items)
 	{
-		size_t ret = 1;
-		for (auto const& i: m_data)
-			ret += i.second.size();
+		sizeWithoutTags += i.bytesRequired(0, Precision::Approximate);
+		if (i.type() == PushTag || i.type() == PushData || i.type() == PushSub)
+			++tagSizedItems;
+	}
 
-		for (AssemblyItem const& i: m_items)
-			ret += i.bytesRequired(tagSize, Precision::Approximate);
+	for (unsigned tagSize = subTagSize; true; ++tagSize)
+	{
+		size_t ret = sizeWithoutTags + tagSizedItems * tagSize;
 		if (numberEncodingSize(ret) <= tagSize)
 			return static_cast<unsigned>(ret);
 	}
@@ -347,18 +361,34 @@ map<u256, u256> const& Assembly::optimiseInternal(
 	if (m_tagReplacements)
 		return *m_tagReplacements;
 
-	// Run optimisation for sub-assemblies.
+	util::TraceSpan span("evmasmOptimization", "evmasm", {{"assembly", m_name}});
+	optimiseSubAssemblies(_settings);
+
+	// The block index is shared by the passes below and only rebuilt after a pass changed the items.
+	optional<BlockIndex> blockIndex;
+	auto currentBlockIndex = [&]() -> BlockIndex const& {
+		if (!blockIndex)
+			blockIndex.emplace(m_items);
+		return *blockIndex;
+	};
+
+	// Collect the results of the optimisation of sub-assemblies.
+	// Applying the replacements of one sub-assembly does not change the tags referenced in the others.
+	bool subTagsReplaced = false;
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
 	{
 		OptimiserSettings settings = _settings;
 		Assembly& sub = *m_subs[subId];
 		map<u256, u256> const& subTagReplacements = sub.optimiseInternal(
 			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
+			currentBlockIndex().referencedTags(subId)
 		);
 		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
+		if (BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId))
+			subTagsReplaced = true;
 	}
+	if (subTagsReplaced)
+		blockIndex.reset();
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -367,26 +397,44 @@ map<u256, u256> const& Assembly::optimiseInternal(
 		count = 0;
 
 		if (_settings.runInliner)
-			Inliner{
+		{
+			// The size limit applies to the deployed code, i.e. to the assemblies that are not creation code.
+			optional<size_t> codeSizeBudget;
+			if (_settings.inlinerSizeLimit && !isCreation())
+			{
+				size_t size = codeSize(1);
+				codeSizeBudget = *_settings.inlinerSizeLimit > size ? *_settings.inlinerSizeLimit - size : 0;
+			}
+			if (Inliner{
 				m_items,
 				_tagsReferencedFromOutside,
 				_settings.expectedExecutionsPerDeployment,
 				isCreation(),
-				_settings.evmVersion
-			}.optimise();
+				_settings.evmVersion,
+				codeSizeBudget
+			}.optimise(currentBlockIndex()))
+				blockIndex.reset();
+		}
 
 		if (_settings.runJumpdestRemover)
 		{
 			JumpdestRemover jumpdestOpt{m_items};
-			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
+			if (jumpdestOpt.optimise(_tagsReferencedFromOutside, currentBlockIndex()))
+			{
+				blockIndex.reset();
 				count++;
+			}
 		}
 
 		if (_settings.runPeephole)
 		{
-			PeepholeOptimiser peepOpt{m_items};
+			PeepholeOptimiser peepOpt{
+				m_items,
+				_settings.recordStatistics ? &m_optimiserStatistics["PeepholeOptimiser"] : nullptr
+			};
 			while (peepOpt.optimise())
 			{
+				blockIndex.reset();
 				count++;
 				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
 			}
@@ -414,6 +462,23 @@ map<u256, u256> const& Assembly::optimiseInternal(
 					if (_tagsReferencedFromOutside.erase(static_cast<size_t>(replacement.first)))
 						_tagsReferencedFromOutside.insert(static_cast<size_t>(replacement.second));
 				}
+				blockIndex.reset();
+				count++;
+			}
+		}
+
+		if (_settings.runTailMerger)
+		{
+			TailMerger tailMerger{
+				m_items,
+				[this]() { return newTag(); },
+				_settings.expectedExecutionsPerDeployment,
+				isCreation(),
+				_settings.evmVersion
+			};
+			if (tailMerger.optimise())
+			{
+				blockIndex.reset();
 				count++;
 			}
 		}
@@ -433,6 +498,10 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			while (iter != m_items.end())
 			{
 				KnownState emptyState;
+				// Rules applied to chunks whose optimised code is discarded are not counted.
+				map<string, size_t> ruleApplications;
+				if (_settings.recordStatistics)
+					emptyState.expressionClasses().countRuleApplications(&ruleApplications);
 				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
@@ -458,6 +527,8 @@ map<u256, u256> const& Assembly::optimiseInternal(
 				{
 					count++;
 					optimisedItems += optimisedChunk;
+					for (auto const& [rule, applications]: ruleApplications)
+						m_optimiserStatistics["CommonSubexpressionEliminator"][rule] += applications;
 				}
 				else
 					copy(orig, iter, back_inserter(optimisedItems));
@@ -465,6 +536,7 @@ map<u256, u256> const& Assembly::optimiseInternal(
 			if (optimisedItems.size() < m_items.size())
 			{
 				m_items = std::move(optimisedItems);
+				blockIndex.reset();
 				count++;
 			}
 		}
@@ -482,6 +554,203 @@ map<u256, u256> const& Assembly::optimiseInternal(
 	return *m_tagReplacements;
 }
 
+void Assembly::optimiseSubAssemblies(OptimiserSettings const& _settings)
+{
+	struct PendingAssembly
+	{
+		Assembly* assembly;
+		set<size_t> tagsReferencedFromOutside;
+		/// One more than the largest height of a pending sub-assembly.
+		size_t height;
+	};
+	vector<PendingAssembly> pending;
+	map<Assembly const*, size_t> pendingIndices;
+
+	// Visits the assemblies in the order in which optimiseInternal would reach them, so that
+	// an assembly with multiple super-assemblies gets the tags referenced by the same one.
+	// Note that the tags referenced by a super-assembly do not change while its sub-assemblies
+	// are optimised.
+	// @returns the height of the assembly, which is zero if it does not need to be optimised.
+	function<size_t(Assembly&, set<size_t>)> visit = [&](Assembly& _assembly, set<size_t> _tagsReferencedFromOutside)
+	{
+		if (_assembly.m_tagReplacements)
+			return size_t(0);
+		if (auto it = pendingIndices.find(&_assembly); it != pendingIndices.end())
+			return pending[it->second].height;
+		size_t index = pending.size();
+		pendingIndices[&_assembly] = index;
+		pending.push_back({&_assembly, std::move(_tagsReferencedFromOutside), 0});
+		size_t height = 1;
+		BlockIndex blockIndex{_assembly.m_items};
+		for (size_t subId = 0; subId < _assembly.m_subs.size(); ++subId)
+			height = max(
+				height,
+				visit(*_assembly.m_subs[subId], blockIndex.referencedTags(subId)) + 1
+			);
+		pending[index].height = height;
+		return height;
+	};
+
+	size_t maxHeight = 0;
+	BlockIndex blockIndex{m_items};
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		maxHeight = max(maxHeight, visit(*m_subs[subId], blockIndex.referencedTags(subId)));
+
+	// Assemblies of the same height do not depend on each other.
+	for (size_t height = 1; height <= maxHeight; ++height)
+	{
+		vector<PendingAssembly*> batch;
+		for (PendingAssembly& pendingAssembly: pending)
+			if (pendingAssembly.height == height)
+				batch.push_back(&pendingAssembly);
+		util::ThreadPool::instance().parallelFor(batch.size(), [&](size_t _index) {
+			batch[_index]->assembly->optimiseInternal(_settings, std::move(batch[_index]->tagsReferencedFromOutside));
+		});
+	}
+}
+
+namespace
+{
+
+/// Code of an AssignImmutable together with the gas it consumes, not counting the costs of
+/// memory expansion, which are the same for all ways to assign an immutable.
+struct ImmutableAssignmentCode
+{
+	bytes code;
+	size_t opcodeCount = 0;
+	bigint executionGas = 0;
+
+	void append(Instruction _instruction, size_t _executions, EVMVersion _evmVersion)
+	{
+		code.push_back(static_cast<uint8_t>(_instruction));
+		++opcodeCount;
+		executionGas += bigint(GasMeter::runGas(_instruction, _evmVersion)) * _executions;
+	}
+	void appendPush(u256 const& _value, size_t _executions, EVMVersion _evmVersion)
+	{
+		bytes data = toCompactBigEndian(_value, 1);
+		append(pushInstruction(static_cast<unsigned>(data.size())), _executions, _evmVersion);
+		code += data;
+	}
+	void append(ImmutableAssignmentCode const& _other)
+	{
+		code += _other.code;
+		opcodeCount += _other.opcodeCount;
+		executionGas += _other.executionGas;
+	}
+	/// @returns the deployment costs of the code, as part of the creation transaction, plus its execution costs.
+	bigint cost(EVMVersion _evmVersion) const
+	{
+		return bigint(GasMeter::dataGas(code, true, _evmVersion)) + executionGas;
+	}
+};
+
+/// @returns the code that stores the value below the offset of the runtime code in memory, which
+/// is on top of the stack, at each of @a _offsets relative to that memory offset. The code consumes both values.
+/// Without EOF, groups of offsets may be written in a loop that extracts them from a single packed
+/// word, which is cheaper to deploy than a separate store for each of them once an immutable is
+/// referenced often enough. Whichever variant is cheaper is chosen for every group.
+ImmutableAssignmentCode immutableAssignmentCode(
+	vector<size_t> const& _offsets,
+	EVMVersion _evmVersion,
+	optional<uint8_t> _eofVersion
+)
+{
+	ImmutableAssignmentCode result;
+	if (_offsets.empty())
+	{
+		result.append(Instruction::POP, 1, _evmVersion);
+		result.append(Instruction::POP, 1, _evmVersion);
+		return result;
+	}
+
+	unsigned offsetSize = 1;
+	for (size_t offset: _offsets)
+	{
+		// The loop stops at the first zero offset, but immutables are never referenced at offset zero.
+		solAssert(offset > 0, "");
+		offsetSize = max(offsetSize, numberEncodingSize(offset));
+	}
+	size_t const groupSize = _eofVersion.has_value() ? _offsets.size() : 32 / offsetSize;
+
+	for (size_t groupStart = 0; groupStart < _offsets.size(); groupStart += groupSize)
+	{
+		size_t const groupEnd = min(groupStart + groupSize, _offsets.size());
+		bool const lastGroup = groupEnd == _offsets.size();
+
+		// (DUP2 DUP2 PUSH <offset> ADD MSTORE)* (PUSH <offset> ADD MSTORE) for the last group.
+		ImmutableAssignmentCode unrolled;
+		for (size_t index = groupStart; index < groupEnd; ++index)
+		{
+			if (!lastGroup || index + 1 != groupEnd)
+			{
+				unrolled.append(Instruction::DUP2, 1, _evmVersion);
+				unrolled.append(Instruction::DUP2, 1, _evmVersion);
+			}
+			// TODO: should we make use of the constant optimizer methods for pushing the offsets?
+			unrolled.appendPush(_offsets[index], 1, _evmVersion);
+			unrolled.append(Instruction::ADD, 1, _evmVersion);
+			unrolled.append(Instruction::MSTORE, 1, _evmVersion);
+		}
+		if (_eofVersion.has_value() || groupEnd - groupStart < 2)
+		{
+			result.append(unrolled);
+			continue;
+		}
+
+		// The offsets of the group, packed into a single word with the first one in the lowest bits.
+		u256 packedOffsets = 0;
+		for (size_t index = groupEnd; index > groupStart; --index)
+			packedOffsets = (packedOffsets << (8 * offsetSize)) | u256(_offsets[index - 1]);
+		size_t const iterations = groupEnd - groupStart;
+
+		// Stack: value codeOffset [value codeOffset] loopStart packedOffsets
+		ImmutableAssignmentCode loop;
+		if (!lastGroup)
+		{
+			loop.append(Instruction::DUP2, 1, _evmVersion);
+			loop.append(Instruction::DUP2, 1, _evmVersion);
+		}
+		// PC PUSH1 <distance to the JUMPDEST> ADD PUSH <packedOffsets> JUMPDEST
+		loop.append(Instruction::PC, 1, _evmVersion);
+		loop.appendPush(5 + numberEncodingSize(packedOffsets), 1, _evmVersion);
+		loop.append(Instruction::ADD, 1, _evmVersion);
+		loop.appendPush(packedOffsets, 1, _evmVersion);
+		loop.append(Instruction::JUMPDEST, iterations, _evmVersion);
+		// DUP4 DUP2 PUSH <mask> AND DUP5 ADD MSTORE
+		loop.append(Instruction::DUP4, iterations, _evmVersion);
+		loop.append(Instruction::DUP2, iterations, _evmVersion);
+		loop.appendPush((u256(1) << (8 * offsetSize)) - 1, iterations, _evmVersion);
+		loop.append(Instruction::AND, iterations, _evmVersion);
+		loop.append(Instruction::DUP5, iterations, _evmVersion);
+		loop.append(Instruction::ADD, iterations, _evmVersion);
+		loop.append(Instruction::MSTORE, iterations, _evmVersion);
+		// Drop the offset that was just written.
+		if (_evmVersion.hasBitwiseShifting())
+		{
+			loop.appendPush(8 * offsetSize, iterations, _evmVersion);
+			loop.append(Instruction::SHR, iterations, _evmVersion);
+		}
+		else
+		{
+			loop.appendPush(u256(1) << (8 * offsetSize), iterations, _evmVersion);
+			loop.append(Instruction::SWAP1, iterations, _evmVersion);
+			loop.append(Instruction::DIV, iterations, _evmVersion);
+		}
+		// DUP1 DUP3 JUMPI POP POP POP POP
+		loop.append(Instruction::DUP1, iterations, _evmVersion);
+		loop.append(Instruction::DUP3, iterations, _evmVersion);
+		loop.append(Instruction::JUMPI, iterations, _evmVersion);
+		for (size_t i = 0; i < 4; ++i)
+			loop.append(Instruction::POP, 1, _evmVersion);
+
+		result.append(loop.cost(_evmVersion) < unrolled.cost(_evmVersion) ? loop : unrolled);
+	}
+	return result;
+}
+
+}
+
 LinkerObject const& Assembly::assemble() const
 {
 	assertThrow(!m_invalid, AssemblyException, "Attempted to assemble invalid Assembly object.");
@@ -518,7 +787,12 @@ LinkerObject const& Assembly::assemble() const
 	for (auto const& i: m_items)
 		if (i.type() == AssignImmutable)
 		{
-			i.setImmutableOccurrences(immutableReferencesBySub[i.data()].second.size());
+			ImmutableAssignmentCode assignment = immutableAssignmentCode(
+				immutableReferencesBySub[i.data()].second,
+				m_evmVersion,
+				m_eofVersion
+			);
+			i.setImmutableAssignmentSize(assignment.code.size(), assignment.opcodeCount);
 			setsImmutables = true;
 		}
 		else if (i.type() == PushImmutable)
@@ -547,8 +821,40 @@ LinkerObject const& Assembly::assemble() const
 	uint8_t dataRefPush = static_cast<uint8_t>(pushInstruction(bytesPerDataRef));
 	ret.bytecode.reserve(bytesRequiredIncludingData);
 
-	for (AssemblyItem const& i: m_items)
+	// With EOF, jumps to a tag pushed right before them are encoded as relative jumps, whose signed
+	// 16 bit offsets can reach everywhere as long as the code is small enough. Tags that are only
+	// targeted by relative jumps do not need a JUMPDEST.
+	bool const useRelativeJumps =
+		m_eofVersion.has_value() &&
+		bytesRequiredForCode <= static_cast<unsigned>(numeric_limits<int16_t>::max());
+	auto isStaticJump = [&](size_t _index) {
+		return
+			m_items[_index].type() == PushTag &&
+			m_items[_index].splitForeignPushTag().first == numeric_limits<size_t>::max() &&
+			_index + 1 < m_items.size() &&
+			(m_items[_index + 1] == Instruction::JUMP || m_items[_index + 1] == Instruction::JUMPI);
+	};
+	set<size_t> dynamicJumpTargets;
+	if (useRelativeJumps)
+		for (size_t index = 0; index < m_items.size(); ++index)
+			if (m_items[index].type() == PushTag)
+			{
+				assertThrow(
+					m_items[index].splitForeignPushTag().first == numeric_limits<size_t>::max(),
+					AssemblyException,
+					"Tags of other assemblies cannot be referenced with EOF."
+				);
+				if (isStaticJump(index))
+					++index;
+				else
+					dynamicJumpTargets.insert(static_cast<size_t>(m_items[index].data()));
+			}
+	/// Positions of the immediates of relative jumps and the tags they jump to.
+	map<size_t, size_t> relativeTagRef;
+
+	for (size_t index = 0; index < m_items.size(); ++index)
 	{
+		AssemblyItem const& i = m_items[index];
 		// store position of the invalid jump destination
 		if (i.type() != Tag && m_tagPositionsInBytecode[0] == numeric_limits<size_t>::max())
 			m_tagPositionsInBytecode[0] = ret.bytecode.size();
@@ -569,6 +875,17 @@ LinkerObject const& Assembly::assemble() const
 		}
 		case PushTag:
 		{
+			if (useRelativeJumps && isStaticJump(index))
+			{
+				// The relative jump replaces both the tag and the jump.
+				++index;
+				ret.bytecode.push_back(static_cast<uint8_t>(
+					m_items[index] == Instruction::JUMP ? Instruction::RJUMP : Instruction::RJUMPI
+				));
+				relativeTagRef[ret.bytecode.size()] = static_cast<size_t>(i.data());
+				ret.bytecode.resize(ret.bytecode.size() + 2);
+				break;
+			}
 			ret.bytecode.push_back(tagPush);
 			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
@@ -624,26 +941,11 @@ LinkerObject const& Assembly::assemble() const
 		case AssignImmutable:
 		{
 			// Expect 2 elements on stack (source, dest_base)
-			auto const& offsets = immutableReferencesBySub[i.data()].second;
-			for (size_t i = 0; i < offsets.size(); ++i)
-			{
-				if (i != offsets.size() - 1)
-				{
-					ret.bytecode.push_back(uint8_t(Instruction::DUP2));
-					ret.bytecode.push_back(uint8_t(Instruction::DUP2));
-				}
-				// TODO: should we make use of the constant optimizer methods for pushing the offsets?
-				bytes offsetBytes = toCompactBigEndian(u256(offsets[i]));
-				ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(static_cast<unsigned>(offsetBytes.size()))));
-				ret.bytecode += offsetBytes;
-				ret.bytecode.push_back(uint8_t(Instruction::ADD));
-				ret.bytecode.push_back(uint8_t(Instruction::MSTORE));
-			}
-			if (offsets.empty())
-			{
-				ret.bytecode.push_back(uint8_t(Instruction::POP));
-				ret.bytecode.push_back(uint8_t(Instruction::POP));
-			}
+			ret.bytecode += immutableAssignmentCode(
+				immutableReferencesBySub[i.data()].second,
+				m_evmVersion,
+				m_eofVersion
+			).code;
 			immutableReferencesBySub.erase(i.data());
 			break;
 		}
@@ -659,7 +961,8 @@ LinkerObject const& Assembly::assemble() const
 			assertThrow(ret.bytecode.size() < 0xffffffffL, AssemblyException, "Tag too large.");
 			assertThrow(m_tagPositionsInBytecode[tagId] == numeric_limits<size_t>::max(), AssemblyException, "Duplicate tag position.");
 			m_tagPositionsInBytecode[tagId] = ret.bytecode.size();
-			ret.bytecode.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
+			if (!useRelativeJumps || dynamicJumpTargets.count(tagId))
+				ret.bytecode.push_back(static_cast<uint8_t>(Instruction::JUMPDEST));
 			break;
 		}
 		default:
@@ -703,16 +1006,34 @@ LinkerObject const& Assembly::assemble() const
 		bytesRef r(ret.bytecode.data() + i.first, bytesPerTag);
 		toBigEndian(pos, r);
 	}
+	for (auto const& [immediatePosition, tagId]: relativeTagRef)
+	{
+		assertThrow(tagId < m_tagPositionsInBytecode.size(), AssemblyException, "Reference to non-existing tag.");
+		size_t pos = m_tagPositionsInBytecode[tagId];
+		assertThrow(pos != numeric_limits<size_t>::max(), AssemblyException, "Reference to tag without position.");
+		// The offset is relative to the end of the immediate.
+		auto offset = static_cast<int64_t>(pos) - static_cast<int64_t>(immediatePosition + 2);
+		assertThrow(
+			numeric_limits<int16_t>::min() <= offset && offset <= numeric_limits<int16_t>::max(),
+			AssemblyException,
+			"Relative jump out of range."
+		);
+		auto encodedOffset = static_cast<uint16_t>(static_cast<int16_t>(offset));
+		ret.bytecode[immediatePosition] = static_cast<uint8_t>(encodedOffset >> 8);
+		ret.bytecode[immediatePosition + 1] = static_cast<uint8_t>(encodedOffset & 0xff);
+	}
+	// Index of the first occurrence of each tag among the items.
+	map<size_t, size_t> tagIndices;
+	if (!m_namedTags.empty())
+		for (auto&& [index, item]: m_items | ranges::views::enumerate)
+			if (item.type() == Tag)
+				tagIndices.emplace(static_cast<size_t>(item.data()), index);
 	for (auto const& [name, tagInfo]: m_namedTags)
 	{
 		size_t position = m_tagPositionsInBytecode.at(tagInfo.id);
 		optional<size_t> tagIndex;
-		for (auto&& [index, item]: m_items | ranges::views::enumerate)
-			if (item.type() == Tag && static_cast<size_t>(item.data()) == tagInfo.id)
-			{
-				tagIndex = index;
-				break;
-			}
+		if (size_t const* index = valueOrNullptr(tagIndices, tagInfo.id))
+			tagIndex = *index;
 		ret.functionDebugData[name] = {
 			position == numeric_limits<size_t>::max() ? nullopt : optional<size_t>{position},
 			tagIndex,
@@ -796,14 +1117,16 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, false, _evmVersion, 0, std::nullopt};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
 	asmSettings.runDeduplicate = _settings.runDeduplicate;
 	asmSettings.runCSE = _settings.runCSE;
 	asmSettings.runConstantOptimiser = _settings.runConstantOptimiser;
+	asmSettings.runTailMerger = _settings.runTailMerger;
 	asmSettings.expectedExecutionsPerDeployment = _settings.expectedExecutionsPerDeployment;
+	asmSettings.inlinerSizeLimit = _settings.inlinerSizeLimit;
 	asmSettings.evmVersion = _evmVersion;
 	return asmSettings;
 }
@@ -39,6 +39,7 @@
 #include <sstream>
 #include <memory>
 #include <map>
+#include <optional>
 #include <utility>
 
 namespace solidity::evmasm
@@ -49,7 +50,12 @@ using AssemblyPointer = std::shared_ptr<Assembly>;
 class Assembly
 {
 public:
-	Assembly(langutil::EVMVersion _evmVersion, bool _creation, std::string _name): m_evmVersion(_evmVersion), m_creation(_creation), m_name(std::move(_name)) { }
+	Assembly(langutil::EVMVersion _evmVersion, bool _creation, std::optional<uint8_t> _eofVersion, std::string _name):
+		m_evmVersion(_evmVersion),
+		m_creation(_creation),
+		m_eofVersion(_eofVersion),
+		m_name(std::move(_name))
+	{}
 
 	AssemblyItem newTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(Tag, m_usedTags++); }
 	AssemblyItem newPushTag() { assertThrow(m_usedTags < 0xffffffff, AssemblyException, ""); return AssemblyItem(PushTag, m_usedTags++); }
@@ -113,6 +119,7 @@ public:
 	void setSourceLocation(langutil::SourceLocation const& _location) { m_currentSourceLocation = _location; }
 	langutil::SourceLocation const& currentSourceLocation() const { return m_currentSourceLocation; }
 	langutil::EVMVersion const& evmVersion() const { return m_evmVersion; }
+	std::optional<uint8_t> eofVersion() const { return m_eofVersion; }
 
 	/// Assembles the assembly into bytecode. The assembly should not be modified after this call, since the assembled version is cached.
 	LinkerObject const& assemble() const;
@@ -125,10 +132,16 @@ public:
 		bool runDeduplicate = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
+		bool runTailMerger = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Size in bytes that inlining should not make the code of a non-creation assembly exceed.
+		std::optional<size_t> inlinerSizeLimit;
+		/// Count the applications of the peephole optimiser methods and of the simplification
+		/// rules, see @a optimiserStatistics.
+		bool recordStatistics = false;
 
 		static OptimiserSettings translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion);
 	};
@@ -136,6 +149,10 @@ public:
 	/// Modify and return the current assembly such that creation and execution gas usage
 	/// is optimised according to the settings in @a _settings.
 	Assembly& optimise(OptimiserSettings const& _settings);
+	/// @returns the number of applications of the optimisations while optimising this assembly,
+	/// not including its sub-assemblies, indexed by the optimiser component and the name of the
+	/// optimisation. Only recorded if requested in the optimiser settings.
+	std::map<std::string, std::map<std::string, size_t>> const& optimiserStatistics() const { return m_optimiserStatistics; }
 
 	/// Create a text representation of the assembly.
 	std::string assemblyString(
@@ -168,6 +185,10 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// Runs optimiseInternal on all sub-assemblies (transitively) that have not been optimised yet.
+	/// Sub-assemblies that do not depend on each other are optimised in parallel. The result is the
+	/// same as when optimising them recursively, in order.
+	void optimiseSubAssemblies(OptimiserSettings const& _settings);
 
 	unsigned codeSize(unsigned subTagSize) const;
 
@@ -205,6 +226,7 @@ protected:
 	/// Contains the tag replacements relevant for super-assemblies.
 	/// If set, it means the optimizer has run and we will not run it again.
 	std::optional<std::map<u256, u256>> m_tagReplacements;
+	std::map<std::string, std::map<std::string, size_t>> m_optimiserStatistics;
 
 	mutable LinkerObject m_assembledObject;
 	mutable std::vector<size_t> m_tagPositionsInBytecode;
@@ -214,6 +236,8 @@ protected:
 	int m_deposit = 0;
 	/// True, if the assembly contains contract creation code.
 	bool const m_creation = false;
+	/// The EOF version to target or nullopt for legacy bytecode. Only affects the encoding of jumps so far.
+	std::optional<uint8_t> m_eofVersion;
 	/// Internal name of the assembly object, only used with the Yul backend
 	/// currently
 	std::string m_name;
@@ -27,8 +27,11 @@
 #include <libsolutil/FixedHash.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
+#include <charconv>
 #include <fstream>
 #include <limits>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -49,6 +52,19 @@ string toStringInHex(u256 _value)
 
 }
 
+shared_ptr<u256 const> AssemblyItem::sharedData(u256 const& _data)
+{
+	static array<shared_ptr<u256 const>, 0x100> const smallValues = []() {
+		array<shared_ptr<u256 const>, 0x100> values;
+		for (size_t i = 0; i < values.size(); ++i)
+			values[i] = make_shared<u256 const>(i);
+		return values;
+	}();
+	if (_data < smallValues.size())
+		return smallValues[static_cast<size_t>(_data)];
+	return make_shared<u256 const>(_data);
+}
+
 AssemblyItem AssemblyItem::toSubAssemblyTag(size_t _subId) const
 {
 	assertThrow(data() < (u256(1) << 64), util::Exception, "Tag already has subassembly set.");
@@ -138,25 +154,12 @@ size_t AssemblyItem::bytesRequired(size_t _addressLength, Precision _precision)
 	case PushImmutable:
 		return 1 + 32;
 	case AssignImmutable:
-	{
-		unsigned long immutableOccurrences = 0;
-
 		// Skip exact immutables count if no precise count was requested
 		if (_precision == Precision::Approximate)
-			immutableOccurrences = 1; // Assume one immut. ref.
-		else
-		{
-			solAssert(m_immutableOccurrences, "No immutable references. `bytesRequired()` called before assembly()?");
-			immutableOccurrences = m_immutableOccurrences.value();
-		}
-
-		if (immutableOccurrences != 0)
-			// (DUP DUP PUSH <n> ADD MSTORE)* (PUSH <n> ADD MSTORE)
-			return (immutableOccurrences - 1) * (5 + 32) + (3 + 32);
-		else
-			// POP POP
-			return 2;
-	}
+			// Assume one immutable reference: PUSH <n> ADD MSTORE
+			return 3 + 32;
+		solAssert(m_immutableAssignmentSize, "No immutable references. `bytesRequired()` called before assembly()?");
+		return m_immutableAssignmentSize->first;
 	case VerbatimBytecode:
 		return std::get<2>(*m_verbatimBytecode).size();
 	default:
@@ -396,16 +399,10 @@ size_t AssemblyItem::opcodeCount() const noexcept
 	switch (m_type)
 	{
 		case AssemblyItemType::AssignImmutable:
-			// Append empty items if this AssignImmutable was referenced more than once.
-			// For n immutable occurrences the first (n - 1) occurrences will
-			// generate 5 opcodes and the last will generate 3 opcodes,
-			// because it is reusing the 2 top-most elements on the stack.
-			solAssert(m_immutableOccurrences, "");
-
-			if (m_immutableOccurrences.value() != 0)
-				return (*m_immutableOccurrences - 1) * 5 + 3;
-			else
-				return 2; // two POP's
+			// Append empty items if this AssignImmutable was assembled to more than one opcode,
+			// which depends on the number of references to the immutable.
+			solAssert(m_immutableAssignmentSize, "");
+			return m_immutableAssignmentSize->second;
 		default:
 			return 1;
 	}
@@ -417,24 +414,39 @@ std::string AssemblyItem::computeSourceMapping(
 )
 {
 	string ret;
+	// Most items repeat the location of the previous one and only add a separator.
+	ret.reserve(2 * _items.size());
+	auto const appendInt = [&](int _value) {
+		array<char, 16> buffer;
+		auto const result = to_chars(buffer.data(), buffer.data() + buffer.size(), _value);
+		solAssert(result.ec == errc{});
+		ret.append(buffer.data(), result.ptr);
+	};
 
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Source names are interned, so their indices can be cached by address.
+	unordered_map<string const*, int> sourceIndices;
 
 	for (auto const& item: _items)
 	{
 		if (!ret.empty())
-			ret += ";";
+			ret += ';';
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			(location.sourceName && _sourceIndicesMap.count(*location.sourceName)) ?
-			static_cast<int>(_sourceIndicesMap.at(*location.sourceName)) :
-			-1;
+		int sourceIndex = -1;
+		if (location.sourceName)
+		{
+			auto [it, inserted] = sourceIndices.try_emplace(location.sourceName, -1);
+			if (inserted)
+				if (auto index = _sourceIndicesMap.find(*location.sourceName); index != _sourceIndicesMap.end())
+					it->second = static_cast<int>(index->second);
+			sourceIndex = it->second;
+		}
 		char jump = '-';
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
@@ -465,17 +477,17 @@ std::string AssemblyItem::computeSourceMapping(
 		if (components-- > 0)
 		{
 			if (location.start != prevStart)
-				ret += to_string(location.start);
+				appendInt(location.start);
 			if (components-- > 0)
 			{
 				ret += ':';
 				if (length != prevLength)
-					ret += to_string(length);
+					appendInt(length);
 				if (components-- > 0)
 				{
 					ret += ':';
 					if (sourceIndex != prevSourceIndex)
-						ret += to_string(sourceIndex);
+						appendInt(sourceIndex);
 					if (components-- > 0)
 					{
 						ret += ':';
@@ -485,7 +497,7 @@ std::string AssemblyItem::computeSourceMapping(
 						{
 							ret += ':';
 							if (modifierDepth != prevModifierDepth)
-								ret += to_string(modifierDepth);
+								appendInt(modifierDepth);
 						}
 					}
 				}
@@ -493,7 +505,7 @@ std::string AssemblyItem::computeSourceMapping(
 		}
 
 		if (item.opcodeCount() > 1)
-			ret += string(item.opcodeCount() - 1, ';');
+			ret.append(item.opcodeCount() - 1, ';');
 
 		prevStart = location.start;
 		prevLength = length;
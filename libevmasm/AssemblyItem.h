@@ -78,12 +78,12 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			m_data = sharedData(_data);
 	}
 	explicit AssemblyItem(bytes _verbatimData, size_t _arguments, size_t _returnVariables):
 		m_type(VerbatimBytecode),
 		m_instruction{},
-		m_verbatimBytecode{{_arguments, _returnVariables, std::move(_verbatimData)}}
+		m_verbatimBytecode{std::make_shared<VerbatimBytecodeInfo const>(_arguments, _returnVariables, std::move(_verbatimData))}
 	{}
 
 	AssemblyItem(AssemblyItem const&) = default;
@@ -104,7 +104,7 @@ public:
 
 	AssemblyItemType type() const { return m_type; }
 	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = sharedData(_data); }
 
 	/// This function is used in `Assembly::assemblyJSON`.
 	/// It returns the name & data of the current assembly item.
@@ -184,24 +184,34 @@ public:
 
 	size_t m_modifierDepth = 0;
 
-	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
+	/// Sets the size in bytes and the number of opcodes of the code assembled for an AssignImmutable.
+	void setImmutableAssignmentSize(size_t _bytes, size_t _opcodes) const { m_immutableAssignmentSize = std::make_pair(_bytes, _opcodes); }
 
 private:
+	/// Number of arguments, number of return variables and the verbatim bytecode.
+	using VerbatimBytecodeInfo = std::tuple<size_t, size_t, bytes>;
+
 	size_t opcodeCount() const noexcept;
 
+	/// @returns a pointer to a copy of @a _data. Small values, which are used most often,
+	/// are shared between all items instead of being allocated for every item.
+	static std::shared_ptr<u256 const> sharedData(u256 const& _data);
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	/// If m_type == VerbatimBytecode, this holds number of arguments, number of
-	/// return variables and verbatim bytecode.
-	std::optional<std::tuple<size_t, size_t, bytes>> m_verbatimBytecode;
-	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
+	/// Only valid if m_type != Operation. Items are copied often, so the value is never
+	/// modified in place but shared between copies.
+	std::shared_ptr<u256 const> m_data;
+	/// Only set if m_type == VerbatimBytecode, shared between copies.
+	std::shared_ptr<VerbatimBytecodeInfo const> m_verbatimBytecode;
+	langutil::SourceLocation m_location;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
 	mutable std::shared_ptr<u256> m_pushedValue;
-	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
-	mutable std::optional<size_t> m_immutableOccurrences;
+	/// Size in bytes and number of opcodes of the code of an AssignImmutable, which depends on the
+	/// PushImmutable's with the same hash. Only used for AssignImmutable.
+	mutable std::optional<std::pair<size_t, size_t>> m_immutableAssignmentSize;
 };
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength,  Precision _precision = Precision::Precise)
@@ -27,8 +27,10 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
-#include <functional>
-#include <set>
+#include <boost/container_hash/hash.hpp>
+
+#include <algorithm>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
@@ -37,8 +39,8 @@ using namespace solidity::evmasm;
 
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
-	// opcodes that stop the control flow.
+	// Compares blocks starting at tags based on the suffix that starts there, ignoring tags
+	// and stopping at opcodes that stop the control flow.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
 	// We abort if this virtual tag actually exists.
@@ -49,46 +51,39 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	auto equalBlocks = [&](size_t _i, size_t _j)
 	{
-		if (_i == _j)
-			return false;
-
 		// To compare recursive loops, we have to already unify PushTag opcodes of the
 		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
+		AssemblyItem pushFirstTag = m_items.at(_i).pushTag();
+		AssemblyItem pushSecondTag = m_items.at(_j).pushTag();
 
 		using diff_type = BlockIterator::difference_type;
 		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
 		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
 		BlockIterator end{m_items.end(), m_items.end()};
 
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
+		// Skip the tags themselves.
+		++first;
+		++second;
 
-		return std::lexicographical_compare(first, end, second, end);
+		return std::equal(first, end, second, end);
 	};
 
 	size_t iterations = 0;
 	for (; ; ++iterations)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
+		vector<size_t> hashes = suffixHashes();
+		// Blocks that are not equal to any previous block, bucketed by their hash.
+		unordered_map<size_t, vector<size_t>> blocksSeen;
 		for (size_t i = 0; i < m_items.size(); ++i)
 		{
 			if (m_items.at(i).type() != Tag)
 				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& candidates = blocksSeen[hashes[i]];
+			auto it = find_if(candidates.begin(), candidates.end(), [&](size_t _j) { return equalBlocks(_j, i); });
+			if (it == candidates.end())
+				candidates.push_back(i);
 			else
 				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
 		}
@@ -99,6 +94,30 @@ bool BlockDeduplicator::deduplicate()
 	return iterations > 0;
 }
 
+vector<size_t> BlockDeduplicator::suffixHashes() const
+{
+	vector<size_t> hashes(m_items.size() + 1, 0);
+	for (size_t i = m_items.size(); i-- > 0;)
+	{
+		AssemblyItem const& item = m_items[i];
+		if (item.type() == Tag)
+		{
+			hashes[i] = hashes[i + 1];
+			continue;
+		}
+		size_t hash = 0;
+		boost::hash_combine(hash, static_cast<int>(item.type()));
+		if (item.type() == Operation)
+			boost::hash_combine(hash, item.instruction());
+		else if (item.type() != PushTag && item.type() != VerbatimBytecode)
+			boost::hash_combine(hash, item.data());
+		if (!SemanticInformation::altersControlFlow(item) || item == Instruction::JUMPI)
+			boost::hash_combine(hash, hashes[i + 1]);
+		hashes[i] = hash;
+	}
+	return hashes;
+}
+
 bool BlockDeduplicator::applyTagReplacement(
 	AssemblyItems& _items,
 	map<u256, u256> const& _replacements,
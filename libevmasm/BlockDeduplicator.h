@@ -63,6 +63,11 @@ public:
 	);
 
 private:
+	/// @returns, for each position, a hash of the items a BlockIterator visits from there,
+	/// the last element being the hash of the empty sequence. Pushed tags only contribute
+	/// their type, since the comparison of blocks replaces the block's own tag.
+	std::vector<size_t> suffixHashes() const;
+
 	/// Iterator that skips tags and skips to the end if (all branches of) the control
 	/// flow does not continue to the next instruction.
 	/// If the arguments are supplied to the constructor, replaces items on the fly.
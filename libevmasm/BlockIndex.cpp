@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Index of the tagged blocks of a list of assembly items that is shared by the optimiser passes.
+ */
+
+#include <libevmasm/BlockIndex.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/Exceptions.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+BlockIndex::BlockIndex(AssemblyItems const& _items)
+{
+	size_t constexpr currentSubId = numeric_limits<size_t>::max();
+	optional<size_t> openTag;
+	for (size_t index = 0; index < _items.size(); ++index)
+	{
+		AssemblyItem const& item = _items[index];
+		if (item.type() == PushTag)
+		{
+			auto [subId, tag] = item.splitForeignPushTag();
+			m_referencedTags[subId].insert(tag);
+			if (subId == currentSubId)
+				m_blocks[tag].pushTagPositions.push_back(index);
+		}
+
+		if (openTag && SemanticInformation::breaksCSEAnalysisBlock(item, false))
+		{
+			m_blocks[*openTag].end = index + 1;
+			openTag.reset();
+		}
+
+		if (item.type() == Tag)
+		{
+			auto [subId, tag] = item.splitForeignPushTag();
+			assertThrow(subId == currentSubId, OptimizerException, "Sub-assembly tag used as label.");
+			m_blocks[tag].start = index;
+			openTag = tag;
+		}
+	}
+}
+
+BlockIndex::Block const* BlockIndex::block(size_t _tag) const
+{
+	auto it = m_blocks.find(_tag);
+	return it == m_blocks.end() ? nullptr : &it->second;
+}
+
+set<size_t> const& BlockIndex::referencedTags(size_t _subId) const
+{
+	static set<size_t> const empty;
+	auto it = m_referencedTags.find(_subId);
+	return it == m_referencedTags.end() ? empty : it->second;
+}
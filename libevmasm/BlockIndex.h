@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Index of the tagged blocks of a list of assembly items that is shared by the optimiser passes.
+ */
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::evmasm
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Records, in a single scan over a list of assembly items, where the blocks starting at the
+ * tags of the assembly are located and which PushTag items reference them, as well as the
+ * tags of sub-assemblies that are referenced.
+ * The index refers to item positions and has to be rebuilt whenever the items change.
+ */
+class BlockIndex
+{
+public:
+	struct Block
+	{
+		/// Position of the Tag item, if the tag is defined in the items.
+		std::optional<size_t> start;
+		/// Position one past the first item after the tag that ends a basic block in the sense of
+		/// SemanticInformation::breaksCSEAnalysisBlock, if there is such an item.
+		std::optional<size_t> end;
+		/// Positions of the PushTag items that reference the tag, i.e. of its potential jump sites.
+		std::vector<size_t> pushTagPositions;
+	};
+
+	explicit BlockIndex(AssemblyItems const& _items);
+
+	/// @returns the blocks of the assembly keyed by their tag, including tags that are only pushed.
+	std::map<size_t, Block> const& blocks() const { return m_blocks; }
+	/// @returns the block of tag @a _tag or nullptr if the tag neither appears nor is pushed.
+	Block const* block(size_t _tag) const;
+	/// @returns the tags of the given sub-assembly that are referenced by PushTag items.
+	/// Tags of the assembly itself are referenced with a sub id of size_t(-1).
+	std::set<size_t> const& referencedTags(size_t _subId) const;
+
+private:
+	std::map<size_t, Block> m_blocks;
+	std::map<size_t, std::set<size_t>> m_referencedTags;
+};
+
+}
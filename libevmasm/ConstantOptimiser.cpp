@@ -24,10 +24,47 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <mutex>
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+ConstantOptimisationMethod::Representation const& ConstantOptimisationMethod::bestRepresentation(
+	Params const& _params,
+	u256 const& _value
+)
+{
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+	static mutex cacheMutex;
+	static map<Key, Representation> cache;
+
+	Key key{_value, _params.isCreation, _params.runs, _params.multiplicity, _params.evmVersion};
+	{
+		lock_guard lock(cacheMutex);
+		if (auto it = cache.find(key); it != cache.end())
+			return it->second;
+	}
+
+	Representation representation;
+	bigint literalGas = LiteralMethod(_params, _value).gasNeeded();
+	bigint copyGas = CodeCopyMethod(_params, _value).gasNeeded();
+	ComputeMethod compute(_params, _value);
+	bigint computeGas = compute.gasNeeded();
+	if (copyGas < literalGas && copyGas < computeGas)
+		representation.method = Representation::CodeCopy;
+	else if (computeGas < literalGas && computeGas <= copyGas)
+	{
+		representation.method = Representation::Compute;
+		representation.routine = compute.routine();
+	}
+
+	lock_guard lock(cacheMutex);
+	// References to map elements stay valid on insertion.
+	return cache.emplace(std::move(key), std::move(representation)).first->second;
+}
+
 unsigned ConstantOptimisationMethod::optimiseConstants(
 	bool _isCreation,
 	size_t _runs,
@@ -54,21 +91,16 @@ unsigned ConstantOptimisationMethod::optimiseConstants(
 		params.isCreation = _isCreation;
 		params.runs = _runs;
 		params.evmVersion = _evmVersion;
-		LiteralMethod lit(params, item.data());
-		bigint literalGas = lit.gasNeeded();
-		CodeCopyMethod copy(params, item.data());
-		bigint copyGas = copy.gasNeeded();
-		ComputeMethod compute(params, item.data());
-		bigint computeGas = compute.gasNeeded();
+		Representation const& representation = bestRepresentation(params, item.data());
 		AssemblyItems replacement;
-		if (copyGas < literalGas && copyGas < computeGas)
+		if (representation.method == Representation::CodeCopy)
 		{
-			replacement = copy.execute(_assembly);
+			replacement = CodeCopyMethod(params, item.data()).execute(_assembly);
 			optimisations++;
 		}
-		else if (computeGas < literalGas && computeGas <= copyGas)
+		else if (representation.method == Representation::Compute)
 		{
-			replacement = compute.execute(_assembly);
+			replacement = representation.routine;
 			optimisations++;
 		}
 		if (!replacement.empty())
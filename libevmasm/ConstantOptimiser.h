@@ -65,6 +65,20 @@ protected:
 		langutil::EVMVersion evmVersion; ///< Version of the EVM
 	};
 
+	/// The cheapest way to represent a constant.
+	struct Representation
+	{
+		enum Method { Literal, CodeCopy, Compute };
+		Method method = Literal;
+		/// The routine computing the constant if method is Compute.
+		AssemblyItems routine;
+	};
+
+	/// @returns the cheapest representation of @a _value among the literal, code copy and
+	/// compute methods. The decisions are cached for the lifetime of the process, since the
+	/// same constants are optimised in every contract and every compilation.
+	static Representation const& bestRepresentation(Params const& _params, u256 const& _value);
+
 	explicit ConstantOptimisationMethod(Params const& _params, u256 const& _value):
 		m_params(_params), m_value(_value) {}
 	virtual ~ConstantOptimisationMethod() = default;
@@ -148,6 +162,7 @@ public:
 	{
 		return m_routine;
 	}
+	AssemblyItems const& routine() const { return m_routine; }
 
 protected:
 	/// Tries to recursively find a way to compute @a _value.
@@ -20,58 +20,118 @@
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonIO.h>
+
 #include <functional>
+#include <map>
+#include <mutex>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// Appends the hex digits of the big-endian number formed by @a _size bytes at @a _data followed
+/// by @a _zeroBytes zero bytes to @a _out, without leading zeros.
+void appendHexNumber(string& _out, uint8_t const* _data, size_t _size, size_t _zeroBytes)
+{
+	static char constexpr digits[] = "0123456789ABCDEF";
+	bool leadingZero = true;
+	auto appendDigit = [&](unsigned _digit) {
+		if (leadingZero && _digit == 0)
+			return;
+		leadingZero = false;
+		_out += digits[_digit];
+	};
+	for (size_t i = 0; i < _size; ++i)
+	{
+		appendDigit(_data[i] >> 4);
+		appendDigit(_data[i] & 0xf);
+	}
+	if (!leadingZero)
+		_out.append(2 * _zeroBytes, '0');
+	if (leadingZero)
+		_out += '0';
+}
+
+}
+
+array<OpcodeDecoding, 256> const& solidity::evmasm::opcodeDecodingTable(langutil::EVMVersion _evmVersion)
+{
+	// Names are kept alive by the map, whose nodes do not move.
+	struct Table
+	{
+		array<OpcodeDecoding, 256> decodings;
+		array<string, 256> names;
+	};
+	static mutex tablesMutex;
+	static map<langutil::EVMVersion, Table> tables;
+
+	lock_guard<mutex> lock(tablesMutex);
+	auto [it, inserted] = tables.try_emplace(_evmVersion);
+	Table& table = it->second;
+	if (inserted)
+		for (size_t opcode = 0; opcode < 256; ++opcode)
+		{
+			Instruction const instruction{static_cast<uint8_t>(opcode)};
+			if (!isValidInstruction(instruction))
+				continue;
+			InstructionInfo info = instructionInfo(instruction, _evmVersion);
+			table.names[opcode] = info.name;
+			table.decodings[opcode] = {true, static_cast<uint8_t>(info.additional), table.names[opcode]};
+		}
+	return table.decodings;
+}
 
 void solidity::evmasm::eachInstruction(
 	bytes const& _mem,
-	langutil::EVMVersion _evmVersion,
+	langutil::EVMVersion,
 	function<void(Instruction,u256 const&)> const& _onInstruction
 )
 {
-	for (auto it = _mem.begin(); it < _mem.end(); ++it)
+	for (DecodedInstruction const& instruction: InstructionRange{_mem})
 	{
-		Instruction const instr{*it};
-		int additional = 0;
-		if (isValidInstruction(instr))
-			additional = instructionInfo(instr, _evmVersion).additional;
-
 		u256 data{};
 
 		// fill the data with the additional data bytes from the instruction stream
-		while (additional > 0 && std::next(it) < _mem.end())
+		for (size_t i = 0; i < instruction.immediateSize; ++i)
 		{
 			data <<= 8;
-			data |= *++it;
-			--additional;
+			data |= instruction.immediate[i];
 		}
 
 		// pad the remaining number of additional octets with zeros
-		data <<= 8 * additional;
+		data <<= 8 * instruction.missingImmediateSize;
 
-		_onInstruction(instr, data);
+		_onInstruction(Instruction{instruction.opcode}, data);
 	}
 }
 
 string solidity::evmasm::disassemble(bytes const& _mem, langutil::EVMVersion _evmVersion, string const& _delimiter)
 {
-	stringstream ret;
-	eachInstruction(_mem, _evmVersion, [&](Instruction _instr, u256 const& _data) {
-		if (!isValidInstruction(_instr))
-			ret << "0x" << std::uppercase << std::hex << static_cast<int>(_instr) << _delimiter;
+	array<OpcodeDecoding, 256> const& decodings = opcodeDecodingTable(_evmVersion);
+	string ret;
+	ret.reserve(_mem.size() * 4);
+	for (DecodedInstruction const& instruction: InstructionRange{_mem})
+	{
+		OpcodeDecoding const& decoding = decodings[instruction.opcode];
+		if (!decoding.valid)
+		{
+			ret += "0x";
+			appendHexNumber(ret, &instruction.opcode, 1, 0);
+		}
 		else
 		{
-			InstructionInfo info = instructionInfo(_instr, _evmVersion);
-			ret << info.name;
-			if (info.additional)
-				ret << " 0x" << std::uppercase << std::hex << _data;
-			ret << _delimiter;
+			ret += decoding.name;
+			if (decoding.immediateSize)
+			{
+				ret += " 0x";
+				appendHexNumber(ret, instruction.immediate, instruction.immediateSize, instruction.missingImmediateSize);
+			}
 		}
-	});
-	return ret.str();
+		ret += _delimiter;
+	}
+	return ret;
 }
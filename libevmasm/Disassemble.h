@@ -23,12 +23,115 @@
 
 #include <libevmasm/Instruction.h>
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <iterator>
 #include <string>
+#include <string_view>
 
 namespace solidity::evmasm
 {
 
+/// Number of immediate bytes that follow each opcode byte, i.e. the size of the data pushed by PUSH1 to PUSH32.
+inline constexpr std::array<uint8_t, 256> c_immediateSizes = []() {
+	std::array<uint8_t, 256> sizes{};
+	for (unsigned opcode = static_cast<unsigned>(Instruction::PUSH1); opcode <= static_cast<unsigned>(Instruction::PUSH32); ++opcode)
+		sizes[opcode] = static_cast<uint8_t>(opcode - static_cast<unsigned>(Instruction::PUSH1) + 1);
+	return sizes;
+}();
+
+/// What the disassembler needs to know about an opcode byte.
+struct OpcodeDecoding
+{
+	bool valid = false;
+	/// Number of immediate bytes that follow the opcode.
+	uint8_t immediateSize = 0;
+	/// Name of the instruction, empty if the opcode is not valid.
+	std::string_view name;
+};
+
+/// @returns a table of the decodings of all opcode bytes for the given EVM version.
+/// The table is built on first use and stays valid for the lifetime of the program.
+std::array<OpcodeDecoding, 256> const& opcodeDecodingTable(langutil::EVMVersion _evmVersion);
+
+/// An instruction found in bytecode.
+struct DecodedInstruction
+{
+	/// Offset of the opcode in the bytecode.
+	size_t position = 0;
+	uint8_t opcode = 0;
+	/// The immediate bytes that are present in the bytecode.
+	uint8_t const* immediate = nullptr;
+	size_t immediateSize = 0;
+	/// Number of immediate bytes cut off by the end of the bytecode.
+	size_t missingImmediateSize = 0;
+};
+
+/// Range over the instructions in bytecode that decodes them on the fly without allocating.
+/// The bytecode has to outlive the range.
+class InstructionRange
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = DecodedInstruction;
+		using difference_type = std::ptrdiff_t;
+		using pointer = DecodedInstruction const*;
+		using reference = DecodedInstruction const&;
+
+		Iterator(uint8_t const* _begin, uint8_t const* _position, uint8_t const* _end):
+			m_begin(_begin), m_end(_end)
+		{
+			decode(_position);
+		}
+
+		reference operator*() const { return m_current; }
+		pointer operator->() const { return &m_current; }
+		Iterator& operator++()
+		{
+			decode(m_current.immediate + m_current.immediateSize);
+			return *this;
+		}
+		Iterator operator++(int) { Iterator ret = *this; ++*this; return ret; }
+		bool operator==(Iterator const& _other) const { return m_position == _other.m_position; }
+		bool operator!=(Iterator const& _other) const { return m_position != _other.m_position; }
+
+	private:
+		void decode(uint8_t const* _position)
+		{
+			m_position = _position;
+			if (_position >= m_end)
+				return;
+			size_t immediateSize = c_immediateSizes[*_position];
+			size_t available = static_cast<size_t>(m_end - _position - 1);
+			m_current.position = static_cast<size_t>(_position - m_begin);
+			m_current.opcode = *_position;
+			m_current.immediate = _position + 1;
+			m_current.immediateSize = std::min(immediateSize, available);
+			m_current.missingImmediateSize = immediateSize - m_current.immediateSize;
+		}
+
+		uint8_t const* m_begin = nullptr;
+		uint8_t const* m_position = nullptr;
+		uint8_t const* m_end = nullptr;
+		DecodedInstruction m_current;
+	};
+
+	explicit InstructionRange(bytes const& _bytecode):
+		m_begin(_bytecode.data()), m_end(_bytecode.data() + _bytecode.size())
+	{}
+
+	Iterator begin() const { return {m_begin, m_begin, m_end}; }
+	Iterator end() const { return {m_begin, m_end, m_end}; }
+
+private:
+	uint8_t const* m_begin = nullptr;
+	uint8_t const* m_end = nullptr;
+};
+
 /// Iterate through EVM code and call a function on each instruction.
 void eachInstruction(bytes const& _mem, langutil::EVMVersion _evmVersion, std::function<void(Instruction, u256 const&)> const& _onInstruction);
 
@@ -30,6 +30,7 @@
 
 #include <boost/container_hash/hash.hpp>
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <tuple>
@@ -41,37 +42,56 @@ using namespace solidity::langutil;
 
 bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
 {
-	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	assertThrow(!!_other.item, OptimizerException, "");
+	return equals(*_other.item, _other.arguments, _other.sequenceNumber);
+}
+
+bool ExpressionClasses::Expression::equals(
+	AssemblyItem const& _item,
+	Ids const& _arguments,
+	unsigned _sequenceNumber
+) const
+{
+	assertThrow(!!item, OptimizerException, "");
 	auto type = item->type();
-	auto otherType = _other.item->type();
+	auto otherType = _item.type();
 	if (type != otherType)
 		return false;
 	else if (type == Operation)
 	{
 		auto instr = item->instruction();
-		auto otherInstr = _other.item->instruction();
+		auto otherInstr = _item.instruction();
 		return std::tie(instr, arguments, sequenceNumber) ==
-			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
+			std::tie(otherInstr, _arguments, _sequenceNumber);
 	}
 	else
 		return std::tie(item->data(), arguments, sequenceNumber) ==
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+			std::tie(_item.data(), _arguments, _sequenceNumber);
 }
 
 std::size_t ExpressionClasses::Expression::ExpressionHash::operator()(Expression const& _expression) const
 {
 	assertThrow(!!_expression.item, OptimizerException, "");
+	return hash(*_expression.item, _expression.arguments, _expression.sequenceNumber);
+}
+
+std::size_t ExpressionClasses::Expression::ExpressionHash::hash(
+	AssemblyItem const& _item,
+	Ids const& _arguments,
+	unsigned _sequenceNumber
+)
+{
 	std::size_t seed = 0;
-	auto type = _expression.item->type();
+	auto type = _item.type();
 	boost::hash_combine(seed, type);
 
 	if (type == Operation)
-		boost::hash_combine(seed, _expression.item->instruction());
+		boost::hash_combine(seed, _item.instruction());
 	else
-		boost::hash_combine(seed, _expression.item->data());
+		boost::hash_combine(seed, _item.data());
 
-	boost::hash_range(seed, _expression.arguments.begin(), _expression.arguments.end());
-	boost::hash_combine(seed, _expression.sequenceNumber);
+	boost::hash_range(seed, _arguments.begin(), _arguments.end());
+	boost::hash_combine(seed, _sequenceNumber);
 
 	return seed;
 }
@@ -83,24 +103,36 @@ ExpressionClasses::Id ExpressionClasses::find(
 	unsigned _sequenceNumber
 )
 {
-	Expression exp;
-	exp.id = Id(-1);
-	exp.item = &_item;
-	exp.arguments = _arguments;
-	exp.sequenceNumber = _sequenceNumber;
-
-	if (SemanticInformation::isCommutativeOperation(_item))
-		sort(exp.arguments.begin(), exp.arguments.end());
-
-	if (SemanticInformation::isDeterministic(_item))
+	// Only sort a copy of the arguments if needed, so that looking up an already known
+	// expression does not allocate.
+	Ids const* arguments = &_arguments;
+	Ids sortedArguments;
+	if (
+		SemanticInformation::isCommutativeOperation(_item) &&
+		!is_sorted(_arguments.begin(), _arguments.end())
+	)
 	{
-		auto it = m_expressions.find(exp);
-		if (it != m_expressions.end())
-			return it->id;
+		sortedArguments = _arguments;
+		sort(sortedArguments.begin(), sortedArguments.end());
+		arguments = &sortedArguments;
 	}
 
-	if (_copyItem)
-		exp.item = storeItem(_item);
+	if (SemanticInformation::isDeterministic(_item))
+		if (
+			Expression const* existing = findExpression(
+				_item,
+				*arguments,
+				_sequenceNumber,
+				Expression::ExpressionHash::hash(_item, *arguments, _sequenceNumber)
+			)
+		)
+			return existing->id;
+
+	Expression exp;
+	exp.id = Id(-1);
+	exp.item = _copyItem ? storeItem(_item) : &_item;
+	exp.arguments = arguments == &sortedArguments ? std::move(sortedArguments) : _arguments;
+	exp.sequenceNumber = _sequenceNumber;
 
 	ExpressionClasses::Id id = tryToSimplify(exp);
 	if (id < m_representatives.size())
@@ -110,8 +142,9 @@ ExpressionClasses::Id ExpressionClasses::find(
 		exp.id = static_cast<Id>(m_representatives.size());
 		m_representatives.push_back(exp);
 	}
-	m_expressions.insert(exp);
-	return exp.id;
+	Id resultId = exp.id;
+	insertExpression(std::move(exp));
+	return resultId;
 }
 
 void ExpressionClasses::forceEqual(
@@ -132,7 +165,7 @@ void ExpressionClasses::forceEqual(
 	if (_copyItem)
 		exp.item = storeItem(_item);
 
-	m_expressions.insert(exp);
+	insertExpression(std::move(exp));
 }
 
 ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _location)
@@ -141,7 +174,7 @@ ExpressionClasses::Id ExpressionClasses::newClass(SourceLocation const& _locatio
 	exp.id = static_cast<Id>(m_representatives.size());
 	exp.item = storeItem(AssemblyItem(UndefinedItem, (u256(1) << 255) + exp.id, _location));
 	m_representatives.push_back(exp);
-	m_expressions.insert(exp);
+	insertExpression(exp);
 	return exp.id;
 }
 
@@ -171,7 +204,7 @@ bool ExpressionClasses::knownNonZero(Id _c)
 
 u256 const* ExpressionClasses::knownConstant(Id _c)
 {
-	map<unsigned, Expression const*> matchGroups;
+	MatchGroups matchGroups{};
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
@@ -185,6 +218,54 @@ AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
 	return m_spareAssemblyItems.back().get();
 }
 
+ExpressionClasses::Expression const* ExpressionClasses::findExpression(
+	AssemblyItem const& _item,
+	Ids const& _arguments,
+	unsigned _sequenceNumber,
+	size_t _hash
+) const
+{
+	if (m_expressionTable.empty())
+		return nullptr;
+	size_t mask = m_expressionTable.size() - 1;
+	for (size_t slot = _hash & mask; m_expressionTable[slot] != 0; slot = (slot + 1) & mask)
+	{
+		size_t index = m_expressionTable[slot] - 1;
+		if (m_expressionHashes[index] == _hash && m_expressions[index].equals(_item, _arguments, _sequenceNumber))
+			return &m_expressions[index];
+	}
+	return nullptr;
+}
+
+void ExpressionClasses::insertExpression(Expression _expression)
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t hash = Expression::ExpressionHash::hash(*_expression.item, _expression.arguments, _expression.sequenceNumber);
+	if (findExpression(*_expression.item, _expression.arguments, _expression.sequenceNumber, hash))
+		return;
+
+	if (2 * (m_expressions.size() + 1) > m_expressionTable.size())
+	{
+		m_expressionTable.assign(max<size_t>(64, 2 * m_expressionTable.size()), 0);
+		size_t mask = m_expressionTable.size() - 1;
+		for (size_t index = 0; index < m_expressions.size(); ++index)
+		{
+			size_t slot = m_expressionHashes[index] & mask;
+			while (m_expressionTable[slot] != 0)
+				slot = (slot + 1) & mask;
+			m_expressionTable[slot] = index + 1;
+		}
+	}
+
+	size_t mask = m_expressionTable.size() - 1;
+	size_t slot = hash & mask;
+	while (m_expressionTable[slot] != 0)
+		slot = (slot + 1) & mask;
+	m_expressions.emplace_back(std::move(_expression));
+	m_expressionHashes.emplace_back(hash);
+	m_expressionTable[slot] = m_expressions.size();
+}
+
 string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 {
 	Expression const& expr = representative(_id);
@@ -204,7 +285,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules keep the state of the current match, so every thread needs its own copy.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
@@ -227,6 +309,8 @@ ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 			cout << "to " << match->action().toString() << endl;
 		}
 
+		if (m_ruleApplications)
+			++(*m_ruleApplications)[match->pattern.toString()];
 		return rebuildExpression(ExpressionTemplate(match->action(), _expr.item->location()));
 	}
 
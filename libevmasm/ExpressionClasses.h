@@ -28,8 +28,9 @@
 
 #include <libsolutil/Common.h>
 
+#include <map>
 #include <memory>
-#include <unordered_set>
+#include <string>
 #include <vector>
 
 namespace solidity::langutil
@@ -62,10 +63,13 @@ public:
 		unsigned sequenceNumber = 0;
 		/// Behaves as if this was a tuple of (item->type(), item->data(), arguments, sequenceNumber).
 		bool operator==(Expression const& _other) const;
+		/// Same as operator==, but compares against the components of an expression.
+		bool equals(AssemblyItem const& _item, Ids const& _arguments, unsigned _sequenceNumber) const;
 
 		struct ExpressionHash
 		{
 			std::size_t operator()(Expression const& _expression) const;
+			static std::size_t hash(AssemblyItem const& _item, Ids const& _arguments, unsigned _sequenceNumber);
 		};
 	};
 
@@ -115,6 +119,10 @@ public:
 
 	std::string fullDAGToString(Id _id) const;
 
+	/// Makes the simplification of expressions count the applications of each simplification
+	/// rule in @a _ruleApplications, indexed by the pattern of the rule. Not counted if null.
+	void countRuleApplications(std::map<std::string, size_t>* _ruleApplications) { m_ruleApplications = _ruleApplications; }
+
 private:
 	/// Tries to simplify the given expression.
 	/// @returns its class if it possible or Id(-1) otherwise.
@@ -125,11 +133,28 @@ private:
 
 	std::vector<std::pair<Pattern, std::function<Pattern()>>> createRules() const;
 
+	/// @returns the expression equal to the given components that was encountered before, or nullptr.
+	Expression const* findExpression(
+		AssemblyItem const& _item,
+		Ids const& _arguments,
+		unsigned _sequenceNumber,
+		std::size_t _hash
+	) const;
+	/// Records @a _expression as encountered, unless an equal expression was encountered before.
+	void insertExpression(Expression _expression);
+
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
-	std::unordered_set<Expression, Expression::ExpressionHash> m_expressions;
+	std::vector<Expression> m_expressions;
+	/// Hashes of the elements of m_expressions.
+	std::vector<std::size_t> m_expressionHashes;
+	/// Open-addressing hash table with linear probing over m_expressions.
+	/// Contains indices into m_expressions plus one, zero marks an empty slot.
+	/// Its size is a power of two and it is kept at most half full.
+	std::vector<size_t> m_expressionTable;
 	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
+	std::map<std::string, size_t>* m_ruleApplications = nullptr;
 };
 
 }
@@ -110,6 +110,13 @@ GasMeter::GasConsumption GasMeter::estimateMax(AssemblyItem const& _item, bool _
 			gas += memoryGas(0, -2);
 			gas += wordGas(GasCosts::copyGas, m_state->relativeStackElement(-2));
 			break;
+		case Instruction::MCOPY:
+			gas = runGas(_item.instruction(), m_evmVersion);
+			// Memory is expanded to cover both the source and the target area.
+			gas += memoryGas(0, -2);
+			gas += memoryGas(-1, -2);
+			gas += wordGas(GasCosts::copyGas, m_state->relativeStackElement(-2));
+			break;
 		case Instruction::EXTCODESIZE:
 			gas = GasCosts::extCodeGas(m_evmVersion);
 			break;
@@ -272,6 +279,65 @@ unsigned GasMeter::runGas(Instruction _instruction, langutil::EVMVersion _evmVer
 	return 0;
 }
 
+unsigned GasMeter::staticGas(AssemblyItem const& _item, langutil::EVMVersion _evmVersion)
+{
+	switch (_item.type())
+	{
+	case Push:
+	case PushTag:
+	case PushData:
+	case PushSub:
+	case PushSubSize:
+	case PushProgramSize:
+	case PushLibraryAddress:
+	case PushDeployTimeAddress:
+	case PushImmutable:
+		return runGas(Instruction::PUSH1, _evmVersion);
+	case Tag:
+		return runGas(Instruction::JUMPDEST, _evmVersion);
+	case Operation:
+		break;
+	default:
+		return 0;
+	}
+
+	switch (_item.instruction())
+	{
+	case Instruction::SSTORE:
+		return GasCosts::totalSstoreSetGas(_evmVersion);
+	case Instruction::SLOAD:
+		return GasCosts::sloadGas(_evmVersion);
+	case Instruction::KECCAK256:
+		return GasCosts::keccak256Gas;
+	case Instruction::EXTCODESIZE:
+	case Instruction::EXTCODECOPY:
+		return GasCosts::extCodeGas(_evmVersion);
+	case Instruction::EXTCODEHASH:
+	case Instruction::BALANCE:
+		return GasCosts::balanceGas(_evmVersion);
+	case Instruction::LOG0:
+	case Instruction::LOG1:
+	case Instruction::LOG2:
+	case Instruction::LOG3:
+	case Instruction::LOG4:
+		return GasCosts::logGas + GasCosts::logTopicGas * getLogNumber(_item.instruction());
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		return GasCosts::callGas(_evmVersion);
+	case Instruction::SELFDESTRUCT:
+		return GasCosts::selfdestructGas(_evmVersion);
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return GasCosts::createGas;
+	case Instruction::EXP:
+		return GasCosts::expGas;
+	default:
+		return runGas(_item.instruction(), _evmVersion);
+	}
+}
+
 u256 GasMeter::dataGas(bytes const& _data, bool _inCreation, langutil::EVMVersion _evmVersion)
 {
 	bigint gas = 0;
@@ -223,6 +223,12 @@ public:
 	/// change with EVM versions)
 	static unsigned runGas(Instruction _instruction, langutil::EVMVersion _evmVersion);
 
+	/// @returns the part of the gas costs of the given item that does not depend on the state
+	/// of the execution, i.e. without memory expansion, costs per word and value transfers.
+	/// Storage writes are assumed to set a slot. Items that are not a single instruction
+	/// (assigning immutables or verbatim bytecode) are assumed to be free.
+	static unsigned staticGas(AssemblyItem const& _item, langutil::EVMVersion _evmVersion);
+
 	/// @returns the gas cost of the supplied data, depending whether it is in creation code, or not.
 	/// In case of @a _inCreation, the data is only sent as a transaction and is not stored, whereas
 	/// otherwise code will be stored and have to pay "createDataGas" cost.
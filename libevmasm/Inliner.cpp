@@ -31,7 +31,6 @@
 
 #include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/view/drop_last.hpp>
-#include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/slice.hpp>
 #include <range/v3/view/transform.hpp>
 
@@ -99,41 +98,24 @@ bool Inliner::isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _i
 	return true;
 }
 
-map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(AssemblyItems const& _items) const
+map<size_t, Inliner::InlinableBlock> Inliner::determineInlinableBlocks(
+	AssemblyItems const& _items,
+	BlockIndex const& _blockIndex
+) const
 {
-	std::map<size_t, ranges::span<AssemblyItem const>> inlinableBlockItems;
-	std::map<size_t, uint64_t> numPushTags;
-	std::optional<size_t> lastTag;
-	for (auto&& [index, item]: _items | ranges::views::enumerate)
+	map<size_t, InlinableBlock> result;
+	for (auto&& [tag, block]: _blockIndex.blocks())
 	{
-		// The number of PushTags approximates the number of calls to a block.
-		if (item.type() == PushTag)
-			if (optional<size_t> tag = getLocalTag(item))
-				++numPushTags[*tag];
-
 		// We can only inline blocks with straight control flow that end in a jump.
 		// Using breaksCSEAnalysisBlock will hopefully allow the return jump to be optimized after inlining.
-		if (lastTag && SemanticInformation::breaksCSEAnalysisBlock(item, false))
-		{
-			ranges::span<AssemblyItem const> block = _items | ranges::views::slice(*lastTag + 1, index + 1);
-			if (optional<size_t> tag = getLocalTag(_items[*lastTag]))
-				if (isInlineCandidate(*tag, block))
-					inlinableBlockItems[*tag] = block;
-			lastTag.reset();
-		}
-
-		if (item.type() == Tag)
-		{
-			assertThrow(getLocalTag(item), OptimizerException, "");
-			lastTag = index;
-		}
+		// The number of PushTags approximates the number of calls to a block. Tags that are never pushed
+		// are discarded.
+		if (!block.start || !block.end || block.pushTagPositions.empty())
+			continue;
+		ranges::span<AssemblyItem const> items = _items | ranges::views::slice(*block.start + 1, *block.end);
+		if (isInlineCandidate(tag, items))
+			result.emplace(tag, InlinableBlock{items, static_cast<uint64_t>(block.pushTagPositions.size())});
 	}
-
-	// Store the number of PushTags alongside the assembly items and discard tags that are never pushed.
-	map<size_t, InlinableBlock> result;
-	for (auto&& [tag, items]: inlinableBlockItems)
-		if (uint64_t const* numPushes = util::valueOrNullptr(numPushTags, tag))
-			result.emplace(tag, InlinableBlock{items, *numPushes});
 	return result;
 }
 
@@ -236,46 +218,111 @@ optional<AssemblyItem> Inliner::shouldInline(size_t _tag, AssemblyItem const& _j
 }
 
 
-void Inliner::optimise()
+bool Inliner::optimise()
 {
-	std::map<size_t, InlinableBlock> inlinableBlocks = determineInlinableBlocks(m_items);
+	return optimise(BlockIndex{m_items});
+}
+
+bool Inliner::optimise(BlockIndex const& _blockIndex)
+{
+	std::map<size_t, InlinableBlock> inlinableBlocks = determineInlinableBlocks(m_items, _blockIndex);
 
 	if (inlinableBlocks.empty())
-		return;
+		return false;
+
+	static AssemblyItems const jumpPattern = {
+		AssemblyItem{PushTag},
+		AssemblyItem{Instruction::JUMP},
+	};
+	static AssemblyItems const removedByInlining = jumpPattern + AssemblyItems{AssemblyItem{Tag}};
+	bigint const gasSavedPerJump = bigint(m_runs) * bigint(executionCost(removedByInlining, m_evmVersion));
+
+	vector<InlinedJump> inlinedJumps;
+	for (size_t index = 0; index + 1 < m_items.size(); ++index)
+	{
+		AssemblyItem const& item = m_items[index];
+		AssemblyItem const& nextItem = m_items[index + 1];
+		if (item.type() == PushTag && nextItem == Instruction::JUMP)
+			if (optional<size_t> tag = getLocalTag(item))
+				if (auto* inlinableBlock = util::valueOrNullptr(inlinableBlocks, *tag))
+					if (auto exitItem = shouldInline(*tag, nextItem, *inlinableBlock))
+					{
+						inlinedJumps.push_back({
+							index,
+							inlinableBlock->items,
+							std::move(*exitItem),
+							gasSavedPerJump,
+							static_cast<int64_t>(codeSize(inlinableBlock->items)) - static_cast<int64_t>(codeSize(jumpPattern))
+						});
+
+						// We are removing one push tag to the block we inline.
+						--inlinableBlock->pushTagCount;
+						// We might increase the number of push tags to other blocks.
+						for (AssemblyItem const& inlinedItem: inlinableBlock->items)
+							if (inlinedItem.type() == PushTag)
+								if (optional<size_t> duplicatedTag = getLocalTag(inlinedItem))
+									if (auto* block = util::valueOrNullptr(inlinableBlocks, *duplicatedTag))
+										++block->pushTagCount;
+
+						// Skip the original jump to the inlined tag and continue.
+						++index;
+					}
+	}
+
+	if (m_codeSizeBudget)
+		applyCodeSizeBudget(inlinedJumps);
+
+	if (inlinedJumps.empty())
+		return false;
 
 	AssemblyItems newItems;
-	for (auto it = m_items.begin(); it != m_items.end(); ++it)
+	newItems.reserve(m_items.size());
+	auto inlinedJump = inlinedJumps.begin();
+	for (size_t index = 0; index < m_items.size(); ++index)
 	{
-		AssemblyItem const& item = *it;
-		if (next(it) != m_items.end())
+		if (inlinedJump != inlinedJumps.end() && inlinedJump->position == index)
 		{
-			AssemblyItem const& nextItem = *next(it);
-			if (item.type() == PushTag && nextItem == Instruction::JUMP)
-			{
-				if (optional<size_t> tag = getLocalTag(item))
-					if (auto* inlinableBlock = util::valueOrNullptr(inlinableBlocks, *tag))
-						if (auto exitItem = shouldInline(*tag, nextItem, *inlinableBlock))
-						{
-							newItems += inlinableBlock->items | ranges::views::drop_last(1);
-							newItems.emplace_back(std::move(*exitItem));
-
-							// We are removing one push tag to the block we inline.
-							--inlinableBlock->pushTagCount;
-							// We might increase the number of push tags to other blocks.
-							for (AssemblyItem const& inlinedItem: inlinableBlock->items)
-								if (inlinedItem.type() == PushTag)
-									if (optional<size_t> duplicatedTag = getLocalTag(inlinedItem))
-										if (auto* block = util::valueOrNullptr(inlinableBlocks, *duplicatedTag))
-											++block->pushTagCount;
-
-							// Skip the original jump to the inlined tag and continue.
-							++it;
-							continue;
-						}
-			}
+			newItems += inlinedJump->items | ranges::views::drop_last(1);
+			newItems.emplace_back(std::move(inlinedJump->exitItem));
+			++inlinedJump;
+			// Skip the original jump to the inlined tag.
+			++index;
+			continue;
 		}
-		newItems.emplace_back(item);
+		newItems.emplace_back(m_items[index]);
 	}
 
 	m_items = std::move(newItems);
+	return true;
+}
+
+void Inliner::applyCodeSizeBudget(vector<InlinedJump>& _inlinedJumps) const
+{
+	// Jumps whose inlining does not grow the code are always inlined and free up budget.
+	bigint budget = *m_codeSizeBudget;
+	vector<size_t> growingJumps;
+	for (size_t index = 0; index < _inlinedJumps.size(); ++index)
+		if (_inlinedJumps[index].sizeIncrease > 0)
+			growingJumps.push_back(index);
+		else
+			budget -= _inlinedJumps[index].sizeIncrease;
+
+	// Spend the budget on the jumps that save the most gas per byte of added code first.
+	stable_sort(growingJumps.begin(), growingJumps.end(), [&](size_t _a, size_t _b) {
+		InlinedJump const& a = _inlinedJumps[_a];
+		InlinedJump const& b = _inlinedJumps[_b];
+		return a.gasSaved * b.sizeIncrease > b.gasSaved * a.sizeIncrease;
+	});
+	vector<bool> keep(_inlinedJumps.size(), true);
+	for (size_t index: growingJumps)
+		if (_inlinedJumps[index].sizeIncrease <= budget)
+			budget -= _inlinedJumps[index].sizeIncrease;
+		else
+			keep[index] = false;
+
+	size_t kept = 0;
+	for (size_t index = 0; index < _inlinedJumps.size(); ++index)
+		if (keep[index])
+			_inlinedJumps[kept++] = std::move(_inlinedJumps[index]);
+	_inlinedJumps.resize(kept);
 }
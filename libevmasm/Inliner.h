@@ -24,10 +24,12 @@
 #include <libsolutil/Common.h>
 #include <libevmasm/Assembly.h>
 #include <libevmasm/AssemblyItem.h>
+#include <libevmasm/BlockIndex.h>
 #include <liblangutil/EVMVersion.h>
 
 #include <range/v3/view/span.hpp>
 #include <map>
+#include <optional>
 #include <set>
 #include <vector>
 
@@ -42,18 +44,23 @@ public:
 		std::set<size_t> const& _tagsReferencedFromOutside,
 		size_t _runs,
 		bool _isCreation,
-		langutil::EVMVersion _evmVersion
+		langutil::EVMVersion _evmVersion,
+		std::optional<size_t> _codeSizeBudget = std::nullopt
 	):
 	m_items(_items),
 	m_tagsReferencedFromOutside(_tagsReferencedFromOutside),
 	m_runs(_runs),
 	m_isCreation(_isCreation),
-	m_evmVersion(_evmVersion)
+	m_evmVersion(_evmVersion),
+	m_codeSizeBudget(_codeSizeBudget)
 	{
 	}
 	virtual ~Inliner() = default;
 
-	void optimise();
+	/// @returns true if any jump was inlined.
+	bool optimise();
+	/// Same as above, but takes the blocks from @a _blockIndex, which has to be up to date.
+	bool optimise(BlockIndex const& _blockIndex);
 
 private:
 	struct InlinableBlock
@@ -61,6 +68,18 @@ private:
 		ranges::span<AssemblyItem const> items;
 		uint64_t pushTagCount = 0;
 	};
+	/// A jump that is replaced by a copy of the block it jumps to.
+	struct InlinedJump
+	{
+		/// Position of the PushTag item of the jump.
+		size_t position = 0;
+		ranges::span<AssemblyItem const> items;
+		AssemblyItem exitItem{UndefinedItem};
+		/// Estimated gas saved over the lifetime of the contract.
+		bigint gasSaved;
+		/// Estimated number of bytes by which the code grows.
+		int64_t sizeIncrease = 0;
+	};
 
 	/// @returns the exit item for the block to be inlined, if a particular jump to it should be inlined, otherwise nullopt.
 	std::optional<AssemblyItem> shouldInline(size_t _tag, AssemblyItem const& _jump, InlinableBlock const& _block) const;
@@ -72,13 +91,18 @@ private:
 	bool isInlineCandidate(size_t _tag, ranges::span<AssemblyItem const> _items) const;
 	/// @returns a map from tags that can potentially be inlined to the inlinable item range behind that tag and the
 	/// number of times the tag in question was referenced.
-	std::map<size_t, InlinableBlock> determineInlinableBlocks(AssemblyItems const& _items) const;
+	std::map<size_t, InlinableBlock> determineInlinableBlocks(AssemblyItems const& _items, BlockIndex const& _blockIndex) const;
+	/// Drops jumps from @a _inlinedJumps such that the code grows by at most the code size budget,
+	/// preferring the jumps that save the most gas per added byte.
+	void applyCodeSizeBudget(std::vector<InlinedJump>& _inlinedJumps) const;
 
 	AssemblyItems& m_items;
 	std::set<size_t> const& m_tagsReferencedFromOutside;
 	size_t const m_runs = Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment;
 	bool const m_isCreation = false;
 	langutil::EVMVersion const m_evmVersion;
+	/// Number of bytes by which inlining may grow the code, unlimited if not set.
+	std::optional<size_t> const m_codeSizeBudget;
 };
 
 }
@@ -94,6 +94,7 @@ std::map<std::string, Instruction> const solidity::evmasm::c_instructions =
 	{ "MSIZE", Instruction::MSIZE },
 	{ "GAS", Instruction::GAS },
 	{ "JUMPDEST", Instruction::JUMPDEST },
+	{ "MCOPY", Instruction::MCOPY },
 	{ "PUSH1", Instruction::PUSH1 },
 	{ "PUSH2", Instruction::PUSH2 },
 	{ "PUSH3", Instruction::PUSH3 },
@@ -242,6 +243,7 @@ static std::map<Instruction, InstructionInfo> const c_instructionInfo =
 	{ Instruction::MSIZE,		{ "MSIZE",			0, 0, 1, false, Tier::Base } },
 	{ Instruction::GAS,			{ "GAS",			0, 0, 1, false, Tier::Base } },
 	{ Instruction::JUMPDEST,	{ "JUMPDEST",		0, 0, 0, true, Tier::Special } },
+	{ Instruction::MCOPY,		{ "MCOPY",			0, 3, 0, true, Tier::VeryLow } },
 	{ Instruction::PUSH1,		{ "PUSH1",			1, 0, 1, false, Tier::VeryLow } },
 	{ Instruction::PUSH2,		{ "PUSH2",			2, 0, 1, false, Tier::VeryLow } },
 	{ Instruction::PUSH3,		{ "PUSH3",			3, 0, 1, false, Tier::VeryLow } },
@@ -23,6 +23,7 @@
 #include <libevmasm/JumpdestRemover.h>
 
 #include <libevmasm/AssemblyItem.h>
+#include <libevmasm/BlockIndex.h>
 
 #include <limits>
 
@@ -33,7 +34,12 @@ using namespace solidity::evmasm;
 
 bool JumpdestRemover::optimise(set<size_t> const& _tagsReferencedFromOutside)
 {
-	set<size_t> references{referencedTags(m_items, numeric_limits<size_t>::max())};
+	return optimise(_tagsReferencedFromOutside, BlockIndex{m_items});
+}
+
+bool JumpdestRemover::optimise(set<size_t> const& _tagsReferencedFromOutside, BlockIndex const& _blockIndex)
+{
+	set<size_t> references{_blockIndex.referencedTags(numeric_limits<size_t>::max())};
 	references.insert(_tagsReferencedFromOutside.begin(), _tagsReferencedFromOutside.end());
 
 	size_t initialSize = m_items.size();
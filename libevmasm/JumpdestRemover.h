@@ -29,6 +29,7 @@ namespace solidity::evmasm
 {
 class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
+class BlockIndex;
 
 class JumpdestRemover
 {
@@ -36,6 +37,8 @@ public:
 	explicit JumpdestRemover(AssemblyItems& _items): m_items(_items) {}
 
 	bool optimise(std::set<size_t> const& _tagsReferencedFromOutside);
+	/// Same as above, but takes the referenced tags from @a _blockIndex, which has to be up to date.
+	bool optimise(std::set<size_t> const& _tagsReferencedFromOutside, BlockIndex const& _blockIndex);
 
 	/// @returns a set of all tags from the given sub-assembly that are referenced
 	/// from the given list of items.
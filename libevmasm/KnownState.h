@@ -108,11 +108,11 @@ public:
 	StoreOperation feedItem(AssemblyItem const& _item, bool _copyItem = false);
 
 	/// Resets any knowledge about storage.
-	void resetStorage() { m_storageContent.clear(); }
+	void resetStorage() { resetContent(m_storageContent); }
 	/// Resets any knowledge about storage.
-	void resetMemory() { m_memoryContent.clear(); }
+	void resetMemory() { resetContent(m_memoryContent); }
 	/// Resets known Keccak-256 hashes
-	void resetKnownKeccak256Hashes() { m_knownKeccak256Hashes.clear(); }
+	void resetKnownKeccak256Hashes() { resetContent(m_knownKeccak256Hashes); }
 	/// Resets any knowledge about the current stack.
 	void resetStack() { m_stackElements.clear(); m_stackHeight = 0; }
 	/// Resets any knowledge.
@@ -127,6 +127,8 @@ public:
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
 	/// @returns a shared pointer to a copy of this state.
+	/// The knowledge about storage, memory, hashes and tag unions is shared with the copy until
+	/// one of the two states modifies it.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
@@ -149,9 +151,22 @@ public:
 	std::map<int, Id> const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	std::map<Id, Id> const& storageContent() const { return *m_storageContent; }
 
 private:
+	using MemoryContent = std::map<Id, Id>;
+	using StorageContent = std::map<Id, Id>;
+	using KnownKeccak256Hashes = std::map<std::pair<std::vector<Id>, unsigned>, Id>;
+	using TagUnions = boost::bimap<Id, std::set<u256>>;
+
+	/// Replaces @a _content by an empty container unless it is already empty.
+	template <class Content>
+	static void resetContent(std::shared_ptr<Content>& _content)
+	{
+		if (!_content->empty())
+			_content = std::make_shared<Content>();
+	}
+
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
 	void setStackElement(int _stackHeight, Id _class);
 	/// Swaps the given stack elements in their next sequence number.
@@ -182,18 +197,20 @@ private:
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	/// This and the following containers are shared between copies of a state and only
+	/// copied when modified while shared.
+	std::shared_ptr<StorageContent> m_storageContent = std::make_shared<StorageContent>();
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	std::shared_ptr<MemoryContent> m_memoryContent = std::make_shared<MemoryContent>();
 	/// Keeps record of all Keccak-256 hashes that are computed. The first parameter in the
 	/// std::pair corresponds to memory content and the second parameter corresponds to the length
 	/// that is accessed.
-	std::map<std::pair<std::vector<Id>, unsigned>, Id> m_knownKeccak256Hashes;
+	std::shared_ptr<KnownKeccak256Hashes> m_knownKeccak256Hashes = std::make_shared<KnownKeccak256Hashes>();
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
 	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	std::shared_ptr<TagUnions> m_tagUnions = std::make_shared<TagUnions>();
 };
 
 }
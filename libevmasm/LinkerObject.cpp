@@ -23,6 +23,10 @@
 #include <libevmasm/LinkerObject.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+#include <string_view>
 
 using namespace std;
 using namespace solidity;
@@ -38,6 +42,9 @@ void LinkerObject::append(LinkerObject const& _other)
 
 void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 {
+	if (linkReferences.empty() || _libraryAddresses.empty())
+		return;
+
 	std::map<size_t, std::string> remainingRefs;
 	for (auto const& linkRef: linkReferences)
 		if (h160 const* address = matchLibrary(linkRef.second, _libraryAddresses))
@@ -47,16 +54,30 @@ void LinkerObject::link(map<string, h160> const& _libraryAddresses)
 	linkReferences.swap(remainingRefs);
 }
 
+void LinkerObject::link(vector<LinkerObject*> const& _objects, map<string, h160> const& _libraryAddresses)
+{
+	if (_libraryAddresses.empty())
+		return;
+
+	ThreadPool::instance().parallelFor(_objects.size(), [&](size_t _index) {
+		_objects[_index]->link(_libraryAddresses);
+	});
+}
+
 string LinkerObject::toHex() const
 {
 	string hex = solidity::util::toHex(bytecode);
-	for (auto const& ref: linkReferences)
+	// A library is usually referenced several times, so its placeholder is only computed once.
+	map<string_view, string> placeholders;
+	for (auto const& [offset, libraryName]: linkReferences)
 	{
-		size_t pos = ref.first * 2;
-		string hash = libraryPlaceholder(ref.second);
+		auto placeholder = placeholders.find(libraryName);
+		if (placeholder == placeholders.end())
+			placeholder = placeholders.emplace(libraryName, libraryPlaceholder(libraryName)).first;
+
+		size_t pos = offset * 2;
 		hex[pos] = hex[pos + 1] = hex[pos + 38] = hex[pos + 39] = '_';
-		for (size_t i = 0; i < 36; ++i)
-			hex[pos + 2 + i] = hash.at(i);
+		copy_n(placeholder->second.begin(), 36, hex.begin() + static_cast<string::difference_type>(pos + 2));
 	}
 	return hex;
 }
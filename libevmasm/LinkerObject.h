@@ -63,6 +63,9 @@ struct LinkerObject
 	/// Links the given libraries by replacing their uses in the code and removes them from the references.
 	void link(std::map<std::string, util::h160> const& _libraryAddresses);
 
+	/// Links the given libraries in all of @a _objects, processing independent objects in parallel.
+	static void link(std::vector<LinkerObject*> const& _objects, std::map<std::string, util::h160> const& _libraryAddresses);
+
 	/// @returns a hex representation of the bytecode of the given object, replacing unlinked
 	/// addresses by placeholders. This output is lowercase.
 	std::string toHex() const;
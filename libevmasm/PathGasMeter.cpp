@@ -28,12 +28,26 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+PathGasMeter::PathGasMeter(
+	AssemblyItems const& _items,
+	langutil::EVMVersion _evmVersion,
+	shared_ptr<TagPositions const> _tagPositions,
+	optional<size_t> _maxPaths
+):
+	m_tagPositions(_tagPositions ? std::move(_tagPositions) : tagPositions(_items)),
+	m_items(_items),
+	m_evmVersion(_evmVersion),
+	m_maxPaths(_maxPaths)
 {
-	for (size_t i = 0; i < m_items.size(); ++i)
-		if (m_items[i].type() == Tag)
-			m_tagPositions[m_items[i].data()] = i;
+}
+
+shared_ptr<PathGasMeter::TagPositions const> PathGasMeter::tagPositions(AssemblyItems const& _items)
+{
+	auto positions = make_shared<TagPositions>();
+	for (size_t i = 0; i < _items.size(); ++i)
+		if (_items[i].type() == Tag)
+			(*positions)[_items[i].data()] = i;
+	return positions;
 }
 
 GasMeter::GasConsumption PathGasMeter::estimateMax(
@@ -47,8 +61,13 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	queue(std::move(path));
 
 	GasMeter::GasConsumption gas;
+	size_t exploredPaths = 0;
 	while (!m_queue.empty() && !gas.isInfinite)
+	{
+		if (m_maxPaths && exploredPaths++ >= *m_maxPaths)
+			return GasMeter::GasConsumption::infinite();
 		gas = max(gas, handleQueueItem());
+	}
 	return gas;
 }
 
@@ -123,8 +142,8 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		{
 			auto newPath = make_unique<GasPath>();
 			newPath->index = m_items.size();
-			if (m_tagPositions.count(tag))
-				newPath->index = m_tagPositions.at(tag);
+			if (auto position = m_tagPositions->find(tag); position != m_tagPositions->end())
+				newPath->index = position->second;
 			newPath->gas = gas;
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
 			newPath->state = state->copy();
@@ -26,9 +26,11 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
+#include <memory>
+#include <optional>
 #include <set>
 #include <vector>
-#include <memory>
 
 namespace solidity::evmasm
 {
@@ -52,7 +54,19 @@ struct GasPath
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// Map of tag -> position of the tag in the list of assembly items.
+	using TagPositions = std::map<u256, size_t>;
+
+	/// @param _tagPositions the positions of the tags in @a _items, which are computed if not given.
+	/// Passing them allows sharing them between the meters of several functions of the same code.
+	/// @param _maxPaths the maximal number of paths to explore. If more paths are needed,
+	/// the gas usage is reported as infinite.
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		std::shared_ptr<TagPositions const> _tagPositions = nullptr,
+		std::optional<size_t> _maxPaths = std::nullopt
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
@@ -60,12 +74,17 @@ public:
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
 		size_t _startIndex,
-		std::shared_ptr<KnownState> const& _state
+		std::shared_ptr<KnownState> const& _state,
+		std::shared_ptr<TagPositions const> _tagPositions = nullptr,
+		std::optional<size_t> _maxPaths = std::nullopt
 	)
 	{
-		return PathGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
+		return PathGasMeter(_items, _evmVersion, std::move(_tagPositions), _maxPaths).estimateMax(_startIndex, _state);
 	}
 
+	/// @returns the positions of the tags in @a _items.
+	static std::shared_ptr<TagPositions const> tagPositions(AssemblyItems const& _items);
+
 private:
 	/// Adds a new path item to the queue, but only if we do not already have
 	/// a higher gas usage at that point.
@@ -78,9 +97,10 @@ private:
 	/// item per jumpdest, because of the behaviour of `queue` above.
 	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
 	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
-	std::map<u256, size_t> m_tagPositions;
+	std::shared_ptr<TagPositions const> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	std::optional<size_t> m_maxPaths;
 };
 
 }
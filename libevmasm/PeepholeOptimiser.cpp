@@ -25,6 +25,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -39,6 +41,10 @@ struct OptimiserState
 	AssemblyItems const& items;
 	size_t i;
 	back_insert_iterator<AssemblyItems> out;
+	/// Set if any method other than the identity has been applied.
+	bool changed = false;
+	/// Number of applications of each method, in the order in which they are tried.
+	array<size_t, 32> applications{};
 };
 
 template<typename FunctionType>
@@ -52,6 +58,10 @@ struct FunctionParameterCount<R(Args...)>
 template <class Method>
 struct SimplePeepholeOptimizerMethod
 {
+	/// @returns false if the method cannot apply to a window starting with @a _item.
+	/// Only inspects the type and instruction of the item, which is used to build the
+	/// dispatch table in PeepholeMethods.
+	static bool startsWith(AssemblyItem const&) { return true; }
 	template <size_t... Indices>
 	static bool applyRule(
 		AssemblyItems::const_iterator _in,
@@ -79,6 +89,7 @@ struct SimplePeepholeOptimizerMethod
 
 struct Identity: SimplePeepholeOptimizerMethod<Identity>
 {
+	static constexpr char const* name{"Identity"};
 	static bool applySimple(
 		AssemblyItem const& _item,
 		back_insert_iterator<AssemblyItems> _out
@@ -91,6 +102,15 @@ struct Identity: SimplePeepholeOptimizerMethod<Identity>
 
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
+	static constexpr char const* name{"PushPop"};
+	static bool startsWith(AssemblyItem const& _push)
+	{
+		auto t = _push.type();
+		return
+			SemanticInformation::isDupInstruction(_push) ||
+			t == Push || t == PushTag || t == PushSub ||
+			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _pop,
@@ -108,6 +128,8 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 {
+	static constexpr char const* name{"OpPop"};
+	static bool startsWith(AssemblyItem const& _op) { return _op.type() == Operation; }
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -130,6 +152,8 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 
 struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 {
+	static constexpr char const* name{"OpStop"};
+	static bool startsWith(AssemblyItem const& _op) { return _op.type() == Operation || _op.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _stop,
@@ -159,6 +183,8 @@ struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 
 struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 {
+	static constexpr char const* name{"OpReturnRevert"};
+	static bool startsWith(AssemblyItem const& _op) { return _op.type() == Operation || _op.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _push,
@@ -188,6 +214,8 @@ struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 {
+	static constexpr char const* name{"DoubleSwap"};
+	static bool startsWith(AssemblyItem const& _s1) { return SemanticInformation::isSwapInstruction(_s1); }
 	static size_t applySimple(
 		AssemblyItem const& _s1,
 		AssemblyItem const& _s2,
@@ -200,6 +228,8 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 {
+	static constexpr char const* name{"DoublePush"};
+	static bool startsWith(AssemblyItem const& _push1) { return _push1.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _push1,
 		AssemblyItem const& _push2,
@@ -219,6 +249,8 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 {
+	static constexpr char const* name{"CommutativeSwap"};
+	static bool startsWith(AssemblyItem const& _swap) { return _swap == Instruction::SWAP1; }
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -241,6 +273,8 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 {
+	static constexpr char const* name{"SwapComparison"};
+	static bool startsWith(AssemblyItem const& _swap) { return _swap == Instruction::SWAP1; }
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -271,6 +305,8 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 {
+	static constexpr char const* name{"DupSwap"};
+	static bool startsWith(AssemblyItem const& _dupN) { return SemanticInformation::isDupInstruction(_dupN); }
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -294,6 +330,8 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 {
+	static constexpr char const* name{"IsZeroIsZeroJumpI"};
+	static bool startsWith(AssemblyItem const& _iszero1) { return _iszero1 == Instruction::ISZERO; }
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -320,6 +358,8 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 
 struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 {
+	static constexpr char const* name{"EqIsZeroJumpI"};
+	static bool startsWith(AssemblyItem const& _eq) { return _eq == Instruction::EQ; }
 	static size_t applySimple(
 		AssemblyItem const& _eq,
 		AssemblyItem const& _iszero,
@@ -348,6 +388,8 @@ struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 // push_tag_1 jumpi push_tag_2 jump tag_1: -> iszero push_tag_2 jumpi tag_1:
 struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 {
+	static constexpr char const* name{"DoubleJump"};
+	static bool startsWith(AssemblyItem const& _pushTag1) { return _pushTag1.type() == PushTag; }
 	static size_t applySimple(
 		AssemblyItem const& _pushTag1,
 		AssemblyItem const& _jumpi,
@@ -379,6 +421,8 @@ struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 {
+	static constexpr char const* name{"JumpToNext"};
+	static bool startsWith(AssemblyItem const& _pushTag) { return _pushTag.type() == PushTag; }
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -405,6 +449,8 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 {
+	static constexpr char const* name{"TagConjunctions"};
+	static bool startsWith(AssemblyItem const& _pushTag) { return _pushTag.type() == PushTag || _pushTag.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -440,6 +486,8 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 {
+	static constexpr char const* name{"TruthyAnd"};
+	static bool startsWith(AssemblyItem const& _push) { return _push.type() == Push; }
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -458,20 +506,22 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	static constexpr char const* name{"UnreachableCode"};
+	static bool startsWith(AssemblyItem const& _item)
+	{
+		return
+			_item == Instruction::JUMP ||
+			_item == Instruction::RETURN ||
+			_item == Instruction::STOP ||
+			_item == Instruction::INVALID ||
+			_item == Instruction::SELFDESTRUCT ||
+			_item == Instruction::REVERT;
+	}
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
 		auto end = _state.items.end();
-		if (it == end)
-			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
+		if (it == end || !startsWith(it[0]))
 			return false;
 
 		ptrdiff_t i = 1;
@@ -488,17 +538,85 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+/// Applies the first of the given methods that matches at the current position.
+/// The methods are tried in order, but only those that can start with the current item
+/// according to a table indexed by its instruction (or its type for non-operations).
+template <typename... Methods>
+class PeepholeMethods
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
-}
+public:
+	static void apply(OptimiserState& _state)
+	{
+		static DispatchTable const table = dispatchTable();
+		applyMethods<Methods...>(_state, table[dispatchKey(_state.items[_state.i])]);
+	}
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
-{
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
-}
+	/// Adds the number of applications of the methods other than the identity in @a _state
+	/// to @a _methodApplications, indexed by the name of the method.
+	static void countApplications(OptimiserState const& _state, map<string, size_t>& _methodApplications)
+	{
+		static constexpr array<char const*, sizeof...(Methods)> names{{Methods::name...}};
+		for (size_t i = 0; i < names.size(); ++i)
+			if (_state.applications[i] > 0)
+				_methodApplications[names[i]] += _state.applications[i];
+	}
+
+private:
+	static_assert(sizeof...(Methods) <= 32, "Too many peephole methods for the dispatch table.");
+	static constexpr size_t NumDispatchKeys = 0x100 + VerbatimBytecode + 1;
+	using DispatchTable = array<uint32_t, NumDispatchKeys>;
+
+	static size_t dispatchKey(AssemblyItem const& _item)
+	{
+		if (_item.type() == Operation)
+			return static_cast<size_t>(_item.instruction());
+		return 0x100 + static_cast<size_t>(_item.type());
+	}
+
+	/// @returns, for each dispatch key, the set of methods that can start with an item of
+	/// that key as a bit mask, the lowest bit corresponding to the first method.
+	static DispatchTable dispatchTable()
+	{
+		DispatchTable table{};
+		for (size_t key = 0; key < NumDispatchKeys; ++key)
+		{
+			AssemblyItem item = key < 0x100 ?
+				AssemblyItem(static_cast<Instruction>(key)) :
+				AssemblyItem(static_cast<AssemblyItemType>(key - 0x100));
+			uint32_t bit = 1;
+			for (bool startsWith: {Methods::startsWith(item)...})
+			{
+				if (startsWith)
+					table[key] |= bit;
+				bit <<= 1;
+			}
+		}
+		return table;
+	}
+
+	template <typename Method, typename... OtherMethods>
+	static void applyMethods(OptimiserState& _state, uint32_t _candidates)
+	{
+		if ((_candidates & 1) && Method::apply(_state))
+		{
+			if constexpr (!is_same_v<Method, Identity>)
+			{
+				_state.changed = true;
+				++_state.applications[sizeof...(Methods) - sizeof...(OtherMethods) - 1];
+			}
+		}
+		else if constexpr (sizeof...(OtherMethods) > 0)
+			applyMethods<OtherMethods...>(_state, _candidates >> 1);
+		else
+			assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	}
+};
+
+using AllMethods = PeepholeMethods<
+	PushPop, OpPop, OpStop, OpReturnRevert, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+	DupSwap, IsZeroIsZeroJumpI, EqIsZeroJumpI, DoubleJump, JumpToNext, UnreachableCode,
+	TagConjunctions, TruthyAnd, Identity
+>;
 
 size_t numberOfPops(AssemblyItems const& _items)
 {
@@ -513,12 +631,13 @@ bool PeepholeOptimiser::optimise()
 	auto const approx = evmasm::Precision::Approximate;
 	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems)};
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+		AllMethods::apply(state);
+	if (!state.changed)
+	{
+		// The items have only been copied, so there is nothing to compare.
+		m_optimisedItems.clear();
+		return false;
+	}
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
@@ -527,6 +646,8 @@ bool PeepholeOptimiser::optimise()
 	))
 	{
 		m_items = std::move(m_optimisedItems);
+		if (m_methodApplications)
+			AllMethods::countApplications(state, *m_methodApplications);
 		return true;
 	}
 	else
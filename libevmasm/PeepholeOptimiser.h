@@ -24,6 +24,8 @@
 #include <vector>
 #include <cstddef>
 #include <iterator>
+#include <map>
+#include <string>
 
 namespace solidity::evmasm
 {
@@ -41,7 +43,12 @@ public:
 class PeepholeOptimiser
 {
 public:
-	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
+	/// @param _methodApplications if not null, the number of applications of each method
+	/// is added to it, indexed by the name of the method.
+	explicit PeepholeOptimiser(AssemblyItems& _items, std::map<std::string, size_t>* _methodApplications = nullptr):
+		m_items(_items),
+		m_methodApplications(_methodApplications)
+	{}
 	virtual ~PeepholeOptimiser() = default;
 
 	bool optimise();
@@ -49,6 +56,7 @@ public:
 private:
 	AssemblyItems& m_items;
 	AssemblyItems m_optimisedItems;
+	std::map<std::string, size_t>* m_methodApplications = nullptr;
 };
 
 }
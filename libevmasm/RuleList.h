@@ -27,6 +27,7 @@
 #include <libevmasm/SimplificationRule.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/FixedU256.h>
 
 #include <boost/multiprecision/detail/min_max.hpp>
 
@@ -85,11 +86,11 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }},
 		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }},
 		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }},
+		{Builtins::DIV(A, B), [=]{ return Word((FixedU256(A.d()) / FixedU256(B.d())).toU256()); }},
 		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
+		{Builtins::MOD(A, B), [=]{ return Word((FixedU256(A.d()) % FixedU256(B.d())).toU256()); }},
 		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::EXP(A, B), [=]{ return Word(FixedU256::exp(FixedU256(A.d()), FixedU256(B.d())).toU256()); }},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
@@ -105,6 +105,22 @@ vector<SemanticInformation::Operation> SemanticInformation::readWriteOperations(
 		op.lengthParameter = 2;
 		return {op};
 	}
+	case Instruction::MCOPY:
+	{
+		assertThrow(memory(_instruction) == Effect::Write, OptimizerException, "");
+		assertThrow(storage(_instruction) == Effect::None, OptimizerException, "");
+		Operation readOperation;
+		readOperation.effect = Effect::Read;
+		readOperation.location = Location::Memory;
+		readOperation.startParameter = 1;
+		readOperation.lengthParameter = 2;
+		Operation writeOperation;
+		writeOperation.effect = Effect::Write;
+		writeOperation.location = Location::Memory;
+		writeOperation.startParameter = 0;
+		writeOperation.lengthParameter = 2;
+		return {readOperation, writeOperation};
+	}
 	case Instruction::STATICCALL:
 	case Instruction::CALL:
 	case Instruction::CALLCODE:
@@ -364,6 +380,7 @@ SemanticInformation::Effect SemanticInformation::memory(Instruction _instruction
 	case Instruction::CODECOPY:
 	case Instruction::EXTCODECOPY:
 	case Instruction::RETURNDATACOPY:
+	case Instruction::MCOPY:
 	case Instruction::MSTORE:
 	case Instruction::MSTORE8:
 	case Instruction::CALL:
@@ -51,6 +51,14 @@ struct SimplificationRule
 	std::function<bool()> feasible;
 };
 
+/// @returns the name of the pattern in the rule list (see RuleList.h) that is assigned
+/// the match group @a _group by the rule sets, i.e. one of A, B, C, W, X, Y and Z.
+inline char matchGroupName(unsigned _group)
+{
+	assertThrow(_group > 0 && _group <= 7, OptimizerException, "Invalid match group.");
+	return " ABCWXYZ"[_group];
+}
+
 template <typename Pattern>
 struct EVMBuiltins
 {
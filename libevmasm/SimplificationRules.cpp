@@ -103,8 +103,9 @@ Pattern::Pattern(Instruction _instruction, std::initializer_list<Pattern> _argum
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups& _matchGroups)
 {
+	assertThrow(_group > 0 && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -115,9 +116,10 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
+		Expression const*& match = (*m_matchGroups)[m_matchGroup];
+		if (!match)
+			match = &_expr;
+		else if (match->id != _expr.id)
 			return false;
 	}
 	assertThrow(m_arguments.size() == 0 || _expr.arguments.size() == m_arguments.size(), OptimizerException, "");
@@ -137,38 +139,31 @@ AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 
 string Pattern::toString() const
 {
-	stringstream s;
+	// Patterns of the rule list are shown with the names they have there, e.g. "ADD(X, 0)".
+	if (m_matchGroup && m_arguments.empty())
+		return string(1, matchGroupName(m_matchGroup));
 	switch (m_type)
 	{
 	case Operation:
-		// Note: This function is exclusively used for debugging.
-		s << instructionInfo(m_instruction, EVMVersion()).name;
-		break;
+	{
+		string result = instructionInfo(m_instruction, EVMVersion()).name + "(";
+		for (size_t i = 0; i < m_arguments.size(); ++i)
+			result += (i > 0 ? ", " : "") + m_arguments[i].toString();
+		return result + ")";
+	}
 	case Push:
-		if (m_data)
-			s << "PUSH " << hex << data();
-		else
-			s << "PUSH ";
-		break;
+		return m_data ? formatNumber(data()) : "PUSH";
 	case UndefinedItem:
-		s << "ANY";
-		break;
+		return "ANY";
 	default:
+	{
+		stringstream s;
+		s << "t=" << dec << m_type;
 		if (m_data)
-			s << "t=" << dec << m_type << " d=" << hex << data();
-		else
-			s << "t=" << dec << m_type << " d: nullptr";
-		break;
+			s << " d=" << hex << data();
+		return s.str();
+	}
 	}
-	if (!m_requireDataMatch)
-		s << " ~";
-	if (m_matchGroup)
-		s << "[" << dec << m_matchGroup << "]";
-	s << "(";
-	for (Pattern const& p: m_arguments)
-		s << p.toString() << ", ";
-	s << ")";
-	return s.str();
 }
 
 bool Pattern::matchesBaseItem(AssemblyItem const* _item) const
@@ -29,6 +29,7 @@
 
 #include <libsolutil/CommonData.h>
 
+#include <array>
 #include <functional>
 #include <vector>
 
@@ -42,6 +43,10 @@ namespace solidity::evmasm
 
 class Pattern;
 
+/// Expressions bound to the match groups of a rule, indexed by the match group number.
+/// Match group zero means "no match group" and is unused.
+using MatchGroups = std::array<ExpressionClasses::Expression const*, 8>;
+
 /**
  * Container for all simplification rules.
  */
@@ -71,9 +76,9 @@ private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
+	MatchGroups m_matchGroups{};
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
 	std::vector<SimplificationRule<Pattern>> m_rules[256];
@@ -107,7 +112,7 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
 
@@ -119,6 +124,7 @@ public:
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 const& d() const { return matchGroupValue().item->data(); }
 
+	/// @returns the pattern in the syntax of the rule list, e.g. "ADD(X, 0)".
 	std::string toString() const;
 
 	AssemblyItemType type() const { return m_type; }
@@ -139,7 +145,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups* m_matchGroups = nullptr;
 };
 
 /**
@@ -0,0 +1,194 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file TailMerger.cpp
+ * Lets code paths that end in the same instructions up to a REVERT or RETURN share one copy of them.
+ */
+
+#include <libevmasm/TailMerger.h>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <map>
+#include <optional>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+
+namespace
+{
+
+/// @returns true if @a _item can be part of a tail, i.e. it is not a tag, does not alter the
+/// control flow and does not depend on its position in the code.
+bool canBePartOfTail(AssemblyItem const& _item)
+{
+	switch (_item.type())
+	{
+	case Operation:
+		return
+			_item != Instruction::PC &&
+			_item != Instruction::JUMPDEST &&
+			!SemanticInformation::altersControlFlow(_item);
+	case UndefinedItem:
+	case Tag:
+	case VerbatimBytecode:
+		return false;
+	default:
+		return true;
+	}
+}
+
+/// @returns an estimation of the code size in bytes needed for @a _items.
+uint64_t codeSize(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end)
+{
+	uint64_t size = 0;
+	for (auto it = _begin; it != _end; ++it)
+		size += it->bytesRequired(2, Precision::Approximate);
+	return size;
+}
+
+}
+
+bool TailMerger::optimise()
+{
+	// Tags to insert in front of an item and jumps to a tag that replace
+	// the items up to the given end, indexed by the position of the first item.
+	map<size_t, AssemblyItem> newTags;
+	map<size_t, pair<size_t, AssemblyItem>> jumps;
+
+	vector<Tail> keptTails;
+	for (Tail const& tail: findTails())
+	{
+		Tail const* target = nullptr;
+		size_t length = 0;
+		for (Tail const& other: keptTails)
+			if (size_t otherLength = commonSuffixLength(tail, other); otherLength > length)
+			{
+				target = &other;
+				length = otherLength;
+			}
+		if (!target)
+		{
+			keptTails.emplace_back(tail);
+			continue;
+		}
+
+		size_t targetPosition = target->end + 1 - length;
+		optional<AssemblyItem> tag;
+		if (AssemblyItem const* newTag = util::valueOrNullptr(newTags, targetPosition))
+			tag = *newTag;
+		else if (
+			targetPosition == target->start &&
+			targetPosition > 0 &&
+			m_items[targetPosition - 1].type() == Tag
+		)
+			// The common items form the whole block behind an existing tag.
+			tag = m_items[targetPosition - 1];
+
+		if (!worthMerging(tail, length, !tag))
+		{
+			keptTails.emplace_back(tail);
+			continue;
+		}
+		if (!tag)
+			tag = newTags.emplace(targetPosition, m_newTag()).first->second;
+		jumps.emplace(tail.end + 1 - length, make_pair(tail.end, *tag));
+	}
+
+	if (jumps.empty())
+		return false;
+
+	AssemblyItems items;
+	items.reserve(m_items.size() + newTags.size());
+	for (size_t index = 0; index < m_items.size(); ++index)
+	{
+		if (AssemblyItem const* tag = util::valueOrNullptr(newTags, index))
+			items.emplace_back(*tag);
+		if (auto const* jump = util::valueOrNullptr(jumps, index))
+		{
+			auto const& [end, tag] = *jump;
+			langutil::SourceLocation const& location = m_items[index].location();
+			items.emplace_back(AssemblyItem(PushTag, tag.data(), location));
+			items.emplace_back(AssemblyItem(Instruction::JUMP, location));
+			index = end;
+		}
+		else
+			items.emplace_back(std::move(m_items[index]));
+	}
+	m_items = std::move(items);
+	return true;
+}
+
+vector<TailMerger::Tail> TailMerger::findTails() const
+{
+	vector<Tail> tails;
+	size_t start = 0;
+	for (size_t index = 0; index < m_items.size(); ++index)
+	{
+		AssemblyItem const& item = m_items[index];
+		if (item == Instruction::REVERT || item == Instruction::RETURN)
+			tails.emplace_back(Tail{start, index});
+		if (!canBePartOfTail(item))
+			start = index + 1;
+	}
+	return tails;
+}
+
+size_t TailMerger::commonSuffixLength(Tail const& _tail, Tail const& _other) const
+{
+	size_t length = 0;
+	while (
+		length <= _tail.end - _tail.start &&
+		length <= _other.end - _other.start &&
+		m_items[_tail.end - length] == m_items[_other.end - length]
+	)
+		++length;
+	return length;
+}
+
+bool TailMerger::worthMerging(Tail const& _tail, size_t _length, bool _needsNewTag) const
+{
+	static AssemblyItems const jumpPattern{AssemblyItem{PushTag}, AssemblyItem{Instruction::JUMP}};
+	static AssemblyItems const jumpDestination{AssemblyItem{Tag}};
+
+	auto end = m_items.begin() + static_cast<ptrdiff_t>(_tail.end) + 1;
+	uint64_t removedSize = codeSize(end - static_cast<ptrdiff_t>(_length), end);
+	uint64_t addedSize =
+		codeSize(jumpPattern.begin(), jumpPattern.end()) +
+		(_needsNewTag ? codeSize(jumpDestination.begin(), jumpDestination.end()) : 0);
+	if (removedSize <= addedSize)
+		return false;
+
+	// Reverting paths are assumed not to be executed in the lifetime of the contract.
+	if (m_items[_tail.end] == Instruction::REVERT)
+		return true;
+
+	GasMeter gasMeter{make_shared<KnownState>(), m_evmVersion};
+	GasMeter::GasConsumption jumpCost;
+	for (AssemblyItem const& item: jumpPattern + jumpDestination)
+		jumpCost += gasMeter.estimateMax(item, false);
+	if (jumpCost.isInfinite)
+		return false;
+	bigint additionalExecutionCost = bigint(m_isCreation ? 1 : m_runs) * jumpCost.value;
+	return GasMeter::dataGas(removedSize - addedSize, m_isCreation, m_evmVersion) > additionalExecutionCost;
+}
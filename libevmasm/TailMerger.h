@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * @file TailMerger.h
+ * Lets code paths that end in the same instructions up to a REVERT or RETURN share one copy of them.
+ */
+#pragma once
+
+#include <libevmasm/AssemblyItem.h>
+#include <liblangutil/EVMVersion.h>
+
+#include <functional>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/**
+ * Optimizer class that reduces code size by merging common tails of code paths that end in
+ * ``REVERT`` or ``RETURN``, for example the code that reverts with a panic code or an error.
+ *
+ * A tail is a sequence of items that contains no tags, no jumps and no instructions that depend
+ * on their position in the code, followed by ``REVERT`` or ``RETURN``. If a tail ends in the same
+ * items as an earlier one, these items are replaced by a jump to a new tag in front of the same
+ * items of the earlier tail. Since the jump does not change the stack, the shared items operate
+ * on the same stack as before, independent of the stack height at the jump.
+ *
+ * Tails are merged if this reduces the deposit cost. Since reverting paths are not executed in
+ * successful transactions, only the additional execution cost of common ``RETURN`` tails is
+ * weighed against the saved deposit cost.
+ *
+ * Modifies the passed vector in place.
+ */
+class TailMerger
+{
+public:
+	/// @param _newTag is called to create a new tag of the assembly.
+	TailMerger(
+		AssemblyItems& _items,
+		std::function<AssemblyItem()> _newTag,
+		size_t _runs,
+		bool _isCreation,
+		langutil::EVMVersion _evmVersion
+	):
+		m_items(_items),
+		m_newTag(std::move(_newTag)),
+		m_runs(_runs),
+		m_isCreation(_isCreation),
+		m_evmVersion(_evmVersion)
+	{}
+
+	/// @returns true if something was changed.
+	bool optimise();
+
+private:
+	/// Item range [start, end] where the item at end is REVERT or RETURN.
+	struct Tail
+	{
+		size_t start = 0;
+		size_t end = 0;
+	};
+
+	/// @returns the tails in the order of their appearance.
+	std::vector<Tail> findTails() const;
+	/// @returns the number of items at the end of @a _tail and @a _other that are equal.
+	size_t commonSuffixLength(Tail const& _tail, Tail const& _other) const;
+	/// @returns true if replacing the last @a _length items of @a _tail with a jump saves gas.
+	bool worthMerging(Tail const& _tail, size_t _length, bool _needsNewTag) const;
+
+	AssemblyItems& m_items;
+	std::function<AssemblyItem()> m_newTag;
+	size_t m_runs;
+	bool m_isCreation;
+	langutil::EVMVersion m_evmVersion;
+};
+
+}
@@ -102,19 +102,33 @@ string CharStream::lineAtPosition(int _position) const
 
 LineColumn CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
+	size_t searchPosition = min<size_t>(m_source.size(), size_t(_position));
+	vector<size_t> const& starts = lineStarts();
+	// The line is the last one that starts at or before the position.
+	auto line = upper_bound(starts.begin(), starts.end(), searchPosition) - 1;
+	return LineColumn{
+		static_cast<int>(line - starts.begin()),
+		static_cast<int>(searchPosition - *line)
+	};
+}
+
+vector<size_t> const& CharStream::lineStarts() const
+{
+	shared_ptr<vector<size_t> const> starts = atomic_load(&m_lineStarts);
+	if (!starts)
 	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
+		auto newStarts = make_shared<vector<size_t>>(1, 0);
+		for (
+			size_t lineEnd = m_source.find('\n');
+			lineEnd != string::npos;
+			lineEnd = m_source.find('\n', lineEnd + 1)
+		)
+			newStarts->push_back(lineEnd + 1);
+		starts = std::move(newStarts);
+		// If another thread was faster, both computed the same index and either can be used.
+		atomic_store(&m_lineStarts, starts);
 	}
-	return LineColumn{lineNumber, static_cast<int>(searchPosition - lineStart)};
+	return *starts;
 }
 
 string_view CharStream::text(SourceLocation const& _location) const
@@ -137,17 +151,28 @@ string CharStream::singleLineSnippet(string const& _sourceCode, SourceLocation c
 	if (static_cast<size_t>(_location.start) >= _sourceCode.size())
 		return {};
 
-	string cut = _sourceCode.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
+	// Only the first line is copied, since the location may span a whole contract.
+	string_view cut = string_view{_sourceCode}.substr(static_cast<size_t>(_location.start), static_cast<size_t>(_location.end - _location.start));
 	auto newLinePos = cut.find_first_of("\n\r");
-	if (newLinePos != string::npos)
-		cut = cut.substr(0, newLinePos) + "...";
+	if (newLinePos != string_view::npos)
+		return string{cut.substr(0, newLinePos)} + "...";
 
-	return cut;
+	return string{cut};
 }
 
 optional<int> CharStream::translateLineColumnToPosition(LineColumn const& _lineColumn) const
 {
-	return translateLineColumnToPosition(m_source, _lineColumn);
+	vector<size_t> const& starts = lineStarts();
+	if (_lineColumn.line < 0 || static_cast<size_t>(_lineColumn.line) >= starts.size())
+		return nullopt;
+
+	size_t line = static_cast<size_t>(_lineColumn.line);
+	size_t offset = starts[line];
+	size_t endOfLine = line + 1 < starts.size() ? starts[line + 1] - 1 : m_source.size();
+
+	if (offset + static_cast<size_t>(_lineColumn.column) > endOfLine)
+		return nullopt;
+	return offset + static_cast<size_t>(_lineColumn.column);
 }
 
 optional<int> CharStream::translateLineColumnToPosition(std::string const& _text, LineColumn const& _input)
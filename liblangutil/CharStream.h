@@ -51,10 +51,12 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace solidity::langutil
 {
@@ -103,12 +105,13 @@ public:
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
 	std::string lineAtPosition(int _position) const;
+	/// Uses a binary search over the start positions of the lines.
 	LineColumn translatePositionToLineColumn(int _position) const;
 	///@}
 
 	/// Translates a line:column to the absolute position.
+	/// Uses the start positions of the lines.
 	std::optional<int> translateLineColumnToPosition(LineColumn const& _lineColumn) const;
 
 	/// Translates a line:column to the absolute position for the given input text.
@@ -142,10 +145,16 @@ public:
 	static std::string singleLineSnippet(std::string const& _sourceCode, SourceLocation const& _location);
 
 private:
+	/// @returns the positions at which the lines of the source start, in ascending order.
+	/// The first line starts at 0 and every other line right after a '\n'.
+	std::vector<size_t> const& lineStarts() const;
+
 	std::string m_source;
 	std::string m_name;
 	bool m_importedFromAST{false};
 	size_t m_position{0};
+	/// Computed on first use. Accessed atomically, so that a stream can be shared between threads.
+	mutable std::shared_ptr<std::vector<size_t> const> m_lineStarts;
 };
 
 }
@@ -17,7 +17,7 @@
 namespace solidity::langutil
 {
 
-inline bool isDecimalDigit(char c)
+constexpr bool isDecimalDigit(char c)
 {
 	return '0' <= c && c <= '9';
 }
@@ -30,17 +30,17 @@ inline bool isHexDigit(char c)
 		('A' <= c && c <= 'F');
 }
 
-inline bool isWhiteSpace(char c)
+constexpr bool isWhiteSpace(char c)
 {
 	return c == ' ' || c == '\n' || c == '\t' || c == '\r';
 }
 
-inline bool isIdentifierStart(char c)
+constexpr bool isIdentifierStart(char c)
 {
 	return c == '_' || c == '$' || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
 }
 
-inline bool isIdentifierPart(char c)
+constexpr bool isIdentifierPart(char c)
 {
 	return isIdentifierStart(c) || isDecimalDigit(c);
 }
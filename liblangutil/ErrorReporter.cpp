@@ -29,6 +29,15 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 
+namespace
+{
+
+ErrorId const c_tooManyWarnings = 4591_error;
+ErrorId const c_tooManyInfos = 2833_error;
+ErrorId const c_tooManyErrors = 4013_error;
+
+}
+
 ErrorReporter& ErrorReporter::operator=(ErrorReporter const& _errorReporter)
 {
 	if (&_errorReporter == this)
@@ -37,6 +46,18 @@ ErrorReporter& ErrorReporter::operator=(ErrorReporter const& _errorReporter)
 	return *this;
 }
 
+void ErrorReporter::appendWithLimits(ErrorList const& _errorList)
+{
+	for (auto const& error: _errorList)
+		if (error->errorId() == c_tooManyErrors)
+			// The other reporter saw one error too many. Counting that error here throws
+			// because this reporter has seen at least as many errors.
+			checkForExcessiveErrors(Error::Type::TypeError);
+		else if (error->errorId() != c_tooManyWarnings && error->errorId() != c_tooManyInfos)
+			if (!checkForExcessiveErrors(error->type()))
+				m_errorList.push_back(error);
+}
+
 void ErrorReporter::warning(ErrorId _error, string const& _description)
 {
 	error(_error, Error::Type::Warning, SourceLocation(), _description);
@@ -89,7 +110,7 @@ bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
 		m_warningCount++;
 
 		if (m_warningCount == c_maxWarningsAllowed)
-			m_errorList.push_back(make_shared<Error>(4591_error, Error::Type::Warning, "There are more than 256 warnings. Ignoring the rest."));
+			m_errorList.push_back(make_shared<Error>(c_tooManyWarnings, Error::Type::Warning, "There are more than 256 warnings. Ignoring the rest."));
 
 		if (m_warningCount >= c_maxWarningsAllowed)
 			return true;
@@ -99,7 +120,7 @@ bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
 		m_infoCount++;
 
 		if (m_infoCount == c_maxInfosAllowed)
-			m_errorList.push_back(make_shared<Error>(2833_error, Error::Type::Info, "There are more than 256 infos. Ignoring the rest."));
+			m_errorList.push_back(make_shared<Error>(c_tooManyInfos, Error::Type::Info, "There are more than 256 infos. Ignoring the rest."));
 
 		if (m_infoCount >= c_maxInfosAllowed)
 			return true;
@@ -110,7 +131,7 @@ bool ErrorReporter::checkForExcessiveErrors(Error::Type _type)
 
 		if (m_errorCount > c_maxErrorsAllowed)
 		{
-			m_errorList.push_back(make_shared<Error>(4013_error, Error::Type::Warning, "There are more than 256 errors. Aborting."));
+			m_errorList.push_back(make_shared<Error>(c_tooManyErrors, Error::Type::Warning, "There are more than 256 errors. Aborting."));
 			BOOST_THROW_EXCEPTION(FatalError());
 		}
 	}
@@ -53,6 +53,12 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Appends the errors collected by another reporter as if they had been reported to this
+	/// one, i.e. subject to the limits on the number of errors. The notices about excessive
+	/// errors found in @a _errorList are regenerated based on the counts of this reporter,
+	/// including the fatal error thrown when there are too many errors.
+	void appendWithLimits(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
@@ -246,11 +246,63 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 		return _else;
 }
 
+namespace
+{
+
+/// Character classes used by the fast paths below, which scan the raw source
+/// instead of advancing one character at a time.
+enum CharClass: uint8_t
+{
+	WhiteSpace = 1,
+	IdentifierPart = 2,
+	/// Bytes that may start a line terminator, including the lead bytes of the
+	/// UTF-8 encodings of NEL, LS and PS.
+	LinebreakStart = 4
+};
+
+constexpr array<uint8_t, 256> makeCharClasses()
+{
+	array<uint8_t, 256> classes{};
+	for (size_t i = 0; i < classes.size(); ++i)
+	{
+		char c = static_cast<char>(i);
+		if (isWhiteSpace(c))
+			classes[i] |= WhiteSpace;
+		if (isIdentifierPart(c))
+			classes[i] |= IdentifierPart;
+		if ((0x0a <= i && i <= 0x0d) || i == 0xc2 || i == 0xe2)
+			classes[i] |= LinebreakStart;
+	}
+	return classes;
+}
+
+constexpr array<uint8_t, 256> charClasses = makeCharClasses();
+
+/// @returns the first position at or after @a _position whose character does not satisfy @a _predicate,
+/// or the size of @a _source if there is none.
+template <typename Predicate>
+size_t skipWhile(string const& _source, size_t _position, Predicate _predicate)
+{
+	char const* data = _source.data();
+	size_t const size = _source.size();
+	while (_position < size && _predicate(static_cast<uint8_t>(data[_position])))
+		++_position;
+	return _position;
+}
+
+}
+
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
+	// The current character can differ from the source (after multi-line comments),
+	// so it has to be looked at before switching to the source text.
+	if (isWhiteSpace(m_char) && advance())
+		m_char = m_source.setPosition(skipWhile(
+			m_source.source(),
+			sourcePos(),
+			[](uint8_t _c) { return (charClasses[_c] & WhiteSpace) != 0; }
+		));
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -312,9 +364,15 @@ Token Scanner::skipSingleLineComment()
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
 	size_t startPosition = m_source.position();
-	while (!isUnicodeLinebreak())
-		if (!advance())
-			break;
+	string const& source = m_source.source();
+	// Jump to the next byte that could start a line terminator and only then
+	// apply the full check.
+	while (!isUnicodeLinebreak() && advance())
+		m_char = m_source.setPosition(skipWhile(
+			source,
+			sourcePos(),
+			[](uint8_t _c) { return (charClasses[_c] & LinebreakStart) == 0; }
+		));
 
 	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
 	if (unicodeDirectionError != ScannerError::NoError)
@@ -392,26 +450,25 @@ size_t Scanner::scanSingleLineDocComment()
 Token Scanner::skipMultiLineComment()
 {
 	size_t startPosition = m_source.position();
-	while (!isSourcePastEndOfInput())
+	// The search for the terminator is delegated to the (vectorised) library routines.
+	size_t endPosition = m_source.source().find("*/", startPosition);
+	if (endPosition == string::npos)
 	{
-		char prevChar = m_char;
-		advance();
+		// Unterminated multi-line comment.
+		m_char = m_source.setPosition(m_source.size());
+		return setError(ScannerError::IllegalCommentTerminator);
+	}
 
-		// If we have reached the end of the multi-line comment, we
-		// consume the '/' and insert a whitespace. This way all
-		// multi-line comments are treated as whitespace.
-		if (prevChar == '*' && m_char == '/')
-		{
-			ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
-			if (unicodeDirectionError != ScannerError::NoError)
-				return setError(unicodeDirectionError);
+	// If we have reached the end of the multi-line comment, we
+	// consume the '/' and insert a whitespace. This way all
+	// multi-line comments are treated as whitespace.
+	m_source.setPosition(endPosition + 1);
+	ScannerError unicodeDirectionError = validateBiDiMarkup(m_source, startPosition);
+	if (unicodeDirectionError != ScannerError::NoError)
+		return setError(unicodeDirectionError);
 
-			m_char = ' ';
-			return Token::Whitespace;
-		}
-	}
-	// Unterminated multi-line comment.
-	return setError(ScannerError::IllegalCommentTerminator);
+	m_char = ' ';
+	return Token::Whitespace;
 }
 
 Token Scanner::scanMultiLineDocComment()
@@ -1015,10 +1072,16 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
-	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_kind == ScannerKind::Yul))
-		addLiteralCharAndAdvance();
+	// Scan the rest of the identifier characters and copy them in one go.
+	size_t const startPosition = sourcePos();
+	bool const allowDots = m_kind == ScannerKind::Yul;
+	size_t const endPosition = skipWhile(
+		m_source.source(),
+		startPosition + 1,
+		[allowDots](uint8_t _c) { return (charClasses[_c] & IdentifierPart) != 0 || (allowDots && _c == '.'); }
+	);
+	m_tokens[NextNext].literal.append(m_source.source(), startPosition, endPosition - startPosition);
+	m_char = m_source.setPosition(endPosition);
 	literal.complete();
 	auto const token = TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 	if (m_kind == ScannerKind::Yul)
@@ -103,7 +103,7 @@ class Scanner
 public:
 	explicit Scanner(CharStream& _source):
 		m_source(_source),
-		m_sourceName{std::make_shared<std::string>(_source.name())}
+		m_sourceName{internSourceName(_source.name())}
 	{
 		reset();
 	}
@@ -261,7 +261,7 @@ private:
 	TokenDesc m_tokens[3] = {}; // desc for the current, next and nextnext token
 
 	CharStream& m_source;
-	std::shared_ptr<std::string const> m_sourceName;
+	std::string const* m_sourceName = nullptr;
 
 	ScannerKind m_kind = ScannerKind::Solidity;
 
@@ -22,12 +22,23 @@
 #include <boost/algorithm/string.hpp>
 
 #include <iostream>
+#include <mutex>
+#include <set>
 
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace std;
 
-SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<shared_ptr<string const>> const& _sourceNames)
+string const* solidity::langutil::internSourceName(string const& _sourceName)
+{
+	// The set is never destroyed, so that locations stay valid during static destruction.
+	static auto* sourceNames = new set<string>();
+	static mutex sourceNamesMutex;
+	lock_guard lock(sourceNamesMutex);
+	return &*sourceNames->insert(_sourceName).first;
+}
+
+SourceLocation solidity::langutil::parseSourceLocation(string const& _input, vector<string const*> const& _sourceNames)
 {
 	// Expected input: "start:length:sourceindex"
 	enum SrcElem: size_t { Start, Length, Index };
@@ -32,6 +32,12 @@
 namespace solidity::langutil
 {
 
+/// Interns @a _sourceName for the lifetime of the process, so that source locations
+/// can refer to their source through a plain pointer instead of a reference-counted one.
+/// Safe to call concurrently.
+/// @returns a pointer to the interned copy, equal for all calls with the same name.
+std::string const* internSourceName(std::string const& _sourceName);
+
 /**
  * Representation of an interval of source positions.
  * The interval includes start and excludes end.
@@ -75,11 +81,11 @@ struct SourceLocation
 
 	bool equalSources(SourceLocation const& _other) const
 	{
-		if (!!sourceName != !!_other.sourceName)
-			return false;
-		if (sourceName && *sourceName != *_other.sourceName)
+		if (sourceName == _other.sourceName)
+			return true;
+		if (!sourceName || !_other.sourceName)
 			return false;
-		return true;
+		return *sourceName == *_other.sourceName;
 	}
 
 	bool isValid() const { return sourceName || start != -1 || end != -1; }
@@ -108,12 +114,13 @@ struct SourceLocation
 
 	int start = -1;
 	int end = -1;
-	std::shared_ptr<std::string const> sourceName;
+	/// Name of the source, usually obtained from internSourceName().
+	std::string const* sourceName = nullptr;
 };
 
 SourceLocation parseSourceLocation(
 	std::string const& _input,
-	std::vector<std::shared_ptr<std::string const>> const& _sourceNames
+	std::vector<std::string const*> const& _sourceNames
 );
 
 /// Stream output for Location (used e.g. in boost exceptions).
@@ -35,6 +35,7 @@ public:
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description)
 	{
+		++m_reportCount;
 		if (!seen(_error, _location, _description))
 		{
 			m_errorReporter.warning(_error, _location, _description);
@@ -49,6 +50,7 @@ public:
 		SecondarySourceLocation const& _secondaryLocation
 	)
 	{
+		++m_reportCount;
 		if (!seen(_error, _location, _description))
 		{
 			m_errorReporter.warning(_error, _location, _description, _secondaryLocation);
@@ -58,11 +60,13 @@ public:
 
 	void warning(ErrorId _error, std::string const& _description)
 	{
+		++m_reportCount;
 		m_errorReporter.warning(_error, _description);
 	}
 
 	void info(ErrorId _error, SourceLocation const& _location, std::string const& _description)
 	{
+		++m_reportCount;
 		if (!seen(_error, _location, _description))
 		{
 			m_errorReporter.info(_error, _location, _description);
@@ -72,6 +76,7 @@ public:
 
 	void info(ErrorId _error, std::string const& _description)
 	{
+		++m_reportCount;
 		m_errorReporter.info(_error, _description);
 	}
 
@@ -93,12 +98,16 @@ public:
 
 	ErrorList const& errors() const { return m_errorReporter.errors(); }
 
+	/// @returns the number of errors reported so far, including the duplicates that were removed.
+	size_t reportCount() const { return m_reportCount; }
+
 	void clear() { m_errorReporter.clear(); }
 
 private:
 	ErrorList m_uniqueErrors;
 	ErrorReporter m_errorReporter;
 	std::map<std::pair<ErrorId, SourceLocation>, std::string> m_seenErrors;
+	size_t m_reportCount = 0;
 };
 
 }
@@ -41,13 +41,15 @@ CHCSmtLib2Interface::CHCSmtLib2Interface(
 	map<h256, string> const& _queryResponses,
 	ReadCallback::Callback _smtCallback,
 	SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	CompilationCache* _queryCache
 ):
 	CHCSolverInterface(_queryTimeout),
 	m_smtlib2(make_unique<SMTLib2Interface>(_queryResponses, _smtCallback, m_queryTimeout)),
 	m_queryResponses(std::move(_queryResponses)),
 	m_smtCallback(_smtCallback),
-	m_enabledSolvers(_enabledSolvers)
+	m_enabledSolvers(_enabledSolvers),
+	m_queryCache(_queryCache, "chc-smtlib2")
 {
 	reset();
 }
@@ -55,6 +57,8 @@ CHCSmtLib2Interface::CHCSmtLib2Interface(
 void CHCSmtLib2Interface::reset()
 {
 	m_accumulatedOutput.clear();
+	m_ruleRanges.clear();
+	m_slicer.clear();
 	m_variables.clear();
 	m_unhandledQueries.clear();
 	m_sortNames.clear();
@@ -78,26 +82,31 @@ void CHCSmtLib2Interface::registerRelation(Expression const& _expr)
 			" Bool)"
 		);
 	}
+	m_slicer.addRelation(_expr.name);
 }
 
 void CHCSmtLib2Interface::addRule(Expression const& _expr, std::string const& /*_name*/)
 {
+	size_t begin = m_accumulatedOutput.size();
 	write(
 		"(assert\n(forall " + forall() + "\n" +
 		m_smtlib2->toSExpr(_expr) +
 		"))\n\n"
 	);
+	m_ruleRanges.emplace_back(begin, m_accumulatedOutput.size());
+	solAssert(m_slicer.addRule(_expr) + 1 == m_ruleRanges.size());
 }
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface::query(Expression const& _block)
 {
+	string sliced = slicedOutput(_block);
 	string accumulated{};
 	swap(m_accumulatedOutput, accumulated);
 	solAssert(m_smtlib2, "");
 	writeHeader();
 	for (auto const& decl: m_smtlib2->userSorts() | ranges::views::values)
 		write(decl);
-	m_accumulatedOutput += accumulated;
+	m_accumulatedOutput += sliced;
 
 	string queryRule = "(assert\n(forall " + forall() + "\n" +
 		"(=> " + _block.name + " false)"
@@ -123,6 +132,29 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> CHCSmtLib2Interface
 	return {result, Expression(true), {}};
 }
 
+string CHCSmtLib2Interface::slicedOutput(Expression const& _query) const
+{
+	HornSlicer::Slice slice = m_slicer.slice(_query);
+	if (slice.rules.size() == m_ruleRanges.size())
+		return m_accumulatedOutput;
+
+	// Declarations are kept, only the rules that cannot reach the query are left out.
+	vector<bool> keep(m_ruleRanges.size(), false);
+	for (size_t rule: slice.rules)
+		keep[rule] = true;
+	string output;
+	size_t position = 0;
+	for (size_t rule = 0; rule < m_ruleRanges.size(); ++rule)
+		if (!keep[rule])
+		{
+			auto [begin, end] = m_ruleRanges[rule];
+			output.append(m_accumulatedOutput, position, begin - position);
+			position = end;
+		}
+	output.append(m_accumulatedOutput, position, string::npos);
+	return output;
+}
+
 void CHCSmtLib2Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort);
@@ -206,12 +238,19 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
 
+	if (auto cachedResponse = m_queryCache.load(_input))
+		return *cachedResponse;
+
 	smtAssert(m_enabledSolvers.smtlib2 || m_enabledSolvers.eld);
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (QueryCache::definitiveSmtLib2Response(result.responseOrErrorMessage))
+				m_queryCache.store(_input, result.responseOrErrorMessage);
 			return result.responseOrErrorMessage;
+		}
 	}
 
 	m_unhandledQueries.push_back(_input);
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/HornSlicer.h>
 
 #include <libsmtutil/SMTLib2Interface.h>
 
@@ -36,7 +37,8 @@ public:
 		std::map<util::h256, std::string> const& _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		frontend::CompilationCache* _queryCache = nullptr
 	);
 
 	void reset();
@@ -46,6 +48,7 @@ public:
 	void addRule(Expression const& _expr, std::string const& _name) override;
 
 	/// Takes a function application _expr and checks for reachability.
+	/// Only the rules _expr depends on are sent to the solver.
 	/// @returns solving result, an invariant, and counterexample graph, if possible.
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
@@ -65,6 +68,8 @@ private:
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
 	void write(std::string _data);
+	/// @returns the accumulated output without the rules @a _query does not depend on.
+	std::string slicedOutput(Expression const& _query) const;
 
 	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
 	std::string querySolver(std::string const& _input);
@@ -73,6 +78,9 @@ private:
 	std::unique_ptr<SMTLib2Interface> m_smtlib2;
 
 	std::string m_accumulatedOutput;
+	/// Range of each rule in m_accumulatedOutput, indexed like the rules of m_slicer.
+	std::vector<std::pair<size_t, size_t>> m_ruleRanges;
+	HornSlicer m_slicer;
 	std::set<std::string> m_variables;
 
 	std::map<util::h256, std::string> const& m_queryResponses;
@@ -82,6 +90,8 @@ private:
 	SMTSolverChoice m_enabledSolvers;
 
 	std::map<Sort const*, std::string> m_sortNames;
+
+	QueryCache m_queryCache;
 };
 
 }
@@ -59,8 +59,21 @@ public:
 		Expression const& _expr
 	) = 0;
 
+	/// Sets the timeout of the following queries in milliseconds.
+	virtual void setTimeout(unsigned _timeout) { m_queryTimeout = _timeout; }
+
+	/// Sets whether the following queries return the invariants of safe queries and
+	/// the counterexample graphs of unsafe ones, or only the solving result.
+	void setQueryDetails(bool _invariants, bool _counterexamples)
+	{
+		m_invariantsRequested = _invariants;
+		m_counterexamplesRequested = _counterexamples;
+	}
+
 protected:
 	std::optional<unsigned> m_queryTimeout;
+	bool m_invariantsRequested = true;
+	bool m_counterexamplesRequested = true;
 };
 
 }
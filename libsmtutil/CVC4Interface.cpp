@@ -38,6 +38,7 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_translations.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -46,6 +47,12 @@ void CVC4Interface::reset()
 		m_solver.setResourceLimit(resourceLimit);
 }
 
+void CVC4Interface::setTimeout(unsigned _timeout)
+{
+	SolverInterface::setTimeout(_timeout);
+	m_solver.setTimeLimit(_timeout);
+}
+
 void CVC4Interface::push()
 {
 	m_solver.push();
@@ -59,6 +66,8 @@ void CVC4Interface::pop()
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	if (m_variables.count(_name))
+		m_translations.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
 }
 
@@ -122,7 +131,34 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	try
+	{
+		m_solver.interrupt();
+	}
+	catch (CVC4::Exception const&)
+	{
+		// Thrown if the solver is not inside a query any more.
+	}
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	// Copies of an expression share their arguments, so that a subexpression
+	// occurring many times is only translated once.
+	auto key = make_tuple(_expr.arguments.id(), _expr.name, _expr.sort.get());
+	if (auto it = m_translations.find(key); it != m_translations.end())
+		return it->second.second;
+	CVC4::Expr result = translate(_expr);
+	m_translations.emplace(std::move(key), make_pair(_expr, result));
+	return result;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
 	if (_expr.arguments.empty() && m_variables.count(_expr.name))
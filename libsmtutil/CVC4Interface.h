@@ -54,9 +54,13 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	void setTimeout(unsigned _timeout) override;
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// Translates @a _expr, whose arguments are translated via the cache of toCVC4Expr.
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
@@ -64,6 +68,11 @@ private:
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
 
+	/// Translations of expressions with arguments, keyed by the identifier of their shared arguments,
+	/// their name and their sort. The expressions are kept so that the identifiers are not reused.
+	/// Cleared whenever a variable is declared again.
+	std::map<std::tuple<void const*, std::string, Sort const*>, std::pair<Expression, CVC4::Expr>> m_translations;
+
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	// The tests start failing for CVC4 with less than 6000,
@@ -0,0 +1,109 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/HornSlicer.h>
+
+#include <algorithm>
+#include <stack>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+
+void HornSlicer::clear()
+{
+	m_relations.clear();
+	m_ruleBodies.clear();
+	m_rulesByHead.clear();
+	m_unconditionalRules.clear();
+}
+
+size_t HornSlicer::addRule(Expression const& _rule)
+{
+	size_t index = m_ruleBodies.size();
+	bool implication = _rule.name == "=>" && _rule.arguments.size() == 2;
+	Expression const& head = implication ? _rule.arguments[1] : _rule;
+
+	set<string> body;
+	if (implication)
+		collectRelations(_rule.arguments[0], body);
+	m_ruleBodies.emplace_back(std::move(body));
+
+	if (m_relations.count(head.name))
+		m_rulesByHead[head.name].push_back(index);
+	else
+	{
+		// Keep everything the head mentions reachable, so that the slice stays sound.
+		collectRelations(head, m_ruleBodies.back());
+		m_unconditionalRules.push_back(index);
+	}
+	return index;
+}
+
+HornSlicer::Slice HornSlicer::slice(Expression const& _query) const
+{
+	Slice result;
+	stack<string> toVisit;
+	auto visitRelations = [&](set<string> const& _relations) {
+		for (auto const& relation: _relations)
+			if (result.relations.insert(relation).second)
+				toVisit.push(relation);
+	};
+
+	set<string> queried;
+	collectRelations(_query, queried);
+	visitRelations(queried);
+	for (size_t rule: m_unconditionalRules)
+	{
+		result.rules.push_back(rule);
+		visitRelations(m_ruleBodies.at(rule));
+	}
+
+	while (!toVisit.empty())
+	{
+		string relation = std::move(toVisit.top());
+		toVisit.pop();
+		if (auto rules = m_rulesByHead.find(relation); rules != m_rulesByHead.end())
+			for (size_t rule: rules->second)
+			{
+				result.rules.push_back(rule);
+				visitRelations(m_ruleBodies.at(rule));
+			}
+	}
+
+	sort(result.rules.begin(), result.rules.end());
+	return result;
+}
+
+void HornSlicer::collectRelations(Expression const& _expr, set<string>& _relations) const
+{
+	// Subexpressions are shared between rules, so every argument list is only visited once.
+	set<void const*> visited;
+	stack<Expression const*> toVisit;
+	toVisit.push(&_expr);
+	while (!toVisit.empty())
+	{
+		Expression const& expr = *toVisit.top();
+		toVisit.pop();
+		if (m_relations.count(expr.name))
+			_relations.insert(expr.name);
+		if (!expr.arguments.empty() && visited.insert(expr.arguments.id()).second)
+			for (auto const& argument: expr.arguments)
+				toVisit.push(&argument);
+	}
+}
@@ -0,0 +1,75 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Dependency graph between the relations of a Horn system.
+ * A query only depends on the rules whose head relation can reach the queried relation,
+ * so all other rules can be left out when the system is sent to the solver.
+ */
+class HornSlicer
+{
+public:
+	/// Rules and relations a query depends on.
+	struct Slice
+	{
+		/// Indices of the rules, in the order in which they were added.
+		std::vector<size_t> rules;
+		/// Relations that occur in these rules or in the query.
+		std::set<std::string> relations;
+	};
+
+	void clear();
+
+	void addRelation(std::string const& _name) { m_relations.insert(_name); }
+
+	/// Adds the rule @a _rule, which is either an implication whose consequent is the head
+	/// or just the head (a fact).
+	/// @returns the index of the rule.
+	size_t addRule(Expression const& _rule);
+
+	size_t ruleCount() const { return m_ruleBodies.size(); }
+
+	/// @returns the rules and relations the query @a _query depends on.
+	Slice slice(Expression const& _query) const;
+
+private:
+	/// Inserts the relations applied in @a _expr into @a _relations.
+	void collectRelations(Expression const& _expr, std::set<std::string>& _relations) const;
+
+	std::set<std::string> m_relations;
+	/// Relations occurring in the body of each rule, indexed by rule.
+	std::vector<std::set<std::string>> m_ruleBodies;
+	/// Rules indexed by the relation in their head.
+	std::map<std::string, std::vector<size_t>> m_rulesByHead;
+	/// Rules whose head is not a relation application. Every query depends on them.
+	std::vector<size_t> m_unconditionalRules;
+};
+
+}
@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <optional>
+#include <string>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Answers of a solver to queries, kept in a compilation cache so that they survive
+ * across compiler runs.
+ * Only answers that are fully determined by the query should be stored, i.e. no answers
+ * that depend on a wall-clock timeout.
+ */
+class QueryCache
+{
+public:
+	/// @param _cache the cache to use, or nullptr to disable caching.
+	/// @param _solver identifies the solver and all of its settings that affect its answers.
+	QueryCache(frontend::CompilationCache* _cache = nullptr, std::string _solver = {}):
+		m_cache(_cache), m_solver(std::move(_solver))
+	{}
+
+	bool enabled() const { return m_cache != nullptr; }
+
+	/// @returns true if the response of an SMT-LIB2 solver starts with SAT or UNSAT.
+	static bool definitiveSmtLib2Response(std::string const& _response)
+	{
+		return boost::starts_with(_response, "sat") || boost::starts_with(_response, "unsat");
+	}
+
+	std::optional<std::string> load(std::string const& _query) const
+	{
+		if (!m_cache)
+			return std::nullopt;
+		return m_cache->load(key(_query));
+	}
+
+	void store(std::string const& _query, std::string const& _answer) const
+	{
+		if (m_cache)
+			m_cache->store(key(_query), _answer);
+	}
+
+private:
+	util::h256 key(std::string const& _query) const
+	{
+		return util::keccak256("smt-query\n" + m_solver + "\n" + _query);
+	}
+
+	frontend::CompilationCache* m_cache = nullptr;
+	std::string m_solver;
+};
+
+}
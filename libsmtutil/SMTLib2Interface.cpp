@@ -42,11 +42,13 @@ using namespace solidity::smtutil;
 SMTLib2Interface::SMTLib2Interface(
 	map<h256, string> _queryResponses,
 	ReadCallback::Callback _smtCallback,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	CompilationCache* _queryCache
 ):
 	SolverInterface(_queryTimeout),
 	m_queryResponses(std::move(_queryResponses)),
-	m_smtCallback(std::move(_smtCallback))
+	m_smtCallback(std::move(_smtCallback)),
+	m_queryCache(_queryCache, "smtlib2")
 {
 	reset();
 }
@@ -56,6 +58,7 @@ void SMTLib2Interface::reset()
 	m_accumulatedOutput.clear();
 	m_accumulatedOutput.emplace_back();
 	m_variables.clear();
+	m_translations.clear();
 	m_userSorts.clear();
 	write("(set-option :produce-models true)");
 	if (m_queryTimeout)
@@ -143,6 +146,20 @@ string SMTLib2Interface::toSExpr(Expression const& _expr)
 	if (_expr.arguments.empty())
 		return _expr.name;
 
+	// Copies of an expression share their arguments, so that a subexpression
+	// occurring many times is only translated once.
+	auto key = make_tuple(_expr.arguments.id(), _expr.name, _expr.sort.get());
+	if (auto it = m_translations.find(key); it != m_translations.end())
+		return it->second.second;
+	string sexpr = translate(_expr);
+	m_translations.emplace(std::move(key), make_pair(_expr, sexpr));
+	return sexpr;
+}
+
+string SMTLib2Interface::translate(Expression const& _expr)
+{
+	smtAssert(!_expr.arguments.empty());
+
 	std::string sexpr = "(";
 	if (_expr.name == "int2bv")
 	{
@@ -313,11 +330,17 @@ string SMTLib2Interface::querySolver(string const& _input)
 	h256 inputHash = keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	if (auto cachedResponse = m_queryCache.load(_input))
+		return *cachedResponse;
 	if (m_smtCallback)
 	{
 		auto result = m_smtCallback(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), _input);
 		if (result.success)
+		{
+			if (QueryCache::definitiveSmtLib2Response(result.responseOrErrorMessage))
+				m_queryCache.store(_input, result.responseOrErrorMessage);
 			return result.responseOrErrorMessage;
+		}
 	}
 	m_unhandledQueries.push_back(_input);
 	return "unknown\n";
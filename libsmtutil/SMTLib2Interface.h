@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 
 #include <libsolidity/interface/ReadFile.h>
@@ -29,6 +30,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace solidity::smtutil
@@ -44,7 +46,8 @@ public:
 	explicit SMTLib2Interface(
 		std::map<util::h256, std::string> _queryResponses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		frontend::CompilationCache* _queryCache = nullptr
 	);
 
 	void reset() override;
@@ -71,6 +74,9 @@ public:
 private:
 	void declareFunction(std::string const& _name, SortPointer const& _sort);
 
+	/// Translates @a _expr, whose arguments are translated via the cache of toSExpr.
+	std::string translate(Expression const& _expr);
+
 	void write(std::string _data);
 
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
@@ -82,6 +88,10 @@ private:
 	std::vector<std::string> m_accumulatedOutput;
 	std::map<std::string, SortPointer> m_variables;
 
+	/// Translations of expressions with arguments, keyed by the identifier of their shared arguments,
+	/// their name and their sort. The expressions are kept so that the identifiers are not reused.
+	std::map<std::tuple<void const*, std::string, Sort const*>, std::pair<Expression, std::string>> m_translations;
+
 	/// Each pair in this vector represents an SMTChecker created
 	/// sort (a user sort), and the smtlib2 declaration of that sort.
 	/// It needs to be a vector so that the declaration order is kept,
@@ -92,6 +102,7 @@ private:
 	std::vector<std::string> m_unhandledQueries;
 
 	frontend::ReadCallback::Callback m_smtCallback;
+	QueryCache m_queryCache;
 };
 
 }
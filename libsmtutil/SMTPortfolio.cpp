@@ -26,6 +26,10 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <exception>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,15 +40,18 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _raceSolvers,
+	frontend::CompilationCache* _queryCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_raceSolvers(_raceSolvers)
 {
 	if (_enabledSolvers.smtlib2)
-		m_solvers.emplace_back(make_unique<SMTLib2Interface>(std::move(_smtlib2Responses), std::move(_smtCallback), m_queryTimeout));
+		m_solvers.emplace_back(make_unique<SMTLib2Interface>(std::move(_smtlib2Responses), std::move(_smtCallback), m_queryTimeout, _queryCache));
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
-		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout, _queryCache));
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
@@ -58,6 +65,13 @@ void SMTPortfolio::reset()
 		s->reset();
 }
 
+void SMTPortfolio::setTimeout(unsigned _timeout)
+{
+	SolverInterface::setTimeout(_timeout);
+	for (auto const& s: m_solvers)
+		s->setTimeout(_timeout);
+}
+
 void SMTPortfolio::push()
 {
 	for (auto const& s: m_solvers)
@@ -112,9 +126,14 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * If the solvers race each other, the first answer wins and rule 2) does not apply.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	if (m_raceSolvers && m_solvers.size() > 1)
+		return race(_expressionsToEvaluate);
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
 	for (auto const& s: m_solvers)
@@ -141,6 +160,68 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 	return make_pair(lastResult, finalValues);
 }
 
+pair<CheckResult, vector<string>> SMTPortfolio::race(vector<Expression> const& _expressionsToEvaluate)
+{
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size(), {CheckResult::ERROR, {}});
+	vector<exception_ptr> exceptions(m_solvers.size());
+	// Protects everything below.
+	mutex mutex;
+	vector<bool> running(m_solvers.size(), false);
+	optional<size_t> winner;
+
+	auto runSolver = [&](size_t _index) {
+		{
+			lock_guard<std::mutex> lock(mutex);
+			if (winner)
+			{
+				results[_index].first = CheckResult::UNKNOWN;
+				return;
+			}
+			running[_index] = true;
+		}
+		pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+		try
+		{
+			result = m_solvers[_index]->check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			exceptions[_index] = current_exception();
+		}
+		lock_guard<std::mutex> lock(mutex);
+		running[_index] = false;
+		results[_index] = std::move(result);
+		if (!winner && solverAnswered(results[_index].first))
+		{
+			winner = _index;
+			// Only interrupt solvers that are still inside a query, so that the
+			// interruption cannot affect their next query.
+			for (size_t i = 0; i < m_solvers.size(); ++i)
+				if (running[i])
+					m_solvers[i]->interrupt();
+		}
+	};
+
+	// The first solver runs on the calling thread. This is the SMT-LIB2 interface, if enabled,
+	// which cannot be interrupted and invokes the callback, which is not required to be thread-safe.
+	vector<thread> threads;
+	for (size_t i = 1; i < m_solvers.size(); ++i)
+		threads.emplace_back(runSolver, i);
+	runSolver(0);
+	for (auto& thread: threads)
+		thread.join();
+
+	for (auto const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+	if (winner)
+		return std::move(results[*winner]);
+	for (auto const& [result, values]: results)
+		if (result == CheckResult::UNKNOWN)
+			return make_pair(result, vector<string>{});
+	return make_pair(CheckResult::ERROR, vector<string>{});
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
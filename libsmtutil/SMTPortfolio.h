@@ -20,6 +20,7 @@
 
 
 #include <libsmtutil/SolverInterface.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
 
@@ -34,6 +35,8 @@ namespace solidity::smtutil
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Alternatively, the solvers can race each other on every query, in which case
+ * the first definitive answer is used and no conflicts are detected.
  */
 class SMTPortfolio: public SolverInterface
 {
@@ -46,7 +49,9 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _raceSolvers = false,
+		frontend::CompilationCache* _queryCache = nullptr
 	);
 
 	void reset() override;
@@ -60,12 +65,18 @@ public:
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void setTimeout(unsigned _timeout) override;
+
 	std::vector<std::string> unhandledQueries() override;
 	size_t solvers() override { return m_solvers.size(); }
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Runs all solvers concurrently and interrupts the others as soon as one of them answers.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	bool m_raceSolvers = false;
 
 	std::vector<Expression> m_assertions;
 };
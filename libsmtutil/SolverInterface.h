@@ -115,10 +115,48 @@ enum class CheckResult
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// The arguments of an expression are immutable and shared between its copies, so that
+/// expressions form a DAG and copying one does not copy its subexpressions.
 class Expression
 {
 	friend class SolverInterface;
 public:
+	/// Read-only list of the arguments of an expression, whose elements are shared
+	/// by all copies of the list.
+	class Arguments
+	{
+	public:
+		using const_iterator = std::vector<Expression>::const_iterator;
+
+		Arguments() = default;
+		Arguments(std::vector<Expression> _arguments):
+			m_arguments(_arguments.empty() ? nullptr : std::make_shared<std::vector<Expression> const>(std::move(_arguments)))
+		{}
+
+		bool empty() const { return !m_arguments; }
+		size_t size() const { return m_arguments ? m_arguments->size() : 0; }
+		Expression const& operator[](size_t _index) const { return (*m_arguments)[_index]; }
+		Expression const& at(size_t _index) const { return vector().at(_index); }
+		Expression const& front() const { return vector().front(); }
+		Expression const& back() const { return vector().back(); }
+		const_iterator begin() const { return vector().begin(); }
+		const_iterator end() const { return vector().end(); }
+		std::vector<Expression> const& vector() const
+		{
+			static std::vector<Expression> const noArguments;
+			return m_arguments ? *m_arguments : noArguments;
+		}
+		operator std::vector<Expression> const&() const { return vector(); }
+
+		/// @returns an identifier of the shared list, which is the same for all copies of it
+		/// and null for an empty list. Solver interfaces use it to translate shared
+		/// subexpressions only once.
+		void const* id() const { return m_arguments.get(); }
+
+	private:
+		std::shared_ptr<std::vector<Expression> const> m_arguments;
+	};
+
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	explicit Expression(std::shared_ptr<SortSort> _sort, std::string _name = ""): Expression(std::move(_name), {}, _sort) {}
 	explicit Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
@@ -485,7 +523,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	Arguments arguments;
 	SortPointer sort;
 
 private:
@@ -530,6 +568,14 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to @a check that is running on another thread to stop as soon as possible,
+	/// in which case it reports UNKNOWN. Solvers that cannot be interrupted ignore this.
+	virtual void interrupt() {}
+
+	/// Sets the timeout of the following queries in milliseconds.
+	/// Interfaces that write the timeout into the query text only apply it after the next reset.
+	virtual void setTimeout(unsigned _timeout) { m_queryTimeout = _timeout; }
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
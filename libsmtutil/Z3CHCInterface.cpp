@@ -27,11 +27,45 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
-Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout):
+namespace
+{
+
+/// Z3Interface that records the variables declared on it.
+class RecordingZ3Interface: public Z3Interface
+{
+public:
+	RecordingZ3Interface(optional<unsigned> _queryTimeout, vector<Z3CHCInterface::Operation>& _operations):
+		Z3Interface(_queryTimeout),
+		m_operations(_operations)
+	{}
+
+	void declareVariable(string const& _name, SortPointer const& _sort) override
+	{
+		m_operations.push_back({Z3CHCInterface::Operation::Kind::DeclareVariable, _name, _sort});
+		Z3Interface::declareVariable(_name, _sort);
+	}
+
+private:
+	vector<Z3CHCInterface::Operation>& m_operations;
+};
+
+}
+
+Z3CHCInterface::Z3CHCInterface(
+	optional<unsigned> _queryTimeout,
+	bool _recordOperations,
+	frontend::CompilationCache* _queryCache
+):
 	CHCSolverInterface(_queryTimeout),
-	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
+	m_z3Interface(
+		_recordOperations ?
+		make_unique<RecordingZ3Interface>(m_queryTimeout, m_operations) :
+		make_unique<Z3Interface>(m_queryTimeout)
+	),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_recordOperations(_recordOperations),
+	m_queryCache(_queryCache, _queryCache ? "chc " + Z3Interface::settings(_queryTimeout) : "")
 {
 	Z3_get_version(
 		&get<0>(m_version),
@@ -59,40 +93,83 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
+	if (m_recordOperations)
+		m_operations.push_back({Operation::Kind::RegisterRelation, {}, {}, _expr});
 	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	m_slicer.addRelation(_expr.name);
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
+	if (m_recordOperations)
+		m_operations.push_back({Operation::Kind::AddRule, _name, {}, _expr});
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
-	if (m_z3Interface->constants().empty())
-		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
-	else
+	if (!m_z3Interface->constants().empty())
 	{
 		z3::expr_vector variables(*m_context);
 		for (auto const& var: m_z3Interface->constants())
 			variables.push_back(var.second);
-		z3::expr boundRule = z3::forall(variables, rule);
-		m_solver.add_rule(boundRule, m_context->str_symbol(_name.c_str()));
+		rule = z3::forall(variables, rule);
 	}
+	m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
+	m_rules.emplace_back(rule, _name);
+	smtAssert(m_slicer.addRule(_expr) + 1 == m_rules.size());
 }
 
 tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(Expression const& _expr)
+{
+	HornSlicer::Slice slice = m_slicer.slice(_expr);
+	if (slice.rules.size() == m_rules.size())
+		return query(m_solver, _expr);
+
+	// Rules of unrelated contracts and functions, and those leading to the error blocks
+	// of other targets, cannot reach the query. Leaving them out keeps the system small.
+	z3::fixedpoint slicedSolver(*m_context);
+	slicedSolver.set(spacerOptions());
+	for (auto const& relation: slice.relations)
+		slicedSolver.register_relation(m_z3Interface->functions().at(relation));
+	for (size_t rule: slice.rules)
+		slicedSolver.add_rule(m_rules[rule].first, m_context->str_symbol(m_rules[rule].second.c_str()));
+	return query(slicedSolver, _expr);
+}
+
+tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::query(z3::fixedpoint& _solver, Expression const& _expr)
 {
 	CheckResult result;
+	string query;
 	try
 	{
 		z3::expr z3Expr = m_z3Interface->toZ3Expr(_expr);
-		switch (m_solver.query(z3Expr))
+		if (m_queryCache.enabled())
+		{
+			query =
+				"preprocessing=" + to_string(m_spacerPreProcessing) + "\n" +
+				_solver.to_string() + "\n" +
+				"(query " + z3Expr.to_string() + ")";
+			if (optional<string> cachedAnswer = m_queryCache.load(query))
+			{
+				if (*cachedAnswer == "unsat")
+					return {CheckResult::UNSATISFIABLE, Expression(true), {}};
+				else if (*cachedAnswer == "unknown")
+					return {CheckResult::UNKNOWN, Expression(true), {}};
+				// Cached answers do not carry counterexamples, so they have to be solved again if requested.
+				else if (*cachedAnswer == "sat" && !m_counterexamplesRequested)
+					return {CheckResult::SATISFIABLE, Expression(true), {}};
+			}
+		}
+		switch (_solver.query(z3Expr))
 		{
 		case z3::check_result::sat:
 		{
 			result = CheckResult::SATISFIABLE;
+			m_queryCache.store(query, "sat");
+			if (!m_counterexamplesRequested)
+				break;
 			// z3 version 4.8.8 modified Spacer to also return
 			// proofs containing nonlinear clauses.
 			if (m_version >= tuple(4, 8, 8, 0))
 			{
-				auto proof = m_solver.get_answer();
+				auto proof = _solver.get_answer();
 				return {result, Expression(true), cexGraph(proof)};
 			}
 			break;
@@ -100,12 +177,18 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 		case z3::check_result::unsat:
 		{
 			result = CheckResult::UNSATISFIABLE;
-			auto invariants = m_z3Interface->fromZ3Expr(m_solver.get_answer());
+			m_queryCache.store(query, "unsat");
+			if (!m_invariantsRequested)
+				break;
+			auto invariants = m_z3Interface->fromZ3Expr(_solver.get_answer());
 			return {result, std::move(invariants), {}};
 		}
 		case z3::check_result::unknown:
 		{
 			result = CheckResult::UNKNOWN;
+			// Running out of resources is deterministic, unlike running out of time.
+			if (_solver.reason_unknown() == Z3Interface::resourceLimitExceededMessage)
+				m_queryCache.store(query, "unknown");
 			break;
 		}
 		}
@@ -115,12 +198,16 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 	{
 		set<string> msgs{
 			/// Resource limit (rlimit) exhausted.
-			"max. resource limit exceeded",
+			Z3Interface::resourceLimitExceededMessage,
 			/// User given timeout exhausted.
 			"canceled"
 		};
 		if (msgs.count(_err.msg()))
+		{
 			result = CheckResult::UNKNOWN;
+			if (_err.msg() == string(Z3Interface::resourceLimitExceededMessage) && !query.empty())
+				m_queryCache.store(query, "unknown");
+		}
 		else
 			result = CheckResult::ERROR;
 	}
@@ -128,7 +215,40 @@ tuple<CheckResult, Expression, CHCSolverInterface::CexGraph> Z3CHCInterface::que
 	return {result, Expression(true), {}};
 }
 
+void Z3CHCInterface::setTimeout(unsigned _timeout)
+{
+	CHCSolverInterface::setTimeout(_timeout);
+	m_z3Interface->setTimeout(_timeout);
+}
+
+void Z3CHCInterface::replay(Z3CHCInterface const& _source, size_t _from, size_t _to)
+{
+	smtAssert(_from <= _to && _to <= _source.m_operations.size());
+	for (size_t i = _from; i < _to; ++i)
+	{
+		Operation const& operation = _source.m_operations[i];
+		switch (operation.kind)
+		{
+		case Operation::Kind::DeclareVariable:
+			m_z3Interface->declareVariable(operation.name, operation.sort);
+			break;
+		case Operation::Kind::RegisterRelation:
+			registerRelation(operation.expression);
+			break;
+		case Operation::Kind::AddRule:
+			addRule(operation.expression, operation.name);
+			break;
+		}
+	}
+}
+
 void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
+{
+	m_spacerPreProcessing = _preProcessing;
+	m_solver.set(spacerOptions());
+}
+
+z3::params Z3CHCInterface::spacerOptions() const
 {
 	// Spacer options.
 	// These needs to be set in the solver.
@@ -144,11 +264,11 @@ void Z3CHCInterface::setSpacerOptions(bool _preProcessing)
 	// Spacer optimization should be
 	// - enabled for better solving (default)
 	// - disable for counterexample generation
-	p.set("fp.xform.slice", _preProcessing);
-	p.set("fp.xform.inline_linear", _preProcessing);
-	p.set("fp.xform.inline_eager", _preProcessing);
+	p.set("fp.xform.slice", m_spacerPreProcessing);
+	p.set("fp.xform.inline_linear", m_spacerPreProcessing);
+	p.set("fp.xform.inline_eager", m_spacerPreProcessing);
 
-	m_solver.set(p);
+	return p;
 }
 
 /**
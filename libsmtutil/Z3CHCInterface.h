@@ -23,6 +23,7 @@
 #pragma once
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/HornSlicer.h>
 #include <libsmtutil/Z3Interface.h>
 
 #include <tuple>
@@ -34,7 +35,29 @@ namespace solidity::smtutil
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface(std::optional<unsigned> _queryTimeout = {});
+	/// Call made to the solver while building the Horn system.
+	struct Operation
+	{
+		enum class Kind { DeclareVariable, RegisterRelation, AddRule };
+		Kind kind;
+		/// The name of the variable or of the rule.
+		std::string name;
+		/// The sort of the variable.
+		SortPointer sort;
+		/// The relation or the rule.
+		Expression expression = Expression(true);
+	};
+
+	/// If @a _recordOperations is true, the variable declarations, relations and rules given
+	/// to the solver (including the declarations made directly on @a z3Interface) are
+	/// recorded, so that they can be replayed into other solvers using @a replay.
+	/// If @a _queryCache is given, UNSAT and UNKNOWN answers are stored in it and reused in later runs.
+	/// Answers loaded from the cache do not come with invariants.
+	Z3CHCInterface(
+		std::optional<unsigned> _queryTimeout = {},
+		bool _recordOperations = false,
+		frontend::CompilationCache* _queryCache = nullptr
+	);
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
@@ -43,13 +66,26 @@ public:
 
 	void addRule(Expression const& _expr, std::string const& _name) override;
 
+	/// Queries a Horn system that only contains the rules @a _expr depends on.
 	std::tuple<CheckResult, Expression, CexGraph> query(Expression const& _expr) override;
 
+	void setTimeout(unsigned _timeout) override;
+
 	Z3Interface* z3Interface() const { return m_z3Interface.get(); }
 
 	void setSpacerOptions(bool _preProcessing = true);
 
+	bool recordsOperations() const { return m_recordOperations; }
+	/// @returns the number of recorded operations, which identifies the current state of the Horn system.
+	size_t recordedOperations() const { return m_operations.size(); }
+	/// Performs the operations [_from, _to) recorded by @a _source on this solver.
+	/// Since every solver has its own Z3 context, the solvers can be queried concurrently afterwards.
+	void replay(Z3CHCInterface const& _source, size_t _from, size_t _to);
+
 private:
+	std::tuple<CheckResult, Expression, CexGraph> query(z3::fixedpoint& _solver, Expression const& _expr);
+	z3::params spacerOptions() const;
+
 	/// Constructs a nonlinear counterexample graph from the refutation.
 	CHCSolverInterface::CexGraph cexGraph(z3::expr const& _proof);
 	/// @returns the fact from a proof node.
@@ -65,8 +101,17 @@ private:
 	z3::context* m_context;
 	// Horn solver.
 	z3::fixedpoint m_solver;
+	/// The rules given to m_solver with their names, indexed like the rules of m_slicer.
+	std::vector<std::pair<z3::expr, std::string>> m_rules;
+	HornSlicer m_slicer;
 
 	std::tuple<unsigned, unsigned, unsigned, unsigned> m_version = std::tuple(0, 0, 0, 0);
+
+	bool m_recordOperations = false;
+	std::vector<Operation> m_operations;
+
+	QueryCache m_queryCache;
+	bool m_spacerPreProcessing = true;
 };
 
 }
@@ -21,6 +21,7 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
 
 #ifdef HAVE_Z3_DLOPEN
 #include <libsmtutil/Z3Loader.h>
@@ -39,9 +40,27 @@ bool Z3Interface::available()
 #endif
 }
 
-Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout):
+string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision);
+}
+
+string Z3Interface::settings(std::optional<unsigned> _queryTimeout)
+{
+	return
+		"z3 " + version() + " " +
+		(_queryTimeout ? "timeout=" + to_string(*_queryTimeout) : "rlimit=" + to_string(resourceLimit));
+}
+
+Z3Interface::Z3Interface(std::optional<unsigned> _queryTimeout, frontend::CompilationCache* _queryCache):
 	SolverInterface(_queryTimeout),
-	m_solver(m_context)
+	m_solver(m_context),
+	m_queryCache(_queryCache, _queryCache ? settings(_queryTimeout) : "")
 {
 	// These need to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
@@ -56,9 +75,16 @@ void Z3Interface::reset()
 {
 	m_constants.clear();
 	m_functions.clear();
+	m_translations.clear();
 	m_solver.reset();
 }
 
+void Z3Interface::setTimeout(unsigned _timeout)
+{
+	SolverInterface::setTimeout(_timeout);
+	m_context.set("timeout", int(_timeout));
+}
+
 void Z3Interface::push()
 {
 	m_solver.push();
@@ -75,7 +101,10 @@ void Z3Interface::declareVariable(string const& _name, SortPointer const& _sort)
 	if (_sort->kind == Kind::Function)
 		declareFunction(_name, *_sort);
 	else if (m_constants.count(_name))
+	{
 		m_constants.at(_name) = m_context.constant(_name.c_str(), z3Sort(*_sort));
+		m_translations.clear();
+	}
 	else
 		m_constants.emplace(_name, m_context.constant(_name.c_str(), z3Sort(*_sort)));
 }
@@ -85,7 +114,10 @@ void Z3Interface::declareFunction(string const& _name, Sort const& _sort)
 	smtAssert(_sort.kind == Kind::Function, "");
 	FunctionSort fSort = dynamic_cast<FunctionSort const&>(_sort);
 	if (m_functions.count(_name))
+	{
 		m_functions.at(_name) = m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain));
+		m_translations.clear();
+	}
 	else
 		m_functions.emplace(_name, m_context.function(_name.c_str(), z3Sort(fSort.domain), z3Sort(*fSort.codomain)));
 }
@@ -97,8 +129,20 @@ void Z3Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	string query;
+	if (m_queryCache.enabled())
+	{
+		query = m_solver.to_smt2();
+		for (Expression const& e: _expressionsToEvaluate)
+			query += "\n" + toZ3Expr(e).to_string();
+		if (auto answer = loadCachedAnswer(query))
+			return *answer;
+	}
+
 	CheckResult result;
 	vector<string> values;
+	// Running out of resources is deterministic, unlike running out of time or being interrupted.
+	bool resourceLimitExceeded = false;
 	try
 	{
 		switch (m_solver.check())
@@ -111,6 +155,7 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 			break;
 		case z3::check_result::unknown:
 			result = CheckResult::UNKNOWN;
+			resourceLimitExceeded = m_solver.reason_unknown() == resourceLimitExceededMessage;
 			break;
 		}
 
@@ -125,7 +170,7 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	{
 		set<string> msgs{
 			/// Resource limit (rlimit) exhausted.
-			"max. resource limit exceeded",
+			resourceLimitExceededMessage,
 			/// User given timeout exhausted.
 			"canceled"
 		};
@@ -134,13 +179,71 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 			result = CheckResult::UNKNOWN;
 		else
 			result = CheckResult::ERROR;
+		resourceLimitExceeded = string(_err.msg()) == resourceLimitExceededMessage;
 		values.clear();
 	}
 
+	if (
+		m_queryCache.enabled() &&
+		(result == CheckResult::SATISFIABLE || result == CheckResult::UNSATISFIABLE || resourceLimitExceeded)
+	)
+	{
+		Json::Value answer{Json::objectValue};
+		answer["result"] = result == CheckResult::SATISFIABLE ? "sat" : result == CheckResult::UNSATISFIABLE ? "unsat" : "unknown";
+		answer["values"] = Json::arrayValue;
+		for (string const& value: values)
+			answer["values"].append(value);
+		m_queryCache.store(query, jsonCompactPrint(answer));
+	}
+
 	return make_pair(result, values);
 }
 
+optional<pair<CheckResult, vector<string>>> Z3Interface::loadCachedAnswer(string const& _query)
+{
+	optional<string> cachedAnswer = m_queryCache.load(_query);
+	Json::Value answer;
+	if (!cachedAnswer || !jsonParseStrict(*cachedAnswer, answer) || !answer.isObject() || !answer["values"].isArray())
+		return nullopt;
+
+	static map<string, CheckResult> const results{
+		{"sat", CheckResult::SATISFIABLE},
+		{"unsat", CheckResult::UNSATISFIABLE},
+		{"unknown", CheckResult::UNKNOWN}
+	};
+	if (!answer["result"].isString() || !results.count(answer["result"].asString()))
+		return nullopt;
+	vector<string> values;
+	for (auto const& value: answer["values"])
+	{
+		if (!value.isString())
+			return nullopt;
+		values.push_back(value.asString());
+	}
+	return make_pair(results.at(answer["result"].asString()), std::move(values));
+}
+
+void Z3Interface::interrupt()
+{
+	m_context.interrupt();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+		return translate(_expr);
+
+	// Copies of an expression share their arguments, so that a subexpression
+	// occurring many times is only translated once.
+	auto key = make_tuple(_expr.arguments.id(), _expr.name, _expr.sort.get());
+	if (auto it = m_translations.find(key); it != m_translations.end())
+		return it->second.second;
+	z3::expr result = translate(_expr);
+	m_translations.emplace(std::move(key), make_pair(_expr, result));
+	return result;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
 		return m_constants.at(_expr.name);
@@ -18,9 +18,12 @@
 
 #pragma once
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <z3++.h>
 
+#include <tuple>
+
 namespace solidity::smtutil
 {
 
@@ -31,9 +34,14 @@ public:
 	Z3Interface(Z3Interface const&) = delete;
 	Z3Interface& operator=(Z3Interface const&) = delete;
 
-	Z3Interface(std::optional<unsigned> _queryTimeout = {});
+	/// Answers to queries are stored in @a _queryCache, if given, and reused in later runs.
+	Z3Interface(std::optional<unsigned> _queryTimeout = {}, frontend::CompilationCache* _queryCache = nullptr);
 
 	static bool available();
+	/// @returns the version of the Z3 library in use.
+	static std::string version();
+	/// @returns a description of the Z3 settings that affect the answers to queries.
+	static std::string settings(std::optional<unsigned> _queryTimeout);
 
 	void reset() override;
 
@@ -44,6 +52,8 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+	void setTimeout(unsigned _timeout) override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -56,10 +66,18 @@ public:
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	static int const resourceLimit = 1000000;
+	/// Reason given by Z3 if a query exceeds @a resourceLimit.
+	static constexpr char const* resourceLimitExceededMessage = "max. resource limit exceeded";
 
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	/// Translates @a _expr, whose arguments are translated via the cache of toZ3Expr.
+	z3::expr translate(Expression const& _expr);
+
+	/// @returns the answer to @a _query stored in the query cache, if any.
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> loadCachedAnswer(std::string const& _query);
+
 	z3::sort z3Sort(Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<SortPointer> const& _sorts);
 	smtutil::SortPointer fromZ3Sort(z3::sort const& _sort);
@@ -70,6 +88,13 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+
+	/// Translations of expressions with arguments, keyed by the identifier of their shared arguments,
+	/// their name and their sort. The expressions are kept so that the identifiers are not reused.
+	/// Cleared whenever a variable or function is declared again.
+	std::map<std::tuple<void const*, std::string, Sort const*>, std::pair<Expression, z3::expr>> m_translations;
+
+	QueryCache m_queryCache;
 };
 
 }
@@ -25,10 +25,14 @@
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libyul/YulString.h>
+#include <libsolutil/ThreadPool.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <list>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "license.h"
 
@@ -42,26 +46,54 @@ using solidity::frontend::StandardCompiler;
 namespace
 {
 
-// The strings in this list must not be resized after they have been added here (via solidity_alloc()), because
-// this may potentially change the pointer that was passed to the caller from solidity_alloc().
-static list<string> solidityAllocations;
+/// Strings whose data has been handed out to the caller, guarded by a mutex.
+class Allocations
+{
+public:
+	char* add(string _data)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_allocations.emplace_back(std::move(_data)).data();
+	}
+
+	/// Find the equivalent to @p _data in the list of allocations,
+	/// removes it from the list and returns its value.
+	///
+	/// If any invalid argument is being passed, it is considered a programming error
+	/// on the caller-side and hence, will call abort() then.
+	string take(char const* _data)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (auto iter = begin(m_allocations); iter != end(m_allocations); ++iter)
+			if (iter->data() == _data)
+			{
+				string chunk = std::move(*iter);
+				m_allocations.erase(iter);
+				return chunk;
+			}
+
+		abort();
+	}
+
+	void clear()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_allocations.clear();
+	}
+
+private:
+	mutex m_mutex;
+	// The strings in this list must not be resized after they have been added here, because
+	// this may potentially change the pointer that was passed to the caller.
+	list<string> m_allocations;
+};
+
+/// Allocations of solidity_alloc() and results of solidity_compile().
+Allocations solidityAllocations;
 
-/// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
-/// removes it from the list and returns its value.
-///
-/// If any invalid argument is being passed, it is considered a programming error
-/// on the caller-side and hence, will call abort() then.
 string takeOverAllocation(char const* _data)
 {
-	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
-		if (iter->data() == _data)
-		{
-			string chunk = std::move(*iter);
-			solidityAllocations.erase(iter);
-			return chunk;
-		}
-
-	abort();
+	return solidityAllocations.take(_data);
 }
 
 /// Resizes a std::string to the proper length based on the occurrence of a zero terminator.
@@ -108,12 +140,23 @@ ReadCallback::Callback wrapReadCallback(CStyleReadFileCallback _readCallback, vo
 
 string compile(string _input, CStyleReadFileCallback _readCallback, void* _readContext)
 {
+#ifdef SOLJSON_THREAD_POOL_SIZE
+	// Only the workers started together with the module are available, see cmake/EthCompilerSettings.cmake.
+	// The calling thread takes part in the work as well.
+	ThreadPool::instance().setMaxThreads(min<size_t>(thread::hardware_concurrency(), SOLJSON_THREAD_POOL_SIZE + 1));
+#endif
 	StandardCompiler compiler(wrapReadCallback(_readCallback, _readContext));
 	return compiler.compile(std::move(_input));
 }
 
 }
 
+struct solidity_context
+{
+	/// Results of solidity_compile_ctx() on this context.
+	Allocations results;
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -129,14 +172,14 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return solidityAllocations.add(compile(_input, _readCallback, _readContext));
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return solidityAllocations.add(string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -157,4 +200,36 @@ extern void solidity_reset() noexcept
 	yul::YulStringRepository::reset();
 	solidityAllocations.clear();
 }
+
+extern solidity_context* solidity_create_context() noexcept
+{
+	try
+	{
+		return new solidity_context();
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+extern void solidity_destroy_context(solidity_context* _context) noexcept
+{
+	delete _context;
+}
+
+extern char* solidity_compile_ctx(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	return _context->results.add(compile(_input, _readCallback, _readContext));
+}
+
+extern void solidity_free_ctx(solidity_context* _context, char* _data) noexcept
+{
+	_context->results.take(_data);
+}
 }
@@ -94,8 +94,37 @@ char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback,
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
 /// is invalid after calling this!
+/// This also resets state that is shared by all compilations, so it must not be called while
+/// any other thread is compiling.
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// A compilation context. Compiling with different contexts is safe to do from several threads at once.
+/// solidity_alloc() and solidity_free() are safe to call from any thread as well.
+typedef struct solidity_context solidity_context;
+
+/// Creates a new compilation context.
+///
+/// @returns NULL if the context could not be allocated.
+solidity_context* solidity_create_context() SOLC_NOEXCEPT;
+
+/// Destroys @p _context and frees all results of solidity_compile_ctx() that were not freed yet.
+void solidity_destroy_context(solidity_context* _context) SOLC_NOEXCEPT;
+
+/// Same as solidity_compile(), but within @p _context.
+/// The result is owned by the context and stays valid until it is freed via solidity_free_ctx()
+/// or the context is destroyed. It is not affected by solidity_reset().
+char* solidity_compile_ctx(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Frees a result of solidity_compile_ctx() on @p _context.
+///
+/// Important, this call will abort() in case of any invalid argument being passed to this call.
+void solidity_free_ctx(solidity_context* _context, char* _data) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
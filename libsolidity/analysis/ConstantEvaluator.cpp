@@ -89,12 +89,27 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 			return nullopt;
 		else
 			return _left.numerator() & _right.numerator();
-	case Token::Add: return _left + _right;
-	case Token::Sub: return _left - _right;
-	case Token::Mul: return _left * _right;
+	// Integers are combined directly, which avoids normalising the resulting rational.
+	case Token::Add:
+		if (fractional)
+			return _left + _right;
+		else
+			return _left.numerator() + _right.numerator();
+	case Token::Sub:
+		if (fractional)
+			return _left - _right;
+		else
+			return _left.numerator() - _right.numerator();
+	case Token::Mul:
+		if (fractional)
+			return _left * _right;
+		else
+			return _left.numerator() * _right.numerator();
 	case Token::Div:
 		if (_right == rational(0))
 			return nullopt;
+		else if (!fractional && _left.numerator() % _right.numerator() == 0)
+			return _left.numerator() / _right.numerator();
 		else
 			return _left / _right;
 	case Token::Mod:
@@ -144,10 +159,25 @@ optional<rational> ConstantEvaluator::evaluateBinaryOperator(Token _operator, ra
 					return boost::multiprecision::pow(_base, _exponent);
 			};
 
-			bigint numerator = optimizedPow(_left.numerator(), absExp);
-			bigint denominator = optimizedPow(_left.denominator(), absExp);
+			bigint numerator;
+			bigint denominator = 1;
+			bigint const absBase = abs(_left.numerator());
+			if (_left.denominator() == 1 && boost::multiprecision::lsb(absBase) == boost::multiprecision::msb(absBase))
+			{
+				// Powers of two, e.g. in ``2**k - 1``, are computed by shifting.
+				numerator = bigint(1) << (boost::multiprecision::msb(absBase) * absExp);
+				if (_left < 0 && (absExp & 1))
+					numerator = -numerator;
+			}
+			else
+			{
+				numerator = optimizedPow(_left.numerator(), absExp);
+				denominator = optimizedPow(_left.denominator(), absExp);
+			}
 
-			if (exp >= 0)
+			if (exp >= 0 && denominator == 1)
+				return numerator;
+			else if (exp >= 0)
 				return makeRational(numerator, denominator);
 			else
 				// invert
@@ -23,7 +23,11 @@
 
 #include <range/v3/algorithm/sort.hpp>
 
+#include <boost/dynamic_bitset.hpp>
+
+#include <algorithm>
 #include <functional>
+#include <unordered_map>
 
 using namespace std;
 using namespace std::placeholders;
@@ -63,47 +67,83 @@ void ControlFlowAnalyzer::analyze(FunctionDefinition const& _function, ContractD
 
 void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNode const* _exit, bool _emptyBody, optional<string> _contractName)
 {
-	struct NodeInfo
+	// Number the nodes reachable from the entry in reverse postorder, as well as the variables
+	// and the accesses occurring in them, so that the data flow can be computed on dense bit sets.
+	vector<CFGNode const*> nodes;
 	{
-		set<VariableDeclaration const*> unassignedVariablesAtEntry;
-		set<VariableDeclaration const*> unassignedVariablesAtExit;
-		set<VariableOccurrence const*> uninitializedVariableAccesses;
-		/// Propagate the information from another node to this node.
-		/// To be used to propagate information from a node to its exit nodes.
-		/// Returns true, if new variables were added and thus the current node has
-		/// to be traversed again.
-		bool propagateFrom(NodeInfo const& _entryNode)
+		vector<pair<CFGNode const*, size_t>> stack{{_entry, 0}};
+		set<CFGNode const*> visited{_entry};
+		while (!stack.empty())
 		{
-			size_t previousUnassignedVariablesAtEntry = unassignedVariablesAtEntry.size();
-			size_t previousUninitializedVariableAccessess = uninitializedVariableAccesses.size();
-			unassignedVariablesAtEntry += _entryNode.unassignedVariablesAtExit;
-			uninitializedVariableAccesses += _entryNode.uninitializedVariableAccesses;
-			return
-				unassignedVariablesAtEntry.size() > previousUnassignedVariablesAtEntry ||
-				uninitializedVariableAccesses.size() > previousUninitializedVariableAccessess
-			;
+			auto& [node, nextExit] = stack.back();
+			if (nextExit < node->exits.size())
+			{
+				CFGNode const* exit = node->exits[nextExit++];
+				if (visited.insert(exit).second)
+					stack.emplace_back(exit, 0);
+			}
+			else
+			{
+				nodes.push_back(node);
+				stack.pop_back();
+			}
+		}
+		reverse(nodes.begin(), nodes.end());
+	}
+	unordered_map<CFGNode const*, size_t> nodeIndices;
+	for (size_t i = 0; i < nodes.size(); ++i)
+		nodeIndices[nodes[i]] = i;
+
+	unordered_map<VariableDeclaration const*, size_t> variableIndices;
+	vector<VariableOccurrence const*> accesses;
+	for (CFGNode const* node: nodes)
+		for (auto const& variableOccurrence: node->variableOccurrences)
+		{
+			variableIndices.emplace(&variableOccurrence.declaration(), variableIndices.size());
+			if (
+				variableOccurrence.kind() != VariableOccurrence::Kind::Assignment &&
+				variableOccurrence.kind() != VariableOccurrence::Kind::Declaration
+			)
+				accesses.push_back(&variableOccurrence);
 		}
-	};
-	map<CFGNode const*, NodeInfo> nodeInfos;
-	set<CFGNode const*> nodesToTraverse;
-	nodesToTraverse.insert(_entry);
-
-	// Walk all paths starting from the nodes in ``nodesToTraverse`` until ``NodeInfo::propagateFrom``
-	// returns false for all exits, i.e. until all paths have been walked with maximal sets of unassigned
-	// variables and accesses.
+
+	// For every node, the variables that can be unassigned at its entry and the accesses to
+	// unassigned variables on any path from the function entry up to the end of the node.
+	vector<boost::dynamic_bitset<>> unassignedVariablesAtEntry(nodes.size(), boost::dynamic_bitset<>(variableIndices.size()));
+	vector<boost::dynamic_bitset<>> uninitializedVariableAccesses(nodes.size(), boost::dynamic_bitset<>(accesses.size()));
+	// Index of the first access of every node in ``accesses``.
+	vector<size_t> firstAccess(nodes.size() + 1, 0);
+	for (size_t i = 0; i < nodes.size(); ++i)
+		firstAccess[i + 1] = firstAccess[i] + static_cast<size_t>(count_if(
+			nodes[i]->variableOccurrences.begin(),
+			nodes[i]->variableOccurrences.end(),
+			[](VariableOccurrence const& _occurrence) {
+				return
+					_occurrence.kind() != VariableOccurrence::Kind::Assignment &&
+					_occurrence.kind() != VariableOccurrence::Kind::Declaration;
+			}
+		));
+
+	// Process the nodes in reverse postorder until no set changes any more. Every node has
+	// to be processed at least once, since it might access unassigned variables itself.
+	set<size_t> nodesToTraverse;
+	for (size_t i = 0; i < nodes.size(); ++i)
+		nodesToTraverse.insert(nodesToTraverse.end(), i);
 	while (!nodesToTraverse.empty())
 	{
-		CFGNode const* currentNode = *nodesToTraverse.begin();
+		size_t const current = *nodesToTraverse.begin();
 		nodesToTraverse.erase(nodesToTraverse.begin());
 
-		auto& nodeInfo = nodeInfos[currentNode];
-		auto unassignedVariables = nodeInfo.unassignedVariablesAtEntry;
-		for (auto const& variableOccurrence: currentNode->variableOccurrences)
+		boost::dynamic_bitset<> unassignedVariables = unassignedVariablesAtEntry[current];
+		boost::dynamic_bitset<>& nodeAccesses = uninitializedVariableAccesses[current];
+		size_t accessIndex = firstAccess[current];
+		for (auto const& variableOccurrence: nodes[current]->variableOccurrences)
 		{
+			size_t const variableIndex = variableIndices.at(&variableOccurrence.declaration());
 			switch (variableOccurrence.kind())
 			{
 				case VariableOccurrence::Kind::Assignment:
-					unassignedVariables.erase(&variableOccurrence.declaration());
+					unassignedVariables.reset(variableIndex);
 					break;
 				case VariableOccurrence::Kind::InlineAssembly:
 					// We consider all variables referenced in inline assembly as accessed.
@@ -111,37 +151,41 @@ void ControlFlowAnalyzer::checkUninitializedAccess(CFGNode const* _entry, CFGNod
 					// the control flow in the assembly at some point.
 				case VariableOccurrence::Kind::Access:
 				case VariableOccurrence::Kind::Return:
-					if (unassignedVariables.count(&variableOccurrence.declaration()))
-					{
-						// Merely store the unassigned access. We do not generate an error right away, since this
-						// path might still always revert. It is only an error if this is propagated to the exit
-						// node of the function (i.e. there is a path with an uninitialized access).
-						nodeInfo.uninitializedVariableAccesses.insert(&variableOccurrence);
-					}
+					// Merely store the unassigned access. We do not generate an error right away, since this
+					// path might still always revert. It is only an error if this is propagated to the exit
+					// node of the function (i.e. there is a path with an uninitialized access).
+					if (unassignedVariables.test(variableIndex))
+						nodeAccesses.set(accessIndex);
+					++accessIndex;
 					break;
 				case VariableOccurrence::Kind::Declaration:
-					unassignedVariables.insert(&variableOccurrence.declaration());
+					unassignedVariables.set(variableIndex);
 					break;
 			}
 		}
-		nodeInfo.unassignedVariablesAtExit = std::move(unassignedVariables);
 
 		// Propagate changes to all exits and queue them for traversal, if needed.
-		for (auto const& exit: currentNode->exits)
-			if (
-				auto exists = util::valueOrNullptr(nodeInfos, exit);
-				nodeInfos[exit].propagateFrom(nodeInfo) || !exists
-			)
-				nodesToTraverse.insert(exit);
+		for (CFGNode const* exit: nodes[current]->exits)
+		{
+			size_t const exitIndex = nodeIndices.at(exit);
+			boost::dynamic_bitset<>& exitUnassignedVariables = unassignedVariablesAtEntry[exitIndex];
+			boost::dynamic_bitset<>& exitAccesses = uninitializedVariableAccesses[exitIndex];
+			if (!unassignedVariables.is_subset_of(exitUnassignedVariables) || !nodeAccesses.is_subset_of(exitAccesses))
+			{
+				exitUnassignedVariables |= unassignedVariables;
+				exitAccesses |= nodeAccesses;
+				nodesToTraverse.insert(exitIndex);
+			}
+		}
 	}
 
-	auto const& exitInfo = nodeInfos[_exit];
-	if (!exitInfo.uninitializedVariableAccesses.empty())
+	auto const exitIndex = util::valueOrNullptr(nodeIndices, _exit);
+	if (exitIndex && uninitializedVariableAccesses[*exitIndex].any())
 	{
-		vector<VariableOccurrence const*> uninitializedAccessesOrdered(
-			exitInfo.uninitializedVariableAccesses.begin(),
-			exitInfo.uninitializedVariableAccesses.end()
-		);
+		boost::dynamic_bitset<> const& exitAccesses = uninitializedVariableAccesses[*exitIndex];
+		vector<VariableOccurrence const*> uninitializedAccessesOrdered;
+		for (size_t i = exitAccesses.find_first(); i != boost::dynamic_bitset<>::npos; i = exitAccesses.find_next(i))
+			uninitializedAccessesOrdered.push_back(accesses[i]);
 		ranges::sort(
 			uninitializedAccessesOrdered,
 			[](VariableOccurrence const* lhs, VariableOccurrence const* rhs) -> bool
@@ -29,6 +29,8 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/range/conversion.hpp>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::frontend;
@@ -42,10 +44,10 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (auto it = m_declarations.find(*_name); it != m_declarations.end())
+		declarations += it->second;
+	if (auto it = m_invisibleDeclarations.find(*_name); it != m_invisibleDeclarations.end())
+		declarations += it->second;
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -85,13 +87,15 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	auto invisible = m_invisibleDeclarations.find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		invisible != m_invisibleDeclarations.end() && invisible->second.size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
-	m_invisibleDeclarations.erase(_name);
+	vector<Declaration const*>& declarations = m_declarations[_name];
+	solAssert(declarations.empty(), "");
+	declarations.emplace_back(invisible->second.front());
+	m_invisibleDeclarations.erase(invisible);
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
@@ -150,28 +154,38 @@ vector<Declaration const*> DeclarationContainer::resolveName(
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
 	vector<Declaration const*> result;
 
-	if (m_declarations.count(_name))
+	// Walk up the enclosing containers iteratively until a container has a matching declaration.
+	for (DeclarationContainer const* container = this; container; container = container->m_enclosingContainer)
 	{
-		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_declarations.at(_name);
-	}
+		if (auto it = container->m_declarations.find(_name); it != container->m_declarations.end())
+		{
+			if (_settings.onlyVisibleAsUnqualifiedNames)
+				result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			else
+				result += it->second;
+		}
 
-	if (_settings.alsoInvisible && m_invisibleDeclarations.count(_name))
-	{
-		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_invisibleDeclarations.at(_name);
+		if (_settings.alsoInvisible)
+			if (auto it = container->m_invisibleDeclarations.find(_name); it != container->m_invisibleDeclarations.end())
+			{
+				if (_settings.onlyVisibleAsUnqualifiedNames)
+					result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+				else
+					result += it->second;
+			}
+
+		if (!result.empty() || !_settings.recursive)
+			break;
 	}
 
-	if (result.empty() && _settings.recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, _settings);
-
 	return result;
 }
 
+map<ASTString, vector<Declaration const*>> DeclarationContainer::declarations() const
+{
+	return {m_declarations.begin(), m_declarations.end()};
+}
+
 vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
 {
 
@@ -181,17 +195,16 @@ vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) con
 
 	vector<ASTString> similar;
 	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
-	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
+	for (auto const* declarations: {&m_declarations, &m_invisibleDeclarations})
 	{
-		string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
+		size_t const firstSimilar = similar.size();
+		for (auto const& declaration: *declarations)
+		{
+			string const& declarationName = declaration.first;
+			if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+				similar.push_back(declarationName);
+		}
+		sort(similar.begin() + static_cast<ptrdiff_t>(firstSimilar), similar.end());
 	}
 
 	if (m_enclosingContainer)
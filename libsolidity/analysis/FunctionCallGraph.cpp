@@ -18,7 +18,11 @@
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
 
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTVisitor.h>
+
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/Visitor.h>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/reverse.hpp>
@@ -28,91 +32,34 @@ using namespace std;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const& _contract)
+namespace
 {
-	FunctionCallGraphBuilder builder(_contract);
-	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
-
-	// Create graph for constructor, state vars, etc
-	for (ContractDefinition const* base: _contract.annotation().linearizedBaseContracts | ranges::views::reverse)
-	{
-		// The constructor and functions called in state variable initial assignments should have
-		// an edge from Entry
-		builder.m_currentNode = CallGraph::SpecialNode::Entry;
-		for (auto const* stateVar: base->stateVariables())
-			if (!stateVar->isConstant())
-				stateVar->accept(builder);
-
-		if (base->constructor())
-		{
-			builder.functionReferenced(*base->constructor());
-
-			// Constructors and functions called in state variable initializers have an edge either from
-			// the previous class in linearized order or from Entry if there's no class before.
-			builder.m_currentNode = base->constructor();
-		}
 
-		// Functions called from the inheritance specifier should have an edge from the constructor
-		// for consistency with functions called from constructor modifiers.
-		for (auto const& inheritanceSpecifier: base->baseContracts())
-			inheritanceSpecifier->accept(builder);
-	}
-
-	builder.m_currentNode = CallGraph::SpecialNode::Entry;
-	builder.processQueue();
-
-	return std::move(builder.m_graph);
-}
-
-CallGraph FunctionCallGraphBuilder::buildDeployedGraph(
-	ContractDefinition const& _contract,
-	CallGraph const& _creationGraph
-)
+/// Collects the references in a piece of code without resolving virtual functions.
+class ReferenceCollector: private ASTConstVisitor
 {
-	FunctionCallGraphBuilder builder(_contract);
-	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
-
-	auto getSecondElement = [](auto const& _tuple){ return get<1>(_tuple); };
-
-	// Create graph for all publicly reachable functions
-	for (FunctionTypePointer functionType: _contract.interfaceFunctionList() | ranges::views::transform(getSecondElement))
-	{
-		auto const* function = dynamic_cast<FunctionDefinition const*>(&functionType->declaration());
-		auto const* variable = dynamic_cast<VariableDeclaration const*>(&functionType->declaration());
-
-		if (function)
-			builder.functionReferenced(*function);
-		else
-			// If it's not a function, it must be a getter of a public variable; we ignore those
-			solAssert(variable, "");
-	}
+public:
+	using Reference = FunctionCallGraphBuilder::Reference;
 
-	if (_contract.fallbackFunction())
-		builder.functionReferenced(*_contract.fallbackFunction());
-
-	if (_contract.receiveFunction())
-		builder.functionReferenced(*_contract.receiveFunction());
-
-	// All functions present in internal dispatch at creation time could potentially be pointers
-	// assigned to state variables and as such may be reachable after deployment as well.
-	builder.m_currentNode = CallGraph::SpecialNode::InternalDispatch;
-	set<CallGraph::Node, CallGraph::CompareByID> defaultNode;
-	for (CallGraph::Node const& dispatchTarget: util::valueOrDefault(_creationGraph.edges, CallGraph::SpecialNode::InternalDispatch, defaultNode))
+	static vector<Reference> collect(ASTNode const& _node)
 	{
-		solAssert(!holds_alternative<CallGraph::SpecialNode>(dispatchTarget), "");
-		solAssert(get<CallableDeclaration const*>(dispatchTarget) != nullptr, "");
-
-		// Visit the callable to add not only it but also everything it calls too
-		builder.functionReferenced(*get<CallableDeclaration const*>(dispatchTarget), false);
+		ReferenceCollector collector;
+		_node.accept(collector);
+		return std::move(collector.m_references);
 	}
 
-	builder.m_currentNode = CallGraph::SpecialNode::Entry;
-	builder.processQueue();
+private:
+	bool visit(FunctionCall const& _functionCall) override;
+	bool visit(EmitStatement const& _emitStatement) override;
+	bool visit(Identifier const& _identifier) override;
+	bool visit(MemberAccess const& _memberAccess) override;
+	bool visit(ModifierInvocation const& _modifierInvocation) override;
+	bool visit(NewExpression const& _newExpression) override;
 
-	return std::move(builder.m_graph);
-}
+	vector<Reference> m_references;
+};
 
-bool FunctionCallGraphBuilder::visit(FunctionCall const& _functionCall)
+bool ReferenceCollector::visit(FunctionCall const& _functionCall)
 {
 	if (*_functionCall.annotation().kind != FunctionCallKind::FunctionCall)
 		return true;
@@ -124,31 +71,31 @@ bool FunctionCallGraphBuilder::visit(FunctionCall const& _functionCall)
 		// If it's not a direct call, we don't really know which function will be called (it may even
 		// change at runtime). All we can do is to add an edge to the dispatch which in turn has
 		// edges to all functions could possibly be called.
-		add(m_currentNode, CallGraph::SpecialNode::InternalDispatch);
+		m_references.emplace_back(FunctionCallGraphBuilder::IndirectCall{});
 	else if (functionType->kind() == FunctionType::Kind::Error)
-		m_graph.usedErrors.insert(&dynamic_cast<ErrorDefinition const&>(functionType->declaration()));
+		m_references.emplace_back(&dynamic_cast<ErrorDefinition const&>(functionType->declaration()));
 
 	return true;
 }
 
-bool FunctionCallGraphBuilder::visit(EmitStatement const& _emitStatement)
+bool ReferenceCollector::visit(EmitStatement const& _emitStatement)
 {
 	auto const* functionType = dynamic_cast<FunctionType const*>(_emitStatement.eventCall().expression().annotation().type);
 	solAssert(functionType, "");
 
-	m_graph.emittedEvents.insert(&dynamic_cast<EventDefinition const&>(functionType->declaration()));
+	m_references.emplace_back(&dynamic_cast<EventDefinition const&>(functionType->declaration()));
 
 	return true;
 }
 
-bool FunctionCallGraphBuilder::visit(Identifier const& _identifier)
+bool ReferenceCollector::visit(Identifier const& _identifier)
 {
 	if (auto const* variable = dynamic_cast<VariableDeclaration const*>(_identifier.annotation().referencedDeclaration))
 	{
 		if (variable->isConstant())
 		{
 			solAssert(variable->isStateVariable() || variable->isFileLevelVariable(), "");
-			variable->accept(*this);
+			m_references.emplace_back(FunctionCallGraphBuilder::ConstantReference{variable});
 		}
 	}
 	else if (auto const* callable = dynamic_cast<CallableDeclaration const*>(_identifier.annotation().referencedDeclaration))
@@ -159,13 +106,18 @@ bool FunctionCallGraphBuilder::visit(Identifier const& _identifier)
 
 		// For events kind() == Event, so we have an extra check here
 		if (funType && funType->kind() == FunctionType::Kind::Internal)
-			functionReferenced(callable->resolveVirtual(m_contract), _identifier.annotation().calledDirectly);
+			m_references.emplace_back(FunctionCallGraphBuilder::CallableReference{
+				callable,
+				VirtualLookup::Virtual,
+				nullptr,
+				_identifier.annotation().calledDirectly
+			});
 	}
 
 	return true;
 }
 
-bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
+bool ReferenceCollector::visit(MemberAccess const& _memberAccess)
 {
 	Type const* exprType = _memberAccess.expression().annotation().type;
 	ASTString const& memberName = _memberAccess.memberName();
@@ -176,7 +128,10 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 		))
 		{
 			ContractType const& accessedContractType = dynamic_cast<ContractType const&>(*magicType->typeArgument());
-			m_graph.bytecodeDependency.emplace(&accessedContractType.contractDefinition(), &_memberAccess);
+			m_references.emplace_back(FunctionCallGraphBuilder::BytecodeReference{
+				&accessedContractType.contractDefinition(),
+				&_memberAccess
+			});
 		}
 
 	auto functionType = dynamic_cast<FunctionType const*>(_memberAccess.annotation().type);
@@ -184,6 +139,12 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 	if (!functionType || !functionDef || functionType->kind() != FunctionType::Kind::Internal)
 		return true;
 
+	FunctionCallGraphBuilder::CallableReference reference{
+		functionDef,
+		VirtualLookup::Static,
+		nullptr,
+		_memberAccess.annotation().calledDirectly
+	};
 	// Super functions
 	if (*_memberAccess.annotation().requiredLookup == VirtualLookup::Super)
 	{
@@ -191,45 +152,158 @@ bool FunctionCallGraphBuilder::visit(MemberAccess const& _memberAccess)
 			if (auto const contractType = dynamic_cast<ContractType const*>(typeType->actualType()))
 			{
 				solAssert(contractType->isSuper(), "");
-				functionDef = &functionDef->resolveVirtual(
-					m_contract,
-					contractType->contractDefinition().superContract(m_contract)
-				);
+				reference.lookup = VirtualLookup::Super;
+				reference.superLookupContract = &contractType->contractDefinition();
 			}
 	}
 	else
 		solAssert(*_memberAccess.annotation().requiredLookup == VirtualLookup::Static, "");
 
-	functionReferenced(*functionDef, _memberAccess.annotation().calledDirectly);
+	m_references.emplace_back(reference);
 	return true;
 }
 
-bool FunctionCallGraphBuilder::visit(ModifierInvocation const& _modifierInvocation)
+bool ReferenceCollector::visit(ModifierInvocation const& _modifierInvocation)
 {
 	if (auto const* modifier = dynamic_cast<ModifierDefinition const*>(_modifierInvocation.name().annotation().referencedDeclaration))
 	{
 		VirtualLookup const& requiredLookup = *_modifierInvocation.name().annotation().requiredLookup;
-
-		if (requiredLookup == VirtualLookup::Virtual)
-			functionReferenced(modifier->resolveVirtual(m_contract));
-		else
-		{
-			solAssert(requiredLookup == VirtualLookup::Static, "");
-			functionReferenced(*modifier);
-		}
+		solAssert(requiredLookup == VirtualLookup::Virtual || requiredLookup == VirtualLookup::Static, "");
+		m_references.emplace_back(FunctionCallGraphBuilder::CallableReference{modifier, requiredLookup, nullptr, true});
 	}
 
 	return true;
 }
 
-bool FunctionCallGraphBuilder::visit(NewExpression const& _newExpression)
+bool ReferenceCollector::visit(NewExpression const& _newExpression)
 {
 	if (ContractType const* contractType = dynamic_cast<ContractType const*>(_newExpression.typeName().annotation().type))
-		m_graph.bytecodeDependency.emplace(&contractType->contractDefinition(), &_newExpression);
+		m_references.emplace_back(FunctionCallGraphBuilder::BytecodeReference{&contractType->contractDefinition(), &_newExpression});
 
 	return true;
 }
 
+}
+
+vector<FunctionCallGraphBuilder::Reference> const& FunctionCallGraphBuilder::ReferenceCache::references(ASTNode const& _node)
+{
+	auto it = m_references.find(&_node);
+	if (it == m_references.end())
+		it = m_references.emplace(&_node, ReferenceCollector::collect(_node)).first;
+	return it->second;
+}
+
+CallGraph FunctionCallGraphBuilder::buildCreationGraph(ContractDefinition const& _contract, ReferenceCache* _cache)
+{
+	FunctionCallGraphBuilder builder(_contract, _cache);
+	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
+
+	// Create graph for constructor, state vars, etc
+	for (ContractDefinition const* base: _contract.annotation().linearizedBaseContracts | ranges::views::reverse)
+	{
+		// The constructor and functions called in state variable initial assignments should have
+		// an edge from Entry
+		builder.m_currentNode = CallGraph::SpecialNode::Entry;
+		for (auto const* stateVar: base->stateVariables())
+			if (!stateVar->isConstant())
+				builder.addReferences(*stateVar);
+
+		if (base->constructor())
+		{
+			builder.functionReferenced(*base->constructor());
+
+			// Constructors and functions called in state variable initializers have an edge either from
+			// the previous class in linearized order or from Entry if there's no class before.
+			builder.m_currentNode = base->constructor();
+		}
+
+		// Functions called from the inheritance specifier should have an edge from the constructor
+		// for consistency with functions called from constructor modifiers.
+		for (auto const& inheritanceSpecifier: base->baseContracts())
+			builder.addReferences(*inheritanceSpecifier);
+	}
+
+	builder.m_currentNode = CallGraph::SpecialNode::Entry;
+	builder.processQueue();
+
+	return std::move(builder.m_graph);
+}
+
+CallGraph FunctionCallGraphBuilder::buildDeployedGraph(
+	ContractDefinition const& _contract,
+	CallGraph const& _creationGraph,
+	ReferenceCache* _cache
+)
+{
+	FunctionCallGraphBuilder builder(_contract, _cache);
+	solAssert(builder.m_currentNode == CallGraph::Node(CallGraph::SpecialNode::Entry), "");
+
+	auto getSecondElement = [](auto const& _tuple){ return get<1>(_tuple); };
+
+	// Create graph for all publicly reachable functions
+	for (FunctionTypePointer functionType: _contract.interfaceFunctionList() | ranges::views::transform(getSecondElement))
+	{
+		auto const* function = dynamic_cast<FunctionDefinition const*>(&functionType->declaration());
+		auto const* variable = dynamic_cast<VariableDeclaration const*>(&functionType->declaration());
+
+		if (function)
+			builder.functionReferenced(*function);
+		else
+			// If it's not a function, it must be a getter of a public variable; we ignore those
+			solAssert(variable, "");
+	}
+
+	if (_contract.fallbackFunction())
+		builder.functionReferenced(*_contract.fallbackFunction());
+
+	if (_contract.receiveFunction())
+		builder.functionReferenced(*_contract.receiveFunction());
+
+	// All functions present in internal dispatch at creation time could potentially be pointers
+	// assigned to state variables and as such may be reachable after deployment as well.
+	builder.m_currentNode = CallGraph::SpecialNode::InternalDispatch;
+	set<CallGraph::Node, CallGraph::CompareByID> defaultNode;
+	for (CallGraph::Node const& dispatchTarget: util::valueOrDefault(_creationGraph.edges, CallGraph::SpecialNode::InternalDispatch, defaultNode))
+	{
+		solAssert(!holds_alternative<CallGraph::SpecialNode>(dispatchTarget), "");
+		solAssert(get<CallableDeclaration const*>(dispatchTarget) != nullptr, "");
+
+		// Visit the callable to add not only it but also everything it calls too
+		builder.functionReferenced(*get<CallableDeclaration const*>(dispatchTarget), false);
+	}
+
+	builder.m_currentNode = CallGraph::SpecialNode::Entry;
+	builder.processQueue();
+
+	return std::move(builder.m_graph);
+}
+
+void FunctionCallGraphBuilder::addReferences(ASTNode const& _node)
+{
+	for (Reference const& reference: m_cache.references(_node))
+		std::visit(GenericVisitor{
+			[&](CallableReference const& _reference) {
+				CallableDeclaration const* callable = _reference.callable;
+				if (_reference.lookup == VirtualLookup::Virtual)
+					callable = &callable->resolveVirtual(m_contract);
+				else if (_reference.lookup == VirtualLookup::Super)
+				{
+					solAssert(_reference.superLookupContract, "");
+					callable = &dynamic_cast<FunctionDefinition const&>(*callable).resolveVirtual(
+						m_contract,
+						_reference.superLookupContract->superContract(m_contract)
+					);
+				}
+				functionReferenced(*callable, _reference.calledDirectly);
+			},
+			[&](IndirectCall const&) { add(m_currentNode, CallGraph::SpecialNode::InternalDispatch); },
+			[&](ConstantReference const& _reference) { addReferences(*_reference.variable); },
+			[&](EventDefinition const* _event) { m_graph.emittedEvents.insert(_event); },
+			[&](ErrorDefinition const* _error) { m_graph.usedErrors.insert(_error); },
+			[&](BytecodeReference const& _reference) { m_graph.bytecodeDependency.emplace(_reference.contract, _reference.node); }
+		}, reference);
+}
+
 void FunctionCallGraphBuilder::enqueueCallable(CallableDeclaration const& _callable)
 {
 	if (!m_graph.edges.count(&_callable))
@@ -251,7 +325,7 @@ void FunctionCallGraphBuilder::processQueue()
 		solAssert(holds_alternative<CallableDeclaration const*>(m_currentNode), "");
 
 		m_visitQueue.pop_front();
-		get<CallableDeclaration const*>(m_currentNode)->accept(*this);
+		addReferences(*get<CallableDeclaration const*>(m_currentNode));
 	}
 
 	m_currentNode = CallGraph::SpecialNode::Entry;
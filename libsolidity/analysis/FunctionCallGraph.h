@@ -18,12 +18,15 @@
 
 #pragma once
 
+#include <libsolidity/ast/ASTEnums.h>
 #include <libsolidity/ast/ASTForward.h>
-#include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/ast/CallGraph.h>
 
 #include <deque>
+#include <map>
 #include <ostream>
+#include <variant>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -54,26 +57,73 @@ namespace solidity::frontend
  *  is also guaranteed to contain keys representing all the reachable functions and modifiers, even
  *  if they have no outgoing edges.
  */
-class FunctionCallGraphBuilder: private ASTConstVisitor
+class FunctionCallGraphBuilder
 {
 public:
-	static CallGraph buildCreationGraph(ContractDefinition const& _contract);
+	/// Reference to a function or modifier. Virtual and super references are resolved against
+	/// the most derived contract when the graph is built.
+	struct CallableReference
+	{
+		CallableDeclaration const* callable = nullptr;
+		VirtualLookup lookup = VirtualLookup::Static;
+		/// For references via `super`, the contract that contains the reference.
+		ContractDefinition const* superLookupContract = nullptr;
+		bool calledDirectly = true;
+	};
+	/// Call of an internal function that is only determined at runtime.
+	struct IndirectCall {};
+	/// Reference to a constant, whose initial value is evaluated at the place of the reference.
+	struct ConstantReference
+	{
+		VariableDeclaration const* variable = nullptr;
+	};
+	/// Reference to the bytecode of a contract, e.g. via `new` or `type(C).creationCode`.
+	struct BytecodeReference
+	{
+		ContractDefinition const* contract = nullptr;
+		ASTNode const* node = nullptr;
+	};
+	using Reference = std::variant<
+		CallableReference,
+		IndirectCall,
+		ConstantReference,
+		EventDefinition const*,
+		ErrorDefinition const*,
+		BytecodeReference
+	>;
+
+	/**
+	 * The references found in the code of callables, state variables and inheritance specifiers,
+	 * in the order in which they appear. They only depend on the AST and not on the contract whose
+	 * graph is built, so a cache can be shared by the graphs of all contracts of a compilation.
+	 * This way, the code of common base contracts is only visited once.
+	 */
+	class ReferenceCache
+	{
+	public:
+		std::vector<Reference> const& references(ASTNode const& _node);
+
+	private:
+		std::map<ASTNode const*, std::vector<Reference>> m_references;
+	};
+
+	/// @param _cache if not null, used to look up and store the references of the visited code.
+	static CallGraph buildCreationGraph(ContractDefinition const& _contract, ReferenceCache* _cache = nullptr);
 	static CallGraph buildDeployedGraph(
 		ContractDefinition const& _contract,
-		CallGraph const& _creationGraph
+		CallGraph const& _creationGraph,
+		ReferenceCache* _cache = nullptr
 	);
 
 private:
-	FunctionCallGraphBuilder(ContractDefinition const& _contract):
-		m_contract(_contract)
+	FunctionCallGraphBuilder(ContractDefinition const& _contract, ReferenceCache* _cache):
+		m_contract(_contract),
+		m_cache(_cache ? *_cache : m_ownCache)
 	{}
 
-	bool visit(FunctionCall const& _functionCall) override;
-	bool visit(EmitStatement const& _emitStatement) override;
-	bool visit(Identifier const& _identifier) override;
-	bool visit(MemberAccess const& _memberAccess) override;
-	bool visit(ModifierInvocation const& _modifierInvocation) override;
-	bool visit(NewExpression const& _newExpression) override;
+	/// Adds the references found in @a _node to the graph, resolving virtual functions
+	/// against the most derived contract.
+	void addReferences(ASTNode const& _node);
 
 	void enqueueCallable(CallableDeclaration const& _callable);
 	void processQueue();
@@ -83,6 +133,8 @@ private:
 
 	CallGraph::Node m_currentNode = CallGraph::SpecialNode::Entry;
 	ContractDefinition const& m_contract;
+	ReferenceCache m_ownCache;
+	ReferenceCache& m_cache;
 	CallGraph m_graph;
 	std::deque<CallableDeclaration const*> m_visitQueue;
 };
@@ -37,22 +37,11 @@ using namespace solidity::frontend;
 using namespace solidity::langutil;
 
 using solidity::util::GenericVisitor;
-using solidity::util::contains_if;
 using solidity::util::joinHumanReadable;
 
 namespace
 {
 
-// Helper struct to do a search by name
-struct MatchByName
-{
-	string const& m_name;
-	bool operator()(OverrideProxy const& _item)
-	{
-		return _item.name() == m_name;
-	}
-};
-
 /**
  * Construct the override graph for this signature.
  * Reserve node 0 for the current contract and node
@@ -473,10 +462,12 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 {
 	OverrideProxyBySignatureMultiSet const& inheritedFuncs = inheritedFunctions(_contract);
 	OverrideProxyBySignatureMultiSet const& inheritedMods = inheritedModifiers(_contract);
+	set<string> const& inheritedFuncNames = inheritedFunctionNames(_contract);
+	set<string> const& inheritedModNames = inheritedModifierNames(_contract);
 
 	for (ModifierDefinition const* modifier: _contract.functionModifiers())
 	{
-		if (contains_if(inheritedFuncs, MatchByName{modifier->name()}))
+		if (inheritedFuncNames.count(modifier->name()))
 			m_errorReporter.typeError(
 				5631_error,
 				modifier->location(),
@@ -491,7 +482,7 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 		if (function->isConstructor())
 			continue;
 
-		if (contains_if(inheritedMods, MatchByName{function->name()}))
+		if (inheritedModNames.count(function->name()))
 			m_errorReporter.typeError(1469_error, function->location(), "Override changes modifier to function.");
 
 		checkOverrideList(OverrideProxy{function}, inheritedFuncs);
@@ -506,7 +497,7 @@ void OverrideChecker::checkIllegalOverrides(ContractDefinition const& _contract)
 			continue;
 		}
 
-		if (contains_if(inheritedMods, MatchByName{stateVar->name()}))
+		if (inheritedModNames.count(stateVar->name()))
 			m_errorReporter.typeError(1456_error, stateVar->location(), "Override changes modifier to public state variable.");
 
 		checkOverrideList(OverrideProxy{stateVar}, inheritedFuncs);
@@ -729,20 +720,29 @@ void OverrideChecker::checkAmbiguousOverrides(ContractDefinition const& _contrac
 		// Fetch inherited functions and sort them by signature.
 		// We get at least one function per signature and direct base contract, which is
 		// enough because we re-construct the inheritance graph later.
-		OverrideProxyBySignatureMultiSet nonOverriddenFunctions = inheritedFunctions(_contract);
+		OverrideProxyBySignatureMultiSet const& inheritedFuncs = inheritedFunctions(_contract);
 
-		// Remove all functions that match the signature of a function in the current contract.
+		// Skip all functions that match the signature of a function in the current contract.
+		// The cached set is shared with the contracts deriving from this one, so it is not copied.
+		set<OverrideProxy, OverrideProxy::CompareBySignature> overridingFunctions;
 		for (FunctionDefinition const* f: _contract.definedFunctions())
-			nonOverriddenFunctions.erase(OverrideProxy{f});
+			overridingFunctions.emplace(OverrideProxy{f});
 		for (VariableDeclaration const* v: _contract.stateVariables())
 			if (v->isPublic())
-				nonOverriddenFunctions.erase(OverrideProxy{v});
+				overridingFunctions.emplace(OverrideProxy{v});
 
 		// Walk through the set of functions signature by signature.
-		for (auto it = nonOverriddenFunctions.cbegin(); it != nonOverriddenFunctions.cend();)
+		for (auto it = inheritedFuncs.cbegin(); it != inheritedFuncs.cend();)
 		{
+			auto nextSignature = inheritedFuncs.upper_bound(*it);
+			if (overridingFunctions.count(*it))
+			{
+				it = nextSignature;
+				continue;
+			}
+
 			std::set<OverrideProxy> baseFunctions;
-			for (auto nextSignature = nonOverriddenFunctions.upper_bound(*it); it != nextSignature; ++it)
+			for (; it != nextSignature; ++it)
 				baseFunctions.insert(*it);
 
 			checkAmbiguousOverridesInternal(std::move(baseFunctions), _contract.location());
@@ -750,14 +750,22 @@ void OverrideChecker::checkAmbiguousOverrides(ContractDefinition const& _contrac
 	}
 
 	{
-		OverrideProxyBySignatureMultiSet modifiers = inheritedModifiers(_contract);
+		OverrideProxyBySignatureMultiSet const& inheritedMods = inheritedModifiers(_contract);
+		set<OverrideProxy, OverrideProxy::CompareBySignature> overridingModifiers;
 		for (ModifierDefinition const* mod: _contract.functionModifiers())
-			modifiers.erase(OverrideProxy{mod});
+			overridingModifiers.emplace(OverrideProxy{mod});
 
-		for (auto it = modifiers.cbegin(); it != modifiers.cend();)
+		for (auto it = inheritedMods.cbegin(); it != inheritedMods.cend();)
 		{
+			auto next = inheritedMods.upper_bound(*it);
+			if (overridingModifiers.count(*it))
+			{
+				it = next;
+				continue;
+			}
+
 			std::set<OverrideProxy> baseModifiers;
-			for (auto next = modifiers.upper_bound(*it); it != next; ++it)
+			for (; it != next; ++it)
 				baseModifiers.insert(*it);
 
 			checkAmbiguousOverridesInternal(std::move(baseModifiers), _contract.location());
@@ -946,7 +954,7 @@ OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheri
 					result.insert(func);
 		}
 
-		m_inheritedFunctions[&_contract] = result;
+		m_inheritedFunctions[&_contract] = std::move(result);
 	}
 
 	return m_inheritedFunctions[&_contract];
@@ -970,8 +978,34 @@ OverrideChecker::OverrideProxyBySignatureMultiSet const& OverrideChecker::inheri
 			result += modifiersInBase;
 		}
 
-		m_inheritedModifiers[&_contract] = result;
+		m_inheritedModifiers[&_contract] = std::move(result);
 	}
 
 	return m_inheritedModifiers[&_contract];
 }
+
+set<string> const& OverrideChecker::inheritedFunctionNames(ContractDefinition const& _contract) const
+{
+	if (!m_inheritedFunctionNames.count(&_contract))
+	{
+		set<string> result;
+		for (OverrideProxy const& func: inheritedFunctions(_contract))
+			result.insert(func.name());
+		m_inheritedFunctionNames[&_contract] = std::move(result);
+	}
+
+	return m_inheritedFunctionNames[&_contract];
+}
+
+set<string> const& OverrideChecker::inheritedModifierNames(ContractDefinition const& _contract) const
+{
+	if (!m_inheritedModifierNames.count(&_contract))
+	{
+		set<string> result;
+		for (OverrideProxy const& mod: inheritedModifiers(_contract))
+			result.insert(mod.name());
+		m_inheritedModifierNames[&_contract] = std::move(result);
+	}
+
+	return m_inheritedModifierNames[&_contract];
+}
@@ -157,6 +157,10 @@ public:
 	OverrideProxyBySignatureMultiSet const& inheritedModifiers(ContractDefinition const& _contract) const;
 
 private:
+	/// @returns the names of the elements of inheritedFunctions() and inheritedModifiers(), respectively.
+	std::set<std::string> const& inheritedFunctionNames(ContractDefinition const& _contract) const;
+	std::set<std::string> const& inheritedModifierNames(ContractDefinition const& _contract) const;
+
 	void checkIllegalOverrides(ContractDefinition const& _contract);
 	/// Performs various checks related to @a _overriding overriding @a _super like
 	/// different return type, invalid visibility change, etc.
@@ -191,6 +195,9 @@ private:
 	/// Cache for inheritedFunctions().
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedFunctions;
 	std::map<ContractDefinition const*, OverrideProxyBySignatureMultiSet> mutable m_inheritedModifiers;
+	/// Cache for inheritedFunctionNames() and inheritedModifierNames().
+	std::map<ContractDefinition const*, std::set<std::string>> mutable m_inheritedFunctionNames;
+	std::map<ContractDefinition const*, std::set<std::string>> mutable m_inheritedModifierNames;
 };
 
 }
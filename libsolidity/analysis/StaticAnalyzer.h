@@ -57,6 +57,9 @@ public:
 	/// @returns true iff all checks passed. Note even if all checks passed, errors() can still contain warnings
 	bool analyze(SourceUnit const& _sourceUnit);
 
+	/// @returns the visitor that performs the analysis, for a traversal that is shared with other checks.
+	ASTConstVisitor& visitor() { return *this; }
+
 private:
 
 	bool visit(ContractDefinition const& _contract) override;
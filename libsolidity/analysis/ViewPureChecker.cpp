@@ -131,7 +131,7 @@ bool ViewPureChecker::check()
 	for (auto const& source: m_ast)
 		source->accept(*this);
 
-	return !m_errors;
+	return success();
 }
 
 bool ViewPureChecker::visit(ImportDirective const&)
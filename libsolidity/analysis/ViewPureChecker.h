@@ -43,6 +43,11 @@ public:
 
 	bool check();
 
+	/// @returns the visitor that performs the check, for a traversal that is shared with other checks.
+	/// The result is available from @a success afterwards.
+	ASTConstVisitor& visitor() { return *this; }
+	bool success() const { return !m_errors; }
+
 private:
 	struct MutabilityAndLocation
 	{
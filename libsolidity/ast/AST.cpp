@@ -128,16 +128,23 @@ SourceUnitAnnotation& SourceUnit::annotation() const
 
 set<SourceUnit const*> SourceUnit::referencedSourceUnits(bool _recurse, set<SourceUnit const*> _skipList) const
 {
+	// The skip list is shared by the whole traversal, so that every source unit is visited at most once
+	// even if it is imported along many paths.
 	set<SourceUnit const*> sourceUnits;
-	for (ImportDirective const* importDirective: filteredNodes<ImportDirective>(nodes()))
+	vector<SourceUnit const*> toVisit{this};
+	while (!toVisit.empty())
 	{
-		auto const& sourceUnit = importDirective->annotation().sourceUnit;
-		if (!_skipList.count(sourceUnit))
+		SourceUnit const* current = toVisit.back();
+		toVisit.pop_back();
+		for (ImportDirective const* importDirective: filteredNodes<ImportDirective>(current->nodes()))
 		{
-			_skipList.insert(sourceUnit);
-			sourceUnits.insert(sourceUnit);
-			if (_recurse)
-				sourceUnits += sourceUnit->referencedSourceUnits(true, _skipList);
+			auto const& sourceUnit = importDirective->annotation().sourceUnit;
+			if (_skipList.insert(sourceUnit).second)
+			{
+				sourceUnits.insert(sourceUnit);
+				if (_recurse)
+					toVisit.push_back(sourceUnit);
+			}
 		}
 	}
 	return sourceUnits;
@@ -260,7 +267,8 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 {
 	return m_interfaceFunctionList[_includeInheritedFunctions].init([&]{
 		set<string> signaturesSeen;
-		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		vector<string> signatures;
+		vector<FunctionTypePointer> interfaceFunctions;
 
 		for (ContractDefinition const* contract: annotation().linearizedBaseContracts)
 		{
@@ -282,11 +290,17 @@ vector<pair<util::FixedHash<4>, FunctionTypePointer>> const& ContractDefinition:
 				if (signaturesSeen.count(functionSignature) == 0)
 				{
 					signaturesSeen.insert(functionSignature);
-					interfaceFunctionList.emplace_back(util::selectorFromSignatureH32(functionSignature), fun);
+					signatures.emplace_back(std::move(functionSignature));
+					interfaceFunctions.push_back(fun);
 				}
 			}
 		}
 
+		// The selectors are computed together, which is faster than hashing the signatures one by one.
+		vector<util::FixedHash<4>> selectors = util::selectorsFromSignaturesH32(signatures);
+		vector<pair<util::FixedHash<4>, FunctionTypePointer>> interfaceFunctionList;
+		for (size_t i = 0; i < interfaceFunctions.size(); ++i)
+			interfaceFunctionList.emplace_back(selectors[i], interfaceFunctions[i]);
 		return interfaceFunctionList;
 	});
 }
@@ -0,0 +1,47 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory arena for the AST nodes of a source unit.
+ */
+
+#include <libsolidity/ast/ASTArena.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::frontend;
+
+void* ASTArena::allocate(size_t _size, size_t _alignment)
+{
+	if (!m_position || !std::align(_alignment, _size, m_position, m_available))
+	{
+		// Objects larger than a block get a block of their own.
+		size_t const size = max(blockSize, _size + _alignment);
+		m_blocks.emplace_back(new byte[size]);
+		m_position = m_blocks.back().get();
+		m_available = size;
+		void* aligned = std::align(_alignment, _size, m_position, m_available);
+		solAssert(aligned, "");
+	}
+	void* result = m_position;
+	m_position = static_cast<byte*>(m_position) + _size;
+	m_available -= _size;
+	return result;
+}
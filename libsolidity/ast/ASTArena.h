@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Memory arena for the AST nodes of a source unit.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Hands out memory sequentially from large blocks, so that the nodes of a source unit are allocated
+ * cheaply and next to each other in the order in which the parser creates them.
+ * Memory is never reused, it is only released when the arena is destroyed.
+ * Not thread-safe, an arena is only used by a single parser.
+ */
+class ASTArena
+{
+public:
+	ASTArena() = default;
+	ASTArena(ASTArena const&) = delete;
+	ASTArena& operator=(ASTArena const&) = delete;
+
+	/// @returns uninitialised memory of @a _size bytes aligned to @a _alignment.
+	void* allocate(size_t _size, size_t _alignment);
+
+private:
+	static size_t constexpr blockSize = 64 * 1024;
+
+	std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	/// Start of the free part of the last block.
+	void* m_position = nullptr;
+	size_t m_available = 0;
+};
+
+/**
+ * Allocator that allocates from an ASTArena, for use with std::allocate_shared.
+ * Every allocation keeps the arena alive, so nodes can safely outlive the parser and the source unit.
+ * Deallocation does nothing, the memory is released together with the arena.
+ */
+template <class T>
+class ASTArenaAllocator
+{
+public:
+	using value_type = T;
+
+	explicit ASTArenaAllocator(std::shared_ptr<ASTArena> _arena): m_arena(std::move(_arena)) {}
+	template <class U>
+	ASTArenaAllocator(ASTArenaAllocator<U> const& _other): m_arena(_other.arena()) {}
+
+	T* allocate(size_t _count) { return static_cast<T*>(m_arena->allocate(sizeof(T) * _count, alignof(T))); }
+	void deallocate(T*, size_t) noexcept {}
+
+	std::shared_ptr<ASTArena> const& arena() const { return m_arena; }
+
+	template <class U>
+	bool operator==(ASTArenaAllocator<U> const& _other) const { return m_arena == _other.arena(); }
+	template <class U>
+	bool operator!=(ASTArenaAllocator<U> const& _other) const { return m_arena != _other.arena(); }
+
+private:
+	std::shared_ptr<ASTArena> m_arena;
+};
+
+}
@@ -201,12 +201,64 @@ Json::Value ASTJsonExporter::inlineAssemblyIdentifierToJson(pair<yul::Identifier
 
 void ASTJsonExporter::print(ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format)
 {
-	_stream << util::jsonPrint(toJson(_node), _format);
+	if (_format.format == util::JsonFormat::Compact)
+		printCompact(_stream, _node);
+	else
+		_stream << util::jsonPrint(toJson(_node), _format);
+}
+
+void ASTJsonExporter::printCompact(ostream& _stream, ASTNode const& _node)
+{
+	vector<ASTPointer<ASTNode>> children;
+	if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(&_node))
+		children = sourceUnit->nodes();
+	else if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_node))
+		children = contract->subNodes();
+	else
+	{
+		_stream << util::jsonCompactPrint(toJson(_node));
+		return;
+	}
+
+	m_omitNodesOf = &_node;
+	Json::Value json = toJson(_node);
+	m_omitNodesOf = nullptr;
+
+	// Same member order and separators as jsonCompactPrint(), with the children printed in place of the empty "nodes".
+	_stream << '{';
+	for (auto it = json.begin(); it != json.end(); ++it)
+	{
+		if (it != json.begin())
+			_stream << ',';
+		_stream << util::jsonCompactPrint(it.key()) << ':';
+		if (it.name() != "nodes")
+		{
+			_stream << util::jsonCompactPrint(*it);
+			continue;
+		}
+		_stream << '[';
+		for (size_t i = 0; i < children.size(); ++i)
+		{
+			if (i != 0)
+				_stream << ',';
+			if (children[i])
+				printCompact(_stream, *children[i]);
+			else
+				_stream << "null";
+		}
+		_stream << ']';
+	}
+	_stream << '}';
 }
 
 Json::Value ASTJsonExporter::toJson(ASTNode const& _node)
 {
+	++m_toJsonDepth;
+	ScopeGuard decreaseDepth{[&] { --m_toJsonDepth; }};
 	_node.accept(*this);
+	// The removal is recursive, so doing it for every nested node as well would be quadratic in the depth of the AST.
+	if (m_toJsonDepth > 1)
+		return std::move(m_currentValue);
 	return util::removeNullMembers(std::move(m_currentValue));
 }
 
@@ -214,7 +266,7 @@ bool ASTJsonExporter::visit(SourceUnit const& _node)
 {
 	std::vector<pair<string, Json::Value>> attributes = {
 		make_pair("license", _node.licenseString() ? Json::Value(*_node.licenseString()) : Json::nullValue),
-		make_pair("nodes", toJson(_node.nodes()))
+		make_pair("nodes", &_node == m_omitNodesOf ? Json::Value(Json::arrayValue) : toJson(_node.nodes()))
 	};
 
 	if (_node.annotation().exportedSymbols.set())
@@ -287,7 +339,7 @@ bool ASTJsonExporter::visit(ContractDefinition const& _node)
 		make_pair("baseContracts", toJson(_node.baseContracts())),
 		make_pair("contractDependencies", getContainerIds(_node.annotation().contractDependencies | ranges::views::keys)),
 		make_pair("usedErrors", getContainerIds(_node.interfaceErrors(false))),
-		make_pair("nodes", toJson(_node.subNodes())),
+		make_pair("nodes", &_node == m_omitNodesOf ? Json::Value(Json::arrayValue) : toJson(_node.subNodes())),
 		make_pair("scope", idOrNull(_node.scope()))
 	};
 	addIfSet(attributes, "canonicalName", _node.annotation().canonicalName);
@@ -59,6 +59,8 @@ public:
 		std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>()
 	);
 	/// Output the json representation of the AST to _stream.
+	/// In compact format, the members of source units and contracts are written one by one,
+	/// so that the JSON of the whole tree never has to be kept in memory.
 	void print(std::ostream& _stream, ASTNode const& _node, util::JsonFormat const& _format);
 	Json::Value toJson(ASTNode const& _node);
 	template <class T>
@@ -131,6 +133,9 @@ public:
 	void endVisit(EventDefinition const&) override;
 
 private:
+	/// Writes the compact json representation of @a _node to @a _stream, streaming the
+	/// "nodes" member of source units and contracts.
+	void printCompact(std::ostream& _stream, ASTNode const& _node);
 	void setJsonNode(
 		ASTNode const& _node,
 		std::string const& _nodeName,
@@ -198,6 +203,10 @@ private:
 
 	CompilerStack::State m_stackState = CompilerStack::State::Empty; ///< Used to only access information that already exists
 	bool m_inEvent = false; ///< whether we are currently inside an event or not
+	/// Nesting depth of toJson() calls. Null members are only removed at the outermost one.
+	size_t m_toJsonDepth = 0;
+	/// Source unit or contract whose "nodes" member is output as an empty array, see printCompact().
+	ASTNode const* m_omitNodesOf = nullptr;
 	Json::Value m_currentValue;
 	std::map<std::string, unsigned> m_sourceIndices;
 };
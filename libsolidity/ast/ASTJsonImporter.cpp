@@ -36,6 +36,9 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <string_view>
+#include <unordered_map>
+
 using namespace std;
 
 namespace solidity::frontend
@@ -58,7 +61,7 @@ ASTPointer<T> ASTJsonImporter::nullOrCast(Json::Value const& _json)
 map<string, ASTPointer<SourceUnit>> ASTJsonImporter::jsonToSourceUnit(map<string, Json::Value> const& _sourceList)
 {
 	for (auto const& src: _sourceList)
-		m_sourceNames.emplace_back(make_shared<string const>(src.first));
+		m_sourceNames.emplace_back(langutil::internSourceName(src.first));
 	for (auto const& srcPair: _sourceList)
 	{
 		astAssert(!srcPair.second.isNull());
@@ -141,125 +144,76 @@ ASTPointer<T> ASTJsonImporter::convertJsonToASTNode(Json::Value const& _node)
 
 ASTPointer<ASTNode> ASTJsonImporter::convertJsonToASTNode(Json::Value const& _json)
 {
-	astAssert(_json["nodeType"].isString() && _json.isMember("id"), "JSON-Node needs to have 'nodeType' and 'id' fields.");
-	string nodeType = _json["nodeType"].asString();
-	if (nodeType == "PragmaDirective")
-		return createPragmaDirective(_json);
-	if (nodeType == "ImportDirective")
-		return createImportDirective(_json);
-	if (nodeType == "ContractDefinition")
-		return createContractDefinition(_json);
-	if (nodeType == "IdentifierPath")
-		return createIdentifierPath(_json);
-	if (nodeType == "InheritanceSpecifier")
-		return createInheritanceSpecifier(_json);
-	if (nodeType == "UsingForDirective")
-		return createUsingForDirective(_json);
-	if (nodeType == "StructDefinition")
-		return createStructDefinition(_json);
-	if (nodeType == "EnumDefinition")
-		return createEnumDefinition(_json);
-	if (nodeType == "EnumValue")
-		return createEnumValue(_json);
-	if (nodeType == "UserDefinedValueTypeDefinition")
-		return createUserDefinedValueTypeDefinition(_json);
-	if (nodeType == "ParameterList")
-		return createParameterList(_json);
-	if (nodeType == "OverrideSpecifier")
-		return createOverrideSpecifier(_json);
-	if (nodeType == "FunctionDefinition")
-		return createFunctionDefinition(_json);
-	if (nodeType == "VariableDeclaration")
-		return createVariableDeclaration(_json);
-	if (nodeType == "ModifierDefinition")
-		return createModifierDefinition(_json);
-	if (nodeType == "ModifierInvocation")
-		return createModifierInvocation(_json);
-	if (nodeType == "EventDefinition")
-		return createEventDefinition(_json);
-	if (nodeType == "ErrorDefinition")
-		return createErrorDefinition(_json);
-	if (nodeType == "ElementaryTypeName")
-		return createElementaryTypeName(_json);
-	if (nodeType == "UserDefinedTypeName")
-		return createUserDefinedTypeName(_json);
-	if (nodeType == "FunctionTypeName")
-		return createFunctionTypeName(_json);
-	if (nodeType == "Mapping")
-		return createMapping(_json);
-	if (nodeType == "ArrayTypeName")
-		return createArrayTypeName(_json);
-	if (nodeType == "InlineAssembly")
-		return createInlineAssembly(_json);
-	if (nodeType == "Block")
-		return createBlock(_json, false);
-	if (nodeType == "UncheckedBlock")
-		return createBlock(_json, true);
-	if (nodeType == "PlaceholderStatement")
-		return createPlaceholderStatement(_json);
-	if (nodeType == "IfStatement")
-		return createIfStatement(_json);
-	if (nodeType == "TryCatchClause")
-		return createTryCatchClause(_json);
-	if (nodeType == "TryStatement")
-		return createTryStatement(_json);
-	if (nodeType == "WhileStatement")
-		return createWhileStatement(_json, false);
-	if (nodeType == "DoWhileStatement")
-		return createWhileStatement(_json, true);
-	if (nodeType == "ForStatement")
-		return createForStatement(_json);
-	if (nodeType == "Continue")
-		return createContinue(_json);
-	if (nodeType == "Break")
-		return createBreak(_json);
-	if (nodeType == "Return")
-		return createReturn(_json);
-	if (nodeType == "EmitStatement")
-		return createEmitStatement(_json);
-	if (nodeType == "RevertStatement")
-		return createRevertStatement(_json);
-	if (nodeType == "Throw")
-		return createThrow(_json);
-	if (nodeType == "VariableDeclarationStatement")
-		return createVariableDeclarationStatement(_json);
-	if (nodeType == "ExpressionStatement")
-		return createExpressionStatement(_json);
-	if (nodeType == "Conditional")
-		return createConditional(_json);
-	if (nodeType == "Assignment")
-		return createAssignment(_json);
-	if (nodeType == "TupleExpression")
-		return createTupleExpression(_json);
-	if (nodeType == "UnaryOperation")
-		return createUnaryOperation(_json);
-	if (nodeType == "BinaryOperation")
-		return createBinaryOperation(_json);
-	if (nodeType == "FunctionCall")
-		return createFunctionCall(_json);
-	if (nodeType == "FunctionCallOptions")
-		return createFunctionCallOptions(_json);
-	if (nodeType == "NewExpression")
-		return createNewExpression(_json);
-	if (nodeType == "MemberAccess")
-		return createMemberAccess(_json);
-	if (nodeType == "IndexAccess")
-		return createIndexAccess(_json);
-	if (nodeType == "IndexRangeAccess")
-		return createIndexRangeAccess(_json);
-	if (nodeType == "Identifier")
-		return createIdentifier(_json);
-	if (nodeType == "ElementaryTypeNameExpression")
-		return createElementaryTypeNameExpression(_json);
-	if (nodeType == "Literal")
-		return createLiteral(_json);
-	if (nodeType == "StructuredDocumentation")
-		return createDocumentation(_json);
-	else
-		astAssert(false, "Unknown type of ASTNode: " + nodeType);
-
-	// FIXME: Workaround for spurious GCC 12.1 warning (https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105794)
-	util::unreachable();
+	Json::Value const& nodeTypeValue = _json["nodeType"];
+	astAssert(nodeTypeValue.isString() && _json.isMember("id"), "JSON-Node needs to have 'nodeType' and 'id' fields.");
+	char const* nodeTypeBegin = nullptr;
+	char const* nodeTypeEnd = nullptr;
+	nodeTypeValue.getString(&nodeTypeBegin, &nodeTypeEnd);
+	string_view nodeType(nodeTypeBegin, static_cast<size_t>(nodeTypeEnd - nodeTypeBegin));
+
+	using NodeFactory = ASTPointer<ASTNode>(*)(ASTJsonImporter&, Json::Value const&);
+	static unordered_map<string_view, NodeFactory> const nodeFactories{
+		{"PragmaDirective", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createPragmaDirective(_node); }},
+		{"ImportDirective", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createImportDirective(_node); }},
+		{"ContractDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createContractDefinition(_node); }},
+		{"IdentifierPath", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createIdentifierPath(_node); }},
+		{"InheritanceSpecifier", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createInheritanceSpecifier(_node); }},
+		{"UsingForDirective", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createUsingForDirective(_node); }},
+		{"StructDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createStructDefinition(_node); }},
+		{"EnumDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createEnumDefinition(_node); }},
+		{"EnumValue", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createEnumValue(_node); }},
+		{"UserDefinedValueTypeDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createUserDefinedValueTypeDefinition(_node); }},
+		{"ParameterList", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createParameterList(_node); }},
+		{"OverrideSpecifier", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createOverrideSpecifier(_node); }},
+		{"FunctionDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createFunctionDefinition(_node); }},
+		{"VariableDeclaration", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createVariableDeclaration(_node); }},
+		{"ModifierDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createModifierDefinition(_node); }},
+		{"ModifierInvocation", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createModifierInvocation(_node); }},
+		{"EventDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createEventDefinition(_node); }},
+		{"ErrorDefinition", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createErrorDefinition(_node); }},
+		{"ElementaryTypeName", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createElementaryTypeName(_node); }},
+		{"UserDefinedTypeName", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createUserDefinedTypeName(_node); }},
+		{"FunctionTypeName", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createFunctionTypeName(_node); }},
+		{"Mapping", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createMapping(_node); }},
+		{"ArrayTypeName", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createArrayTypeName(_node); }},
+		{"InlineAssembly", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createInlineAssembly(_node); }},
+		{"Block", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createBlock(_node, false); }},
+		{"UncheckedBlock", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createBlock(_node, true); }},
+		{"PlaceholderStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createPlaceholderStatement(_node); }},
+		{"IfStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createIfStatement(_node); }},
+		{"TryCatchClause", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createTryCatchClause(_node); }},
+		{"TryStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createTryStatement(_node); }},
+		{"WhileStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createWhileStatement(_node, false); }},
+		{"DoWhileStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createWhileStatement(_node, true); }},
+		{"ForStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createForStatement(_node); }},
+		{"Continue", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createContinue(_node); }},
+		{"Break", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createBreak(_node); }},
+		{"Return", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createReturn(_node); }},
+		{"EmitStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createEmitStatement(_node); }},
+		{"RevertStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createRevertStatement(_node); }},
+		{"Throw", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createThrow(_node); }},
+		{"VariableDeclarationStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createVariableDeclarationStatement(_node); }},
+		{"ExpressionStatement", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createExpressionStatement(_node); }},
+		{"Conditional", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createConditional(_node); }},
+		{"Assignment", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createAssignment(_node); }},
+		{"TupleExpression", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createTupleExpression(_node); }},
+		{"UnaryOperation", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createUnaryOperation(_node); }},
+		{"BinaryOperation", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createBinaryOperation(_node); }},
+		{"FunctionCall", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createFunctionCall(_node); }},
+		{"FunctionCallOptions", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createFunctionCallOptions(_node); }},
+		{"NewExpression", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createNewExpression(_node); }},
+		{"MemberAccess", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createMemberAccess(_node); }},
+		{"IndexAccess", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createIndexAccess(_node); }},
+		{"IndexRangeAccess", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createIndexRangeAccess(_node); }},
+		{"Identifier", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createIdentifier(_node); }},
+		{"ElementaryTypeNameExpression", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createElementaryTypeNameExpression(_node); }},
+		{"Literal", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createLiteral(_node); }},
+		{"StructuredDocumentation", [](ASTJsonImporter& _importer, Json::Value const& _node) -> ASTPointer<ASTNode> { return _importer.createDocumentation(_node); }}
+	};
+
+	auto factory = nodeFactories.find(nodeType);
+	astAssert(factory != nodeFactories.end(), "Unknown type of ASTNode: " + string(nodeType));
+	return factory->second(*this, _json);
 }
 
 // ============ functions to instantiate the AST-Nodes from Json-Nodes ==============
@@ -1046,10 +1000,10 @@ ASTPointer<StructuredDocumentation> ASTJsonImporter::createDocumentation(Json::V
 
 // ===== helper functions ==========
 
-Json::Value ASTJsonImporter::member(Json::Value const& _node, string const& _name)
+Json::Value const& ASTJsonImporter::member(Json::Value const& _node, string const& _name)
 {
 	if (!_node.isMember(_name))
-		return Json::nullValue;
+		return Json::Value::nullSingleton();
 	return _node[_name];
 }
 
@@ -1068,14 +1022,14 @@ ASTPointer<ASTString> ASTJsonImporter::nullOrASTString(Json::Value const& _json,
 
 ASTPointer<ASTString> ASTJsonImporter::memberAsASTString(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isString(), "field " + _name + " must be of type string.");
 	return make_shared<ASTString>(_node[_name].asString());
 }
 
 bool ASTJsonImporter::memberAsBool(Json::Value const& _node, string const& _name)
 {
-	Json::Value value = member(_node, _name);
+	Json::Value const& value = member(_node, _name);
 	astAssert(value.isBool(), "field " + _name + " must be of type boolean.");
 	return _node[_name].asBool();
 }
@@ -1119,7 +1073,7 @@ Token ASTJsonImporter::literalTokenKind(Json::Value const& _node)
 
 Visibility ASTJsonImporter::visibility(Json::Value const& _node)
 {
-	Json::Value visibility = member(_node, "visibility");
+	Json::Value const& visibility = member(_node, "visibility");
 	astAssert(visibility.isString(), "'visibility' expected to be a string.");
 
 	string const visibilityStr = visibility.asString();
@@ -1143,7 +1097,7 @@ Visibility ASTJsonImporter::visibility(Json::Value const& _node)
 
 VariableDeclaration::Location ASTJsonImporter::location(Json::Value const& _node)
 {
-	Json::Value storageLoc = member(_node, "storageLocation");
+	Json::Value const& storageLoc = member(_node, "storageLocation");
 	astAssert(storageLoc.isString(), "'storageLocation' expected to be a string.");
 
 	string const storageLocStr = storageLoc.asString();
@@ -1165,7 +1119,7 @@ VariableDeclaration::Location ASTJsonImporter::location(Json::Value const& _node
 
 Literal::SubDenomination ASTJsonImporter::subdenomination(Json::Value const& _node)
 {
-	Json::Value subDen = member(_node, "subdenomination");
+	Json::Value const& subDen = member(_node, "subdenomination");
 
 	if (subDen.isNull())
 		return Literal::SubDenomination::None;
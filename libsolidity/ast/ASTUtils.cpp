@@ -22,6 +22,10 @@
 
 #include <libsolutil/Algorithms.h>
 
+#include <limits>
+#include <utility>
+#include <vector>
+
 namespace solidity::frontend
 {
 
@@ -47,6 +51,49 @@ ASTNode const* locateInnermostASTNode(int _offsetInFile, SourceUnit const& _sour
 	return innermostMatch;
 }
 
+InnermostASTNodeIndex::InnermostASTNodeIndex(SourceUnit const& _sourceUnit)
+{
+	// locateInnermostASTNode only descends into nodes that contain the offset and takes the
+	// last one in visiting order. So each node is assigned to the part of its location that
+	// is covered by all its ancestors, overwriting the nodes visited before.
+	std::vector<std::pair<int, int>> ranges{{0, std::numeric_limits<int>::max()}};
+	auto indexer = SimpleASTVisitor(
+		[&](ASTNode const& _node) -> bool
+		{
+			auto const& [parentStart, parentEnd] = ranges.back();
+			langutil::SourceLocation const& location = _node.location();
+			int start = location.hasText() ? std::max(location.start, parentStart) : 0;
+			int end = location.hasText() ? std::min(location.end, parentEnd) : 0;
+			if (start >= end)
+				start = end = 0;
+			ranges.emplace_back(start, end);
+			if (start == end)
+				return false;
+
+			assign(start, end, &_node);
+			return true;
+		},
+		[&](ASTNode const&) { ranges.pop_back(); }
+	);
+	_sourceUnit.accept(indexer);
+}
+
+ASTNode const* InnermostASTNodeIndex::find(int _offsetInFile) const
+{
+	auto next = m_nodes.upper_bound(_offsetInFile);
+	if (_offsetInFile < 0 || next == m_nodes.begin())
+		return nullptr;
+	return std::prev(next)->second;
+}
+
+void InnermostASTNodeIndex::assign(int _start, int _end, ASTNode const* _node)
+{
+	ASTNode const* nodeAtEnd = find(_end);
+	m_nodes.erase(m_nodes.lower_bound(_start), m_nodes.upper_bound(_end));
+	m_nodes[_start] = _node;
+	m_nodes[_end] = nodeAtEnd;
+}
+
 bool isConstantVariableRecursive(VariableDeclaration const& _varDecl)
 {
 	solAssert(_varDecl.isConstant(), "Constant variable expected");
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <map>
+
 namespace solidity::frontend
 {
 
@@ -38,6 +40,27 @@ bool isConstantVariableRecursive(VariableDeclaration const& _varDecl);
 /// Returns the innermost AST node that covers the given location or nullptr if not found.
 ASTNode const* locateInnermostASTNode(int _offsetInFile, SourceUnit const& _sourceUnit);
 
+/**
+ * Index of the innermost AST nodes of a source unit by offset. It is built by a single walk
+ * over the AST and answers the same queries as locateInnermostASTNode in logarithmic time.
+ */
+class InnermostASTNodeIndex
+{
+public:
+	explicit InnermostASTNodeIndex(SourceUnit const& _sourceUnit);
+
+	/// @returns the innermost AST node that covers the given location or nullptr if not found.
+	ASTNode const* find(int _offsetInFile) const;
+
+private:
+	/// Assigns @a _node to all offsets in [_start, _end).
+	void assign(int _start, int _end, ASTNode const* _node);
+
+	/// Maps the start of each range of offsets to the innermost node covering it. The range
+	/// ends at the next key.
+	std::map<int, ASTNode const*> m_nodes;
+};
+
 /// @returns @a _expr itself, in case it is not a unary tuple expression. Otherwise it descends recursively
 /// into unary tuples and returns the contained expression.
 Expression const* resolveOuterUnaryTuples(Expression const* _expr);
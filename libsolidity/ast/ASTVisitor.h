@@ -329,4 +329,163 @@ private:
 	std::function<void(ASTNode const&)> m_onEndVisit;
 };
 
+/**
+ * Visitor that runs several visitors in a single traversal of the AST.
+ * Every visitor receives the same calls as in a traversal of its own: If a visitor does not
+ * want to visit the children of a node, it does not receive any calls for them, while the other
+ * visitors still do. The children are only skipped if none of the visitors wants to visit them.
+ * Only suitable for visitors that do not depend on each other's effects.
+ */
+class ASTConstVisitorMultiplexer: public ASTConstVisitor
+{
+public:
+	explicit ASTConstVisitorMultiplexer(std::vector<ASTConstVisitor*> _visitors):
+		m_visitors(std::move(_visitors)),
+		m_skippedAt(m_visitors.size(), nullptr)
+	{}
+
+	bool visit(SourceUnit const& _node) override { return multiplexVisit(_node); }
+	bool visit(PragmaDirective const& _node) override { return multiplexVisit(_node); }
+	bool visit(ImportDirective const& _node) override { return multiplexVisit(_node); }
+	bool visit(ContractDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(IdentifierPath const& _node) override { return multiplexVisit(_node); }
+	bool visit(InheritanceSpecifier const& _node) override { return multiplexVisit(_node); }
+	bool visit(UsingForDirective const& _node) override { return multiplexVisit(_node); }
+	bool visit(UserDefinedValueTypeDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(StructDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(EnumDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(EnumValue const& _node) override { return multiplexVisit(_node); }
+	bool visit(ParameterList const& _node) override { return multiplexVisit(_node); }
+	bool visit(OverrideSpecifier const& _node) override { return multiplexVisit(_node); }
+	bool visit(FunctionDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(VariableDeclaration const& _node) override { return multiplexVisit(_node); }
+	bool visit(ModifierDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(ModifierInvocation const& _node) override { return multiplexVisit(_node); }
+	bool visit(EventDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(ErrorDefinition const& _node) override { return multiplexVisit(_node); }
+	bool visit(ElementaryTypeName const& _node) override { return multiplexVisit(_node); }
+	bool visit(UserDefinedTypeName const& _node) override { return multiplexVisit(_node); }
+	bool visit(FunctionTypeName const& _node) override { return multiplexVisit(_node); }
+	bool visit(Mapping const& _node) override { return multiplexVisit(_node); }
+	bool visit(ArrayTypeName const& _node) override { return multiplexVisit(_node); }
+	bool visit(Block const& _node) override { return multiplexVisit(_node); }
+	bool visit(PlaceholderStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(IfStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(TryCatchClause const& _node) override { return multiplexVisit(_node); }
+	bool visit(TryStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(WhileStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(ForStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(Continue const& _node) override { return multiplexVisit(_node); }
+	bool visit(InlineAssembly const& _node) override { return multiplexVisit(_node); }
+	bool visit(Break const& _node) override { return multiplexVisit(_node); }
+	bool visit(Return const& _node) override { return multiplexVisit(_node); }
+	bool visit(Throw const& _node) override { return multiplexVisit(_node); }
+	bool visit(EmitStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(RevertStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(VariableDeclarationStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(ExpressionStatement const& _node) override { return multiplexVisit(_node); }
+	bool visit(Conditional const& _node) override { return multiplexVisit(_node); }
+	bool visit(Assignment const& _node) override { return multiplexVisit(_node); }
+	bool visit(TupleExpression const& _node) override { return multiplexVisit(_node); }
+	bool visit(UnaryOperation const& _node) override { return multiplexVisit(_node); }
+	bool visit(BinaryOperation const& _node) override { return multiplexVisit(_node); }
+	bool visit(FunctionCall const& _node) override { return multiplexVisit(_node); }
+	bool visit(FunctionCallOptions const& _node) override { return multiplexVisit(_node); }
+	bool visit(NewExpression const& _node) override { return multiplexVisit(_node); }
+	bool visit(MemberAccess const& _node) override { return multiplexVisit(_node); }
+	bool visit(IndexAccess const& _node) override { return multiplexVisit(_node); }
+	bool visit(IndexRangeAccess const& _node) override { return multiplexVisit(_node); }
+	bool visit(Identifier const& _node) override { return multiplexVisit(_node); }
+	bool visit(ElementaryTypeNameExpression const& _node) override { return multiplexVisit(_node); }
+	bool visit(Literal const& _node) override { return multiplexVisit(_node); }
+	bool visit(StructuredDocumentation const& _node) override { return multiplexVisit(_node); }
+
+	void endVisit(SourceUnit const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(PragmaDirective const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ImportDirective const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ContractDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(IdentifierPath const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(InheritanceSpecifier const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(UsingForDirective const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(UserDefinedValueTypeDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(StructDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(EnumDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(EnumValue const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ParameterList const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(OverrideSpecifier const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(FunctionDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(VariableDeclaration const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ModifierDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ModifierInvocation const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(EventDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ErrorDefinition const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ElementaryTypeName const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(UserDefinedTypeName const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(FunctionTypeName const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Mapping const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ArrayTypeName const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Block const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(PlaceholderStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(IfStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(TryCatchClause const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(TryStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(WhileStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ForStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Continue const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(InlineAssembly const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Break const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Return const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Throw const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(EmitStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(RevertStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(VariableDeclarationStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ExpressionStatement const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Conditional const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Assignment const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(TupleExpression const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(UnaryOperation const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(BinaryOperation const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(FunctionCall const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(FunctionCallOptions const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(NewExpression const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(MemberAccess const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(IndexAccess const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(IndexRangeAccess const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Identifier const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(ElementaryTypeNameExpression const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(Literal const& _node) override { multiplexEndVisit(_node); }
+	void endVisit(StructuredDocumentation const& _node) override { multiplexEndVisit(_node); }
+
+private:
+	template <class NodeType>
+	bool multiplexVisit(NodeType const& _node)
+	{
+		bool visitChildren = false;
+		for (size_t i = 0; i < m_visitors.size(); ++i)
+			if (!m_skippedAt[i])
+			{
+				if (m_visitors[i]->visit(_node))
+					visitChildren = true;
+				else
+					m_skippedAt[i] = &_node;
+			}
+		return visitChildren;
+	}
+
+	template <class NodeType>
+	void multiplexEndVisit(NodeType const& _node)
+	{
+		for (size_t i = 0; i < m_visitors.size(); ++i)
+			if (!m_skippedAt[i] || m_skippedAt[i] == &_node)
+			{
+				m_skippedAt[i] = nullptr;
+				m_visitors[i]->endVisit(_node);
+			}
+	}
+
+	std::vector<ASTConstVisitor*> m_visitors;
+	/// For every visitor, the node whose children it skips, if any.
+	std::vector<ASTNode const*> m_skippedAt;
+};
+
 }
@@ -338,74 +338,50 @@ Type const* Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) c
 	return encodingType;
 }
 
-namespace
-{
-
-vector<UsingForDirective const*> usingForDirectivesForType(Type const& _type, ASTNode const& _scope)
+MemberList::MemberMap Type::attachedFunctions(Type const& _type, ASTNode const& _scope)
 {
-	vector<UsingForDirective const*> usingForDirectives;
-	SourceUnit const* sourceUnit = dynamic_cast<SourceUnit const*>(&_scope);
-	if (auto const* contract = dynamic_cast<ContractDefinition const*>(&_scope))
-	{
-		sourceUnit = &contract->sourceUnit();
-		usingForDirectives += contract->usingForDirectives();
-	}
-	else
-		solAssert(sourceUnit, "");
-	usingForDirectives += ASTNode::filteredNodes<UsingForDirective>(sourceUnit->nodes());
-
-	if (Declaration const* typeDefinition = _type.typeDefinition())
-		if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(typeDefinition->scope()))
-			for (auto usingFor: ASTNode::filteredNodes<UsingForDirective>(sourceUnit->nodes()))
-				// We do not yet compare the type name because of normalization.
-				if (usingFor->global() && usingFor->typeName())
-					usingForDirectives.emplace_back(usingFor);
+	MemberList::MemberMap members;
 
 	// Normalise data location of type.
 	DataLocation typeLocation = DataLocation::Storage;
 	if (auto refType = dynamic_cast<ReferenceType const*>(&_type))
 		typeLocation = refType->location();
+	Type const* normalisedType = nullptr;
 
-	return usingForDirectives | ranges::views::filter([&](UsingForDirective const* _directive) -> bool {
+	auto appliesTo = [&](UsingForScope::Directive const& _directive) -> bool
+	{
+		if (!_directive.typeName)
+			return true;
 		// Convert both types to pointers for comparison to see if the `using for` directive applies.
 		// Note that at this point we don't yet know if the functions are actually usable with the type.
 		// `_type` may not be convertible to the function parameter type.
-		return
-			!_directive->typeName() ||
-			*TypeProvider::withLocationIfReference(typeLocation, &_type, true) ==
-			*TypeProvider::withLocationIfReference(
-				typeLocation,
-				_directive->typeName()->annotation().type,
-				true
-			);
-	}) | ranges::to<vector<UsingForDirective const*>>;
-}
-
-}
-
-MemberList::MemberMap Type::attachedFunctions(Type const& _type, ASTNode const& _scope)
-{
-	MemberList::MemberMap members;
+		if (_directive.typeName->category() != _type.category())
+			return false;
+		if (!normalisedType)
+			normalisedType = TypeProvider::withLocationIfReference(typeLocation, &_type, true);
+		return *normalisedType == *TypeProvider::withLocationIfReference(typeLocation, _directive.typeName, true);
+	};
 
-	set<pair<string, Declaration const*>> seenFunctions;
-	auto addFunction = [&](FunctionDefinition const& _function, optional<string> _name = {})
+	auto attachableFunctions = [](UsingForScope::Directive const& _directive) -> vector<UsingForScope::AttachedFunction> const&
 	{
-		if (!_name)
-			_name = _function.name();
-		Type const* functionType =
-			_function.libraryFunction() ? _function.typeViaContractName() : _function.type();
-		solAssert(functionType, "");
-		FunctionType const* withBoundFirstArgument =
-			dynamic_cast<FunctionType const&>(*functionType).withBoundFirstArgument();
-		solAssert(withBoundFirstArgument, "");
-
-		if (_type.isImplicitlyConvertibleTo(*withBoundFirstArgument->selfType()))
-			if (seenFunctions.insert(make_pair(*_name, &_function)).second)
-				members.emplace_back(&_function, withBoundFirstArgument, *_name);
-	};
+		if (_directive.functions)
+			return *_directive.functions;
 
-	for (UsingForDirective const* ufd: usingForDirectivesForType(_type, _scope))
-		for (auto const& identifierPath: ufd->functionsOrLibrary())
+		vector<UsingForScope::AttachedFunction> functions;
+		auto addFunction = [&](FunctionDefinition const& _function, optional<string> _name = {})
+		{
+			if (!_name)
+				_name = _function.name();
+			Type const* functionType =
+				_function.libraryFunction() ? _function.typeViaContractName() : _function.type();
+			solAssert(functionType, "");
+			FunctionType const* withBoundFirstArgument =
+				dynamic_cast<FunctionType const&>(*functionType).withBoundFirstArgument();
+			solAssert(withBoundFirstArgument, "");
+			functions.push_back({&_function, std::move(*_name), withBoundFirstArgument});
+		};
+
+		for (auto const& identifierPath: _directive.directive->functionsOrLibrary())
 		{
 			solAssert(identifierPath);
 			Declaration const* declaration = identifierPath->annotation().referencedDeclaration;
@@ -427,6 +403,25 @@ MemberList::MemberMap Type::attachedFunctions(Type const& _type, ASTNode const&
 					identifierPath->path().back()
 				);
 		}
+		_directive.functions = std::move(functions);
+		return *_directive.functions;
+	};
+
+	set<pair<string, Declaration const*>> seenFunctions;
+	auto addDirectives = [&](UsingForScope const& _scope)
+	{
+		for (UsingForScope::Directive const& directive: _scope.directives)
+			if (appliesTo(directive))
+				for (UsingForScope::AttachedFunction const& function: attachableFunctions(directive))
+					if (_type.isImplicitlyConvertibleTo(*function.type->selfType()))
+						if (seenFunctions.insert(make_pair(function.name, function.function)).second)
+							members.emplace_back(function.function, function.type, function.name);
+	};
+
+	addDirectives(TypeProvider::usingForScope(_scope));
+	if (Declaration const* typeDefinition = _type.typeDefinition())
+		if (auto const* sourceUnit = dynamic_cast<SourceUnit const*>(typeDefinition->scope()))
+			addDirectives(TypeProvider::usingForScope(*sourceUnit, true));
 
 	return members;
 }
@@ -1652,6 +1647,8 @@ string ArrayType::richIdentifier() const
 
 bool ArrayType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	ArrayType const& other = dynamic_cast<ArrayType const&>(_other);
@@ -3758,6 +3755,8 @@ string MappingType::richIdentifier() const
 
 bool MappingType::operator==(Type const& _other) const
 {
+	if (&_other == this)
+		return true;
 	if (_other.category() != category())
 		return false;
 	MappingType const& other = dynamic_cast<MappingType const&>(_other);
@@ -159,6 +159,32 @@ private:
 
 static_assert(std::is_nothrow_move_constructible<MemberList>::value, "MemberList should be noexcept move constructible");
 
+/**
+ * The `using for` directives that are visible in a scope, i.e. in a contract or a source unit,
+ * in the order in which they attach functions to types. It is built once per scope and shared
+ * by the member lists of all types.
+ */
+struct UsingForScope
+{
+	struct AttachedFunction
+	{
+		FunctionDefinition const* function = nullptr;
+		std::string name;
+		/// The type of the function with the first argument bound to the type it is attached to.
+		FunctionType const* type = nullptr;
+	};
+	struct Directive
+	{
+		UsingForDirective const* directive = nullptr;
+		/// The type the functions are attached to or nullptr for `using ... for *`.
+		Type const* typeName = nullptr;
+		/// The functions attached by the directive, determined when it first applies to a type.
+		mutable std::optional<std::vector<AttachedFunction>> functions;
+	};
+
+	std::vector<Directive> directives;
+};
+
 /**
  * Abstract base class that forms the root of the type hierarchy.
  */
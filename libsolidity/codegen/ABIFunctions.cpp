@@ -39,7 +39,8 @@ string ABIFunctions::tupleEncoder(
 	TypePointers const& _givenTypes,
 	TypePointers _targetTypes,
 	bool _encodeAsLibraryTypes,
-	bool _reversed
+	bool _reversed,
+	bool _inlineValueTypes
 )
 {
 	solAssert(_givenTypes.size() == _targetTypes.size(), "");
@@ -65,6 +66,8 @@ string ABIFunctions::tupleEncoder(
 	functionName += options.toFunctionNameSuffix();
 	if (_reversed)
 		functionName += "_reversed";
+	if (_inlineValueTypes)
+		functionName += "_inline";
 
 	return createFunction(functionName, [&]() {
 		// Note that the values are in reverse due to the difference in calling semantics.
@@ -85,6 +88,24 @@ string ABIFunctions::tupleEncoder(
 			solAssert(_givenTypes[i], "");
 			solAssert(_targetTypes[i], "");
 			size_t sizeOnStack = _givenTypes[i]->sizeOnStack();
+			if (_inlineValueTypes && isInlineEncodable(*_givenTypes[i], *_targetTypes[i]))
+			{
+				encodeElements += Whiskers(R"(
+					mstore(add(headStart, <pos>), <cleanupConvert>(<value>))
+				)")
+				("pos", to_string(headPos))
+				(
+					"cleanupConvert",
+					*_givenTypes[i] == *_targetTypes[i] ?
+					m_utils.cleanupFunction(*_givenTypes[i]) :
+					m_utils.conversionFunction(*_givenTypes[i], *_targetTypes[i])
+				)
+				("value", "value" + to_string(stackPos))
+				.render();
+				headPos += _targetTypes[i]->calldataHeadSize();
+				stackPos += sizeOnStack;
+				continue;
+			}
 			bool dynamic = _targetTypes[i]->isDynamicallyEncoded();
 			Whiskers elementTempl(
 				dynamic ?
@@ -190,13 +211,15 @@ string ABIFunctions::tupleEncoderPacked(
 		return templ.render();
 	});
 }
-string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
+string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory, bool _inlineValueTypes)
 {
 	string functionName = string("abi_decode_tuple_");
 	for (auto const& t: _types)
 		functionName += t->identifier();
 	if (_fromMemory)
 		functionName += "_fromMemory";
+	if (_inlineValueTypes)
+		functionName += "_inline";
 
 	return createFunction(functionName, [&]() {
 		TypePointers decodingTypes;
@@ -231,6 +254,22 @@ string ABIFunctions::tupleDecoder(TypePointers const& _types, bool _fromMemory)
 				valueReturnParams.emplace_back("value" + to_string(stackPos));
 				stackPos++;
 			}
+			if (_inlineValueTypes && isInlineDecodable(*decodingTypes[i]))
+			{
+				// Validation should use the type and not decodingType, because e.g.
+				// the decoding type of an enum is a plain int.
+				decodeElements += Whiskers(R"(
+					<value> := <load>(add(headStart, <pos>))
+					<validator>(<value>)
+				)")
+				("value", valueNamesLocal.front())
+				("load", _fromMemory ? "mload" : "calldataload")
+				("pos", to_string(headPos))
+				("validator", m_utils.validatorFunction(*_types[i], true))
+				.render();
+				headPos += decodingTypes[i]->calldataHeadSize();
+				continue;
+			}
 			Whiskers elementTempl(R"(
 				{
 					<?dynamic>
@@ -1548,6 +1587,27 @@ size_t ABIFunctions::headSize(TypePointers const& _targetTypes)
 	return headSize;
 }
 
+bool ABIFunctions::isInlineDecodable(Type const& _decodingType)
+{
+	return
+		_decodingType.isValueType() &&
+		_decodingType.category() != Type::Category::Function &&
+		!_decodingType.isDynamicallyEncoded() &&
+		_decodingType.sizeOnStack() == 1;
+}
+
+bool ABIFunctions::isInlineEncodable(Type const& _givenType, Type const& _targetType)
+{
+	return
+		_givenType.isValueType() &&
+		_givenType.category() != Type::Category::Function &&
+		_givenType.category() != Type::Category::StringLiteral &&
+		!_givenType.dataStoredIn(DataLocation::Storage) &&
+		_givenType.sizeOnStack() == 1 &&
+		_targetType.isValueType() &&
+		!_targetType.isDynamicallyEncoded();
+}
+
 size_t ABIFunctions::numVariablesForType(Type const& _type, EncodingOptions const& _options)
 {
 	if (_type.category() == Type::Category::Function && !_options.encodeFunctionFromStack)
@@ -76,20 +76,27 @@ public:
 	/// Does not allocate memory (does not change the free memory pointer), but writes
 	/// to memory starting at $headStart and an unrestricted amount after that.
 	/// If @reversed is true, the order of the variables after <headStart> is reversed.
+	/// @param _inlineValueTypes if true, values of value types are cleaned up or converted and
+	/// stored at their constant offset directly in the function instead of calling an encoding
+	/// function for each of them. For tuples of static types, this results in a single mstore
+	/// per element. This makes the function cheaper to call, at the expense of code that cannot
+	/// be shared between encoders.
 	std::string tupleEncoder(
 		TypePointers const& _givenTypes,
 		TypePointers _targetTypes,
 		bool _encodeAsLibraryTypes = false,
-		bool _reversed = false
+		bool _reversed = false,
+		bool _inlineValueTypes = false
 	);
 
 	/// Specialization of tupleEncoder to _reversed = true
 	std::string tupleEncoderReversed(
 		TypePointers const& _givenTypes,
 		TypePointers const& _targetTypes,
-		bool _encodeAsLibraryTypes = false
+		bool _encodeAsLibraryTypes = false,
+		bool _inlineValueTypes = false
 	) {
-		return tupleEncoder(_givenTypes, _targetTypes, _encodeAsLibraryTypes, true);
+		return tupleEncoder(_givenTypes, _targetTypes, _encodeAsLibraryTypes, true, _inlineValueTypes);
 	}
 
 	/// @returns name of an assembly function to encode values of @a _givenTypes
@@ -123,7 +130,10 @@ public:
 	/// Outputs: <value0> <value1> ... <valuen>
 	/// The values represent stack slots. If a type occupies more or less than one
 	/// stack slot, it takes exactly that number of values.
-	std::string tupleDecoder(TypePointers const& _types, bool _fromMemory = false);
+	/// @param _inlineValueTypes if true, values of value types are loaded and validated directly
+	/// in the function instead of calling a decoding function for each of them. This makes the
+	/// function cheaper to call, at the expense of code that cannot be shared between decoders.
+	std::string tupleDecoder(TypePointers const& _types, bool _fromMemory = false, bool _inlineValueTypes = false);
 
 	struct EncodingOptions
 	{
@@ -267,6 +277,15 @@ private:
 	/// @returns the size of the static part of the encoding of the given types.
 	static size_t headSize(TypePointers const& _targetTypes);
 
+	/// @returns true if values of the given decoding type can be decoded by a single load
+	/// followed by validation, which is the case for value types other than function types.
+	static bool isInlineDecodable(Type const& _decodingType);
+
+	/// @returns true if values of the given type can be encoded as the given target type by
+	/// a single mstore of the cleaned up or converted value, which is the case for value types
+	/// other than function types that are not storage references.
+	static bool isInlineEncodable(Type const& _givenType, Type const& _targetType);
+
 	/// @returns the number of variables needed to store a type.
 	/// This is one for almost all types. The exception being dynamically sized calldata arrays or
 	/// external function types (if we are encoding from stack, i.e. _options.encodeFunctionFromStack
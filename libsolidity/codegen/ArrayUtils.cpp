@@ -58,6 +58,16 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 	bool sourceIsStorage = _sourceType.location() == DataLocation::Storage;
 	bool fromCalldata = _sourceType.location() == DataLocation::CallData;
 	bool directCopy = sourceIsStorage && sourceBaseType->isValueType() && *sourceBaseType == *targetBaseType;
+	// Full-word values of identical type can be copied from memory or calldata without
+	// cleanup or conversion.
+	bool wordCopy =
+		!sourceIsStorage &&
+		*sourceBaseType == *targetBaseType &&
+		targetBaseType->storageBytes() == 32 &&
+		(
+			targetBaseType->category() == Type::Category::Integer ||
+			targetBaseType->category() == Type::Category::FixedBytes
+		);
 	bool haveByteOffsetSource = !directCopy && sourceIsStorage && sourceBaseType->storageBytes() <= 16;
 	bool haveByteOffsetTarget = !directCopy && targetBaseType->storageBytes() <= 16;
 	unsigned byteOffsetSize = (haveByteOffsetSource ? 1u : 0u) + (haveByteOffsetTarget ? 1u : 0u);
@@ -207,6 +217,13 @@ void ArrayUtils::copyArrayToStorage(ArrayType const& _targetType, ArrayType cons
 					<< Instruction::DUP3 << Instruction::SLOAD
 					<< Instruction::DUP3 << Instruction::SSTORE;
 			}
+			else if (wordCopy)
+			{
+				solAssert(byteOffsetSize == 0, "Byte offset for word copy.");
+				_context
+					<< Instruction::DUP3 << (fromCalldata ? Instruction::CALLDATALOAD : Instruction::MLOAD)
+					<< Instruction::DUP3 << Instruction::SSTORE;
+			}
 			else
 			{
 				// Note that we have to copy each element on its own in case conversion is involved.
@@ -33,9 +33,12 @@ using namespace solidity::frontend;
 void Compiler::compileContract(
 	ContractDefinition const& _contract,
 	std::map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers,
-	bytes const& _metadata
+	bytes const& _metadata,
+	std::vector<util::PhaseStatistics>* _phaseStatistics,
+	bool _recordOptimiserStatistics
 )
 {
+	util::PhaseRecorder phases("evmCodeGeneration", _phaseStatistics);
 	ContractCompiler runtimeCompiler(nullptr, m_runtimeContext, m_optimiserSettings);
 	runtimeCompiler.compileContract(_contract, _otherCompilers);
 	m_runtimeContext.appendToAuxiliaryData(_metadata);
@@ -49,7 +52,9 @@ void Compiler::compileContract(
 	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
 	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
 
-	m_context.optimise(m_optimiserSettings);
+	phases.start("evmasmOptimization");
+	m_context.optimise(m_optimiserSettings, _recordOptimiserStatistics);
+	phases.stop();
 
 	solAssert(m_context.appendYulUtilityFunctionsRan(), "appendYulUtilityFunctions() was not called.");
 	solAssert(m_runtimeContext.appendYulUtilityFunctionsRan(), "appendYulUtilityFunctions() was not called.");
@@ -28,6 +28,7 @@
 #include <libsolidity/interface/DebugSettings.h>
 #include <liblangutil/EVMVersion.h>
 #include <libevmasm/Assembly.h>
+#include <libsolutil/PhaseStatistics.h>
 #include <functional>
 #include <ostream>
 
@@ -37,18 +38,34 @@ namespace solidity::frontend
 class Compiler
 {
 public:
-	Compiler(langutil::EVMVersion _evmVersion, RevertStrings _revertStrings, OptimiserSettings _optimiserSettings):
+	/// @param _yulUtilityCodeCache if not null, the cache of the Yul utility code shared with the
+	/// compilers of other contracts.
+	Compiler(
+		langutil::EVMVersion _evmVersion,
+		RevertStrings _revertStrings,
+		OptimiserSettings _optimiserSettings,
+		YulUtilityCodeCache* _yulUtilityCodeCache = nullptr
+	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_runtimeContext(_evmVersion, _revertStrings),
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
-	{ }
+	{
+		m_runtimeContext.setYulUtilityCodeCache(_yulUtilityCodeCache);
+		m_context.setYulUtilityCodeCache(_yulUtilityCodeCache);
+	}
 
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
+	/// @arg _phaseStatistics if not null, the wall time and memory usage of the code generation
+	/// and of the assembly optimizer are appended to it.
+	/// @arg _recordOptimiserStatistics if true, the assembly optimizer counts the applied
+	/// optimisations, see evmasm::Assembly::optimiserStatistics.
 	void compileContract(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
-		bytes const& _metadata
+		bytes const& _metadata,
+		std::vector<util::PhaseStatistics>* _phaseStatistics = nullptr,
+		bool _recordOptimiserStatistics = false
 	);
 	/// @returns Entire assembly.
 	evmasm::Assembly const& assembly() const { return m_context.assembly(); }
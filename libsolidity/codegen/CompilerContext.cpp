@@ -196,18 +196,39 @@ void CompilerContext::appendYulUtilityFunctions(OptimiserSettings const& _optimi
 	m_appendYulUtilityFunctionsRan = true;
 
 	string code = m_yulFunctionCollector.requestedFunctions();
-	if (!code.empty())
-	{
-		appendInlineAssembly(
-			yul::reindent("{\n" + std::move(code) + "\n}"),
-			{},
-			m_externallyUsedYulFunctions,
-			true,
-			_optimiserSettings,
-			yulUtilityFileName()
-		);
-		solAssert(!m_generatedYulUtilityCode.empty(), "");
-	}
+	if (code.empty())
+		return;
+	code = yul::reindent("{\n" + std::move(code) + "\n}");
+
+	if (m_yulUtilityCodeCache)
+		if (auto const* entry = m_yulUtilityCodeCache->find(code, m_externallyUsedYulFunctions, _optimiserSettings))
+		{
+			// Another contract of this compilation requested the same utility code,
+			// so it does not have to be parsed, analysed and optimised again.
+			m_generatedYulUtilityCode = entry->generatedCode;
+			yul::CodeGenerator::assemble(
+				*entry->code,
+				*entry->analysisInfo,
+				*m_asm,
+				m_evmVersion,
+				{},
+				true,
+				_optimiserSettings.optimizeStackAllocation
+			);
+			updateSourceLocation();
+			solAssert(!m_generatedYulUtilityCode.empty(), "");
+			return;
+		}
+
+	appendInlineAssembly(
+		code,
+		{},
+		m_externallyUsedYulFunctions,
+		true,
+		_optimiserSettings,
+		yulUtilityFileName()
+	);
+	solAssert(!m_generatedYulUtilityCode.empty(), "");
 }
 
 void CompilerContext::addVariable(
@@ -518,6 +539,14 @@ void CompilerContext::appendInlineAssembly(
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(errorReporter.errors().empty(), "Failed to analyze inline assembly block.");
+	if (_system && m_yulUtilityCodeCache)
+		m_yulUtilityCodeCache->store(_assembly, {
+			_externallyUsedFunctions,
+			_optimiserSettings,
+			parserResult,
+			make_shared<yul::AsmAnalysisInfo>(analysisInfo),
+			m_generatedYulUtilityCode
+		});
 	yul::CodeGenerator::assemble(
 		*parserResult,
 		analysisInfo,
@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/YulUtilityCodeCache.h>
 
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -65,7 +66,7 @@ public:
 		RevertStrings _revertStrings,
 		CompilerContext* _runtimeContext = nullptr
 	):
-		m_asm(std::make_shared<evmasm::Assembly>(_evmVersion, _runtimeContext != nullptr, std::string{})),
+		m_asm(std::make_shared<evmasm::Assembly>(_evmVersion, _runtimeContext != nullptr, std::nullopt, std::string{})),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
@@ -173,6 +174,9 @@ public:
 	/// Should be called exactly once on each context.
 	void appendYulUtilityFunctions(OptimiserSettings const& _optimiserSettings);
 	bool appendYulUtilityFunctionsRan() const { return m_appendYulUtilityFunctionsRan; }
+	/// Sets a cache to look up the Yul utility code in before it is parsed, analysed and optimised.
+	/// Has to be cleared whenever the EVM version changes.
+	void setYulUtilityCodeCache(YulUtilityCodeCache* _cache) { m_yulUtilityCodeCache = _cache; }
 	std::string const& generatedYulUtilityCode() const { return m_generatedYulUtilityCode; }
 	static std::string yulUtilityFileName() { return "#utility.yul"; }
 
@@ -283,7 +287,13 @@ public:
 	void appendToAuxiliaryData(bytes const& _data) { m_asm->appendToAuxiliaryData(_data); }
 
 	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion)); }
+	/// @param _recordStatistics if true, the applied optimisations are counted, see evmasm::Assembly::optimiserStatistics.
+	void optimise(OptimiserSettings const& _settings, bool _recordStatistics = false)
+	{
+		evmasm::Assembly::OptimiserSettings settings = evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion);
+		settings.recordStatistics = _recordStatistics;
+		m_asm->optimise(settings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
@@ -393,6 +403,8 @@ private:
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
 	/// Flag to check that appendYulUtilityFunctions() was called exactly once
 	bool m_appendYulUtilityFunctionsRan = false;
+	/// Cache of the Yul utility code shared with the contexts of other contracts, if any.
+	YulUtilityCodeCache* m_yulUtilityCodeCache = nullptr;
 };
 
 }
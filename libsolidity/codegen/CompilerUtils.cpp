@@ -244,14 +244,14 @@ void CompilerUtils::storeInMemoryDynamic(Type const& _type, bool _padToWordBound
 	}
 }
 
-void CompilerUtils::abiDecode(TypePointers const& _typeParameters, bool _fromMemory)
+void CompilerUtils::abiDecode(TypePointers const& _typeParameters, bool _fromMemory, bool _inlineValueTypes)
 {
 	/// Stack: <source_offset> <length>
 	if (m_context.useABICoderV2())
 	{
 		// Use the new Yul-based decoding function
 		auto stackHeightBefore = m_context.stackHeight();
-		abiDecodeV2(_typeParameters, _fromMemory);
+		abiDecodeV2(_typeParameters, _fromMemory, _inlineValueTypes);
 		solAssert(m_context.stackHeight() - stackHeightBefore == sizeOnStack(_typeParameters) - 2);
 		return;
 	}
@@ -425,7 +425,8 @@ void CompilerUtils::encodeToMemory(
 	TypePointers const& _targetTypes,
 	bool _padToWordBoundaries,
 	bool _copyDynamicDataInPlace,
-	bool _encodeAsLibraryTypes
+	bool _encodeAsLibraryTypes,
+	bool _inlineValueTypes
 )
 {
 	// stack: <v1> <v2> ... <vn> <mem>
@@ -449,7 +450,13 @@ void CompilerUtils::encodeToMemory(
 			"Non-padded and in-place encoding can only be combined."
 		);
 		auto stackHeightBefore = m_context.stackHeight();
-		abiEncodeV2(_givenTypes, targetTypes, _encodeAsLibraryTypes, _padToWordBoundaries);
+		abiEncodeV2(
+			_givenTypes,
+			targetTypes,
+			_encodeAsLibraryTypes,
+			_padToWordBoundaries,
+			_inlineValueTypes && _padToWordBoundaries
+		);
 		solAssert(stackHeightBefore - m_context.stackHeight() == sizeOnStack(_givenTypes));
 		return;
 	}
@@ -610,28 +617,32 @@ void CompilerUtils::abiEncodeV2(
 	TypePointers const& _givenTypes,
 	TypePointers const& _targetTypes,
 	bool _encodeAsLibraryTypes,
-	bool _padToWordBoundaries
+	bool _padToWordBoundaries,
+	bool _inlineValueTypes
 )
 {
 	if (!_padToWordBoundaries)
+	{
 		solAssert(!_encodeAsLibraryTypes, "Library calls cannot be packed.");
+		solAssert(!_inlineValueTypes, "Packed encoding does not inline value types.");
+	}
 
 	// stack: <$value0> <$value1> ... <$value(n-1)> <$headStart>
 
 	string encoderName =
 		_padToWordBoundaries ?
-		m_context.abiFunctions().tupleEncoderReversed(_givenTypes, _targetTypes, _encodeAsLibraryTypes) :
+		m_context.abiFunctions().tupleEncoderReversed(_givenTypes, _targetTypes, _encodeAsLibraryTypes, _inlineValueTypes) :
 		m_context.abiFunctions().tupleEncoderPackedReversed(_givenTypes, _targetTypes);
 	m_context.callYulFunction(encoderName, sizeOnStack(_givenTypes) + 1, 1);
 }
 
-void CompilerUtils::abiDecodeV2(TypePointers const& _parameterTypes, bool _fromMemory)
+void CompilerUtils::abiDecodeV2(TypePointers const& _parameterTypes, bool _fromMemory, bool _inlineValueTypes)
 {
 	// stack: <source_offset> <length> [stack top]
 	m_context << Instruction::DUP2 << Instruction::ADD;
 	m_context << Instruction::SWAP1;
 	// stack: <end> <start>
-	string decoderName = m_context.abiFunctions().tupleDecoder(_parameterTypes, _fromMemory);
+	string decoderName = m_context.abiFunctions().tupleDecoder(_parameterTypes, _fromMemory, _inlineValueTypes);
 	m_context.callYulFunction(decoderName, 2, sizeOnStack(_parameterTypes));
 }
 
@@ -667,15 +678,24 @@ void CompilerUtils::memoryCopy32()
 {
 	// Stack here: size target source
 
-	m_context.appendInlineAssembly(R"(
-		{
-			for { let i := 0 } lt(i, len) { i := add(i, 32) } {
-				mstore(add(dst, i), mload(add(src, i)))
+	if (m_context.evmVersion().hasMcopy())
+		m_context.appendInlineAssembly(R"(
+			{
+				mcopy(dst, src, and(add(len, 31), not(31)))
 			}
-		}
-	)",
-		{ "len", "dst", "src" }
-	);
+		)",
+			{ "len", "dst", "src" }
+		);
+	else
+		m_context.appendInlineAssembly(R"(
+			{
+				for { let i := 0 } lt(i, len) { i := add(i, 32) } {
+					mstore(add(dst, i), mload(add(src, i)))
+				}
+			}
+		)",
+			{ "len", "dst", "src" }
+		);
 	m_context << Instruction::POP << Instruction::POP << Instruction::POP;
 }
 
@@ -683,6 +703,19 @@ void CompilerUtils::memoryCopy()
 {
 	// Stack here: size target source
 
+	if (m_context.evmVersion().hasMcopy())
+	{
+		m_context.appendInlineAssembly(R"(
+			{
+				mcopy(dst, src, len)
+			}
+		)",
+			{ "len", "dst", "src" }
+		);
+		m_context << Instruction::POP << Instruction::POP << Instruction::POP;
+		return;
+	}
+
 	m_context.appendInlineAssembly(R"(
 		{
 			// copy 32 bytes at once
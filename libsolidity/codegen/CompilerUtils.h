@@ -127,9 +127,11 @@ public:
 	/// Calls revert if the supplied size is shorter than the static data requirements
 	/// or if dynamic data pointers reach outside of the area.
 	/// Also has a hard cap of 0x100000000 for any given length/offset field.
+	/// If @a _inlineValueTypes is true and ABI coder v2 is used, value types are decoded without
+	/// calling a separate function for each of them.
 	/// Stack pre: <source_offset> <length>
 	/// Stack post: <value0> <value1> ... <valuen>
-	void abiDecode(TypePointers const& _typeParameters, bool _fromMemory = false);
+	void abiDecode(TypePointers const& _typeParameters, bool _fromMemory = false, bool _inlineValueTypes = false);
 
 	/// Copies values (of types @a _givenTypes) given on the stack to a location in memory given
 	/// at the stack top, encoding them according to the ABI as the given types @a _targetTypes.
@@ -142,6 +144,8 @@ public:
 	/// together with fixed-length data.
 	/// @param _encodeAsLibraryTypes if true, encodes for a library function, e.g. does not
 	/// convert storage pointer types to memory types.
+	/// @param _inlineValueTypes if true and ABI coder v2 is used for padded encoding, value
+	/// types are encoded without calling a separate function for each of them.
 	/// @note the locations of target reference types are ignored, because it will always be
 	/// memory.
 	void encodeToMemory(
@@ -149,7 +153,8 @@ public:
 		TypePointers const& _targetTypes,
 		bool _padToWords,
 		bool _copyDynamicDataInPlace,
-		bool _encodeAsLibraryTypes = false
+		bool _encodeAsLibraryTypes = false,
+		bool _inlineValueTypes = false
 	);
 
 	/// Special case of @a encodeToMemory which assumes tight packing, e.g. no zero padding
@@ -172,30 +177,36 @@ public:
 	void abiEncode(
 		TypePointers const& _givenTypes,
 		TypePointers const& _targetTypes,
-		bool _encodeAsLibraryTypes = false
+		bool _encodeAsLibraryTypes = false,
+		bool _inlineValueTypes = false
 	)
 	{
-		encodeToMemory(_givenTypes, _targetTypes, true, false, _encodeAsLibraryTypes);
+		encodeToMemory(_givenTypes, _targetTypes, true, false, _encodeAsLibraryTypes, _inlineValueTypes);
 	}
 
 	/// Special case of @a encodeToMemory which assumes that everything is padded to words
 	/// and dynamic data is not copied in place (i.e. a proper ABI encoding).
 	/// Uses a new, less tested encoder implementation.
+	/// If @a _inlineValueTypes is set to true, value types are encoded without calling
+	/// a separate function for each of them. Only allowed for padded encoding.
 	/// Stack pre: <value0> <value1> ... <valueN-1> <head_start>
 	/// Stack post: <mem_ptr>
 	void abiEncodeV2(
 		TypePointers const& _givenTypes,
 		TypePointers const& _targetTypes,
 		bool _encodeAsLibraryTypes = false,
-		bool _padToWordBoundaries = true
+		bool _padToWordBoundaries = true,
+		bool _inlineValueTypes = false
 	);
 
 	/// Decodes data from ABI encoding into internal encoding. If @a _fromMemory is set to true,
 	/// the data is taken from memory instead of from calldata.
+	/// If @a _inlineValueTypes is set to true, value types are decoded without calling
+	/// a separate function for each of them.
 	/// Can allocate memory.
 	/// Stack pre: <source_offset> <length>
 	/// Stack post: <value0> <value1> ... <valuen>
-	void abiDecodeV2(TypePointers const& _parameterTypes, bool _fromMemory = false);
+	void abiDecodeV2(TypePointers const& _parameterTypes, bool _fromMemory = false, bool _inlineValueTypes = false);
 
 	/// Zero-initialises (the data part of) an already allocated memory array.
 	/// Length has to be nonzero!
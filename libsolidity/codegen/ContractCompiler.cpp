@@ -42,7 +42,6 @@
 
 #include <libevmasm/Instruction.h>
 #include <libevmasm/Assembly.h>
-#include <libevmasm/GasMeter.h>
 
 #include <liblangutil/ErrorReporter.h>
 
@@ -325,60 +324,23 @@ void ContractCompiler::appendDelegatecallCheck()
 
 void ContractCompiler::appendInternalSelector(
 	map<FixedHash<4>, evmasm::AssemblyItem const> const& _entryPoints,
-	vector<FixedHash<4>> const& _ids,
-	evmasm::AssemblyItem const& _notFoundTag,
-	size_t _runs
+	DispatchTree const& _tree,
+	evmasm::AssemblyItem const& _notFoundTag
 )
 {
-	// Code for selecting from n functions without split:
-	//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
-	//   push2/3 <notfound> jump
-	// (called SELECT[n])
-	// Code for selecting from n functions with split:
-	//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
-	//     SELECT[n/2]
-	//   tag_less:
-	//     SELECT[n/2]
-	//
-	// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
-	// The average execution cost if we do not split at all are:
-	//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
-	// If we split once:
-	//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
-	//
-	// We should split if
-	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
-	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
-	//
-	// Which also means that the execution itself is not profitable
-	// unless we have at least 5 functions.
-
-	// Start with some comparisons to avoid overflow, then do the actual comparison.
-	bool split = false;
-	if (_ids.size() <= 4)
-		split = false;
-	else if (_runs > (17 * evmasm::GasCosts::createDataGas) / 6)
-		split = true;
-	else
-		split = (_runs * 6 * (_ids.size() - 4) > 17 * evmasm::GasCosts::createDataGas);
-
-	if (split)
+	if (!_tree.isLeaf())
 	{
-		size_t pivotIndex = _ids.size() / 2;
-		FixedHash<4> pivot{_ids.at(pivotIndex)};
-		m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(pivot)) << Instruction::GT;
+		m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(_tree.pivot)) << Instruction::GT;
 		evmasm::AssemblyItem lessTag{m_context.appendConditionalJump()};
 		// Here, we have funid >= pivot
-		vector<FixedHash<4>> larger{_ids.begin() + static_cast<ptrdiff_t>(pivotIndex), _ids.end()};
-		appendInternalSelector(_entryPoints, larger, _notFoundTag, _runs);
+		appendInternalSelector(_entryPoints, *_tree.larger, _notFoundTag);
 		m_context << lessTag;
 		// Here, we have funid < pivot
-		vector<FixedHash<4>> smaller{_ids.begin(), _ids.begin() + static_cast<ptrdiff_t>(pivotIndex)};
-		appendInternalSelector(_entryPoints, smaller, _notFoundTag, _runs);
+		appendInternalSelector(_entryPoints, *_tree.smaller, _notFoundTag);
 	}
 	else
 	{
-		for (auto const& id: _ids)
+		for (auto const& id: _tree.selectors)
 		{
 			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
 			m_context.appendConditionalJumpTo(_entryPoints.at(id));
@@ -448,14 +410,17 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 		CompilerUtils(m_context).loadFromMemory(0, IntegerType(CompilerUtils::dataStartOffset * 8), true, false);
 
 		// stack now is: <can-call-non-view-functions>? <funhash>
-		vector<FixedHash<4>> sortedIDs;
+		vector<FixedHash<4>> ids;
 		for (auto const& it: interfaceFunctions)
 		{
 			callDataUnpackerEntryPoints.emplace(it.first, m_context.newTag());
-			sortedIDs.emplace_back(it.first);
+			ids.emplace_back(it.first);
 		}
-		std::sort(sortedIDs.begin(), sortedIDs.end());
-		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		appendInternalSelector(
+			callDataUnpackerEntryPoints,
+			DispatchTree::build(std::move(ids), m_optimiserSettings.expectedExecutionsPerDeployment, m_optimiserSettings.callProfile),
+			notFound
+		);
 	}
 
 	m_context << notFoundOrReceiveEther;
@@ -530,12 +495,14 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 
 		// Return tag is used to jump out of the function.
 		evmasm::AssemblyItem returnTag = m_context.pushNewTag();
+		// Frequently called functions use a decoder and an encoder that are cheaper to call.
+		bool const frequentlyCalled = util::valueOrDefault(m_optimiserSettings.callProfile, it.first, size_t(0)) > 0;
 		if (!functionType->parameterTypes().empty())
 		{
 			// Parameter for calldataUnpacker
 			m_context << CompilerUtils::dataStartOffset;
 			m_context << Instruction::DUP1 << Instruction::CALLDATASIZE << Instruction::SUB;
-			CompilerUtils(m_context).abiDecode(functionType->parameterTypes());
+			CompilerUtils(m_context).abiDecode(functionType->parameterTypes(), false, frequentlyCalled);
 		}
 		m_context.appendJumpTo(
 			m_context.functionEntryLabel(functionType->declaration()),
@@ -549,11 +516,11 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 			1
 		);
 		// Consumes the return parameters.
-		appendReturnValuePacker(functionType->returnParameterTypes(), _contract.isLibrary());
+		appendReturnValuePacker(functionType->returnParameterTypes(), _contract.isLibrary(), frequentlyCalled);
 	}
 }
 
-void ContractCompiler::appendReturnValuePacker(TypePointers const& _typeParameters, bool _isLibrary)
+void ContractCompiler::appendReturnValuePacker(TypePointers const& _typeParameters, bool _isLibrary, bool _inlineValueTypes)
 {
 	CompilerUtils utils(m_context);
 	if (_typeParameters.empty())
@@ -563,7 +530,7 @@ void ContractCompiler::appendReturnValuePacker(TypePointers const& _typeParamete
 		utils.fetchFreeMemoryPointer();
 		//@todo optimization: if we return a single memory array, there should be enough space before
 		// its data to add the needed parts and we avoid a memory copy.
-		utils.abiEncode(_typeParameters, _typeParameters, _isLibrary);
+		utils.abiEncode(_typeParameters, _typeParameters, _isLibrary, _inlineValueTypes);
 		utils.toSizeAfterFreeMemoryPointer();
 		m_context << Instruction::RETURN;
 	}
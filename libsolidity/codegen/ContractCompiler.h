@@ -25,6 +25,7 @@
 
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/codegen/CompilerContext.h>
+#include <libsolidity/codegen/DispatchTree.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libevmasm/Assembly.h>
 #include <functional>
@@ -87,17 +88,17 @@ private:
 	/// This is done by inserting a specific push constant as the first instruction
 	/// whose data will be modified in memory at deploy time.
 	void appendDelegatecallCheck();
-	/// Appends the function selector. Is called recursively to create a binary search tree.
-	/// @a _runs the number of intended executions of the contract to tune the split point.
+	/// Appends the function selector. Is called recursively for each node of @a _tree.
 	void appendInternalSelector(
 		std::map<util::FixedHash<4>, evmasm::AssemblyItem const> const& _entryPoints,
-		std::vector<util::FixedHash<4>> const& _ids,
-		evmasm::AssemblyItem const& _notFoundTag,
-		size_t _runs
+		DispatchTree const& _tree,
+		evmasm::AssemblyItem const& _notFoundTag
 	);
 	void appendFunctionSelector(ContractDefinition const& _contract);
 	void appendCallValueCheck();
-	void appendReturnValuePacker(TypePointers const& _typeParameters, bool _isLibrary);
+	/// Encodes the return values and returns. If @a _inlineValueTypes is true, value types
+	/// are encoded without calling a separate function for each of them.
+	void appendReturnValuePacker(TypePointers const& _typeParameters, bool _isLibrary, bool _inlineValueTypes);
 
 	void registerStateVariables(ContractDefinition const& _contract);
 	void registerImmutableVariables(ContractDefinition const& _contract);
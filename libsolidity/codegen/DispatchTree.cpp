@@ -0,0 +1,184 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/codegen/DispatchTree.h>
+
+#include <libevmasm/GasMeter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+// Code for selecting from n functions without split:
+//   n times: dup1, push4 <id_i>, eq, push2/3 <tag_i>, jumpi
+//   push2/3 <notfound> jump
+// (called SELECT[n])
+// Code for selecting from n functions with split:
+//   dup1, push4 <pivot>, gt, push2/3<tag_less>, jumpi
+//     SELECT[n/2]
+//   tag_less:
+//     SELECT[n/2]
+//
+// This means each split adds 16-18 bytes of additional code (note the additional jump out!)
+// The average execution cost if we do not split at all are:
+//   (3 + 3 + 3 + 3 + 10) * n/2 = 24 * n/2 = 12 * n
+// If we split once:
+//    (3 + 3 + 3 + 3 + 10) + 24 * n/4 = 24 * (n/4 + 1) = 6 * n + 24;
+//
+// We should split if
+//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
+// <=> _runs * 6 * (n - 4) > 17 * createDataGas
+//
+// Which also means that the execution itself is not profitable
+// unless we have at least 5 functions.
+//
+// If a call profile is given, the expected cost of a call is the sum of the costs of the
+// comparisons needed to reach each function weighted by its relative frequency. The selectors
+// of a leaf are compared in the order of decreasing frequency and the pivot of a split is
+// chosen such that both halves receive about the same share of the calls. A split is made if
+// the saved execution cost exceeds the deploy cost of the additional code of the split and of
+// all splits below it.
+
+namespace
+{
+
+/// Execution cost of comparing the selector with a value and jumping: dup1, push4, eq/gt, push2/3, jumpi.
+double constexpr comparisonCost = 3 + 3 + 3 + 3 + 10;
+/// Number of bytes a split adds to the code.
+size_t constexpr splitSize = 17;
+
+DispatchTree buildUnweighted(vector<FixedHash<4>> _ids, size_t _runs)
+{
+	// Start with some comparisons to avoid overflow, then do the actual comparison.
+	bool split = false;
+	if (_ids.size() <= 4)
+		split = false;
+	else if (_runs > (splitSize * evmasm::GasCosts::createDataGas) / 6)
+		split = true;
+	else
+		split = (_runs * 6 * (_ids.size() - 4) > splitSize * evmasm::GasCosts::createDataGas);
+
+	DispatchTree tree;
+	if (split)
+	{
+		auto pivot = _ids.begin() + static_cast<ptrdiff_t>(_ids.size() / 2);
+		tree.pivot = *pivot;
+		tree.larger = make_unique<DispatchTree>(buildUnweighted({pivot, _ids.end()}, _runs));
+		tree.smaller = make_unique<DispatchTree>(buildUnweighted({_ids.begin(), pivot}, _runs));
+	}
+	else
+		tree.selectors = std::move(_ids);
+	return tree;
+}
+
+struct WeightedTree
+{
+	DispatchTree tree;
+	/// Expected execution cost of a call.
+	double cost = 0;
+	size_t splitCount = 0;
+};
+
+/// Builds the tree for the given selectors, which have to be sorted, together with their weights.
+WeightedTree buildWeighted(vector<pair<FixedHash<4>, double>> const& _ids, double _runs)
+{
+	double totalWeight = 0;
+	for (auto const& id: _ids)
+		totalWeight += id.second;
+
+	WeightedTree leaf;
+	vector<pair<FixedHash<4>, double>> byWeight = _ids;
+	stable_sort(byWeight.begin(), byWeight.end(), [](auto const& _a, auto const& _b) { return _a.second > _b.second; });
+	for (size_t index = 0; index < byWeight.size(); ++index)
+	{
+		leaf.tree.selectors.emplace_back(byWeight[index].first);
+		if (totalWeight > 0)
+			leaf.cost += comparisonCost * static_cast<double>(index + 1) * byWeight[index].second / totalWeight;
+	}
+	if (_ids.size() <= 1 || totalWeight == 0)
+		return leaf;
+
+	// Choose the pivot that divides the calls most evenly.
+	size_t pivotIndex = 1;
+	double smallerWeight = 0;
+	double bestImbalance = numeric_limits<double>::infinity();
+	for (size_t index = 1; index < _ids.size(); ++index)
+	{
+		smallerWeight += _ids[index - 1].second;
+		double imbalance = abs(totalWeight - 2 * smallerWeight);
+		if (imbalance < bestImbalance)
+		{
+			bestImbalance = imbalance;
+			pivotIndex = index;
+		}
+	}
+	auto pivot = _ids.begin() + static_cast<ptrdiff_t>(pivotIndex);
+	vector<pair<FixedHash<4>, double>> larger{pivot, _ids.end()};
+	vector<pair<FixedHash<4>, double>> smaller{_ids.begin(), pivot};
+	double largerWeight = 0;
+	for (auto const& id: larger)
+		largerWeight += id.second;
+	smallerWeight = totalWeight - largerWeight;
+
+	WeightedTree largerTree = buildWeighted(larger, _runs * largerWeight / totalWeight);
+	WeightedTree smallerTree = buildWeighted(smaller, _runs * smallerWeight / totalWeight);
+
+	WeightedTree split;
+	split.cost =
+		comparisonCost +
+		(largerWeight * largerTree.cost + smallerWeight * smallerTree.cost) / totalWeight;
+	split.splitCount = 1 + largerTree.splitCount + smallerTree.splitCount;
+	double splitDeployCost = static_cast<double>(splitSize * evmasm::GasCosts::createDataGas * split.splitCount);
+	if (_runs * leaf.cost <= _runs * split.cost + splitDeployCost)
+		return leaf;
+
+	split.tree.pivot = pivot->first;
+	split.tree.larger = make_unique<DispatchTree>(std::move(largerTree.tree));
+	split.tree.smaller = make_unique<DispatchTree>(std::move(smallerTree.tree));
+	return split;
+}
+
+}
+
+DispatchTree DispatchTree::build(
+	vector<FixedHash<4>> _selectors,
+	size_t _runs,
+	map<FixedHash<4>, size_t> const& _callProfile
+)
+{
+	sort(_selectors.begin(), _selectors.end());
+
+	vector<pair<FixedHash<4>, double>> weightedSelectors;
+	bool profiled = false;
+	for (FixedHash<4> const& selector: _selectors)
+	{
+		auto it = _callProfile.find(selector);
+		size_t weight = it == _callProfile.end() ? 0 : it->second;
+		profiled = profiled || weight > 0;
+		weightedSelectors.emplace_back(selector, static_cast<double>(weight));
+	}
+
+	if (!profiled)
+		return buildUnweighted(std::move(_selectors), _runs);
+	return std::move(buildWeighted(weightedSelectors, static_cast<double>(_runs)).tree);
+}
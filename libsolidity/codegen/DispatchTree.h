@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Layout of the external function dispatcher, shared by both code generators.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Search tree the function dispatcher uses to find the function for a selector.
+ *
+ * A leaf compares the selector with each of its selectors in turn. An inner node compares the
+ * selector with the pivot and continues with the subtree @a larger if it is greater or equal,
+ * and with @a smaller otherwise.
+ */
+struct DispatchTree
+{
+	/// Builds the tree for the given selectors.
+	/// @param _runs the number of intended executions of the contract to tune the split points.
+	/// @param _callProfile relative call frequencies of the functions. If no function of
+	/// @a _selectors has a positive frequency, the tree is built assuming that all functions
+	/// are called equally often.
+	static DispatchTree build(
+		std::vector<util::FixedHash<4>> _selectors,
+		size_t _runs,
+		std::map<util::FixedHash<4>, size_t> const& _callProfile = {}
+	);
+
+	bool isLeaf() const { return !larger; }
+
+	/// Selectors of a leaf in the order they are compared with.
+	std::vector<util::FixedHash<4>> selectors;
+	util::FixedHash<4> pivot;
+	std::unique_ptr<DispatchTree> larger;
+	std::unique_ptr<DispatchTree> smaller;
+};
+
+}
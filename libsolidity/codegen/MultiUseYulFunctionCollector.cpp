@@ -23,6 +23,8 @@
 #include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
 
 #include <liblangutil/Exceptions.h>
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
 #include <libsolutil/StringUtils.h>
 
@@ -31,6 +33,12 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
+MultiUseYulFunctionCache::Entry const* MultiUseYulFunctionCache::find(string const& _name) const
+{
+	auto it = m_entries.find(_name);
+	return it == m_entries.end() ? nullptr : &it->second;
+}
+
 string MultiUseYulFunctionCollector::requestedFunctions()
 {
 	string result = std::move(m_code);
@@ -39,43 +47,122 @@ string MultiUseYulFunctionCollector::requestedFunctions()
 	return result;
 }
 
+string MultiUseYulFunctionCollector::createDataSection(string const& _name, bytes const& _data)
+{
+	solAssert(m_dataSectionsEnabled, "Data sections are not available.");
+	solAssert(!_name.empty(), "");
+	if (m_cache && !m_dependencyStack.empty())
+		m_dependencyStack.back().dataSections.emplace(_name, _data);
+
+	if (m_requestedDataSections.insert(_name).second)
+		m_dataSectionsCode += "data \"" + _name + "\" hex\"" + util::toHex(_data) + "\"\n";
+	return _name;
+}
+
+string MultiUseYulFunctionCollector::requestedDataSections()
+{
+	string result = std::move(m_dataSectionsCode);
+	m_dataSectionsCode.clear();
+	m_requestedDataSections.clear();
+	return result;
+}
+
 string MultiUseYulFunctionCollector::createFunction(string const& _name, function<string ()> const& _creator)
 {
+	return createFunction(_name, _creator, true);
+}
+
+string MultiUseYulFunctionCollector::createFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return createFunction(_name, [&]() { return functionCode(_name, _creator); }, true);
+}
+
+string MultiUseYulFunctionCollector::createContractSpecificFunction(string const& _name, function<string ()> const& _creator)
+{
+	return createFunction(_name, _creator, false);
+}
+
+string MultiUseYulFunctionCollector::createContractSpecificFunction(
+	string const& _name,
+	function<string(vector<string>&, vector<string>&)> const& _creator
+)
+{
+	return createFunction(_name, [&]() { return functionCode(_name, _creator); }, false);
+}
+
+string MultiUseYulFunctionCollector::createFunction(
+	string const& _name,
+	function<string ()> const& _creator,
+	bool _cacheable
+)
+{
+	solAssert(!_name.empty(), "");
+	bool const caching = _cacheable && m_cache;
+	if (caching && !m_dependencyStack.empty())
+		m_dependencyStack.back().dependencies.emplace_back(_name);
+	else
+		solAssert(m_dependencyStack.empty(), "Cached function depends on contract-specific function.");
+
 	if (!m_requestedFunctions.count(_name))
 	{
+		if (caching && m_cache->find(_name))
+		{
+			addCachedFunction(_name);
+			return _name;
+		}
+
 		m_requestedFunctions.insert(_name);
+		if (caching)
+			m_dependencyStack.emplace_back();
+		ScopeGuard popDependencies{[&] { if (caching) m_dependencyStack.pop_back(); }};
 		string fun = _creator();
 		solAssert(!fun.empty(), "");
 		solAssert(fun.find("function " + _name + "(") != string::npos, "Function not properly named.");
+		if (caching)
+		{
+			m_dependencyStack.back().code = fun;
+			m_cache->store(_name, std::move(m_dependencyStack.back()));
+		}
 		m_code += std::move(fun);
 	}
 	return _name;
 }
 
-string MultiUseYulFunctionCollector::createFunction(
+void MultiUseYulFunctionCollector::addCachedFunction(string const& _name)
+{
+	if (m_requestedFunctions.count(_name))
+		return;
+	MultiUseYulFunctionCache::Entry const* entry = m_cache->find(_name);
+	solAssert(entry, "Dependency of cached function not cached.");
+	m_requestedFunctions.insert(_name);
+	for (string const& dependency: entry->dependencies)
+		addCachedFunction(dependency);
+	for (auto const& [name, data]: entry->dataSections)
+		createDataSection(name, data);
+	m_code += entry->code;
+}
+
+string MultiUseYulFunctionCollector::functionCode(
 	string const& _name,
 	function<string(vector<string>&, vector<string>&)> const& _creator
 )
 {
-	solAssert(!_name.empty(), "");
-	if (!m_requestedFunctions.count(_name))
-	{
-		m_requestedFunctions.insert(_name);
-		vector<string> arguments;
-		vector<string> returnParameters;
-		string body = _creator(arguments, returnParameters);
-		solAssert(!body.empty(), "");
+	vector<string> arguments;
+	vector<string> returnParameters;
+	string body = _creator(arguments, returnParameters);
+	solAssert(!body.empty(), "");
 
-		m_code += Whiskers(R"(
+	return Whiskers(R"(
 			function <functionName>(<args>)<?+retParams> -> <retParams></+retParams> {
 				<body>
 			}
 		)")
-		("functionName", _name)
-		("args", joinHumanReadable(arguments))
-		("retParams", joinHumanReadable(returnParameters))
-		("body", body)
-		.render();
-	}
-	return _name;
+	("functionName", _name)
+	("args", joinHumanReadable(arguments))
+	("retParams", joinHumanReadable(returnParameters))
+	("body", body)
+	.render();
 }
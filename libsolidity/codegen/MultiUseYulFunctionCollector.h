@@ -22,14 +22,43 @@
 
 #pragma once
 
+#include <libsolutil/Common.h>
+
 #include <functional>
 #include <map>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace solidity::frontend
 {
 
+/**
+ * Cache of the code of generated Yul functions that can be shared between the function
+ * collectors of all contracts of a compilation.
+ * Together with the code, it stores the functions each function requested while it was being
+ * created, so that they can be added to a collector in the same order without generating them.
+ * Only valid as long as the settings the code depends on (EVM version, revert strings) do not change.
+ */
+class MultiUseYulFunctionCache
+{
+public:
+	struct Entry
+	{
+		std::string code;
+		std::vector<std::string> dependencies;
+		/// Data sections the function refers to, by name.
+		std::map<std::string, bytes> dataSections;
+	};
+
+	Entry const* find(std::string const& _name) const;
+	void store(std::string const& _name, Entry _entry) { m_entries.emplace(_name, std::move(_entry)); }
+	void clear() { m_entries.clear(); }
+
+private:
+	std::map<std::string, Entry> m_entries;
+};
+
 /**
  * Container of (unparsed) Yul functions identified by name which are meant to be generated
  * only once.
@@ -37,6 +66,10 @@ namespace solidity::frontend
 class MultiUseYulFunctionCollector
 {
 public:
+	/// Sets a cache to look up functions created via ``createFunction`` in and to store them to.
+	/// Has to be cleared whenever the settings the generated code depends on change.
+	void setCache(MultiUseYulFunctionCache* _cache) { m_cache = _cache; }
+
 	/// Helper function that uses @a _creator to create a function and add it to
 	/// @a m_requestedFunctions if it has not been created yet and returns @a _name in both
 	/// cases.
@@ -47,6 +80,15 @@ public:
 		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
 	);
 
+	/// Same as ``createFunction``, but for functions whose code depends on the contract
+	/// being compiled. These functions are never cached.
+	std::string createContractSpecificFunction(std::string const& _name, std::function<std::string()> const& _creator);
+
+	std::string createContractSpecificFunction(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	/// @returns concatenation of all generated functions in the order in which they were
 	/// generated.
 	/// Clears the internal list, i.e. calling it again will result in an
@@ -56,9 +98,42 @@ public:
 	/// @returns true IFF a function with the specified name has already been collected.
 	bool contains(std::string const& _name) const { return m_requestedFunctions.count(_name) > 0; }
 
+	/// Allows functions to refer to data sections of the Yul object their code is part of.
+	/// Must not be enabled for code that is not compiled as part of an object, like inline assembly.
+	void enableDataSections() { m_dataSectionsEnabled = true; }
+	bool dataSectionsEnabled() const { return m_dataSectionsEnabled; }
+
+	/// Adds a data section with the name @a _name and the content @a _data to the object unless
+	/// it has already been added and returns @a _name.
+	std::string createDataSection(std::string const& _name, bytes const& _data);
+
+	/// @returns the data sections referred to by the generated functions in the syntax of Yul
+	/// objects, in the order in which they were requested.
+	/// Clears the internal list, i.e. calling it again will result in an
+	/// empty return value.
+	std::string requestedDataSections();
+
 private:
+	std::string createFunction(std::string const& _name, std::function<std::string()> const& _creator, bool _cacheable);
+	/// Adds the cached function @a _name and its dependencies unless they are already present.
+	void addCachedFunction(std::string const& _name);
+
+	/// @returns the code of a function with the given name and the body, parameters and
+	/// return parameters provided by @a _creator.
+	static std::string functionCode(
+		std::string const& _name,
+		std::function<std::string(std::vector<std::string>&, std::vector<std::string>&)> const& _creator
+	);
+
 	std::set<std::string> m_requestedFunctions;
 	std::string m_code;
+	MultiUseYulFunctionCache* m_cache = nullptr;
+	/// Functions and data sections requested by each cacheable function that is currently
+	/// being created.
+	std::vector<MultiUseYulFunctionCache::Entry> m_dependencyStack;
+	bool m_dataSectionsEnabled = false;
+	std::set<std::string> m_requestedDataSections;
+	std::string m_dataSectionsCode;
 };
 
 }
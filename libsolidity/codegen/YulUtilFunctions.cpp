@@ -101,6 +101,18 @@ string YulUtilFunctions::copyToMemoryFunction(bool _fromCalldata, bool _cleanup)
 			("cleanup", _cleanup)
 			.render();
 		}
+		else if (m_evmVersion.hasMcopy())
+		{
+			return Whiskers(R"(
+				function <functionName>(src, dst, length) {
+					mcopy(dst, src, length)
+					<?cleanup>mstore(add(dst, length), 0)</cleanup>
+				}
+			)")
+			("functionName", functionName)
+			("cleanup", _cleanup)
+			.render();
+		}
 		else
 		{
 			return Whiskers(R"(
@@ -145,6 +157,24 @@ string YulUtilFunctions::storeLiteralInMemoryFunction(string const& _literal)
 
 	return m_functionCollector.createFunction(functionName, [&]() {
 		size_t words = (_literal.length() + 31) / 32;
+		// Copying from a data section costs less gas and, apart from short literals, less code
+		// than storing every word separately, but hides the literal from the optimiser.
+		if (words > 3 && m_functionCollector.dataSectionsEnabled())
+		{
+			// Copy whole words so that the end of the last word is zero as well.
+			bytes data = util::asBytes(_literal);
+			data.resize(words * 32, 0);
+			return Whiskers(R"(
+				function <functionName>(memPtr) {
+					datacopy(memPtr, dataoffset("<dataName>"), <length>)
+				}
+			)")
+			("functionName", functionName)
+			("dataName", m_functionCollector.createDataSection("literal_" + util::toHex(util::keccak256(_literal).asBytes()), data))
+			("length", to_string(data.size()))
+			.render();
+		}
+
 		vector<map<string, string>> wordParams(words);
 		for (size_t i = 0; i < words; ++i)
 		{
@@ -2045,6 +2075,10 @@ string YulUtilFunctions::copyValueArrayToStorageFunction(ArrayType const& _fromT
 						dstSlotValue := <maskFull>(srcSlotValue)
 						<updateSrcPtr>
 					<!sameTypeFromStorage>
+					<?wordCopy>
+						dstSlotValue := <loadWord>(srcPtr)
+						<updateSrcPtr>
+					<!wordCopy>
 						<?multipleItemsPerSlotDst>for { let j := 0 } lt(j, <itemsPerSlot>) { j := add(j, 1) } </multipleItemsPerSlotDst>
 						{
 							<?isFromStorage>
@@ -2064,6 +2098,7 @@ string YulUtilFunctions::copyValueArrayToStorageFunction(ArrayType const& _fromT
 
 							<updateSrcPtr>
 						}
+					</wordCopy>
 					</sameTypeFromStorage>
 
 					sstore(add(dstSlot, i), dstSlotValue)
@@ -2128,6 +2163,18 @@ string YulUtilFunctions::copyValueArrayToStorageFunction(ArrayType const& _fromT
 			sameTypeFromStorage = fromStorage;
 		}
 		templ("sameTypeFromStorage", sameTypeFromStorage);
+		// Full-word values of identical type need neither cleanup nor conversion,
+		// so they can be moved from memory or calldata to storage one word at a time.
+		bool wordCopy =
+			!fromStorage &&
+			*_fromType.baseType() == *_toType.baseType() &&
+			_toType.storageStride() == 32 &&
+			(
+				_toType.baseType()->category() == Type::Category::Integer ||
+				_toType.baseType()->category() == Type::Category::FixedBytes
+			);
+		templ("wordCopy", wordCopy);
+		templ("loadWord", fromCalldata ? "calldataload" : "mload");
 		if (sameTypeFromStorage)
 		{
 			templ("maskFull", maskLowerOrderBytesFunction(itemsPerSlot * _toType.storageStride()));
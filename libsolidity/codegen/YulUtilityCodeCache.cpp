@@ -0,0 +1,36 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/codegen/YulUtilityCodeCache.h>
+
+using namespace std;
+using namespace solidity::frontend;
+
+YulUtilityCodeCache::Entry const* YulUtilityCodeCache::find(
+	string const& _code,
+	set<string> const& _externallyUsedFunctions,
+	OptimiserSettings const& _optimiserSettings
+) const
+{
+	auto it = m_entries.find(_code);
+	if (it != m_entries.end())
+		for (Entry const& entry: it->second)
+			if (entry.externallyUsedFunctions == _externallyUsedFunctions && entry.optimiserSettings == _optimiserSettings)
+				return &entry;
+	return nullptr;
+}
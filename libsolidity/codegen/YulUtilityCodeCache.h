@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the Yul utility code of the legacy code generator.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/ASTForward.h>
+#include <libyul/AsmAnalysisInfo.h>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Cache of the parsed, analysed and optimised Yul utility code of the legacy code generator
+ * that can be shared between the compiler contexts of all contracts of a compilation.
+ * Entries are identified by the code, the externally used functions and the optimiser settings.
+ * Only valid as long as the EVM version does not change.
+ */
+class YulUtilityCodeCache
+{
+public:
+	struct Entry
+	{
+		std::set<std::string> externallyUsedFunctions;
+		OptimiserSettings optimiserSettings;
+		std::shared_ptr<yul::Block const> code;
+		std::shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+		/// The code to be returned by CompilerContext::generatedYulUtilityCode.
+		std::string generatedCode;
+	};
+
+	Entry const* find(
+		std::string const& _code,
+		std::set<std::string> const& _externallyUsedFunctions,
+		OptimiserSettings const& _optimiserSettings
+	) const;
+	void store(std::string _code, Entry _entry) { m_entries[std::move(_code)].emplace_back(std::move(_entry)); }
+	void clear() { m_entries.clear(); }
+
+private:
+	std::map<std::string, std::vector<Entry>> m_entries;
+};
+
+}
@@ -29,12 +29,16 @@
 #include <libsolidity/ast/ASTVisitor.h>
 #include <libsolidity/codegen/ABIFunctions.h>
 #include <libsolidity/codegen/CompilerUtils.h>
+#include <libsolidity/codegen/DispatchTree.h>
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/Version.h>
 
 #include <libyul/YulStack.h>
 #include <libyul/Utilities.h>
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/Whiskers.h>
 
@@ -85,15 +89,57 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 	return reachableCallables;
 }
 
+/// @returns a Yul switch on the variable `selector` that selects the cases as arranged by @a _tree.
+/// Splits of the tree turn into nested switches on the value of the selector.
+string selectorSwitch(map<FixedHash<4>, string> const& _cases, DispatchTree const& _tree)
+{
+	if (_tree.isLeaf())
+	{
+		string code = "switch selector\n";
+		for (FixedHash<4> const& selector: _tree.selectors)
+			code += _cases.at(selector);
+		return code + "default {}\n";
+	}
+
+	return Whiskers(R"(
+		switch lt(selector, <pivot>)
+		case 0 {
+			<larger>
+		}
+		default {
+			<smaller>
+		}
+	)")
+	("pivot", "0x" + _tree.pivot.hex())
+	("larger", selectorSwitch(_cases, *_tree.larger))
+	("smaller", selectorSwitch(_cases, *_tree.smaller))
+	.render();
+}
+
 }
 
 pair<string, string> IRGenerator::run(
 	ContractDefinition const& _contract,
 	bytes const& _cborMetadata,
-	map<ContractDefinition const*, string_view const> const& _otherYulSources
+	map<ContractDefinition const*, string_view const> const& _otherYulSources,
+	CompilationCache* _cache,
+	vector<yul::OptimiserProfile>* _optimiserProfiles,
+	MultiUseYulFunctionCache* _functionCache,
+	vector<util::PhaseStatistics>* _phaseStatistics
 )
 {
+	m_functionCache = _functionCache;
+	util::PhaseRecorder phase("irGeneration", _phaseStatistics);
 	string ir = yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+	phase.stop();
+
+	optional<h256> cacheKey;
+	if (_cache)
+	{
+		cacheKey = optimizedIRCacheKey(ir);
+		if (optional<string> cachedOptimizedIR = _cache->load(*cacheKey))
+			return {std::move(ir), std::move(*cachedOptimizedIR)};
+	}
 
 	yul::YulStack asmStack(
 		m_evmVersion,
@@ -102,6 +148,7 @@ pair<string, string> IRGenerator::run(
 		m_optimiserSettings,
 		m_context.debugInfoSelection()
 	);
+	asmStack.enablePhaseStatistics(_phaseStatistics != nullptr);
 	if (!asmStack.parseAndAnalyze("", ir))
 	{
 		string errorMessage;
@@ -112,9 +159,49 @@ pair<string, string> IRGenerator::run(
 			);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	asmStack.enableOptimiserProfiling(_optimiserProfiles != nullptr);
 	asmStack.optimize();
+	m_optimiserTimeBudgetExhausted = asmStack.optimiserTimeBudgetExhausted();
+	if (_optimiserProfiles)
+		*_optimiserProfiles += asmStack.optimiserProfiles();
+	if (_phaseStatistics)
+		*_phaseStatistics += asmStack.phaseStatistics();
+	string optimizedIR = asmStack.print(m_context.soliditySourceProvider());
+
+	// The result of an interrupted optimization depends on the speed of the machine.
+	if (_cache && !m_optimiserTimeBudgetExhausted)
+		_cache->store(*cacheKey, optimizedIR);
+
+	return {std::move(ir), std::move(optimizedIR)};
+}
 
-	return {std::move(ir), asmStack.print(m_context.soliditySourceProvider())};
+h256 IRGenerator::optimizedIRCacheKey(string const& _ir) const
+{
+	string settings =
+		VersionString + "\n" +
+		m_evmVersion.name() + "\n" +
+		(m_eofVersion.has_value() ? to_string(*m_eofVersion) : "legacy") + "\n" +
+		toString(m_context.debugInfoSelection()) + "\n";
+	for (bool flag: {
+		m_optimiserSettings.runOrderLiterals,
+		m_optimiserSettings.runInliner,
+		m_optimiserSettings.runJumpdestRemover,
+		m_optimiserSettings.runPeephole,
+		m_optimiserSettings.runDeduplicate,
+		m_optimiserSettings.runCSE,
+		m_optimiserSettings.runConstantOptimiser,
+		m_optimiserSettings.optimizeStackAllocation,
+		m_optimiserSettings.runYulOptimiser
+	})
+		settings += flag ? '1' : '0';
+	settings +=
+		"\n" + m_optimiserSettings.yulOptimiserSteps +
+		":" + m_optimiserSettings.yulOptimiserCleanupSteps +
+		"\n" + to_string(m_optimiserSettings.expectedExecutionsPerDeployment) + "\n";
+	for (auto const& [function, executionCount]: m_optimiserSettings.yulInlinerProfile)
+		settings += function + ":" + to_string(executionCount) + "\n";
+
+	return keccak256(settings + _ir);
 }
 
 string IRGenerator::generate(
@@ -167,9 +254,11 @@ string IRGenerator::generate(
 					<deployedFunctions>
 				}
 				<deployedSubObjects>
+				<deployedDataSections>
 				data "<metadataName>" hex"<cborMetadata>"
 			}
 			<subObjects>
+			<dataSections>
 		}
 	)");
 
@@ -203,6 +292,7 @@ string IRGenerator::generate(
 	InternalDispatchMap internalDispatchMap = generateInternalDispatchFunctions(_contract);
 
 	t("functions", m_context.functionCollector().requestedFunctions());
+	t("dataSections", m_context.functionCollector().requestedDataSections());
 	t("subObjects", subObjectSources(m_context.subObjectsCreated()));
 
 	// This has to be called only after all other code generation for the creation object is complete.
@@ -225,6 +315,7 @@ string IRGenerator::generate(
 	set<FunctionDefinition const*> deployedFunctionList = generateQueuedFunctions();
 	generateInternalDispatchFunctions(_contract);
 	t("deployedFunctions", m_context.functionCollector().requestedFunctions());
+	t("deployedDataSections", m_context.functionCollector().requestedDataSections());
 	t("deployedSubObjects", subObjectSources(m_context.subObjectsCreated()));
 	t("metadataName", yul::Object::metadataName());
 	t("cborMetadata", util::toHex(_cborMetadata));
@@ -278,7 +369,7 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 	for (YulArity const& arity: internalDispatchMap | ranges::views::keys)
 	{
 		string funName = IRNames::internalDispatch(arity);
-		m_context.functionCollector().createFunction(funName, [&]() {
+		m_context.functionCollector().createContractSpecificFunction(funName, [&]() {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>(fun<?+in>, <in></+in>) <?+out>-> <out></+out> {
@@ -335,7 +426,7 @@ InternalDispatchMap IRGenerator::generateInternalDispatchFunctions(ContractDefin
 string IRGenerator::generateFunction(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::function(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractSpecificFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -406,7 +497,7 @@ string IRGenerator::generateModifier(
 )
 {
 	string functionName = IRNames::modifierInvocation(_modifierInvocation);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractSpecificFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<astIDComment><sourceLocationComment>
@@ -498,7 +589,7 @@ string IRGenerator::generateModifier(
 string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const& _function)
 {
 	string functionName = IRNames::functionWithModifierInner(_function);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractSpecificFunction(functionName, [&]() {
 		m_context.resetLocalVariables();
 		Whiskers t(R"(
 			<sourceLocationComment>
@@ -538,7 +629,7 @@ string IRGenerator::generateFunctionWithModifierInner(FunctionDefinition const&
 string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 {
 	string functionName = IRNames::function(_varDecl);
-	return m_context.functionCollector().createFunction(functionName, [&]() {
+	return m_context.functionCollector().createContractSpecificFunction(functionName, [&]() {
 		Type const* type = _varDecl.annotation().type;
 
 		solAssert(_varDecl.isStateVariable(), "");
@@ -728,10 +819,14 @@ string IRGenerator::generateGetter(VariableDeclaration const& _varDecl)
 	});
 }
 
-string IRGenerator::generateExternalFunction(ContractDefinition const& _contract, FunctionType const& _functionType)
+string IRGenerator::generateExternalFunction(
+	ContractDefinition const& _contract,
+	FunctionType const& _functionType,
+	bool _frequentlyCalled
+)
 {
 	string functionName = IRNames::externalFunctionABIWrapper(_functionType.declaration());
-	return m_context.functionCollector().createFunction(functionName, [&](vector<string>&, vector<string>&) -> string {
+	return m_context.functionCollector().createContractSpecificFunction(functionName, [&](vector<string>&, vector<string>&) -> string {
 		Whiskers t(R"X(
 			<callValueCheck>
 			<?+params>let <params> := </+params> <abiDecode>(4, calldatasize())
@@ -746,7 +841,7 @@ string IRGenerator::generateExternalFunction(ContractDefinition const& _contract
 		unsigned retVars = make_shared<TupleType>(_functionType.returnParameterTypes())->sizeOnStack();
 
 		ABIFunctions abiFunctions(m_evmVersion, m_context.revertStrings(), m_context.functionCollector());
-		t("abiDecode", abiFunctions.tupleDecoder(_functionType.parameterTypes()));
+		t("abiDecode", abiFunctions.tupleDecoder(_functionType.parameterTypes(), false, _frequentlyCalled));
 		t("params",  suffixedVariableNameList("param_", 0, paramVars));
 		t("retParams",  suffixedVariableNameList("ret_", 0, retVars));
 
@@ -761,7 +856,13 @@ string IRGenerator::generateExternalFunction(ContractDefinition const& _contract
 			solAssert(false, "Unexpected declaration for function!");
 
 		t("allocateUnbounded", m_utils.allocateUnboundedFunction());
-		t("abiEncode", abiFunctions.tupleEncoder(_functionType.returnParameterTypes(), _functionType.returnParameterTypes(), _contract.isLibrary()));
+		t("abiEncode", abiFunctions.tupleEncoder(
+			_functionType.returnParameterTypes(),
+			_functionType.returnParameterTypes(),
+			_contract.isLibrary(),
+			false,
+			_frequentlyCalled
+		));
 		return t.render();
 	});
 }
@@ -866,7 +967,7 @@ void IRGenerator::generateConstructors(ContractDefinition const& _contract)
 		baseConstructorParams.erase(contract);
 
 		m_context.resetLocalVariables();
-		m_context.functionCollector().createFunction(IRNames::constructor(*contract), [&]() {
+		m_context.functionCollector().createContractSpecificFunction(IRNames::constructor(*contract), [&]() {
 			Whiskers t(R"(
 				<astIDComment><sourceLocationComment>
 				function <functionName>(<params><comma><baseParams>) {
@@ -998,32 +1099,30 @@ string IRGenerator::callValueCheck()
 string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 {
 	Whiskers t(R"X(
-		<?+cases>if iszero(lt(calldatasize(), 4))
+		<?+selectorSwitch>if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
-			<#cases>
-			case <functionSelector>
-			{
-				// <functionName>
-				<delegatecallCheck>
-				<externalFunction>()
-			}
-			</cases>
-			default {}
-		}</+cases>
+			<selectorSwitch>
+		}</+selectorSwitch>
 		<?+receiveEther>if iszero(calldatasize()) { <receiveEther> }</+receiveEther>
 		<fallback>
 	)X");
 	t("shr224", m_utils.shiftRightFunction(224));
-	vector<map<string, string>> functions;
+	vector<FixedHash<4>> selectors;
+	map<FixedHash<4>, string> cases;
 	for (auto const& function: _contract.interfaceFunctions())
 	{
-		functions.emplace_back();
-		map<string, string>& templ = functions.back();
-		templ["functionSelector"] = "0x" + function.first.hex();
+		Whiskers templ(R"X(
+			case <functionSelector>
+			{
+				// <functionName>
+				<delegatecallCheck>
+				<externalFunction>()
+			}
+		)X");
+		templ("functionSelector", "0x" + function.first.hex());
 		FunctionTypePointer const& type = function.second;
-		templ["functionName"] = type->externalSignature();
+		templ("functionName", type->externalSignature());
 		string delegatecallCheck;
 		if (_contract.isLibrary())
 		{
@@ -1036,11 +1135,21 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 					m_utils.revertReasonIfDebugFunction("Non-view function of library called without DELEGATECALL") +
 					"() }";
 		}
-		templ["delegatecallCheck"] = delegatecallCheck;
-
-		templ["externalFunction"] = generateExternalFunction(_contract, *type);
+		templ("delegatecallCheck", delegatecallCheck);
+
+		templ("externalFunction", generateExternalFunction(
+			_contract,
+			*type,
+			util::valueOrDefault(m_optimiserSettings.callProfile, function.first, size_t(0)) > 0
+		));
+		selectors.emplace_back(function.first);
+		cases.emplace(function.first, templ.render());
 	}
-	t("cases", functions);
+	t("selectorSwitch", cases.empty() ? "" : selectorSwitch(cases, DispatchTree::build(
+		selectors,
+		m_optimiserSettings.expectedExecutionsPerDeployment,
+		m_optimiserSettings.callProfile
+	)));
 	FunctionDefinition const* etherReceiver = _contract.receiveFunction();
 	if (etherReceiver)
 	{
@@ -1104,6 +1213,10 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 		m_context.functionCollector().requestedFunctions().empty(),
 		"Reset context while it still had functions."
 	);
+	solAssert(
+		m_context.functionCollector().requestedDataSections().empty(),
+		"Reset context while it still had data sections."
+	);
 	solAssert(
 		m_context.internalDispatchClean(),
 		"Reset internal dispatch map without consuming it."
@@ -1119,6 +1232,8 @@ void IRGenerator::resetContext(ContractDefinition const& _contract, ExecutionCon
 	);
 	newContext.copyFunctionIDsFrom(m_context);
 	m_context = std::move(newContext);
+	m_context.functionCollector().setCache(m_functionCache);
+	m_context.functionCollector().enableDataSections();
 
 	m_context.setMostDerivedContract(_contract);
 	for (auto const& var: ContractType(_contract).stateVariables())
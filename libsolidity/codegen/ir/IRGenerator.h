@@ -32,11 +32,21 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/PhaseStatistics.h>
+
 #include <string>
+#include <vector>
+
+namespace solidity::yul
+{
+struct OptimiserProfile;
+}
 
 namespace solidity::frontend
 {
 
+class CompilationCache;
 class SourceUnit;
 
 class IRGenerator
@@ -70,13 +80,30 @@ public:
 
 	/// Generates and returns the IR code, in unoptimized and optimized form
 	/// (or just pretty-printed, depending on the optimizer settings).
+	/// @param _cache if not null, the optimized form is looked up in and stored to this cache.
+	/// @param _optimiserProfiles if not null, execution statistics of the optimizer are appended to it.
+	/// @param _functionCache if not null, generated utility functions are looked up in and stored to
+	/// this cache, which can be shared between all contracts compiled with the same settings.
+	/// @param _phaseStatistics if not null, the wall time and memory usage of the IR generation and
+	/// of the Yul optimizer are appended to it.
 	std::pair<std::string, std::string> run(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
-		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
+		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources,
+		CompilationCache* _cache = nullptr,
+		std::vector<yul::OptimiserProfile>* _optimiserProfiles = nullptr,
+		MultiUseYulFunctionCache* _functionCache = nullptr,
+		std::vector<util::PhaseStatistics>* _phaseStatistics = nullptr
 	);
 
+	/// @returns true if the Yul optimizer skipped steps during @a run because its time budget ran out.
+	bool optimiserTimeBudgetExhausted() const { return m_optimiserTimeBudgetExhausted; }
+
 private:
+	/// @returns the key under which the optimized form of @a _ir is stored in a compilation cache.
+	/// It covers the compiler version and all settings that influence the optimizer and the printer.
+	util::h256 optimizedIRCacheKey(std::string const& _ir) const;
+
 	std::string generate(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
@@ -105,7 +132,13 @@ private:
 	std::string generateGetter(VariableDeclaration const& _varDecl);
 
 	/// Generates the external part (ABI decoding and encoding) of a function or getter.
-	std::string generateExternalFunction(ContractDefinition const& _contract, FunctionType const& _functionType);
+	/// @param _frequentlyCalled if true, the parameters are decoded and the return values are
+	/// encoded by functions that are cheaper to call but share less code with other ones.
+	std::string generateExternalFunction(
+		ContractDefinition const& _contract,
+		FunctionType const& _functionType,
+		bool _frequentlyCalled
+	);
 
 	/// Generates code that assigns the initial value of the respective type.
 	std::string generateInitialAssignment(VariableDeclaration const& _varDecl);
@@ -145,6 +178,8 @@ private:
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
+	MultiUseYulFunctionCache* m_functionCache = nullptr;
+	bool m_optimiserTimeBudgetExhausted = false;
 };
 
 }
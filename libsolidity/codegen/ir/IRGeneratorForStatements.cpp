@@ -343,7 +343,7 @@ string IRGeneratorForStatements::constantValueFunction(VariableDeclaration const
 	try
 	{
 		string functionName = IRNames::constantValueFunction(_constant);
-		return m_context.functionCollector().createFunction(functionName, [&] {
+		return m_context.functionCollector().createContractSpecificFunction(functionName, [&] {
 			Whiskers templ(R"(
 				<sourceLocationComment>
 				function <functionName>() -> <ret> {
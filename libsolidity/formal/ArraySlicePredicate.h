@@ -56,7 +56,8 @@ struct ArraySlicePredicate
 
 private:
 	/// Maps a unique sort name to its slice data.
-	static std::map<std::string, SliceData> m_slicePredicates;
+	/// Per thread, so that independent compilations can run in different threads.
+	static thread_local std::map<std::string, SliceData> m_slicePredicates;
 };
 
 }
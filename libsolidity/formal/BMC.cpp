@@ -21,11 +21,19 @@
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/formal/SymbolicTypes.h>
 
+#include <libsolidity/ast/CallGraph.h>
+#include <libsolidity/interface/Version.h>
+
 #include <libsmtutil/SMTPortfolio.h>
 
 #include <liblangutil/CharStream.h>
 #include <liblangutil/CharStreamProvider.h>
 
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TraceEvents.h>
+
+#include <range/v3/view/reverse.hpp>
+
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
 #endif
@@ -36,16 +44,94 @@ using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Collects the functions, modifiers, events and errors referenced in the visited code.
+class CallableReferenceCollector: private ASTConstVisitor
+{
+public:
+	static vector<CallableDeclaration const*> collect(CallableDeclaration const& _callable)
+	{
+		CallableReferenceCollector collector;
+		_callable.accept(collector);
+		return std::move(collector.m_references);
+	}
+
+private:
+	bool visit(Identifier const& _identifier) override
+	{
+		add(_identifier.annotation().referencedDeclaration);
+		return true;
+	}
+	bool visit(IdentifierPath const& _identifierPath) override
+	{
+		add(_identifierPath.annotation().referencedDeclaration);
+		return true;
+	}
+	bool visit(MemberAccess const& _memberAccess) override
+	{
+		add(_memberAccess.annotation().referencedDeclaration);
+		return true;
+	}
+
+	void add(Declaration const* _declaration)
+	{
+		if (auto callable = dynamic_cast<CallableDeclaration const*>(_declaration))
+			m_references.push_back(callable);
+	}
+
+	vector<CallableDeclaration const*> m_references;
+};
+
+/// @returns true if @a _a and @a _b are structurally equal. Gives up and returns false if
+/// this cannot be decided by looking at less than @a _maxNodes subexpressions that are not shared.
+bool sameExpression(smtutil::Expression const& _a, smtutil::Expression const& _b, size_t& _maxNodes)
+{
+	if (_a.name != _b.name || _a.arguments.size() != _b.arguments.size())
+		return false;
+	if (_a.sort != _b.sort && (!_a.sort || !_b.sort || _a.sort->kind != _b.sort->kind))
+		return false;
+	if (_a.arguments.id() == _b.arguments.id())
+		return true;
+	if (_maxNodes == 0)
+		return false;
+	--_maxNodes;
+	for (size_t i = 0; i < _a.arguments.size(); ++i)
+		if (!sameExpression(_a.arguments[i], _b.arguments[i], _maxNodes))
+			return false;
+	return true;
+}
+
+bool sameExpression(smtutil::Expression const& _a, smtutil::Expression const& _b)
+{
+	size_t maxNodes = 1000;
+	return sameExpression(_a, _b, maxNodes);
+}
+
+}
+
 BMC::BMC(
 	smt::EncodingContext& _context,
 	UniqueErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	CompilationCache* _cache,
+	ModelCheckerBudget* _budget
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _settings.solvers, _settings.timeout))
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_settings.solvers,
+		_budget ? _budget->solverTimeout() : _settings.timeout,
+		_settings.raceSolvers,
+		_cache
+	)),
+	m_budget(_budget),
+	m_cache(_cache)
 {
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (m_settings.solvers.cvc4 || m_settings.solvers.z3)
@@ -81,7 +167,8 @@ void BMC::analyze(SourceUnit const& _source, map<ASTNode const*, set<Verificatio
 	m_context.reset();
 	m_context.setAssertionAccumulation(true);
 	m_variableUsage.setFunctionInlining(shouldInlineFunctionCall);
-	createFreeConstants(sourceDependencies(_source));
+	m_sourceDependencies = sourceDependencies(_source);
+	createFreeConstants(m_sourceDependencies);
 	state().prepareForSourceUnit(_source, false);
 	m_unprovedAmt = 0;
 
@@ -141,6 +228,7 @@ bool BMC::shouldInlineFunctionCall(
 
 bool BMC::visit(ContractDefinition const& _contract)
 {
+	m_contractProfileStart = {chrono::steady_clock::now(), m_profiles[&_contract].solverTime};
 	initContract(_contract);
 
 	SMTEncoder::visit(_contract);
@@ -163,6 +251,11 @@ void BMC::endVisit(ContractDefinition const& _contract)
 		m_verificationTargets.clear();
 	}
 
+	auto& profile = m_profiles[&_contract];
+	auto [start, solverTimeAtStart] = m_contractProfileStart;
+	auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+	profile.encodingTime += duration - (profile.solverTime - solverTimeAtStart);
+
 	SMTEncoder::endVisit(_contract);
 }
 
@@ -179,6 +272,20 @@ bool BMC::visit(FunctionDefinition const& _function)
 
 	if (m_callStack.empty())
 	{
+		if (m_cache && (m_rootFunctionCacheKey = rootFunctionCacheKey(_function)))
+		{
+			if (m_cache->load(*m_rootFunctionCacheKey))
+			{
+				m_skippedRootFunction = &_function;
+				return false;
+			}
+			m_reportsBeforeRootFunction = {
+				m_errorReporter.reportCount(),
+				m_unprovedAmt,
+				m_interface->unhandledQueries().size(),
+				m_budget ? m_budget->skippedQueries() : 0u
+			};
+		}
 		reset();
 		initFunction(_function);
 		if (_function.isConstructor() || _function.isPublic())
@@ -204,11 +311,31 @@ void BMC::endVisit(FunctionDefinition const& _function)
 	if (!m_currentContract)
 		return;
 
+	if (m_skippedRootFunction == &_function)
+	{
+		m_skippedRootFunction = nullptr;
+		return;
+	}
+
 	if (isRootFunction())
 	{
 		checkVerificationTargets();
 		m_verificationTargets.clear();
 		m_pathConditions.clear();
+
+		// Only record functions that did not lead to any report, so that skipping them later
+		// does not change the output.
+		if (m_rootFunctionCacheKey)
+		{
+			if (m_reportsBeforeRootFunction == make_tuple(
+				m_errorReporter.reportCount(),
+				m_unprovedAmt,
+				m_interface->unhandledQueries().size(),
+				m_budget ? m_budget->skippedQueries() : 0u
+			))
+				m_cache->store(*m_rootFunctionCacheKey, "safe");
+			m_rootFunctionCacheKey.reset();
+		}
 	}
 
 	SMTEncoder::endVisit(_function);
@@ -696,8 +823,83 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
+	if (m_budget && m_budget->enabled())
+		checkVerificationTargetsWithinBudget();
+	else
+	{
+		vector<BMCVerificationTarget*> targets;
+		for (auto& target: m_verificationTargets)
+			targets.push_back(&target);
+		checkVerificationTargets(targets, [&](BMCVerificationTarget& _target) { checkVerificationTarget(_target); });
+	}
+}
+
+void BMC::checkVerificationTargets(
+	vector<BMCVerificationTarget*> const& _targets,
+	function<void(BMCVerificationTarget&)> const& _check
+)
+{
+	solAssert(!m_constraintsAsserted);
+	bool sharesNext = false;
+	for (size_t i = 0; i < _targets.size(); ++i)
+	{
+		BMCVerificationTarget& target = *_targets[i];
+		bool sharesPrevious = sharesNext;
+		sharesNext = i + 1 < _targets.size() && sameExpression(target.constraints, _targets[i + 1]->constraints);
+		// Targets at the same program point, such as underflow and overflow of the same
+		// operation, have the same constraints. They are asserted once for all of them and
+		// every condition is checked in its own scope on top of them.
+		if (!sharesPrevious && (sharesNext || target.type == VerificationTargetType::UnderOverflow))
+		{
+			m_interface->push();
+			m_interface->addAssertion(target.constraints);
+			m_constraintsAsserted = true;
+		}
+		_check(target);
+		if (m_constraintsAsserted && !sharesNext)
+		{
+			m_interface->pop();
+			m_constraintsAsserted = false;
+		}
+	}
+}
+
+void BMC::checkVerificationTargetsWithinBudget()
+{
+	// Targets with their held back reports, or nullopt if they were not checked yet.
+	vector<pair<BMCVerificationTarget*, optional<vector<function<void()>>>>> unresolved;
 	for (auto& target: m_verificationTargets)
-		checkVerificationTarget(target);
+		unresolved.emplace_back(&target, nullopt);
+
+	for (m_budgetRound = 0; !unresolved.empty() && m_budget->timeout(m_budgetRound); ++m_budgetRound)
+	{
+		vector<BMCVerificationTarget*> targets;
+		for (auto const& item: unresolved)
+			targets.push_back(item.first);
+		vector<pair<BMCVerificationTarget*, optional<vector<function<void()>>>>> stillUnresolved;
+		checkVerificationTargets(targets, [&](BMCVerificationTarget& _target) {
+			m_targetUnresolved = false;
+			m_deferredReports.emplace();
+			checkVerificationTarget(_target);
+			if (m_targetUnresolved)
+				stillUnresolved.emplace_back(&_target, std::move(m_deferredReports));
+		});
+		unresolved = std::move(stillUnresolved);
+	}
+	m_deferredReports.reset();
+	m_budgetRound = 0;
+
+	// The budget is used up or the timeouts cannot grow any further.
+	// Targets that were never checked are checked now, which reports all their queries as unknown
+	// if the budget is used up.
+	vector<BMCVerificationTarget*> unchecked;
+	for (auto& [target, reports]: unresolved)
+		if (reports)
+			for (auto const& report: *reports)
+				report();
+		else
+			unchecked.push_back(target);
+	checkVerificationTargets(unchecked, [&](BMCVerificationTarget& _target) { checkVerificationTarget(_target); });
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -762,7 +964,8 @@ void BMC::checkUnderflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
-		_target.constraints && _target.value < smt::minValue(*intType),
+		_target.constraints,
+		_target.value < smt::minValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -795,7 +998,8 @@ void BMC::checkOverflow(BMCVerificationTarget& _target)
 		intType = TypeProvider::uint256();
 
 	checkCondition(
-		_target.constraints && _target.value > smt::maxValue(*intType),
+		_target.constraints,
+		_target.value > smt::maxValue(*intType),
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -818,7 +1022,8 @@ void BMC::checkDivByZero(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
-		_target.constraints && (_target.value == 0),
+		_target.constraints,
+		(_target.value == 0),
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -834,7 +1039,8 @@ void BMC::checkBalance(BMCVerificationTarget& _target)
 {
 	solAssert(_target.type == VerificationTargetType::Balance, "");
 	checkCondition(
-		_target.constraints && _target.value,
+		_target.constraints,
+		_target.value,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -856,7 +1062,8 @@ void BMC::checkAssert(BMCVerificationTarget& _target)
 		return;
 
 	checkCondition(
-		_target.constraints && !_target.value,
+		_target.constraints,
+		!_target.value,
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
@@ -894,6 +1101,7 @@ void BMC::addVerificationTarget(
 /// Solving.
 
 void BMC::checkCondition(
+	smtutil::Expression const& _constraints,
 	smtutil::Expression _condition,
 	vector<SMTEncoder::CallStackEntry> const& _callStack,
 	pair<vector<smtutil::Expression>, vector<string>> const& _modelExpressions,
@@ -906,12 +1114,16 @@ void BMC::checkCondition(
 )
 {
 	m_interface->push();
-	m_interface->addAssertion(_condition);
+	if (m_constraintsAsserted)
+		m_interface->addAssertion(_condition);
+	else
+		m_interface->addAssertion(_constraints && _condition);
 
 	vector<smtutil::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
-	if (_callStack.size())
+	if (!m_settings.verdictsOnly)
+		tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
+	if (_callStack.size() && !m_settings.verdictsOnly)
 		if (_additionalValue)
 		{
 			expressionsToEvaluate.emplace_back(*_additionalValue);
@@ -946,7 +1158,7 @@ void BMC::checkCondition(
 
 		std::ostringstream modelMessage;
 		// Sometimes models have complex smtlib2 expressions that SMTLib2Interface fails to parse.
-		if (values.size() == expressionNames.size())
+		if (!m_settings.verdictsOnly && values.size() == expressionNames.size())
 		{
 			modelMessage << "Counterexample:\n";
 			map<string, string> sortedModel;
@@ -972,9 +1184,16 @@ void BMC::checkCondition(
 		break;
 	case smtutil::CheckResult::UNKNOWN:
 	{
-		++m_unprovedAmt;
-		if (m_settings.showUnproved)
-			m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+		m_targetUnresolved = true;
+		auto report = [this, _errorMightHappen, _location, _description, secondaryLocation]() {
+			++m_unprovedAmt;
+			if (m_settings.showUnproved)
+				m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+		};
+		if (m_deferredReports)
+			m_deferredReports->emplace_back(std::move(report));
+		else
+			report();
 		break;
 	}
 	case smtutil::CheckResult::CONFLICTING:
@@ -999,16 +1218,22 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
+	// Both checks share the constraints, which are therefore asserted only once.
 	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
+	m_interface->addAssertion(_constraints);
+
+	m_interface->push();
+	m_interface->addAssertion(_value);
 	auto positiveResult = checkSatisfiable();
 	m_interface->pop();
 
 	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
+	m_interface->addAssertion(!_value);
 	auto negatedResult = checkSatisfiable();
 	m_interface->pop();
 
+	m_interface->pop();
+
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
 		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
 	else if (positiveResult == smtutil::CheckResult::CONFLICTING || negatedResult == smtutil::CheckResult::CONFLICTING)
@@ -1020,6 +1245,7 @@ void BMC::checkBooleanNotConstant(
 	else if (positiveResult == smtutil::CheckResult::UNKNOWN || negatedResult == smtutil::CheckResult::UNKNOWN)
 	{
 		// can't do anything.
+		m_targetUnresolved = true;
 	}
 	else if (positiveResult == smtutil::CheckResult::UNSATISFIABLE && negatedResult == smtutil::CheckResult::UNSATISFIABLE)
 		m_errorReporter.warning(2512_error, _condition.location(), "BMC: Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
@@ -1051,6 +1277,22 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 {
 	smtutil::CheckResult result;
 	vector<string> values;
+	if (m_budget && m_budget->enabled())
+	{
+		optional<unsigned> timeout = m_budget->timeout(m_budgetRound);
+		if (!timeout)
+		{
+			m_budget->skipQuery();
+			return {smtutil::CheckResult::UNKNOWN, {}};
+		}
+		m_interface->setTimeout(*timeout);
+	}
+	util::TraceSpan span(
+		"bmcQuery",
+		"modelChecker",
+		{{"contract", m_currentContract ? m_currentContract->fullyQualifiedName() : ""}}
+	);
+	auto start = chrono::steady_clock::now();
 	try
 	{
 		tie(result, values) = m_interface->check(_expressionsToEvaluate);
@@ -1063,6 +1305,11 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 		m_errorReporter.warning(8140_error, description);
 		result = smtutil::CheckResult::ERROR;
 	}
+	span.stop();
+	if (m_currentContract)
+		m_profiles[m_currentContract].addQuery(
+			chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start)
+		);
 
 	for (string& value: values)
 	{
@@ -1082,6 +1329,125 @@ smtutil::CheckResult BMC::checkSatisfiable()
 	return checkSatisfiableAndGenerateModel({}).first;
 }
 
+optional<h256> BMC::rootFunctionCacheKey(FunctionDefinition const& _function) const
+{
+	solAssert(m_currentContract);
+	auto const& callGraph = _function.isConstructor() ?
+		m_currentContract->annotation().creationCallGraph :
+		m_currentContract->annotation().deployedCallGraph;
+	if (!callGraph.set())
+		return nullopt;
+
+	auto text = [&](ASTNode const& _node) -> optional<string> {
+		SourceLocation const& location = _node.location();
+		if (!location.hasText())
+			return nullopt;
+		string const& source = m_charStreamProvider.charStream(*location.sourceName).source();
+		if (static_cast<size_t>(location.end) > source.size())
+			return nullopt;
+		return source.substr(static_cast<size_t>(location.start), static_cast<size_t>(location.end - location.start));
+	};
+
+	// The call graph does not contain external calls to `this`, which are inlined, so the
+	// references in the code of the reachable callables are followed as well. Since they are
+	// not resolved against the current contract, all callables of the same name are included.
+	auto const& hierarchy = m_currentContract->annotation().linearizedBaseContracts;
+	set<CallGraph::Node, CallGraph::CompareByID> visited;
+	vector<CallGraph::Node> toVisit{&_function};
+	if (_function.isConstructor())
+		// Base constructors and state variable initializers are inlined into the constructor.
+		toVisit.emplace_back(CallGraph::SpecialNode::Entry);
+	while (!toVisit.empty())
+	{
+		CallGraph::Node node = toVisit.back();
+		toVisit.pop_back();
+		if (!visited.insert(node).second)
+			continue;
+
+		if (auto const* callable = get_if<CallableDeclaration const*>(&node))
+			for (CallableDeclaration const* reference: CallableReferenceCollector::collect(**callable))
+			{
+				toVisit.emplace_back(reference);
+				for (ContractDefinition const* base: hierarchy)
+				{
+					for (FunctionDefinition const* function: base->definedFunctions(reference->name()))
+						toVisit.emplace_back(function);
+					for (ModifierDefinition const* modifier: base->functionModifiers())
+						if (modifier->name() == reference->name())
+							toVisit.emplace_back(modifier);
+				}
+			}
+		if (auto it = (*callGraph)->edges.find(node); it != (*callGraph)->edges.end())
+			toVisit += it->second;
+	}
+
+	vector<string> callables;
+	for (CallGraph::Node const& node: visited)
+		if (auto const* callable = get_if<CallableDeclaration const*>(&node))
+		{
+			optional<string> callableText = text(**callable);
+			if (!callableText)
+				return nullopt;
+			auto const* scope = dynamic_cast<ContractDefinition const*>((*callable)->scope());
+			string entry = (scope ? scope->fullyQualifiedName() : (*callable)->sourceUnitName()) + "\n" + *callableText + "\n";
+			SourceLocation const& location = (*callable)->location();
+			for (auto const& [target, types]: m_solvedTargets)
+				if (location.contains(target->location()))
+				{
+					entry += to_string(target->location().start - location.start) + "-" + to_string(target->location().end - location.start) + ":";
+					for (VerificationTargetType type: types)
+						entry += to_string(static_cast<int>(type)) + ",";
+					entry += "\n";
+				}
+			callables.emplace_back(std::move(entry));
+		}
+	sort(callables.begin(), callables.end());
+
+	// The functions and modifiers that are reachable are already covered without their
+	// position, so that moving code around does not change the key.
+	map<string, string> sources;
+	for (SourceUnit const* source: m_sourceDependencies)
+	{
+		optional<string> sourceText = text(*source);
+		if (!sourceText)
+			return nullopt;
+		vector<SourceLocation> callableLocations;
+		for (auto const& node: source->nodes())
+			if (dynamic_cast<FunctionDefinition const*>(node.get()))
+				callableLocations.emplace_back(node->location());
+			else if (auto const* contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				for (auto const& subNode: contract->subNodes())
+					if (dynamic_cast<CallableDeclaration const*>(subNode.get()))
+						callableLocations.emplace_back(subNode->location());
+		// Remove them back to front, so that the offsets of the remaining ones stay valid.
+		sort(callableLocations.begin(), callableLocations.end());
+		for (SourceLocation const& location: callableLocations | ranges::views::reverse)
+			if (location.hasText() && source->location().contains(location))
+				sourceText->erase(
+					static_cast<size_t>(location.start - source->location().start),
+					static_cast<size_t>(location.end - location.start)
+				);
+		sources[*source->location().sourceName] = std::move(*sourceText);
+	}
+
+	string key = "bmc-function\n" + VersionString + "\n";
+	for (auto const& [source, contracts]: m_settings.contracts.contracts)
+		key += source + ":" + joinHumanReadable(contracts) + ";";
+	key +=
+		"\n" + to_string(m_settings.divModNoSlacks) +
+		to_string(m_settings.engine.bmc) +
+		to_string(m_settings.engine.chc) +
+		to_string(m_settings.externalCalls.isTrusted()) + "\n";
+	for (VerificationTargetType type: m_settings.targets.targets)
+		key += to_string(static_cast<int>(type)) + ",";
+	key += "\n" + m_currentContract->fullyQualifiedName() + "\n" + *text(_function) + "\n";
+	for (string const& callable: callables)
+		key += "callable " + callable;
+	for (auto const& [name, sourceText]: sources)
+		key += "source " + name + "\n" + sourceText + "\n";
+	return keccak256(key);
+}
+
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
 {
 	auto oldVar = _symVar.currentValue();
@@ -30,16 +30,24 @@
 
 
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/ModelCheckerBudget.h>
+#include <libsolidity/formal/ModelCheckerProfile.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/UniqueErrorReporter.h>
 
+#include <chrono>
+#include <functional>
+#include <map>
+#include <optional>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 using solidity::util::h256;
@@ -63,7 +71,9 @@ public:
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		CompilationCache* _cache = nullptr,
+		ModelCheckerBudget* _budget = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources, std::map<ASTNode const*, std::set<VerificationTargetType>, smt::EncodingContext::IdCompare> _solvedTargets);
@@ -73,6 +83,9 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
 
+	/// @returns where the analysis of each contract spent its time.
+	std::map<ContractDefinition const*, ModelCheckerEngineProfile> const& profiles() const { return m_profiles; }
+
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
 	/// @param _contextContract The most derived contract, currently being analyzed.
@@ -138,6 +151,14 @@ private:
 	};
 
 	void checkVerificationTargets();
+	/// Calls @a _check for each target in @a _targets. Consecutive targets with the same
+	/// constraints share one solver scope in which the constraints are asserted only once.
+	void checkVerificationTargets(
+		std::vector<BMCVerificationTarget*> const& _targets,
+		std::function<void(BMCVerificationTarget&)> const& _check
+	);
+	/// Checks the targets in rounds of increasing timeouts as long as the budget lasts.
+	void checkVerificationTargetsWithinBudget();
 	void checkVerificationTarget(BMCVerificationTarget& _target);
 	void checkConstantCondition(BMCVerificationTarget& _target);
 	void checkUnderflow(BMCVerificationTarget& _target);
@@ -154,8 +175,10 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Check that a condition can be satisfied under the constraints @a _constraints,
+	/// which are not asserted again if they are asserted for the current group of targets already.
 	void checkCondition(
+		smtutil::Expression const& _constraints,
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> const& _modelExpressions,
@@ -180,6 +203,18 @@ private:
 	smtutil::CheckResult checkSatisfiable();
 	//@}
 
+	/// Incremental analysis.
+	//@{
+	/// @returns the key under which it is recorded that all verification targets of the root
+	/// function @a _function were proved safe, or nullopt if the sources are not available.
+	/// Besides the settings and the function itself, the key covers everything the function can call
+	/// according to the call graph of the current contract, the targets in there that were already
+	/// proved, and the text of all sources the current source depends on with all other functions and
+	/// modifiers removed. Changes to functions that cannot be reached from @a _function therefore
+	/// do not change the key.
+	std::optional<util::h256> rootFunctionCacheKey(FunctionDefinition const& _function) const;
+	//@}
+
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
 
 	/// Flags used for better warning messages.
@@ -193,6 +228,33 @@ private:
 
 	/// Number of verification conditions that could not be proved.
 	size_t m_unprovedAmt = 0;
+
+	/// Time budget shared with the other engines, or nullptr.
+	ModelCheckerBudget* m_budget = nullptr;
+	/// Round of the budget the current queries belong to.
+	unsigned m_budgetRound = 0;
+	/// Whether the constraints of the targets being checked are asserted on the solver already.
+	bool m_constraintsAsserted = false;
+	/// Whether a query of the target being checked had an unknown result.
+	bool m_targetUnresolved = false;
+	/// If set, unknown results are not reported right away but collected here, because
+	/// the target will be checked again with a longer timeout.
+	std::optional<std::vector<std::function<void()>>> m_deferredReports;
+
+	/// Cache for solver answers and for root functions that were proved safe, or nullptr.
+	CompilationCache* m_cache = nullptr;
+	/// The sources the current source depends on, including itself.
+	std::set<SourceUnit const*, ASTNode::CompareByID> m_sourceDependencies;
+	/// Cache key of the root function being analyzed, if its outcome is recorded.
+	std::optional<util::h256> m_rootFunctionCacheKey;
+	/// Number of reports and of unproved, unhandled and skipped queries when the analysis of the root function started.
+	std::tuple<size_t, size_t, size_t, size_t> m_reportsBeforeRootFunction;
+	/// Root function that is not analyzed, because it was proved safe before.
+	FunctionDefinition const* m_skippedRootFunction = nullptr;
+
+	std::map<ContractDefinition const*, ModelCheckerEngineProfile> m_profiles;
+	/// Start of the analysis of the current contract and the solver time of the contract at that point.
+	std::pair<std::chrono::steady_clock::time_point, std::chrono::microseconds> m_contractProfileStart;
 };
 
 }
@@ -36,6 +36,8 @@
 #include <liblangutil/CharStreamProvider.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
+#include <libsolutil/TraceEvents.h>
 
 #ifdef HAVE_Z3_DLOPEN
 #include <z3_version.h>
@@ -43,12 +45,14 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/algorithm/for_each.hpp>
 #include <range/v3/view.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 
 #include <charconv>
+#include <mutex>
 #include <queue>
 
 using namespace std;
@@ -65,11 +69,15 @@ CHC::CHC(
 	map<util::h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
 	ModelCheckerSettings _settings,
-	CharStreamProvider const& _charStreamProvider
+	CharStreamProvider const& _charStreamProvider,
+	CompilationCache* _queryCache,
+	ModelCheckerBudget* _budget
 ):
 	SMTEncoder(_context, _settings, _errorReporter, _charStreamProvider),
 	m_smtlib2Responses(_smtlib2Responses),
-	m_smtCallback(_smtCallback)
+	m_smtCallback(_smtCallback),
+	m_queryCache(_queryCache),
+	m_budget(_budget)
 {
 }
 
@@ -141,6 +149,7 @@ bool CHC::visit(ContractDefinition const& _contract)
 	if (!shouldAnalyze(_contract))
 		return false;
 
+	m_contractProfileStart = chrono::steady_clock::now();
 	resetContractAnalysis();
 	initContract(_contract);
 	clearIndices(&_contract);
@@ -256,6 +265,9 @@ void CHC::endVisit(ContractDefinition const& _contract)
 	solAssert(m_scopes.back() == &_contract, "");
 	m_scopes.pop_back();
 
+	m_profiles[&_contract].encodingTime +=
+		chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_contractProfileStart);
+
 	SMTEncoder::endVisit(_contract);
 }
 
@@ -290,6 +302,18 @@ bool CHC::visit(FunctionDefinition const& _function)
 
 	initFunction(_function);
 
+	// Functions inherited from a base contract are often encoded exactly as for another
+	// contract already. Their summary is then defined by that one, instead of encoding the body again.
+	if (auto const* encodingContract = reusableSummaryContext(_function))
+	{
+		// Balances the stack of SMTEncoder::endVisit(FunctionDefinition).
+		m_modifierDepthStack.push_back(-1);
+		reuseSummary(_function, *encodingContract);
+		m_reusingSummary = true;
+		return false;
+	}
+	m_encodedSummaries[&_function].push_back(m_currentContract);
+
 	auto functionEntryBlock = createBlock(m_currentFunction, PredicateType::FunctionBlock);
 	auto bodyBlock = createBlock(&m_currentFunction->body(), PredicateType::FunctionBlock);
 
@@ -332,7 +356,10 @@ void CHC::endVisit(FunctionDefinition const& _function)
 	solAssert(m_scopes.back() == &_function, "");
 	m_scopes.pop_back();
 
-	connectBlocks(m_currentBlock, summary(_function));
+	if (m_reusingSummary)
+		m_reusingSummary = false;
+	else
+		connectBlocks(m_currentBlock, summary(_function));
 	setCurrentBlock(*m_summaries.at(m_currentContract).at(&_function));
 
 	// Query placeholders for constructors are not created here because
@@ -1155,6 +1182,7 @@ void CHC::resetSourceAnalysis()
 	m_callGraph.clear();
 	m_summaries.clear();
 	m_externalSummaries.clear();
+	m_encodedSummaries.clear();
 	m_interfaces.clear();
 	m_nondetInterfaces.clear();
 	m_constructorSummaries.clear();
@@ -1170,7 +1198,13 @@ void CHC::resetSourceAnalysis()
 	{
 #ifdef HAVE_Z3
 		// z3::fixedpoint does not have a reset mechanism, so we need to create another.
-		m_interface = std::make_unique<Z3CHCInterface>(m_settings.timeout);
+		// The Horn system is recorded if the targets can be checked in parallel on copies of it.
+		// Cached answers do not carry invariants, so the cache is not used if they are requested.
+		m_interface = std::make_unique<Z3CHCInterface>(
+			solverTimeout(),
+			ThreadPool::instance().maxThreads() > 1,
+			m_settings.invariants.invariants.empty() ? m_queryCache : nullptr
+		);
 		auto z3Interface = dynamic_cast<Z3CHCInterface const*>(m_interface.get());
 		solAssert(z3Interface, "");
 		m_context.setSolver(z3Interface->z3Interface());
@@ -1183,13 +1217,20 @@ void CHC::resetSourceAnalysis()
 		solAssert(m_settings.solvers.smtlib2 || m_settings.solvers.eld);
 
 		if (!m_interface)
-			m_interface = make_unique<CHCSmtLib2Interface>(m_smtlib2Responses, m_smtCallback, m_settings.solvers, m_settings.timeout);
+			m_interface = make_unique<CHCSmtLib2Interface>(
+				m_smtlib2Responses,
+				m_smtCallback,
+				m_settings.solvers,
+				solverTimeout(),
+				m_queryCache
+			);
 
 		auto smtlib2Interface = dynamic_cast<CHCSmtLib2Interface*>(m_interface.get());
 		solAssert(smtlib2Interface, "");
 		smtlib2Interface->reset();
 		m_context.setSolver(smtlib2Interface->smtlib2Interface());
 	}
+	m_interface->setQueryDetails(!m_settings.invariants.invariants.empty(), !m_settings.verdictsOnly);
 
 	m_context.reset();
 	m_context.resetUniqueId();
@@ -1475,6 +1516,125 @@ void CHC::defineExternalFunctionInterface(FunctionDefinition const& _function, C
 	connectBlocks(functionPred, externalSummary(_function));
 }
 
+ContractDefinition const* CHC::reusableSummaryContext(FunctionDefinition const& _function)
+{
+	auto encodingContracts = m_encodedSummaries.find(&_function);
+	if (encodingContracts == m_encodedSummaries.end())
+		return nullptr;
+
+	// Storage pointer arguments may point to state variables that only the current contract has.
+	for (auto const& parameter: _function.parameters())
+		if (parameter->referenceLocation() == VariableDeclaration::Location::Storage)
+			return nullptr;
+
+	solAssert(m_currentContract, "");
+	for (auto const* contract: encodingContracts->second)
+		if (sameEncodingInContexts(_function, *contract, *m_currentContract))
+			return contract;
+	return nullptr;
+}
+
+bool CHC::sameEncodingInContexts(FunctionDefinition const& _function, ContractDefinition const& _a, ContractDefinition const& _b)
+{
+	using Callable = pair<CallableDeclaration const*, ContractDefinition const*>;
+
+	struct DependencyVisitor: public ASTConstVisitor
+	{
+		DependencyVisitor(ContractDefinition const& _a, ContractDefinition const& _b): a(_a), b(_b) {}
+		bool visit(InlineAssembly const&) override
+		{
+			same = false;
+			return false;
+		}
+		void endVisit(ModifierInvocation const& _invocation) override
+		{
+			auto const* modifier = resolveModifierInvocation(_invocation, &a);
+			if (modifier != resolveModifierInvocation(_invocation, &b))
+				same = false;
+			else if (modifier)
+				// Calls in modifiers are resolved in the scope of the modified function.
+				callables.emplace_back(modifier, scope);
+		}
+		void endVisit(FunctionCall const& _funCall) override
+		{
+			if (*_funCall.annotation().kind != FunctionCallKind::FunctionCall)
+				return;
+			switch (dynamic_cast<FunctionType const&>(*_funCall.expression().annotation().type).kind())
+			{
+			case FunctionType::Kind::Internal:
+			{
+				auto const* function = functionCallToDefinition(_funCall, scope, &a);
+				if (!function || function != functionCallToDefinition(_funCall, scope, &b))
+					same = false;
+				else
+					callables.emplace_back(function, function->annotation().contract);
+				break;
+			}
+			case FunctionType::Kind::External:
+			case FunctionType::Kind::BareCall:
+			case FunctionType::Kind::BareStaticCall:
+			case FunctionType::Kind::BareCallCode:
+			case FunctionType::Kind::BareDelegateCall:
+			case FunctionType::Kind::DelegateCall:
+			case FunctionType::Kind::Creation:
+				same = false;
+				break;
+			default:
+				break;
+			}
+		}
+
+		ContractDefinition const& a;
+		ContractDefinition const& b;
+		ContractDefinition const* scope = nullptr;
+		vector<Callable> callables;
+		bool same = true;
+	};
+
+	DependencyVisitor visitor{_a, _b};
+	visitor.callables.emplace_back(&_function, _function.annotation().contract);
+	set<Callable> visited;
+	while (visitor.same && !visitor.callables.empty())
+	{
+		Callable callable = visitor.callables.back();
+		visitor.callables.pop_back();
+		if (!visited.insert(callable).second)
+			continue;
+		visitor.scope = callable.second;
+		callable.first->accept(visitor);
+	}
+	return visitor.same;
+}
+
+void CHC::reuseSummary(FunctionDefinition const& _function, ContractDefinition const& _encodingContract)
+{
+	solAssert(m_currentContract, "");
+	auto const encodingStateVariables = stateVariablesIncludingInheritedAndPrivate(_encodingContract);
+	set<VariableDeclaration const*> const encodingVariables(encodingStateVariables.begin(), encodingStateVariables.end());
+
+	// Apart from the state variables, both summaries have the same arguments.
+	// The state variables of the current contract that the other one does not have
+	// cannot be accessed by the function, so they do not change.
+	auto summaryArgs = [&](vector<VariableDeclaration const*> const& _stateVariables) {
+		vector<smtutil::Expression> args{errorFlag().currentValue(), state().thisAddress(), state().abi(), state().crypto(), state().tx(), state().state(1)};
+		args += applyMap(_stateVariables, [this](auto _var) { return valueAtIndex(*_var, 1); }) +
+			applyMap(_function.parameters(), [this](auto _var) { return valueAtIndex(*_var, 0); }) +
+			vector<smtutil::Expression>{state().state(2)} +
+			applyMap(_stateVariables, [&](auto _var) { return valueAtIndex(*_var, encodingVariables.count(_var) ? 2 : 1); }) +
+			applyMap(_function.parameters(), [this](auto _var) { return valueAtIndex(*_var, 1); }) +
+			applyMap(_function.returnParameters(), [this](auto _var) { return valueAtIndex(*_var, 1); });
+		return args;
+	};
+
+	addRule(
+		smtutil::Expression::implies(
+			(*m_summaries.at(&_encodingContract).at(&_function))(summaryArgs(encodingStateVariables)),
+			(*m_summaries.at(m_currentContract).at(&_function))(summaryArgs(stateVariablesIncludingInheritedAndPrivate(*m_currentContract)))
+		),
+		"summary_reuse_" + to_string(_function.id()) + "_" + to_string(m_currentContract->id())
+	);
+}
+
 void CHC::defineContractInitializer(ContractDefinition const& _contract, ContractDefinition const& _contextContract)
 {
 	m_contractInitializers[&_contextContract][&_contract] = createConstructorBlock(_contract, "contract_initializer");
@@ -1794,53 +1954,74 @@ void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 	m_interface->addRule(_rule, _ruleName);
 }
 
-tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, CHCVerificationTarget const& _target)
+{
+	auto queryResult = solve(*m_interface, _query, m_profiles[_target.contract]);
+	reportSolverFailure(get<0>(queryResult), _target.errorNode->location());
+	return queryResult;
+}
+
+tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> CHC::solve(
+	CHCSolverInterface& _solver,
+	smtutil::Expression const& _query,
+	ModelCheckerEngineProfile& _profile
+) const
 {
+	auto timedQuery = [&]() {
+		util::TraceSpan span("chcQuery", "modelChecker");
+		auto start = chrono::steady_clock::now();
+		auto result = _solver.query(_query);
+		_profile.addQuery(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start));
+		return result;
+	};
+
+	if (m_budget && m_budget->enabled())
+	{
+		optional<unsigned> timeout = m_budget->timeout(m_budgetRound);
+		if (!timeout)
+		{
+			m_budget->skipQuery();
+			return {CheckResult::UNKNOWN, smtutil::Expression(true), {}};
+		}
+		_solver.setTimeout(*timeout);
+	}
+
 	CheckResult result;
 	smtutil::Expression invariant(true);
 	CHCSolverInterface::CexGraph cex;
-	tie(result, invariant, cex) = m_interface->query(_query);
-	switch (result)
-	{
-	case CheckResult::SATISFIABLE:
-	{
+	tie(result, invariant, cex) = timedQuery();
 	// We still need the ifdef because of Z3CHCInterface.
-		if (m_settings.solvers.z3)
-		{
+	if (result == CheckResult::SATISFIABLE && m_settings.solvers.z3)
+	{
 #ifdef HAVE_Z3
-			// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
-			// We now disable those optimizations and check whether we can still solve the problem.
-			auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
-			solAssert(spacer, "");
-			spacer->setSpacerOptions(false);
+		// Even though the problem is SAT, Spacer's pre processing makes counterexamples incomplete.
+		// We now disable those optimizations and check whether we can still solve the problem.
+		auto* spacer = dynamic_cast<Z3CHCInterface*>(&_solver);
+		solAssert(spacer, "");
+		spacer->setSpacerOptions(false);
 
-			CheckResult resultNoOpt;
-			smtutil::Expression invariantNoOpt(true);
-			CHCSolverInterface::CexGraph cexNoOpt;
-			tie(resultNoOpt, invariantNoOpt, cexNoOpt) = m_interface->query(_query);
+		CheckResult resultNoOpt;
+		smtutil::Expression invariantNoOpt(true);
+		CHCSolverInterface::CexGraph cexNoOpt;
+		tie(resultNoOpt, invariantNoOpt, cexNoOpt) = timedQuery();
 
-			if (resultNoOpt == CheckResult::SATISFIABLE)
-				cex = std::move(cexNoOpt);
+		if (resultNoOpt == CheckResult::SATISFIABLE)
+			cex = std::move(cexNoOpt);
 
-			spacer->setSpacerOptions(true);
+		spacer->setSpacerOptions(true);
 #else
-			solAssert(false);
+		solAssert(false);
 #endif
-		}
-		break;
 	}
-	case CheckResult::UNSATISFIABLE:
-		break;
-	case CheckResult::UNKNOWN:
-		break;
-	case CheckResult::CONFLICTING:
+	return {result, invariant, cex};
+}
+
+void CHC::reportSolverFailure(CheckResult _result, langutil::SourceLocation const& _location)
+{
+	if (_result == CheckResult::CONFLICTING)
 		m_errorReporter.warning(1988_error, _location, "CHC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-		break;
-	case CheckResult::ERROR:
+	else if (_result == CheckResult::ERROR)
 		m_errorReporter.warning(1218_error, _location, "CHC: Error trying to invoke SMT solver.");
-		break;
-	}
-	return {result, invariant, cex};
 }
 
 void CHC::verificationTargetEncountered(
@@ -1858,7 +2039,7 @@ void CHC::verificationTargetEncountered(
 	bool scopeIsFunction = m_currentFunction && !m_currentFunction->isConstructor();
 	auto errorId = newErrorId();
 	solAssert(m_verificationTargets.count(errorId) == 0, "Error ID is not unique!");
-	m_verificationTargets.emplace(errorId, CHCVerificationTarget{{_type, _errorCondition, smtutil::Expression(true)}, errorId, _errorNode});
+	m_verificationTargets.emplace(errorId, CHCVerificationTarget{{_type, _errorCondition, smtutil::Expression(true)}, errorId, _errorNode, m_currentContract});
 	if (scopeIsFunction)
 		m_functionTargetIds[m_currentFunction].push_back(errorId);
 	else
@@ -1898,6 +2079,7 @@ void CHC::checkVerificationTargets()
 	}
 
 	set<unsigned> checkedErrorIds;
+	vector<CHCTargetCheck> checks;
 	for (auto const& [targetId, placeholders]: targetEntryPoints)
 	{
 		string errorType;
@@ -1952,10 +2134,23 @@ void CHC::checkVerificationTargets()
 		else
 			solAssert(false, "");
 
-		checkAndReportTarget(target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here.");
+		checks.push_back({target, placeholders, errorReporterId, errorType + " happens here.", errorType + " might happen here."});
 		checkedErrorIds.insert(target.errorId);
 	}
 
+	vector<optional<smtutil::Expression>> unresolved(checks.size());
+	if (!checkAndReportTargetsInParallel(checks, unresolved))
+		for (size_t i = 0; i < checks.size(); ++i)
+			unresolved[i] = checkAndReportTarget(
+				checks[i].target,
+				checks[i].placeholders,
+				checks[i].errorReporterId,
+				checks[i].satMsg,
+				checks[i].unknownMsg
+			);
+	if (m_budget && m_budget->enabled())
+		revisitUnresolvedTargets(checks, std::move(unresolved));
+
 	auto toReport = m_unsafeTargets;
 	if (m_settings.showUnproved)
 		for (auto const& [node, targets]: m_unprovedTargets)
@@ -2043,7 +2238,7 @@ void CHC::checkVerificationTargets()
 		m_safeTargets[m_verificationTargets.at(id).errorNode].insert(m_verificationTargets.at(id).type);
 }
 
-void CHC::checkAndReportTarget(
+optional<smtutil::Expression> CHC::checkAndReportTarget(
 	CHCVerificationTarget const& _target,
 	vector<CHCQueryPlaceholder> const& _placeholders,
 	ErrorId _errorReporterId,
@@ -2051,9 +2246,178 @@ void CHC::checkAndReportTarget(
 	string _unknownMsg
 )
 {
-	if (m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type))
-		return;
+	if (alreadyUnsafe(_target))
+		return nullopt;
+
+	connectTargetToErrorBlock(_target, _placeholders);
+	auto result = query(error(), _target);
+	reportTarget(
+		_target,
+		_errorReporterId,
+		_satMsg,
+		_unknownMsg,
+		error().name,
+		result
+	);
+	if (get<0>(result) == CheckResult::UNKNOWN)
+		return error();
+	return nullopt;
+}
+
+bool CHC::checkAndReportTargetsInParallel(
+	vector<CHCTargetCheck> const& _checks,
+	vector<optional<smtutil::Expression>>& _unresolved
+)
+{
+#ifdef HAVE_Z3
+	auto* spacer = dynamic_cast<Z3CHCInterface*>(m_interface.get());
+	if (!spacer || !spacer->recordsOperations() || _checks.size() <= 1)
+		return false;
 
+	// Unlike in the sequential case, the error blocks of all targets are created up front,
+	// including those of targets that turn out to be redundant because an earlier target with
+	// the same error node and type is unsafe.
+	// The query of every target only needs the Horn system up to its own error block.
+	vector<pair<smtutil::Expression, size_t>> queries;
+	for (auto const& check: _checks)
+	{
+		connectTargetToErrorBlock(check.target, check.placeholders);
+		queries.emplace_back(error(), spacer->recordedOperations());
+	}
+
+	vector<tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph>> results(
+		_checks.size(),
+		{CheckResult::ERROR, smtutil::Expression(true), {}}
+	);
+	vector<ModelCheckerEngineProfile> profiles(_checks.size());
+	// Copies of the Horn system that are not in use, together with the number of operations replayed into them.
+	// Since queries are handed out in order, a copy can usually be caught up with the next query it is used for.
+	mutex replicasMutex;
+	vector<pair<unique_ptr<Z3CHCInterface>, size_t>> replicas;
+	ThreadPool::instance().parallelFor(_checks.size(), [&](size_t _index) {
+		size_t const operations = queries[_index].second;
+		unique_ptr<Z3CHCInterface> replica;
+		size_t replayed = 0;
+		{
+			lock_guard<mutex> lock(replicasMutex);
+			auto best = replicas.end();
+			for (auto it = replicas.begin(); it != replicas.end(); ++it)
+				if (it->second <= operations && (best == replicas.end() || it->second > best->second))
+					best = it;
+			if (best != replicas.end())
+			{
+				tie(replica, replayed) = std::move(*best);
+				replicas.erase(best);
+			}
+			else
+			{
+				replica = make_unique<Z3CHCInterface>(
+					solverTimeout(),
+					false,
+					m_settings.invariants.invariants.empty() ? m_queryCache : nullptr
+				);
+				replica->setQueryDetails(!m_settings.invariants.invariants.empty(), !m_settings.verdictsOnly);
+			}
+		}
+		replica->replay(*spacer, replayed, operations);
+		results[_index] = solve(*replica, queries[_index].first, profiles[_index]);
+		lock_guard<mutex> lock(replicasMutex);
+		replicas.emplace_back(std::move(replica), operations);
+	});
+
+	for (size_t i = 0; i < _checks.size(); ++i)
+	{
+		auto const& check = _checks[i];
+		auto& profile = m_profiles[check.target.contract];
+		profile.solverTime += profiles[i].solverTime;
+		profile.queries += profiles[i].queries;
+		if (alreadyUnsafe(check.target))
+			continue;
+		reportSolverFailure(get<0>(results[i]), check.target.errorNode->location());
+		reportTarget(
+			check.target,
+			check.errorReporterId,
+			check.satMsg,
+			check.unknownMsg,
+			queries[i].first.name,
+			results[i]
+		);
+		if (get<0>(results[i]) == CheckResult::UNKNOWN)
+			_unresolved[i] = queries[i].first;
+	}
+	return true;
+#else
+	(void)_checks;
+	(void)_unresolved;
+	return false;
+#endif
+}
+
+void CHC::revisitUnresolvedTargets(
+	vector<CHCTargetCheck> const& _checks,
+	vector<optional<smtutil::Expression>> _unresolved
+)
+{
+	solAssert(m_budget && m_budget->enabled());
+	solAssert(_checks.size() == _unresolved.size());
+
+	// The unknown results of the first round were recorded as unproved. The entries
+	// are recreated below for the targets that are still unresolved in the end.
+	for (size_t i = 0; i < _checks.size(); ++i)
+		if (_unresolved[i])
+		{
+			auto const& target = _checks[i].target;
+			if (m_unprovedTargets.count(target.errorNode))
+			{
+				m_unprovedTargets.at(target.errorNode).erase(target.type);
+				if (m_unprovedTargets.at(target.errorNode).empty())
+					m_unprovedTargets.erase(target.errorNode);
+			}
+		}
+
+	// The Horn system still contains the error blocks of all targets and every query
+	// is sliced to the rules its error block depends on, so the queries can simply be repeated.
+	auto anyUnresolved = [&]() {
+		return ranges::any_of(_unresolved, [](auto const& _errorPredicate) { return _errorPredicate.has_value(); });
+	};
+	for (m_budgetRound = 1; anyUnresolved() && m_budget->timeout(m_budgetRound); ++m_budgetRound)
+		for (size_t i = 0; i < _checks.size(); ++i)
+		{
+			auto const& check = _checks[i];
+			if (!_unresolved[i])
+				continue;
+			if (alreadyUnsafe(check.target))
+			{
+				_unresolved[i].reset();
+				continue;
+			}
+			auto result = query(*_unresolved[i], check.target);
+			if (get<0>(result) == CheckResult::UNKNOWN)
+				continue;
+			reportTarget(check.target, check.errorReporterId, check.satMsg, check.unknownMsg, _unresolved[i]->name, result);
+			_unresolved[i].reset();
+		}
+	m_budgetRound = 0;
+
+	for (size_t i = 0; i < _checks.size(); ++i)
+		if (_unresolved[i])
+			reportTarget(
+				_checks[i].target,
+				_checks[i].errorReporterId,
+				_checks[i].satMsg,
+				_checks[i].unknownMsg,
+				_unresolved[i]->name,
+				{CheckResult::UNKNOWN, smtutil::Expression(true), {}}
+			);
+}
+
+bool CHC::alreadyUnsafe(CHCVerificationTarget const& _target) const
+{
+	return m_unsafeTargets.count(_target.errorNode) && m_unsafeTargets.at(_target.errorNode).count(_target.type);
+}
+
+void CHC::connectTargetToErrorBlock(CHCVerificationTarget const& _target, vector<CHCQueryPlaceholder> const& _placeholders)
+{
 	createErrorBlock();
 	for (auto const& placeholder: _placeholders)
 		connectBlocks(
@@ -2061,8 +2425,19 @@ void CHC::checkAndReportTarget(
 			error(),
 			placeholder.constraints && placeholder.errorExpression == _target.errorId
 		);
+}
+
+void CHC::reportTarget(
+	CHCVerificationTarget const& _target,
+	ErrorId _errorReporterId,
+	string const& _satMsg,
+	string const& _unknownMsg,
+	string const& _errorPredicate,
+	tuple<CheckResult, smtutil::Expression, CHCSolverInterface::CexGraph> const& _queryResult
+)
+{
+	auto const& [result, invariant, model] = _queryResult;
 	auto const& location = _target.errorNode->location();
-	auto [result, invariant, model] = query(error(), location);
 	if (result == CheckResult::UNSATISFIABLE)
 	{
 		m_safeTargets[_target.errorNode].insert(_target.type);
@@ -2071,14 +2446,19 @@ void CHC::checkAndReportTarget(
 			predicates.insert(pred);
 		for (auto const* pred: m_nondetInterfaces | ranges::views::values)
 			predicates.insert(pred);
-		map<Predicate const*, set<string>> invariants = collectInvariants(invariant, predicates, m_settings.invariants);
-		for (auto pred: invariants | ranges::views::keys)
-			m_invariants[pred] += std::move(invariants.at(pred));
+		if (!m_settings.invariants.invariants.empty())
+		{
+			map<Predicate const*, set<string>> invariants = collectInvariants(invariant, predicates, m_settings.invariants);
+			for (auto pred: invariants | ranges::views::keys)
+				m_invariants[pred] += std::move(invariants.at(pred));
+		}
 	}
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
-		auto cex = generateCounterexample(model, error().name);
+		optional<string> cex;
+		if (!m_settings.verdictsOnly)
+			cex = generateCounterexample(model, _errorPredicate);
 		if (cex)
 			m_unsafeTargets[_target.errorNode][_target.type] = {
 				_errorReporterId,
@@ -31,10 +31,13 @@
 
 #pragma once
 
+#include <libsolidity/formal/ModelCheckerBudget.h>
+#include <libsolidity/formal/ModelCheckerProfile.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/CHCSolverInterface.h>
@@ -44,6 +47,7 @@
 
 #include <boost/algorithm/string/join.hpp>
 
+#include <chrono>
 #include <map>
 #include <optional>
 #include <set>
@@ -60,7 +64,9 @@ public:
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
 		ModelCheckerSettings _settings,
-		langutil::CharStreamProvider const& _charStreamProvider
+		langutil::CharStreamProvider const& _charStreamProvider,
+		CompilationCache* _queryCache = nullptr,
+		ModelCheckerBudget* _budget = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -79,6 +85,10 @@ public:
 	/// the constructor.
 	std::vector<std::string> unhandledQueries() const;
 
+	/// @returns where the analysis of each contract spent its time.
+	/// The solver time of a verification target is attributed to the contract it was encountered in.
+	std::map<ContractDefinition const*, ModelCheckerEngineProfile> const& profiles() const { return m_profiles; }
+
 	enum class CHCNatspecOption
 	{
 		AbstractFunctionNondet
@@ -180,6 +190,22 @@ private:
 	/// potential balance increase by external means, for example.
 	void defineExternalFunctionInterface(FunctionDefinition const& _function, ContractDefinition const& _contract);
 
+	/// @returns a contract in whose context the body of _function was already encoded
+	/// and whose summary of _function can be reused for the current contract,
+	/// or nullptr if there is none.
+	ContractDefinition const* reusableSummaryContext(FunctionDefinition const& _function);
+	/// @returns true if the encoding of _function does not depend on whether _a or _b
+	/// is the most derived contract. That is the case if all internal calls and modifiers
+	/// in _function and, transitively, in the functions and modifiers it uses resolve to
+	/// the same definitions in both contracts, and none of them contains external calls,
+	/// contract creations or inline assembly, which act on the state of the most derived contract.
+	static bool sameEncodingInContexts(FunctionDefinition const& _function, ContractDefinition const& _a, ContractDefinition const& _b);
+	/// Creates the rule
+	/// summary_function_encodingContract \land unchanged_other_state_vars => summary_function
+	/// which defines the summary of _function for the current contract by the one
+	/// already encoded for _encodingContract.
+	void reuseSummary(FunctionDefinition const& _function, ContractDefinition const& _encodingContract);
+
 	/// Creates a CHC system that, for a given contract,
 	/// - initializes its state variables (as 0 or given value, if any).
 	/// - "calls" the explicit constructor function of the contract, if any.
@@ -252,26 +278,70 @@ private:
 
 	/// Solver related.
 	//@{
+	struct CHCVerificationTarget;
 	/// Adds Horn rule to the solver.
 	void addRule(smtutil::Expression const& _rule, std::string const& _ruleName);
 	/// @returns <true, invariant, empty> if query is unsatisfiable (safe).
 	/// @returns <false, Expression(true), model> otherwise.
-	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, langutil::SourceLocation const& _location);
+	/// The query is made for @a _target, whose location is used for reporting solver failures.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> query(smtutil::Expression const& _query, CHCVerificationTarget const& _target);
+	/// Runs @a _query on @a _solver like @a query, but does not report anything.
+	/// If the budget is used up, the solver is not called and the result is unknown.
+	/// The solver calls are recorded in @a _profile.
+	/// Can be called concurrently for different solvers and profiles.
+	std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> solve(
+		smtutil::CHCSolverInterface& _solver,
+		smtutil::Expression const& _query,
+		ModelCheckerEngineProfile& _profile
+	) const;
+	/// @returns the timeout the solvers are created with.
+	std::optional<unsigned> solverTimeout() const { return m_budget ? m_budget->solverTimeout() : m_settings.timeout; }
+	/// Reports a warning if @a _result means that the solvers failed.
+	void reportSolverFailure(smtutil::CheckResult _result, langutil::SourceLocation const& _location);
 
 	void verificationTargetEncountered(ASTNode const* const _errorNode, VerificationTargetType _type, smtutil::Expression const& _errorCondition);
 
 	void checkVerificationTargets();
 	// Forward declarations. Definitions are below.
-	struct CHCVerificationTarget;
 	struct CHCQueryPlaceholder;
+	struct CHCTargetCheck;
 	void checkAssertTarget(ASTNode const* _scope, CHCVerificationTarget const& _target);
-	void checkAndReportTarget(
+	/// @returns the error predicate of the query if its result was unknown.
+	std::optional<smtutil::Expression> checkAndReportTarget(
 		CHCVerificationTarget const& _target,
 		std::vector<CHCQueryPlaceholder> const& _placeholders,
 		langutil::ErrorId _errorReporterId,
 		std::string _satMsg,
 		std::string _unknownMsg = ""
 	);
+	/// Checks all @a _checks using independent copies of the Horn system, as many at a time as
+	/// the thread pool allows, and reports them in order.
+	/// Stores the error predicates of the checks whose result was unknown in @a _unresolved.
+	/// @returns false and does nothing if the targets cannot be checked concurrently.
+	bool checkAndReportTargetsInParallel(
+		std::vector<CHCTargetCheck> const& _checks,
+		std::vector<std::optional<smtutil::Expression>>& _unresolved
+	);
+	/// Queries the error predicates in @a _unresolved of the corresponding @a _checks again in
+	/// rounds of increasing timeouts, as long as the budget lasts.
+	void revisitUnresolvedTargets(
+		std::vector<CHCTargetCheck> const& _checks,
+		std::vector<std::optional<smtutil::Expression>> _unresolved
+	);
+	/// @returns true if the result of @a _target has already been decided to be unsafe.
+	bool alreadyUnsafe(CHCVerificationTarget const& _target) const;
+	/// Creates a new error block that is reachable if @a _target is violated in any of @a _placeholders.
+	void connectTargetToErrorBlock(CHCVerificationTarget const& _target, std::vector<CHCQueryPlaceholder> const& _placeholders);
+	/// Reports @a _target according to the result of the query whether the error predicate
+	/// @a _errorPredicate is reachable.
+	void reportTarget(
+		CHCVerificationTarget const& _target,
+		langutil::ErrorId _errorReporterId,
+		std::string const& _satMsg,
+		std::string const& _unknownMsg,
+		std::string const& _errorPredicate,
+		std::tuple<smtutil::CheckResult, smtutil::Expression, smtutil::CHCSolverInterface::CexGraph> const& _queryResult
+	);
 
 	std::optional<std::string> generateCounterexample(smtutil::CHCSolverInterface::CexGraph const& _graph, std::string const& _root);
 
@@ -359,6 +429,10 @@ private:
 
 	/// External function predicates.
 	std::map<ContractDefinition const*, std::map<FunctionDefinition const*, Predicate const*>> m_externalSummaries;
+
+	/// Contracts in whose context the body of each function was encoded.
+	/// The summaries of the function for other contracts may be defined by these.
+	std::map<FunctionDefinition const*, std::vector<ContractDefinition const*>> m_encodedSummaries;
 	//@}
 
 	/// Variables.
@@ -374,6 +448,8 @@ private:
 	{
 		unsigned const errorId;
 		ASTNode const* const errorNode;
+		/// The contract whose analysis encountered the target.
+		ContractDefinition const* const contract;
 	};
 
 	/// Query placeholder stores information necessary to create the final query edge in the CHC system.
@@ -385,6 +461,17 @@ private:
 		smtutil::Expression const fromPredicate;
 	};
 
+	/// A verification target together with the contexts it has to be checked in and the
+	/// messages to report it with.
+	struct CHCTargetCheck
+	{
+		CHCVerificationTarget const& target;
+		std::vector<CHCQueryPlaceholder> const& placeholders;
+		langutil::ErrorId errorReporterId;
+		std::string satMsg;
+		std::string unknownMsg;
+	};
+
 	/// Query placeholders for constructors, if the key has type ContractDefinition*,
 	/// or external functions, if the key has type FunctionDefinition*.
 	/// A placeholder is created for each possible context of a function (e.g. multiple contracts in contract inheritance hierarchy).
@@ -411,6 +498,9 @@ private:
 	/// Control-flow.
 	//@{
 	FunctionDefinition const* m_currentFunction = nullptr;
+	/// Whether the summary of the current function is defined by the one of another contract
+	/// instead of by encoding its body.
+	bool m_reusingSummary = false;
 
 	std::map<ASTNode const*, std::set<ASTNode const*, smt::EncodingContext::IdCompare>, smt::EncodingContext::IdCompare> m_callGraph;
 
@@ -447,6 +537,18 @@ private:
 
 	std::map<util::h256, std::string> const& m_smtlib2Responses;
 	ReadCallback::Callback const& m_smtCallback;
+
+	/// Cache for solver answers across compiler runs, or nullptr.
+	CompilationCache* m_queryCache = nullptr;
+
+	/// Time budget shared with the other engines, or nullptr.
+	ModelCheckerBudget* m_budget = nullptr;
+	/// Round of the budget the current queries belong to.
+	unsigned m_budgetRound = 0;
+
+	std::map<ContractDefinition const*, ModelCheckerEngineProfile> m_profiles;
+	/// Start of the encoding of the current contract.
+	std::chrono::steady_clock::time_point m_contractProfileStart;
 };
 
 }
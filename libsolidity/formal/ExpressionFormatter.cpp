@@ -130,8 +130,7 @@ smtutil::Expression substitute(smtutil::Expression _from, map<string, string> co
 		return smtutil::Expression(true);
 	if (_subst.count(_from.name))
 		_from.name = _subst.at(_from.name);
-	for (auto& arg: _from.arguments)
-		arg = substitute(arg, _subst);
+	_from.arguments = util::applyMap(_from.arguments.vector(), [&](auto const& _arg) { return substitute(_arg, _subst); });
 	return _from;
 }
 
@@ -43,13 +43,15 @@ ModelChecker::ModelChecker(
 	langutil::CharStreamProvider const& _charStreamProvider,
 	map<h256, string> const& _smtlib2Responses,
 	ModelCheckerSettings _settings,
-	ReadCallback::Callback const& _smtCallback
+	ReadCallback::Callback const& _smtCallback,
+	CompilationCache* _queryCache
 ):
 	m_errorReporter(_errorReporter),
 	m_settings(std::move(_settings)),
+	m_budget(m_settings.budget, m_settings.timeout),
 	m_context(),
-	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider),
-	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider)
+	m_bmc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, _queryCache, &m_budget),
+	m_chc(m_context, m_uniqueErrorReporter, _smtlib2Responses, _smtCallback, m_settings, _charStreamProvider, _queryCache, &m_budget)
 {
 }
 
@@ -136,11 +138,39 @@ void ModelChecker::analyze(SourceUnit const& _source)
 	m_uniqueErrorReporter.clear();
 }
 
+void ModelChecker::reportBudgetUsage()
+{
+	if (!m_budget.enabled() || m_settings.engine.none())
+		return;
+
+	string message =
+		"SMTChecker: Used " + to_string(m_budget.elapsed()) +
+		" ms of the time budget of " + to_string(m_budget.budget()) + " ms.";
+	if (m_budget.skippedQueries() > 0)
+		message +=
+			" " + to_string(m_budget.skippedQueries()) +
+			" solver quer" + (m_budget.skippedQueries() == 1 ? "y was" : "ies were") +
+			" skipped because the budget was used up.";
+	m_errorReporter.info(9127_error, message);
+}
+
 vector<string> ModelChecker::unhandledQueries()
 {
 	return m_bmc.unhandledQueries() + m_chc.unhandledQueries();
 }
 
+map<ContractDefinition const*, ModelCheckerProfile> ModelChecker::profiles() const
+{
+	map<ContractDefinition const*, ModelCheckerProfile> profiles;
+	for (auto const& [contract, profile]: m_bmc.profiles())
+		if (contract)
+			profiles[contract].bmc = profile;
+	for (auto const& [contract, profile]: m_chc.profiles())
+		if (contract)
+			profiles[contract].chc = profile;
+	return profiles;
+}
+
 SMTSolverChoice ModelChecker::availableSolvers()
 {
 	smtutil::SMTSolverChoice available = smtutil::SMTSolverChoice::SMTLIB2();
@@ -26,6 +26,8 @@
 #include <libsolidity/formal/BMC.h>
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/ModelCheckerBudget.h>
+#include <libsolidity/formal/ModelCheckerProfile.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 
 #include <libsolidity/interface/ReadFile.h>
@@ -54,7 +56,8 @@ public:
 		langutil::CharStreamProvider const& _charStreamProvider,
 		std::map<solidity::util::h256, std::string> const& _smtlib2Responses,
 		ModelCheckerSettings _settings = ModelCheckerSettings{},
-		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback()
+		ReadCallback::Callback const& _smtCallback = ReadCallback::Callback(),
+		CompilationCache* _queryCache = nullptr
 	);
 
 	// TODO This should be removed for 0.9.0.
@@ -66,11 +69,18 @@ public:
 
 	void analyze(SourceUnit const& _sources);
 
+	/// Reports how much of the time budget was used, if a budget was given.
+	/// Should be called once all sources were analyzed.
+	void reportBudgetUsage();
+
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
 	std::vector<std::string> unhandledQueries();
 
+	/// @returns where the engines spent their time for each analyzed contract.
+	std::map<ContractDefinition const*, ModelCheckerProfile> profiles() const;
+
 	/// @returns SMT solvers that are available via the C++ API.
 	static smtutil::SMTSolverChoice availableSolvers();
 
@@ -91,6 +101,9 @@ private:
 
 	ModelCheckerSettings m_settings;
 
+	/// Time budget shared by the engines. The time is counted from the construction on.
+	ModelCheckerBudget m_budget;
+
 	/// Stores the context of the encoding.
 	smt::EncodingContext m_context;
 
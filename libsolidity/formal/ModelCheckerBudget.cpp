@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/ModelCheckerBudget.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+ModelCheckerBudget::ModelCheckerBudget(optional<unsigned> _budget, optional<unsigned> _maxTimeout):
+	m_budget(_budget),
+	m_maxTimeout(_maxTimeout && *_maxTimeout > 0 ? _maxTimeout : nullopt),
+	m_start(chrono::steady_clock::now())
+{
+}
+
+optional<unsigned> ModelCheckerBudget::solverTimeout() const
+{
+	if (!enabled())
+		return m_maxTimeout;
+	return min(roundTimeout(0), *m_budget);
+}
+
+optional<unsigned> ModelCheckerBudget::timeout(unsigned _round) const
+{
+	solAssert(enabled());
+	unsigned passed = elapsed();
+	if (passed >= *m_budget)
+		return nullopt;
+	if (_round > 0 && roundTimeout(_round) == roundTimeout(_round - 1))
+		return nullopt;
+	return min(roundTimeout(_round), *m_budget - passed);
+}
+
+unsigned ModelCheckerBudget::elapsed() const
+{
+	auto passed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - m_start).count();
+	return static_cast<unsigned>(min<decltype(passed)>(passed, numeric_limits<unsigned>::max()));
+}
+
+unsigned ModelCheckerBudget::roundTimeout(unsigned _round) const
+{
+	unsigned timeout = initialTimeout;
+	for (unsigned i = 0; i < _round && timeout <= numeric_limits<unsigned>::max() / 2; ++i)
+		timeout *= 2;
+	if (m_maxTimeout)
+		timeout = min(timeout, *m_maxTimeout);
+	return timeout;
+}
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Wall-clock time budget of a model checker run, shared by its engines.
+ * Queries are first given a short timeout. Verification targets that stay unresolved are
+ * revisited in later rounds, each with twice the timeout of the previous round, as long as
+ * the budget lasts. Once it is used up, no more queries are made and the remaining targets
+ * are reported as unproved.
+ */
+class ModelCheckerBudget
+{
+public:
+	/// Timeout of the queries in the first round, in milliseconds.
+	static unsigned constexpr initialTimeout = 1000;
+
+	/// @param _budget the budget in milliseconds. Without it, queries are not limited by the budget.
+	/// @param _maxTimeout the longest timeout given to a single query in milliseconds,
+	/// where 0 means no limit.
+	ModelCheckerBudget(std::optional<unsigned> _budget, std::optional<unsigned> _maxTimeout);
+
+	bool enabled() const { return m_budget.has_value(); }
+
+	/// @returns the timeout the solvers are created with.
+	/// Without a budget, this is the timeout given in the settings.
+	std::optional<unsigned> solverTimeout() const;
+
+	/// @returns the timeout of a query made in round @a _round, which is limited by the time
+	/// left in the budget, or nullopt if the budget is used up or the timeout would not be
+	/// longer than in the previous round.
+	/// @a _round starts at 0. Must only be called if the budget is enabled.
+	std::optional<unsigned> timeout(unsigned _round) const;
+
+	/// Records that a query was not made because the budget was used up.
+	void skipQuery() { ++m_skippedQueries; }
+
+	unsigned budget() const { return m_budget.value_or(0); }
+	/// @returns the milliseconds passed since the creation of the budget.
+	unsigned elapsed() const;
+	unsigned skippedQueries() const { return m_skippedQueries; }
+
+private:
+	/// @returns the timeout of round @a _round ignoring the time left in the budget.
+	unsigned roundTimeout(unsigned _round) const;
+
+	std::optional<unsigned> m_budget;
+	std::optional<unsigned> m_maxTimeout;
+	std::chrono::steady_clock::time_point m_start;
+	/// Queries are made from several threads by the CHC engine.
+	std::atomic<unsigned> m_skippedQueries = 0;
+};
+
+}
@@ -0,0 +1,57 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Where an engine of the model checker spent its time while analyzing a contract.
+ */
+struct ModelCheckerEngineProfile
+{
+	/// Time spent creating the encoding of the contract, i.e. everything but the solver queries.
+	std::chrono::microseconds encodingTime{0};
+	/// Time spent waiting for solver answers. Queries that run concurrently are summed up.
+	std::chrono::microseconds solverTime{0};
+	/// Number of solver queries, including those answered from a cache.
+	size_t queries = 0;
+
+	void addQuery(std::chrono::microseconds _duration)
+	{
+		solverTime += _duration;
+		++queries;
+	}
+};
+
+/**
+ * Profile of the analysis of a contract by the model checker engines.
+ */
+struct ModelCheckerProfile
+{
+	/// Set if the engine analyzed the contract.
+	std::optional<ModelCheckerEngineProfile> bmc;
+	std::optional<ModelCheckerEngineProfile> chc;
+};
+
+}
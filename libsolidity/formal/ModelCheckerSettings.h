@@ -157,6 +157,10 @@ struct ModelCheckerExtCalls
 
 struct ModelCheckerSettings
 {
+	/// Wall-clock time in milliseconds that the model checker may spend on solver queries.
+	/// If given, queries get short timeouts first and unresolved targets are revisited with
+	/// longer timeouts, which are limited by @a timeout.
+	std::optional<unsigned> budget;
 	ModelCheckerContracts contracts = ModelCheckerContracts::Default();
 	/// Currently division and modulo are replaced by multiplication with slack vars, such that
 	/// a / b <=> a = b * k + m
@@ -168,24 +172,33 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::None();
 	ModelCheckerExtCalls externalCalls = {};
 	ModelCheckerInvariants invariants = ModelCheckerInvariants::Default();
+	/// If more than one SMT solver is enabled, run them concurrently on every query and
+	/// use the first answer instead of running them one after another and comparing their answers.
+	bool raceSolvers = false;
 	bool showUnproved = false;
 	smtutil::SMTSolverChoice solvers = smtutil::SMTSolverChoice::Z3();
 	ModelCheckerTargets targets = ModelCheckerTargets::Default();
 	std::optional<unsigned> timeout;
+	/// Only report whether the targets are safe, unsafe or unproved. Counterexamples are neither
+	/// extracted from the solvers nor reconstructed, so the answers to unsafe queries can be cached.
+	bool verdictsOnly = false;
 
 	bool operator!=(ModelCheckerSettings const& _other) const noexcept { return !(*this == _other); }
 	bool operator==(ModelCheckerSettings const& _other) const noexcept
 	{
 		return
+			budget == _other.budget &&
 			contracts == _other.contracts &&
 			divModNoSlacks == _other.divModNoSlacks &&
 			engine == _other.engine &&
 			externalCalls.mode == _other.externalCalls.mode &&
 			invariants == _other.invariants &&
+			raceSolvers == _other.raceSolvers &&
 			showUnproved == _other.showUnproved &&
 			solvers == _other.solvers &&
 			targets == _other.targets &&
-			timeout == _other.timeout;
+			timeout == _other.timeout &&
+			verdictsOnly == _other.verdictsOnly;
 	}
 };
 
@@ -0,0 +1,117 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+FileSystemCompilationCache::FileSystemCompilationCache(boost::filesystem::path _directory):
+	m_directory(std::move(_directory))
+{
+}
+
+optional<string> FileSystemCompilationCache::load(util::h256 const& _key)
+{
+	boost::filesystem::path const path = entryPath(_key);
+
+	boost::system::error_code errorCode;
+	if (!boost::filesystem::is_regular_file(path, errorCode))
+		return nullopt;
+
+	try
+	{
+		return util::readFileAsString(path);
+	}
+	catch (util::Exception const&)
+	{
+		return nullopt;
+	}
+}
+
+void FileSystemCompilationCache::store(util::h256 const& _key, string const& _artifact)
+{
+	boost::system::error_code errorCode;
+	boost::filesystem::create_directories(m_directory, errorCode);
+	if (errorCode)
+		return;
+
+	// Write to a unique temporary file first and then rename it into place so that concurrent
+	// compiler processes sharing the directory never observe a partially written entry.
+	boost::filesystem::path const path = entryPath(_key);
+	boost::filesystem::path const temporaryPath = boost::filesystem::unique_path(path.string() + ".%%%%-%%%%.tmp", errorCode);
+	if (errorCode)
+		return;
+
+	{
+		ofstream output(temporaryPath.string(), ios::binary | ios::trunc);
+		output << _artifact;
+		if (!output.good())
+		{
+			output.close();
+			boost::filesystem::remove(temporaryPath, errorCode);
+			return;
+		}
+	}
+
+	boost::filesystem::rename(temporaryPath, path, errorCode);
+	if (errorCode)
+		boost::filesystem::remove(temporaryPath, errorCode);
+}
+
+boost::filesystem::path FileSystemCompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / _key.hex();
+}
+
+optional<string> MemoryCompilationCache::load(util::h256 const& _key)
+{
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_entries.find(_key);
+	if (it == m_entries.end())
+		return nullopt;
+	return it->second;
+}
+
+void MemoryCompilationCache::store(util::h256 const& _key, string const& _artifact)
+{
+	if (_artifact.size() > m_maxSize)
+		return;
+
+	lock_guard<mutex> lock(m_mutex);
+	if (auto it = m_entries.find(_key); it != m_entries.end())
+	{
+		m_size -= it->second.size();
+		m_entries.erase(it);
+	}
+	if (m_size + _artifact.size() > m_maxSize)
+	{
+		m_entries.clear();
+		m_size = 0;
+	}
+	m_entries.emplace(_key, _artifact);
+	m_size += _artifact.size();
+}
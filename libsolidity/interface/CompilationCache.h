@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Content-addressed store for intermediate compilation artifacts.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Store for artifacts that are expensive to produce and fully determined by their inputs.
+ * Entries are addressed by a hash of everything that influences their content, so an entry
+ * never has to be invalidated. A cache is purely an optimisation: a failing lookup or store
+ * must never affect the result of the compilation.
+ */
+class CompilationCache
+{
+public:
+	virtual ~CompilationCache() = default;
+
+	/// @returns the artifact stored under @a _key or an empty optional if there is none.
+	virtual std::optional<std::string> load(util::h256 const& _key) = 0;
+	/// Stores @a _artifact under @a _key, replacing any previous entry.
+	virtual void store(util::h256 const& _key, std::string const& _artifact) = 0;
+};
+
+/**
+ * Compilation cache that keeps one file per entry in a directory, so that its contents are
+ * preserved across compiler runs. The directory is created on first use.
+ */
+class FileSystemCompilationCache: public CompilationCache
+{
+public:
+	explicit FileSystemCompilationCache(boost::filesystem::path _directory);
+
+	std::optional<std::string> load(util::h256 const& _key) override;
+	void store(util::h256 const& _key, std::string const& _artifact) override;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+/**
+ * Compilation cache that keeps its entries in memory, for a compiler process that serves
+ * many compilations. Once the entries exceed the size limit, they are all dropped.
+ * Can be used from several threads at once.
+ */
+class MemoryCompilationCache: public CompilationCache
+{
+public:
+	/// @param _maxSize the maximum total size of the stored artifacts in bytes.
+	explicit MemoryCompilationCache(size_t _maxSize = 512 * 1024 * 1024): m_maxSize(_maxSize) {}
+
+	std::optional<std::string> load(util::h256 const& _key) override;
+	void store(util::h256 const& _key, std::string const& _artifact) override;
+
+private:
+	size_t const m_maxSize;
+	std::mutex m_mutex;
+	std::map<util::h256, std::string> m_entries;
+	size_t m_size = 0;
+};
+
+}
@@ -50,9 +50,11 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/interface/StoragePackingAdvisor.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
 
@@ -76,6 +78,8 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/ThreadPool.h>
+#include <libsolutil/TraceEvents.h>
 
 #include <json/json.h>
 
@@ -96,14 +100,88 @@ using namespace solidity::frontend;
 using solidity::util::errinfo_comment;
 using solidity::util::toHex;
 
-static int g_compilerStackCounts = 0;
+namespace
+{
+
+/// Runs @a _check on all @a _sourceUnits in parallel, each with its own error reporter.
+/// The errors are then appended to @a _errorReporter in the order of @a _sourceUnits, so that
+/// the result is the same as if the sources had been checked one after the other.
+/// May only be used for checks that do not modify or share state across source units.
+/// @returns false if any of the checks returned false.
+bool checkSourceUnitsInParallel(
+	vector<SourceUnit const*> const& _sourceUnits,
+	ErrorReporter& _errorReporter,
+	function<bool(SourceUnit const&, ErrorReporter&)> const& _check
+)
+{
+	struct Result
+	{
+		ErrorList errors;
+		bool success = true;
+		bool fatal = false;
+	};
+	vector<Result> results(_sourceUnits.size());
+	util::ThreadPool::instance().parallelFor(_sourceUnits.size(), [&](size_t _index) {
+		Result& result = results[_index];
+		ErrorReporter errorReporter(result.errors);
+		try
+		{
+			result.success = _check(*_sourceUnits[_index], errorReporter);
+		}
+		catch (FatalError const&)
+		{
+			result.success = false;
+			result.fatal = true;
+		}
+	});
+
+	bool success = true;
+	for (Result const& result: results)
+	{
+		_errorReporter.appendWithLimits(result.errors);
+		// Sequential checking would have stopped at this source.
+		if (result.fatal)
+			BOOST_THROW_EXCEPTION(FatalError());
+		success = success && result.success;
+	}
+	return success;
+}
+
+/// Adds a fixed offset to the IDs of all nodes of a source unit.
+class NodeIDShifter: private ASTVisitor
+{
+public:
+	static void shift(SourceUnit& _sourceUnit, int64_t _offset)
+	{
+		NodeIDShifter shifter{_offset};
+		_sourceUnit.accept(shifter);
+	}
+
+private:
+	explicit NodeIDShifter(int64_t _offset): m_offset(_offset) {}
+
+	bool visitNode(ASTNode& _node) override
+	{
+		// Nodes that are reachable in more than one way must only be shifted once.
+		if (m_shiftedNodes.insert(&_node).second)
+			_node.shiftID(m_offset);
+		return true;
+	}
+
+	int64_t m_offset = 0;
+	set<ASTNode const*> m_shiftedNodes;
+};
+
+}
+
+static thread_local int g_compilerStackCounts = 0;
 
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
+	// Because TypeProvider is currently a per-thread singleton API, we must ensure that
+	// no more than one entity on this thread is actually using it at a time.
 	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
 	++g_compilerStackCounts;
 }
@@ -116,6 +194,8 @@ CompilerStack::~CompilerStack()
 
 void CompilerStack::createAndAssignCallGraphs()
 {
+	// Shared by all contracts, so that the code of common base contracts is only visited once.
+	FunctionCallGraphBuilder::ReferenceCache referenceCache;
 	for (Source const* source: m_sourceOrder)
 	{
 		if (!source->ast)
@@ -127,12 +207,13 @@ void CompilerStack::createAndAssignCallGraphs()
 				m_contracts.at(contract->fullyQualifiedName()).contract->annotation();
 
 			annotation.creationCallGraph = make_unique<CallGraph>(
-				FunctionCallGraphBuilder::buildCreationGraph(*contract)
+				FunctionCallGraphBuilder::buildCreationGraph(*contract, &referenceCache)
 			);
 			annotation.deployedCallGraph = make_unique<CallGraph>(
 				FunctionCallGraphBuilder::buildDeployedGraph(
 					*contract,
-					**annotation.creationCallGraph
+					**annotation.creationCallGraph,
+					&referenceCache
 				)
 			);
 
@@ -243,8 +324,8 @@ void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 
 void CompilerStack::setLibraries(std::map<std::string, util::h160> const& _libraries)
 {
-	if (m_stackState >= ParsedAndImported)
-		solThrow(CompilerError, "Must set libraries before parsing.");
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set libraries before compiling.");
 	m_libraries = _libraries;
 }
 
@@ -305,6 +386,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_phaseStatistics.clear();
 	if (!_keepSettings)
 	{
 		m_importRemapper.clear();
@@ -320,10 +402,14 @@ void CompilerStack::reset(bool _keepSettings)
 		m_metadataFormat = defaultMetadataFormat();
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
+		m_skipUnreferencedSources = false;
+		m_deduplicateSources = false;
 	}
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_yulFunctionCache.clear();
+	m_yulUtilityCodeCache.clear();
 	m_errorReporter.clear();
 	TypeProvider::reset();
 }
@@ -334,7 +420,7 @@ void CompilerStack::setSources(StringMap _sources)
 		solThrow(CompilerError, "Cannot change sources once set.");
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must set sources before parsing.");
-	for (auto source: _sources)
+	for (auto& source: _sources)
 		m_sources[source.first].charStream = make_unique<CharStream>(/*content*/std::move(source.second), /*name*/source.first);
 	m_stackState = SourcesSet;
 }
@@ -348,47 +434,126 @@ bool CompilerStack::parse()
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
 
-	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	util::PhaseRecorder phase("parsing", phaseStatisticsTarget());
 
+	// If unreferenced sources are skipped, parsing starts with the requested sources only
+	// and follows their imports.
+	bool const onlyImportClosure = m_skipUnreferencedSources && m_stopAfter >= ParsedAndImported;
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
-
-	for (size_t i = 0; i < sourcesToParse.size(); ++i)
+		if (!onlyImportClosure || isRequestedSource(s.first))
+			sourcesToParse.push_back(s.first);
+	set<string> queuedSources(sourcesToParse.begin(), sourcesToParse.end());
+	size_t const requestedSourceCount = sourcesToParse.size();
+
+	// The sources are parsed in waves: All sources known at the start of a wave are parsed in parallel,
+	// each by its own parser and error reporter. Their results are then processed in order, which
+	// resolves their imports and may queue further sources for the next wave. The node IDs are shifted
+	// to the values a single parser that parses all sources one after the other would have assigned.
+	struct ParseResult
 	{
-		string const& path = sourcesToParse[i];
-		Source& source = m_sources[path];
-		source.ast = parser.parse(*source.charStream);
-		if (!source.ast)
-			solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
-		else
+		ASTPointer<SourceUnit> ast;
+		ErrorList errors;
+		int64_t nodeIDCount = 0;
+	};
+	int64_t nodeIDOffset = 0;
+	for (size_t i = 0; i < sourcesToParse.size();)
+	{
+		vector<CharStream*> charStreams;
+		for (size_t j = i; j < sourcesToParse.size(); ++j)
+			charStreams.push_back(m_sources.at(sourcesToParse[j]).charStream.get());
+		vector<ParseResult> results(charStreams.size());
+		util::ThreadPool::instance().parallelFor(charStreams.size(), [&](size_t _index) {
+			ParseResult& result = results[_index];
+			ErrorReporter errorReporter(result.errors);
+			Parser parser{errorReporter, m_evmVersion, m_parserErrorRecovery};
+			result.ast = parser.parse(*charStreams[_index]);
+			result.nodeIDCount = parser.nodeIDCount();
+		});
+
+		for (ParseResult& result: results)
 		{
-			source.ast->annotation().path = path;
-
-			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+			string const path = sourcesToParse[i++];
+			Source& source = m_sources[path];
+			try
+			{
+				m_errorReporter.appendWithLimits(result.errors);
+			}
+			catch (FatalError const&)
 			{
-				solAssert(!import->path().empty(), "Import path cannot be empty.");
-
-				// The current value of `path` is the absolute path as seen from this source file.
-				// We first have to apply remappings before we can store the actual absolute path
-				// as seen globally.
-				import->annotation().absolutePath = applyRemapping(util::absolutePath(
-					import->path(),
-					path
-				), path);
+				// Parsing this source after the errors of the previous ones would have exceeded the error limit.
+				result.ast = nullptr;
 			}
+			source.ast = std::move(result.ast);
+			if (source.ast && nodeIDOffset != 0)
+				NodeIDShifter::shift(*source.ast, nodeIDOffset);
+			nodeIDOffset += result.nodeIDCount;
+
+			if (!source.ast)
+				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
+			else
+			{
+				source.ast->annotation().path = path;
 
-			if (m_stopAfter >= ParsedAndImported)
-				for (auto const& newSource: loadMissingSources(*source.ast))
+				for (auto const& import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
 				{
-					string const& newPath = newSource.first;
-					string const& newContents = newSource.second;
-					m_sources[newPath].charStream = make_shared<CharStream>(newContents, newPath);
-					sourcesToParse.push_back(newPath);
+					solAssert(!import->path().empty(), "Import path cannot be empty.");
+
+					// The current value of `path` is the absolute path as seen from this source file.
+					// We first have to apply remappings before we can store the actual absolute path
+					// as seen globally.
+					import->annotation().absolutePath = applyRemapping(util::absolutePath(
+						import->path(),
+						path
+					), path);
+
+					string const& importPath = *import->annotation().absolutePath;
+					if (onlyImportClosure && m_sources.count(importPath) && queuedSources.insert(importPath).second)
+						sourcesToParse.push_back(importPath);
 				}
+
+				if (m_stopAfter >= ParsedAndImported)
+					for (auto& [newPath, newContents]: loadMissingSources(*source.ast))
+					{
+						m_sources[newPath].charStream = make_shared<CharStream>(std::move(newContents), newPath);
+						sourcesToParse.push_back(newPath);
+						queuedSources.insert(newPath);
+					}
+			}
 		}
 	}
 
+	if (m_deduplicateSources && m_stopAfter >= ParsedAndImported)
+	{
+		redirectImportsOfDuplicateSources();
+		if (onlyImportClosure)
+		{
+			// Copies that were only reached through redirected imports are no longer referenced.
+			queuedSources.clear();
+			vector<string> toVisit(sourcesToParse.begin(), sourcesToParse.begin() + static_cast<ptrdiff_t>(requestedSourceCount));
+			while (!toVisit.empty())
+			{
+				string const path = std::move(toVisit.back());
+				toVisit.pop_back();
+				if (!queuedSources.insert(path).second)
+					continue;
+				if (SourceUnit const* ast = m_sources.at(path).ast.get())
+					for (auto const& import: ASTNode::filteredNodes<ImportDirective>(ast->nodes()))
+						if (m_sources.count(*import->annotation().absolutePath))
+							toVisit.push_back(*import->annotation().absolutePath);
+			}
+		}
+	}
+
+	if (onlyImportClosure)
+	{
+		for (auto it = m_sources.begin(); it != m_sources.end();)
+			if (queuedSources.count(it->first))
+				++it;
+			else
+				it = m_sources.erase(it);
+	}
+
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
 	else
@@ -401,10 +566,63 @@ bool CompilerStack::parse()
 	return !m_hasError;
 }
 
+void CompilerStack::redirectImportsOfDuplicateSources()
+{
+	// Sources are duplicates of each other if they have the same content and their imports,
+	// in order, refer to duplicates of each other as well. The classes of duplicates are found by
+	// starting with the classes of sources with the same content and splitting them until the
+	// imports of all sources in a class refer to the same classes.
+	map<string, size_t> classOf;
+	{
+		map<h256, size_t> contentClasses;
+		for (auto const& [path, source]: m_sources)
+			if (source.ast)
+				classOf[path] = contentClasses.emplace(
+					util::keccak256(source.charStream->source()),
+					contentClasses.size()
+				).first->second;
+	}
+	for (size_t classCount = 0; ;)
+	{
+		// Imports of sources that are not available are identified by their path.
+		using Signature = pair<size_t, vector<pair<size_t, string>>>;
+		map<Signature, size_t> refinedClasses;
+		map<string, size_t> refinedClassOf;
+		for (auto const& [path, sourceClass]: classOf)
+		{
+			Signature signature{sourceClass, {}};
+			for (auto const& import: ASTNode::filteredNodes<ImportDirective>(m_sources.at(path).ast->nodes()))
+			{
+				string const& importPath = *import->annotation().absolutePath;
+				if (classOf.count(importPath))
+					signature.second.emplace_back(classOf.at(importPath), string{});
+				else
+					signature.second.emplace_back(numeric_limits<size_t>::max(), importPath);
+			}
+			refinedClassOf[path] = refinedClasses.emplace(std::move(signature), refinedClasses.size()).first->second;
+		}
+		classOf = std::move(refinedClassOf);
+		// Classes are only ever split, so an unchanged number of classes means that nothing changed.
+		if (refinedClasses.size() == classCount)
+			break;
+		classCount = refinedClasses.size();
+	}
+
+	// Every class is represented by its source with the smallest name.
+	map<size_t, string> representatives;
+	for (auto const& [path, sourceClass]: classOf)
+		representatives.emplace(sourceClass, path);
+	for (auto const& [path, sourceClass]: classOf)
+		for (auto const& import: ASTNode::filteredNodes<ImportDirective>(m_sources.at(path).ast->nodes()))
+			if (classOf.count(*import->annotation().absolutePath))
+				import->annotation().absolutePath = representatives.at(classOf.at(*import->annotation().absolutePath));
+}
+
 void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 {
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
+	util::PhaseRecorder phase("astImport", phaseStatisticsTarget());
 	m_sourceJsons = _sources;
 	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(m_sourceJsons);
 	for (auto& src: reconstructedSources)
@@ -429,6 +647,7 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		solThrow(CompilerError, "Must call analyze only after parsing was performed.");
+	util::PhaseRecorder phases("scoping", phaseStatisticsTarget());
 	resolveImports();
 
 	for (Source const* source: m_sourceOrder)
@@ -437,13 +656,24 @@ bool CompilerStack::analyze()
 
 	bool noErrors = true;
 
+	// The checks that only look at a single source unit are run on all sources in parallel.
+	vector<SourceUnit const*> sourceUnits;
+	for (Source const* source: m_sourceOrder)
+		if (source->ast)
+			sourceUnits.push_back(source->ast.get());
+
 	try
 	{
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
-
+		phases.start("syntaxChecking");
+		bool const useYulOptimizer = m_optimiserSettings.runYulOptimiser;
+		checkSourceUnitsInParallel(sourceUnits, m_errorReporter, [&](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return SyntaxChecker(_errorReporter, useYulOptimizer).checkSyntax(_sourceUnit);
+		});
+		// The syntax checker also fails because of errors reported before it ran.
+		if (!sourceUnits.empty() && Error::containsErrors(m_errorReporter.errors()))
+			noErrors = false;
+
+		phases.start("declarationRegistration");
 		m_globalContext = make_shared<GlobalContext>();
 		// We need to keep the same resolver during the whole process.
 		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
@@ -460,22 +690,27 @@ bool CompilerStack::analyze()
 
 		resolver.warnHomonymDeclarations();
 
+		phases.start("docStringParsing");
 		DocStringTagParser docStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
-				noErrors = false;
+		if (!checkSourceUnitsInParallel(sourceUnits, m_errorReporter, [](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return DocStringTagParser(_errorReporter).parseDocStrings(_sourceUnit);
+		}))
+			noErrors = false;
 
 		// Requires DocStringTagParser
+		phases.start("nameAndTypeResolution");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
+		phases.start("declarationTypeChecking");
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
 		// Requires DeclarationTypeChecker to have run
+		phases.start("docStringTypeValidation");
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !docStringTagParser.validateDocStringsUsingTypes(*source->ast))
 				noErrors = false;
@@ -484,6 +719,7 @@ bool CompilerStack::analyze()
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
+		phases.start("contractLevelChecking");
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
 		for (Source const* source: m_sourceOrder)
@@ -497,6 +733,7 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
+		phases.start("typeChecking");
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
 		for (Source const* source: m_sourceOrder)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
@@ -505,6 +742,7 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Requires ContractLevelChecker and TypeChecker
+			phases.start("docStringAnalysis");
 			DocStringAnalyser docStringAnalyser(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
@@ -514,6 +752,7 @@ bool CompilerStack::analyze()
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			phases.start("postTypeChecking");
 			PostTypeChecker postTypeChecker(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !postTypeChecker.check(*source->ast))
@@ -525,28 +764,36 @@ bool CompilerStack::analyze()
 		// Create & assign callgraphs and check for contract dependency cycles
 		if (noErrors)
 		{
+			phases.start("callGraphs");
 			createAndAssignCallGraphs();
 			findAndReportCyclicContractDependencies();
 		}
 
 		if (noErrors)
+		{
+			phases.start("postTypeContractLevelChecking");
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !PostTypeContractLevelChecker{m_errorReporter}.check(*source->ast))
 					noErrors = false;
+		}
 
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
+		{
+			phases.start("immutableValidation");
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 							ImmutableValidator(m_errorReporter, *contract).analyze();
+		}
 
 		if (noErrors)
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			phases.start("controlFlowAnalysis");
 			CFG cfg(m_errorReporter);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast && !cfg.constructFlow(*source->ast))
@@ -565,28 +812,50 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			// Checks for common mistakes. Only generates warnings.
-			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
-		}
-
-		if (noErrors)
-		{
-			// Check for state mutability in every function.
+			// Checks for common mistakes, which only generates warnings, and the check of the state
+			// mutability of every function share a single traversal of the AST. They report to separate
+			// error lists, so that the errors are the same as if the checks had run one after the other.
+			phases.start("staticAnalysisAndViewPureChecking");
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					ast.push_back(source->ast);
 
-			if (!ViewPureChecker(ast, m_errorReporter).check())
+			ErrorList staticAnalysisErrors;
+			ErrorList viewPureErrors;
+			ErrorReporter staticAnalysisErrorReporter(staticAnalysisErrors);
+			ErrorReporter viewPureErrorReporter(viewPureErrors);
+			StaticAnalyzer staticAnalyzer(staticAnalysisErrorReporter);
+			ViewPureChecker viewPureChecker(ast, viewPureErrorReporter);
+			ASTConstVisitorMultiplexer multiplexer({&staticAnalyzer.visitor(), &viewPureChecker.visitor()});
+			try
+			{
+				for (ASTPointer<ASTNode> const& sourceUnit: ast)
+					sourceUnit->accept(multiplexer);
+			}
+			catch (FatalError const&)
+			{
+				m_errorReporter.appendWithLimits(staticAnalysisErrors);
+				if (!Error::containsErrors(m_errorReporter.errors()))
+					m_errorReporter.appendWithLimits(viewPureErrors);
+				throw;
+			}
+
+			m_errorReporter.appendWithLimits(staticAnalysisErrors);
+			if (Error::containsErrors(m_errorReporter.errors()))
 				noErrors = false;
+			else
+			{
+				m_errorReporter.appendWithLimits(viewPureErrors);
+				if (!viewPureChecker.success())
+					noErrors = false;
+			}
 		}
 
 		if (noErrors)
 		{
 			// Run SMTChecker
+			phases.start("modelChecking");
 
 			auto allSources = util::applyMap(m_sourceOrder, [](Source const* _source) { return _source->ast; });
 			if (ModelChecker::isPragmaPresent(allSources))
@@ -597,11 +866,23 @@ bool CompilerStack::analyze()
 			if (m_modelCheckerSettings.engine.any())
 				m_modelCheckerSettings.solvers = ModelChecker::checkRequestedSolvers(m_modelCheckerSettings.solvers, m_errorReporter);
 
-			ModelChecker modelChecker(m_errorReporter, *this, m_smtlib2Responses, m_modelCheckerSettings, m_readFile);
+			ModelChecker modelChecker(
+				m_errorReporter,
+				*this,
+				m_smtlib2Responses,
+				m_modelCheckerSettings,
+				m_readFile,
+				m_compilationCache.get()
+			);
 			modelChecker.checkRequestedSourcesAndContracts(allSources);
 			for (Source const* source: m_sourceOrder)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
+			modelChecker.reportBudgetUsage();
+			auto modelCheckerProfiles = modelChecker.profiles();
+			for (auto& [name, contract]: m_contracts)
+				if (modelCheckerProfiles.count(contract.contract))
+					contract.modelCheckerProfile = modelCheckerProfiles.at(contract.contract);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
 		}
 	}
@@ -611,8 +892,10 @@ bool CompilerStack::analyze()
 			throw; // Something is weird here, rather throw again.
 		noErrors = false;
 	}
+	phases.stop();
 
 	m_stackState = AnalysisPerformed;
+	m_analysisErrorCount = m_errorList.size();
 	if (!noErrors)
 		m_hasError = true;
 
@@ -670,70 +953,133 @@ bool CompilerStack::compile(State _stopAfter)
 		solThrow(CompilerError, "Called compile with errors.");
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
-
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
-							return false;
-						}
-						else
-							throw;
-					}
-				}
+					requestedContracts.push_back(contract);
+
+	// Index of the last requested contract whose compilation needs the results of a contract,
+	// i.e. the contract itself or one that creates it, directly or indirectly.
+	map<ContractDefinition const*, size_t> lastUse;
+	for (size_t i = 0; i < requestedContracts.size(); ++i)
+	{
+		vector<ContractDefinition const*> toVisit{requestedContracts[i]};
+		set<ContractDefinition const*> visited;
+		while (!toVisit.empty())
+		{
+			ContractDefinition const* contract = toVisit.back();
+			toVisit.pop_back();
+			if (!visited.insert(contract).second)
+				continue;
+			lastUse[contract] = i;
+			for (auto const& [dependency, referencee]: contract->annotation().contractDependencies)
+				toVisit.push_back(dependency);
+		}
+	}
+	map<size_t, vector<ContractDefinition const*>> releasableAfter;
+	for (auto const& [contract, index]: lastUse)
+		releasableAfter[index].push_back(contract);
+
+	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	for (size_t i = 0; i < requestedContracts.size(); ++i)
+	{
+		if (!compileRequestedContract(*requestedContracts[i], otherCompilers))
+			return false;
+		for (ContractDefinition const* contract: releasableAfter[i])
+			releaseIntermediates(*contract, otherCompilers);
+	}
+
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+void CompilerStack::resetCodeGeneration()
+{
+	if (m_stackState < AnalysisPerformed)
+		solThrow(CompilerError, "Must call resetCodeGeneration only after the analysis.");
+
+	// Only the contract definitions and the results of the model checker were produced
+	// by the analysis. Everything else, including the lazily computed outputs that
+	// depend on the code generation settings, has to be computed again.
+	map<string const, Contract> analysedContracts;
+	for (auto const& [name, contract]: m_contracts)
+	{
+		Contract& analysedContract = analysedContracts[name];
+		analysedContract.contract = contract.contract;
+		analysedContract.modelCheckerProfile = contract.modelCheckerProfile;
+	}
+	m_contracts.swap(analysedContracts);
+	m_yulFunctionCache.clear();
+	m_yulUtilityCodeCache.clear();
+	solAssert(m_errorList.size() >= m_analysisErrorCount);
+	m_errorList.erase(m_errorList.begin() + static_cast<ptrdiff_t>(m_analysisErrorCount), m_errorList.end());
+	m_stackState = AnalysisPerformed;
+}
+
+bool CompilerStack::compileRequestedContract(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+)
+{
+	try
+	{
+		if (m_viaIR || m_generateIR || m_generateEwasm)
+			generateIR(_contract);
+		if (m_generateEvmBytecode)
+		{
+			if (m_viaIR)
+				generateEVMFromIR(_contract);
+			else
+				compileContract(_contract, _otherCompilers);
+		}
+		if (m_generateEwasm)
+			generateEwasm(_contract);
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+			return false;
+		}
+		else
+			throw;
+	}
+	return true;
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
+	vector<evmasm::LinkerObject*> objects;
 	for (auto& contract: m_contracts)
 	{
-		contract.second.object.link(m_libraries);
-		contract.second.runtimeObject.link(m_libraries);
+		objects.emplace_back(&contract.second.object);
+		objects.emplace_back(&contract.second.runtimeObject);
 	}
+	evmasm::LinkerObject::link(objects, m_libraries);
 }
 
 vector<string> CompilerStack::contractNames() const
@@ -782,22 +1128,26 @@ Json::Value CompilerStack::generatedSources(string const& _contractName, bool _r
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	Contract const& c = contract(_contractName);
+	return generatedSources(contract(_contractName), _runtime);
+}
+
+Json::Value const& CompilerStack::generatedSources(Contract const& _contract, bool _runtime) const
+{
 	util::LazyInit<Json::Value const> const& sources =
 		_runtime ?
-		c.runtimeGeneratedSources :
-		c.generatedSources;
+		_contract.runtimeGeneratedSources :
+		_contract.generatedSources;
 	return sources.init([&]{
 		Json::Value sources{Json::arrayValue};
 		// If there is no compiler, then no bytecode was generated and thus no
 		// sources were generated (or we compiled "via IR").
-		if (c.compiler)
+		if (_contract.compiler)
 		{
 			solAssert(!m_viaIR, "");
 			string source =
 				_runtime ?
-				c.compiler->runtimeGeneratedYulUtilityCode() :
-				c.compiler->generatedYulUtilityCode();
+				_contract.compiler->runtimeGeneratedYulUtilityCode() :
+				_contract.compiler->generatedYulUtilityCode();
 			if (!source.empty())
 			{
 				string sourceName = CompilerContext::yulUtilityFileName();
@@ -826,11 +1176,7 @@ string const* CompilerStack::sourceMapping(string const& _contractName) const
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	Contract const& c = contract(_contractName);
-	if (!c.sourceMapping)
-	{
-		if (auto items = assemblyItems(_contractName))
-			c.sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices()));
-	}
+	computeSourceMapping(c, false);
 	return c.sourceMapping ? &*c.sourceMapping : nullptr;
 }
 
@@ -840,16 +1186,18 @@ string const* CompilerStack::runtimeSourceMapping(string const& _contractName) c
 		solThrow(CompilerError, "Compilation was not successful.");
 
 	Contract const& c = contract(_contractName);
-	if (!c.runtimeSourceMapping)
-	{
-		if (auto items = runtimeAssemblyItems(_contractName))
-			c.runtimeSourceMapping.emplace(
-				evmasm::AssemblyItem::computeSourceMapping(*items, sourceIndices())
-			);
-	}
+	computeSourceMapping(c, true);
 	return c.runtimeSourceMapping ? &*c.runtimeSourceMapping : nullptr;
 }
 
+void CompilerStack::computeSourceMapping(Contract const& _contract, bool _runtime) const
+{
+	optional<string const>& sourceMapping = _runtime ? _contract.runtimeSourceMapping : _contract.sourceMapping;
+	shared_ptr<evmasm::Assembly> const& assembly = _runtime ? _contract.evmRuntimeAssembly : _contract.evmAssembly;
+	if (!sourceMapping && assembly)
+		sourceMapping.emplace(evmasm::AssemblyItem::computeSourceMapping(assembly->items(), sourceIndices()));
+}
+
 std::string const CompilerStack::filesystemFriendlyName(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -890,6 +1238,117 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	return contract(_contractName).yulIROptimized;
 }
 
+Json::Value CompilerStack::optimiserProfile(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Json::Value objects(Json::arrayValue);
+	for (yul::OptimiserProfile const& profile: contract(_contractName).optimiserProfiles)
+	{
+		Json::Value steps(Json::objectValue);
+		for (auto const& [step, statistics]: profile.steps)
+		{
+			Json::Value stepData(Json::objectValue);
+			stepData["runs"] = Json::UInt64(statistics.runs);
+			stepData["durationInMicroseconds"] = Json::Int64(statistics.durationInMicroseconds);
+			stepData["codeSizeBefore"] = Json::UInt64(statistics.codeSizeBefore);
+			stepData["codeSizeAfter"] = Json::UInt64(statistics.codeSizeAfter);
+			if (!statistics.counters.empty())
+			{
+				Json::Value counters(Json::objectValue);
+				for (auto const& [counter, value]: statistics.counters)
+					counters[counter] = Json::UInt64(value);
+				stepData["counters"] = std::move(counters);
+			}
+			steps[step] = std::move(stepData);
+		}
+
+		Json::Value object(Json::objectValue);
+		object["name"] = profile.objectName;
+		object["durationInMicroseconds"] = Json::Int64(profile.durationInMicroseconds);
+		object["codeSizeBefore"] = Json::UInt64(profile.codeSizeBefore);
+		object["codeSizeAfter"] = Json::UInt64(profile.codeSizeAfter);
+		object["repeatIterations"] = Json::UInt64(profile.repeatIterations);
+		object["timeBudgetExhausted"] = profile.timeBudgetExhausted;
+		object["steps"] = std::move(steps);
+		objects.append(std::move(object));
+	}
+	return objects;
+}
+
+Json::Value CompilerStack::assemblyOptimiserProfile(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Json::Value components(Json::objectValue);
+	for (auto const& [component, applications]: contract(_contractName).assemblyOptimiserStatistics)
+	{
+		Json::Value counters(Json::objectValue);
+		for (auto const& [optimisation, count]: applications)
+			counters[optimisation] = Json::UInt64(count);
+		components[component] = std::move(counters);
+	}
+	return components;
+}
+
+Json::Value CompilerStack::modelCheckerProfile(string const& _contractName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		solThrow(CompilerError, "Analysis was not successful.");
+
+	auto engineProfile = [](ModelCheckerEngineProfile const& _profile) {
+		Json::Value engine(Json::objectValue);
+		engine["encodingTimeInMicroseconds"] = Json::Int64(_profile.encodingTime.count());
+		engine["solverTimeInMicroseconds"] = Json::Int64(_profile.solverTime.count());
+		engine["queries"] = Json::UInt64(_profile.queries);
+		return engine;
+	};
+
+	Json::Value profile(Json::objectValue);
+	if (auto const& contractProfile = contract(_contractName).modelCheckerProfile)
+	{
+		if (contractProfile->bmc)
+			profile["bmc"] = engineProfile(*contractProfile->bmc);
+		if (contractProfile->chc)
+			profile["chc"] = engineProfile(*contractProfile->chc);
+	}
+	return profile;
+}
+
+vector<util::PhaseStatistics> const& CompilerStack::phaseStatistics(string const& _contractName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		solThrow(CompilerError, "Analysis was not successful.");
+
+	return contract(_contractName).phaseStatistics;
+}
+
+Json::Value CompilerStack::compilationStats(string const& _contractName) const
+{
+	auto toJson = [](vector<util::PhaseStatistics> const& _phases) {
+		Json::Value phases(Json::arrayValue);
+		for (util::PhaseStatistics const& phase: _phases)
+		{
+			Json::Value phaseData(Json::objectValue);
+			phaseData["name"] = phase.name;
+			phaseData["durationInMicroseconds"] = Json::Int64(phase.duration.count());
+			if (phase.peakMemoryInKiB)
+				phaseData["peakMemoryInKiB"] = Json::UInt64(*phase.peakMemoryInKiB);
+			if (phase.peakMemoryIncreaseInKiB)
+				phaseData["peakMemoryIncreaseInKiB"] = Json::UInt64(*phase.peakMemoryIncreaseInKiB);
+			phases.append(std::move(phaseData));
+		}
+		return phases;
+	};
+
+	Json::Value stats(Json::objectValue);
+	stats["sharedPhases"] = toJson(sharedPhaseStatistics());
+	stats["phases"] = toJson(phaseStatistics(_contractName));
+	return stats;
+}
+
 string const& CompilerStack::ewasm(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -993,6 +1452,16 @@ Json::Value const& CompilerStack::storageLayout(string const& _contractName) con
 	return storageLayout(contract(_contractName));
 }
 
+Json::Value CompilerStack::storagePackingAdvice(string const& _contractName) const
+{
+	if (m_stackState < AnalysisPerformed)
+		solThrow(CompilerError, "Analysis was not successful.");
+
+	Contract const& currentContract = contract(_contractName);
+	solAssert(currentContract.contract, "");
+	return StoragePackingAdvisor().generate(*currentContract.contract);
+}
+
 Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1039,6 +1508,54 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 	return _contract.devDocumentation.init([&]{ return Natspec::devDocumentation(*_contract.contract); });
 }
 
+void CompilerStack::generateArtifacts(map<string, ArtifactSelection> const& _artifacts) const
+{
+	if (m_stackState < AnalysisPerformed)
+		solThrow(CompilerError, "Analysis was not successful.");
+
+	// The ABI, the storage layout and the documentation create and query types, which belong
+	// to the TypeProvider of the calling thread and fill their caches on first use, so they are
+	// generated on this thread. The metadata contains the ABI and the documentation.
+	vector<Contract const*> metadataContracts;
+	set<string> metadataSources;
+	for (auto const& [name, selection]: _artifacts)
+	{
+		Contract const& contract = this->contract(name);
+		if (selection.abi || selection.metadata)
+			contractABI(contract);
+		if (selection.storageLayout)
+			storageLayout(contract);
+		if (selection.natspecUser || selection.metadata)
+			natspecUser(contract);
+		if (selection.natspecDev || selection.metadata)
+			natspecDev(contract);
+		if (selection.metadata)
+		{
+			metadataContracts.push_back(&contract);
+			set<string> const& referencedSources = m_sources.at(*contract.contract->sourceUnit().annotation().path).referencedSources();
+			metadataSources.insert(referencedSources.begin(), referencedSources.end());
+		}
+	}
+
+	// Hashing the sources and assembling the metadata only reads the sources, the settings and
+	// the artifacts above, so the sources and then the contracts are processed in parallel.
+	vector<Source const*> sources;
+	for (string const& path: metadataSources)
+		sources.push_back(&m_sources.at(path));
+	util::ThreadPool::instance().parallelFor(sources.size(), [&](size_t _index) {
+		Source const& source = *sources[_index];
+		source.keccak256();
+		if (!m_metadataLiteralSources)
+		{
+			source.swarmHash();
+			source.ipfsUrl();
+		}
+	});
+	util::ThreadPool::instance().parallelFor(metadataContracts.size(), [&](size_t _index) {
+		metadata(*metadataContracts[_index]);
+	});
+}
+
 Json::Value CompilerStack::interfaceSymbols(string const& _contractName) const
 {
 	if (m_stackState < AnalysisPerformed)
@@ -1132,23 +1649,36 @@ size_t CompilerStack::functionEntryPoint(
 
 h256 const& CompilerStack::Source::keccak256() const
 {
-	if (keccak256HashCached == h256{})
+	if (!keccak256HashCached)
 		keccak256HashCached = util::keccak256(charStream->source());
-	return keccak256HashCached;
+	return *keccak256HashCached;
 }
 
 h256 const& CompilerStack::Source::swarmHash() const
 {
-	if (swarmHashCached == h256{})
+	if (!swarmHashCached)
 		swarmHashCached = util::bzzr1Hash(charStream->source());
-	return swarmHashCached;
+	return *swarmHashCached;
 }
 
 string const& CompilerStack::Source::ipfsUrl() const
 {
-	if (ipfsUrlCached.empty())
+	if (!ipfsUrlCached)
 		ipfsUrlCached = "dweb:/ipfs/" + util::ipfsHashBase58(charStream->source());
-	return ipfsUrlCached;
+	return *ipfsUrlCached;
+}
+
+set<string> const& CompilerStack::Source::referencedSources() const
+{
+	if (!referencedSourcesCached)
+	{
+		solAssert(ast);
+		referencedSourcesCached.emplace();
+		referencedSourcesCached->insert(*ast->annotation().path);
+		for (auto const sourceUnit: ast->referencedSourceUnits(true))
+			referencedSourcesCached->insert(*sourceUnit->annotation().path);
+	}
+	return *referencedSourcesCached;
 }
 
 StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
@@ -1170,7 +1700,7 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast)
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources[importPath] = std::move(result.responseOrErrorMessage);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1267,8 +1797,14 @@ void CompilerStack::assemble(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
+	util::PhaseRecorder phase("assembly", phaseStatisticsTarget(compiledContract));
 	compiledContract.evmAssembly = _assembly;
 	solAssert(compiledContract.evmAssembly, "");
+	if (m_profileOptimiser)
+		for (evmasm::Assembly const* assembly: {_assembly.get(), _runtimeAssembly.get()})
+			for (auto const& [component, applications]: assembly->optimiserStatistics())
+				for (auto const& [optimisation, count]: applications)
+					compiledContract.assemblyOptimiserStatistics[component][optimisation] += count;
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -1291,6 +1827,7 @@ void CompilerStack::assemble(
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
+	phase.stop();
 
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
@@ -1331,18 +1868,32 @@ void CompilerStack::compileContract(
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::TraceSpan span("compileContract", "contract", {{"contract", _contract.fullyQualifiedName()}});
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		&m_yulUtilityCodeCache
+	);
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
+	util::PhaseRecorder metadataPhase("metadata", phaseStatisticsTarget(compiledContract));
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ false);
+	metadataPhase.stop();
 
 	try
 	{
 		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		compiler->compileContract(
+			_contract,
+			_otherCompilers,
+			cborEncodedMetadata,
+			phaseStatisticsTarget(compiledContract),
+			m_profileOptimiser
+		);
 	}
 	catch(evmasm::OptimizerException const&)
 	{
@@ -1379,10 +1930,15 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	if (!_contract.canBeDeployed())
 		return;
 
+	util::TraceSpan span("generateIR", "contract", {{"contract", _contract.fullyQualifiedName()}});
 	map<ContractDefinition const*, string_view const> otherYulSources;
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
+	util::PhaseRecorder metadataPhase("metadata", phaseStatisticsTarget(compiledContract));
+	bytes cborEncodedMetadata = createCBORMetadata(compiledContract, /* _forIR */ true);
+	metadataPhase.stop();
+
 	IRGenerator generator(
 		m_evmVersion,
 		m_eofVersion,
@@ -1394,9 +1950,15 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	);
 	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(
 		_contract,
-		createCBORMetadata(compiledContract, /* _forIR */ true),
-		otherYulSources
+		cborEncodedMetadata,
+		otherYulSources,
+		m_compilationCache.get(),
+		m_profileOptimiser ? &compiledContract.optimiserProfiles : nullptr,
+		&m_yulFunctionCache,
+		phaseStatisticsTarget(compiledContract)
 	);
+	if (generator.optimiserTimeBudgetExhausted())
+		reportOptimiserTimeBudgetExhausted(_contract);
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1413,6 +1975,7 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 	if (!compiledContract.object.bytecode.empty())
 		return;
 
+	util::TraceSpan span("generateEVMFromIR", "contract", {{"contract", _contract.fullyQualifiedName()}});
 	// Re-parse the Yul IR in EVM dialect
 	yul::YulStack stack(
 		m_evmVersion,
@@ -1421,17 +1984,39 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
+	stack.enableOptimiserProfiling(m_profileOptimiser);
+	stack.enablePhaseStatistics(m_recordPhaseStatistics);
 	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
 	stack.optimize();
+	compiledContract.optimiserProfiles += stack.optimiserProfiles();
+	if (stack.optimiserTimeBudgetExhausted())
+		reportOptimiserTimeBudgetExhausted(_contract);
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
 	string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
 	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
+	compiledContract.phaseStatistics += stack.phaseStatistics();
 	assemble(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
 }
 
+void CompilerStack::reportOptimiserTimeBudgetExhausted(ContractDefinition const& _contract)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	if (compiledContract.optimiserTimeBudgetExhausted)
+		return;
+	compiledContract.optimiserTimeBudgetExhausted = true;
+	m_errorReporter.warning(
+		4958_error,
+		_contract.location(),
+		"The Yul optimizer exceeded its time budget of " +
+		to_string(*m_optimiserSettings.yulOptimiserTimeBudget) +
+		" ms and skipped the remaining optimization steps. "
+		"The resulting bytecode depends on the speed of the machine and may not be reproducible."
+	);
+}
+
 void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1468,6 +2053,32 @@ void CompilerStack::generateEwasm(ContractDefinition const& _contract)
 	compiledContract.ewasmObject = std::move(*result.bytecode);
 }
 
+void CompilerStack::releaseIntermediates(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	if (!m_retainedIntermediates.yulIR)
+		string{}.swap(compiledContract.yulIR);
+	if (!m_retainedIntermediates.yulIROptimized)
+		string{}.swap(compiledContract.yulIROptimized);
+	if (!m_retainedIntermediates.evmAssembly)
+	{
+		for (bool runtime: {false, true})
+		{
+			if (m_retainedIntermediates.sourceMappings)
+				computeSourceMapping(compiledContract, runtime);
+			if (m_retainedIntermediates.generatedSources)
+				generatedSources(compiledContract, runtime);
+		}
+		compiledContract.compiler.reset();
+		compiledContract.evmAssembly.reset();
+		compiledContract.evmRuntimeAssembly.reset();
+		_otherCompilers.erase(&_contract);
+	}
+}
+
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1525,40 +2136,37 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 	meta["language"] = sourceType;
 	meta["compiler"]["version"] = VersionStringStrict;
 
-	/// All the source files (including self), which should be included in the metadata.
-	set<string> referencedSources;
-	referencedSources.insert(*_contract.contract->sourceUnit().annotation().path);
-	for (auto const sourceUnit: _contract.contract->sourceUnit().referencedSourceUnits(true))
-		referencedSources.insert(*sourceUnit->annotation().path);
-
 	meta["sources"] = Json::objectValue;
-	for (auto const& s: m_sources)
+	/// All the source files (including self), which should be included in the metadata.
+	for (string const& path: m_sources.at(*_contract.contract->sourceUnit().annotation().path).referencedSources())
 	{
-		if (!referencedSources.count(s.first))
-			continue;
-
-		solAssert(s.second.charStream, "Character stream not available");
-		meta["sources"][s.first]["keccak256"] = "0x" + util::toHex(s.second.keccak256().asBytes());
-		if (optional<string> licenseString = s.second.ast->licenseString())
-			meta["sources"][s.first]["license"] = *licenseString;
+		Source const& source = m_sources.at(path);
+		solAssert(source.charStream, "Character stream not available");
+		Json::Value& sourceMeta = meta["sources"][path];
+		sourceMeta["keccak256"] = "0x" + util::toHex(source.keccak256().asBytes());
+		if (optional<string> licenseString = source.ast->licenseString())
+			sourceMeta["license"] = *licenseString;
 		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.charStream->source();
+			sourceMeta["content"] = source.charStream->source();
 		else
 		{
-			meta["sources"][s.first]["urls"] = Json::arrayValue;
-			meta["sources"][s.first]["urls"].append("bzz-raw://" + util::toHex(s.second.swarmHash().asBytes()));
-			meta["sources"][s.first]["urls"].append(s.second.ipfsUrl());
+			sourceMeta["urls"] = Json::arrayValue;
+			sourceMeta["urls"].append("bzz-raw://" + util::toHex(source.swarmHash().asBytes()));
+			sourceMeta["urls"].append(source.ipfsUrl());
 		}
 	}
 
 	static_assert(sizeof(m_optimiserSettings.expectedExecutionsPerDeployment) <= sizeof(Json::LargestUInt), "Invalid word size.");
 	solAssert(static_cast<Json::LargestUInt>(m_optimiserSettings.expectedExecutionsPerDeployment) < std::numeric_limits<Json::LargestUInt>::max(), "");
 	meta["settings"]["optimizer"]["runs"] = Json::Value(Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment));
+	for (auto const& [selector, frequency]: m_optimiserSettings.callProfile)
+		meta["settings"]["optimizer"]["callProfile"][selector.hex()] = Json::Value(Json::LargestUInt(frequency));
 
 	/// Backwards compatibility: If set to one of the default settings, do not provide details.
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.callProfile.clear();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1574,12 +2182,21 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+		// Only listed if enabled to keep the metadata of existing settings unchanged.
+		if (m_optimiserSettings.runTailMerger)
+			details["tailMerger"] = true;
+		if (m_optimiserSettings.inlinerSizeLimit)
+			details["inlinerSizeLimit"] = Json::Value(Json::LargestUInt(*m_optimiserSettings.inlinerSizeLimit));
+		if (m_optimiserSettings.yulOptimiserTimeBudget)
+			details["timeBudget"] = Json::Value(Json::LargestUInt(*m_optimiserSettings.yulOptimiserTimeBudget));
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
 			details["yulDetails"] = Json::objectValue;
 			details["yulDetails"]["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
 			details["yulDetails"]["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps;
+			for (auto const& [function, executionCount]: m_optimiserSettings.yulInlinerProfile)
+				details["yulDetails"]["inlinerProfile"][function] = Json::Value(Json::LargestUInt(executionCount));
 		}
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
@@ -1600,6 +2217,8 @@ string CompilerStack::createMetadata(Contract const& _contract, bool _forIR) con
 	if (_forIR)
 		meta["settings"]["viaIR"] = _forIR;
 	meta["settings"]["evmVersion"] = m_evmVersion.name();
+	if (m_deduplicateSources)
+		meta["settings"]["deduplicateSources"] = true;
 	if (m_eofVersion.has_value())
 		meta["settings"]["eofVersion"] = *m_eofVersion;
 	meta["settings"]["compilationTarget"][_contract.contract->sourceUnitName()] =
@@ -1754,7 +2373,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
-Json::Value CompilerStack::gasEstimates(string const& _contractName) const
+Json::Value CompilerStack::gasEstimates(string const& _contractName, optional<size_t> _maxPaths) const
 {
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
@@ -1763,7 +2382,7 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 		return Json::Value();
 
 	using Gas = GasEstimator::GasConsumption;
-	GasEstimator gasEstimator(m_evmVersion);
+	GasEstimator gasEstimator(m_evmVersion, _maxPaths);
 	Json::Value output(Json::objectValue);
 
 	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
@@ -1782,46 +2401,62 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 
 	if (evmasm::AssemblyItems const* items = runtimeAssemblyItems(_contractName))
 	{
-		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
-		Json::Value externalFunctions(Json::objectValue);
+
+		// The functions are estimated independently of each other in parallel,
+		// sharing the positions of the tags in the runtime code. The types of the parameters
+		// already cached their stack sizes during code generation, so they are only read here.
+		auto const tagPositions = evmasm::PathGasMeter::tagPositions(*items);
+
+		/// External functions, by their name in the output and the signature used for the estimation
+		vector<pair<string, string>> externalSignatures;
 		for (auto it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			externalSignatures.emplace_back(sig, sig);
 		}
-
 		if (contract.fallbackFunction())
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
+			externalSignatures.emplace_back("", "INVALID");
+
+		/// Internal functions
+		/// Exclude externally visible functions, constructor, fallback and receive ether function
+		vector<pair<FunctionDefinition const*, size_t>> internalFunctionEntries;
+		for (auto const& it: contract.definedFunctions())
+			if (!it->isPartOfExternalInterface() && it->isOrdinary())
+				internalFunctionEntries.emplace_back(it, functionEntryPoint(_contractName, *it));
+
+		vector<Gas> gas(externalSignatures.size() + internalFunctionEntries.size(), Gas::infinite());
+		util::ThreadPool::instance().parallelFor(gas.size(), [&](size_t _index) {
+			if (_index < externalSignatures.size())
+				gas[_index] = gasEstimator.functionalEstimation(*items, externalSignatures[_index].second, tagPositions);
+			else if (auto const& [function, entry] = internalFunctionEntries[_index - externalSignatures.size()]; entry > 0)
+				gas[_index] = gasEstimator.functionalEstimation(*items, entry, *function, tagPositions);
+		});
+
+		Json::Value externalFunctions(Json::objectValue);
+		for (size_t i = 0; i < externalSignatures.size(); ++i)
+			externalFunctions[externalSignatures[i].first] = gasToJson(gas[i]);
 
 		if (!externalFunctions.empty())
 			output["external"] = externalFunctions;
 
-		/// Internal functions
 		Json::Value internalFunctions(Json::objectValue);
-		for (auto const& it: contract.definedFunctions())
+		for (size_t i = 0; i < internalFunctionEntries.size(); ++i)
 		{
-			/// Exclude externally visible functions, constructor, fallback and receive ether function
-			if (it->isPartOfExternalInterface() || !it->isOrdinary())
-				continue;
-
-			size_t entry = functionEntryPoint(_contractName, *it);
-			GasEstimator::GasConsumption gas = GasEstimator::GasConsumption::infinite();
-			if (entry > 0)
-				gas = gasEstimator.functionalEstimation(*items, entry, *it);
+			FunctionDefinition const& function = *internalFunctionEntries[i].first;
 
 			/// TODO: This could move into a method shared with externalSignature()
-			FunctionType type(*it);
-			string sig = it->name() + "(";
+			FunctionType type(function);
+			string sig = function.name() + "(";
 			auto paramTypes = type.parameterTypes();
 			for (auto it = paramTypes.begin(); it != paramTypes.end(); ++it)
 				sig += (*it)->toString() + (it + 1 == paramTypes.end() ? "" : ",");
 			sig += ")";
 
-			internalFunctions[sig] = gasToJson(gas);
+			internalFunctions[sig] = gasToJson(gas[externalSignatures.size() + i]);
 		}
 
 		if (!internalFunctions.empty())
@@ -1830,3 +2465,52 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 
 	return output;
 }
+
+Json::Value CompilerStack::gasMap(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	GasEstimator gasEstimator(m_evmVersion);
+	map<string, unsigned> const indices = sourceIndices();
+	auto costsToJson = [&](evmasm::AssemblyItems const& _items, evmasm::LinkerObject const& _object) {
+		auto costMap = gasEstimator.staticCostMap(
+			_items,
+			_object.functionDebugData,
+			numberEncodingSize(_object.bytecode.size())
+		);
+		auto toJson = [](GasEstimator::StaticCosts const& _costs, Json::Value& _output) {
+			_output["gas"] = Json::Value(static_cast<Json::UInt64>(_costs.gas));
+			_output["bytes"] = Json::Value(static_cast<Json::UInt64>(_costs.bytes));
+		};
+
+		Json::Value sourceRanges(Json::arrayValue);
+		for (auto const& [location, costs]: costMap.sourceLocations)
+		{
+			Json::Value range(Json::objectValue);
+			range["start"] = location.start;
+			range["length"] = location.start >= 0 && location.end >= location.start ? location.end - location.start : -1;
+			range["source"] =
+				location.sourceName && indices.count(*location.sourceName) ?
+				Json::Value(indices.at(*location.sourceName)) :
+				Json::Value(-1);
+			toJson(costs, range);
+			sourceRanges.append(std::move(range));
+		}
+		Json::Value functions(Json::objectValue);
+		for (auto const& [name, costs]: costMap.functions)
+			toJson(costs, functions[name]);
+
+		Json::Value output(Json::objectValue);
+		output["sourceRanges"] = std::move(sourceRanges);
+		output["functions"] = std::move(functions);
+		return output;
+	};
+
+	Json::Value output(Json::objectValue);
+	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
+		output["creation"] = costsToJson(*items, object(_contractName));
+	if (evmasm::AssemblyItems const* items = runtimeAssemblyItems(_contractName))
+		output["runtime"] = costsToJson(*items, runtimeObject(_contractName));
+	return output;
+}
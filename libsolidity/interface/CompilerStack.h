@@ -25,12 +25,15 @@
 #pragma once
 
 #include <libsolidity/analysis/FunctionCallGraph.h>
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+#include <libsolidity/codegen/YulUtilityCodeCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/interface/DebugSettings.h>
 
+#include <libsolidity/formal/ModelCheckerProfile.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 
 #include <libsmtutil/SolverInterface.h>
@@ -43,14 +46,18 @@
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libyul/optimiser/Suite.h>
+
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
+#include <libsolutil/PhaseStatistics.h>
 
 #include <json/json.h>
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -81,6 +88,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class CompilationCache;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -150,7 +158,7 @@ public:
 	void setRemappings(std::vector<ImportRemapper::Remapping> _remappings);
 
 	/// Sets library addresses. Addresses are cleared iff @a _libraries is missing.
-	/// Must be set before parsing.
+	/// Must be set before compiling.
 	void setLibraries(std::map<std::string, util::h160> const& _libraries = {});
 
 	/// Changes the optimiser settings.
@@ -172,6 +180,24 @@ public:
 		m_parserErrorRecovery = _wantErrorRecovery;
 	}
 
+	/// Sets whether sources that are neither requested (see setRequestedContractNames) nor
+	/// imported by a requested source, directly or indirectly, are skipped. Skipped sources are
+	/// not parsed or analysed and are removed from the stack. Only applies if imports are resolved.
+	/// Must be set before parsing.
+	void setSkipUnreferencedSources(bool _skipUnreferencedSources = false)
+	{
+		m_skipUnreferencedSources = _skipUnreferencedSources;
+	}
+
+	/// Sets whether imports of a source that is a byte-identical copy of another source, with
+	/// imports that refer to copies as well, are redirected to the copy with the smallest name.
+	/// Copies that are then no longer imported are skipped together with the other unreferenced
+	/// sources. Must be set before parsing.
+	void setDeduplicateSources(bool _deduplicateSources = false)
+	{
+		m_deduplicateSources = _deduplicateSources;
+	}
+
 	/// Sets the pipeline to go through the Yul IR or not.
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
@@ -206,6 +232,34 @@ public:
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Selection of the intermediate results of the code generation that are kept after a
+	/// contract has been compiled.
+	struct IntermediateSelection
+	{
+		bool yulIR = true;
+		bool yulIROptimized = true;
+		/// EVM assemblies and the compiler of the legacy code generator, needed for the assembly
+		/// outputs and the gas estimates.
+		bool evmAssembly = true;
+		/// Source mappings and generated sources are derived from the assemblies. If selected,
+		/// they are computed before the assemblies are released.
+		bool sourceMappings = true;
+		bool generatedSources = true;
+	};
+
+	/// Selects the intermediate results that are kept. The others are released as soon as no
+	/// contract compiled later needs them, which reduces the peak memory usage of large
+	/// compilations. Outputs derived from released results are empty. By default, all are kept.
+	/// Must be set before compiling.
+	void retainIntermediates(IntermediateSelection _selection) { m_retainedIntermediates = _selection; }
+
+	/// Enable recording of execution statistics of the Yul optimizer steps run on the IR of each contract.
+	void enableOptimiserProfiling(bool _enable = true) { m_profileOptimiser = _enable; }
+
+	/// Enable recording of the wall time and memory usage of the compilation phases.
+	/// Must be set before parsing.
+	void enablePhaseStatistics(bool _enable = true) { m_recordPhaseStatistics = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -218,6 +272,11 @@ public:
 	/// Select components of debug info that should be included in comments in generated assembly.
 	void selectDebugInfo(langutil::DebugInfoSelection _debugInfoSelection);
 
+	/// Sets a cache used to skip the Yul optimizer for IR that was already optimized
+	/// with identical settings, possibly by an earlier compiler run.
+	/// Passing nullptr disables caching.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache) { m_compilationCache = std::move(_cache); }
+
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
@@ -246,6 +305,12 @@ public:
 	/// @returns false on error.
 	bool compile(State _stopAfter = State::CompilationSuccessful);
 
+	/// Discards the results of code generation and returns to the AnalysisPerformed state,
+	/// keeping the parsed and analysed sources. This allows generating code for the same
+	/// sources again with different libraries or output selection without re-running the analysis.
+	/// Errors reported during code generation are discarded as well.
+	void resetCodeGeneration();
+
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
 
@@ -282,6 +347,39 @@ public:
 	/// @returns the optimized IR representation of a contract.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
+	/// @returns a JSON representing the execution statistics of the Yul optimizer steps
+	/// run on the IR of the contract, one entry per optimized Yul object.
+	/// Empty unless optimizer profiling was enabled and the IR was optimized.
+	/// Prerequisite: Successful compilation.
+	Json::Value optimiserProfile(std::string const& _contractName) const;
+
+	/// @returns a JSON representing the number of applications of the optimisations of the
+	/// EVM assembly optimizer to the creation and the deployed code of the contract, indexed by
+	/// the optimizer component and the name of the optimisation.
+	/// Empty unless optimizer profiling was enabled.
+	/// Prerequisite: Successful compilation.
+	Json::Value assemblyOptimiserProfile(std::string const& _contractName) const;
+
+	/// @returns a JSON representing the time the SMTChecker engines spent on the contract
+	/// and the number of solver queries they made, one entry per engine that analyzed it.
+	/// Prerequisite: Successful call to parse or compile.
+	Json::Value modelCheckerProfile(std::string const& _contractName) const;
+
+	/// @returns the phases that are shared by all contracts, i.e. parsing and the analysis passes,
+	/// in the order in which they ran. Empty unless phase statistics were enabled.
+	std::vector<util::PhaseStatistics> const& sharedPhaseStatistics() const { return m_phaseStatistics; }
+
+	/// @returns the code generation, optimization, assembly and metadata phases run for the contract,
+	/// in the order in which they ran. A phase can appear more than once, e.g. the Yul optimizer
+	/// also runs on the optimized IR before EVM code is generated from it.
+	/// Empty unless phase statistics were enabled.
+	/// Prerequisite: Successful call to parse or compile.
+	std::vector<util::PhaseStatistics> const& phaseStatistics(std::string const& _contractName) const;
+
+	/// @returns a JSON representing the shared phases and the phases of the contract.
+	/// Prerequisite: Successful call to parse or compile.
+	Json::Value compilationStats(std::string const& _contractName) const;
+
 	/// @returns the Ewasm text representation of a contract.
 	std::string const& ewasm(std::string const& _contractName) const;
 
@@ -330,6 +428,11 @@ public:
 	/// Prerequisite: Successful call to parse or compile.
 	Json::Value const& storageLayout(std::string const& _contractName) const;
 
+	/// @returns a JSON representing declaration orders of the state variables and struct members
+	/// of the contract that need fewer storage slots (see StoragePackingAdvisor).
+	/// Prerequisite: Successful call to parse or compile.
+	Json::Value storagePackingAdvice(std::string const& _contractName) const;
+
 	/// @returns a JSON representing the contract's user documentation.
 	/// Prerequisite: Successful call to parse or compile.
 	Json::Value const& natspecUser(std::string const& _contractName) const;
@@ -338,6 +441,23 @@ public:
 	/// Prerequisite: Successful call to parse or compile.
 	Json::Value const& natspecDev(std::string const& _contractName) const;
 
+	/// Selection of the artifacts of a contract that are computed by @a generateArtifacts.
+	struct ArtifactSelection
+	{
+		bool abi = false;
+		bool storageLayout = false;
+		bool natspecUser = false;
+		bool natspecDev = false;
+		bool metadata = false;
+	};
+
+	/// Computes the selected ABI, storage layout, documentation and metadata of the given contracts
+	/// at once, using the thread pool where possible. The results are cached and returned by
+	/// the corresponding functions, which compute any missing artifact on demand as before.
+	/// @param _artifacts maps fully qualified contract names to the artifacts to compute.
+	/// Prerequisite: Successful call to parse or compile.
+	void generateArtifacts(std::map<std::string, ArtifactSelection> const& _artifacts) const;
+
 	/// @returns a JSON object with the three members ``methods``, ``events``, ``errors``. Each is a map, mapping identifiers (hashes) to function names.
 	Json::Value interfaceSymbols(std::string const& _contractName) const;
 
@@ -353,7 +473,13 @@ public:
 	bytes cborMetadata(std::string const& _contractName, bool _forIR) const;
 
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
-	Json::Value gasEstimates(std::string const& _contractName) const;
+	/// @param _maxPaths the maximal number of code paths explored per estimate, after which the
+	/// estimate is reported as infinite.
+	Json::Value gasEstimates(std::string const& _contractName, std::optional<size_t> _maxPaths = std::nullopt) const;
+
+	/// @returns a JSON representing the static gas costs and the sizes of the creation and the
+	/// runtime code, added up per source range and per function (see GasEstimator::staticCostMap).
+	Json::Value gasMap(std::string const& _contractName) const;
 
 	/// Changes the format of the metadata appended at the end of the bytecode.
 	void setMetadataFormat(MetadataFormat _metadataFormat) { m_metadataFormat = _metadataFormat; }
@@ -369,13 +495,17 @@ private:
 	{
 		std::shared_ptr<langutil::CharStream> charStream;
 		std::shared_ptr<SourceUnit> ast;
-		util::h256 mutable keccak256HashCached;
-		util::h256 mutable swarmHashCached;
-		std::string mutable ipfsUrlCached;
+		/// Hashes and imports of the source, computed on first use and shared by the metadata of all contracts.
+		std::optional<util::h256> mutable keccak256HashCached;
+		std::optional<util::h256> mutable swarmHashCached;
+		std::optional<std::string> mutable ipfsUrlCached;
+		std::optional<std::set<std::string>> mutable referencedSourcesCached;
 		void reset() { *this = Source(); }
 		util::h256 const& keccak256() const;
 		util::h256 const& swarmHash() const;
 		std::string const& ipfsUrl() const;
+		/// @returns the paths of this source and all the sources it imports, directly or indirectly.
+		std::set<std::string> const& referencedSources() const;
 	};
 
 	/// The state per contract. Filled gradually during compilation.
@@ -389,6 +519,12 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
 		std::string yulIROptimized; ///< Optimized Yul IR code.
+		std::vector<yul::OptimiserProfile> optimiserProfiles; ///< Recorded only if optimizer profiling is enabled.
+		bool optimiserTimeBudgetExhausted = false; ///< Whether the Yul optimizer skipped steps due to its time budget.
+		/// Recorded only if optimizer profiling is enabled.
+		std::map<std::string, std::map<std::string, size_t>> assemblyOptimiserStatistics;
+		std::optional<ModelCheckerProfile> modelCheckerProfile; ///< Set if the SMTChecker analyzed the contract.
+		std::vector<util::PhaseStatistics> phaseStatistics; ///< Recorded only if phase statistics are enabled.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -412,6 +548,10 @@ private:
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Redirects all imports of sources that are duplicates of other sources to the duplicate
+	/// with the smallest name.
+	void redirectImportsOfDuplicateSources();
+
 	/// Store the contract definitions in m_contracts.
 	void storeContractDefinitions();
 
@@ -437,6 +577,14 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Runs all requested code generation stages (IR, EVM bytecode, Ewasm) for a single contract
+	/// and its dependencies. Code generation errors are reported to the error reporter.
+	/// @returns false if code generation failed.
+	bool compileRequestedContract(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -445,10 +593,21 @@ private:
 	/// Depends on output generated by generateIR.
 	void generateEVMFromIR(ContractDefinition const& _contract);
 
+	/// Records that the Yul optimizer ran out of its time budget while optimizing the code of
+	/// @a _contract and warns about it, once per contract.
+	void reportOptimiserTimeBudgetExhausted(ContractDefinition const& _contract);
+
 	/// Generate Ewasm representation for a single contract.
 	/// Depends on output generated by generateIR.
 	void generateEwasm(ContractDefinition const& _contract);
 
+	/// Releases the intermediate results of a compiled contract that are not selected by
+	/// retainIntermediates. The contract must not be needed by any contract compiled later.
+	void releaseIntermediates(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
 	void link();
@@ -457,6 +616,23 @@ private:
 	/// Can only be called after state is CompilationSuccessful.
 	Contract const& contract(std::string const& _contractName) const;
 
+	/// @returns the generated sources of @a _contract, which are computed on first use.
+	Json::Value const& generatedSources(Contract const& _contract, bool _runtime) const;
+
+	/// Computes the source mapping of @a _contract on first use if it has an assembly.
+	void computeSourceMapping(Contract const& _contract, bool _runtime) const;
+
+	/// @returns the list the shared phases or the phases of @a _contract are appended to,
+	/// or nullptr if phase statistics are disabled.
+	std::vector<util::PhaseStatistics>* phaseStatisticsTarget()
+	{
+		return m_recordPhaseStatistics ? &m_phaseStatistics : nullptr;
+	}
+	std::vector<util::PhaseStatistics>* phaseStatisticsTarget(Contract& _contract) const
+	{
+		return m_recordPhaseStatistics ? &_contract.phaseStatistics : nullptr;
+	}
+
 	/// @returns the source object for the given @a _sourceName.
 	/// Can only be called after state is SourcesSet.
 	Source const& source(std::string const& _sourceName) const;
@@ -508,6 +684,11 @@ private:
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
 	bool m_generateEwasm = false;
+	IntermediateSelection m_retainedIntermediates;
+	bool m_profileOptimiser = false;
+	bool m_recordPhaseStatistics = false;
+	/// Phases shared by all contracts.
+	std::vector<util::PhaseStatistics> m_phaseStatistics;
 	std::map<std::string, util::h160> m_libraries;
 	ImportRemapper m_importRemapper;
 	std::map<std::string const, Source> m_sources;
@@ -521,10 +702,19 @@ private:
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
+	/// Number of errors and warnings reported up to the end of the analysis.
+	size_t m_analysisErrorCount = 0;
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	langutil::DebugInfoSelection m_debugInfoSelection = langutil::DebugInfoSelection::Default();
+	std::shared_ptr<CompilationCache> m_compilationCache;
+	/// Utility functions generated for the IR, shared between all contracts.
+	MultiUseYulFunctionCache m_yulFunctionCache;
+	/// Utility code of the legacy code generator, shared between all contracts.
+	YulUtilityCodeCache m_yulUtilityCodeCache;
 	bool m_parserErrorRecovery = false;
+	bool m_skipUnreferencedSources = false;
+	bool m_deduplicateSources = false;
 	State m_stackState = Empty;
 	CompilationSourceType m_compilationSourceType = CompilationSourceType::Solidity;
 	/// Whether or not there has been an error during processing.
@@ -69,6 +69,7 @@ void FileReader::setBasePath(boost::filesystem::path const& _path)
 	}
 	else
 		m_basePath = normalizeCLIPathForVFS(_path);
+	m_resolvedAllowedDirectories.reset();
 }
 
 void FileReader::addIncludePath(boost::filesystem::path const& _path)
@@ -76,12 +77,14 @@ void FileReader::addIncludePath(boost::filesystem::path const& _path)
 	solAssert(!m_basePath.empty(), "");
 	solAssert(!_path.empty(), "");
 	m_includePaths.push_back(normalizeCLIPathForVFS(_path));
+	m_resolvedAllowedDirectories.reset();
 }
 
 void FileReader::allowDirectory(boost::filesystem::path _path)
 {
 	solAssert(!_path.empty(), "");
 	m_allowedDirectories.insert(std::move(_path));
+	m_resolvedAllowedDirectories.reset();
 }
 
 void FileReader::addOrUpdateFile(boost::filesystem::path const& _path, SourceCode _source)
@@ -144,9 +147,18 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 			decltype(allowedPaths){m_basePath.empty() ? "." : m_basePath} +
 			m_includePaths;
 
+		// Resolving the symlinks in the allowed directories needs several filesystem queries
+		// per directory, so it is only done once for all files that are read.
+		if (!m_resolvedAllowedDirectories)
+		{
+			m_resolvedAllowedDirectories.emplace();
+			for (boost::filesystem::path const& allowedDir: allowedPaths)
+				m_resolvedAllowedDirectories->push_back(normalizeCLIPathForVFS(allowedDir, SymlinkResolution::Enabled));
+		}
+
 		bool isAllowed = false;
-		for (boost::filesystem::path const& allowedDir: allowedPaths)
-			if (isPathPrefix(normalizeCLIPathForVFS(allowedDir, SymlinkResolution::Enabled), candidates[0]))
+		for (boost::filesystem::path const& allowedDir: *m_resolvedAllowedDirectories)
+			if (isPathPrefix(allowedDir, candidates[0]))
 			{
 				isAllowed = true;
 				break;
@@ -167,7 +179,7 @@ ReadCallback::Result FileReader::readFile(string const& _kind, string const& _so
 		auto contents = readFileAsString(candidates[0]);
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, contents};
+		return ReadCallback::Result{true, std::move(contents)};
 	}
 	catch (util::Exception const& _exception)
 	{
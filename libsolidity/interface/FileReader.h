@@ -23,6 +23,7 @@
 #include <boost/filesystem.hpp>
 
 #include <map>
+#include <optional>
 #include <set>
 
 namespace solidity::frontend
@@ -164,6 +165,10 @@ private:
 	/// list of allowed directories to read files from
 	FileSystemPathSet m_allowedDirectories;
 
+	/// Allowed directories, base path and include paths with symlinks resolved.
+	/// Computed on first use and reset whenever one of them changes.
+	std::optional<std::vector<boost::filesystem::path>> m_resolvedAllowedDirectories;
+
 	/// map of input files to source code strings
 	StringMap m_sourceCodes;
 };
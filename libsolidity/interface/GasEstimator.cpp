@@ -45,7 +45,8 @@ using namespace solidity::langutil;
 
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	AssemblyItems const& _items,
-	string const& _signature
+	string const& _signature,
+	shared_ptr<TagPositions const> _tagPositions
 ) const
 {
 	auto state = make_shared<KnownState>();
@@ -79,13 +80,14 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state, std::move(_tagPositions), m_maxPaths);
 }
 
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	AssemblyItems const& _items,
 	size_t const& _offset,
-	FunctionDefinition const& _function
+	FunctionDefinition const& _function,
+	shared_ptr<TagPositions const> _tagPositions
 ) const
 {
 	auto state = make_shared<KnownState>();
@@ -101,7 +103,43 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state, std::move(_tagPositions), m_maxPaths);
+}
+
+GasEstimator::StaticCostMap GasEstimator::staticCostMap(
+	AssemblyItems const& _items,
+	map<string, LinkerObject::FunctionDebugData> const& _functionDebugData,
+	size_t _addressLength
+) const
+{
+	// Names of the functions by the index of their entry point among the items.
+	map<size_t, string> functionEntries;
+	for (auto const& [name, data]: _functionDebugData)
+		if (data.instructionIndex)
+			functionEntries[*data.instructionIndex] = name;
+
+	StaticCostMap costMap;
+	string const* function = nullptr;
+	for (size_t index = 0; index < _items.size(); ++index)
+	{
+		if (auto entry = functionEntries.find(index); entry != functionEntries.end())
+			function = &entry->second;
+
+		AssemblyItem const& item = _items[index];
+		unsigned gas = GasMeter::staticGas(item, m_evmVersion);
+		size_t bytes = item.bytesRequired(_addressLength, Precision::Precise);
+
+		StaticCosts& locationCosts = costMap.sourceLocations[item.location()];
+		locationCosts.gas += gas;
+		locationCosts.bytes += bytes;
+		if (function)
+		{
+			StaticCosts& functionCosts = costMap.functions[*function];
+			functionCosts.gas += gas;
+			functionCosts.bytes += bytes;
+		}
+	}
+	return costMap;
 }
 
 set<ASTNode const*> GasEstimator::finestNodesAtLocation(
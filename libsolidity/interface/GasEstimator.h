@@ -27,9 +27,12 @@
 
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/PathGasMeter.h>
 
 #include <array>
 #include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace solidity::frontend
@@ -46,28 +49,63 @@ public:
 	using ASTGasConsumptionSelfAccumulated =
 		std::map<ASTNode const*, std::array<GasConsumption, 2>>;
 
-	explicit GasEstimator(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+	using TagPositions = evmasm::PathGasMeter::TagPositions;
+
+	/// @param _maxPaths the maximal number of paths explored per estimation, after which
+	/// the gas consumption is reported as infinite.
+	explicit GasEstimator(langutil::EVMVersion _evmVersion, std::optional<size_t> _maxPaths = std::nullopt):
+		m_evmVersion(_evmVersion),
+		m_maxPaths(_maxPaths)
+	{}
 
 	/// @returns the estimated gas consumption by the (public or external) function with the
 	/// given signature. If no signature is given, estimates the maximum gas usage.
+	/// @param _tagPositions the positions of the tags in @a _items, if already known.
 	GasConsumption functionalEstimation(
 		evmasm::AssemblyItems const& _items,
-		std::string const& _signature = ""
+		std::string const& _signature = "",
+		std::shared_ptr<TagPositions const> _tagPositions = nullptr
 	) const;
 
 	/// @returns the estimated gas consumption by the given function which starts at the given
 	/// offset into the list of assembly items.
+	/// @param _tagPositions the positions of the tags in @a _items, if already known.
 	/// @note this does not work correctly for recursive functions.
 	GasConsumption functionalEstimation(
 		evmasm::AssemblyItems const& _items,
 		size_t const& _offset,
-		FunctionDefinition const& _function
+		FunctionDefinition const& _function,
+		std::shared_ptr<TagPositions const> _tagPositions = nullptr
+	) const;
+
+	/// Static gas costs and size in bytes of a part of the code.
+	struct StaticCosts
+	{
+		u256 gas;
+		size_t bytes = 0;
+	};
+	struct StaticCostMap
+	{
+		std::map<langutil::SourceLocation, StaticCosts> sourceLocations;
+		std::map<std::string, StaticCosts> functions;
+	};
+
+	/// @returns the static gas costs (see GasMeter::staticGas) and the sizes of @a _items, added
+	/// up per source location and per function in @a _functionDebugData. Items are attributed to
+	/// the function whose entry point is the closest one before them. Items before the first entry
+	/// point, like the dispatcher, do not belong to any function.
+	/// @param _addressLength the number of bytes used to push tags and data offsets.
+	StaticCostMap staticCostMap(
+		evmasm::AssemblyItems const& _items,
+		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _functionDebugData,
+		size_t _addressLength
 	) const;
 
 private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
+	std::optional<size_t> m_maxPaths;
 };
 
 }
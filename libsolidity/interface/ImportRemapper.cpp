@@ -36,11 +36,28 @@ void ImportRemapper::setRemappings(vector<Remapping> _remappings)
 	for (auto const& remapping: _remappings)
 		solAssert(!remapping.prefix.empty(), "");
 	m_remappings = std::move(_remappings);
+
+	m_sanitizedRemappings.clear();
+	m_prefixTrie.assign(1, PrefixNode{});
+	for (size_t index = 0; index < m_remappings.size(); ++index)
+	{
+		Remapping const& remapping = m_remappings[index];
+		m_sanitizedRemappings.push_back({util::sanitizePath(remapping.context), util::sanitizePath(remapping.target)});
+
+		size_t node = 0;
+		for (char c: util::sanitizePath(remapping.prefix))
+		{
+			auto [it, inserted] = m_prefixTrie[node].children.try_emplace(c, m_prefixTrie.size());
+			if (inserted)
+				m_prefixTrie.emplace_back();
+			node = it->second;
+		}
+		m_prefixTrie[node].remappings.push_back(index);
+	}
 }
 
 SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _context) const
 {
-	// Try to find the longest prefix match in all remappings that are active in the current context.
 	auto isPrefixOf = [](string const& _a, string const& _b)
 	{
 		if (_a.length() > _b.length())
@@ -48,33 +65,35 @@ SourceUnitName ImportRemapper::apply(ImportPath const& _path, string const& _con
 		return equal(_a.begin(), _a.end(), _b.begin());
 	};
 
+	// Walk the prefix trie along the path. The remappings are visited ordered by the length
+	// of their prefix and then by their position, so that of the remappings with the longest
+	// context, the one with the longest prefix that was given last wins.
 	size_t longestPrefix = 0;
 	size_t longestContext = 0;
-	string bestMatchTarget;
+	SanitizedRemapping const* bestMatch = nullptr;
 
-	for (auto const& redir: m_remappings)
+	size_t node = 0;
+	for (size_t prefixLength = 0; ; ++prefixLength)
 	{
-		string context = util::sanitizePath(redir.context);
-		string prefix = util::sanitizePath(redir.prefix);
-
-		// Skip if current context is closer
-		if (context.length() < longestContext)
-			continue;
-		// Skip if redir.context is not a prefix of _context
-		if (!isPrefixOf(context, _context))
-			continue;
-		// Skip if we already have a closer prefix match.
-		if (prefix.length() < longestPrefix && context.length() == longestContext)
-			continue;
-		// Skip if the prefix does not match.
-		if (!isPrefixOf(prefix, _path))
-			continue;
-
-		longestContext = context.length();
-		longestPrefix = prefix.length();
-		bestMatchTarget = util::sanitizePath(redir.target);
+		for (size_t index: m_prefixTrie[node].remappings)
+		{
+			SanitizedRemapping const& remapping = m_sanitizedRemappings[index];
+			if (remapping.context.length() < longestContext || !isPrefixOf(remapping.context, _context))
+				continue;
+			longestContext = remapping.context.length();
+			longestPrefix = prefixLength;
+			bestMatch = &remapping;
+		}
+
+		if (prefixLength == _path.size())
+			break;
+		auto child = m_prefixTrie[node].children.find(_path[prefixLength]);
+		if (child == m_prefixTrie[node].children.end())
+			break;
+		node = child->second;
 	}
-	string path = bestMatchTarget;
+
+	string path = bestMatch ? bestMatch->target : string{};
 	path.append(_path.begin() + static_cast<string::difference_type>(longestPrefix), _path.end());
 	return path;
 }
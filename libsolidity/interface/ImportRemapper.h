@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <map>
 #include <optional>
 #include <string>
 #include <vector>
@@ -49,11 +50,14 @@ public:
 		std::string target;
 	};
 
-	void clear() { m_remappings.clear(); }
+	void clear() { setRemappings({}); }
 
 	void setRemappings(std::vector<Remapping> _remappings);
 	std::vector<Remapping> const& remappings() const noexcept { return m_remappings; }
 
+	/// @returns @a _path with the longest matching prefix replaced by the target of its remapping.
+	/// Remappings with a longer context that is a prefix of @a _context take precedence,
+	/// and of otherwise equal remappings the one given last is used.
 	SourceUnitName apply(ImportPath const& _path, std::string const& _context) const;
 
 	/// @returns true if the string can be parsed as a remapping
@@ -66,6 +70,23 @@ private:
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
 	std::vector<Remapping> m_remappings = {};
+
+	/// Remapping with sanitized context and target, in the order of @a m_remappings.
+	struct SanitizedRemapping
+	{
+		std::string context;
+		std::string target;
+	};
+	std::vector<SanitizedRemapping> m_sanitizedRemappings;
+
+	/// Node of a trie over the sanitized prefixes of all remappings. The root is the first node.
+	struct PrefixNode
+	{
+		std::map<char, size_t> children;
+		/// Indices of the remappings whose prefix ends at this node, in ascending order.
+		std::vector<size_t> remappings;
+	};
+	std::vector<PrefixNode> m_prefixTrie = std::vector<PrefixNode>(1);
 };
 
 }
@@ -25,7 +25,11 @@
 
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/FixedHash.h>
+
 #include <cstddef>
+#include <map>
+#include <optional>
 #include <string>
 
 namespace solidity::frontend
@@ -117,10 +121,15 @@ struct OptimiserSettings
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			runTailMerger == _other.runTailMerger &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
 			yulOptimiserSteps == _other.yulOptimiserSteps &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			yulInlinerProfile == _other.yulInlinerProfile &&
+			yulOptimiserTimeBudget == _other.yulOptimiserTimeBudget &&
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			callProfile == _other.callProfile &&
+			inlinerSizeLimit == _other.inlinerSizeLimit;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -139,6 +148,8 @@ struct OptimiserSettings
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Merger of common code at the end of paths that terminate in revert or return.
+	bool runTailMerger = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
@@ -152,9 +163,25 @@ struct OptimiserSettings
 	/// is left empty, there will still be hard-coded optimisation steps that will run regardless.
 	/// Set @a runYulOptimiser to false if you want no optimisations.
 	std::string yulOptimiserCleanupSteps = DefaultYulOptimiserCleanupSteps;
+	/// Execution counts of Yul functions in the unoptimised IR, for example gathered from traces
+	/// of real transactions. If not empty, the Yul optimiser only inlines functions that are
+	/// executed, unless they are tiny or called only once, and allows larger executed functions.
+	std::map<std::string, size_t> yulInlinerProfile;
+	/// Wall time in milliseconds that the optimisation sequence of the Yul optimiser may take
+	/// for each object. When it is exceeded, the remaining steps are skipped and only the clean-up
+	/// sequence is run. The resulting code depends on the speed of the machine. Unlimited if not set.
+	std::optional<size_t> yulOptimiserTimeBudget;
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Relative frequencies of calls to external functions, indexed by selector. If not empty,
+	/// the function dispatcher checks the more frequently called functions first.
+	/// Functions that are not listed are assumed to be never called.
+	std::map<util::FixedHash<4>, size_t> callProfile;
+	/// Size in bytes that the deployed code of a contract should not exceed because of inlining
+	/// by the evmasm inliner. If set, the inliner prefers the jumps that save the most gas per
+	/// added byte. Unlimited if not set.
+	std::optional<size_t> inlinerSizeLimit;
 };
 
 }
@@ -26,6 +26,7 @@
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/process.hpp>
@@ -38,7 +39,71 @@ using namespace std;
 namespace solidity::frontend
 {
 
-SMTSolverCommand::SMTSolverCommand(string _solverCmd) : m_solverCmd(_solverCmd) {}
+/// A solver process that reads SMT-LIB2 commands from a pipe and writes its answers to another.
+/// The end of the answer to a query is recognised by a marker the solver is asked to echo.
+class SMTSolverCommand::SolverProcess
+{
+public:
+	SolverProcess(boost::filesystem::path const& _solverBin, vector<string> const& _arguments):
+		m_process(
+			_solverBin,
+			boost::process::args(_arguments),
+			boost::process::std_in < m_input,
+			boost::process::std_out > m_output
+		)
+	{}
+
+	~SolverProcess()
+	{
+		try
+		{
+			m_input << "(exit)" << endl;
+			m_input.pipe().close();
+			m_process.wait();
+		}
+		catch (...)
+		{
+		}
+	}
+
+	/// @returns the answer of the solver to @a _query, or nullopt if the solver terminated
+	/// before answering.
+	optional<string> query(string const& _query)
+	{
+		// The solver is reset before the query rather than after it, so that an error reported
+		// for the reset is part of the answer it belongs to.
+		m_input << "(reset)\n" << _query << "\n(echo \"" << endMarker << "\")" << endl;
+		if (!m_input)
+			return nullopt;
+
+		vector<string> data;
+		string line;
+		while (getline(m_output, line))
+		{
+			boost::trim(line);
+			// Some solvers print the echoed string with its quotes.
+			if (line == endMarker || line == "\"" + string(endMarker) + "\"")
+				return boost::join(data, "\n");
+			if (!line.empty())
+				data.push_back(line);
+		}
+		return nullopt;
+	}
+
+private:
+	static constexpr char const* endMarker = "solc-query-done";
+
+	boost::process::opstream m_input;
+	boost::process::ipstream m_output;
+	boost::process::child m_process;
+};
+
+SMTSolverCommand::SMTSolverCommand(string _solverCmd, vector<string> _interactiveArguments):
+	m_solverCmd(std::move(_solverCmd)),
+	m_interactiveArguments(std::move(_interactiveArguments))
+{}
+
+SMTSolverCommand::~SMTSolverCommand() = default;
 
 ReadCallback::Result SMTSolverCommand::solve(string const& _kind, string const& _query)
 {
@@ -47,34 +112,38 @@ ReadCallback::Result SMTSolverCommand::solve(string const& _kind, string const&
 		if (_kind != ReadCallback::kindString(ReadCallback::Kind::SMTQuery))
 			solAssert(false, "SMTQuery callback used as callback kind " + _kind);
 
-		auto tempDir = solidity::util::TemporaryDirectory("smt");
-		util::h256 queryHash = util::keccak256(_query);
-		auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
-
-		auto queryFile = boost::filesystem::ofstream(queryFileName);
-		queryFile << _query;
+		boost::filesystem::path solverBin = boost::filesystem::path(m_solverCmd).has_parent_path() ?
+			boost::filesystem::path(m_solverCmd) :
+			boost::process::search_path(m_solverCmd);
 
-		auto eldBin = boost::process::search_path(m_solverCmd);
-
-		if (eldBin.empty())
+		if (solverBin.empty() || !boost::filesystem::exists(solverBin))
 			return ReadCallback::Result{false, m_solverCmd + " binary not found."};
 
-		boost::process::ipstream pipe;
-		boost::process::child eld(
-			eldBin,
-			queryFileName,
-			boost::process::std_out > pipe
-		);
-
-		vector<string> data;
-		string line;
-		while (eld.running() && std::getline(pipe, line))
-			if (!line.empty())
-				data.push_back(line);
-
-		eld.wait();
-
-		return ReadCallback::Result{true, boost::join(data, "\n")};
+		if (m_interactiveArguments.empty())
+			return solveInNewProcess(solverBin, _query);
+
+		unique_ptr<SolverProcess> process;
+		{
+			lock_guard<mutex> lock(m_idleProcessesMutex);
+			if (!m_idleProcesses.empty())
+			{
+				process = std::move(m_idleProcesses.back());
+				m_idleProcesses.pop_back();
+			}
+		}
+		if (!process)
+			process = make_unique<SolverProcess>(solverBin, m_interactiveArguments);
+
+		if (optional<string> answer = process->query(_query))
+		{
+			lock_guard<mutex> lock(m_idleProcessesMutex);
+			m_idleProcesses.emplace_back(std::move(process));
+			return ReadCallback::Result{true, std::move(*answer)};
+		}
+
+		// The solver terminated, e.g. because it does not support the interactive protocol after all.
+		process.reset();
+		return solveInNewProcess(solverBin, _query);
 	}
 	catch (...)
 	{
@@ -82,4 +151,32 @@ ReadCallback::Result SMTSolverCommand::solve(string const& _kind, string const&
 	}
 }
 
+ReadCallback::Result SMTSolverCommand::solveInNewProcess(boost::filesystem::path const& _solverBin, string const& _query)
+{
+	auto tempDir = solidity::util::TemporaryDirectory("smt");
+	util::h256 queryHash = util::keccak256(_query);
+	auto queryFileName = tempDir.path() / ("query_" + queryHash.hex() + ".smt2");
+
+	auto queryFile = boost::filesystem::ofstream(queryFileName);
+	queryFile << _query;
+	queryFile.close();
+
+	boost::process::ipstream pipe;
+	boost::process::child eld(
+		_solverBin,
+		queryFileName,
+		boost::process::std_out > pipe
+	);
+
+	vector<string> data;
+	string line;
+	while (eld.running() && std::getline(pipe, line))
+		if (!line.empty())
+			data.push_back(line);
+
+	eld.wait();
+
+	return ReadCallback::Result{true, boost::join(data, "\n")};
+}
+
 }
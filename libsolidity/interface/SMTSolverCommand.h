@@ -21,14 +21,27 @@
 
 #include <boost/filesystem.hpp>
 
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 namespace solidity::frontend
 {
 
 /// SMTSolverCommand wraps an SMT solver called via its binary in the OS.
+/// By default the solver is started for every query. Solvers that support the interactive
+/// SMT-LIB2 protocol can instead be kept running, in which case the queries are streamed
+/// to a pool of solver processes that are reused, avoiding the startup cost per query.
 class SMTSolverCommand
 {
 public:
-	SMTSolverCommand(std::string _solverCmd);
+	/// @param _solverCmd the name of the solver's binary or a path to it.
+	/// @param _interactiveArguments arguments that make the solver read SMT-LIB2 commands from
+	/// its standard input and answer each one as soon as it is read, e.g. `-in` for z3.
+	/// If empty, the solver is started for every query with the query file as its only argument.
+	explicit SMTSolverCommand(std::string _solverCmd, std::vector<std::string> _interactiveArguments = {});
+	~SMTSolverCommand();
 
 	/// Calls an SMT solver with the given query.
 	frontend::ReadCallback::Result solve(std::string const& _kind, std::string const& _query);
@@ -39,8 +52,18 @@ public:
 	}
 
 private:
+	class SolverProcess;
+
+	/// Starts the solver on a file containing the query and waits for it to terminate.
+	frontend::ReadCallback::Result solveInNewProcess(boost::filesystem::path const& _solverBin, std::string const& _query);
+
 	/// The name of the solver's binary.
 	std::string const m_solverCmd;
+	std::vector<std::string> const m_interactiveArguments;
+
+	std::mutex m_idleProcessesMutex;
+	/// Solver processes that are running but not answering a query at the moment.
+	std::vector<std::unique_ptr<SolverProcess>> m_idleProcesses;
 };
 
 }
@@ -43,6 +43,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -265,7 +266,7 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"*",
 		"ir", "irOptimized",
 		"wast", "wasm", "ewasm.wast", "ewasm.wasm",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"evm.gasEstimates", "evm.gasMap", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
 	for (auto const& fileRequests: _outputSelection)
@@ -284,7 +285,7 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 
 	static vector<string> const outputsThatRequireEvmBinaries = vector<string>{
 		"*",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"evm.gasEstimates", "evm.gasMap", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
 
 	for (auto const& fileRequests: _outputSelection)
@@ -330,6 +331,85 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the output @a _output was explicitly requested for any contract.
+/// Used for outputs that are not matched by '*'.
+bool isRequestedByName(Json::Value const& _outputSelection, string const& _output)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == _output)
+					return true;
+
+	return false;
+}
+
+/// @returns true if the profile of the Yul optimizer or of the assembly optimizer was requested.
+/// Note that they are not matched by '*' since recording them slows down the optimizer.
+bool isOptimizerProfileRequested(Json::Value const& _outputSelection)
+{
+	return
+		isRequestedByName(_outputSelection, "optimizerProfile") ||
+		isRequestedByName(_outputSelection, "assemblyOptimizerProfile");
+}
+
+/// @returns true if the SMTChecker profile was requested. Note that it is not matched by '*'
+/// since it is not deterministic.
+bool isModelCheckerProfileRequested(Json::Value const& _outputSelection)
+{
+	return isRequestedByName(_outputSelection, "modelCheckerProfile");
+}
+
+/// @returns true if the gas map was requested. Note that it is not matched by '*' or 'evm'
+/// since it is large.
+bool isGasMapRequested(Json::Value const& _outputSelection)
+{
+	return isRequestedByName(_outputSelection, "evm.gasMap");
+}
+
+/// @returns true if the storage packing advice was requested. Note that it is not matched by '*'
+/// since it is an analysis rather than an artifact.
+bool isStoragePackingAdviceRequested(Json::Value const& _outputSelection)
+{
+	return isRequestedByName(_outputSelection, "storagePackingAdvice");
+}
+
+/// @returns true if the compilation statistics were requested. Note that they are not matched
+/// by '*' or 'evm' since they are not deterministic.
+bool isCompilationStatsRequested(Json::Value const& _outputSelection)
+{
+	return isRequestedByName(_outputSelection, "evm.compilationStats");
+}
+
+/// @returns the intermediate results of the code generation that the requested outputs of any
+/// contract are derived from. The compiler releases the others as early as possible.
+CompilerStack::IntermediateSelection requestedIntermediates(Json::Value const& _outputSelection)
+{
+	auto isRequested = [&](vector<string> const& _outputs) {
+		if (!_outputSelection.isObject())
+			return false;
+		for (auto const& fileRequests: _outputSelection)
+			for (auto const& requests: fileRequests)
+				for (auto const& output: _outputs)
+					if (isArtifactRequested(requests, output, false))
+						return true;
+		return false;
+	};
+
+	CompilerStack::IntermediateSelection selection;
+	selection.yulIR = isRequested({"ir"});
+	selection.yulIROptimized = isRequested({"irOptimized"});
+	selection.evmAssembly =
+		isRequested({"evm.assembly", "evm.legacyAssembly", "evm.gasEstimates"}) ||
+		isGasMapRequested(_outputSelection);
+	selection.sourceMappings = isRequested({"evm.bytecode.sourceMap", "evm.deployedBytecode.sourceMap"});
+	selection.generatedSources = isRequested({"evm.bytecode.generatedSources", "evm.deployedBytecode.generatedSources"});
+	return selection;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret{Json::objectValue};
@@ -439,25 +519,25 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "skipUnreferencedSources", "deduplicateSources", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "showUnproved", "solvers", "targets", "timeout"};
+	static set<string> keys{"budget", "contracts", "divModNoSlacks", "engine", "extCalls", "invariants", "raceSolvers", "showUnproved", "solvers", "targets", "timeout", "verdictsOnly"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
 std::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"callProfile", "details", "enabled", "runs"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
 std::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "inliner", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "tailMerger", "inlinerSizeLimit", "timeBudget", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -593,6 +673,28 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("callProfile"))
+	{
+		Json::Value const& callProfile = _jsonInput["callProfile"];
+		if (!callProfile.isObject())
+			return formatFatalError(Error::Type::JSONError, "The \"callProfile\" setting must be an object.");
+		for (string const& selector: callProfile.getMemberNames())
+		{
+			string hexSelector = selector.substr(0, 2) == "0x" ? selector : "0x" + selector;
+			if (hexSelector.size() != 10 || !util::isValidHex(hexSelector))
+				return formatFatalError(
+					Error::Type::JSONError,
+					"Invalid function selector in \"callProfile\": \"" + selector + "\". Expected 8 hex digits."
+				);
+			if (!callProfile[selector].isUInt())
+				return formatFatalError(
+					Error::Type::JSONError,
+					"The call frequency of \"" + selector + "\" in \"callProfile\" must be an unsigned number."
+				);
+			settings.callProfile[util::FixedHash<4>(hexSelector)] = callProfile[selector].asUInt();
+		}
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -613,6 +715,20 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "tailMerger", settings.runTailMerger))
+			return *error;
+		if (details.isMember("inlinerSizeLimit"))
+		{
+			if (!details["inlinerSizeLimit"].isUInt())
+				return formatFatalError(Error::Type::JSONError, "\"settings.optimizer.details.inlinerSizeLimit\" must be an unsigned number.");
+			settings.inlinerSizeLimit = details["inlinerSizeLimit"].asUInt();
+		}
+		if (details.isMember("timeBudget"))
+		{
+			if (!details["timeBudget"].isUInt())
+				return formatFatalError(Error::Type::JSONError, "\"settings.optimizer.details.timeBudget\" must be an unsigned number.");
+			settings.yulOptimiserTimeBudget = details["timeBudget"].asUInt();
+		}
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
@@ -621,12 +737,27 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 			if (!settings.runYulOptimiser)
 				return formatFatalError(Error::Type::JSONError, "\"Providing yulDetails requires Yul optimizer to be enabled.");
 
-			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps"}, "settings.optimizer.details.yulDetails"))
+			if (auto result = checkKeys(details["yulDetails"], {"stackAllocation", "optimizerSteps", "inlinerProfile"}, "settings.optimizer.details.yulDetails"))
 				return *result;
 			if (auto error = checkOptimizerDetail(details["yulDetails"], "stackAllocation", settings.optimizeStackAllocation))
 				return *error;
 			if (auto error = checkOptimizerDetailSteps(details["yulDetails"], "optimizerSteps", settings.yulOptimiserSteps, settings.yulOptimiserCleanupSteps))
 				return *error;
+			if (details["yulDetails"].isMember("inlinerProfile"))
+			{
+				Json::Value const& inlinerProfile = details["yulDetails"]["inlinerProfile"];
+				if (!inlinerProfile.isObject())
+					return formatFatalError(Error::Type::JSONError, "\"settings.optimizer.details.yulDetails.inlinerProfile\" must be an object.");
+				for (string const& function: inlinerProfile.getMemberNames())
+				{
+					if (!inlinerProfile[function].isUInt())
+						return formatFatalError(
+							Error::Type::JSONError,
+							"The execution count of \"" + function + "\" in \"inlinerProfile\" must be an unsigned number."
+						);
+					settings.yulInlinerProfile[function] = inlinerProfile[function].asUInt();
+				}
+			}
 		}
 	}
 	return { std::move(settings) };
@@ -677,7 +808,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 					"Mismatch between content and supplied hash for \"" + sourceName + "\""
 				));
 			else
-				ret.sources[sourceName] = content;
+				ret.sources[sourceName] = std::move(content);
 		}
 		else if (sources[sourceName]["urls"].isArray())
 		{
@@ -702,7 +833,7 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 						));
 					else
 					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
+						ret.sources[sourceName] = std::move(result.responseOrErrorMessage);
 						found = true;
 						break;
 					}
@@ -784,6 +915,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.parserErrorRecovery = settings["parserErrorRecovery"].asBool();
 	}
 
+	if (settings.isMember("skipUnreferencedSources"))
+	{
+		if (!settings["skipUnreferencedSources"].isBool())
+			return formatFatalError(Error::Type::JSONError, "\"settings.skipUnreferencedSources\" must be a Boolean.");
+		ret.skipUnreferencedSources = settings["skipUnreferencedSources"].asBool();
+	}
+
+	if (settings.isMember("deduplicateSources"))
+	{
+		if (!settings["deduplicateSources"].isBool())
+			return formatFatalError(Error::Type::JSONError, "\"settings.deduplicateSources\" must be a Boolean.");
+		ret.deduplicateSources = settings["deduplicateSources"].asBool();
+	}
+
 	if (settings.isMember("viaIR"))
 	{
 		if (!settings["viaIR"].isBool())
@@ -967,6 +1112,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	if (auto result = checkModelCheckerSettingsKeys(modelCheckerSettings))
 		return *result;
 
+	if (modelCheckerSettings.isMember("budget"))
+	{
+		if (!modelCheckerSettings["budget"].isUInt())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.budget must be an unsigned integer.");
+		ret.modelCheckerSettings.budget = modelCheckerSettings["budget"].asUInt();
+	}
+
 	if (modelCheckerSettings.isMember("contracts"))
 	{
 		auto const& sources = modelCheckerSettings["contracts"];
@@ -1047,6 +1199,14 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.invariants = invariants;
 	}
 
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		auto const& raceSolvers = modelCheckerSettings["raceSolvers"];
+		if (!raceSolvers.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.raceSolvers must be a Boolean value.");
+		ret.modelCheckerSettings.raceSolvers = raceSolvers.asBool();
+	}
+
 	if (modelCheckerSettings.isMember("showUnproved"))
 	{
 		auto const& showUnproved = modelCheckerSettings["showUnproved"];
@@ -1101,12 +1261,25 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("verdictsOnly"))
+	{
+		auto const& verdictsOnly = modelCheckerSettings["verdictsOnly"];
+		if (!verdictsOnly.isBool())
+			return formatFatalError(Error::Type::JSONError, "settings.modelChecker.verdictsOnly must be a Boolean value.");
+		ret.modelCheckerSettings.verdictsOnly = verdictsOnly.asBool();
+	}
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	ContractOutputSink const& _contractOutputSink
+)
 {
 	CompilerStack compilerStack(m_readFile);
+	if (m_compilationCache)
+		compilerStack.setCompilationCache(m_compilationCache);
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	compilerStack.setSources(sourceList);
@@ -1115,6 +1288,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setViaIR(_inputsAndSettings.viaIR);
 	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+	compilerStack.setSkipUnreferencedSources(_inputsAndSettings.skipUnreferencedSources);
+	compilerStack.setDeduplicateSources(_inputsAndSettings.deduplicateSources);
 	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
 	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
@@ -1129,7 +1304,10 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableOptimiserProfiling(isOptimizerProfileRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enablePhaseStatistics(isCompilationStatsRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	compilerStack.retainIntermediates(requestedIntermediates(_inputsAndSettings.outputSelection));
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1287,13 +1465,41 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			output["sources"][sourceName] = sourceResult;
 		}
 
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	// Process the contracts grouped by source so that a streaming sink receives the contracts of each
+	// source consecutively. Sorting by fully qualified name does not guarantee that if source names contain colons.
+	auto splitContractName = [](string const& _contractName) -> pair<string, string>
 	{
-		size_t colon = contractName.rfind(':');
+		size_t colon = _contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		return {_contractName.substr(0, colon), _contractName.substr(colon + 1)};
+	};
+	vector<string> contractNames = analysisPerformed ? compilerStack.contractNames() : vector<string>();
+	stable_sort(contractNames.begin(), contractNames.end(), [&](string const& _lhs, string const& _rhs) {
+		return splitContractName(_lhs) < splitContractName(_rhs);
+	});
+
+	// The artifacts that only need the analysis are generated for all contracts up front,
+	// which lets their independent parts run in parallel.
+	map<string, CompilerStack::ArtifactSelection> artifacts;
+	for (string const& contractName: contractNames)
+	{
+		auto const& [file, name] = splitContractName(contractName);
+		CompilerStack::ArtifactSelection& selection = artifacts[contractName];
+		selection.abi = isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental);
+		selection.storageLayout = isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false);
+		selection.natspecUser = isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental);
+		selection.natspecDev = isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental);
+		selection.metadata = isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental);
+	}
+	if (!artifacts.empty())
+		compilerStack.generateArtifacts(artifacts);
+
+	Json::Value contractsOutput = Json::objectValue;
+	for (string const& contractName: contractNames)
+	{
+		string file;
+		string name;
+		tie(file, name) = splitContractName(contractName);
 
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
@@ -1301,6 +1507,11 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["abi"] = compilerStack.contractABI(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
 			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
+		if (
+			isStoragePackingAdviceRequested(_inputsAndSettings.outputSelection) &&
+			isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storagePackingAdvice", false)
+		)
+			contractData["storagePackingAdvice"] = compilerStack.storagePackingAdvice(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
 			contractData["metadata"] = compilerStack.metadata(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
@@ -1313,6 +1524,23 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["ir"] = compilerStack.yulIR(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
 			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+		if (
+			compilationSuccess &&
+			isOptimizerProfileRequested(_inputsAndSettings.outputSelection) &&
+			isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "optimizerProfile", wildcardMatchesExperimental)
+		)
+			contractData["optimizerProfile"] = compilerStack.optimiserProfile(contractName);
+		if (
+			compilationSuccess &&
+			isOptimizerProfileRequested(_inputsAndSettings.outputSelection) &&
+			isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "assemblyOptimizerProfile", wildcardMatchesExperimental)
+		)
+			contractData["assemblyOptimizerProfile"] = compilerStack.assemblyOptimiserProfile(contractName);
+		if (
+			isModelCheckerProfileRequested(_inputsAndSettings.outputSelection) &&
+			isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "modelCheckerProfile", wildcardMatchesExperimental)
+		)
+			contractData["modelCheckerProfile"] = compilerStack.modelCheckerProfile(contractName);
 
 		// Ewasm
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
@@ -1330,6 +1558,17 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
 			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+		if (
+			compilationSuccess &&
+			isGasMapRequested(_inputsAndSettings.outputSelection) &&
+			isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasMap", wildcardMatchesExperimental)
+		)
+			evmData["gasMap"] = compilerStack.gasMap(contractName);
+		if (
+			isCompilationStatsRequested(_inputsAndSettings.outputSelection) &&
+			isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.compilationStats", wildcardMatchesExperimental)
+		)
+			evmData["compilationStats"] = compilerStack.compilationStats(contractName);
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
@@ -1378,11 +1617,15 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		if (!evmData.empty())
 			contractData["evm"] = evmData;
 
-		if (!contractData.empty())
+		if (contractData.empty())
+			continue;
+		if (_contractOutputSink)
+			_contractOutputSink(file, name, std::move(contractData));
+		else
 		{
 			if (!contractsOutput.isMember(file))
 				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			contractsOutput[file][name] = std::move(contractData);
 		}
 	}
 	if (!contractsOutput.empty())
@@ -1529,6 +1772,11 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	return compile(_input, {});
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input, ContractOutputSink const& _contractOutputSink) noexcept
 {
 	YulStringRepository::reset();
 
@@ -1539,7 +1787,7 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _contractOutputSink);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1564,30 +1812,77 @@ Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
+{
+	ostringstream output;
+	compile(_input, output, false);
+	return output.str();
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
+{
+	compile(_input, _output, m_jsonPrintingFormat.format == util::JsonFormat::Compact);
+}
+
+void StandardCompiler::compile(string const& _input, ostream& _output, bool _streamContracts) noexcept
 {
 	Json::Value input;
 	string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+		{
+			_output << util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
 	}
 
+	// Writes `{"contracts":{"<source>":{"<contract>":<output>,...},...}` piece by piece.
+	// The remaining members of the output follow once compilation returns.
+	optional<string> currentSource;
+	auto streamContract = [&](string const& _sourceName, string const& _contractName, Json::Value _contractOutput)
+	{
+		if (!currentSource)
+			_output << "{\"contracts\":{";
+		else if (*currentSource != _sourceName)
+			_output << "},";
+		else
+			_output << ",";
+		if (currentSource != _sourceName)
+			_output << util::jsonCompactPrint(Json::Value(_sourceName)) << ":{";
+		currentSource = _sourceName;
+		_output << util::jsonCompactPrint(Json::Value(_contractName)) << ":" << util::jsonCompactPrint(_contractOutput);
+	};
+
 	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
+	Json::Value output = compile(input, _streamContracts ? ContractOutputSink(streamContract) : ContractOutputSink{});
 	// cout << "Output: " << output.toStyledString() << endl;
 
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		if (!currentSource)
+		{
+			_output << util::jsonPrint(output, m_jsonPrintingFormat);
+			return;
+		}
+
+		// Close the "contracts" member and append the others.
+		_output << "}}";
+		for (string const& member: output.getMemberNames())
+			_output << "," << util::jsonCompactPrint(Json::Value(member)) << ":" << util::jsonCompactPrint(output[member]);
+		_output << "}";
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		if (currentSource)
+			_output << "}},";
+		else
+			_output << "{";
+		_output << "\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
 
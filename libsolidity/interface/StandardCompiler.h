@@ -28,7 +28,10 @@
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <functional>
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -62,6 +65,14 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the serialized output to @a _output. With the compact JSON format,
+	/// the output of each contract is written as soon as it is generated and released afterwards,
+	/// so that the memory needed for the output does not grow with the number of contracts.
+	/// In that case, "contracts" is the first member of the output object.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Sets a cache for artifacts that is shared by all following compilations of Solidity sources.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache) { m_compilationCache = std::move(_cache); }
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -73,6 +84,8 @@ private:
 		std::string language;
 		Json::Value errors;
 		bool parserErrorRecovery = false;
+		bool skipUnreferencedSources = false;
+		bool deduplicateSources = false;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
 		std::map<std::string, std::string> sources;
 		std::map<util::h256, std::string> smtLib2Responses;
@@ -95,12 +108,26 @@ private:
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Receives the output of a single contract as soon as it is generated.
+	using ContractOutputSink = std::function<void(
+		std::string const& _sourceName,
+		std::string const& _contractName,
+		Json::Value _contractOutput
+	)>;
+
+	/// If @a _contractOutputSink is set, the output of the contracts is passed to it
+	/// instead of being included in the returned output.
+	Json::Value compile(Json::Value const& _input, ContractOutputSink const& _contractOutputSink) noexcept;
+	void compile(std::string const& _input, std::ostream& _output, bool _streamContracts) noexcept;
+
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, ContractOutputSink const& _contractOutputSink = {});
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::shared_ptr<CompilationCache> m_compilationCache;
 };
 
 }
@@ -0,0 +1,275 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/StoragePackingAdvisor.h>
+
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
+
+#include <range/v3/view/reverse.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace
+{
+
+/// @returns true if a value of type @a _type can share its slot with other values.
+bool packable(Type const* _type)
+{
+	return _type->storageSize() == 1 && _type->storageBytes() < 32;
+}
+
+/// @returns the number of slots occupied by @a _fields in the given order.
+u256 slotCount(vector<VariableDeclaration const*> const& _fields)
+{
+	TypePointers types;
+	for (VariableDeclaration const* field: _fields)
+		types.push_back(field->annotation().type);
+	StorageOffsets offsets;
+	offsets.computeOffsets(types);
+	return offsets.storageSize();
+}
+
+/// @returns the fields of @a _group in an order that needs as few slots as possible: the fields that
+/// cannot share a slot in their original order, followed by the others, packed into slots by
+/// first-fit decreasing size.
+vector<VariableDeclaration const*> packedOrder(vector<VariableDeclaration const*> const& _group)
+{
+	vector<VariableDeclaration const*> order;
+	vector<VariableDeclaration const*> packableFields;
+	for (VariableDeclaration const* field: _group)
+		if (packable(field->annotation().type))
+			packableFields.push_back(field);
+		else
+			order.push_back(field);
+
+	stable_sort(packableFields.begin(), packableFields.end(), [](auto const* _lhs, auto const* _rhs) {
+		return _lhs->annotation().type->storageBytes() > _rhs->annotation().type->storageBytes();
+	});
+	/// Used bytes and fields of each slot.
+	vector<pair<unsigned, vector<VariableDeclaration const*>>> slots;
+	for (VariableDeclaration const* field: packableFields)
+	{
+		unsigned size = field->annotation().type->storageBytes();
+		auto slot = find_if(slots.begin(), slots.end(), [&](auto const& _slot) { return _slot.first + size <= 32; });
+		if (slot == slots.end())
+			slot = slots.insert(slots.end(), {0, {}});
+		slot->first += size;
+		slot->second.push_back(field);
+	}
+	for (auto const& slot: slots)
+		order += slot.second;
+	return order;
+}
+
+/// Collects the state variables and the members of structs in storage that are written to.
+class WrittenFields: public ASTConstVisitor
+{
+public:
+	explicit WrittenFields(set<VariableDeclaration const*>& o_written): m_written(o_written) {}
+
+	void endVisit(Identifier const& _identifier) override
+	{
+		if (_identifier.annotation().willBeWrittenTo)
+			if (auto variable = dynamic_cast<VariableDeclaration const*>(_identifier.annotation().referencedDeclaration))
+				if (variable->isStateVariable())
+					m_written.insert(variable);
+	}
+
+	void endVisit(MemberAccess const& _memberAccess) override
+	{
+		if (!_memberAccess.annotation().willBeWrittenTo)
+			return;
+		auto structType = dynamic_cast<StructType const*>(_memberAccess.expression().annotation().type);
+		if (structType && structType->location() == DataLocation::Storage)
+			if (auto member = dynamic_cast<VariableDeclaration const*>(_memberAccess.annotation().referencedDeclaration))
+				m_written.insert(member);
+	}
+
+private:
+	set<VariableDeclaration const*>& m_written;
+};
+
+/// The key for the JSON object describing a type, as in the storage layout.
+string typeKeyName(Type const* _type)
+{
+	if (auto refType = dynamic_cast<ReferenceType const*>(_type))
+		return TypeProvider::withLocationIfReference(refType->location(), _type)->richIdentifier();
+	return _type->richIdentifier();
+}
+
+Json::Value fieldToJson(VariableDeclaration const& _field)
+{
+	Json::Value field;
+	field["label"] = _field.name();
+	field["astId"] = static_cast<int>(_field.id());
+	return field;
+}
+
+}
+
+Json::Value StoragePackingAdvisor::generate(ContractDefinition const& _contractDef)
+{
+	solAssert(!m_contract, "");
+	m_contract = &_contractDef;
+
+	auto typeType = dynamic_cast<TypeType const*>(_contractDef.type());
+	solAssert(typeType, "");
+	auto contractType = dynamic_cast<ContractType const*>(typeType->actualType());
+	solAssert(contractType, "");
+
+	// The constructors run only once, the slots they write do not matter.
+	for (ContractDefinition const* contract: _contractDef.annotation().linearizedBaseContracts | ranges::views::reverse)
+		for (FunctionDefinition const* function: contract->definedFunctions())
+			if (function->isImplemented() && !function->isConstructor())
+			{
+				set<VariableDeclaration const*> written;
+				WrittenFields visitor{written};
+				function->body().accept(visitor);
+				if (!written.empty())
+					m_writes.emplace_back(function, std::move(written));
+			}
+
+	// Variables of different contracts are not reordered among each other.
+	Fields stateVariables;
+	ContractDefinition const* currentContract = nullptr;
+	for (auto [variable, slot, offset]: contractType->stateVariables())
+	{
+		auto contract = dynamic_cast<ContractDefinition const*>(variable->scope());
+		if (stateVariables.groups.empty() || contract != currentContract)
+			stateVariables.groups.emplace_back();
+		currentContract = contract;
+		stateVariables.groups.back().push_back(variable);
+		stateVariables.offsets[variable] = {slot, offset};
+		collectStructs(variable->annotation().type);
+	}
+
+	Json::Value types(Json::objectValue);
+	for (auto const& [key, structType]: m_structs)
+	{
+		Fields members;
+		members.groups.emplace_back();
+		for (ASTPointer<VariableDeclaration> const& member: structType->structDefinition().members())
+		{
+			members.groups.back().push_back(member.get());
+			members.offsets[member.get()] = structType->storageOffsetsOfMember(member->name());
+		}
+		Json::Value& typeInfo = types[key];
+		typeInfo = generate(members);
+		typeInfo["label"] = structType->toString(true);
+	}
+
+	Json::Value advice;
+	advice["storage"] = generate(stateVariables);
+	advice["types"] = std::move(types);
+	return advice;
+}
+
+Json::Value StoragePackingAdvisor::generate(Fields const& _fields)
+{
+	vector<VariableDeclaration const*> currentOrder;
+	vector<VariableDeclaration const*> suggestedOrder;
+	for (auto const& group: _fields.groups)
+	{
+		currentOrder += group;
+		suggestedOrder += packedOrder(group);
+	}
+	u256 slots = slotCount(currentOrder);
+	u256 suggestedSlots = slotCount(suggestedOrder);
+
+	Json::Value advice;
+	advice["slots"] = slots.str();
+	if (suggestedSlots < slots)
+	{
+		advice["suggestedSlots"] = suggestedSlots.str();
+		Json::Value order(Json::arrayValue);
+		for (VariableDeclaration const* field: suggestedOrder)
+			order.append(fieldToJson(*field));
+		advice["suggestedOrder"] = std::move(order);
+	}
+	else
+		advice["suggestedSlots"] = slots.str();
+	advice["slotsSaved"] = (slots - min(slots, suggestedSlots)).str();
+	advice["writtenTogether"] = writtenTogether(_fields);
+	return advice;
+}
+
+void StoragePackingAdvisor::collectStructs(Type const* _type)
+{
+	if (auto structType = dynamic_cast<StructType const*>(_type))
+	{
+		if (!m_structs.emplace(typeKeyName(structType), structType).second)
+			return;
+		for (ASTPointer<VariableDeclaration> const& member: structType->structDefinition().members())
+			collectStructs(member->annotation().type);
+	}
+	else if (auto mappingType = dynamic_cast<MappingType const*>(_type))
+		collectStructs(mappingType->valueType());
+	else if (auto arrayType = dynamic_cast<ArrayType const*>(_type))
+		if (!arrayType->isByteArrayOrString())
+			collectStructs(arrayType->baseType());
+}
+
+Json::Value StoragePackingAdvisor::writtenTogether(Fields const& _fields) const
+{
+	Json::Value result(Json::arrayValue);
+	for (auto const& [function, written]: m_writes)
+	{
+		vector<VariableDeclaration const*> fields;
+		for (VariableDeclaration const* field: written)
+			if (_fields.offsets.count(field) && packable(field->annotation().type))
+				fields.push_back(field);
+		sort(fields.begin(), fields.end(), [&](auto const* _lhs, auto const* _rhs) {
+			return _fields.offsets.at(_lhs) < _fields.offsets.at(_rhs);
+		});
+
+		// Fields in different slots that would fit into one.
+		set<VariableDeclaration const*> separated;
+		for (size_t i = 0; i < fields.size(); ++i)
+			for (size_t j = i + 1; j < fields.size(); ++j)
+				if (
+					_fields.offsets.at(fields[i]).first != _fields.offsets.at(fields[j]).first &&
+					fields[i]->annotation().type->storageBytes() + fields[j]->annotation().type->storageBytes() <= 32
+				)
+				{
+					separated.insert(fields[i]);
+					separated.insert(fields[j]);
+				}
+		if (separated.empty())
+			continue;
+
+		Json::Value entry;
+		entry["function"] = function->name().empty() ? string(TokenTraits::toString(function->kind())) : function->name();
+		entry["astId"] = static_cast<int>(function->id());
+		entry["fields"] = Json::arrayValue;
+		for (VariableDeclaration const* field: fields)
+			if (separated.count(field))
+			{
+				Json::Value fieldInfo = fieldToJson(*field);
+				fieldInfo["slot"] = _fields.offsets.at(field).first.str();
+				fieldInfo["offset"] = _fields.offsets.at(field).second;
+				entry["fields"].append(std::move(fieldInfo));
+			}
+		result.append(std::move(entry));
+	}
+	return result;
+}
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Suggests declaration orders of state variables and struct members that need fewer storage slots.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/Types.h>
+
+#include <json/json.h>
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Analyses the storage layout of a contract and of the structs it stores. For the state variables
+ * and for every struct, it reports the number of slots they occupy, the minimal number of slots of
+ * any declaration order and an order that achieves it. State variables are only reordered among
+ * the variables of the same contract, so that the layout stays compatible with inheritance.
+ * It also lists the variables and members that are written in the same function, could share
+ * a slot and do not.
+ */
+class StoragePackingAdvisor
+{
+public:
+	/// Generates the advice for the contract
+	/// @param _contractDef The contract definition
+	/// @return A JSON representation of the advice.
+	Json::Value generate(ContractDefinition const& _contractDef);
+
+private:
+	/// Fields of a contract or struct in storage, i.e. state variables or struct members,
+	/// grouped into the parts that can be reordered independently.
+	struct Fields
+	{
+		std::vector<std::vector<VariableDeclaration const*>> groups;
+		/// Slot and offset of each field in the current layout.
+		std::map<VariableDeclaration const*, std::pair<u256, unsigned>> offsets;
+	};
+
+	/// Generates the advice for @a _fields.
+	Json::Value generate(Fields const& _fields);
+
+	/// Collects the struct types stored by @a _type and its members.
+	void collectStructs(Type const* _type);
+
+	/// @returns the fields among @a _fields that are written by the same function and could share
+	/// a slot with one of the others, by function.
+	Json::Value writtenTogether(Fields const& _fields) const;
+
+	/// State variables and struct members written by each function of the contract and its bases.
+	std::vector<std::pair<FunctionDefinition const*, std::set<VariableDeclaration const*>>> m_writes;
+
+	/// Struct types stored by the contract, by their key in the storage layout.
+	std::map<std::string, StructType const*> m_structs;
+
+	/// Current analyzed contract
+	ContractDefinition const* m_contract = nullptr;
+};
+
+}
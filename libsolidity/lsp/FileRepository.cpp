@@ -23,6 +23,7 @@
 #include <libsolutil/StringUtils.h>
 #include <libsolutil/CommonIO.h>
 
+#include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/algorithm/none_of.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/transform.hpp>
@@ -43,10 +44,38 @@ using solidity::util::readFileAsString;
 using solidity::util::joinHumanReadable;
 using solidity::util::Result;
 
-FileRepository::FileRepository(boost::filesystem::path _basePath, std::vector<boost::filesystem::path> _includePaths):
+namespace
+{
+
+bool isInsideDirectory(boost::filesystem::path const& _path, boost::filesystem::path const& _directory)
+{
+	boost::filesystem::path const relativePath = _path.lexically_normal().lexically_relative(_directory.lexically_normal());
+	return !relativePath.empty() && *relativePath.begin() != "..";
+}
+
+}
+
+string const& DependencyCache::read(boost::filesystem::path const& _path)
+{
+	time_t const lastWriteTime = boost::filesystem::last_write_time(_path);
+	uintmax_t const size = boost::filesystem::file_size(_path);
+
+	auto entry = m_entries.find(_path);
+	if (entry == m_entries.end() || entry->second.lastWriteTime != lastWriteTime || entry->second.size != size)
+		entry = m_entries.insert_or_assign(_path, Entry{lastWriteTime, size, readFileAsString(_path)}).first;
+	return entry->second.contents;
+}
+
+FileRepository::FileRepository(
+	boost::filesystem::path _basePath,
+	std::vector<boost::filesystem::path> _includePaths,
+	shared_ptr<DependencyCache> _dependencyCache
+):
 	m_basePath(std::move(_basePath)),
-	m_includePaths(std::move(_includePaths))
+	m_includePaths(std::move(_includePaths)),
+	m_dependencyCache(std::move(_dependencyCache))
 {
+	solAssert(m_dependencyCache);
 }
 
 void FileRepository::setIncludePaths(std::vector<boost::filesystem::path> _paths)
@@ -102,6 +131,11 @@ void FileRepository::setSourceByUri(string const& _uri, string _source)
 	m_sourceCodes[sourceUnitName] = std::move(_source);
 }
 
+void FileRepository::setSourceUnits(StringMap _sources)
+{
+	m_sourceCodes = std::move(_sources);
+}
+
 Result<boost::filesystem::path> FileRepository::tryResolvePath(std::string const& _strippedSourceUnitName) const
 {
 	if (
@@ -148,6 +182,19 @@ Result<boost::filesystem::path> FileRepository::tryResolvePath(std::string const
 	return candidates[0];
 }
 
+string FileRepository::readFromDisk(boost::filesystem::path const& _path) const
+{
+	bool const isDependency =
+		!isInsideDirectory(_path, m_basePath) ||
+		(m_includePaths.empty() && isInsideDirectory(_path, m_basePath / "node_modules")) ||
+		ranges::any_of(m_includePaths, [&](auto const& _includePath) { return isInsideDirectory(_path, _includePath); });
+
+	if (isDependency)
+		return m_dependencyCache->read(_path);
+	else
+		return readFileAsString(_path);
+}
+
 frontend::ReadCallback::Result FileRepository::readFile(string const& _kind, string const& _sourceUnitName)
 {
 	solAssert(
@@ -166,7 +213,7 @@ frontend::ReadCallback::Result FileRepository::readFile(string const& _kind, str
 		if (!resolvedPath.message().empty())
 			return ReadCallback::Result{false, resolvedPath.message()};
 
-		auto contents = readFileAsString(resolvedPath.get());
+		auto contents = readFromDisk(resolvedPath.get());
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
 		m_sourceCodes[_sourceUnitName] = contents;
 		return ReadCallback::Result{true, std::move(contents)};
@@ -20,16 +20,42 @@
 #include <libsolidity/interface/FileReader.h>
 #include <libsolutil/Result.h>
 
+#include <ctime>
+#include <memory>
 #include <string>
 #include <map>
 
 namespace solidity::lsp
 {
 
+/**
+ * Contents of dependency files read from disk, by their path. A file is only read again
+ * once its modification time or size changed.
+ */
+class DependencyCache
+{
+public:
+	/// @returns the contents of the file at @a _path.
+	std::string const& read(boost::filesystem::path const& _path);
+
+private:
+	struct Entry
+	{
+		std::time_t lastWriteTime;
+		std::uintmax_t size;
+		std::string contents;
+	};
+	std::map<boost::filesystem::path, Entry> m_entries;
+};
+
 class FileRepository
 {
 public:
-	FileRepository(boost::filesystem::path _basePath, std::vector<boost::filesystem::path> _includePaths);
+	FileRepository(
+		boost::filesystem::path _basePath,
+		std::vector<boost::filesystem::path> _includePaths,
+		std::shared_ptr<DependencyCache> _dependencyCache = std::make_shared<DependencyCache>()
+	);
 
 	std::vector<boost::filesystem::path> const& includePaths() const noexcept { return m_includePaths; }
 	void setIncludePaths(std::vector<boost::filesystem::path> _paths);
@@ -57,6 +83,13 @@ public:
 
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
+	/// @returns the contents of the file at @a _path. Dependency files, i.e. files outside of
+	/// the base path or inside of the include paths or the default ``node_modules`` directory,
+	/// are taken from the dependency cache if they did not change on disk.
+	std::string readFromDisk(boost::filesystem::path const& _path) const;
+
+	std::shared_ptr<DependencyCache> const& dependencyCache() const noexcept { return m_dependencyCache; }
+
 private:
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
@@ -69,6 +102,9 @@ private:
 
 	/// Mapping of source unit names to their file content.
 	StringMap m_sourceCodes;
+
+	/// Contents of dependency files, shared with the repositories of later compilations.
+	std::shared_ptr<DependencyCache> m_dependencyCache;
 };
 
 }
@@ -0,0 +1,36 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/FindReferences.h>
+
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+void FindReferences::operator()(MessageID _id, Json::Value const& _args)
+{
+	findOccurrences(_args);
+	sort(m_locations.begin(), m_locations.end());
+
+	Json::Value reply = Json::arrayValue;
+	bool const includeDeclaration = _args["context"]["includeDeclaration"].asBool();
+	for (SourceLocation const& location: m_locations)
+		if (includeDeclaration || location != m_declarationToRename->nameLocation())
+			reply.append(toJson(location));
+
+	client().reply(_id, reply);
+}
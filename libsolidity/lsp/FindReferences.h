@@ -0,0 +1,37 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/lsp/RenameSymbol.h>
+
+namespace solidity::lsp
+{
+
+/**
+ * Handler for ``textDocument/references``, which finds the same occurrences of a symbol
+ * that renaming it would change.
+ */
+class FindReferences: public RenameSymbol
+{
+public:
+	explicit FindReferences(LanguageServer& _server): RenameSymbol(_server) {}
+
+	void operator()(MessageID, Json::Value const&);
+};
+
+}
@@ -26,6 +26,7 @@
 
 // LSP feature implementations
 #include <libsolidity/lsp/DocumentHoverHandler.h>
+#include <libsolidity/lsp/FindReferences.h>
 #include <libsolidity/lsp/GotoDefinition.h>
 #include <libsolidity/lsp/RenameSymbol.h>
 #include <libsolidity/lsp/SemanticTokensBuilder.h>
@@ -33,6 +34,7 @@
 #include <liblangutil/SourceReferenceExtractor.h>
 #include <liblangutil/CharStream.h>
 
+#include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Visitor.h>
 #include <libsolutil/JSON.h>
@@ -129,6 +131,64 @@ Json::Value semanticTokensLegend()
 	return legend;
 }
 
+Json::Value toJsonArray(vector<int>::const_iterator _begin, vector<int>::const_iterator _end)
+{
+	Json::Value array = Json::arrayValue;
+	for (auto it = _begin; it != _end; ++it)
+		array.append(*it);
+	return array;
+}
+
+/// @returns a single edit that replaces the part of @a _old that differs from @a _new.
+Json::Value semanticTokensEdit(vector<int> const& _old, vector<int> const& _new)
+{
+	size_t prefix = 0;
+	while (prefix < _old.size() && prefix < _new.size() && _old[prefix] == _new[prefix])
+		++prefix;
+	size_t suffix = 0;
+	while (
+		suffix < _old.size() - prefix &&
+		suffix < _new.size() - prefix &&
+		_old[_old.size() - 1 - suffix] == _new[_new.size() - 1 - suffix]
+	)
+		++suffix;
+
+	Json::Value edit = Json::objectValue;
+	edit["start"] = Json::UInt64(prefix);
+	edit["deleteCount"] = Json::UInt64(_old.size() - prefix - suffix);
+	edit["data"] = toJsonArray(
+		_new.begin() + static_cast<ptrdiff_t>(prefix),
+		_new.end() - static_cast<ptrdiff_t>(suffix)
+	);
+	return edit;
+}
+
+/// @returns the tokens of @a _data that start in [_start, _end), encoded relative to the start of the document.
+vector<int> semanticTokensInRange(vector<int> const& _data, LineColumn const& _start, LineColumn const& _end)
+{
+	// Each token is encoded as five numbers, the first two of which are its position
+	// relative to the previous token.
+	vector<int> result;
+	LineColumn position{0, 0};
+	LineColumn lastIncluded{0, 0};
+	for (size_t index = 0; index + 5 <= _data.size(); index += 5)
+	{
+		position.column = _data[index] == 0 ? position.column + _data[index + 1] : _data[index + 1];
+		position.line += _data[index];
+		auto const key = make_pair(position.line, position.column);
+		if (key < make_pair(_start.line, _start.column))
+			continue;
+		if (key >= make_pair(_end.line, _end.column))
+			break;
+
+		result.emplace_back(position.line - lastIncluded.line);
+		result.emplace_back(position.line == lastIncluded.line ? position.column - lastIncluded.column : position.column);
+		result.insert(result.end(), _data.begin() + static_cast<ptrdiff_t>(index + 2), _data.begin() + static_cast<ptrdiff_t>(index + 5));
+		lastIncluded = position;
+	}
+	return result;
+}
+
 }
 
 LanguageServer::LanguageServer(Transport& _transport):
@@ -148,7 +208,10 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/hover", DocumentHoverHandler(*this) },
 		{"textDocument/rename", RenameSymbol(*this) },
 		{"textDocument/implementation", GotoDefinition(*this) },
+		{"textDocument/references", FindReferences(*this) },
 		{"textDocument/semanticTokens/full", bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
+		{"textDocument/semanticTokens/full/delta", bind(&LanguageServer::semanticTokensFullDelta, this, _1, _2)},
+		{"textDocument/semanticTokens/range", bind(&LanguageServer::semanticTokensRange, this, _1, _2)},
 		{"workspace/didChangeConfiguration", bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
@@ -189,6 +252,8 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 	}
 
 	m_settingsObject = _settings;
+	// Include paths may have changed, which affects the resolution of imports.
+	m_compiledSources.reset();
 	Json::Value jsonIncludePaths = _settings["include-paths"];
 
 	if (jsonIncludePaths)
@@ -241,7 +306,12 @@ void LanguageServer::compile()
 	// For files that are not open, we have to take changes on disk into account,
 	// so we just remove all non-open files.
 
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
+	// Files of dependencies are only read again if they changed on disk.
+	FileRepository oldRepository(
+		m_fileRepository.basePath(),
+		m_fileRepository.includePaths(),
+		m_fileRepository.dependencyCache()
+	);
 	swap(oldRepository, m_fileRepository);
 
 	// Load all solidity files from project.
@@ -251,7 +321,7 @@ void LanguageServer::compile()
 			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
 			m_fileRepository.setSourceByUri(
 				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
+				m_fileRepository.readFromDisk(projectFile)
 			);
 		}
 
@@ -262,15 +332,62 @@ void LanguageServer::compile()
 			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	if (!sourcesChangedSinceLastCompilation())
+	{
+		lspDebug("sources unchanged, reusing previous analysis");
+		// Restore the files read through the import callback during the last compilation.
+		m_fileRepository.setSourceUnits(*m_compiledSources);
+		return;
+	}
 
 	m_compilerStack.reset(false);
 	m_compilerStack.setSources(m_fileRepository.sourceUnits());
 	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	m_compiledSources = m_fileRepository.sourceUnits();
+	++m_compilationCount;
+}
+
+bool LanguageServer::sourcesChangedSinceLastCompilation() const
+{
+	// Only reuse a successful analysis. Otherwise, a failed import could be caused by a file
+	// that has been created in the meantime, which we would not notice.
+	if (!m_compiledSources || m_compilerStack.state() < CompilerStack::AnalysisPerformed)
+		return true;
+
+	StringMap const& sources = m_fileRepository.sourceUnits();
+	for (auto const& [sourceUnitName, content]: sources)
+	{
+		auto compiledSource = m_compiledSources->find(sourceUnitName);
+		if (compiledSource == m_compiledSources->end() || compiledSource->second != content)
+			return true;
+	}
+
+	// The remaining sources were read through the import callback, compare them to the files on disk.
+	for (auto const& [sourceUnitName, content]: *m_compiledSources)
+		if (!sources.count(sourceUnitName))
+		{
+			util::Result<boost::filesystem::path> const resolvedPath =
+				m_fileRepository.tryResolvePath(stripFileUriSchemePrefix(sourceUnitName));
+			if (!resolvedPath.message().empty())
+				return true;
+
+			try
+			{
+				if (m_fileRepository.readFromDisk(resolvedPath.get()) != content)
+					return true;
+			}
+			catch (std::exception const&)
+			{
+				return true;
+			}
+		}
+
+	return false;
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
+	m_compilationPending = false;
 	compile();
 
 	// These are the source units we will sent diagnostics to the client for sure,
@@ -331,11 +448,34 @@ void LanguageServer::compileAndUpdateDiagnostics()
 
 bool LanguageServer::run()
 {
+	// Messages that do not need the pending compilation to finish first.
+	// Definition and hover requests are answered from the last analysis.
+	static set<string> const methodsWithoutCompilation{
+		"$/cancelRequest",
+		"$/setTrace",
+		"cancelRequest",
+		"exit",
+		"shutdown",
+		"textDocument/definition",
+		"textDocument/didChange",
+		"textDocument/didClose",
+		"textDocument/didOpen",
+		"textDocument/hover",
+		"textDocument/implementation",
+	};
+
 	while (m_state != State::ExitRequested && m_state != State::ExitWithoutShutdown && !m_client.closed())
 	{
 		MessageID id;
 		try
 		{
+			// Only compile after a burst of changes is over.
+			if (m_compilationPending && !m_client.waitForInput(CompilationDebounceInterval))
+			{
+				compileAndUpdateDiagnostics();
+				continue;
+			}
+
 			optional<Json::Value> const jsonMessage = m_client.receive();
 			if (!jsonMessage)
 				continue;
@@ -346,6 +486,9 @@ bool LanguageServer::run()
 				id = (*jsonMessage)["id"];
 				lspDebug(fmt::format("received method call: {}", methodName));
 
+				if (m_compilationPending && !methodsWithoutCompilation.count(methodName))
+					compileAndUpdateDiagnostics();
+
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
 					handler(id, (*jsonMessage)["params"]);
 				else
@@ -409,6 +552,8 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 		setTrace(_args["trace"]);
 
 	m_fileRepository = FileRepository(rootPath, {});
+	m_compiledSources.reset();
+	m_semanticTokens.clear();
 	if (_args["initializationOptions"].isObject())
 		changeConfiguration(_args["initializationOptions"]);
 
@@ -420,10 +565,11 @@ void LanguageServer::handleInitialize(MessageID _id, Json::Value const& _args)
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 	replyArgs["capabilities"]["semanticTokensProvider"]["legend"] = semanticTokensLegend();
-	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = false;
-	replyArgs["capabilities"]["semanticTokensProvider"]["full"] = true; // XOR requests.full.delta = true
+	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = true;
+	replyArgs["capabilities"]["semanticTokensProvider"]["full"]["delta"] = true;
 	replyArgs["capabilities"]["renameProvider"] = true;
 	replyArgs["capabilities"]["hoverProvider"] = true;
+	replyArgs["capabilities"]["referencesProvider"] = true;
 
 	m_client.reply(_id, std::move(replyArgs));
 }
@@ -434,19 +580,79 @@ void LanguageServer::handleInitialized(MessageID, Json::Value const&)
 		compileAndUpdateDiagnostics();
 }
 
+LanguageServer::SemanticTokens const& LanguageServer::semanticTokens(string const& _uri)
+{
+	compile();
+
+	string const sourceName = m_fileRepository.uriToSourceUnitName(_uri);
+	SemanticTokens& tokens = m_semanticTokens[sourceName];
+	if (tokens.resultId.empty() || tokens.compilation != m_compilationCount)
+	{
+		SourceUnit const& ast = m_compilerStack.ast(sourceName);
+		Json::Value data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+		tokens.compilation = m_compilationCount;
+		tokens.resultId = to_string(m_nextSemanticTokensResultId++);
+		tokens.data.clear();
+		tokens.data.reserve(data.size());
+		for (Json::Value const& value: data)
+			tokens.data.emplace_back(value.asInt());
+	}
+	return tokens;
+}
+
 void LanguageServer::semanticTokensFull(MessageID _id, Json::Value const& _args)
 {
-	auto uri = _args["textDocument"]["uri"];
+	SemanticTokens const& tokens = semanticTokens(_args["textDocument"]["uri"].asString());
 
-	compile();
+	Json::Value reply = Json::objectValue;
+	reply["resultId"] = tokens.resultId;
+	reply["data"] = toJsonArray(tokens.data.begin(), tokens.data.end());
 
-	auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.as<string>());
-	SourceUnit const& ast = m_compilerStack.ast(sourceName);
-	m_compilerStack.charStream(sourceName);
-	Json::Value data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+	m_client.reply(_id, std::move(reply));
+}
+
+void LanguageServer::semanticTokensFullDelta(MessageID _id, Json::Value const& _args)
+{
+	string const uri = _args["textDocument"]["uri"].asString();
+	string const previousResultId = _args["previousResultId"].asString();
+
+	// Copy the previous tokens, because requesting the current ones overwrites them.
+	SemanticTokens const* cached = util::valueOrNullptr(m_semanticTokens, m_fileRepository.uriToSourceUnitName(uri));
+	optional<vector<int>> previousData;
+	if (cached && cached->resultId == previousResultId)
+		previousData = cached->data;
+
+	SemanticTokens const& tokens = semanticTokens(uri);
 
 	Json::Value reply = Json::objectValue;
-	reply["data"] = data;
+	reply["resultId"] = tokens.resultId;
+	if (!previousData)
+		reply["data"] = toJsonArray(tokens.data.begin(), tokens.data.end());
+	else
+	{
+		reply["edits"] = Json::arrayValue;
+		if (tokens.resultId != previousResultId)
+			reply["edits"].append(semanticTokensEdit(*previousData, tokens.data));
+	}
+
+	m_client.reply(_id, std::move(reply));
+}
+
+void LanguageServer::semanticTokensRange(MessageID _id, Json::Value const& _args)
+{
+	optional<LineColumn> start = parseLineColumn(_args["range"]["start"]);
+	optional<LineColumn> end = parseLineColumn(_args["range"]["end"]);
+	lspRequire(
+		start && end,
+		ErrorCode::InvalidParams,
+		"Invalid range: " + util::jsonCompactPrint(_args["range"])
+	);
+
+	SemanticTokens const& tokens = semanticTokens(_args["textDocument"]["uri"].asString());
+	vector<int> data = semanticTokensInRange(tokens.data, *start, *end);
+
+	Json::Value reply = Json::objectValue;
+	reply["data"] = toJsonArray(data.begin(), data.end());
 
 	m_client.reply(_id, std::move(reply));
 }
@@ -488,7 +694,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.insert(uri);
 	m_fileRepository.setSourceByUri(uri, std::move(text));
-	compileAndUpdateDiagnostics();
+	m_compilationPending = true;
 }
 
 void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
@@ -529,7 +735,7 @@ void LanguageServer::handleTextDocumentDidChange(Json::Value const& _args)
 		m_fileRepository.setSourceByUri(uri, std::move(text));
 	}
 
-	compileAndUpdateDiagnostics();
+	m_compilationPending = true;
 }
 
 void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
@@ -545,7 +751,21 @@ void LanguageServer::handleTextDocumentDidClose(Json::Value const& _args)
 	string uri = _args["textDocument"]["uri"].asString();
 	m_openFiles.erase(uri);
 
-	compileAndUpdateDiagnostics();
+	m_compilationPending = true;
+}
+
+ReferenceCollector::References const& LanguageServer::references()
+{
+	if (!m_references || m_referencesCompilation != m_compilationCount)
+	{
+		vector<SourceUnit const*> sourceUnits;
+		if (m_compilerStack.state() >= CompilerStack::AnalysisPerformed)
+			for (string const& sourceName: m_compilerStack.sourceNames())
+				sourceUnits.emplace_back(&m_compilerStack.ast(sourceName));
+		m_references = ReferenceCollector::collect(sourceUnits);
+		m_referencesCompilation = m_compilationCount;
+	}
+	return *m_references;
 }
 
 ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
@@ -559,10 +779,25 @@ tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std:
 		return {nullptr, -1};
 	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
 		return {nullptr, -1};
+	// The file might have been opened after the last analysis.
+	if (!util::contains(m_compilerStack.sourceNames(), _sourceUnitName))
+		return {nullptr, -1};
 
 	optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	if (m_astNodeIndicesCompilation != m_compilationCount)
+	{
+		m_astNodeIndices.clear();
+		m_astNodeIndicesCompilation = m_compilationCount;
+	}
+	auto index = m_astNodeIndices.find(_sourceUnitName);
+	if (index == m_astNodeIndices.end())
+		index = m_astNodeIndices.emplace(
+			_sourceUnitName,
+			InnermostASTNodeIndex{m_compilerStack.ast(_sourceUnitName)}
+		).first;
+
+	return {index->second.find(*sourcePos), *sourcePos};
 }
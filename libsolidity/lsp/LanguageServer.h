@@ -19,11 +19,14 @@
 
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
+#include <libsolidity/lsp/ReferenceCollector.h>
+#include <libsolidity/ast/ASTUtils.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
 #include <json/value.h>
 
+#include <chrono>
 #include <functional>
 #include <map>
 #include <optional>
@@ -80,6 +83,9 @@ public:
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the references to all declarations in the last analysis, which are collected
+	/// on the first call after each analysis.
+	ReferenceCollector::References const& references();
 
 private:
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
@@ -95,15 +101,35 @@ private:
 	void handleRename(Json::Value const& _args);
 	void handleGotoDefinition(MessageID _id, Json::Value const& _args);
 	void semanticTokensFull(MessageID _id, Json::Value const& _args);
+	/// Replies with the edits that turn the tokens of the previous reply into the current ones,
+	/// or with the full tokens if the previous result is not known anymore.
+	void semanticTokensFullDelta(MessageID _id, Json::Value const& _args);
+	void semanticTokensRange(MessageID _id, Json::Value const& _args);
 
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json::Value const&);
 
 	/// Compile everything until after analysis phase.
+	/// Does nothing if no source changed since the last successful analysis.
 	void compile();
 
+	/// @returns false if the sources that would be compiled now, including the files read
+	/// from disk through imports, are identical to the ones of the last successful analysis.
+	bool sourcesChangedSinceLastCompilation() const;
+
 	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
 
+	/// Encoded semantic tokens of a source unit and the ID they were sent to the client with.
+	struct SemanticTokens
+	{
+		size_t compilation = 0;
+		std::string resultId;
+		std::vector<int> data;
+	};
+	/// Compiles and @returns the semantic tokens of @a _uri, which are only rebuilt
+	/// if the source unit was compiled again since they were last requested.
+	SemanticTokens const& semanticTokens(std::string const& _uri);
+
 	using MessageHandler = std::function<void(MessageID, Json::Value const&)>;
 
 	Json::Value toRange(langutil::SourceLocation const& _location);
@@ -124,7 +150,30 @@ private:
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
+	/// Set when sources changed. The compilation is delayed until no further message arrives
+	/// within the debounce interval or until a request needs the up-to-date analysis.
+	bool m_compilationPending = false;
+	static constexpr std::chrono::milliseconds CompilationDebounceInterval{100};
+
 	frontend::CompilerStack m_compilerStack;
+	/// All sources of the last compilation, including those read through the import callback.
+	std::optional<StringMap> m_compiledSources;
+	/// Number of compilations so far, used to tell whether cached results are still valid.
+	size_t m_compilationCount = 0;
+
+	/// Indices of the AST nodes by offset, by source unit name. They are built on first use
+	/// and belong to the compilation with the number m_astNodeIndicesCompilation.
+	std::map<std::string, frontend::InnermostASTNodeIndex> m_astNodeIndices;
+	size_t m_astNodeIndicesCompilation = 0;
+
+	/// The references to all declarations, collected in the compilation with the number
+	/// m_referencesCompilation.
+	std::optional<ReferenceCollector::References> m_references;
+	size_t m_referencesCompilation = 0;
+
+	/// The semantic tokens last sent to the client, by source unit name.
+	std::map<std::string, SemanticTokens> m_semanticTokens;
+	size_t m_nextSemanticTokensResultId = 0;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
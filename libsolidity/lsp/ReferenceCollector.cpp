@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#include <libsolidity/lsp/ReferenceCollector.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <libyul/AST.h>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::lsp;
+using namespace std;
+
+ReferenceCollector::References ReferenceCollector::collect(vector<SourceUnit const*> const& _sourceUnits)
+{
+	ReferenceCollector collector;
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		sourceUnit->accept(collector);
+	return std::move(collector.m_references);
+}
+
+void ReferenceCollector::endVisit(ImportDirective const& _node)
+{
+	// Handles SourceUnit aliases
+	addDeclaration(_node);
+
+	for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
+		if (symbolAlias.alias != nullptr)
+			add(symbolAlias.symbol->annotation().referencedDeclaration, *symbolAlias.alias, symbolAlias.location);
+}
+
+void ReferenceCollector::endVisit(FunctionCall const& _node)
+{
+	auto const* functionType = dynamic_cast<FunctionType const*>(_node.expression().annotation().type);
+	if (!functionType || !functionType->hasDeclaration())
+		return;
+	auto const* functionDefinition = dynamic_cast<FunctionDefinition const*>(&functionType->declaration());
+	if (!functionDefinition)
+		return;
+
+	// The names of named arguments refer to the parameters of the called function.
+	for (size_t i = 0; i < _node.names().size(); i++)
+		if (_node.names()[i])
+			for (auto const& parameter: functionDefinition->parameters())
+				if (parameter && parameter->name() == *_node.names()[i])
+					add(parameter.get(), parameter->name(), _node.nameLocations()[i]);
+}
+
+void ReferenceCollector::endVisit(MemberAccess const& _node)
+{
+	add(_node.annotation().referencedDeclaration, _node.memberName(), _node.memberLocation());
+}
+
+void ReferenceCollector::endVisit(Identifier const& _node)
+{
+	add(_node.annotation().referencedDeclaration, _node.name(), _node.location());
+}
+
+void ReferenceCollector::endVisit(IdentifierPath const& _node)
+{
+	std::vector<Declaration const*>& declarations = _node.annotation().pathDeclarations;
+	solAssert(declarations.size() == _node.path().size());
+
+	for (size_t i = 0; i < _node.path().size(); i++)
+		add(declarations[i], _node.path()[i], _node.pathLocations()[i]);
+}
+
+void ReferenceCollector::endVisit(InlineAssembly const& _node)
+{
+	for (auto&& [identifier, externalReference]: _node.annotation().externalReferences)
+	{
+		string identifierName = identifier->name.str();
+		if (!externalReference.suffix.empty())
+			identifierName = identifierName.substr(0, identifierName.length() - externalReference.suffix.size() - 1);
+
+		SourceLocation location = yul::nativeLocationOf(*identifier);
+		location.end -= static_cast<int>(externalReference.suffix.size() + 1);
+
+		add(externalReference.declaration, std::move(identifierName), std::move(location));
+	}
+}
+
+void ReferenceCollector::addDeclaration(Declaration const& _declaration)
+{
+	add(&_declaration, _declaration.name(), _declaration.nameLocation());
+}
+
+void ReferenceCollector::add(Declaration const* _declaration, string _name, SourceLocation _location)
+{
+	if (_declaration)
+		m_references[{_declaration, std::move(_name)}].emplace_back(std::move(_location));
+}
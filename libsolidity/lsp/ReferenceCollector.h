@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsolidity/ast/ASTVisitor.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::lsp
+{
+
+/**
+ * Collects the locations of all names that refer to a declaration, including the names of the
+ * declarations themselves, by the declaration and the name it is referenced with.
+ */
+class ReferenceCollector: public frontend::ASTConstVisitor
+{
+public:
+	using References = std::map<
+		std::pair<frontend::Declaration const*, std::string>,
+		std::vector<langutil::SourceLocation>
+	>;
+
+	static References collect(std::vector<frontend::SourceUnit const*> const& _sourceUnits);
+
+	void endVisit(frontend::ImportDirective const& _node) override;
+	void endVisit(frontend::MemberAccess const& _node) override;
+	void endVisit(frontend::Identifier const& _node) override;
+	void endVisit(frontend::IdentifierPath const& _node) override;
+	void endVisit(frontend::FunctionCall const& _node) override;
+	void endVisit(frontend::InlineAssembly const& _node) override;
+
+	void endVisit(frontend::ContractDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::StructDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::EnumDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::EnumValue const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::UserDefinedValueTypeDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::VariableDeclaration const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::FunctionDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::ModifierDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::EventDefinition const& _node) override { addDeclaration(_node); }
+	void endVisit(frontend::ErrorDefinition const& _node) override { addDeclaration(_node); }
+
+private:
+	void addDeclaration(frontend::Declaration const& _declaration);
+	void add(frontend::Declaration const* _declaration, std::string _name, langutil::SourceLocation _location);
+
+	References m_references;
+};
+
+}
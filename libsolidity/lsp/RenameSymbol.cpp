@@ -50,43 +50,9 @@ CallableDeclaration const* extractCallableDeclaration(FunctionCall const& _funct
 
 void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 {
-	auto const&& [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
 	string const newName = _args["newName"].asString();
-	string const uri = _args["textDocument"]["uri"].asString();
-
-	ASTNode const* sourceNode = m_server.astNodeAtSourceLocation(sourceUnitName, lineColumn);
 
-	m_symbolName = {};
-	m_declarationToRename = nullptr;
-	m_sourceUnits = { &m_server.compilerStack().ast(sourceUnitName) };
-	m_locations.clear();
-
-	optional<int> cursorBytePosition = charStreamProvider()
-		.charStream(sourceUnitName)
-		.translateLineColumnToPosition(lineColumn);
-	solAssert(cursorBytePosition.has_value(), "Expected source pos");
-
-	extractNameAndDeclaration(*sourceNode, *cursorBytePosition);
-
-	// Find all source units using this symbol
-	for (auto const& [name, content]: fileRepository().sourceUnits())
-	{
-		auto const& sourceUnit = m_server.compilerStack().ast(name);
-		for (auto const* referencedSourceUnit: sourceUnit.referencedSourceUnits(true, util::convertContainer<set<SourceUnit const*>>(m_sourceUnits)))
-			if (*referencedSourceUnit->location().sourceName == sourceUnitName)
-			{
-				m_sourceUnits.insert(&sourceUnit);
-				break;
-			}
-	}
-
-	// Origin source unit should always be checked
-	m_sourceUnits.insert(&m_declarationToRename->sourceUnit());
-
-	Visitor visitor(*this);
-
-	for (auto const* sourceUnit: m_sourceUnits)
-		sourceUnit->accept(visitor);
+	findOccurrences(_args);
 
 	// Apply changes in reverse order (will iterate in reverse)
 	sort(m_locations.begin(), m_locations.end());
@@ -122,6 +88,28 @@ void RenameSymbol::operator()(MessageID _id, Json::Value const& _args)
 	client().reply(_id, reply);
 }
 
+void RenameSymbol::findOccurrences(Json::Value const& _args)
+{
+	auto const&& [sourceUnitName, lineColumn] = extractSourceUnitNameAndLineColumn(_args);
+
+	ASTNode const* sourceNode = m_server.astNodeAtSourceLocation(sourceUnitName, lineColumn);
+
+	m_symbolName = {};
+	m_declarationToRename = nullptr;
+	m_locations.clear();
+
+	optional<int> cursorBytePosition = charStreamProvider()
+		.charStream(sourceUnitName)
+		.translateLineColumnToPosition(lineColumn);
+	solAssert(cursorBytePosition.has_value(), "Expected source pos");
+
+	if (sourceNode)
+		extractNameAndDeclaration(*sourceNode, *cursorBytePosition);
+
+	if (m_declarationToRename)
+		m_locations = util::valueOrDefault(m_server.references(), pair<Declaration const*, string>{m_declarationToRename, m_symbolName});
+}
+
 void RenameSymbol::extractNameAndDeclaration(ASTNode const& _node, int _cursorBytePosition)
 {
 	// Identify symbol name and node
@@ -157,7 +145,8 @@ void RenameSymbol::extractNameAndDeclaration(ASTNode const& _node, int _cursorBy
 	else
 		solAssert(false, "Unexpected ASTNODE id: " + to_string(_node.id()));
 
-	lspDebug(fmt::format("Goal: rename '{}', loc: {}-{}", m_symbolName, m_declarationToRename->nameLocation().start, m_declarationToRename->nameLocation().end));
+	if (m_declarationToRename)
+		lspDebug(fmt::format("Goal: rename '{}', loc: {}-{}", m_symbolName, m_declarationToRename->nameLocation().start, m_declarationToRename->nameLocation().end));
 }
 
 void RenameSymbol::extractNameAndDeclaration(ImportDirective const& _importDirective, int _cursorBytePosition)
@@ -172,21 +161,6 @@ void RenameSymbol::extractNameAndDeclaration(ImportDirective const& _importDirec
 		}
 }
 
-void RenameSymbol::Visitor::endVisit(ImportDirective const& _node)
-{
-	// Handles SourceUnit aliases
-	if (handleGenericDeclaration(_node))
-		return;
-
-	for (ImportDirective::SymbolAlias const& symbolAlias: _node.symbolAliases())
-		if (
-			symbolAlias.alias != nullptr &&
-			*symbolAlias.alias == m_outer.m_symbolName &&
-			symbolAlias.symbol->annotation().referencedDeclaration == m_outer.m_declarationToRename
-		)
-			m_outer.m_locations.emplace_back(symbolAlias.location);
-}
-
 void RenameSymbol::extractNameAndDeclaration(FunctionCall const& _functionCall, int _cursorBytePosition)
 {
 	if (auto const* functionDefinition = extractCallableDeclaration(_functionCall))
@@ -204,44 +178,6 @@ void RenameSymbol::extractNameAndDeclaration(FunctionCall const& _functionCall,
 			}
 }
 
-void RenameSymbol::Visitor::endVisit(FunctionCall const& _node)
-{
-	SourceLocation nameLocationInFunctionCall;
-
-	for (size_t i = 0; i < _node.names().size(); i++)
-		if (_node.names()[i] && *_node.names()[i] == m_outer.m_symbolName)
-			nameLocationInFunctionCall = _node.nameLocations()[i];
-
-	if (!nameLocationInFunctionCall.isValid())
-		return;
-
-	if (auto const* functionDefinition = extractCallableDeclaration(_node))
-		for (size_t j = 0; j < functionDefinition->parameters().size(); j++)
-			if (
-				functionDefinition->parameters()[j] &&
-				*functionDefinition->parameters()[j] == *m_outer.m_declarationToRename
-			)
-				m_outer.m_locations.emplace_back(nameLocationInFunctionCall);
-}
-
-void RenameSymbol::Visitor::endVisit(MemberAccess const& _node)
-{
-	if (
-		m_outer.m_symbolName == _node.memberName() &&
-		*m_outer.m_declarationToRename == *_node.annotation().referencedDeclaration
-	)
-		m_outer.m_locations.emplace_back(_node.memberLocation());
-}
-
-void RenameSymbol::Visitor::endVisit(Identifier const& _node)
-{
-	if (
-		m_outer.m_symbolName == _node.name() &&
-		*m_outer.m_declarationToRename == *_node.annotation().referencedDeclaration
-	)
-		m_outer.m_locations.emplace_back(_node.location());
-}
-
 void RenameSymbol::extractNameAndDeclaration(IdentifierPath const& _identifierPath, int _cursorBytePosition)
 {
 	// iterate through the elements of the path to find the one the cursor is on
@@ -261,19 +197,6 @@ void RenameSymbol::extractNameAndDeclaration(IdentifierPath const& _identifierPa
 	}
 }
 
-void RenameSymbol::Visitor::endVisit(IdentifierPath const& _node)
-{
-	std::vector<Declaration const*>& declarations = _node.annotation().pathDeclarations;
-	solAssert(declarations.size() == _node.path().size());
-
-	for (size_t i = 0; i < _node.path().size(); i++)
-		if (
-			_node.path()[i] == m_outer.m_symbolName &&
-			declarations[i] == m_outer.m_declarationToRename
-		)
-			m_outer.m_locations.emplace_back(_node.pathLocations()[i]);
-}
-
 void RenameSymbol::extractNameAndDeclaration(InlineAssembly const& _inlineAssembly, int _cursorBytePosition)
 {
 	for (auto&& [identifier, externalReference]: _inlineAssembly.annotation().externalReferences)
@@ -292,25 +215,3 @@ void RenameSymbol::extractNameAndDeclaration(InlineAssembly const& _inlineAssemb
 		}
 	}
 }
-
-void RenameSymbol::Visitor::endVisit(InlineAssembly const& _node)
-{
-	for (auto&& [identifier, externalReference]: _node.annotation().externalReferences)
-	{
-		string identifierName = identifier->name.str();
-		if (!externalReference.suffix.empty())
-			identifierName = identifierName.substr(0, identifierName.length() - externalReference.suffix.size() - 1);
-
-		if (
-			externalReference.declaration == m_outer.m_declarationToRename &&
-			identifierName == m_outer.m_symbolName
-		)
-		{
-			SourceLocation location = yul::nativeLocationOf(*identifier);
-			location.end -= static_cast<int>(externalReference.suffix.size() + 1);
-
-			m_outer.m_locations.emplace_back(location);
-		}
-	}
-
-}
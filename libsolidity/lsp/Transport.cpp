@@ -35,6 +35,9 @@
 #if defined(_WIN32)
 #include <io.h>
 #include <fcntl.h>
+#else
+#include <poll.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -155,6 +158,11 @@ bool IOStreamTransport::closed() const noexcept
 	return m_input.eof();
 }
 
+bool IOStreamTransport::waitForInput(std::chrono::milliseconds)
+{
+	return m_input.rdbuf()->in_avail() > 0;
+}
+
 std::string IOStreamTransport::readBytes(size_t _length)
 {
 	return util::readBytes(m_input, _length);
@@ -192,6 +200,18 @@ bool StdioTransport::closed() const noexcept
 	return feof(stdin);
 }
 
+bool StdioTransport::waitForInput(std::chrono::milliseconds _timeout)
+{
+#if defined(_WIN32)
+	(void)_timeout;
+	return false;
+#else
+	// Note that this does not see input that is already buffered by stdio.
+	pollfd standardInput{STDIN_FILENO, POLLIN, 0};
+	return poll(&standardInput, 1, static_cast<int>(_timeout.count())) > 0;
+#endif
+}
+
 std::string StdioTransport::readBytes(size_t _byteCount)
 {
 	std::string buffer;
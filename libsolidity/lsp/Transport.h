@@ -21,6 +21,7 @@
 
 #include <json/value.h>
 
+#include <chrono>
 #include <functional>
 #include <iosfwd>
 #include <map>
@@ -105,6 +106,10 @@ public:
 
 	virtual bool closed() const noexcept = 0;
 
+	/// @returns true if more input arrives within @p _timeout.
+	/// Transports that cannot tell return false immediately.
+	virtual bool waitForInput(std::chrono::milliseconds /*_timeout*/) { return false; }
+
 	void trace(std::string _message, Json::Value _extra = Json::nullValue);
 
 	TraceValue traceValue() const noexcept { return m_logTrace; }
@@ -151,6 +156,8 @@ public:
 	IOStreamTransport(std::istream& _in, std::ostream& _out);
 
 	bool closed() const noexcept override;
+	/// Does not wait, only checks if input is buffered already.
+	bool waitForInput(std::chrono::milliseconds _timeout) override;
 
 protected:
 	std::string readBytes(size_t _byteCount) override;
@@ -172,6 +179,7 @@ public:
 	StdioTransport();
 
 	bool closed() const noexcept override;
+	bool waitForInput(std::chrono::milliseconds _timeout) override;
 
 protected:
 	std::string readBytes(size_t _byteCount) override;
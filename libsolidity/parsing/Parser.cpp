@@ -22,6 +22,7 @@
  */
 
 #include <libsolidity/parsing/Parser.h>
+#include <libsolidity/ast/ASTArena.h>
 
 #include <libsolidity/interface/Version.h>
 #include <libyul/AST.h>
@@ -73,7 +74,12 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return allocate_shared<NodeType>(
+			ASTArenaAllocator<NodeType>(m_parser.m_arena),
+			m_parser.nextID(),
+			m_location,
+			std::forward<Args>(_args)...
+		);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -90,6 +96,7 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	{
 		m_recursionDepth = 0;
 		m_scanner = make_shared<Scanner>(_charStream);
+		m_arena = make_shared<ASTArena>();
 		ASTNodeFactory nodeFactory(*this);
 
 		vector<ASTPointer<ASTNode>> nodes;
@@ -1393,7 +1400,15 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(*block).end;
-	return make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), block);
+	return allocate_shared<InlineAssembly>(
+		ASTArenaAllocator<InlineAssembly>(m_arena),
+		nextID(),
+		location,
+		_docString,
+		dialect,
+		std::move(flags),
+		block
+	);
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -35,6 +35,8 @@ class CharStream;
 namespace solidity::frontend
 {
 
+class ASTArena;
+
 class Parser: public langutil::ParserBase
 {
 public:
@@ -49,6 +51,9 @@ public:
 
 	ASTPointer<SourceUnit> parse(langutil::CharStream& _charStream);
 
+	/// @returns the number of AST node IDs handed out by this parser so far.
+	int64_t nodeIDCount() const { return m_currentNodeID; }
+
 private:
 	class ASTNodeFactory;
 
@@ -226,6 +231,8 @@ private:
 	langutil::EVMVersion m_evmVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// Arena for the nodes of the source unit that is currently parsed.
+	std::shared_ptr<ASTArena> m_arena;
 };
 
 }
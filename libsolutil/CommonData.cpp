@@ -29,6 +29,8 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <cstring>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -39,6 +41,49 @@ namespace
 static char const* upperHexChars = "0123456789ABCDEF";
 static char const* lowerHexChars = "0123456789abcdef";
 
+/// The two hex characters of every byte value, so that a byte is converted with a single lookup.
+struct HexPairTable
+{
+	constexpr HexPairTable(char const* _chars): pairs{}
+	{
+		for (size_t i = 0; i < 256; ++i)
+		{
+			pairs[2 * i] = _chars[i >> 4];
+			pairs[2 * i + 1] = _chars[i & 0xf];
+		}
+	}
+	char pairs[512];
+};
+
+static constexpr HexPairTable upperHexPairs{"0123456789ABCDEF"};
+static constexpr HexPairTable lowerHexPairs{"0123456789abcdef"};
+
+/// The value of every hex character, -1 for all other characters.
+struct HexValueTable
+{
+	constexpr HexValueTable(): values{}
+	{
+		for (size_t i = 0; i < 256; ++i)
+			values[i] = -1;
+		for (int i = 0; i < 10; ++i)
+			values['0' + i] = static_cast<int8_t>(i);
+		for (int i = 0; i < 6; ++i)
+			values['a' + i] = values['A' + i] = static_cast<int8_t>(10 + i);
+	}
+	int8_t values[256];
+};
+
+static constexpr HexValueTable hexValues{};
+
+int hexValue(char _c, WhenError _throw)
+{
+	int value = hexValues.values[static_cast<uint8_t>(_c)];
+	if (value == -1)
+		// Reports the error the same way as for a single character.
+		return fromHex(_c, _throw);
+	return value;
+}
+
 }
 
 string solidity::util::toHex(uint8_t _data, HexCase _case)
@@ -65,16 +110,16 @@ string solidity::util::toHex(bytes const& _data, HexPrefix _prefix, HexCase _cas
 	}
 
 	// Mixed case will be handled inside the loop.
-	char const* chars = _case == HexCase::Upper ? upperHexChars : lowerHexChars;
+	char const* pairs = _case == HexCase::Upper ? upperHexPairs.pairs : lowerHexPairs.pairs;
 	size_t rix = _data.size() - 1;
 	for (uint8_t c: _data)
 	{
 		// switch hex case every four hexchars
 		if (_case == HexCase::Mixed)
-			chars = (rix-- & 2) == 0 ? lowerHexChars : upperHexChars;
+			pairs = (rix-- & 2) == 0 ? lowerHexPairs.pairs : upperHexPairs.pairs;
 
-		ret[i++] = chars[(static_cast<size_t>(c) >> 4ul) & 0xfu];
-		ret[i++] = chars[c & 0xfu];
+		memcpy(&ret[i], pairs + 2 * size_t(c), 2);
+		i += 2;
 	}
 	assertThrow(i == ret.size(), Exception, "");
 
@@ -106,7 +151,7 @@ bytes solidity::util::fromHex(std::string const& _s, WhenError _throw)
 
 	if (_s.size() % 2)
 	{
-		int h = fromHex(_s[s++], _throw);
+		int h = hexValue(_s[s++], _throw);
 		if (h != -1)
 			ret.push_back(static_cast<uint8_t>(h));
 		else
@@ -114,8 +159,8 @@ bytes solidity::util::fromHex(std::string const& _s, WhenError _throw)
 	}
 	for (unsigned i = s; i < _s.size(); i += 2)
 	{
-		int h = fromHex(_s[i], _throw);
-		int l = fromHex(_s[i + 1], _throw);
+		int h = hexValue(_s[i], _throw);
+		int l = hexValue(_s[i + 1], _throw);
 		if (h != -1 && l != -1)
 			ret.push_back(static_cast<uint8_t>(h * 16 + l));
 		else
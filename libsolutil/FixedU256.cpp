@@ -0,0 +1,193 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/FixedU256.h>
+
+using namespace std;
+using namespace solidity;
+
+namespace
+{
+
+using Limb = boost::multiprecision::limb_type;
+/// Number of boost limbs that make up one 64-bit limb.
+size_t constexpr c_limbsPerWord = sizeof(uint64_t) / sizeof(Limb);
+static_assert(c_limbsPerWord == 1 || c_limbsPerWord == 2, "Unsupported limb size.");
+
+}
+
+FixedU256::FixedU256(u256 const& _value)
+{
+	auto const& backend = _value.backend();
+	for (size_t i = 0; i < backend.size(); ++i)
+		m_limbs[i / c_limbsPerWord] |= static_cast<uint64_t>(backend.limbs()[i]) << (8 * sizeof(Limb) * (i % c_limbsPerWord));
+}
+
+u256 FixedU256::toU256() const
+{
+	u256 result;
+	auto& backend = result.backend();
+	backend.resize(static_cast<unsigned>(4 * c_limbsPerWord), static_cast<unsigned>(4 * c_limbsPerWord));
+	for (size_t i = 0; i < 4 * c_limbsPerWord; ++i)
+		backend.limbs()[i] = static_cast<Limb>(m_limbs[i / c_limbsPerWord] >> (8 * sizeof(Limb) * (i % c_limbsPerWord)));
+	backend.normalize();
+	return result;
+}
+
+size_t FixedU256::bitLength() const
+{
+	for (size_t i = 4; i-- > 0;)
+		if (m_limbs[i] != 0)
+		{
+			size_t length = 64 * i;
+			for (uint64_t limb = m_limbs[i]; limb != 0; limb >>= 1)
+				++length;
+			return length;
+		}
+	return 0;
+}
+
+pair<FixedU256, FixedU256> FixedU256::divMod(FixedU256 const& _a, FixedU256 const& _b)
+{
+	if (_b.isZero())
+		return {0, 0};
+	if (_a < _b)
+		return {0, _a};
+
+	// Long division on 32-bit digits following Knuth's algorithm D (TAOCP vol. 2, 4.3.1),
+	// so that every step only needs 64-bit arithmetic.
+	uint64_t constexpr base = uint64_t(1) << 32;
+	auto digits = [](FixedU256 const& _value, array<uint32_t, 9>& o_digits) {
+		size_t count = 0;
+		for (size_t i = 0; i < 8; ++i)
+		{
+			o_digits[i] = static_cast<uint32_t>(_value.m_limbs[i / 2] >> (32 * (i % 2)));
+			if (o_digits[i] != 0)
+				count = i + 1;
+		}
+		return count;
+	};
+	array<uint32_t, 9> u{};
+	array<uint32_t, 9> v{};
+	size_t const m = digits(_a, u);
+	size_t const n = digits(_b, v);
+	array<uint32_t, 8> q{};
+	array<uint32_t, 8> r{};
+
+	if (n == 1)
+	{
+		uint64_t remainder = 0;
+		for (size_t i = m; i-- > 0;)
+		{
+			uint64_t const current = (remainder << 32) | u[i];
+			q[i] = static_cast<uint32_t>(current / v[0]);
+			remainder = current % v[0];
+		}
+		r[0] = static_cast<uint32_t>(remainder);
+	}
+	else
+	{
+		// Normalize so that the most significant digit of the divisor has its highest bit set.
+		unsigned shift = 0;
+		while ((v[n - 1] << shift & 0x80000000) == 0)
+			++shift;
+		array<uint32_t, 8> vn{};
+		array<uint32_t, 9> un{};
+		for (size_t i = n - 1; i > 0; --i)
+			vn[i] = static_cast<uint32_t>((v[i] << shift) | (shift ? v[i - 1] >> (32 - shift) : 0));
+		vn[0] = v[0] << shift;
+		un[m] = shift ? u[m - 1] >> (32 - shift) : 0;
+		for (size_t i = m - 1; i > 0; --i)
+			un[i] = static_cast<uint32_t>((u[i] << shift) | (shift ? u[i - 1] >> (32 - shift) : 0));
+		un[0] = u[0] << shift;
+
+		for (size_t j = m - n + 1; j-- > 0;)
+		{
+			// Estimate the quotient digit from the two leading digits and correct it.
+			uint64_t const numerator = (uint64_t(un[j + n]) << 32) | un[j + n - 1];
+			uint64_t qhat = numerator / vn[n - 1];
+			uint64_t rhat = numerator % vn[n - 1];
+			while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2]))
+			{
+				--qhat;
+				rhat += vn[n - 1];
+				if (rhat >= base)
+					break;
+			}
+
+			// Multiply and subtract.
+			int64_t borrow = 0;
+			int64_t t = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				uint64_t const product = qhat * vn[i];
+				t = int64_t(un[i + j]) - borrow - int64_t(product & 0xffffffff);
+				un[i + j] = static_cast<uint32_t>(t);
+				borrow = int64_t(product >> 32) - (t >> 32);
+			}
+			t = int64_t(un[j + n]) - borrow;
+			un[j + n] = static_cast<uint32_t>(t);
+
+			q[j] = static_cast<uint32_t>(qhat);
+			if (t < 0)
+			{
+				// The estimate was one too large, add the divisor back.
+				--q[j];
+				uint64_t carry = 0;
+				for (size_t i = 0; i < n; ++i)
+				{
+					uint64_t const sum = uint64_t(un[i + j]) + vn[i] + carry;
+					un[i + j] = static_cast<uint32_t>(sum);
+					carry = sum >> 32;
+				}
+				un[j + n] = static_cast<uint32_t>(un[j + n] + carry);
+			}
+		}
+
+		for (size_t i = 0; i < n; ++i)
+			r[i] = static_cast<uint32_t>((un[i] >> shift) | (shift ? uint64_t(un[i + 1]) << (32 - shift) : 0));
+	}
+
+	auto fromDigits = [](array<uint32_t, 8> const& _digits) {
+		FixedU256 result;
+		for (size_t i = 0; i < 4; ++i)
+			result.m_limbs[i] = uint64_t(_digits[2 * i]) | (uint64_t(_digits[2 * i + 1]) << 32);
+		return result;
+	};
+	return {fromDigits(q), fromDigits(r)};
+}
+
+FixedU256 FixedU256::exp(FixedU256 _base, FixedU256 const& _exponent)
+{
+	FixedU256 result = 1;
+	size_t const length = _exponent.bitLength();
+	for (size_t i = 0; i < length; ++i)
+	{
+		// The square of an even number has more trailing zero bits, so the powers of even
+		// bases quickly become zero.
+		if (_base.isZero())
+			return 0;
+		if (_base == 1)
+			break;
+		if (_exponent.bit(i))
+			result = result * _base;
+		if (i + 1 < length)
+			_base = _base * _base;
+	}
+	return result;
+}
@@ -0,0 +1,209 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-width unsigned 256-bit integer for the evaluation of EVM arithmetic on constants.
+ */
+
+#pragma once
+
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace solidity
+{
+
+/**
+ * Unsigned 256-bit integer stored in four 64-bit limbs with arithmetic modulo 2**256.
+ *
+ * In contrast to u256, whose implementation supports numbers of arbitrary size, all operations
+ * work on a fixed number of limbs and never allocate. This makes the expensive operations like
+ * multiplication, division and exponentiation several times faster. Values are converted from
+ * and to u256 at the boundaries of the code that uses it.
+ *
+ * Division and modulo by zero result in zero, as in the EVM.
+ */
+class FixedU256
+{
+public:
+	constexpr FixedU256() = default;
+	constexpr FixedU256(uint64_t _value): m_limbs{{_value, 0, 0, 0}} {}
+	explicit FixedU256(u256 const& _value);
+
+	u256 toU256() const;
+
+	/// @returns the limbs, least significant first.
+	std::array<uint64_t, 4> const& limbs() const { return m_limbs; }
+
+	bool isZero() const { return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	bool bit(size_t _index) const { return ((m_limbs[_index / 64] >> (_index % 64)) & 1) != 0; }
+	/// @returns the number of bits needed to represent the value, i.e. zero for zero.
+	size_t bitLength() const;
+
+	friend bool operator==(FixedU256 const& _a, FixedU256 const& _b) { return _a.m_limbs == _b.m_limbs; }
+	friend bool operator!=(FixedU256 const& _a, FixedU256 const& _b) { return _a.m_limbs != _b.m_limbs; }
+	friend bool operator<(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		for (size_t i = 4; i-- > 0;)
+			if (_a.m_limbs[i] != _b.m_limbs[i])
+				return _a.m_limbs[i] < _b.m_limbs[i];
+		return false;
+	}
+	friend bool operator>(FixedU256 const& _a, FixedU256 const& _b) { return _b < _a; }
+	friend bool operator<=(FixedU256 const& _a, FixedU256 const& _b) { return !(_b < _a); }
+	friend bool operator>=(FixedU256 const& _a, FixedU256 const& _b) { return !(_a < _b); }
+
+	friend FixedU256 operator+(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		uint64_t carry = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint64_t const sum = _a.m_limbs[i] + carry;
+			carry = static_cast<uint64_t>(sum < carry);
+			result.m_limbs[i] = sum + _b.m_limbs[i];
+			carry += static_cast<uint64_t>(result.m_limbs[i] < sum);
+		}
+		return result;
+	}
+
+	friend FixedU256 operator-(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint64_t const difference = _a.m_limbs[i] - borrow;
+			borrow = static_cast<uint64_t>(difference > _a.m_limbs[i]);
+			result.m_limbs[i] = difference - _b.m_limbs[i];
+			borrow += static_cast<uint64_t>(result.m_limbs[i] > difference);
+		}
+		return result;
+	}
+
+	friend FixedU256 operator*(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		FixedU256 result;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint64_t carry = 0;
+			for (size_t j = 0; i + j < 4; ++j)
+			{
+				// result + a * b + carry is less than 2**128, so the high part does not overflow.
+				uint64_t high = 0;
+				uint64_t const low = multiply(_a.m_limbs[i], _b.m_limbs[j], high);
+				uint64_t const sum = result.m_limbs[i + j] + low;
+				high += static_cast<uint64_t>(sum < low);
+				result.m_limbs[i + j] = sum + carry;
+				high += static_cast<uint64_t>(result.m_limbs[i + j] < carry);
+				carry = high;
+			}
+		}
+		return result;
+	}
+
+	friend FixedU256 operator/(FixedU256 const& _a, FixedU256 const& _b) { return divMod(_a, _b).first; }
+	friend FixedU256 operator%(FixedU256 const& _a, FixedU256 const& _b) { return divMod(_a, _b).second; }
+
+	friend FixedU256 operator&(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		return {_a.m_limbs[0] & _b.m_limbs[0], _a.m_limbs[1] & _b.m_limbs[1], _a.m_limbs[2] & _b.m_limbs[2], _a.m_limbs[3] & _b.m_limbs[3]};
+	}
+	friend FixedU256 operator|(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		return {_a.m_limbs[0] | _b.m_limbs[0], _a.m_limbs[1] | _b.m_limbs[1], _a.m_limbs[2] | _b.m_limbs[2], _a.m_limbs[3] | _b.m_limbs[3]};
+	}
+	friend FixedU256 operator^(FixedU256 const& _a, FixedU256 const& _b)
+	{
+		return {_a.m_limbs[0] ^ _b.m_limbs[0], _a.m_limbs[1] ^ _b.m_limbs[1], _a.m_limbs[2] ^ _b.m_limbs[2], _a.m_limbs[3] ^ _b.m_limbs[3]};
+	}
+	friend FixedU256 operator~(FixedU256 const& _a)
+	{
+		return {~_a.m_limbs[0], ~_a.m_limbs[1], ~_a.m_limbs[2], ~_a.m_limbs[3]};
+	}
+
+	friend FixedU256 operator<<(FixedU256 const& _a, size_t _shift)
+	{
+		FixedU256 result;
+		if (_shift >= 256)
+			return result;
+		size_t const limbShift = _shift / 64;
+		size_t const bitShift = _shift % 64;
+		for (size_t i = limbShift; i < 4; ++i)
+		{
+			result.m_limbs[i] = _a.m_limbs[i - limbShift] << bitShift;
+			if (bitShift != 0 && i > limbShift)
+				result.m_limbs[i] |= _a.m_limbs[i - limbShift - 1] >> (64 - bitShift);
+		}
+		return result;
+	}
+
+	friend FixedU256 operator>>(FixedU256 const& _a, size_t _shift)
+	{
+		FixedU256 result;
+		if (_shift >= 256)
+			return result;
+		size_t const limbShift = _shift / 64;
+		size_t const bitShift = _shift % 64;
+		for (size_t i = 0; i + limbShift < 4; ++i)
+		{
+			result.m_limbs[i] = _a.m_limbs[i + limbShift] >> bitShift;
+			if (bitShift != 0 && i + limbShift + 1 < 4)
+				result.m_limbs[i] |= _a.m_limbs[i + limbShift + 1] << (64 - bitShift);
+		}
+		return result;
+	}
+
+	/// @returns the quotient and the remainder of @a _a divided by @a _b, both zero if @a _b is zero.
+	static std::pair<FixedU256, FixedU256> divMod(FixedU256 const& _a, FixedU256 const& _b);
+
+	/// @returns @a _base to the power of @a _exponent modulo 2**256.
+	static FixedU256 exp(FixedU256 _base, FixedU256 const& _exponent);
+
+private:
+	constexpr FixedU256(uint64_t _limb0, uint64_t _limb1, uint64_t _limb2, uint64_t _limb3):
+		m_limbs{{_limb0, _limb1, _limb2, _limb3}}
+	{}
+
+	/// @returns the low 64 bits of @a _a * @a _b and stores the high 64 bits in @a o_high.
+	static uint64_t multiply(uint64_t _a, uint64_t _b, uint64_t& o_high)
+	{
+#ifdef __SIZEOF_INT128__
+		__extension__ using UInt128 = unsigned __int128;
+		UInt128 const product = static_cast<UInt128>(_a) * _b;
+		o_high = static_cast<uint64_t>(product >> 64);
+		return static_cast<uint64_t>(product);
+#else
+		uint64_t const mask = 0xffffffff;
+		uint64_t const lowLow = (_a & mask) * (_b & mask);
+		uint64_t const lowHigh = (_a & mask) * (_b >> 32);
+		uint64_t const highLow = (_a >> 32) * (_b & mask);
+		uint64_t const highHigh = (_a >> 32) * (_b >> 32);
+		uint64_t const middle = (lowLow >> 32) + (lowHigh & mask) + (highLow & mask);
+		o_high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+		return (middle << 32) | (lowLow & mask);
+#endif
+	}
+
+	std::array<uint64_t, 4> m_limbs{};
+};
+
+}
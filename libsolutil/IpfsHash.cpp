@@ -19,9 +19,9 @@
 #include <libsolutil/IpfsHash.h>
 
 #include <libsolutil/Exceptions.h>
-#include <libsolutil/picosha2.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Numeric.h>
+#include <libsolutil/SHA256.h>
 
 using namespace std;
 using namespace solidity;
@@ -48,7 +48,7 @@ bytes encodeByteArray(bytes const& _data)
 
 bytes encodeHash(bytes const& _data)
 {
-	return bytes{0x12, 0x20} + picosha2::hash256(_data);
+	return bytes{0x12, 0x20} + sha256(_data).asBytes();
 }
 
 bytes encodeLinkData(bytes const& _data)
@@ -59,7 +59,8 @@ bytes encodeLinkData(bytes const& _data)
 string base58Encode(bytes const& _data)
 {
 	static string const alphabet{"123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz"};
-	bigint data(util::toHex(_data, HexPrefix::Add));
+	bigint data;
+	boost::multiprecision::import_bits(data, _data.begin(), _data.end());
 	string output;
 	while (data)
 	{
@@ -70,31 +71,98 @@ string base58Encode(bytes const& _data)
 	return output;
 }
 
-struct Chunk
+size_t constexpr maxChunkSize = 1024 * 256;
+size_t constexpr maxChildNum = 174;
+}
+
+void IpfsHasher::update(bytesConstRef _data)
 {
-	Chunk() = default;
-	Chunk(bytes _hash, size_t _size, size_t _blockSize):
-		hash(std::move(_hash)),
-		size(_size),
-		blockSize(_blockSize)
-	{}
+	while (!_data.empty())
+	{
+		if (m_chunk.size() == maxChunkSize)
+			flushChunk();
+		size_t size = min(maxChunkSize - m_chunk.size(), _data.size());
+		m_chunk.insert(m_chunk.end(), _data.begin(), _data.begin() + size);
+		_data = _data.cropped(size);
+	}
+}
+
+bytes IpfsHasher::finalize()
+{
+	// Data that fills the last chunk exactly does not need another (empty) chunk,
+	// but a file without data still consists of one.
+	if (!m_chunk.empty() || !m_hasData)
+		flushChunk();
+
+	// Combines the remaining nodes bottom up, until the top level has a single node
+	// and no lower level has nodes without a parent.
+	for (size_t level = 0; ; ++level)
+	{
+		if (level + 1 == m_levels.size() && m_levels[level].size() == 1)
+			return std::move(m_levels[level].front().hash);
+		if (!m_levels[level].empty())
+		{
+			Link link = combineLinks(m_levels[level]);
+			m_levels[level].clear();
+			addLink(level + 1, std::move(link));
+		}
+	}
+}
 
-	bytes hash = {};
-	size_t size = 0;
-	size_t blockSize = 0;
-};
+void IpfsHasher::flushChunk()
+{
+	bytes lengthAsVarint = varintEncoding(m_chunk.size());
+
+	// Type: File
+	bytes protobufPrefix{0x08, 0x02};
+	if (!m_chunk.empty())
+		// Data (length delimited bytes)
+		protobufPrefix += bytes{0x12} + lengthAsVarint;
+	// filesize: length as varint
+	bytes protobufSuffix = bytes{0x18} + lengthAsVarint;
+	size_t protobufSize = protobufPrefix.size() + m_chunk.size() + protobufSuffix.size();
+
+	// PBDag:
+	// Data: (length delimited bytes)
+	bytes blockPrefix = bytes{0x0a} + varintEncoding(protobufSize) + protobufPrefix;
+
+	// Multihash: sha2-256, 256 bits
+	SHA256Hasher hasher;
+	hasher.update(&blockPrefix);
+	hasher.update(&m_chunk);
+	hasher.update(&protobufSuffix);
+
+	addLink(0, {
+		bytes{0x12, 0x20} + hasher.finalize().asBytes(),
+		m_chunk.size(),
+		blockPrefix.size() + m_chunk.size() + protobufSuffix.size()
+	});
+	m_chunk.clear();
+	m_hasData = true;
+}
 
-using Chunks = vector<Chunk>;
+void IpfsHasher::addLink(size_t _level, Link _link)
+{
+	if (m_levels.size() <= _level)
+		m_levels.resize(_level + 1);
+	m_levels[_level].emplace_back(std::move(_link));
+	if (m_levels[_level].size() == maxChildNum)
+	{
+		Link link = combineLinks(m_levels[_level]);
+		m_levels[_level].clear();
+		addLink(_level + 1, std::move(link));
+	}
+}
 
-Chunk combineLinks(Chunks& _links)
+IpfsHasher::Link IpfsHasher::combineLinks(vector<Link>& _links)
 {
 	bytes data = {};
 	bytes lengths = {};
-	Chunk chunk = {};
-	for (Chunk& link: _links)
+	Link combined = {};
+	for (Link& link: _links)
 	{
-		chunk.size += link.size;
-		chunk.blockSize += link.blockSize;
+		combined.size += link.size;
+		combined.blockSize += link.blockSize;
 
 		data += encodeLinkData(
 			bytes {0x0a} +
@@ -107,97 +175,22 @@ Chunk combineLinks(Chunks& _links)
 		lengths += bytes{0x20} + varintEncoding(link.size);
 	}
 
-	bytes blockData = data + encodeByteArray(bytes{0x08, 0x02, 0x18} + varintEncoding(chunk.size) + lengths);
-
-	chunk.blockSize += blockData.size();
-	chunk.hash = encodeHash(blockData);
-
-	return chunk;
-}
-
-Chunks buildNextLevel(Chunks& _currentLevel)
-{
-	size_t const maxChildNum = 174;
-
-	Chunks nextLevel;
-	Chunks links;
-
-	for (Chunk& chunk: _currentLevel)
-	{
-		links.emplace_back(std::move(chunk.hash), chunk.size, chunk.blockSize);
-		if (links.size() == maxChildNum)
-		{
-			nextLevel.emplace_back(combineLinks(links));
-			links = {};
-		}
-	}
-	if (!links.empty())
-		nextLevel.emplace_back(combineLinks(links));
-
-	return nextLevel;
-}
+	bytes blockData = data + encodeByteArray(bytes{0x08, 0x02, 0x18} + varintEncoding(combined.size) + lengths);
 
-/// Builds a tree starting from the bottom level where nodes are data nodes.
-/// Data nodes should be calculated and passed as the only level in chunk levels
-/// Each next level is calculated as following:
-///   - Pick up to maxChildNum (174) nodes until a whole level is added, group them and pass to the node in the next level
-///   - Do this until the current level has only one node, return the hash in that node
-bytes groupChunksBottomUp(Chunks _currentLevel)
-{
-	// when we reach root it will be the only node in that level
-	while (_currentLevel.size() != 1)
-		_currentLevel = buildNextLevel(_currentLevel);
+	combined.blockSize += blockData.size();
+	combined.hash = encodeHash(blockData);
 
-	// top level's only node stores the hash for file
-	return _currentLevel.front().hash;
-}
+	return combined;
 }
 
-bytes solidity::util::ipfsHash(string _data)
+bytes solidity::util::ipfsHash(string const& _data)
 {
-	size_t const maxChunkSize = 1024 * 256;
-	size_t chunkCount = _data.length() / maxChunkSize + (_data.length() % maxChunkSize > 0 ? 1 : 0);
-	chunkCount = chunkCount == 0 ? 1 : chunkCount;
-
-	Chunks allChunks;
-
-	for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++)
-	{
-		bytes chunkBytes = asBytes(
-			_data.substr(chunkIndex * maxChunkSize, min(maxChunkSize, _data.length() - chunkIndex * maxChunkSize))
-		);
-
-		bytes lengthAsVarint = varintEncoding(chunkBytes.size());
-
-		bytes protobufEncodedData;
-		// Type: File
-		protobufEncodedData += bytes{0x08, 0x02};
-		if (!chunkBytes.empty())
-		{
-			// Data (length delimited bytes)
-			protobufEncodedData += bytes{0x12};
-			protobufEncodedData += lengthAsVarint;
-			protobufEncodedData += chunkBytes;
-		}
-		// filesize: length as varint
-		protobufEncodedData += bytes{0x18} + lengthAsVarint;
-
-		// PBDag:
-		// Data: (length delimited bytes)
-		bytes blockData = encodeByteArray(protobufEncodedData);
-
-		// Multihash: sha2-256, 256 bits
-		allChunks.emplace_back(
-			encodeHash(blockData),
-			chunkBytes.size(),
-			blockData.size()
-		);
-	}
-
-	return groupChunksBottomUp(std::move(allChunks));
+	IpfsHasher hasher;
+	hasher.update(_data);
+	return hasher.finalize();
 }
 
-string solidity::util::ipfsHashBase58(string _data)
+string solidity::util::ipfsHashBase58(string const& _data)
 {
-	return base58Encode(ipfsHash(std::move(_data)));
+	return base58Encode(ipfsHash(_data));
 }
@@ -21,6 +21,7 @@
 #include <libsolutil/Common.h>
 
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -30,9 +31,46 @@ namespace solidity::util
 /// As hash function it will use sha2-256.
 /// The effect is that the hash should be identical to the one produced by
 /// the command `ipfs add <filename>`.
-bytes ipfsHash(std::string _data);
+bytes ipfsHash(std::string const& _data);
 
 /// Compute the "ipfs hash" as above, but encoded in base58 as used by ipfs / bitcoin.
-std::string ipfsHashBase58(std::string _data);
+std::string ipfsHashBase58(std::string const& _data);
+
+/**
+ * Computes the "ipfs hash" of data that is passed in pieces, without keeping the
+ * whole data in memory. At most one chunk of 256 KiB is buffered at a time.
+ */
+class IpfsHasher
+{
+public:
+	/// Appends @a _data to the data to hash.
+	void update(bytesConstRef _data);
+
+	/// @returns the hash of all the data passed to update(), as ipfsHash() does.
+	/// The hasher must not be used afterwards.
+	bytes finalize();
+
+private:
+	/// A node of the DAG in the form in which it is linked from its parent.
+	struct Link
+	{
+		bytes hash;
+		size_t size = 0;
+		size_t blockSize = 0;
+	};
+
+	/// Adds the data node for the buffered chunk to the lowest level.
+	void flushChunk();
+	/// Adds @a _link to the nodes of level @a _level that do not have a parent yet.
+	/// Combines them into a node of the next level once there are enough of them.
+	void addLink(size_t _level, Link _link);
+	static Link combineLinks(std::vector<Link>& _links);
+
+	bytes m_chunk;
+	/// Whether a data node was added already.
+	bool m_hasData = false;
+	/// For each level, the nodes that do not have a parent yet, bottom up.
+	std::vector<std::vector<Link>> m_levels;
+};
 
 }
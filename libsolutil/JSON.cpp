@@ -105,6 +105,152 @@ void removeNullMembersHelper(Json::Value& _json)
 		}
 }
 
+/// Decodes the UTF-8 sequence starting at @a _it and advances @a _it to its last byte.
+/// @returns the code point or U+FFFD for invalid sequences, in the same way as jsoncpp.
+unsigned utf8ToCodepoint(char const*& _it, char const* _end)
+{
+	unsigned const replacementCharacter = 0xFFFD;
+	auto byte = [&](size_t _offset) { return static_cast<unsigned>(static_cast<unsigned char>(_it[_offset])); };
+	unsigned const firstByte = byte(0);
+	if (firstByte < 0x80)
+		return firstByte;
+	if (firstByte < 0xE0)
+	{
+		if (_end - _it < 2)
+			return replacementCharacter;
+		unsigned const codepoint = ((firstByte & 0x1F) << 6) | (byte(1) & 0x3F);
+		_it += 1;
+		// Overlong encodings are invalid.
+		return codepoint < 0x80 ? replacementCharacter : codepoint;
+	}
+	if (firstByte < 0xF0)
+	{
+		if (_end - _it < 3)
+			return replacementCharacter;
+		unsigned const codepoint = ((firstByte & 0x0F) << 12) | ((byte(1) & 0x3F) << 6) | (byte(2) & 0x3F);
+		_it += 2;
+		// Surrogates are not valid code points themselves.
+		if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+			return replacementCharacter;
+		return codepoint < 0x800 ? replacementCharacter : codepoint;
+	}
+	if (firstByte < 0xF8)
+	{
+		if (_end - _it < 4)
+			return replacementCharacter;
+		unsigned const codepoint =
+			((firstByte & 0x07) << 18) | ((byte(1) & 0x3F) << 12) | ((byte(2) & 0x3F) << 6) | (byte(3) & 0x3F);
+		_it += 3;
+		return codepoint < 0x10000 ? replacementCharacter : codepoint;
+	}
+	return replacementCharacter;
+}
+
+void appendEscapedCodeUnit(string& _output, unsigned _codeUnit)
+{
+	static char const hexDigits[] = "0123456789abcdef";
+	_output += "\\u";
+	_output += hexDigits[(_codeUnit >> 12) & 0xF];
+	_output += hexDigits[(_codeUnit >> 8) & 0xF];
+	_output += hexDigits[(_codeUnit >> 4) & 0xF];
+	_output += hexDigits[_codeUnit & 0xF];
+}
+
+/// Appends the string @a _begin ... @a _end as a quoted JSON string, escaping everything that is
+/// not printable ASCII exactly like jsoncpp's StreamWriter does with the default settings.
+void appendQuotedString(string& _output, char const* _begin, char const* _end)
+{
+	_output += '"';
+	for (char const* it = _begin; it != _end; ++it)
+		switch (*it)
+		{
+		case '"': _output += "\\\""; break;
+		case '\\': _output += "\\\\"; break;
+		case '\b': _output += "\\b"; break;
+		case '\f': _output += "\\f"; break;
+		case '\n': _output += "\\n"; break;
+		case '\r': _output += "\\r"; break;
+		case '\t': _output += "\\t"; break;
+		default:
+		{
+			unsigned const codepoint = utf8ToCodepoint(it, _end);
+			if (codepoint < 0x20)
+				appendEscapedCodeUnit(_output, codepoint);
+			else if (codepoint < 0x80)
+				_output += static_cast<char>(codepoint);
+			else if (codepoint < 0x10000)
+				appendEscapedCodeUnit(_output, codepoint);
+			else
+			{
+				// jsoncpp also truncates invalid code points above U+10FFFF to a surrogate pair.
+				appendEscapedCodeUnit(_output, 0xD800 + (((codepoint - 0x10000) >> 10) & 0x3FF));
+				appendEscapedCodeUnit(_output, 0xDC00 + ((codepoint - 0x10000) & 0x3FF));
+			}
+			break;
+		}
+		}
+	_output += '"';
+}
+
+/// Serialises @a _value without any whitespace directly into @a _output.
+/// Produces the same output as jsoncpp's StreamWriter with empty indentation, but avoids
+/// building a writer and going through an output stream, which dominates for large outputs.
+void appendCompact(string& _output, Json::Value const& _value)
+{
+	switch (_value.type())
+	{
+	case Json::nullValue:
+		_output += "null";
+		break;
+	case Json::intValue:
+		_output += Json::valueToString(_value.asLargestInt());
+		break;
+	case Json::uintValue:
+		_output += Json::valueToString(_value.asLargestUInt());
+		break;
+	case Json::realValue:
+		_output += Json::valueToString(_value.asDouble(), 17, Json::PrecisionType::significantDigits);
+		break;
+	case Json::stringValue:
+	{
+		char const* begin = nullptr;
+		char const* end = nullptr;
+		if (_value.getString(&begin, &end))
+			appendQuotedString(_output, begin, end);
+		else
+			_output += "\"\"";
+		break;
+	}
+	case Json::booleanValue:
+		_output += _value.asBool() ? "true" : "false";
+		break;
+	case Json::arrayValue:
+		_output += '[';
+		for (Json::ArrayIndex i = 0; i < _value.size(); ++i)
+		{
+			if (i != 0)
+				_output += ',';
+			appendCompact(_output, _value[i]);
+		}
+		_output += ']';
+		break;
+	case Json::objectValue:
+		_output += '{';
+		for (auto it = _value.begin(); it != _value.end(); ++it)
+		{
+			if (it != _value.begin())
+				_output += ',';
+			char const* nameEnd = nullptr;
+			char const* name = it.memberName(&nameEnd);
+			appendQuotedString(_output, name, nameEnd);
+			_output += ':';
+			appendCompact(_output, *it);
+		}
+		_output += '}';
+		break;
+	}
+}
+
 } // end anonymous namespace
 
 Json::Value removeNullMembers(Json::Value _json)
@@ -125,18 +271,19 @@ string jsonCompactPrint(Json::Value const& _input)
 
 string jsonPrint(Json::Value const& _input, JsonFormat const& _format)
 {
-	map<string, Json::Value> settings;
-	if (_format.format == JsonFormat::Pretty)
+	if (_format.format == JsonFormat::Compact)
 	{
-		settings["indentation"] = string(_format.indent, ' ');
-		settings["enableYAMLCompatibility"] = true;
+		string result;
+		appendCompact(result, _input);
+		return result;
 	}
-	else
-		settings["indentation"] = "";
+
+	map<string, Json::Value> settings;
+	settings["indentation"] = string(_format.indent, ' ');
+	settings["enableYAMLCompatibility"] = true;
 	StreamWriterBuilder writerBuilder(settings);
 	string result = print(_input, writerBuilder);
-	if (_format.format == JsonFormat::Pretty)
-		boost::replace_all(result, " \n", "\n");
+	boost::replace_all(result, " \n", "\n");
 	return result;
 }
 
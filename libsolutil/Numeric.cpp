@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <libsolutil/Numeric.h>
+#include <libsolutil/FixedU256.h>
 
 #include <liblangutil/Exceptions.h>
 
@@ -38,3 +39,8 @@ bool solidity::fitsPrecisionBaseX(bigint const& _mantissa, double _log2OfBase, u
 	bigint bitsNeeded = mostSignificantMantissaBit + bigint(floor(double(_exp) * _log2OfBase)) + 1;
 	return bitsNeeded <= bitsMax;
 }
+
+u256 solidity::exp256(u256 const& _base, u256 const& _exponent)
+{
+	return FixedU256::exp(FixedU256(_base), FixedU256(_exponent)).toU256();
+}
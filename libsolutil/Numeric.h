@@ -69,19 +69,8 @@ inline u256 s2u(s256 _u)
 		return u256(c_end + _u);
 }
 
-inline u256 exp256(u256 _base, u256 _exponent)
-{
-	using boost::multiprecision::limb_type;
-	u256 result = 1;
-	while (_exponent)
-	{
-		if (boost::multiprecision::bit_test(_exponent, 0))
-			result *= _base;
-		_base *= _base;
-		_exponent >>= 1;
-	}
-	return result;
-}
+/// @returns @a _base to the power of @a _exponent modulo 2**256.
+u256 exp256(u256 const& _base, u256 const& _exponent);
 
 /// Checks whether _mantissa * (X ** _exp) fits into 4096 bits,
 /// where X is given indirectly via _log2OfBase = log2(X).
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/PhaseStatistics.h>
+
+#include <libsolutil/TraceEvents.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+optional<size_t> solidity::util::peakResidentMemoryInKiB()
+{
+#if defined(__EMSCRIPTEN__)
+	return nullopt;
+#elif defined(__unix__) || defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return nullopt;
+#if defined(__APPLE__)
+	// ru_maxrss is in bytes on macOS and in KiB elsewhere.
+	return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#else
+	return nullopt;
+#endif
+}
+
+void PhaseRecorder::start(string _name)
+{
+	if (!m_phases && !TraceEvents::instance().enabled())
+		return;
+	stop();
+	m_currentPhase = std::move(_name);
+	if (m_phases)
+		m_peakMemoryAtStart = peakResidentMemoryInKiB();
+	m_start = chrono::steady_clock::now();
+}
+
+void PhaseRecorder::stop()
+{
+	if (!m_currentPhase)
+		return;
+
+	auto const end = chrono::steady_clock::now();
+	TraceEvents::instance().record(*m_currentPhase, "phase", m_start, end);
+	if (!m_phases)
+	{
+		m_currentPhase.reset();
+		return;
+	}
+
+	PhaseStatistics phase;
+	phase.name = std::move(*m_currentPhase);
+	phase.duration = chrono::duration_cast<chrono::microseconds>(end - m_start);
+	phase.peakMemoryInKiB = peakResidentMemoryInKiB();
+	if (phase.peakMemoryInKiB && m_peakMemoryAtStart)
+		phase.peakMemoryIncreaseInKiB = *phase.peakMemoryInKiB - *m_peakMemoryAtStart;
+	m_phases->push_back(std::move(phase));
+	m_currentPhase.reset();
+}
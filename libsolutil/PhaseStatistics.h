@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Wall time and memory usage of the phases of a compilation.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// @returns the peak resident set size of the process so far in KiB or nullopt if it
+/// cannot be determined on this platform.
+std::optional<size_t> peakResidentMemoryInKiB();
+
+/**
+ * Wall time and memory usage of one phase of a compilation.
+ */
+struct PhaseStatistics
+{
+	std::string name;
+	std::chrono::microseconds duration{0};
+	/// Peak resident set size of the process at the end of the phase.
+	std::optional<size_t> peakMemoryInKiB;
+	/// How much the peak resident set size of the process grew during the phase.
+	/// Note that a phase that only reuses memory freed by earlier phases does not grow it.
+	std::optional<size_t> peakMemoryIncreaseInKiB;
+};
+
+/**
+ * Measures consecutive phases and appends their statistics to a list.
+ * Recording is disabled if the list is a null pointer. A phase ends when the next one starts,
+ * when @a stop is called or when the recorder is destroyed.
+ * Independently of the list, the phases are recorded as spans if trace events are enabled.
+ */
+class PhaseRecorder
+{
+public:
+	explicit PhaseRecorder(std::vector<PhaseStatistics>* _phases): m_phases(_phases) {}
+	PhaseRecorder(std::string _name, std::vector<PhaseStatistics>* _phases): m_phases(_phases)
+	{
+		start(std::move(_name));
+	}
+	~PhaseRecorder() { stop(); }
+
+	PhaseRecorder(PhaseRecorder const&) = delete;
+	PhaseRecorder& operator=(PhaseRecorder const&) = delete;
+
+	/// Ends the current phase, if any, and starts a new one called @a _name.
+	void start(std::string _name);
+	/// Ends the current phase, if any.
+	void stop();
+
+private:
+	std::vector<PhaseStatistics>* m_phases = nullptr;
+	std::optional<std::string> m_currentPhase;
+	std::chrono::steady_clock::time_point m_start;
+	std::optional<size_t> m_peakMemoryAtStart;
+};
+
+}
@@ -0,0 +1,226 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/SHA256.h>
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_SHA_EXTENSIONS 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+/// Round constants.
+alignas(16) uint32_t const K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotr(uint32_t _x, unsigned _n)
+{
+	return (_x >> _n) | (_x << (32 - _n));
+}
+
+inline uint32_t loadBigEndian(uint8_t const* _data)
+{
+	return
+		(uint32_t(_data[0]) << 24) |
+		(uint32_t(_data[1]) << 16) |
+		(uint32_t(_data[2]) << 8) |
+		uint32_t(_data[3]);
+}
+
+/// Applies the compression function for @a _blocks consecutive blocks of 64 bytes to @a _state.
+void compressPortable(uint32_t* _state, uint8_t const* _data, size_t _blocks)
+{
+	for (; _blocks > 0; --_blocks, _data += 64)
+	{
+		uint32_t w[64];
+		for (size_t i = 0; i < 16; ++i)
+			w[i] = loadBigEndian(_data + 4 * i);
+		for (size_t i = 16; i < 64; ++i)
+		{
+			uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		uint32_t a = _state[0], b = _state[1], c = _state[2], d = _state[3];
+		uint32_t e = _state[4], f = _state[5], g = _state[6], h = _state[7];
+		for (size_t i = 0; i < 64; ++i)
+		{
+			uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+			uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+		_state[0] += a; _state[1] += b; _state[2] += c; _state[3] += d;
+		_state[4] += e; _state[5] += f; _state[6] += g; _state[7] += h;
+	}
+}
+
+#ifdef SHA256_SHA_EXTENSIONS
+/// Same as compressPortable, but using the SHA extensions.
+/// The state is kept in the order ABEF / CDGH expected by the sha256rnds2 instruction.
+__attribute__((target("sha,sse4.1"))) void compressSHA(uint32_t* _state, uint8_t const* _data, size_t _blocks)
+{
+	__m128i const byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+
+	__m128i dcba = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_state));
+	__m128i hgfe = _mm_loadu_si128(reinterpret_cast<__m128i const*>(_state + 4));
+	__m128i cdab = _mm_shuffle_epi32(dcba, 0xb1);
+	__m128i efgh = _mm_shuffle_epi32(hgfe, 0x1b);
+	__m128i abef = _mm_alignr_epi8(cdab, efgh, 8);
+	__m128i cdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+	for (; _blocks > 0; --_blocks, _data += 64)
+	{
+		__m128i const savedABEF = abef;
+		__m128i const savedCDGH = cdgh;
+		// The last four groups of four words of the message schedule.
+		__m128i words[4];
+#pragma GCC unroll 16
+		for (size_t group = 0; group < 16; ++group)
+		{
+			__m128i& current = words[group % 4];
+			if (group < 4)
+				current = _mm_shuffle_epi8(
+					_mm_loadu_si128(reinterpret_cast<__m128i const*>(_data + 16 * group)),
+					byteSwap
+				);
+			else
+				current = _mm_sha256msg2_epu32(
+					_mm_add_epi32(
+						_mm_sha256msg1_epu32(current, words[(group + 1) % 4]),
+						_mm_alignr_epi8(words[(group + 3) % 4], words[(group + 2) % 4], 4)
+					),
+					words[(group + 3) % 4]
+				);
+			__m128i input = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<__m128i const*>(K + 4 * group)));
+			cdgh = _mm_sha256rnds2_epu32(cdgh, abef, input);
+			abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(input, 0x0e));
+		}
+		abef = _mm_add_epi32(abef, savedABEF);
+		cdgh = _mm_add_epi32(cdgh, savedCDGH);
+	}
+
+	__m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+	__m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(_state), _mm_blend_epi16(feba, dchg, 0xf0));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(_state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+bool hasSHAExtensions()
+{
+	static bool const supported = __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+	return supported;
+}
+#endif
+
+void compress(uint32_t* _state, uint8_t const* _data, size_t _blocks)
+{
+#ifdef SHA256_SHA_EXTENSIONS
+	if (hasSHAExtensions())
+	{
+		compressSHA(_state, _data, _blocks);
+		return;
+	}
+#endif
+	compressPortable(_state, _data, _blocks);
+}
+
+}
+
+SHA256Hasher::SHA256Hasher():
+	m_state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+{
+}
+
+void SHA256Hasher::update(bytesConstRef _data)
+{
+	if (_data.empty())
+		return;
+	m_length += _data.size();
+	if (m_bufferSize > 0)
+	{
+		size_t size = min(blockSize - m_bufferSize, _data.size());
+		memcpy(m_buffer.data() + m_bufferSize, _data.data(), size);
+		m_bufferSize += size;
+		_data = _data.cropped(size);
+		if (m_bufferSize < blockSize)
+			return;
+		compress(m_state.data(), m_buffer.data(), 1);
+		m_bufferSize = 0;
+	}
+	size_t blocks = _data.size() / blockSize;
+	if (blocks > 0)
+		compress(m_state.data(), _data.data(), blocks);
+	_data = _data.cropped(blocks * blockSize);
+	if (!_data.empty())
+		memcpy(m_buffer.data(), _data.data(), _data.size());
+	m_bufferSize = _data.size();
+}
+
+h256 SHA256Hasher::finalize()
+{
+	// Padding: a one bit, zeros up to 8 bytes before the end of a block and the length in bits.
+	uint64_t lengthInBits = m_length * 8;
+	m_buffer[m_bufferSize++] = 0x80;
+	if (m_bufferSize > blockSize - 8)
+	{
+		memset(m_buffer.data() + m_bufferSize, 0, blockSize - m_bufferSize);
+		compress(m_state.data(), m_buffer.data(), 1);
+		m_bufferSize = 0;
+	}
+	memset(m_buffer.data() + m_bufferSize, 0, blockSize - 8 - m_bufferSize);
+	for (size_t i = 0; i < 8; ++i)
+		m_buffer[blockSize - 1 - i] = uint8_t(lengthInBits >> (8 * i));
+	compress(m_state.data(), m_buffer.data(), 1);
+
+	h256 output;
+	for (unsigned i = 0; i < 8; ++i)
+		for (unsigned j = 0; j < 4; ++j)
+			output[4 * i + j] = uint8_t(m_state[i] >> (24 - 8 * j));
+	return output;
+}
+
+h256 solidity::util::sha256(bytesConstRef _input)
+{
+	SHA256Hasher hasher;
+	hasher.update(_input);
+	return hasher.finalize();
+}
@@ -0,0 +1,64 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * SHA-256 hash function, using the SHA extensions of the CPU where available.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <array>
+#include <cstdint>
+
+namespace solidity::util
+{
+
+/// Calculate the SHA-256 hash of the given input, returning as a 256-bit hash.
+h256 sha256(bytesConstRef _input);
+
+/// Calculate the SHA-256 hash of the given input, returning as a 256-bit hash.
+inline h256 sha256(bytes const& _input) { return sha256(bytesConstRef(&_input)); }
+
+/**
+ * Computes the SHA-256 hash of data that is passed in pieces.
+ */
+class SHA256Hasher
+{
+public:
+	SHA256Hasher();
+
+	/// Appends @a _data to the data to hash.
+	void update(bytesConstRef _data);
+
+	/// @returns the hash of all the data passed to update().
+	/// The hasher must not be used afterwards.
+	h256 finalize();
+
+private:
+	static size_t constexpr blockSize = 64;
+
+	std::array<uint32_t, 8> m_state;
+	/// The part of the data that does not fill a whole block yet.
+	std::array<uint8_t, blockSize> m_buffer;
+	size_t m_bufferSize = 0;
+	/// Number of bytes passed to update() so far.
+	uint64_t m_length = 0;
+};
+
+}
@@ -22,6 +22,8 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <cstring>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -63,45 +65,128 @@ h256 swarmHashIntermediate(string const& _input, size_t _offset, size_t _length)
 	return swarmHashSimple(ref, _length);
 }
 
+size_t constexpr chunkSize = 0x1000;
+size_t constexpr branches = chunkSize / 32;
+
 h256 bmtHash(bytesConstRef _data)
 {
 	if (_data.size() <= 64)
 		return keccak256(_data);
 
 	size_t midPoint = _data.size() / 2;
-	return keccak256(
-		bmtHash(_data.cropped(0, midPoint)).asBytes() +
-		bmtHash(_data.cropped(midPoint)).asBytes()
-	);
+	uint8_t children[64];
+	h256 left = bmtHash(_data.cropped(0, midPoint));
+	h256 right = bmtHash(_data.cropped(midPoint));
+	memcpy(children, left.data(), 32);
+	memcpy(children + 32, right.data(), 32);
+	return keccak256(bytesConstRef(children, 64));
 }
 
-h256 chunkHash(bytesConstRef const _data, bool _forceHigherLevel = false)
+/// @returns the hash of a node that covers @a _size bytes and has the content @a _data,
+/// which is either the data itself or the hashes of the children.
+h256 nodeHash(bytesConstRef _data, size_t _size)
 {
-	bytes dataToHash;
-	if (_data.size() < 0x1000)
-		dataToHash = _data.toBytes();
-	else if (_data.size() == 0x1000 && !_forceHigherLevel)
-		dataToHash = _data.toBytes();
-	else
+	uint8_t content[chunkSize] = {};
+	copy(_data.begin(), _data.begin() + min(_data.size(), chunkSize), content);
+	uint8_t hashInput[8 + 32];
+	for (size_t i = 0; i < 8; ++i)
+		hashInput[i] = static_cast<uint8_t>((static_cast<uint64_t>(_size) >> (8 * i)) & 0xff);
+	h256 contentHash = bmtHash({content, chunkSize});
+	memcpy(hashInput + 8, contentHash.data(), 32);
+	return keccak256(bytesConstRef(hashInput, sizeof(hashInput)));
+}
+
+h256 nodeHash(vector<h256> const& _children, size_t _size)
+{
+	bytes content;
+	for (h256 const& child: _children)
+		content += child.asBytes();
+	return nodeHash(&content, _size);
+}
+
+/// @returns the number of bytes covered by a complete subtree of level @a _level.
+size_t subtreeSize(size_t _level)
+{
+	size_t size = chunkSize;
+	for (size_t i = 0; i < _level; ++i)
+		size *= branches;
+	return size;
+}
+
+}
+
+void Bzzr1Hasher::update(bytesConstRef _data)
+{
+	while (!_data.empty())
 	{
-		size_t maxRepresentedSize = 0x1000;
-		while (maxRepresentedSize * (0x1000 / 32) < _data.size())
-			maxRepresentedSize *= (0x1000 / 32);
-		// If remaining size is 0x1000, but maxRepresentedSize is not,
-		// we have to still do one level of the chunk hashes.
-		bool forceHigher = maxRepresentedSize > 0x1000;
-		for (size_t i = 0; i < _data.size(); i += maxRepresentedSize)
+		size_t size = min(chunkSize - m_chunk.size(), _data.size());
+		m_chunk.insert(m_chunk.end(), _data.begin(), _data.begin() + size);
+		_data = _data.cropped(size);
+		if (m_chunk.size() < chunkSize)
+			break;
+
+		h256 hash = nodeHash(&m_chunk, chunkSize);
+		m_chunk.clear();
+		for (size_t level = 0; ; ++level)
 		{
-			size_t size = std::min(maxRepresentedSize, _data.size() - i);
-			dataToHash += chunkHash(_data.cropped(i, size), forceHigher).asBytes();
+			if (m_levels.size() <= level)
+				m_levels.resize(level + 1);
+			m_levels[level].push_back(hash);
+			if (m_levels[level].size() < branches)
+				break;
+			hash = nodeHash(m_levels[level], subtreeSize(level + 1));
+			m_levels[level].clear();
 		}
 	}
+}
 
-	dataToHash.resize(0x1000, 0);
-	return keccak256(toLittleEndian(_data.size()) + bmtHash(&dataToHash).asBytes());
+h256 Bzzr1Hasher::finalize() const
+{
+	if (m_levels.empty() && m_chunk.empty())
+		return h256{};
+	return tailHash(m_levels.empty() ? 0 : m_levels.size() - 1, false);
 }
 
+h256 Bzzr1Hasher::tailHash(size_t _level, bool _forceHigherLevel) const
+{
+	size_t size = m_chunk.size();
+	size_t topLevel = 0;
+	for (size_t level = 0; level <= _level && level < m_levels.size(); ++level)
+		if (!m_levels[level].empty())
+		{
+			size += m_levels[level].size() * subtreeSize(level);
+			topLevel = level;
+		}
 
+	if (size < chunkSize)
+		return nodeHash(&m_chunk, size);
+	if (size == chunkSize)
+	{
+		// A single complete chunk is only wrapped in a node below a node with larger children.
+		h256 chunk = m_levels[0].front();
+		return _forceHigherLevel ? nodeHash({chunk}, chunkSize) : chunk;
+	}
+	// A single complete subtree is its own hash, which was computed when it was completed.
+	if (m_chunk.empty() && m_levels[topLevel].size() == 1 && size == subtreeSize(topLevel))
+		return m_levels[topLevel].front();
+
+	// The children are the complete subtrees of the top level and the rest of the data.
+	size_t maxRepresentedSize = chunkSize;
+	size_t childLevel = 0;
+	while (maxRepresentedSize * branches < size)
+	{
+		maxRepresentedSize *= branches;
+		++childLevel;
+	}
+	vector<h256> children;
+	if (childLevel < m_levels.size())
+		children = m_levels[childLevel];
+	if (size > children.size() * maxRepresentedSize)
+	{
+		bool forceHigher = maxRepresentedSize > chunkSize;
+		children.push_back(childLevel == 0 ? nodeHash(&m_chunk, m_chunk.size()) : tailHash(childLevel - 1, forceHigher));
+	}
+	return nodeHash(children, size);
 }
 
 h256 solidity::util::bzzr0Hash(string const& _input)
@@ -110,9 +195,9 @@ h256 solidity::util::bzzr0Hash(string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input)
 {
-	if (_input.empty())
-		return h256{};
-	return chunkHash(&_input);
+	Bzzr1Hasher hasher;
+	hasher.update(_input);
+	return hasher.finalize();
 }
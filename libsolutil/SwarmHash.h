@@ -23,6 +23,7 @@
 #include <libsolutil/FixedHash.h>
 
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -31,11 +32,43 @@ namespace solidity::util
 h256 bzzr0Hash(std::string const& _input);
 
 /// Compute the "bzz hash" of @a _input (the NEW binary / BMT version)
-h256 bzzr1Hash(bytes const& _input);
+h256 bzzr1Hash(bytesConstRef _input);
+
+inline h256 bzzr1Hash(bytes const& _input)
+{
+	return bzzr1Hash(bytesConstRef(&_input));
+}
 
 inline h256 bzzr1Hash(std::string const& _input)
 {
-	return bzzr1Hash(asBytes(_input));
+	return bzzr1Hash(bytesConstRef(_input));
 }
 
+/**
+ * Computes the "bzz hash" of data that is passed in pieces, without keeping the
+ * whole data in memory. Only the hashes of the complete chunks and subtrees that do
+ * not have a parent yet are stored, together with the last incomplete chunk.
+ */
+class Bzzr1Hasher
+{
+public:
+	/// Appends @a _data to the data to hash.
+	void update(bytesConstRef _data);
+
+	/// @returns the hash of all the data passed to update(), as bzzr1Hash() does.
+	h256 finalize() const;
+
+private:
+	/// @returns the hash of the part of the data that is covered by the subtrees of
+	/// level @a _level and below and the incomplete chunk.
+	/// @param _forceHigherLevel if true, a single complete chunk is hashed as the only child of a node.
+	h256 tailHash(size_t _level, bool _forceHigherLevel) const;
+
+	/// The incomplete chunk at the end of the data.
+	bytes m_chunk;
+	/// For each level, the hashes of the complete subtrees of that level that do not have a parent yet.
+	/// A subtree of level k covers 0x1000 * 128^k bytes.
+	std::vector<std::vector<h256>> m_levels;
+};
+
 }
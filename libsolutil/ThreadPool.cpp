@@ -0,0 +1,126 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+using namespace std;
+using namespace solidity::util;
+
+namespace
+{
+/// Set in worker threads and in threads currently running a loop.
+thread_local bool insideLoop = false;
+}
+
+ThreadPool& ThreadPool::instance()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard lock(m_mutex);
+		m_shutdown = true;
+	}
+	m_workAvailable.notify_all();
+	for (auto& worker: m_workers)
+		worker.join();
+}
+
+void ThreadPool::setMaxThreads(size_t _maxThreads)
+{
+	m_maxThreads = max<size_t>(_maxThreads, 1);
+}
+
+void ThreadPool::parallelFor(size_t _count, function<void(size_t)> const& _task)
+{
+	size_t const threads = min(m_maxThreads.load(), _count);
+	unique_lock loopLock(m_loopMutex, defer_lock);
+	if (threads <= 1 || insideLoop || !loopLock.try_lock())
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	{
+		lock_guard lock(m_mutex);
+		while (m_workers.size() < threads - 1)
+			m_workers.emplace_back([this]() { workerLoop(); });
+		m_task = &_task;
+		m_count = _count;
+		m_nextIndex = 0;
+		m_exception = nullptr;
+		++m_generation;
+	}
+	m_workAvailable.notify_all();
+
+	insideLoop = true;
+	work();
+	insideLoop = false;
+
+	unique_lock lock(m_mutex);
+	m_workFinished.wait(lock, [&]() { return m_activeWorkers == 0; });
+	m_task = nullptr;
+	if (m_exception)
+		rethrow_exception(m_exception);
+}
+
+void ThreadPool::workerLoop()
+{
+	insideLoop = true;
+	size_t seenGeneration = 0;
+	unique_lock lock(m_mutex);
+	while (true)
+	{
+		m_workAvailable.wait(lock, [&]() { return m_shutdown || (m_task && m_generation != seenGeneration); });
+		if (m_shutdown)
+			return;
+		seenGeneration = m_generation;
+		++m_activeWorkers;
+		lock.unlock();
+		work();
+		lock.lock();
+		if (--m_activeWorkers == 0)
+			m_workFinished.notify_all();
+	}
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		size_t index = m_nextIndex++;
+		if (index >= m_count)
+			return;
+		try
+		{
+			(*m_task)(index);
+		}
+		catch (...)
+		{
+			lock_guard lock(m_mutex);
+			if (!m_exception)
+				m_exception = current_exception();
+			// Make all threads stop taking new items.
+			m_nextIndex = m_count;
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Process-wide pool of worker threads for data-parallel loops.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Pool of worker threads that runs loops whose iterations are independent of each other.
+ *
+ * Iterations are handed out one by one to whichever thread asks for more work first, so threads
+ * that finish their items early pick up the remaining ones. The calling thread takes part in the loop.
+ * Only one loop runs on the pool at a time. Loops started from inside a loop or while another
+ * thread uses the pool run sequentially on the calling thread instead.
+ *
+ * The pool is disabled (i.e. everything runs sequentially) unless more than one thread is
+ * requested via @a setMaxThreads. Worker threads are started on first use and kept alive, so
+ * thread-local caches of the workers survive between loops.
+ */
+class ThreadPool
+{
+public:
+	static ThreadPool& instance();
+
+	~ThreadPool();
+
+	/// Sets the number of threads, including the calling thread, that @a parallelFor may use.
+	/// Values of zero and one disable parallel execution.
+	void setMaxThreads(size_t _maxThreads);
+	size_t maxThreads() const { return m_maxThreads; }
+
+	/// Calls @a _task for every index in [0, _count). Returns after all calls have finished.
+	/// If some of the calls throw, the first exception is rethrown once all threads have
+	/// stopped working on the loop. The remaining indices are not processed in that case.
+	void parallelFor(size_t _count, std::function<void(size_t)> const& _task);
+
+private:
+	ThreadPool() = default;
+
+	void workerLoop();
+	/// Processes indices of the current loop until none are left.
+	void work();
+
+	std::atomic<size_t> m_maxThreads = 1;
+
+	/// Held for the whole duration of a loop.
+	std::mutex m_loopMutex;
+
+	/// Protects everything below.
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_workFinished;
+	std::vector<std::thread> m_workers;
+	/// Incremented for every loop, so that workers can tell whether they already joined it.
+	size_t m_generation = 0;
+	size_t m_activeWorkers = 0;
+	bool m_shutdown = false;
+
+	std::function<void(size_t)> const* m_task = nullptr;
+	size_t m_count = 0;
+	std::atomic<size_t> m_nextIndex = 0;
+	std::exception_ptr m_exception;
+};
+
+}
@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/TraceEvents.h>
+
+#include <libsolutil/JSON.h>
+
+using namespace std;
+using namespace solidity::util;
+
+TraceEvents& TraceEvents::instance()
+{
+	static TraceEvents traceEvents;
+	return traceEvents;
+}
+
+void TraceEvents::record(
+	string _name,
+	string _category,
+	chrono::steady_clock::time_point _start,
+	chrono::steady_clock::time_point _end,
+	map<string, string> _args
+)
+{
+	if (!m_enabled)
+		return;
+
+	Span span{
+		std::move(_name),
+		std::move(_category),
+		chrono::duration_cast<chrono::microseconds>(_start - m_origin),
+		chrono::duration_cast<chrono::microseconds>(_end - _start),
+		threadID(),
+		std::move(_args)
+	};
+	lock_guard lock(m_mutex);
+	m_spans.emplace_back(std::move(span));
+}
+
+string TraceEvents::toJson() const
+{
+	Json::Value events{Json::arrayValue};
+	lock_guard lock(m_mutex);
+	for (Span const& span: m_spans)
+	{
+		// Complete events, i.e. spans given by their start and duration.
+		Json::Value event{Json::objectValue};
+		event["name"] = span.name;
+		event["cat"] = span.category;
+		event["ph"] = "X";
+		event["ts"] = Json::Int64(span.start.count());
+		event["dur"] = Json::Int64(span.duration.count());
+		event["pid"] = 1;
+		event["tid"] = Json::UInt64(span.threadID);
+		if (!span.args.empty())
+		{
+			event["args"] = Json::objectValue;
+			for (auto const& [key, value]: span.args)
+				event["args"][key] = value;
+		}
+		events.append(std::move(event));
+	}
+
+	Json::Value trace{Json::objectValue};
+	trace["traceEvents"] = std::move(events);
+	trace["displayTimeUnit"] = "ms";
+	return jsonCompactPrint(trace);
+}
+
+void TraceEvents::clear()
+{
+	lock_guard lock(m_mutex);
+	m_spans.clear();
+}
+
+size_t TraceEvents::threadID()
+{
+	static atomic<size_t> nextID = 1;
+	static thread_local size_t const id = nextID++;
+	return id;
+}
+
+TraceSpan::TraceSpan(string _name, string _category, map<string, string> _args)
+{
+	if (TraceEvents::instance().enabled())
+		m_data = Data{std::move(_name), std::move(_category), std::move(_args), chrono::steady_clock::now()};
+}
+
+void TraceSpan::stop()
+{
+	if (!m_data)
+		return;
+	TraceEvents::instance().record(
+		std::move(m_data->name),
+		std::move(m_data->category),
+		m_data->start,
+		chrono::steady_clock::now(),
+		std::move(m_data->args)
+	);
+	m_data.reset();
+}
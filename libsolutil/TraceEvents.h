@@ -0,0 +1,116 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Timeline of the compilation in the trace event format of Chrome.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Process-wide recorder of the spans of a compilation, i.e. named intervals of the wall time
+ * of a thread. The spans can be exported in the trace event format of Chrome, which can be
+ * viewed with Perfetto or chrome://tracing.
+ *
+ * Recording is disabled unless enabled via @a enable. Spans can be recorded concurrently
+ * from multiple threads.
+ */
+class TraceEvents
+{
+public:
+	static TraceEvents& instance();
+
+	void enable(bool _enable = true) { m_enabled = _enable; }
+	bool enabled() const { return m_enabled; }
+
+	/// Records a span of the calling thread. Does nothing if recording is disabled.
+	/// @param _args additional information shown for the span, e.g. the name of the contract.
+	void record(
+		std::string _name,
+		std::string _category,
+		std::chrono::steady_clock::time_point _start,
+		std::chrono::steady_clock::time_point _end,
+		std::map<std::string, std::string> _args = {}
+	);
+
+	/// @returns the recorded spans as a JSON document in the trace event format.
+	std::string toJson() const;
+
+	/// Removes all recorded spans.
+	void clear();
+
+private:
+	struct Span
+	{
+		std::string name;
+		std::string category;
+		std::chrono::microseconds start;
+		std::chrono::microseconds duration;
+		size_t threadID;
+		std::map<std::string, std::string> args;
+	};
+
+	TraceEvents(): m_origin(std::chrono::steady_clock::now()) {}
+
+	/// @returns a small number that identifies the calling thread.
+	static size_t threadID();
+
+	std::atomic<bool> m_enabled = false;
+	std::chrono::steady_clock::time_point const m_origin;
+	mutable std::mutex m_mutex;
+	std::vector<Span> m_spans;
+};
+
+/**
+ * Records a span from its construction to its destruction or the call to @a stop,
+ * if recording of trace events is enabled.
+ */
+class TraceSpan
+{
+public:
+	TraceSpan(std::string _name, std::string _category, std::map<std::string, std::string> _args = {});
+	~TraceSpan() { stop(); }
+
+	TraceSpan(TraceSpan const&) = delete;
+	TraceSpan& operator=(TraceSpan const&) = delete;
+
+	/// Ends the span, unless it already ended.
+	void stop();
+
+private:
+	struct Data
+	{
+		std::string name;
+		std::string category;
+		std::map<std::string, std::string> args;
+		std::chrono::steady_clock::time_point start;
+	};
+	std::optional<Data> m_data;
+};
+
+}
@@ -25,16 +25,161 @@
 #include <libsolutil/Whiskers.h>
 
 #include <libsolutil/Assertions.h>
+#include <libsolutil/Visitor.h>
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
 #include <regex>
+#include <variant>
 
 using namespace std;
 using namespace solidity::util;
 
+struct Whiskers::ParsedTemplate
+{
+	struct Text
+	{
+		size_t start;
+		size_t length;
+	};
+	/// <name>
+	struct Parameter
+	{
+		string name;
+	};
+	/// <#name>...</name>
+	struct List
+	{
+		string name;
+		shared_ptr<ParsedTemplate const> body;
+	};
+	/// <?name>...<!name>...</name> or <?+name>...<!+name>...</+name>
+	struct Condition
+	{
+		/// Name of the condition including a potential leading "+".
+		string name;
+		shared_ptr<ParsedTemplate const> ifTrue;
+		shared_ptr<ParsedTemplate const> ifFalse;
+	};
+
+	/// The text this template was parsed from. Text pieces refer into it.
+	string source;
+	vector<variant<Text, Parameter, List, Condition>> elements;
+};
+
+namespace
+{
+
+bool isParameterChar(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos if it is non-empty and
+/// directly followed by `>`, otherwise std::nullopt.
+optional<size_t> tagNameEnd(string const& _text, size_t _pos)
+{
+	size_t end = _pos;
+	while (end < _text.size() && isParameterChar(_text[end]))
+		++end;
+	if (end == _pos || end >= _text.size() || _text[end] != '>')
+		return nullopt;
+	return end;
+}
+
+}
+
+shared_ptr<Whiskers::ParsedTemplate const> Whiskers::parseTemplate(string _source)
+{
+	auto result = make_shared<ParsedTemplate>();
+	result->source = std::move(_source);
+	string const& text = result->source;
+
+	size_t textStart = 0;
+	auto flushText = [&](size_t _end) {
+		if (_end > textStart)
+			result->elements.emplace_back(ParsedTemplate::Text{textStart, _end - textStart});
+	};
+
+	size_t pos = 0;
+	while ((pos = text.find('<', pos)) != string::npos)
+	{
+		size_t afterTag = string::npos;
+		if (auto nameEnd = tagNameEnd(text, pos + 1))
+		{
+			flushText(pos);
+			result->elements.emplace_back(ParsedTemplate::Parameter{text.substr(pos + 1, *nameEnd - pos - 1)});
+			afterTag = *nameEnd + 1;
+		}
+		else if (pos + 1 < text.size() && text[pos + 1] == '#')
+		{
+			if (auto nameEnd = tagNameEnd(text, pos + 2))
+			{
+				string name = text.substr(pos + 2, *nameEnd - pos - 2);
+				string closingTag = "</" + name + ">";
+				size_t closing = text.find(closingTag, *nameEnd + 1);
+				if (closing != string::npos)
+				{
+					flushText(pos);
+					result->elements.emplace_back(ParsedTemplate::List{
+						std::move(name),
+						parseTemplate(text.substr(*nameEnd + 1, closing - *nameEnd - 1))
+					});
+					afterTag = closing + closingTag.size();
+				}
+			}
+		}
+		else if (pos + 1 < text.size() && text[pos + 1] == '?')
+		{
+			size_t nameStart = pos + 2;
+			if (nameStart < text.size() && text[nameStart] == '+')
+				++nameStart;
+			if (auto nameEnd = tagNameEnd(text, nameStart))
+			{
+				string name = text.substr(pos + 2, *nameEnd - pos - 2);
+				string elseTag = "<!" + name + ">";
+				string closingTag = "</" + name + ">";
+				size_t bodyStart = *nameEnd + 1;
+				size_t closing = text.find(closingTag, bodyStart);
+				if (closing != string::npos)
+				{
+					size_t elsePos = text.find(elseTag, bodyStart);
+					size_t trueEnd = closing;
+					string falseBody;
+					if (elsePos < closing)
+					{
+						trueEnd = elsePos;
+						falseBody = text.substr(elsePos + elseTag.size(), closing - elsePos - elseTag.size());
+					}
+					flushText(pos);
+					result->elements.emplace_back(ParsedTemplate::Condition{
+						std::move(name),
+						parseTemplate(text.substr(bodyStart, trueEnd - bodyStart)),
+						parseTemplate(std::move(falseBody))
+					});
+					afterTag = closing + closingTag.size();
+				}
+			}
+		}
+
+		if (afterTag == string::npos)
+			++pos;
+		else
+			textStart = pos = afterTag;
+	}
+	flushText(text.size());
+	return result;
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(std::move(_template))
+	m_template(std::move(_template)),
+	m_parsedTemplate(parse(m_template))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(string _parameter, string _value)
@@ -72,15 +217,15 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	return render(*m_parsedTemplate, m_parameters, m_conditions, m_listParameters);
 }
 
-void Whiskers::checkTemplateValid() const
+void Whiskers::checkTemplateValid(string const& _template)
 {
-	regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
+	static regex const validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
 	smatch match;
 	assertThrow(
-		!regex_search(m_template, match, validTemplate),
+		!regex_search(_template, match, validTemplate),
 		WhiskersError,
 		"Template contains an invalid/unclosed tag " + match.str()
 	);
@@ -88,9 +233,8 @@ void Whiskers::checkTemplateValid() const
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterChar),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -128,103 +272,89 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::ParsedTemplate const> Whiskers::parse(string const& _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	static mutex cacheMutex;
+	static map<string, shared_ptr<ParsedTemplate const>, less<>> cache;
+
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		lock_guard lock(cacheMutex);
+		if (auto it = cache.find(_template); it != cache.end())
+			return it->second;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+
+	checkTemplateValid(_template);
+	auto parsed = parseTemplate(_template);
+
+	lock_guard lock(cacheMutex);
+	return cache.emplace(_template, std::move(parsed)).first->second;
 }
 
-string Whiskers::replace(
-	string const& _template,
+string Whiskers::render(
+	ParsedTemplate const& _template,
 	StringMap const& _parameters,
 	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
+	StringListMap const& _listParameters
 )
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				string tag = conditionName.substr(1);
+	string result;
+	result.reserve(_template.source.size());
+	for (auto const& element: _template.elements)
+		visit(GenericVisitor{
+			[&](ParsedTemplate::Text const& _text) {
+				result.append(_template.source, _text.start, _text.length);
+			},
+			[&](ParsedTemplate::Parameter const& _parameter) {
+				auto it = _parameters.find(_parameter.name);
+				assertThrow(
+					it != _parameters.end(),
+					WhiskersError,
+					"Value for tag " + _parameter.name + " not provided.\n" +
+					"Template:\n" +
+					_template.source
+				);
+				result += it->second;
+			},
+			[&](ParsedTemplate::List const& _list) {
+				auto it = _listParameters.find(_list.name);
+				assertThrow(
+					it != _listParameters.end(),
+					WhiskersError, "List parameter " + _list.name + " not set."
+				);
+				for (auto const& parameters: it->second)
+					result += render(*_list.body, joinMaps(_parameters, parameters), _conditions);
+			},
+			[&](ParsedTemplate::Condition const& _condition) {
+				bool conditionValue = false;
+				if (_condition.name[0] == '+')
+				{
+					string tag = _condition.name.substr(1);
 
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
+					if (_parameters.count(tag))
+						conditionValue = !_parameters.at(tag).empty();
+					else if (_listParameters.count(tag))
+						conditionValue = !_listParameters.at(tag).empty();
+					else
+						assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
+				}
 				else
-					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+				{
+					auto it = _conditions.find(_condition.name);
+					assertThrow(
+						it != _conditions.end(),
+						WhiskersError, "Condition parameter " + _condition.name + " not set."
+					);
+					conditionValue = it->second;
+				}
+				result += render(
+					conditionValue ? *_condition.ifTrue : *_condition.ifFalse,
+					_parameters,
+					_conditions,
+					_listParameters
 				);
-				conditionValue = _conditions.at(conditionName);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
+		}, element);
+	return result;
 }
 
 Whiskers::StringMap Whiskers::joinMaps(
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::util
@@ -92,7 +93,7 @@ public:
 private:
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
-	void checkTemplateValid() const;
+	static void checkTemplateValid(std::string const& _template);
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
@@ -102,19 +103,29 @@ private:
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// Template parsed into a sequence of text pieces and tags.
+	struct ParsedTemplate;
+
+	/// @returns the parsed version of the given template. Parsed templates are cached
+	/// process-wide, keyed by the template string, so that each template is validated
+	/// and parsed only once.
+	static std::shared_ptr<ParsedTemplate const> parse(std::string const& _template);
+	/// Parses a template in a single pass. Any `<` that does not start a complete tag
+	/// is kept as text. Bodies of lists and conditions end at the first matching closing tag.
+	static std::shared_ptr<ParsedTemplate const> parseTemplate(std::string _source);
+
+	static std::string render(
+		ParsedTemplate const& _template,
 		StringMap const& _parameters,
 		std::map<std::string, bool> const& _conditions,
 		StringListMap const& _listParameters = StringListMap()
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
 	/// Joins the two maps throwing an exception if two keys are equal.
 	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
 
 	std::string m_template;
+	std::shared_ptr<ParsedTemplate const> m_parsedTemplate;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -28,6 +28,7 @@
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
 #include <libsolutil/Common.h>
+#include <libsolutil/StringUtils.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/view/subrange.hpp>
@@ -35,7 +36,8 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
-#include <regex>
+#include <array>
+#include <tuple>
 
 using namespace std;
 using namespace solidity;
@@ -58,6 +60,99 @@ optional<int> toInt(string const& _value)
 	}
 }
 
+// The debug data comments are parsed by hand instead of with regular expressions, because
+// they precede almost every statement in the IR output and std::regex is slow.
+// The functions below accept exactly what the regular expressions in their comments match.
+
+bool isWhitespace(char _c)
+{
+	return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\v' || _c == '\f' || _c == '\r';
+}
+
+size_t skipWhitespace(string_view _text, size_t _position)
+{
+	while (_position < _text.size() && isWhitespace(_text[_position]))
+		++_position;
+	return _position;
+}
+
+size_t skipDigits(string_view _text, size_t _position)
+{
+	while (_position < _text.size() && isDigit(_text[_position]))
+		++_position;
+	return _position;
+}
+
+/// Searches for the tag in @a _text, e.g. @src, as in `(?:^|\s+)(@[a-zA-Z0-9\-_]+)(?:\s+|$)`.
+/// @returns the tag and the text after the match.
+optional<pair<string_view, string_view>> findTag(string_view _text)
+{
+	auto isTagCharacter = [](char _c) {
+		return ('a' <= _c && _c <= 'z') || ('A' <= _c && _c <= 'Z') || isDigit(_c) || _c == '-' || _c == '_';
+	};
+	for (size_t position = 0; position < _text.size(); ++position)
+	{
+		if (isWhitespace(_text[position]))
+			position = skipWhitespace(_text, position);
+		else if (position != 0)
+			continue;
+		if (position == _text.size() || _text[position] != '@')
+			continue;
+
+		size_t tagEnd = position + 1;
+		while (tagEnd < _text.size() && isTagCharacter(_text[tagEnd]))
+			++tagEnd;
+		if (tagEnd == position + 1 || (tagEnd < _text.size() && !isWhitespace(_text[tagEnd])))
+			continue;
+		return {{_text.substr(position, tagEnd - position), _text.substr(skipWhitespace(_text, tagEnd))}};
+	}
+	return nullopt;
+}
+
+/// Matches the index and location of a @src tag, e.g. 1:234:-1, followed by an optional code snippet
+/// as in `^(-1|\d+):(-1|\d+):(-1|\d+)(?:\s+|$)("(?:[^"\\]|\\.)*"?)?`.
+/// @returns the three numbers, the code snippet if there is one and the text after the match.
+optional<tuple<array<string_view, 3>, optional<string_view>, string_view>> matchSrcArguments(string_view _text)
+{
+	array<string_view, 3> numbers;
+	size_t position = 0;
+	for (size_t i = 0; i < numbers.size(); ++i)
+	{
+		if (i > 0)
+		{
+			if (position == _text.size() || _text[position] != ':')
+				return nullopt;
+			++position;
+		}
+		size_t end = _text.substr(position, 2) == "-1" ? position + 2 : skipDigits(_text, position);
+		if (end == position)
+			return nullopt;
+		numbers[i] = _text.substr(position, end - position);
+		position = end;
+	}
+	if (position < _text.size() && !isWhitespace(_text[position]))
+		return nullopt;
+	position = skipWhitespace(_text, position);
+
+	optional<string_view> snippet;
+	if (position < _text.size() && _text[position] == '"')
+	{
+		size_t end = position + 1;
+		while (end < _text.size() && _text[end] != '"')
+			if (_text[end] != '\\')
+				++end;
+			else if (end + 1 < _text.size() && _text[end + 1] != '\n' && _text[end + 1] != '\r')
+				end += 2;
+			else
+				break;
+		if (end < _text.size() && _text[end] == '"')
+			++end;
+		snippet = _text.substr(position, end - position);
+		position = end;
+	}
+	return {{numbers, snippet, _text.substr(position)}};
+}
+
 }
 
 std::shared_ptr<DebugData const> Parser::createDebugData() const
@@ -65,15 +160,31 @@ std::shared_ptr<DebugData const> Parser::createDebugData() const
 	switch (m_useSourceLocationFrom)
 	{
 		case UseSourceLocationFrom::Scanner:
-			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
+			return reuseOrCreateDebugData(ParserBase::currentLocation(), ParserBase::currentLocation());
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			return reuseOrCreateDebugData(m_locationOverride, m_locationOverride);
 		case UseSourceLocationFrom::Comments:
-			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
+			return reuseOrCreateDebugData(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
 	}
 	solAssert(false, "");
 }
 
+shared_ptr<DebugData const> Parser::reuseOrCreateDebugData(
+	SourceLocation const& _nativeLocation,
+	SourceLocation const& _originLocation,
+	optional<int64_t> _astID
+) const
+{
+	if (
+		!m_lastDebugData ||
+		m_lastDebugData->nativeLocation != _nativeLocation ||
+		m_lastDebugData->originLocation != _originLocation ||
+		m_lastDebugData->astID != _astID
+	)
+		m_lastDebugData = DebugData::create(_nativeLocation, _originLocation, _astID);
+	return m_lastDebugData;
+}
+
 void Parser::updateLocationEndFrom(
 	shared_ptr<DebugData const>& _debugData,
 	SourceLocation const& _location
@@ -88,7 +199,11 @@ void Parser::updateLocationEndFrom(
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
 			updatedDebugData.originLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(std::move(updatedDebugData));
+			_debugData = reuseOrCreateDebugData(
+				updatedDebugData.nativeLocation,
+				updatedDebugData.originLocation,
+				updatedDebugData.astID
+			);
 			break;
 		}
 		case UseSourceLocationFrom::LocationOverride:
@@ -98,7 +213,11 @@ void Parser::updateLocationEndFrom(
 		{
 			DebugData updatedDebugData = *_debugData;
 			updatedDebugData.nativeLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(std::move(updatedDebugData));
+			_debugData = reuseOrCreateDebugData(
+				updatedDebugData.nativeLocation,
+				updatedDebugData.originLocation,
+				updatedDebugData.astID
+			);
 			break;
 		}
 	}
@@ -146,31 +265,25 @@ void Parser::fetchDebugDataFromComment()
 {
 	solAssert(m_sourceNames.has_value(), "");
 
-	static regex const tagRegex = regex(
-		R"~~((?:^|\s+)(@[a-zA-Z0-9\-_]+)(?:\s+|$))~~", // tag, e.g: @src
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-
 	string_view commentLiteral = m_scanner->currentCommentLiteral();
-	match_results<string_view::const_iterator> match;
 
 	langutil::SourceLocation originLocation = m_locationFromComment;
 	// Empty for each new node.
 	optional<int> astID;
 
-	while (regex_search(commentLiteral.cbegin(), commentLiteral.cend(), match, tagRegex))
+	while (auto tag = findTag(commentLiteral))
 	{
-		solAssert(match.size() == 2, "");
-		commentLiteral = commentLiteral.substr(static_cast<size_t>(match.position() + match.length()));
+		string_view tagName;
+		tie(tagName, commentLiteral) = *tag;
 
-		if (match[1] == "@src")
+		if (tagName == "@src")
 		{
 			if (auto parseResult = parseSrcComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, originLocation) = *parseResult;
 			else
 				break;
 		}
-		else if (match[1] == "@ast-id")
+		else if (tagName == "@ast-id")
 		{
 			if (auto parseResult = parseASTIDComment(commentLiteral, m_scanner->currentCommentLocation()))
 				tie(commentLiteral, astID) = *parseResult;
@@ -191,13 +304,8 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argsRegex = regex(
-		R"~~(^(-1|\d+):(-1|\d+):(-1|\d+)(?:\s+|$))~~"  // index and location, e.g.: 1:234:-1
-		R"~~(("(?:[^"\\]|\\.)*"?)?)~~",                // optional code snippet, e.g.: "string memory s = \"abc\";..."
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
-	if (!regex_search(_arguments.cbegin(), _arguments.cend(), match, argsRegex))
+	auto match = matchSrcArguments(_arguments);
+	if (!match)
 	{
 		m_errorReporter.syntaxError(
 			8387_error,
@@ -207,12 +315,11 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		return nullopt;
 	}
 
-	solAssert(match.size() == 5, "");
-	string_view tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
+	auto const& [numbers, snippet, tail] = *match;
 
-	if (match[4].matched && (
-		!boost::algorithm::ends_with(match[4].str(), "\"") ||
-		boost::algorithm::ends_with(match[4].str(), "\\\"")
+	if (snippet && (
+		!boost::algorithm::ends_with(*snippet, "\"") ||
+		boost::algorithm::ends_with(*snippet, "\\\"")
 	))
 	{
 		m_errorReporter.syntaxError(
@@ -223,9 +330,9 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		return {{tail, SourceLocation{}}};
 	}
 
-	optional<int> const sourceIndex = toInt(match[1].str());
-	optional<int> const start = toInt(match[2].str());
-	optional<int> const end = toInt(match[3].str());
+	optional<int> const sourceIndex = toInt(string(numbers[0]));
+	optional<int> const start = toInt(string(numbers[1]));
+	optional<int> const end = toInt(string(numbers[2]));
 
 	if (!sourceIndex.has_value() || !start.has_value() || !end.has_value())
 		m_errorReporter.syntaxError(
@@ -244,9 +351,9 @@ optional<pair<string_view, SourceLocation>> Parser::parseSrcComment(
 		);
 	else
 	{
-		shared_ptr<string const> sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
+		string const* sourceName = m_sourceNames->at(static_cast<unsigned>(sourceIndex.value()));
 		solAssert(sourceName, "");
-		return {{tail, SourceLocation{start.value(), end.value(), std::move(sourceName)}}};
+		return {{tail, SourceLocation{start.value(), end.value(), sourceName}}};
 	}
 	return {{tail, SourceLocation{}}};
 }
@@ -256,21 +363,12 @@ optional<pair<string_view, optional<int>>> Parser::parseASTIDComment(
 	langutil::SourceLocation const& _commentLocation
 )
 {
-	static regex const argRegex = regex(
-		R"~~(^(\d+)(?:\s|$))~~",
-		regex_constants::ECMAScript | regex_constants::optimize
-	);
-	match_results<string_view::const_iterator> match;
+	// Matches `^(\d+)(?:\s|$)`.
+	size_t end = skipDigits(_arguments, 0);
+	bool matched = end > 0 && (end == _arguments.size() || isWhitespace(_arguments[end]));
 	optional<int> astID;
-	bool matched = regex_search(_arguments.cbegin(), _arguments.cend(), match, argRegex);
-	string_view tail = _arguments;
 	if (matched)
-	{
-		solAssert(match.size() == 2, "");
-		tail = _arguments.substr(static_cast<size_t>(match.position() + match.length()));
-
-		astID = toInt(match[1].str());
-	}
+		astID = toInt(string(_arguments.substr(0, end)));
 
 	if (!matched || !astID || *astID < 0 || static_cast<int64_t>(*astID) != *astID)
 	{
@@ -701,17 +799,12 @@ void Parser::checkBreakContinuePosition(string const& _which)
 
 bool Parser::isValidNumberLiteral(string const& _literal)
 {
-	try
-	{
-		// Try to convert _literal to u256.
-		[[maybe_unused]] auto tmp = u256(_literal);
-	}
-	catch (...)
-	{
-		return false;
-	}
+	// Accepts the same literals as the conversion to u256, which reads literals with a leading
+	// zero as octal numbers, but without the cost of the conversion and of the exception.
 	if (boost::starts_with(_literal, "0x"))
-		return true;
+		return _literal.find_first_not_of("0123456789abcdefABCDEF", 2) == string::npos;
+	else if (boost::starts_with(_literal, "0"))
+		return _literal.find_first_not_of("01234567") == string::npos;
 	else
 		return _literal.find_first_not_of("0123456789") == string::npos;
 }
@@ -73,7 +73,7 @@ public:
 	explicit Parser(
 		langutil::ErrorReporter& _errorReporter,
 		Dialect const& _dialect,
-		std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> _sourceNames
+		std::optional<std::map<unsigned, std::string const*>> _sourceNames
 	):
 		ParserBase(_errorReporter),
 		m_dialect(_dialect),
@@ -120,6 +120,15 @@ protected:
 	/// Creates a DebugData object with the correct source location set.
 	std::shared_ptr<DebugData const> createDebugData() const;
 
+	/// @returns the most recently created DebugData object if it carries exactly the given
+	/// data and a newly created one otherwise. Consecutive nodes very often share their
+	/// locations, so this avoids most of the allocations.
+	std::shared_ptr<DebugData const> reuseOrCreateDebugData(
+		langutil::SourceLocation const& _nativeLocation,
+		langutil::SourceLocation const& _originLocation,
+		std::optional<int64_t> _astID = {}
+	) const;
+
 	void updateLocationEndFrom(
 		std::shared_ptr<DebugData const>& _debugData,
 		langutil::SourceLocation const& _location
@@ -156,10 +165,12 @@ protected:
 private:
 	Dialect const& m_dialect;
 
-	std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> m_sourceNames;
+	std::optional<std::map<unsigned, std::string const*>> m_sourceNames;
 	langutil::SourceLocation m_locationOverride;
 	langutil::SourceLocation m_locationFromComment;
 	std::optional<int64_t> m_astIDFromComment;
+	/// Most recently created debug data, shared between nodes with equal debug data.
+	mutable std::shared_ptr<DebugData const> m_lastDebugData;
 	UseSourceLocationFrom m_useSourceLocationFrom = UseSourceLocationFrom::Scanner;
 	ForLoopComponent m_currentForLoopComponent = ForLoopComponent::None;
 	bool m_insideFunction = false;
@@ -162,8 +162,7 @@ void ControlFlowBuilder::newConnectedNode()
 
 ControlFlowNode* ControlFlowBuilder::newNode()
 {
-	m_nodes.emplace_back(make_shared<ControlFlowNode>());
-	return m_nodes.back().get();
+	return &m_nodes.emplace_back();
 }
 
 
@@ -203,30 +202,42 @@ ControlFlowSideEffectsCollector::ControlFlowSideEffectsCollector(
 
 	// Now it is sufficient to handle the reachable function calls (`m_functionCalls`),
 	// we do not have to consider the control-flow graph anymore.
+	// A function can terminate or revert if any function it calls can. Propagate these
+	// properties to the callers until nothing changes anymore.
+	map<FunctionDefinition const*, set<FunctionDefinition const*>> callers;
+	for (auto&& [function, calls]: m_functionCalls)
+		for (FunctionCall const* call: calls)
+			if (m_functionReferences.count(call))
+				callers[m_functionReferences.at(call)].insert(function);
+
+	list<FunctionDefinition const*> pending;
+	set<FunctionDefinition const*> pendingSet;
 	for (auto&& [function, calls]: m_functionCalls)
 	{
 		yulAssert(function);
+		pending.emplace_back(function);
+		pendingSet.insert(function);
+	}
+	while (!pending.empty())
+	{
+		FunctionDefinition const* function = pending.front();
+		pending.pop_front();
+		pendingSet.erase(function);
+
 		ControlFlowSideEffects& functionSideEffects = m_functionSideEffects[function];
-		auto _visit = [&, visited = std::set<FunctionDefinition const*>{}](FunctionDefinition const& _function, auto&& _recurse) mutable {
-			// Worst side-effects already, stop searching.
-			if (functionSideEffects.canTerminate && functionSideEffects.canRevert)
-				return;
-			if (!visited.insert(&_function).second)
-				return;
-
-			for (FunctionCall const* call: m_functionCalls.at(&_function))
-			{
-				ControlFlowSideEffects const& calledSideEffects = sideEffects(*call);
-				if (calledSideEffects.canTerminate)
-					functionSideEffects.canTerminate = true;
-				if (calledSideEffects.canRevert)
-					functionSideEffects.canRevert = true;
-
-				if (m_functionReferences.count(call))
-					_recurse(*m_functionReferences.at(call), _recurse);
-			}
-		};
-		_visit(*function, _visit);
+		bool changed = false;
+		for (FunctionCall const* call: m_functionCalls.at(function))
+		{
+			ControlFlowSideEffects const& calledSideEffects = sideEffects(*call);
+			if (calledSideEffects.canTerminate && !functionSideEffects.canTerminate)
+				functionSideEffects.canTerminate = changed = true;
+			if (calledSideEffects.canRevert && !functionSideEffects.canRevert)
+				functionSideEffects.canRevert = changed = true;
+		}
+		if (changed)
+			for (FunctionDefinition const* caller: callers[function])
+				if (pendingSet.insert(caller).second)
+					pending.emplace_back(caller);
 	}
 }
 
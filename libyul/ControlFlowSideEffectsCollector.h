@@ -21,6 +21,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/ControlFlowSideEffects.h>
 
+#include <deque>
 #include <set>
 #include <stack>
 #include <optional>
@@ -72,7 +73,8 @@ private:
 	void newConnectedNode();
 	ControlFlowNode* newNode();
 
-	std::vector<std::shared_ptr<ControlFlowNode>> m_nodes;
+	/// The nodes, in a container that does not move them when new nodes are added.
+	std::deque<ControlFlowNode> m_nodes;
 
 	ControlFlowNode* m_currentNode = nullptr;
 	ControlFlowNode const* m_leave = nullptr;
@@ -29,10 +29,12 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/replace.hpp>
 
 #include <range/v3/view/transform.hpp>
 
+#include <sstream>
+#include <string_view>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
@@ -42,11 +44,20 @@ using namespace solidity::yul;
 namespace
 {
 
-string indent(std::string const& _input)
+/// Writes @a _text to @a _stream, prefixing every line with @a _indentation levels of indentation.
+void printIndented(ostream& _stream, string_view _text, size_t _indentation)
 {
-	if (_input.empty())
-		return _input;
-	return boost::replace_all_copy("    " + _input, "\n", "\n    ");
+	string const prefix(4 * _indentation, ' ');
+	for (size_t start = 0; start < _text.size();)
+	{
+		size_t end = _text.find('\n', start);
+		if (end == string_view::npos)
+			end = _text.size();
+		_stream << prefix << _text.substr(start, end - start);
+		if (end < _text.size())
+			_stream << '\n';
+		start = end + 1;
+	}
 }
 
 }
@@ -56,36 +67,70 @@ string Data::toString(Dialect const*, DebugInfoSelection const&, CharStreamProvi
 	return "data \"" + name.str() + "\" hex\"" + util::toHex(data) + "\"";
 }
 
+void Data::print(
+	ostream& _stream,
+	Dialect const* _dialect,
+	DebugInfoSelection const& _debugInfoSelection,
+	CharStreamProvider const* _soliditySourceProvider,
+	size_t _indentation
+) const
+{
+	printIndented(_stream, toString(_dialect, _debugInfoSelection, _soliditySourceProvider), _indentation);
+}
+
 string Object::toString(
 	Dialect const* _dialect,
 	DebugInfoSelection const& _debugInfoSelection,
 	CharStreamProvider const* _soliditySourceProvider
 ) const
+{
+	ostringstream output;
+	print(output, _dialect, _debugInfoSelection, _soliditySourceProvider);
+	return output.str();
+}
+
+void Object::print(
+	ostream& _stream,
+	Dialect const* _dialect,
+	DebugInfoSelection const& _debugInfoSelection,
+	CharStreamProvider const* _soliditySourceProvider,
+	size_t _indentation
+) const
 {
 	yulAssert(code, "No code");
 	yulAssert(debugData, "No debug data");
 
-	string useSrcComment;
-
 	if (debugData->sourceNames)
-		useSrcComment =
+		printIndented(
+			_stream,
 			"/// @use-src " +
 			joinHumanReadable(ranges::views::transform(*debugData->sourceNames, [](auto&& _pair) {
 				return to_string(_pair.first) + ":" + util::escapeAndQuoteString(*_pair.second);
 			})) +
-			"\n";
+			"\n",
+			_indentation
+		);
 
-	string inner = "code " + AsmPrinter(
-		_dialect,
-		debugData->sourceNames,
-		_debugInfoSelection,
-		_soliditySourceProvider
-	)(*code);
+	printIndented(_stream, "object \"" + name.str() + "\" {\n", _indentation);
+	printIndented(
+		_stream,
+		"code " + AsmPrinter(
+			_dialect,
+			debugData->sourceNames,
+			_debugInfoSelection,
+			_soliditySourceProvider
+		)(*code),
+		_indentation + 1
+	);
 
 	for (auto const& obj: subObjects)
-		inner += "\n" + obj->toString(_dialect, _debugInfoSelection, _soliditySourceProvider);
+	{
+		_stream << '\n';
+		obj->print(_stream, _dialect, _debugInfoSelection, _soliditySourceProvider, _indentation + 1);
+	}
 
-	return useSrcComment + "object \"" + name.str() + "\" {\n" + indent(inner) + "\n}";
+	_stream << '\n';
+	printIndented(_stream, "}", _indentation);
 }
 
 set<YulString> Object::qualifiedDataNames() const
@@ -29,6 +29,7 @@
 
 #include <libsolutil/Common.h>
 
+#include <iosfwd>
 #include <memory>
 #include <set>
 #include <limits>
@@ -39,7 +40,7 @@ struct Dialect;
 struct AsmAnalysisInfo;
 
 
-using SourceNameMap = std::map<unsigned, std::shared_ptr<std::string const>>;
+using SourceNameMap = std::map<unsigned, std::string const*>;
 
 struct Object;
 
@@ -58,6 +59,15 @@ struct ObjectNode
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const = 0;
+	/// Writes the string representation to @a _stream, indenting every line by
+	/// @a _indentation levels.
+	virtual void print(
+		std::ostream& _stream,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		size_t _indentation
+	) const = 0;
 };
 
 /**
@@ -74,6 +84,13 @@ struct Data: public ObjectNode
 		langutil::DebugInfoSelection const& _debugInfoSelection,
 		langutil::CharStreamProvider const* _soliditySourceProvider
 	) const override;
+	void print(
+		std::ostream& _stream,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		langutil::CharStreamProvider const* _soliditySourceProvider,
+		size_t _indentation
+	) const override;
 };
 
 
@@ -95,6 +112,15 @@ public:
 		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
 	) const;
+	/// Writes the same representation as @a toString to @a _stream without building the text
+	/// of the nested sub-objects separately.
+	void print(
+		std::ostream& _stream,
+		Dialect const* _dialect,
+		langutil::DebugInfoSelection const& _debugInfoSelection = langutil::DebugInfoSelection::Default(),
+		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr,
+		size_t _indentation = 0
+	) const override;
 
 	/// @returns the set of names of data objects accessible from within the code of
 	/// this object, including the name of object itself
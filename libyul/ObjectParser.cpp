@@ -152,7 +152,7 @@ optional<SourceNameMap> ObjectParser::tryParseSourceNameMapping() const
 			break;
 		if (scanner.next() != Token::StringLiteral)
 			break;
-		sourceNames[*sourceIndex] = make_shared<string const>(scanner.currentLiteral());
+		sourceNames[*sourceIndex] = internSourceName(scanner.currentLiteral());
 
 		Token const next = scanner.next();
 		if (next == Token::EOS)
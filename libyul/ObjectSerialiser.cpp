@@ -0,0 +1,614 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary representation of Yul objects.
+ */
+
+#include <libyul/ObjectSerialiser.h>
+
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <libsolutil/LEB128.h>
+#include <libsolutil/Visitor.h>
+
+#include <limits>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Magic number followed by the version of the format.
+bytes const c_header{0x00, 'y', 'u', 'l', 0x01};
+
+/// Maximum nesting depth of blocks and expressions, to guard against malicious input.
+size_t constexpr c_maxDepth = 3000;
+
+enum class NodeKind: uint8_t { Object, Data };
+
+/// Values used for references to debug data. Larger values refer to the debug data
+/// that was read in the given position minus two.
+enum DebugDataReference: uint64_t { NoDebugData = 0, NewDebugData = 1 };
+
+static_assert(variant_size_v<Expression> == 3, "Update the serialisation of Yul expressions.");
+static_assert(variant_size_v<Statement> == 11, "Update the serialisation of Yul statements.");
+
+}
+
+bytes ObjectSerialiser::serialise(Object const& _object)
+{
+	ObjectSerialiser serialiser;
+	serialiser.writeObject(_object);
+
+	bytes result = c_header;
+	result += lebEncode(serialiser.m_strings.size());
+	for (string const* str: serialiser.m_strings)
+	{
+		result += lebEncode(str->size());
+		result.insert(result.end(), str->begin(), str->end());
+	}
+	result += serialiser.m_body;
+	return result;
+}
+
+void ObjectSerialiser::writeObject(Object const& _object)
+{
+	yulAssert(_object.code, "No code.");
+	writeString(_object.name.str());
+	if (_object.debugData && _object.debugData->sourceNames)
+	{
+		writeUnsigned(1);
+		writeUnsigned(_object.debugData->sourceNames->size());
+		for (auto const& [index, sourceName]: *_object.debugData->sourceNames)
+		{
+			writeUnsigned(index);
+			writeString(*sourceName);
+		}
+	}
+	else
+		writeUnsigned(0);
+	writeBlock(*_object.code);
+
+	writeUnsigned(_object.subObjects.size());
+	for (shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+		{
+			m_body.push_back(static_cast<uint8_t>(NodeKind::Object));
+			writeObject(*subObject);
+		}
+		else
+		{
+			Data const& data = dynamic_cast<Data const&>(*subNode);
+			m_body.push_back(static_cast<uint8_t>(NodeKind::Data));
+			writeString(data.name.str());
+			writeUnsigned(data.data.size());
+			m_body += data.data;
+		}
+}
+
+void ObjectSerialiser::writeBlock(Block const& _block)
+{
+	writeDebugData(_block.debugData);
+	writeUnsigned(_block.statements.size());
+	for (Statement const& statement: _block.statements)
+		writeStatement(statement);
+}
+
+void ObjectSerialiser::writeStatement(Statement const& _statement)
+{
+	m_body.push_back(static_cast<uint8_t>(_statement.index()));
+	std::visit(GenericVisitor{
+		[&](ExpressionStatement const& _expressionStatement) {
+			writeDebugData(_expressionStatement.debugData);
+			writeExpression(_expressionStatement.expression);
+		},
+		[&](Assignment const& _assignment) {
+			writeDebugData(_assignment.debugData);
+			writeUnsigned(_assignment.variableNames.size());
+			for (Identifier const& variableName: _assignment.variableNames)
+				writeIdentifier(variableName);
+			yulAssert(_assignment.value, "");
+			writeExpression(*_assignment.value);
+		},
+		[&](VariableDeclaration const& _variableDeclaration) {
+			writeDebugData(_variableDeclaration.debugData);
+			writeTypedNames(_variableDeclaration.variables);
+			writeUnsigned(_variableDeclaration.value ? 1 : 0);
+			if (_variableDeclaration.value)
+				writeExpression(*_variableDeclaration.value);
+		},
+		[&](FunctionDefinition const& _functionDefinition) {
+			writeDebugData(_functionDefinition.debugData);
+			writeString(_functionDefinition.name.str());
+			writeTypedNames(_functionDefinition.parameters);
+			writeTypedNames(_functionDefinition.returnVariables);
+			writeBlock(_functionDefinition.body);
+		},
+		[&](If const& _if) {
+			writeDebugData(_if.debugData);
+			yulAssert(_if.condition, "");
+			writeExpression(*_if.condition);
+			writeBlock(_if.body);
+		},
+		[&](Switch const& _switch) {
+			writeDebugData(_switch.debugData);
+			yulAssert(_switch.expression, "");
+			writeExpression(*_switch.expression);
+			writeUnsigned(_switch.cases.size());
+			for (Case const& switchCase: _switch.cases)
+			{
+				writeDebugData(switchCase.debugData);
+				writeUnsigned(switchCase.value ? 1 : 0);
+				if (switchCase.value)
+					writeLiteral(*switchCase.value);
+				writeBlock(switchCase.body);
+			}
+		},
+		[&](ForLoop const& _forLoop) {
+			writeDebugData(_forLoop.debugData);
+			writeBlock(_forLoop.pre);
+			yulAssert(_forLoop.condition, "");
+			writeExpression(*_forLoop.condition);
+			writeBlock(_forLoop.post);
+			writeBlock(_forLoop.body);
+		},
+		[&](Break const& _break) { writeDebugData(_break.debugData); },
+		[&](Continue const& _continue) { writeDebugData(_continue.debugData); },
+		[&](Leave const& _leave) { writeDebugData(_leave.debugData); },
+		[&](Block const& _block) { writeBlock(_block); }
+	}, _statement);
+}
+
+void ObjectSerialiser::writeExpression(Expression const& _expression)
+{
+	m_body.push_back(static_cast<uint8_t>(_expression.index()));
+	std::visit(GenericVisitor{
+		[&](FunctionCall const& _functionCall) {
+			writeDebugData(_functionCall.debugData);
+			writeIdentifier(_functionCall.functionName);
+			writeUnsigned(_functionCall.arguments.size());
+			for (Expression const& argument: _functionCall.arguments)
+				writeExpression(argument);
+		},
+		[&](Identifier const& _identifier) { writeIdentifier(_identifier); },
+		[&](Literal const& _literal) { writeLiteral(_literal); }
+	}, _expression);
+}
+
+void ObjectSerialiser::writeLiteral(Literal const& _literal)
+{
+	writeDebugData(_literal.debugData);
+	m_body.push_back(static_cast<uint8_t>(_literal.kind));
+	writeString(_literal.value.str());
+	writeString(_literal.type.str());
+}
+
+void ObjectSerialiser::writeIdentifier(Identifier const& _identifier)
+{
+	writeDebugData(_identifier.debugData);
+	writeString(_identifier.name.str());
+}
+
+void ObjectSerialiser::writeTypedNames(vector<TypedName> const& _typedNames)
+{
+	writeUnsigned(_typedNames.size());
+	for (TypedName const& typedName: _typedNames)
+	{
+		writeDebugData(typedName.debugData);
+		writeString(typedName.name.str());
+		writeString(typedName.type.str());
+	}
+}
+
+void ObjectSerialiser::writeDebugData(shared_ptr<DebugData const> const& _debugData)
+{
+	if (!_debugData)
+	{
+		writeUnsigned(NoDebugData);
+		return;
+	}
+	auto [it, inserted] = m_debugDataIndices.emplace(_debugData.get(), m_debugDataIndices.size());
+	if (!inserted)
+	{
+		writeUnsigned(it->second + 2);
+		return;
+	}
+	writeUnsigned(NewDebugData);
+	writeLocation(_debugData->nativeLocation);
+	writeLocation(_debugData->originLocation);
+	if (_debugData->astID)
+	{
+		writeUnsigned(1);
+		writeSigned(*_debugData->astID);
+	}
+	else
+		writeUnsigned(0);
+}
+
+void ObjectSerialiser::writeLocation(SourceLocation const& _location)
+{
+	writeSigned(_location.start);
+	writeSigned(_location.end);
+	if (_location.sourceName)
+	{
+		writeUnsigned(1);
+		writeString(*_location.sourceName);
+	}
+	else
+		writeUnsigned(0);
+}
+
+void ObjectSerialiser::writeString(string const& _string)
+{
+	auto [it, inserted] = m_stringIndices.emplace(_string, m_strings.size());
+	if (inserted)
+		m_strings.push_back(&it->first);
+	writeUnsigned(it->second);
+}
+
+void ObjectSerialiser::writeUnsigned(uint64_t _value)
+{
+	m_body += lebEncode(_value);
+}
+
+void ObjectSerialiser::writeSigned(int64_t _value)
+{
+	m_body += lebEncodeSigned(_value);
+}
+
+shared_ptr<Object> ObjectDeserialiser::deserialise(bytesConstRef _data)
+{
+	if (!isSerialisedObject(_data))
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Not a serialised Yul object."));
+
+	ObjectDeserialiser deserialiser(_data);
+	deserialiser.m_position = c_header.size();
+	size_t const stringCount = deserialiser.readSize();
+	for (size_t i = 0; i < stringCount; ++i)
+	{
+		size_t const length = deserialiser.readSize();
+		deserialiser.m_strings.emplace_back(
+			reinterpret_cast<char const*>(_data.data()) + deserialiser.m_position,
+			length
+		);
+		deserialiser.m_position += length;
+	}
+	deserialiser.m_sourceNames.resize(stringCount, nullptr);
+
+	shared_ptr<Object> object = deserialiser.readObject();
+	if (deserialiser.m_position != _data.size())
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Trailing data after serialised Yul object."));
+	return object;
+}
+
+bool ObjectDeserialiser::isSerialisedObject(bytesConstRef _data)
+{
+	return _data.size() >= c_header.size() && equal(c_header.begin(), c_header.end(), _data.begin());
+}
+
+shared_ptr<Object> ObjectDeserialiser::readObject()
+{
+	if (++m_depth > c_maxDepth)
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Yul objects nested too deeply."));
+
+	auto object = make_shared<Object>();
+	object->name = YulString{readString()};
+	optional<SourceNameMap> sourceNames;
+	if (readUnsigned() != 0)
+	{
+		sourceNames.emplace();
+		for (size_t count = readSize(); count > 0; --count)
+		{
+			uint64_t const index = readUnsigned();
+			if (index > numeric_limits<unsigned>::max())
+				BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid source index."));
+			(*sourceNames)[static_cast<unsigned>(index)] = readSourceName();
+		}
+	}
+	object->debugData = make_shared<ObjectDebugData>(ObjectDebugData{std::move(sourceNames)});
+	object->code = make_shared<Block>(readBlock());
+
+	for (size_t count = readSize(); count > 0; --count)
+	{
+		shared_ptr<ObjectNode> subNode;
+		switch (static_cast<NodeKind>(readByte()))
+		{
+		case NodeKind::Object:
+			subNode = readObject();
+			break;
+		case NodeKind::Data:
+		{
+			YulString name{readString()};
+			size_t const length = readSize();
+			bytesConstRef data = m_data.cropped(m_position, length);
+			m_position += length;
+			subNode = make_shared<Data>(name, data.toBytes());
+			break;
+		}
+		default:
+			BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid kind of Yul object."));
+		}
+		object->subIndexByName[subNode->name] = object->subObjects.size();
+		object->subObjects.emplace_back(std::move(subNode));
+	}
+
+	--m_depth;
+	return object;
+}
+
+Block ObjectDeserialiser::readBlock()
+{
+	if (++m_depth > c_maxDepth)
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Yul code nested too deeply."));
+
+	Block block{readDebugData(), {}};
+	size_t const count = readSize();
+	block.statements.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+		block.statements.emplace_back(readStatement());
+
+	--m_depth;
+	return block;
+}
+
+Statement ObjectDeserialiser::readStatement()
+{
+	switch (readByte())
+	{
+	case 0:
+	{
+		shared_ptr<DebugData const> debugData = readDebugData();
+		return ExpressionStatement{std::move(debugData), readExpression()};
+	}
+	case 1:
+	{
+		Assignment assignment{readDebugData(), {}, {}};
+		for (size_t count = readSize(); count > 0; --count)
+			assignment.variableNames.emplace_back(readIdentifier());
+		assignment.value = make_unique<Expression>(readExpression());
+		return assignment;
+	}
+	case 2:
+	{
+		VariableDeclaration variableDeclaration{readDebugData(), readTypedNames(), {}};
+		if (readUnsigned() != 0)
+			variableDeclaration.value = make_unique<Expression>(readExpression());
+		return variableDeclaration;
+	}
+	case 3:
+	{
+		FunctionDefinition functionDefinition{readDebugData(), {}, {}, {}, {}};
+		functionDefinition.name = YulString{readString()};
+		functionDefinition.parameters = readTypedNames();
+		functionDefinition.returnVariables = readTypedNames();
+		functionDefinition.body = readBlock();
+		return functionDefinition;
+	}
+	case 4:
+	{
+		If ifStatement{readDebugData(), {}, {}};
+		ifStatement.condition = make_unique<Expression>(readExpression());
+		ifStatement.body = readBlock();
+		return ifStatement;
+	}
+	case 5:
+	{
+		Switch switchStatement{readDebugData(), {}, {}};
+		switchStatement.expression = make_unique<Expression>(readExpression());
+		for (size_t count = readSize(); count > 0; --count)
+		{
+			Case switchCase{readDebugData(), {}, {}};
+			if (readUnsigned() != 0)
+				switchCase.value = make_unique<Literal>(readLiteral());
+			switchCase.body = readBlock();
+			switchStatement.cases.emplace_back(std::move(switchCase));
+		}
+		return switchStatement;
+	}
+	case 6:
+	{
+		ForLoop forLoop{readDebugData(), {}, {}, {}, {}};
+		forLoop.pre = readBlock();
+		forLoop.condition = make_unique<Expression>(readExpression());
+		forLoop.post = readBlock();
+		forLoop.body = readBlock();
+		return forLoop;
+	}
+	case 7:
+		return Break{readDebugData()};
+	case 8:
+		return Continue{readDebugData()};
+	case 9:
+		return Leave{readDebugData()};
+	case 10:
+		return readBlock();
+	default:
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid kind of Yul statement."));
+	}
+}
+
+Expression ObjectDeserialiser::readExpression()
+{
+	if (++m_depth > c_maxDepth)
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Yul expression nested too deeply."));
+
+	Expression expression;
+	switch (readByte())
+	{
+	case 0:
+	{
+		FunctionCall functionCall{readDebugData(), {}, {}};
+		functionCall.functionName = readIdentifier();
+		size_t const count = readSize();
+		functionCall.arguments.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+			functionCall.arguments.emplace_back(readExpression());
+		expression = std::move(functionCall);
+		break;
+	}
+	case 1:
+		expression = readIdentifier();
+		break;
+	case 2:
+		expression = readLiteral();
+		break;
+	default:
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid kind of Yul expression."));
+	}
+
+	--m_depth;
+	return expression;
+}
+
+Literal ObjectDeserialiser::readLiteral()
+{
+	Literal literal{readDebugData(), {}, {}, {}};
+	uint8_t const kind = readByte();
+	if (kind > static_cast<uint8_t>(LiteralKind::String))
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid kind of Yul literal."));
+	literal.kind = static_cast<LiteralKind>(kind);
+	literal.value = YulString{readString()};
+	literal.type = YulString{readString()};
+	return literal;
+}
+
+Identifier ObjectDeserialiser::readIdentifier()
+{
+	shared_ptr<DebugData const> debugData = readDebugData();
+	return Identifier{std::move(debugData), YulString{readString()}};
+}
+
+vector<TypedName> ObjectDeserialiser::readTypedNames()
+{
+	vector<TypedName> typedNames;
+	for (size_t count = readSize(); count > 0; --count)
+	{
+		TypedName typedName{readDebugData(), {}, {}};
+		typedName.name = YulString{readString()};
+		typedName.type = YulString{readString()};
+		typedNames.emplace_back(std::move(typedName));
+	}
+	return typedNames;
+}
+
+shared_ptr<DebugData const> ObjectDeserialiser::readDebugData()
+{
+	uint64_t const reference = readUnsigned();
+	if (reference == NoDebugData)
+		return nullptr;
+	if (reference != NewDebugData)
+	{
+		if (reference - 2 >= m_debugData.size())
+			BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid reference to debug data."));
+		return m_debugData[reference - 2];
+	}
+
+	SourceLocation nativeLocation = readLocation();
+	SourceLocation originLocation = readLocation();
+	optional<int64_t> astID;
+	if (readUnsigned() != 0)
+		astID = readSigned();
+	return m_debugData.emplace_back(DebugData::create(std::move(nativeLocation), std::move(originLocation), astID));
+}
+
+SourceLocation ObjectDeserialiser::readLocation()
+{
+	SourceLocation location;
+	int64_t const start = readSigned();
+	int64_t const end = readSigned();
+	if (
+		start < numeric_limits<int>::min() || start > numeric_limits<int>::max() ||
+		end < numeric_limits<int>::min() || end > numeric_limits<int>::max()
+	)
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid source location."));
+	location.start = static_cast<int>(start);
+	location.end = static_cast<int>(end);
+	if (readUnsigned() != 0)
+		location.sourceName = readSourceName();
+	return location;
+}
+
+string const& ObjectDeserialiser::readString()
+{
+	uint64_t const index = readUnsigned();
+	if (index >= m_strings.size())
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid reference to a string."));
+	return m_strings[index];
+}
+
+string const* ObjectDeserialiser::readSourceName()
+{
+	uint64_t const index = readUnsigned();
+	if (index >= m_strings.size())
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid reference to a string."));
+	if (!m_sourceNames[index])
+		m_sourceNames[index] = internSourceName(m_strings[index]);
+	return m_sourceNames[index];
+}
+
+uint64_t ObjectDeserialiser::readUnsigned()
+{
+	uint64_t value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		uint8_t const byte = readByte();
+		value |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+	BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid number."));
+}
+
+int64_t ObjectDeserialiser::readSigned()
+{
+	uint64_t value = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		uint8_t const byte = readByte();
+		value |= uint64_t(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+		{
+			// Sign extend if the sign bit of the last byte is set.
+			if (shift + 7 < 64 && (byte & 0x40))
+				value |= ~uint64_t(0) << (shift + 7);
+			return static_cast<int64_t>(value);
+		}
+	}
+	BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid number."));
+}
+
+size_t ObjectDeserialiser::readSize()
+{
+	uint64_t const size = readUnsigned();
+	// Every element occupies at least one byte, so larger sizes are invalid in any case.
+	if (size > m_data.size() - m_position)
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Invalid size."));
+	return static_cast<size_t>(size);
+}
+
+uint8_t ObjectDeserialiser::readByte()
+{
+	if (m_position >= m_data.size())
+		BOOST_THROW_EXCEPTION(ObjectDeserialisationError() << errinfo_comment("Unexpected end of serialised Yul object."));
+	return m_data[m_position++];
+}
@@ -0,0 +1,117 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary representation of Yul objects.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/Exceptions.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <libsolutil/Common.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Object;
+
+struct ObjectDeserialisationError: virtual YulException {};
+
+/**
+ * Serialises a Yul object, including its sub-objects, data and debug information, into a compact
+ * binary form that can be read back by @a ObjectDeserialiser without parsing Yul source.
+ *
+ * The format starts with a magic number and a version, followed by a table of all strings
+ * (identifiers, types, literals and source names) and the objects, whose nodes refer to the
+ * strings by index. Debug data shared between nodes is stored once.
+ * Analysis information and sub IDs are not part of the format, they have to be recomputed.
+ */
+class ObjectSerialiser
+{
+public:
+	static bytes serialise(Object const& _object);
+
+private:
+	void writeObject(Object const& _object);
+	void writeBlock(Block const& _block);
+	void writeStatement(Statement const& _statement);
+	void writeExpression(Expression const& _expression);
+	void writeLiteral(Literal const& _literal);
+	void writeIdentifier(Identifier const& _identifier);
+	void writeTypedNames(std::vector<TypedName> const& _typedNames);
+	void writeDebugData(std::shared_ptr<DebugData const> const& _debugData);
+	void writeLocation(langutil::SourceLocation const& _location);
+	void writeString(std::string const& _string);
+	void writeUnsigned(uint64_t _value);
+	void writeSigned(int64_t _value);
+
+	bytes m_body;
+	std::vector<std::string const*> m_strings;
+	std::unordered_map<std::string, size_t> m_stringIndices;
+	std::unordered_map<DebugData const*, size_t> m_debugDataIndices;
+};
+
+/**
+ * Reads objects written by @a ObjectSerialiser. The result is equal to the object that was
+ * serialised, but not analysed.
+ * Throws ObjectDeserialisationError if the data is malformed.
+ */
+class ObjectDeserialiser
+{
+public:
+	static std::shared_ptr<Object> deserialise(bytesConstRef _data);
+
+	/// @returns true if @a _data starts with the magic number of the format.
+	static bool isSerialisedObject(bytesConstRef _data);
+
+private:
+	explicit ObjectDeserialiser(bytesConstRef _data): m_data(_data) {}
+
+	std::shared_ptr<Object> readObject();
+	Block readBlock();
+	Statement readStatement();
+	Expression readExpression();
+	Literal readLiteral();
+	Identifier readIdentifier();
+	std::vector<TypedName> readTypedNames();
+	std::shared_ptr<DebugData const> readDebugData();
+	langutil::SourceLocation readLocation();
+	std::string const& readString();
+	std::string const* readSourceName();
+	uint64_t readUnsigned();
+	int64_t readSigned();
+	size_t readSize();
+	uint8_t readByte();
+
+	bytesConstRef m_data;
+	size_t m_position = 0;
+	size_t m_depth = 0;
+	std::vector<std::string> m_strings;
+	std::vector<std::string const*> m_sourceNames;
+	std::vector<std::shared_ptr<DebugData const>> m_debugData;
+};
+
+}
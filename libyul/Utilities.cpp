@@ -30,6 +30,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
@@ -92,8 +93,10 @@ u256 solidity::yul::valueOfNumberLiteral(Literal const& _literal)
 	yulAssert(_literal.kind == LiteralKind::Number, "Expected number literal!");
 
 	static map<YulString, u256> numberCache;
+	static mutex numberCacheMutex;
 	static YulStringRepository::ResetCallback callback{[&] { numberCache.clear(); }};
 
+	lock_guard lock(numberCacheMutex);
 	auto&& [it, isNew] = numberCache.try_emplace(_literal.value, 0);
 	if (isNew)
 	{
@@ -34,12 +34,18 @@
 #include <libyul/backends/wasm/WasmObjectCompiler.h>
 #include <libyul/backends/wasm/EVMToEwasmTranslator.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/ObjectSerialiser.h>
+#include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Assembly.h>
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TraceEvents.h>
 #include <liblangutil/Scanner.h>
 #include <boost/algorithm/string.hpp>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -76,6 +82,7 @@ CharStream const& YulStack::charStream(string const& _sourceName) const
 
 bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const& _source)
 {
+	util::PhaseRecorder phase("yulParsingAndAnalysis", m_recordPhaseStatistics ? &m_phaseStatistics : nullptr);
 	m_errors.clear();
 	m_analysisSuccessful = false;
 	m_charStream = make_unique<CharStream>(_source, _sourceName);
@@ -89,6 +96,42 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
+bool YulStack::loadAndAnalyze(std::string const& _sourceName, bytes const& _serialisedObject)
+{
+	util::PhaseRecorder phase("yulParsingAndAnalysis", m_recordPhaseStatistics ? &m_phaseStatistics : nullptr);
+	m_errors.clear();
+	m_analysisSuccessful = false;
+	m_charStream = make_unique<CharStream>("", _sourceName);
+	m_parserResult = ObjectDeserialiser::deserialise(bytesConstRef(&_serialisedObject));
+	yulAssert(m_parserResult, "");
+	yulAssert(m_parserResult->code, "");
+
+	return analyzeParsed();
+}
+
+namespace
+{
+
+/// @returns a deep copy of @a _object and its sub-objects.
+/// Data nodes are shared since they are never modified.
+shared_ptr<Object> copyObject(Object const& _object)
+{
+	auto copy = make_shared<Object>();
+	copy->name = _object.name;
+	copy->subId = _object.subId;
+	copy->code = make_shared<Block>(ASTCopier{}.translate(*_object.code));
+	copy->subIndexByName = _object.subIndexByName;
+	copy->debugData = _object.debugData;
+	for (shared_ptr<ObjectNode> const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			copy->subObjects.emplace_back(copyObject(*subObject));
+		else
+			copy->subObjects.emplace_back(subNode);
+	return copy;
+}
+
+}
+
 void YulStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -96,10 +139,14 @@ void YulStack::optimize()
 
 	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
 
+	util::PhaseRecorder phase("yulOptimization", m_recordPhaseStatistics ? &m_phaseStatistics : nullptr);
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
-	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
+	OptimizedObjects optimizedObjects;
+	optimize(*m_parserResult, true, optimizedObjects);
+	// The optimiser suite re-analyses each object it optimises and the copies of
+	// optimised objects are analysed when they are created, so there is no need to analyse everything again.
+	m_analysisSuccessful = true;
 }
 
 void YulStack::translate(YulStack::Language _targetLanguage)
@@ -167,22 +214,38 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
 }
 
-void YulStack::optimize(Object& _object, bool _isCreation)
+void YulStack::optimize(Object& _object, bool _isCreation, OptimizedObjects& _optimizedObjects)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
 	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+		if (auto subObject = dynamic_pointer_cast<Object>(subNode))
 		{
 			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			optimize(*subObject, isCreation);
+			pair<util::h256, bool> key{
+				util::keccak256(subObject->toString(nullptr, DebugInfoSelection::All())),
+				isCreation
+			};
+			if (auto const* optimizedObject = util::valueOrNullptr(_optimizedObjects, key))
+			{
+				shared_ptr<Object> copy = copyObject(**optimizedObject);
+				copy->subId = subObject->subId;
+				yulAssert(analyzeParsed(*copy), "Invalid source code after optimization.");
+				subNode = std::move(copy);
+			}
+			else
+			{
+				optimize(*subObject, isCreation, _optimizedObjects);
+				_optimizedObjects.emplace(std::move(key), subObject);
+			}
 		}
 
+	util::TraceSpan span("yulOptimizer", "yul", {{"object", _object.name.str()}});
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
-	OptimiserSuite::run(
+	if (OptimiserSuite::run(
 		dialect,
 		meter.get(),
 		_object,
@@ -190,8 +253,14 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		m_optimiserSettings.yulOptimiserSteps,
 		m_optimiserSettings.yulOptimiserCleanupSteps,
 		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
-	);
+		{},
+		m_profileOptimiser ? &m_optimiserProfiles.emplace_back() : nullptr,
+		m_optimiserSettings.yulInlinerProfile,
+		m_optimiserSettings.yulOptimiserTimeBudget ?
+			make_optional(chrono::milliseconds(*m_optimiserSettings.yulOptimiserTimeBudget)) :
+			nullopt
+	))
+		m_optimiserTimeBudgetExhausted = true;
 }
 
 MachineAssemblyObject YulStack::assemble(Machine _machine) const
@@ -264,11 +333,17 @@ YulStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	yulAssert(m_parserResult->code, "");
 	yulAssert(m_parserResult->analysisInfo, "");
 
-	evmasm::Assembly assembly(m_evmVersion, true, {});
+	util::PhaseRecorder phases("evmCodeTransform", m_recordPhaseStatistics ? &m_phaseStatistics : nullptr);
+	evmasm::Assembly assembly(m_evmVersion, true, m_eofVersion, {});
 	EthAssemblyAdapter adapter(assembly);
 	compileEVM(adapter, m_optimiserSettings.optimizeStackAllocation);
 
-	assembly.optimise(evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion));
+	phases.start("evmasmOptimization");
+	evmasm::Assembly::OptimiserSettings assemblySettings =
+		evmasm::Assembly::OptimiserSettings::translateSettings(m_optimiserSettings, m_evmVersion);
+	assemblySettings.recordStatistics = m_profileOptimiser;
+	assembly.optimise(assemblySettings);
+	phases.stop();
 
 	optional<size_t> subIndex;
 
@@ -297,13 +372,30 @@ YulStack::assembleEVMWithDeployed(optional<string_view> _deployName) const
 	return {make_shared<evmasm::Assembly>(assembly), {}};
 }
 
+bytes YulStack::serialise() const
+{
+	yulAssert(m_parserResult, "");
+	return ObjectSerialiser::serialise(*m_parserResult);
+}
+
 string YulStack::print(
 	CharStreamProvider const* _soliditySourceProvider
 ) const
+{
+	ostringstream output;
+	print(output, _soliditySourceProvider);
+	return output.str();
+}
+
+void YulStack::print(
+	ostream& _stream,
+	CharStreamProvider const* _soliditySourceProvider
+) const
 {
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->code, "");
-	return m_parserResult->toString(&languageToDialect(m_language, m_evmVersion), m_debugInfoSelection, _soliditySourceProvider) + "\n";
+	m_parserResult->print(_stream, &languageToDialect(m_language, m_evmVersion), m_debugInfoSelection, _soliditySourceProvider);
+	_stream << "\n";
 }
 
 shared_ptr<Object> YulStack::parserResult() const
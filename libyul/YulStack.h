@@ -29,13 +29,21 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/PhaseStatistics.h>
+
+#include <iosfwd>
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace solidity::evmasm
 {
@@ -101,10 +109,31 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Loads objects written by @a serialise instead of parsing source code and runs the analysis.
+	/// Returns false if the objects cannot be assembled. The native source locations refer to the
+	/// source the objects were parsed from, whose name is @a _sourceName.
+	/// Throws ObjectDeserialisationError if @a _serialisedObject is malformed.
+	bool loadAndAnalyze(std::string const& _sourceName, bytes const& _serialisedObject);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
 
+	/// Enables recording of execution statistics of the optimizer steps in subsequent calls to @a optimize
+	/// and of the applied optimisations of the assembly optimizer in subsequent calls to @a assembleEVMWithDeployed.
+	void enableOptimiserProfiling(bool _enable = true) { m_profileOptimiser = _enable; }
+	/// @returns the statistics recorded by @a optimize, one entry per optimized object.
+	std::vector<OptimiserProfile> const& optimiserProfiles() const { return m_optimiserProfiles; }
+	/// @returns true if a call to @a optimize skipped optimisation steps of an object because
+	/// the time budget of the optimiser settings ran out.
+	bool optimiserTimeBudgetExhausted() const { return m_optimiserTimeBudgetExhausted; }
+
+	/// Enables recording of the wall time and memory usage of parsing, optimization and EVM code
+	/// generation in subsequent calls.
+	void enablePhaseStatistics(bool _enable = true) { m_recordPhaseStatistics = _enable; }
+	/// @returns the phases recorded so far, in the order in which they ran.
+	std::vector<util::PhaseStatistics> const& phaseStatistics() const { return m_phaseStatistics; }
+
 	/// Translate the source to a different language / dialect.
 	void translate(Language _targetLanguage);
 
@@ -131,10 +160,19 @@ public:
 	/// @returns the errors generated during parsing, analysis (and potentially assembly).
 	langutil::ErrorList const& errors() const { return m_errors; }
 
+	/// @returns the parsed objects in the compact binary form of ObjectSerialiser, which can be
+	/// loaded much faster than source code via @a loadAndAnalyze.
+	bytes serialise() const;
+
 	/// Pretty-print the input after having parsed it.
 	std::string print(
 		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
 	) const;
+	/// Pretty-print the input after having parsed it directly to @a _stream.
+	void print(
+		std::ostream& _stream,
+		langutil::CharStreamProvider const* _soliditySourceProvider = nullptr
+	) const;
 
 	/// Return the parsed and analyzed object.
 	std::shared_ptr<Object> parserResult() const;
@@ -145,13 +183,25 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimised sub-objects, keyed by the hash of their unoptimised form and whether they are
+	/// creation objects.
+	using OptimizedObjects = std::map<std::pair<util::h256, bool>, std::shared_ptr<Object const>>;
+
+	/// Optimizes @a _object and its sub-objects. A sub-object that is identical to one already
+	/// found in @a _optimizedObjects is not optimized again but replaced by a copy of the result.
+	void optimize(yul::Object& _object, bool _isCreation, OptimizedObjects& _optimizedObjects);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 	langutil::DebugInfoSelection m_debugInfoSelection{};
+	bool m_profileOptimiser = false;
+	std::vector<OptimiserProfile> m_optimiserProfiles;
+	bool m_optimiserTimeBudgetExhausted = false;
+	bool m_recordPhaseStatistics = false;
+	/// Mutable because the assembly functions are const.
+	mutable std::vector<util::PhaseStatistics> m_phaseStatistics;
 
 	std::unique_ptr<langutil::CharStream> m_charStream;
 
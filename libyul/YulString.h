@@ -23,11 +23,17 @@
 
 #include <fmt/format.h>
 
-#include <unordered_map>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <memory>
-#include <vector>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
 #include <string>
-#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -36,6 +42,14 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// Interning a string is safe to do concurrently from multiple threads: lookups of strings
+/// that are already known only take a shared lock and only insertions are exclusive.
+/// Strings are stored in chunks that are never moved or freed (apart from reset()),
+/// so resolving an ID to its string does not need any lock.
+///
+/// Strings interned while a PersistentScope is active survive reset() with unchanged IDs.
+/// This is used for the builtin names of the dialects, which can then be kept across resets.
 class YulStringRepository
 {
 public:
@@ -56,21 +70,43 @@ public:
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
+		bool const persistent = persistentScopeDepth() > 0;
+		if (!persistent)
+		{
+			std::shared_lock lock(m_mutex);
+			if (auto id = find(_string, h))
+				return Handle{*id, h};
+		}
+		std::unique_lock lock(m_mutex);
+		// Another thread might have inserted the string in the meantime.
+		if (auto id = find(_string, h))
+		{
+			if (persistent)
+				m_persistentIDs.insert(*id);
+			return Handle{*id, h};
+		}
+		size_t id = m_size;
+		auto [chunk, offset] = chunkAndOffset(id);
+		if (!m_chunks[chunk])
+			m_chunks[chunk] = std::make_unique<std::string[]>(chunkSize(chunk));
+		m_chunks[chunk][offset] = _string;
+		++m_size;
+		m_hashToID.emplace(h, id);
+		if (persistent)
+			m_persistentIDs.insert(id);
 
 		return Handle{id, h};
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
+	std::string const& idToString(size_t _id) const
+	{
+		auto [chunk, offset] = chunkAndOffset(_id);
+		return m_chunks[chunk][offset];
+	}
 
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash. The ordering of YulStrings depends on it, so changing it
+		// changes the order in which the optimizer processes names.
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -81,16 +117,26 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Clear the repository apart from the persistent strings.
+	/// Use with care - there cannot be any dangling YulString references
+	/// and no other thread may use the repository at the same time.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
 	static void reset()
 	{
 		for (auto const& cb: resetCallbacks())
 			cb();
-		instance() = YulStringRepository{};
+		instance().clear();
 	}
+	/// Struct that marks all strings the current thread interns during its lifetime as
+	/// persistent, i.e. they keep their IDs and are not removed by reset().
+	struct PersistentScope
+	{
+		PersistentScope() { ++persistentScopeDepth(); }
+		~PersistentScope() { --persistentScopeDepth(); }
+		PersistentScope(PersistentScope const&) = delete;
+		PersistentScope& operator=(PersistentScope const&) = delete;
+	};
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
@@ -102,11 +148,17 @@ public:
 	};
 
 private:
-	YulStringRepository() = default;
+	/// Size of the first chunk as a power of two. Chunk i has size 2**(FirstChunkBits + i).
+	static constexpr size_t FirstChunkBits = 10;
+	static constexpr size_t MaxChunks = 64 - FirstChunkBits;
+
+	YulStringRepository()
+	{
+		m_chunks[0] = std::make_unique<std::string[]>(chunkSize(0));
+		m_hashToID = {{emptyHash(), 0}};
+	}
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -114,8 +166,66 @@ private:
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	static size_t& persistentScopeDepth()
+	{
+		static thread_local size_t depth = 0;
+		return depth;
+	}
+
+	static constexpr size_t chunkSize(size_t _chunk) { return size_t(1) << (FirstChunkBits + _chunk); }
+
+	/// @returns the chunk and the offset inside the chunk the string with the given ID is stored at.
+	static std::pair<size_t, size_t> chunkAndOffset(size_t _id)
+	{
+		size_t position = _id + chunkSize(0);
+		size_t bits = FirstChunkBits;
+		while (position >> (bits + 1))
+			++bits;
+		return {bits - FirstChunkBits, position - (size_t(1) << bits)};
+	}
+
+	/// @returns the ID of the given string if it is already present.
+	/// Requires at least a shared lock to be held.
+	std::optional<size_t> find(std::string const& _string, std::uint64_t _hash) const
+	{
+		auto range = m_hashToID.equal_range(_hash);
+		for (auto it = range.first; it != range.second; ++it)
+			if (idToString(it->second) == _string)
+				return it->second;
+		return std::nullopt;
+	}
+
+	/// Removes all strings that are not persistent. The IDs of the removed strings below
+	/// the largest persistent ID are not reused, so that the persistent strings keep their IDs.
+	void clear()
+	{
+		std::unique_lock lock(m_mutex);
+		m_size = m_persistentIDs.empty() ? 1 : *m_persistentIDs.rbegin() + 1;
+		m_hashToID = {{emptyHash(), 0}};
+		auto persistentID = m_persistentIDs.begin();
+		for (size_t id = 1; id < m_size; ++id)
+			if (id == *persistentID)
+			{
+				m_hashToID.emplace(hash(idToString(id)), id);
+				++persistentID;
+			}
+			else
+			{
+				auto [chunk, offset] = chunkAndOffset(id);
+				m_chunks[chunk][offset] = std::string{};
+			}
+		for (size_t chunk = chunkAndOffset(m_size - 1).first + 1; chunk < MaxChunks; ++chunk)
+			m_chunks[chunk].reset();
+	}
+
+	/// Protects m_hashToID, m_size, m_persistentIDs and the allocation of chunks.
+	mutable std::shared_mutex m_mutex;
+	/// String storage. The empty string is always stored at ID zero.
+	std::array<std::unique_ptr<std::string[]>, MaxChunks> m_chunks;
+	size_t m_size = 1;
+	std::unordered_multimap<std::uint64_t, size_t> m_hashToID;
+	/// IDs of the strings that are kept by reset().
+	std::set<size_t> m_persistentIDs;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -36,6 +36,7 @@
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 
+#include <mutex>
 #include <regex>
 
 using namespace std;
@@ -120,6 +121,12 @@ set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 		return _instr == evmasm::Instruction::BASEFEE && _evmVersion < langutil::EVMVersion::london();
 	};
 
+	// We allow creating functions or identifiers in Yul with the name mcopy for VMs before cancun.
+	auto mcopyException = [&](evmasm::Instruction _instr) -> bool
+	{
+		return _instr == evmasm::Instruction::MCOPY && _evmVersion < langutil::EVMVersion::cancun();
+	};
+
 	// TODO remove this in 0.9.0. We allow creating functions or identifiers in Yul with the name
 	// prevrandao for VMs before paris.
 	auto prevRandaoException = [&](string const& _instrName) -> bool
@@ -132,7 +139,7 @@ set<YulString> createReservedIdentifiers(langutil::EVMVersion _evmVersion)
 	for (auto const& instr: evmasm::c_instructions)
 	{
 		string name = toLower(instr.first);
-		if (!baseFeeException(instr.second) && !prevRandaoException(name))
+		if (!baseFeeException(instr.second) && !mcopyException(instr.second) && !prevRandaoException(name))
 			reserved.emplace(name);
 	}
 	reserved += vector<YulString>{
@@ -338,18 +345,28 @@ bool EVMDialect::reservedIdentifier(YulString _name) const
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		// The names of the builtins survive resets of the YulStringRepository,
+		// so the dialect does not have to be rebuilt.
+		YulStringRepository::PersistentScope persistentScope;
 		dialects[_version] = make_unique<EVMDialect>(_version, false);
+	}
 	return *dialects[_version];
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		YulStringRepository::PersistentScope persistentScope;
 		dialects[_version] = make_unique<EVMDialect>(_version, true);
+	}
 	return *dialects[_version];
 }
 
@@ -375,9 +392,11 @@ SideEffects EVMDialect::sideEffectsOfInstruction(evmasm::Instruction _instructio
 BuiltinFunctionForEVM const* EVMDialect::verbatimFunction(size_t _arguments, size_t _returnVariables) const
 {
 	pair<size_t, size_t> key{_arguments, _returnVariables};
+	lock_guard lock(m_verbatimFunctionsMutex);
 	shared_ptr<BuiltinFunctionForEVM const>& function = m_verbatimFunctions[key];
 	if (!function)
 	{
+		YulStringRepository::PersistentScope persistentScope;
 		BuiltinFunctionForEVM builtinFunction = createFunction(
 			"verbatim_" + to_string(_arguments) + "i_" + to_string(_returnVariables) + "o",
 			1 + _arguments,
@@ -502,8 +521,12 @@ BuiltinFunctionForEVM const* EVMDialectTyped::equalityFunction(YulString _type)
 EVMDialectTyped const& EVMDialectTyped::instance(langutil::EVMVersion _version)
 {
 	static map<langutil::EVMVersion, unique_ptr<EVMDialectTyped const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
+	static mutex dialectsMutex;
+	lock_guard lock(dialectsMutex);
 	if (!dialects[_version])
+	{
+		YulStringRepository::PersistentScope persistentScope;
 		dialects[_version] = make_unique<EVMDialectTyped>(_version, true);
+	}
 	return *dialects[_version];
 }
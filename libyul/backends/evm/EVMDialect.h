@@ -28,6 +28,7 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <map>
+#include <mutex>
 #include <set>
 
 namespace solidity::yul
@@ -100,6 +101,8 @@ protected:
 	langutil::EVMVersion const m_evmVersion;
 	std::map<YulString, BuiltinFunctionForEVM> m_functions;
 	std::map<std::pair<size_t, size_t>, std::shared_ptr<BuiltinFunctionForEVM const>> mutable m_verbatimFunctions;
+	/// Protects m_verbatimFunctions, which is filled lazily also from concurrently running optimizer steps.
+	std::mutex mutable m_verbatimFunctionsMutex;
 	std::set<YulString> m_reserved;
 };
 
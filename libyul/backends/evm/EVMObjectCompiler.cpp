@@ -30,8 +30,14 @@
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
 
+#include <libsolutil/ThreadPool.h>
+
 #include <boost/algorithm/string.hpp>
 
+#include <exception>
+#include <memory>
+#include <vector>
+
 using namespace solidity::yul;
 using namespace std;
 
@@ -47,31 +53,83 @@ void EVMObjectCompiler::compile(
 	compiler.run(_object, _optimize);
 }
 
-void EVMObjectCompiler::run(Object& _object, bool _optimize)
+namespace
 {
+
+/// Code of an object together with the assembly it is compiled into.
+struct CodeJob
+{
+	Object* object = nullptr;
+	AbstractAssembly* assembly = nullptr;
+	/// Keeps the assembly of a sub-object alive until its code is compiled.
+	shared_ptr<AbstractAssembly> assemblyOwner;
 	BuiltinContext context;
-	context.currentObject = &_object;
+};
 
+/// Creates the sub-assemblies of @a _object and of all objects nested in it and appends their data.
+/// Appends the code of the nested objects and then the code of @a _object to @a o_jobs.
+void prepare(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	shared_ptr<AbstractAssembly> _assemblyOwner,
+	vector<CodeJob>& o_jobs
+)
+{
+	BuiltinContext context;
+	context.currentObject = &_object;
 
 	for (auto const& subNode: _object.subObjects)
 		if (auto* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name.str());
+			auto subAssemblyAndID = _assembly.createSubAssembly(isCreation, subObject->name.str());
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, _optimize, m_eofVersion);
+			prepare(*subObject, *subAssemblyAndID.first, subAssemblyAndID.first, o_jobs);
 		}
 		else
 		{
 			Data const& data = dynamic_cast<Data const&>(*subNode);
 			// Special handling of metadata.
 			if (data.name.str() == Object::metadataName())
-				m_assembly.appendToAuxiliaryData(data.data);
+				_assembly.appendToAuxiliaryData(data.data);
 			else
-				context.subIDs[data.name] = m_assembly.appendData(data.data);
+				context.subIDs[data.name] = _assembly.appendData(data.data);
+		}
+
+	o_jobs.push_back({&_object, &_assembly, std::move(_assemblyOwner), std::move(context)});
+}
+
+}
+
+void EVMObjectCompiler::run(Object& _object, bool _optimize)
+{
+	// The code of an object only refers to the IDs of the sub-assemblies, which are all known
+	// after the preparation. This allows transforming the code of all objects in parallel,
+	// e.g. the creation code of a contract while its deployed code is compiled.
+	vector<CodeJob> jobs;
+	prepare(_object, m_assembly, nullptr, jobs);
+
+	vector<exception_ptr> exceptions(jobs.size());
+	util::ThreadPool::instance().parallelFor(jobs.size(), [&](size_t _index) {
+		CodeJob& job = jobs[_index];
+		try
+		{
+			EVMObjectCompiler(*job.assembly, m_dialect, m_eofVersion).compileCode(*job.object, job.context, _optimize);
+		}
+		catch (...)
+		{
+			exceptions[_index] = current_exception();
 		}
+	});
+	// Report the same error as a sequential compilation would.
+	for (exception_ptr const& exception: exceptions)
+		if (exception)
+			rethrow_exception(exception);
+}
 
+void EVMObjectCompiler::compileCode(Object& _object, BuiltinContext& _context, bool _optimize)
+{
 	yulAssert(_object.analysisInfo, "No analysis info.");
 	yulAssert(_object.code, "No code.");
 	if (m_eofVersion.has_value())
@@ -86,7 +144,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			*_object.analysisInfo,
 			*_object.code,
 			m_dialect,
-			context,
+			_context,
 			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
 		);
 		if (!stackErrors.empty())
@@ -116,7 +174,7 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 			*_object.analysisInfo,
 			*_object.code,
 			m_dialect,
-			context,
+			_context,
 			_optimize,
 			{},
 			CodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
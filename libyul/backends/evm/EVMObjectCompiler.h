@@ -28,6 +28,7 @@ namespace solidity::yul
 {
 struct Object;
 class AbstractAssembly;
+struct BuiltinContext;
 struct EVMDialect;
 
 class EVMObjectCompiler
@@ -45,7 +46,10 @@ private:
 		m_assembly(_assembly), m_dialect(_dialect), m_eofVersion(_eofVersion)
 	{}
 
+	/// Compiles @a _object and all its sub-objects, possibly in parallel.
 	void run(Object& _object, bool _optimize);
+	/// Transforms only the code of @a _object, whose sub-assemblies have to exist already.
+	void compileCode(Object& _object, BuiltinContext& _context, bool _optimize);
 
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
@@ -248,10 +248,10 @@ void OptimizedEVMCodeTransform::createStackLayout(std::shared_ptr<DebugData cons
 	};
 
 	yulAssert(m_assembly.stackHeight() == static_cast<int>(m_stack.size()), "");
-	// ::createStackLayout asserts that it has successfully achieved the target layout.
+	// ::createOptimalStackLayout asserts that it has successfully achieved the target layout.
 	langutil::SourceLocation sourceLocation = _debugData ? _debugData->originLocation : langutil::SourceLocation{};
 	m_assembly.setSourceLocation(sourceLocation);
-	::createStackLayout(
+	::createOptimalStackLayout(
 		m_stack,
 		_targetStack | ranges::to<Stack>,
 		// Swap callback.
@@ -0,0 +1,44 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cached analysis of the stack layout of an object for the optimized EVM code generator.
+ */
+
+#include <libyul/backends/evm/StackAnalysisCache.h>
+
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/Object.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+map<YulString, vector<StackLayoutGenerator::StackTooDeep>> const& StackAnalysisCache::stackTooDeepErrors()
+{
+	if (!m_stackTooDeepErrors)
+	{
+		yulAssert(m_object.code, "");
+		AsmAnalysisInfo analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(m_dialect, m_object);
+		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, m_dialect, *m_object.code);
+		m_stackTooDeepErrors = StackLayoutGenerator::reportStackTooDeep(*cfg);
+	}
+	return *m_stackTooDeepErrors;
+}
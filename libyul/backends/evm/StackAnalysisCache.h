@@ -0,0 +1,65 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cached analysis of the stack layout of an object for the optimized EVM code generator.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/StackLayoutGenerator.h>
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+struct Object;
+
+/**
+ * Determines the stack too deep errors the optimized EVM code generator will encounter in the
+ * code of an object, which requires analysing the code and building its control flow graph,
+ * and keeps them until the code is modified.
+ *
+ * This allows the StackCompressor and the StackLimitEvader to share one analysis as long as
+ * neither of them modifies the code. invalidate() has to be called whenever the code is modified.
+ */
+class StackAnalysisCache
+{
+public:
+	StackAnalysisCache(EVMDialect const& _dialect, Object const& _object):
+		m_dialect(_dialect),
+		m_object(_object)
+	{}
+
+	/// @returns a map from function names to the stack too deep errors occurring in that function,
+	/// as returned by StackLayoutGenerator::reportStackTooDeep.
+	std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>> const& stackTooDeepErrors();
+
+	/// Discards the results. Has to be called after the code of the object was modified.
+	void invalidate() { m_stackTooDeepErrors.reset(); }
+
+private:
+	EVMDialect const& m_dialect;
+	Object const& m_object;
+	std::optional<std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>>> m_stackTooDeepErrors;
+};
+
+}
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/backends/evm/StackShuffleSearch.h>
 #include <libyul/Exceptions.h>
 
 #include <libsolutil/Visitor.h>
@@ -464,4 +465,41 @@ void createStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _sw
 			yulAssert(current == target, "");
 }
 
+/// Transforms @a _currentStack to @a _targetStack like ``createStackLayout``, but uses the cheapest sequence of
+/// shuffling operations, if both layouts are small enough for ``findOptimalStackShuffling`` to find it.
+template<typename Swap, typename PushOrDup, typename Pop>
+void createOptimalStackLayout(Stack& _currentStack, Stack const& _targetStack, Swap _swap, PushOrDup _pushOrDup, Pop _pop)
+{
+	std::optional<std::vector<StackShuffleOperation>> operations = findOptimalStackShuffling(_currentStack, _targetStack);
+	if (!operations)
+	{
+		createStackLayout(_currentStack, _targetStack, _swap, _pushOrDup, _pop);
+		return;
+	}
+
+	for (StackShuffleOperation const& operation: *operations)
+		switch (operation.kind)
+		{
+		case StackShuffleOperation::Kind::Swap:
+			_swap(static_cast<unsigned>(operation.argument));
+			std::swap(_currentStack.at(_currentStack.size() - operation.argument - 1), _currentStack.back());
+			break;
+		case StackShuffleOperation::Kind::PushOrDup:
+			_pushOrDup(_targetStack.at(operation.argument));
+			_currentStack.push_back(_targetStack.at(operation.argument));
+			break;
+		case StackShuffleOperation::Kind::Pop:
+			_pop();
+			_currentStack.pop_back();
+			break;
+		}
+
+	yulAssert(_currentStack.size() == _targetStack.size(), "");
+	for (auto&& [current, target]: ranges::zip_view(_currentStack, _targetStack))
+		if (std::holds_alternative<JunkSlot>(target))
+			current = JunkSlot{};
+		else
+			yulAssert(current == target, "");
+}
+
 }
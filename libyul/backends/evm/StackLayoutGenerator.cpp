@@ -27,6 +27,7 @@
 
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/cxx20.h>
+#include <libsolutil/ThreadPool.h>
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/algorithm/any_of.hpp>
@@ -53,8 +54,25 @@ StackLayout StackLayoutGenerator::run(CFG const& _cfg)
 	StackLayout stackLayout;
 	StackLayoutGenerator{stackLayout}.processEntryPoint(*_cfg.entry);
 
-	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
-		StackLayoutGenerator{stackLayout}.processEntryPoint(*functionInfo.entry, &functionInfo);
+	// The layouts of the functions only depend on their own blocks, so they are generated
+	// independently (and in parallel if the thread pool is enabled) and merged afterwards.
+	vector<CFG::FunctionInfo const*> functionInfos;
+	for (auto const& functionInfo: _cfg.functionInfo | ranges::views::values)
+		functionInfos.emplace_back(&functionInfo);
+	vector<StackLayout> functionLayouts(functionInfos.size());
+	util::ThreadPool::instance().parallelFor(functionInfos.size(), [&](size_t _index) {
+		StackLayoutGenerator{functionLayouts[_index]}.processEntryPoint(
+			*functionInfos[_index]->entry,
+			functionInfos[_index]
+		);
+	});
+
+	for (StackLayout& functionLayout: functionLayouts)
+	{
+		stackLayout.blockInfos.merge(functionLayout.blockInfos);
+		stackLayout.operationEntryLayout.merge(functionLayout.operationEntryLayout);
+		yulAssert(functionLayout.blockInfos.empty() && functionLayout.operationEntryLayout.empty(), "");
+	}
 
 	return stackLayout;
 }
@@ -441,7 +459,7 @@ optional<Stack> StackLayoutGenerator::getExitLayoutOrStageDependencies(
 			if (zeroVisited && nonZeroVisited)
 			{
 				// If the current iteration has already visited both jump targets, start from its entry layout.
-				Stack stack = combineStack(
+				Stack stack = cachedCombineStack(
 					m_layout.blockInfos.at(_conditionalJump.zero).entryLayout,
 					m_layout.blockInfos.at(_conditionalJump.nonZero).entryLayout
 				);
@@ -577,6 +595,11 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 		return holds_alternative<LiteralSlot>(slot) || holds_alternative<FunctionCallReturnLabelSlot>(slot);
 	});
 
+	// Searching for a better permutation is too costly for very large stacks, deep slots
+	// cannot be reached anyways in that case.
+	if (candidate.size() > MaxCombineStackSearchSize)
+		return commonPrefix + candidate;
+
 	auto evaluate = [&](Stack const& _candidate) -> size_t {
 		size_t numOps = 0;
 		Stack testStack = _candidate;
@@ -631,6 +654,15 @@ Stack StackLayoutGenerator::combineStack(Stack const& _stack1, Stack const& _sta
 	return commonPrefix + bestCandidate;
 }
 
+Stack const& StackLayoutGenerator::cachedCombineStack(Stack const& _stack1, Stack const& _stack2) const
+{
+	auto key = make_pair(_stack1, _stack2);
+	if (auto it = m_combinedStacks.find(key); it != m_combinedStacks.end())
+		return it->second;
+	Stack combined = combineStack(_stack1, _stack2);
+	return m_combinedStacks.emplace(std::move(key), std::move(combined)).first->second;
+}
+
 vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG::BasicBlock const& _entry) const
 {
 	vector<StackTooDeep> stackTooDeepErrors;
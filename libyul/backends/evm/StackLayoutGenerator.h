@@ -55,6 +55,8 @@ public:
 		std::vector<YulString> variableChoices;
 	};
 
+	/// Generates the layouts of the functions in @a _cfg in parallel if util::ThreadPool is enabled.
+	/// The result does not depend on the number of threads.
 	static StackLayout run(CFG const& _cfg);
 	/// @returns a map from function names to the stack too deep errors occurring in that function.
 	/// Requires @a _cfg to be a control flow graph generated from disambiguated Yul.
@@ -101,6 +103,14 @@ private:
 	/// Calculates the ideal stack layout, s.t. both @a _stack1 and @a _stack2 can be achieved with minimal
 	/// stack shuffling when starting from the returned layout.
 	static Stack combineStack(Stack const& _stack1, Stack const& _stack2);
+	/// @returns the result of combineStack for @a _stack1 and @a _stack2, reusing the result of earlier
+	/// calls with the same arguments. The layouts are recombined each time the main algorithm reruns along
+	/// a backwards jump.
+	Stack const& cachedCombineStack(Stack const& _stack1, Stack const& _stack2) const;
+
+	/// Maximum number of slots (not counting the common prefix) for which combineStack searches
+	/// through permutations of the combined layout. Larger stacks use the first candidate directly.
+	static constexpr size_t MaxCombineStackSearchSize = 64;
 
 	/// Walks through the CFG and reports any stack too deep errors that would occur when generating code for it
 	/// without countermeasures.
@@ -115,6 +125,8 @@ private:
 	void fillInJunk(CFG::BasicBlock const& _block, CFG::FunctionInfo const* _functionInfo = nullptr);
 
 	StackLayout& m_layout;
+	/// Results of combineStack, see cachedCombineStack.
+	mutable std::map<std::pair<Stack, Stack>, Stack> m_combinedStacks;
 };
 
 }
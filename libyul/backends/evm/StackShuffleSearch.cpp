@@ -0,0 +1,281 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Exhaustive search for the cheapest shuffling between two small stack layouts.
+ */
+
+#include <libyul/backends/evm/StackShuffleSearch.h>
+
+#include <libyul/backends/evm/StackHelpers.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <tuple>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Gas costs of the instructions emitted for the shuffling operations.
+unsigned constexpr swapCost = 3;
+unsigned constexpr pushOrDupCost = 3;
+unsigned constexpr popCost = 2;
+/// Junk that is not on the stack yet is produced by ``CODESIZE``.
+unsigned constexpr junkCost = 2;
+
+/// Number of layouts the search expands at most before giving up.
+size_t constexpr maxExpandedLayouts = 10000;
+
+/// Marks the slots of the target layout that can be anything.
+int constexpr junk = -1;
+
+/// The shape of a pair of source and target layouts, in which every distinct slot is replaced by
+/// the position of its first occurrence in the source followed by the target.
+struct ShufflingShape
+{
+	std::vector<int> source;
+	std::vector<int> target;
+	/// Whether the slot with the respective index can be pushed if it is not on the stack.
+	std::vector<bool> pushable;
+	/// Index of the junk slot, if it occurs in any of the layouts.
+	int junkIndex = junk;
+
+	bool operator<(ShufflingShape const& _other) const
+	{
+		return tie(source, target, pushable, junkIndex) < tie(_other.source, _other.target, _other.pushable, _other.junkIndex);
+	}
+};
+
+ShufflingShape shapeOf(Stack const& _source, Stack const& _target)
+{
+	ShufflingShape shape;
+	Stack slots;
+	auto indexOf = [&](StackSlot const& _slot) {
+		if (optional<size_t> offset = util::findOffset(slots, _slot))
+			return static_cast<int>(*offset);
+		slots.emplace_back(_slot);
+		return static_cast<int>(slots.size() - 1);
+	};
+
+	for (StackSlot const& slot: _source)
+		shape.source.emplace_back(indexOf(slot));
+	size_t const sourceSlotCount = slots.size();
+	for (StackSlot const& slot: _target)
+		if (holds_alternative<JunkSlot>(slot))
+		{
+			shape.target.emplace_back(junk);
+			shape.junkIndex = indexOf(JunkSlot{});
+		}
+		else
+			shape.target.emplace_back(indexOf(slot));
+	for (size_t index = 0; index < slots.size(); ++index)
+	{
+		if (holds_alternative<JunkSlot>(slots[index]))
+			shape.junkIndex = static_cast<int>(index);
+		// ``createStackLayout`` pushes slots that are not in the source, e.g. unassigned return variables.
+		shape.pushable.emplace_back(canBeFreelyGenerated(slots[index]) || index >= sourceSlotCount);
+	}
+	return shape;
+}
+
+/// @returns the gas cost of the shuffling performed by ``createStackLayout``.
+unsigned greedyShufflingCost(Stack const& _source, Stack const& _target)
+{
+	Stack stack = _source;
+	unsigned cost = 0;
+	createStackLayout(
+		stack,
+		_target,
+		[&](unsigned) { cost += swapCost; },
+		[&](StackSlot const& _slot) {
+			cost += holds_alternative<JunkSlot>(_slot) && !util::contains(stack, _slot) ? junkCost : pushOrDupCost;
+		},
+		[&]() { cost += popCost; }
+	);
+	return cost;
+}
+
+/// A* search for the cheapest shuffling of the layouts of @a _shape that costs less than @a _costBound.
+optional<vector<StackShuffleOperation>> searchShuffling(ShufflingShape const& _shape, unsigned _costBound)
+{
+	using Layout = vector<int>;
+	struct Node
+	{
+		unsigned cost = 0;
+		Layout const* predecessor = nullptr;
+		StackShuffleOperation operation{StackShuffleOperation::Kind::Pop};
+	};
+
+	size_t const slotCount = _shape.pushable.size();
+	// Leave room for one temporary copy that is popped again.
+	size_t const maxSize = max(_shape.source.size(), _shape.target.size()) + 1;
+
+	vector<size_t> requiredCopies(slotCount, 0);
+	// Offset in the target at which a slot can be found, which is used as argument of its pushes and dups.
+	vector<optional<size_t>> targetOffsets(slotCount);
+	for (size_t offset = 0; offset < _shape.target.size(); ++offset)
+	{
+		int slot = _shape.target[offset];
+		size_t index = static_cast<size_t>(slot == junk ? _shape.junkIndex : slot);
+		if (slot != junk)
+			++requiredCopies[index];
+		if (!targetOffsets[index])
+			targetOffsets[index] = offset;
+	}
+
+	auto isFinal = [&](Layout const& _layout) {
+		if (_layout.size() != _shape.target.size())
+			return false;
+		for (size_t offset = 0; offset < _layout.size(); ++offset)
+			if (_shape.target[offset] != junk && _shape.target[offset] != _layout[offset])
+				return false;
+		return true;
+	};
+	// Lower bound of the cost of reaching the target from @a _layout, or nullopt if it cannot be reached.
+	auto lowerBound = [&](Layout const& _layout) -> optional<unsigned> {
+		vector<size_t> copies(slotCount, 0);
+		for (int slot: _layout)
+			++copies[static_cast<size_t>(slot)];
+		size_t missingCopies = 0;
+		for (size_t index = 0; index < slotCount; ++index)
+			if (copies[index] < requiredCopies[index])
+			{
+				if (copies[index] == 0 && !_shape.pushable[index])
+					return nullopt;
+				missingCopies += requiredCopies[index] - copies[index];
+			}
+		size_t sizeAfterPushes = _layout.size() + missingCopies;
+		size_t const surplus = sizeAfterPushes > _shape.target.size() ? sizeAfterPushes - _shape.target.size() : 0;
+		unsigned bound = static_cast<unsigned>(missingCopies * pushOrDupCost + surplus * popCost);
+
+		// Every operation fixes at most two target slots and swaps, which are the only operations fixing two,
+		// cost less than twice as much as the others.
+		size_t wrongSlots = 0;
+		for (size_t offset = 0; offset < _shape.target.size(); ++offset)
+			if (_shape.target[offset] != junk && (offset >= _layout.size() || _layout[offset] != _shape.target[offset]))
+				++wrongSlots;
+		bound = max(bound, static_cast<unsigned>((wrongSlots * swapCost + 1) / 2));
+
+		if (bound == 0 && !isFinal(_layout))
+			bound = min(popCost, junkCost);
+		return bound;
+	};
+
+	optional<unsigned> initialBound = lowerBound(_shape.source);
+	if (!initialBound || *initialBound >= _costBound)
+		return nullopt;
+
+	map<Layout, Node> nodes;
+	// Entries are the estimated total cost, a sequence number for deterministic tie breaking and the layout.
+	priority_queue<tuple<unsigned, size_t, Layout const*>, vector<tuple<unsigned, size_t, Layout const*>>, greater<>> queue;
+	size_t sequenceNumber = 0;
+	queue.emplace(*initialBound, sequenceNumber++, &nodes.emplace(_shape.source, Node{}).first->first);
+
+	size_t expandedLayouts = 0;
+	while (!queue.empty())
+	{
+		unsigned const estimate = get<0>(queue.top());
+		Layout const* layout = get<2>(queue.top());
+		queue.pop();
+		Node const& node = nodes.at(*layout);
+		// Skip outdated entries of layouts that were reached more cheaply later.
+		if (estimate != node.cost + *lowerBound(*layout))
+			continue;
+
+		if (isFinal(*layout))
+		{
+			vector<StackShuffleOperation> operations;
+			for (Layout const* current = layout; nodes.at(*current).predecessor; current = nodes.at(*current).predecessor)
+				operations.emplace_back(nodes.at(*current).operation);
+			reverse(operations.begin(), operations.end());
+			return operations;
+		}
+		if (++expandedLayouts > maxExpandedLayouts)
+			return nullopt;
+
+		auto visitSuccessor = [&](Layout _successor, unsigned _cost, StackShuffleOperation _operation) {
+			unsigned cost = node.cost + _cost;
+			optional<unsigned> bound = lowerBound(_successor);
+			if (!bound || cost + *bound >= _costBound)
+				return;
+			auto [it, inserted] = nodes.try_emplace(std::move(_successor), Node{cost, layout, _operation});
+			if (!inserted)
+			{
+				if (it->second.cost <= cost)
+					return;
+				it->second = Node{cost, layout, _operation};
+			}
+			queue.emplace(cost + *bound, sequenceNumber++, &it->first);
+		};
+
+		size_t const size = layout->size();
+		if (size > 0)
+		{
+			Layout successor = *layout;
+			successor.pop_back();
+			visitSuccessor(std::move(successor), popCost, {StackShuffleOperation::Kind::Pop});
+		}
+		for (size_t depth = 1; depth < size && depth <= 16; ++depth)
+			if ((*layout)[size - depth - 1] != layout->back())
+			{
+				Layout successor = *layout;
+				swap(successor[size - depth - 1], successor.back());
+				visitSuccessor(std::move(successor), swapCost, {StackShuffleOperation::Kind::Swap, depth});
+			}
+		if (size < maxSize)
+			for (size_t index = 0; index < slotCount; ++index)
+			{
+				if (!targetOffsets[index])
+					continue;
+				bool const onStack = util::contains(*layout, static_cast<int>(index));
+				if (!onStack && !_shape.pushable[index])
+					continue;
+				Layout successor = *layout;
+				successor.emplace_back(static_cast<int>(index));
+				visitSuccessor(
+					std::move(successor),
+					static_cast<int>(index) == _shape.junkIndex && !onStack ? junkCost : pushOrDupCost,
+					{StackShuffleOperation::Kind::PushOrDup, *targetOffsets[index]}
+				);
+			}
+	}
+	return nullopt;
+}
+
+}
+
+optional<vector<StackShuffleOperation>> solidity::yul::findOptimalStackShuffling(Stack const& _source, Stack const& _target)
+{
+	if (_source.size() > maxOptimalStackShufflingSize || _target.size() > maxOptimalStackShufflingSize)
+		return nullopt;
+
+	thread_local map<ShufflingShape, optional<vector<StackShuffleOperation>>> cache;
+	ShufflingShape shape = shapeOf(_source, _target);
+	if (auto const* operations = util::valueOrNullptr(cache, shape))
+		return *operations;
+
+	optional<vector<StackShuffleOperation>> operations = searchShuffling(shape, greedyShufflingCost(_source, _target));
+	cache.emplace(std::move(shape), operations);
+	return operations;
+}
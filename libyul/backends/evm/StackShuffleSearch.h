@@ -0,0 +1,55 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Exhaustive search for the cheapest shuffling between two small stack layouts.
+ */
+
+#pragma once
+
+#include <libyul/backends/evm/ControlFlowGraph.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/// A single stack shuffling operation as performed by the callbacks of ``createStackLayout``.
+struct StackShuffleOperation
+{
+	enum class Kind { Swap, PushOrDup, Pop };
+	Kind kind;
+	/// The depth of the slot swapped with the top for swaps and the offset in the target layout
+	/// of the slot to be pushed or dupped for pushes and dups. Unused for pops.
+	size_t argument = 0;
+};
+
+/// Largest size of the source and target layouts for which ``findOptimalStackShuffling`` performs a search.
+static size_t constexpr maxOptimalStackShufflingSize = 8;
+
+/// Searches for a sequence of shuffling operations of minimal gas cost that transforms @a _source
+/// into a layout compatible with @a _target, i.e. one that matches all slots of @a _target that are not
+/// junk. Slots that are not on the stack can only be pushed, if they can be freely generated or do not occur
+/// in @a _source at all, in which case ``createStackLayout`` would push them as well.
+///
+/// The search only considers the equality of the slots, so its results are cached per shape of the two layouts.
+/// @returns the operations, or nullopt if one of the layouts has more than ``maxOptimalStackShufflingSize``
+/// slots, if the search exceeds its limits or if it does not find anything cheaper than ``createStackLayout``.
+std::optional<std::vector<StackShuffleOperation>> findOptimalStackShuffling(Stack const& _source, Stack const& _target);
+
+}
@@ -331,32 +331,40 @@ bytes BinaryTransform::run(Module const& _module)
 	return ret;
 }
 
-bytes BinaryTransform::operator()(Literal const& _literal)
-{
-	return std::visit(GenericVisitor{
-		[&](uint32_t _value) -> bytes { return toBytes(Opcode::I32Const) + lebEncodeSigned(static_cast<int32_t>(_value)); },
-		[&](uint64_t _value) -> bytes { return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(_value)); },
+void BinaryTransform::operator()(Literal const& _literal)
+{
+	std::visit(GenericVisitor{
+		[&](uint32_t _value) {
+			m_code.push_back(uint8_t(Opcode::I32Const));
+			m_code += lebEncodeSigned(static_cast<int32_t>(_value));
+		},
+		[&](uint64_t _value) {
+			m_code.push_back(uint8_t(Opcode::I64Const));
+			m_code += lebEncodeSigned(static_cast<int64_t>(_value));
+		},
 	}, _literal.value);
 }
 
-bytes BinaryTransform::operator()(StringLiteral const&)
+void BinaryTransform::operator()(StringLiteral const&)
 {
 	// StringLiteral is a special AST element used for certain builtins.
 	// It is not mapped to actual WebAssembly, and should be processed in visit(BuiltinCall).
 	yulAssert(false, "");
 }
 
-bytes BinaryTransform::operator()(LocalVariable const& _variable)
+void BinaryTransform::operator()(LocalVariable const& _variable)
 {
-	return toBytes(Opcode::LocalGet) + lebEncode(m_locals.at(_variable.name));
+	m_code.push_back(uint8_t(Opcode::LocalGet));
+	m_code += lebEncode(m_locals.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(GlobalVariable const& _variable)
+void BinaryTransform::operator()(GlobalVariable const& _variable)
 {
-	return toBytes(Opcode::GlobalGet) + lebEncode(m_globalIDs.at(_variable.name));
+	m_code.push_back(uint8_t(Opcode::GlobalGet));
+	m_code += lebEncode(m_globalIDs.at(_variable.name));
 }
 
-bytes BinaryTransform::operator()(BuiltinCall const& _call)
+void BinaryTransform::operator()(BuiltinCall const& _call)
 {
 	// We need to avoid visiting the arguments of `dataoffset` and `datasize` because
 	// they are references to object names that should not end up in the code.
@@ -365,125 +373,130 @@ bytes BinaryTransform::operator()(BuiltinCall const& _call)
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		m_code.push_back(uint8_t(Opcode::I64Const));
+		m_code += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).first));
+		return;
 	}
 	else if (_call.functionName == "datasize")
 	{
 		string name = get<StringLiteral>(_call.arguments.at(0)).value;
 		// TODO: support the case where name refers to the current object
 		yulAssert(m_subModulePosAndSize.count(name), "");
-		return toBytes(Opcode::I64Const) + lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		m_code.push_back(uint8_t(Opcode::I64Const));
+		m_code += lebEncodeSigned(static_cast<int64_t>(m_subModulePosAndSize.at(name).second));
+		return;
 	}
 
 	yulAssert(builtins.count(_call.functionName), "Builtin " + _call.functionName + " not found");
 	// NOTE: the dialect ensures we have the right amount of arguments
-	bytes args = visit(_call.arguments);
-	bytes ret = std::move(args) + toBytes(builtins.at(_call.functionName));
+	visit(_call.arguments);
+	m_code.push_back(builtins.at(_call.functionName));
 	if (
 		_call.functionName.find(".load") != string::npos ||
 		_call.functionName.find(".store") != string::npos
 	)
+	{
 		// Alignment hint and offset. Interpreters ignore the alignment. JITs/AOTs can take it
 		// into account to generate more efficient code but if the hint is invalid it could
 		// actually be more expensive. It's best to hint at 1-byte alignment if we don't plan
 		// to control the memory layout accordingly.
-		ret += bytes{{0, 0}}; // 2^0 == 1-byte alignment
-
-	return ret;
+		m_code.push_back(0); // 2^0 == 1-byte alignment
+		m_code.push_back(0);
+	}
 }
 
-bytes BinaryTransform::operator()(FunctionCall const& _call)
+void BinaryTransform::operator()(FunctionCall const& _call)
 {
-	return visit(_call.arguments) + toBytes(Opcode::Call) + lebEncode(m_functionIDs.at(_call.functionName));
+	visit(_call.arguments);
+	m_code.push_back(uint8_t(Opcode::Call));
+	m_code += lebEncode(m_functionIDs.at(_call.functionName));
 }
 
-bytes BinaryTransform::operator()(LocalAssignment const& _assignment)
+void BinaryTransform::operator()(LocalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::LocalSet) +
-		lebEncode(m_locals.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	m_code.push_back(uint8_t(Opcode::LocalSet));
+	m_code += lebEncode(m_locals.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(GlobalAssignment const& _assignment)
+void BinaryTransform::operator()(GlobalAssignment const& _assignment)
 {
-	return
-		std::visit(*this, *_assignment.value) +
-		toBytes(Opcode::GlobalSet) +
-		lebEncode(m_globalIDs.at(_assignment.variableName));
+	std::visit(*this, *_assignment.value);
+	m_code.push_back(uint8_t(Opcode::GlobalSet));
+	m_code += lebEncode(m_globalIDs.at(_assignment.variableName));
 }
 
-bytes BinaryTransform::operator()(If const& _if)
+void BinaryTransform::operator()(If const& _if)
 {
-	bytes result =
-		std::visit(*this, *_if.condition) +
-		toBytes(Opcode::If) +
-		toBytes(ValueType::Void);
+	std::visit(*this, *_if.condition);
+	m_code.push_back(uint8_t(Opcode::If));
+	m_code.push_back(uint8_t(ValueType::Void));
 
 	m_labels.emplace_back();
 
-	result += visit(_if.statements);
+	visit(_if.statements);
 	if (_if.elseStatements)
-		result += toBytes(Opcode::Else) + visit(*_if.elseStatements);
+	{
+		m_code.push_back(uint8_t(Opcode::Else));
+		visit(*_if.elseStatements);
+	}
 
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	m_code.push_back(uint8_t(Opcode::End));
 }
 
-bytes BinaryTransform::operator()(Loop const& _loop)
+void BinaryTransform::operator()(Loop const& _loop)
 {
-	bytes result = toBytes(Opcode::Loop) + toBytes(ValueType::Void);
+	m_code.push_back(uint8_t(Opcode::Loop));
+	m_code.push_back(uint8_t(ValueType::Void));
 
 	m_labels.emplace_back(_loop.labelName);
-	result += visit(_loop.statements);
+	visit(_loop.statements);
 	m_labels.pop_back();
 
-	result += toBytes(Opcode::End);
-	return result;
+	m_code.push_back(uint8_t(Opcode::End));
 }
 
-bytes BinaryTransform::operator()(Branch const& _branch)
+void BinaryTransform::operator()(Branch const& _branch)
 {
-	return toBytes(Opcode::Br) + encodeLabelIdx(_branch.label.name);
+	m_code.push_back(uint8_t(Opcode::Br));
+	m_code += encodeLabelIdx(_branch.label.name);
 }
 
-bytes BinaryTransform::operator()(BranchIf const& _branchIf)
+void BinaryTransform::operator()(BranchIf const& _branchIf)
 {
-	bytes result = std::visit(*this, *_branchIf.condition);
-	result += toBytes(Opcode::BrIf) + encodeLabelIdx(_branchIf.label.name);
-	return result;
+	std::visit(*this, *_branchIf.condition);
+	m_code.push_back(uint8_t(Opcode::BrIf));
+	m_code += encodeLabelIdx(_branchIf.label.name);
 }
 
-bytes BinaryTransform::operator()(Return const&)
+void BinaryTransform::operator()(Return const&)
 {
 	// Note that this does not work if the function returns a value.
-	return toBytes(Opcode::Return);
+	m_code.push_back(uint8_t(Opcode::Return));
 }
 
-bytes BinaryTransform::operator()(Block const& _block)
+void BinaryTransform::operator()(Block const& _block)
 {
 	m_labels.emplace_back(_block.labelName);
-	bytes result =
-		toBytes(Opcode::Block) +
-		toBytes(ValueType::Void) +
-		visit(_block.statements) +
-		toBytes(Opcode::End);
+	m_code.push_back(uint8_t(Opcode::Block));
+	m_code.push_back(uint8_t(ValueType::Void));
+	visit(_block.statements);
+	m_code.push_back(uint8_t(Opcode::End));
 	m_labels.pop_back();
-	return result;
 }
 
-bytes BinaryTransform::operator()(FunctionDefinition const& _function)
+void BinaryTransform::operator()(FunctionDefinition const& _function)
 {
-	bytes ret;
+	size_t const start = m_code.size();
 
 	vector<pair<size_t, ValueType>> localEntries = groupLocalVariables(_function.locals);
-	ret += lebEncode(localEntries.size());
+	m_code += lebEncode(localEntries.size());
 	for (pair<size_t, ValueType> const& entry: localEntries)
 	{
-		ret += lebEncode(entry.first);
-		ret += toBytes(entry.second);
+		m_code += lebEncode(entry.first);
+		m_code.push_back(uint8_t(entry.second));
 	}
 
 	m_locals.clear();
@@ -495,12 +508,15 @@ bytes BinaryTransform::operator()(FunctionDefinition const& _function)
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	ret += visit(_function.body);
-	ret += toBytes(Opcode::End);
+	visit(_function.body);
+	m_code.push_back(uint8_t(Opcode::End));
 
 	yulAssert(m_labels.empty(), "Stray labels.");
 
-	return prefixSize(std::move(ret));
+	// The size of the function is only known now, so it is inserted in front of its code,
+	// which only moves the code of this function.
+	bytes size = lebEncode(m_code.size() - start);
+	m_code.insert(m_code.begin() + static_cast<ptrdiff_t>(start), size.begin(), size.end());
 }
 
 BinaryTransform::Type BinaryTransform::typeOf(FunctionImport const& _import)
@@ -677,26 +693,22 @@ bytes BinaryTransform::customSection(string const& _name, bytes _data)
 
 bytes BinaryTransform::codeSection(vector<wasm::FunctionDefinition> const& _functions)
 {
-	bytes result = lebEncode(_functions.size());
+	m_code = lebEncode(_functions.size());
 	for (FunctionDefinition const& fun: _functions)
-		result += (*this)(fun);
-	return makeSection(Section::CODE, std::move(result));
+		(*this)(fun);
+	return makeSection(Section::CODE, std::move(m_code));
 }
 
-bytes BinaryTransform::visit(vector<Expression> const& _expressions)
+void BinaryTransform::visit(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
-bytes BinaryTransform::visitReversed(vector<Expression> const& _expressions)
+void BinaryTransform::visitReversed(vector<Expression> const& _expressions)
 {
-	bytes result;
 	for (auto const& expr: _expressions | ranges::views::reverse)
-		result += std::visit(*this, expr);
-	return result;
+		std::visit(*this, expr);
 }
 
 bytes BinaryTransform::encodeLabelIdx(string const& _label) const
@@ -39,21 +39,23 @@ class BinaryTransform
 public:
 	static bytes run(Module const& _module);
 
-	bytes operator()(wasm::Literal const& _literal);
-	bytes operator()(wasm::StringLiteral const& _literal);
-	bytes operator()(wasm::LocalVariable const& _identifier);
-	bytes operator()(wasm::GlobalVariable const& _identifier);
-	bytes operator()(wasm::BuiltinCall const& _builinCall);
-	bytes operator()(wasm::FunctionCall const& _functionCall);
-	bytes operator()(wasm::LocalAssignment const& _assignment);
-	bytes operator()(wasm::GlobalAssignment const& _assignment);
-	bytes operator()(wasm::If const& _if);
-	bytes operator()(wasm::Loop const& _loop);
-	bytes operator()(wasm::Branch const& _branch);
-	bytes operator()(wasm::BranchIf const& _branchIf);
-	bytes operator()(wasm::Return const& _return);
-	bytes operator()(wasm::Block const& _block);
-	bytes operator()(wasm::FunctionDefinition const& _function);
+	/// The visitors append the encoding of the node to the code of the code section.
+
+	void operator()(wasm::Literal const& _literal);
+	void operator()(wasm::StringLiteral const& _literal);
+	void operator()(wasm::LocalVariable const& _identifier);
+	void operator()(wasm::GlobalVariable const& _identifier);
+	void operator()(wasm::BuiltinCall const& _builinCall);
+	void operator()(wasm::FunctionCall const& _functionCall);
+	void operator()(wasm::LocalAssignment const& _assignment);
+	void operator()(wasm::GlobalAssignment const& _assignment);
+	void operator()(wasm::If const& _if);
+	void operator()(wasm::Loop const& _loop);
+	void operator()(wasm::Branch const& _branch);
+	void operator()(wasm::BranchIf const& _branchIf);
+	void operator()(wasm::Return const& _return);
+	void operator()(wasm::Block const& _block);
+	void operator()(wasm::FunctionDefinition const& _function);
 
 private:
 	BinaryTransform(
@@ -102,8 +104,8 @@ private:
 	static bytes customSection(std::string const& _name, bytes _data);
 	bytes codeSection(std::vector<wasm::FunctionDefinition> const& _functions);
 
-	bytes visit(std::vector<wasm::Expression> const& _expressions);
-	bytes visitReversed(std::vector<wasm::Expression> const& _expressions);
+	void visit(std::vector<wasm::Expression> const& _expressions);
+	void visitReversed(std::vector<wasm::Expression> const& _expressions);
 
 	bytes encodeLabelIdx(std::string const& _label) const;
 
@@ -116,6 +118,8 @@ private:
 	/// an absolute offset within the resulting assembled bytecode.
 	std::map<std::string, std::pair<size_t, size_t>> const m_subModulePosAndSize;
 
+	/// The code section without its header, written to by the visitors in a single pass.
+	bytes m_code;
 	std::map<std::string, size_t> m_locals;
 	std::vector<std::string> m_labels;
 };
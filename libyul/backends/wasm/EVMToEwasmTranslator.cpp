@@ -23,6 +23,7 @@
 
 #include <libyul/backends/wasm/WordSizeTransform.h>
 #include <libyul/backends/wasm/WasmDialect.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/MainFunction.h>
@@ -45,6 +46,8 @@
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
+#include <libsolutil/ThreadPool.h>
+
 // The following headers are generated from the
 // yul files placed in libyul/backends/wasm/polyfill.
 
@@ -57,16 +60,113 @@
 #include <ewasmPolyfills/Logical.h>
 #include <ewasmPolyfills/Memory.h>
 
+#include <functional>
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 using namespace solidity::util;
 using namespace solidity::langutil;
 
+namespace
+{
+
+/// The parsed polyfill together with the names of its functions and the functions each of them calls.
+struct Polyfill
+{
+	std::shared_ptr<Block> code;
+	set<YulString> functions;
+	map<YulString, set<YulString>> functionCalls;
+};
+
+Polyfill parsePolyfill()
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(
+		"{" +
+			string(solidity::yul::wasm::polyfill::Arithmetic) +
+			string(solidity::yul::wasm::polyfill::Bitwise) +
+			string(solidity::yul::wasm::polyfill::Comparison) +
+			string(solidity::yul::wasm::polyfill::Conversion) +
+			string(solidity::yul::wasm::polyfill::Interface) +
+			string(solidity::yul::wasm::polyfill::Keccak) +
+			string(solidity::yul::wasm::polyfill::Logical) +
+			string(solidity::yul::wasm::polyfill::Memory) +
+		"}", "");
+
+	// Passing an empty SourceLocation() here is a workaround to prevent a crash
+	// when compiling from yul->ewasm. We're stripping nativeLocation and
+	// originLocation from the AST (but we only really need to strip nativeLocation)
+	Polyfill polyfill;
+	polyfill.code = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
+	if (!errors.empty())
+	{
+		string message;
+		for (auto const& err: errors)
+			message += langutil::SourceReferenceFormatter::formatErrorInformation(
+				*err,
+				SingletonCharStreamProvider(charStream)
+			);
+		yulAssert(false, message);
+	}
+
+	for (auto const& statement: polyfill.code->statements)
+		polyfill.functions.insert(std::get<FunctionDefinition>(statement).name);
+	polyfill.functionCalls = CallGraphGenerator::callGraph(*polyfill.code).functionCalls;
+	return polyfill;
+}
+
+/// @returns the polyfill, which is only parsed once and again after the YulStringRepository is reset.
+Polyfill const& cachedPolyfill()
+{
+	static std::unique_ptr<Polyfill> polyfill;
+	static YulStringRepository::ResetCallback callback{[&] { polyfill.reset(); }};
+	static mutex polyfillMutex;
+	lock_guard lock(polyfillMutex);
+	if (!polyfill)
+		polyfill = make_unique<Polyfill>(parsePolyfill());
+	return *polyfill;
+}
+
+}
+
 Object EVMToEwasmTranslator::run(Object const& _object)
 {
-	if (!m_polyfill)
-		parsePolyfill();
+	vector<Object const*> objects;
+	function<void(Object const&)> collectObjects = [&](Object const& _current) {
+		objects.emplace_back(&_current);
+		for (auto const& subObjectNode: _current.subObjects)
+			if (Object const* subObject = dynamic_cast<Object const*>(subObjectNode.get()))
+				collectObjects(*subObject);
+	};
+	collectObjects(_object);
+
+	// The translation of an object does not depend on its sub-objects, so all of them are
+	// translated in parallel, each with its own NameDispenser.
+	vector<Object> translated(objects.size());
+	ThreadPool::instance().parallelFor(objects.size(), [&](size_t _index) {
+		translated[_index] = translateCode(*objects[_index]);
+	});
+
+	size_t nextIndex = 0;
+	function<Object(Object const&)> assemble = [&](Object const& _current) {
+		Object ret = std::move(translated[nextIndex++]);
+		for (auto const& subObjectNode: _current.subObjects)
+			if (Object const* subObject = dynamic_cast<Object const*>(subObjectNode.get()))
+				ret.subObjects.push_back(make_shared<Object>(assemble(*subObject)));
+			else
+				ret.subObjects.push_back(make_shared<Data>(dynamic_cast<Data const&>(*subObjectNode)));
+		ret.subIndexByName = _current.subIndexByName;
+		return ret;
+	};
+	return assemble(_object);
+}
+
+Object EVMToEwasmTranslator::translateCode(Object const& _object) const
+{
+	Polyfill const& polyfill = cachedPolyfill();
 
 	Block ast = std::get<Block>(Disambiguator(m_dialect, *_object.analysisInfo)(*_object.code));
 	set<YulString> reservedIdentifiers;
@@ -86,9 +186,26 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ExpressionSplitter::run(context, ast);
 	WordSizeTransform::run(m_dialect, WasmDialect::instance(), ast, nameDispenser);
 
-	NameDisplacer{nameDispenser, m_polyfillFunctions}(ast);
-	for (auto const& st: m_polyfill->statements)
-		ast.statements.emplace_back(ASTCopier{}.translate(st));
+	NameDisplacer{nameDispenser, polyfill.functions}(ast);
+
+	set<YulString> usedFunctions;
+	vector<YulString> toVisit;
+	auto markUsed = [&](set<YulString> const& _callees) {
+		for (YulString callee: _callees)
+			if (polyfill.functions.count(callee) && usedFunctions.insert(callee).second)
+				toVisit.emplace_back(callee);
+	};
+	for (auto const& [caller, callees]: CallGraphGenerator::callGraph(ast).functionCalls)
+		markUsed(callees);
+	while (!toVisit.empty())
+	{
+		YulString function = toVisit.back();
+		toVisit.pop_back();
+		markUsed(polyfill.functionCalls.at(function));
+	}
+	for (auto const& statement: polyfill.code->statements)
+		if (usedFunctions.count(std::get<FunctionDefinition>(statement).name))
+			ast.statements.emplace_back(ASTCopier{}.translate(statement));
 
 	Object ret;
 	ret.name = _object.name;
@@ -112,48 +229,5 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 		yulAssert(false, message);
 	}
 
-	for (auto const& subObjectNode: _object.subObjects)
-		if (Object const* subObject = dynamic_cast<Object const*>(subObjectNode.get()))
-			ret.subObjects.push_back(make_shared<Object>(run(*subObject)));
-		else
-			ret.subObjects.push_back(make_shared<Data>(dynamic_cast<Data const&>(*subObjectNode)));
-	ret.subIndexByName = _object.subIndexByName;
-
 	return ret;
 }
-
-void EVMToEwasmTranslator::parsePolyfill()
-{
-	ErrorList errors;
-	ErrorReporter errorReporter(errors);
-	CharStream charStream(
-		"{" +
-			string(solidity::yul::wasm::polyfill::Arithmetic) +
-			string(solidity::yul::wasm::polyfill::Bitwise) +
-			string(solidity::yul::wasm::polyfill::Comparison) +
-			string(solidity::yul::wasm::polyfill::Conversion) +
-			string(solidity::yul::wasm::polyfill::Interface) +
-			string(solidity::yul::wasm::polyfill::Keccak) +
-			string(solidity::yul::wasm::polyfill::Logical) +
-			string(solidity::yul::wasm::polyfill::Memory) +
-		"}", "");
-
-	// Passing an empty SourceLocation() here is a workaround to prevent a crash
-	// when compiling from yul->ewasm. We're stripping nativeLocation and
-	// originLocation from the AST (but we only really need to strip nativeLocation)
-	m_polyfill = Parser(errorReporter, WasmDialect::instance(), langutil::SourceLocation()).parse(charStream);
-	if (!errors.empty())
-	{
-		string message;
-		for (auto const& err: errors)
-			message += langutil::SourceReferenceFormatter::formatErrorInformation(
-				*err,
-				SingletonCharStreamProvider(charStream)
-			);
-		yulAssert(false, message);
-	}
-
-	m_polyfillFunctions.clear();
-	for (auto const& statement: m_polyfill->statements)
-		m_polyfillFunctions.insert(std::get<FunctionDefinition>(statement).name);
-}
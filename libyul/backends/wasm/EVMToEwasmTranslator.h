@@ -40,16 +40,16 @@ public:
 		m_dialect(_evmDialect),
 		m_charStreamProvider(_charStreamProvider)
 	{}
+	/// Translates @a _object and its sub-objects, in parallel if util::ThreadPool is enabled.
 	Object run(Object const& _object);
 
 private:
-	void parsePolyfill();
+	/// Translates the code of @a _object without its sub-objects. Only the polyfill functions
+	/// that are (transitively) called by the translated code are added to it.
+	Object translateCode(Object const& _object) const;
 
 	Dialect const& m_dialect;
 	langutil::CharStreamProvider const& m_charStreamProvider;
-
-	std::shared_ptr<Block> m_polyfill;
-	std::set<YulString> m_polyfillFunctions;
 };
 
 }
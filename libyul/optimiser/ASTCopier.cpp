@@ -171,7 +171,7 @@ TypedName ASTCopier::translate(TypedName const& _typedName)
 
 YulString FunctionCopier::translateIdentifier(YulString _name)
 {
-	if (m_translations.count(_name))
-		return m_translations.at(_name);
+	if (auto translation = m_translations.find(_name); translation != m_translations.end())
+		return translation->second;
 	return _name;
 }
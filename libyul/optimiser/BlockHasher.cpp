@@ -45,11 +45,19 @@ static constexpr uint64_t compileTimeLiteralHash(char const (&_literal)[N])
 std::map<Block const*, uint64_t> BlockHasher::run(Block const& _block)
 {
 	std::map<Block const*, uint64_t> result;
-	BlockHasher blockHasher(result);
+	BlockHasher blockHasher(&result);
 	blockHasher(_block);
 	return result;
 }
 
+uint64_t BlockHasher::hash(Block const& _block)
+{
+	BlockHasher blockHasher(nullptr);
+	for (auto const& statement: _block.statements)
+		blockHasher.visit(statement);
+	return blockHasher.m_hash;
+}
+
 void BlockHasher::operator()(Literal const& _literal)
 {
 	hash64(compileTimeLiteralHash("Literal"));
@@ -186,7 +194,8 @@ void BlockHasher::operator()(Block const& _block)
 	for (auto const& statement: _block.statements)
 		subBlockHasher.visit(statement);
 
-	m_blockHashes[&_block] = subBlockHasher.m_hash;
+	if (m_blockHashes)
+		(*m_blockHashes)[&_block] = subBlockHasher.m_hash;
 
 	hash64(subBlockHasher.m_hash);
 	hash64(subBlockHasher.m_externalReferences.size());
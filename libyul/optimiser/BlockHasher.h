@@ -94,13 +94,18 @@ public:
 	void operator()(Leave const&) override;
 	void operator()(Block const& _block) override;
 
+	/// @returns the hashes of all non-empty blocks inside @a _block, including @a _block itself.
 	static std::map<Block const*, uint64_t> run(Block const& _block);
+	/// @returns the hash of @a _block only. For non-empty blocks, this is the same value
+	/// that @a run reports for the block, but the nested blocks are not recorded.
+	static uint64_t hash(Block const& _block);
 
 
 private:
-	BlockHasher(std::map<Block const*, uint64_t>& _blockHashes): m_blockHashes(_blockHashes) {}
+	BlockHasher(std::map<Block const*, uint64_t>* _blockHashes): m_blockHashes(_blockHashes) {}
 
-	std::map<Block const*, uint64_t>& m_blockHashes;
+	/// Hashes of visited blocks. Nothing is recorded if this is null.
+	std::map<Block const*, uint64_t>* m_blockHashes = nullptr;
 
 	struct VariableReference
 	{
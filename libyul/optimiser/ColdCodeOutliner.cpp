@@ -0,0 +1,199 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that moves repeated code that always reverts into shared functions.
+ */
+
+#include <libyul/optimiser/ColdCodeOutliner.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/AST.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/Dialect.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/algorithm/find_if.hpp>
+#include <range/v3/algorithm/sort.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+void ColdCodeOutliner::run(OptimiserStepContext& _context, Block& _ast)
+{
+	set<YulString> topLevelFunctions;
+	for (Statement const& statement: _ast.statements)
+		if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+			topLevelFunctions.insert(function->name);
+
+	ColdCodeOutliner outliner{
+		_context.dialect,
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed(),
+		std::move(topLevelFunctions)
+	};
+	outliner(_ast);
+	outliner.outline(_ast, _context.dispenser);
+}
+
+void ColdCodeOutliner::operator()(If& _if)
+{
+	visit(*_if.condition);
+	visitBody(_if.body);
+}
+
+void ColdCodeOutliner::operator()(Switch& _switch)
+{
+	visit(*_switch.expression);
+	for (Case& switchCase: _switch.cases)
+		visitBody(switchCase.body);
+}
+
+void ColdCodeOutliner::visitBody(Block& _block)
+{
+	if (!isCold(_block))
+	{
+		(*this)(_block);
+		return;
+	}
+
+	// The variables declared outside of the block become parameters in the order of their first reference.
+	set<YulString> declaredVariables = NameCollector{_block, NameCollector::OnlyVariables}.names();
+	set<YulString> externalVariables;
+	vector<TypedName> parameters;
+	forEach<Identifier const>(_block, [&](Identifier const& _identifier) {
+		if (!declaredVariables.count(_identifier.name) && externalVariables.insert(_identifier.name).second)
+			parameters.emplace_back(TypedName{_identifier.debugData, _identifier.name, m_dialect.defaultType});
+	});
+	m_candidates.emplace_back(Candidate{
+		&_block,
+		FunctionDefinition{_block.debugData, {}, std::move(parameters), {}, ASTCopier{}.translate(_block)}
+	});
+}
+
+bool ColdCodeOutliner::isCold(Block const& _block) const
+{
+	if (_block.statements.empty())
+		return false;
+
+	ExpressionStatement const* last = get_if<ExpressionStatement>(&_block.statements.back());
+	FunctionCall const* call = last ? get_if<FunctionCall>(&last->expression) : nullptr;
+	if (!call)
+		return false;
+	ControlFlowSideEffects sideEffects;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(call->functionName.name))
+		sideEffects = builtin->controlFlowSideEffects;
+	else if (ControlFlowSideEffects const* functionSideEffects = valueOrNullptr(m_functionSideEffects, call->functionName.name))
+		sideEffects = *functionSideEffects;
+	else
+		return false;
+	if (!sideEffects.canRevert || sideEffects.canContinue || sideEffects.canTerminate)
+		return false;
+
+	bool movable = NameCollector{_block, NameCollector::OnlyFunctions}.names().empty();
+	forEach<Break const>(_block, [&](Break const&) { movable = false; });
+	forEach<Continue const>(_block, [&](Continue const&) { movable = false; });
+	forEach<Leave const>(_block, [&](Leave const&) { movable = false; });
+	forEach<FunctionCall const>(_block, [&](FunctionCall const& _call) {
+		if (!m_dialect.builtin(_call.functionName.name) && !m_topLevelFunctions.count(_call.functionName.name))
+			movable = false;
+	});
+	return movable;
+}
+
+void ColdCodeOutliner::outline(Block& _ast, NameDispenser& _nameDispenser)
+{
+	map<uint64_t, vector<vector<size_t>>> groupsByHash;
+	for (size_t index = 0; index < m_candidates.size(); ++index)
+	{
+		vector<vector<size_t>>& groups = groupsByHash[BlockHasher::hash(*m_candidates[index].block)];
+		auto group = ranges::find_if(groups, [&](vector<size_t> const& _group) {
+			return SyntacticallyEqual{}.statementEqual(
+				m_candidates[_group.front()].definition,
+				m_candidates[index].definition
+			);
+		});
+		if (group != groups.end())
+			group->emplace_back(index);
+		else
+			groups.emplace_back(vector<size_t>{index});
+	}
+
+	// Create the functions in the order of the first occurrence of their body.
+	vector<vector<size_t>> groups;
+	for (auto&& [hash, groupsWithHash]: groupsByHash)
+		for (vector<size_t>& group: groupsWithHash)
+			groups.emplace_back(std::move(group));
+	ranges::sort(groups, [](vector<size_t> const& _lhs, vector<size_t> const& _rhs) {
+		return _lhs.front() < _rhs.front();
+	});
+
+	// The functions are only added in the end, because the candidates point into the AST.
+	vector<Statement> functions;
+	for (vector<size_t> const& group: groups)
+	{
+		Candidate const& first = m_candidates[group.front()];
+		size_t parameterCount = first.definition.parameters.size();
+		size_t occurrences = group.size();
+		size_t blockSize = CodeSize::codeSize(*first.block);
+		// Each argument and parameter is roughly counted as one stack operation.
+		size_t callSize = CodeWeights{}.functionCallCost + parameterCount;
+		size_t functionSize = CodeWeights{}.functionDefinitionCost + parameterCount + blockSize;
+		if (occurrences * callSize + functionSize >= occurrences * blockSize)
+			continue;
+
+		YulString functionName = _nameDispenser.newName("outlined"_yulstring);
+		map<YulString, YulString> translations;
+		vector<TypedName> parameters;
+		for (TypedName const& parameter: first.definition.parameters)
+		{
+			YulString parameterName = _nameDispenser.newName(parameter.name);
+			translations[parameter.name] = parameterName;
+			parameters.emplace_back(TypedName{parameter.debugData, parameterName, parameter.type});
+		}
+		functions.emplace_back(FunctionDefinition{
+			first.block->debugData,
+			functionName,
+			std::move(parameters),
+			{},
+			FunctionCopier{translations}.translate(*first.block)
+		});
+
+		for (size_t index: group)
+		{
+			Candidate const& candidate = m_candidates[index];
+			shared_ptr<DebugData const> debugData = candidate.block->debugData;
+			vector<Expression> arguments;
+			for (TypedName const& parameter: candidate.definition.parameters)
+				arguments.emplace_back(Identifier{parameter.debugData, parameter.name});
+			candidate.block->statements = make_vector<Statement>(ExpressionStatement{
+				debugData,
+				FunctionCall{debugData, Identifier{debugData, functionName}, std::move(arguments)}
+			});
+		}
+	}
+
+	for (Statement& function: functions)
+		_ast.statements.emplace_back(std::move(function));
+}
@@ -0,0 +1,111 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that moves repeated code that always reverts into shared functions.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+#include <libyul/ControlFlowSideEffects.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Optimisation stage that reduces code size by extracting syntactically equal bodies of
+ * ``if`` statements and ``switch`` cases that always revert into a single function.
+ *
+ * A block is considered cold if its last statement is a call to a function that always
+ * reverts and it does not contain ``break``, ``continue``, ``leave`` or function definitions.
+ * Since control flow never continues after such a block, it is only executed on failure
+ * and calling a function instead does not affect the cost of successful executions.
+ *
+ * Variables that are referenced in the block but declared outside of it become parameters
+ * of the new function. Assignments to them are not visible outside because of the revert.
+ * Blocks are only extracted if all the functions they call are defined at the top level
+ * and if, according to the rough code size metric, the size of the new function and the
+ * calls is smaller than the size of all occurrences.
+ *
+ * Code of the form
+ *
+ * if lt(a, 4) { mstore(0, shl(224, 0x4e487b71)) mstore(4, 0x32) revert(0, 0x24) }
+ * if lt(b, 4) { mstore(0, shl(224, 0x4e487b71)) mstore(4, 0x32) revert(0, 0x24) }
+ *
+ * is transformed into
+ *
+ * if lt(a, 4) { outlined() }
+ * if lt(b, 4) { outlined() }
+ * function outlined() { mstore(0, shl(224, 0x4e487b71)) mstore(4, 0x32) revert(0, 0x24) }
+ *
+ * Nested cold blocks are not considered separately.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class ColdCodeOutliner: public ASTModifier
+{
+public:
+	static constexpr char const* name{"ColdCodeOutliner"};
+	static void run(OptimiserStepContext& _context, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(If& _if) override;
+	void operator()(Switch& _switch) override;
+
+private:
+	/// A cold block together with a function definition that has the block as its body
+	/// and the externally declared variables it references as parameters.
+	struct Candidate
+	{
+		Block* block = nullptr;
+		FunctionDefinition definition;
+	};
+
+	ColdCodeOutliner(
+		Dialect const& _dialect,
+		std::map<YulString, ControlFlowSideEffects> _functionSideEffects,
+		std::set<YulString> _topLevelFunctions
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_topLevelFunctions(std::move(_topLevelFunctions))
+	{}
+
+	/// Records @a _block as a candidate if it is cold and visits it otherwise.
+	void visitBody(Block& _block);
+	/// @returns true if @a _block always reverts and can be moved to a top-level function.
+	bool isCold(Block const& _block) const;
+	/// Replaces the blocks of each group of equal candidates by calls to a new function
+	/// if this reduces the code size and adds these functions to @a _ast.
+	void outline(Block& _ast, NameDispenser& _nameDispenser);
+
+	Dialect const& m_dialect;
+	std::map<YulString, ControlFlowSideEffects> m_functionSideEffects;
+	std::set<YulString> m_topLevelFunctions;
+	std::vector<Candidate> m_candidates;
+};
+
+}
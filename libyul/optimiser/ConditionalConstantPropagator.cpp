@@ -0,0 +1,325 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that propagates constants through the whole program, taking
+ * into account which branches can be executed.
+ */
+
+#include <libyul/optimiser/ConditionalConstantPropagator.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Value of a variable or an expression in the lattice of the propagation.
+struct Value
+{
+	enum class Kind { Unknown, Constant, NotConstant };
+
+	static Value makeNotConstant() { return Value{Kind::NotConstant, 0}; }
+	static Value makeConstant(u256 _value) { return Value{Kind::Constant, std::move(_value)}; }
+
+	bool operator==(Value const& _other) const { return kind == _other.kind && constant == _other.constant; }
+	bool operator!=(Value const& _other) const { return !(*this == _other); }
+
+	/// @returns false if the value is known to be zero or still unknown.
+	bool canBeNonZero() const { return kind == Kind::NotConstant || (kind == Kind::Constant && constant != 0); }
+
+	Kind kind = Kind::Unknown;
+	u256 constant;
+};
+
+/**
+ * Determines the values of all variables and the code that can be executed.
+ *
+ * The whole program is traversed repeatedly until the values do not change anymore.
+ * Values only ever move from unknown to constant and from constant to not constant,
+ * and code only becomes executable, so this terminates.
+ */
+class ConstantAnalysis
+{
+public:
+	ConstantAnalysis(Dialect const& _dialect, Block const& _ast):
+		m_dialect(_dialect),
+		m_functions(allFunctionDefinitions(_ast))
+	{
+		do
+		{
+			m_changed = false;
+			visitBlock(_ast);
+			for (YulString function: vector<YulString>(m_executableFunctions.begin(), m_executableFunctions.end()))
+				visitBlock(m_functions.at(function)->body);
+		}
+		while (m_changed);
+	}
+
+	/// @returns the constant values of variables and calls.
+	map<YulString, u256> constantVariables() const
+	{
+		map<YulString, u256> result;
+		for (auto const& [name, value]: m_values)
+			if (value.kind == Value::Kind::Constant)
+				result[name] = value.constant;
+		return result;
+	}
+
+	/// @returns the constant results of function calls that can be executed.
+	map<FunctionCall const*, u256> constantCalls() const
+	{
+		map<FunctionCall const*, u256> result;
+		for (auto const& [call, value]: m_callValues)
+			if (value.kind == Value::Kind::Constant)
+				result[call] = value.constant;
+		return result;
+	}
+
+private:
+	void visitBlock(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			visitStatement(statement);
+	}
+
+	void visitStatement(Statement const& _statement)
+	{
+		std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) { evaluate(_expressionStatement.expression); },
+			[&](Assignment const& _assignment) {
+				vector<Value> values = evaluate(*_assignment.value, _assignment.variableNames.size());
+				for (size_t i = 0; i < _assignment.variableNames.size(); ++i)
+					meet(_assignment.variableNames[i].name, values[i]);
+			},
+			[&](VariableDeclaration const& _declaration) {
+				vector<Value> values =
+					_declaration.value ?
+					evaluate(*_declaration.value, _declaration.variables.size()) :
+					vector<Value>(_declaration.variables.size(), Value::makeConstant(0));
+				for (size_t i = 0; i < _declaration.variables.size(); ++i)
+					meet(_declaration.variables[i], values[i]);
+			},
+			[&](FunctionDefinition const&) {},
+			[&](If const& _if) {
+				if (evaluate(*_if.condition).canBeNonZero())
+					visitBlock(_if.body);
+			},
+			[&](Switch const& _switch) {
+				Value value = evaluate(*_switch.expression);
+				if (value.kind == Value::Kind::Unknown)
+					return;
+				bool matched = false;
+				for (Case const& switchCase: _switch.cases)
+					if (switchCase.value && value.kind == Value::Kind::Constant && valueOfLiteral(*switchCase.value) == value.constant)
+						matched = true;
+				for (Case const& switchCase: _switch.cases)
+					if (
+						value.kind == Value::Kind::NotConstant ||
+						(switchCase.value ? valueOfLiteral(*switchCase.value) == value.constant : !matched)
+					)
+						visitBlock(switchCase.body);
+			},
+			[&](ForLoop const& _loop) {
+				visitBlock(_loop.pre);
+				if (evaluate(*_loop.condition).canBeNonZero())
+				{
+					visitBlock(_loop.body);
+					visitBlock(_loop.post);
+				}
+			},
+			[&](Break const&) {},
+			[&](Continue const&) {},
+			[&](Leave const&) {},
+			[&](Block const& _block) { visitBlock(_block); }
+		}, _statement);
+	}
+
+	/// @returns the values of the @a _count values @a _expression evaluates to.
+	vector<Value> evaluate(Expression const& _expression, size_t _count)
+	{
+		if (_count == 1)
+			return {evaluate(_expression)};
+		else if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+			return evaluate(*call);
+		else
+			return vector<Value>(_count, Value::makeNotConstant());
+	}
+
+	Value evaluate(Expression const& _expression)
+	{
+		if (Literal const* literal = get_if<Literal>(&_expression))
+		{
+			if (!isDefaultType(literal->type) || (literal->kind == LiteralKind::String && literal->value.str().size() > 32))
+				return Value::makeNotConstant();
+			return Value::makeConstant(valueOfLiteral(*literal));
+		}
+		else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+			return util::valueOrDefault(m_values, identifier->name);
+		else
+		{
+			vector<Value> values = evaluate(std::get<FunctionCall>(_expression));
+			return values.size() == 1 ? values.front() : Value::makeNotConstant();
+		}
+	}
+
+	/// @returns the values of the return values of @a _call.
+	/// Marks called functions as executable and updates the values of their parameters.
+	vector<Value> evaluate(FunctionCall const& _call)
+	{
+		vector<Value> results;
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name))
+			results = evaluateBuiltin(*builtin, _call);
+		else
+		{
+			FunctionDefinition const* function = m_functions.at(_call.functionName.name);
+			if (m_executableFunctions.insert(function->name).second)
+			{
+				m_changed = true;
+				for (TypedName const& returnVariable: function->returnVariables)
+					meet(returnVariable, Value::makeConstant(0));
+			}
+			yulAssert(function->parameters.size() == _call.arguments.size(), "");
+			for (size_t i = 0; i < _call.arguments.size(); ++i)
+				meet(function->parameters[i], evaluate(_call.arguments[i]));
+			for (TypedName const& returnVariable: function->returnVariables)
+				results.emplace_back(util::valueOrDefault(m_values, returnVariable.name));
+		}
+		if (results.size() == 1)
+			m_callValues[&_call] = results.front();
+		return results;
+	}
+
+	vector<Value> evaluateBuiltin(BuiltinFunction const& _builtin, FunctionCall const& _call)
+	{
+		vector<u256> arguments;
+		bool unknown = false;
+		bool notConstant = _builtin.returns.size() != 1 || !_builtin.sideEffects.movable;
+		for (size_t i = 0; i < _call.arguments.size(); ++i)
+		{
+			if (_builtin.literalArgument(i))
+			{
+				notConstant = true;
+				continue;
+			}
+			Value value = evaluate(_call.arguments[i]);
+			if (value.kind == Value::Kind::NotConstant)
+				notConstant = true;
+			else if (value.kind == Value::Kind::Unknown)
+				unknown = true;
+			else
+				arguments.emplace_back(value.constant);
+		}
+
+		if (notConstant)
+			return vector<Value>(_builtin.returns.size(), Value::makeNotConstant());
+		else if (unknown)
+			return {Value{}};
+		else if (optional<u256> result = fold(_builtin.name, arguments))
+			return {Value::makeConstant(*result)};
+		else
+			return {Value::makeNotConstant()};
+	}
+
+	/// @returns the result of the builtin @a _builtin applied to @a _arguments, if the
+	/// simplification rules can compute it.
+	optional<u256> fold(YulString _builtin, vector<u256> const& _arguments)
+	{
+		auto [it, inserted] = m_foldedValues.try_emplace(make_pair(_builtin, _arguments));
+		if (!inserted)
+			return it->second;
+
+		it->second = evaluateBuiltinCall(m_dialect, _builtin, _arguments);
+		return it->second;
+	}
+
+	void meet(TypedName const& _variable, Value const& _value)
+	{
+		meet(_variable.name, isDefaultType(_variable.type) ? _value : Value::makeNotConstant());
+	}
+
+	void meet(YulString _variable, Value const& _value)
+	{
+		Value& current = m_values[_variable];
+		Value updated = current;
+		if (current.kind == Value::Kind::Unknown)
+			updated = _value;
+		else if (current.kind == Value::Kind::Constant && _value.kind != Value::Kind::Unknown && _value != current)
+			updated = Value::makeNotConstant();
+		if (updated != current)
+		{
+			current = std::move(updated);
+			m_changed = true;
+		}
+	}
+
+	bool isDefaultType(YulString _type) const { return _type.empty() || _type == m_dialect.defaultType; }
+
+	Dialect const& m_dialect;
+	map<YulString, FunctionDefinition const*> m_functions;
+	map<YulString, Value> m_values;
+	set<YulString> m_executableFunctions;
+	map<FunctionCall const*, Value> m_callValues;
+	map<pair<YulString, vector<u256>>, optional<u256>> m_foldedValues;
+	bool m_changed = false;
+};
+
+}
+
+void ConditionalConstantPropagator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	ConstantAnalysis analysis{_context.dialect, _ast};
+	ConditionalConstantPropagator{
+		_context.dialect,
+		analysis.constantVariables(),
+		analysis.constantCalls(),
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	}(_ast);
+}
+
+void ConditionalConstantPropagator::visit(Expression& _expression)
+{
+	ASTModifier::visit(_expression);
+
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (u256 const* value = util::valueOrNullptr(m_variableValues, identifier->name))
+			_expression = Literal{identifier->debugData, LiteralKind::Number, YulString{formatNumber(*value)}, {}};
+	}
+	else if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+		if (u256 const* value = util::valueOrNullptr(m_callValues, call))
+		{
+			SideEffectsCollector sideEffects{m_dialect, _expression, &m_functionSideEffects};
+			if (sideEffects.canBeRemoved() && sideEffects.cannotLoop())
+				_expression = Literal{call->debugData, LiteralKind::Number, YulString{formatNumber(*value)}, {}};
+		}
+}
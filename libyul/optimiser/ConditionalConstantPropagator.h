@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that propagates constants through the whole program, taking
+ * into account which branches can be executed.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/SideEffects.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Sparse conditional constant propagation over the whole program.
+ *
+ * Every variable, including function parameters and return variables, is assigned a value
+ * that is either still unknown, a constant or not constant. Assignments and declarations
+ * contribute to the value of the variable only if they can be executed. The body of an ``if``,
+ * the cases of a ``switch`` and the body of a ``for`` loop can be executed unless their
+ * condition is a constant that rules them out, and a function can be executed if it is called
+ * from code that can be executed. The values of the parameters of a function follow from its
+ * calls. The values are refined until nothing changes anymore.
+ *
+ * Afterwards, references to constant variables are replaced by literals and calls to
+ * builtins and removable functions whose result is constant are replaced by their result.
+ * Branches that cannot be executed are not removed, but their conditions become literals
+ * that the StructuralSimplifier can use.
+ *
+ * Since the value of a variable combines all of its assignments, the step is most effective
+ * on code in SSA form.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class ConditionalConstantPropagator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"ConditionalConstantPropagator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override;
+
+private:
+	ConditionalConstantPropagator(
+		Dialect const& _dialect,
+		std::map<YulString, u256> _variableValues,
+		std::map<FunctionCall const*, u256> _callValues,
+		std::map<YulString, SideEffects> _functionSideEffects
+	):
+		m_dialect(_dialect),
+		m_variableValues(std::move(_variableValues)),
+		m_callValues(std::move(_callValues)),
+		m_functionSideEffects(std::move(_functionSideEffects))
+	{}
+
+	Dialect const& m_dialect;
+	std::map<YulString, u256> m_variableValues;
+	/// Constant results of calls with a single return value.
+	std::map<FunctionCall const*, u256> m_callValues;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+};
+
+}
@@ -36,6 +36,8 @@
 
 #include <variant>
 
+#include <range/v3/algorithm/any_of.hpp>
+#include <range/v3/algorithm/none_of.hpp>
 #include <range/v3/view/reverse.hpp>
 
 using namespace std;
@@ -46,10 +48,12 @@ using namespace solidity::yul;
 DataFlowAnalyzer::DataFlowAnalyzer(
 	Dialect const& _dialect,
 	MemoryAndStorage _analyzeStores,
-	map<YulString, SideEffects> _functionSideEffects
+	map<YulString, SideEffects> _functionSideEffects,
+	map<YulString, StorageWrites> _functionStorageWrites
 ):
 	m_dialect(_dialect),
 	m_functionSideEffects(std::move(_functionSideEffects)),
+	m_functionStorageWrites(std::move(_functionStorageWrites)),
 	m_knowledgeBase([this](YulString _var) { return variableValue(_var); }),
 	m_analyzeStores(_analyzeStores == MemoryAndStorage::Analyze)
 {
@@ -73,23 +77,25 @@ void DataFlowAnalyzer::operator()(ExpressionStatement& _statement)
 		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&](auto&& key, auto&& value) {
+			Environment& environment = mutableEnvironment();
+			cxx20::erase_if(environment.storage, mapTuple([&](auto&& key, auto&& value) {
 				return
 					!m_knowledgeBase.knownToBeDifferent(vars->first, key) &&
 					vars->second != value;
 			}));
-			m_state.environment.storage[vars->first] = vars->second;
+			environment.storage[vars->first] = vars->second;
 			return;
 		}
 		else if (auto vars = isSimpleStore(StoreLoadLocation::Memory, _statement))
 		{
 			ASTModifier::operator()(_statement);
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
+			Environment& environment = mutableEnvironment();
+			cxx20::erase_if(environment.memory, mapTuple([&](auto&& key, auto&& /* value */) {
 				return !m_knowledgeBase.knownToBeDifferentByAtLeast32(vars->first, key);
 			}));
 			// TODO erase keccak knowledge, but in a more clever way
-			m_state.environment.keccak = {};
-			m_state.environment.memory[vars->first] = vars->second;
+			environment.keccak = {};
+			environment.memory[vars->first] = vars->second;
 			return;
 		}
 	}
@@ -127,7 +133,7 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 void DataFlowAnalyzer::operator()(If& _if)
 {
 	clearKnowledgeIfInvalidated(*_if.condition);
-	Environment preEnvironment = m_state.environment;
+	shared_ptr<Environment> preEnvironment = m_state.environment;
 
 	ASTModifier::operator()(_if);
 	joinKnowledge(preEnvironment);
@@ -142,7 +148,7 @@ void DataFlowAnalyzer::operator()(Switch& _switch)
 	set<YulString> assignedVariables;
 	for (auto& _case: _switch.cases)
 	{
-		Environment preEnvironment = m_state.environment;
+		shared_ptr<Environment> preEnvironment = m_state.environment;
 		(*this)(_case.body);
 		joinKnowledge(preEnvironment);
 
@@ -225,7 +231,7 @@ void DataFlowAnalyzer::operator()(Block& _block)
 
 optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.storage, _key))
+	if (YulString const* value = valueOrNullptr(m_state.environment->storage, _key))
 		return *value;
 	else
 		return nullopt;
@@ -233,7 +239,7 @@ optional<YulString> DataFlowAnalyzer::storageValue(YulString _key) const
 
 optional<YulString> DataFlowAnalyzer::memoryValue(YulString _key) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.memory, _key))
+	if (YulString const* value = valueOrNullptr(m_state.environment->memory, _key))
 		return *value;
 	else
 		return nullopt;
@@ -241,7 +247,7 @@ optional<YulString> DataFlowAnalyzer::memoryValue(YulString _key) const
 
 optional<YulString> DataFlowAnalyzer::keccakValue(YulString _start, YulString _length) const
 {
-	if (YulString const* value = valueOrNullptr(m_state.environment.keccak, make_pair(_start, _length)))
+	if (YulString const* value = valueOrNullptr(m_state.environment->keccak, make_pair(_start, _length)))
 		return *value;
 	else
 		return nullopt;
@@ -271,20 +277,34 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 	auto const& referencedVariables = movableChecker.referencedVariables();
 	for (auto const& name: _variables)
 	{
-		m_state.references[name] = referencedVariables;
+		setReferences(name, referencedVariables);
 		if (!_isDeclaration)
 		{
+			auto matchesValue = mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; });
+			auto matchesKeccak = [&name](auto&& _item) {
+				return _item.first.first == name || _item.first.second == name || _item.second == name;
+			};
+			Environment const& environment = *m_state.environment;
+			// Most assignments do not affect storage or memory knowledge,
+			// avoid copying a shared environment in that case.
+			if (
+				!environment.storage.count(name) &&
+				!environment.memory.count(name) &&
+				ranges::none_of(environment.storage, matchesValue) &&
+				ranges::none_of(environment.memory, matchesValue) &&
+				ranges::none_of(environment.keccak, matchesKeccak)
+			)
+				continue;
+			Environment& mutableEnv = mutableEnvironment();
 			// assignment to slot denoted by "name"
-			m_state.environment.storage.erase(name);
+			mutableEnv.storage.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.storage, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			cxx20::erase_if(mutableEnv.storage, matchesValue);
 			// assignment to slot denoted by "name"
-			m_state.environment.memory.erase(name);
+			mutableEnv.memory.erase(name);
 			// assignment to slot contents denoted by "name"
-			cxx20::erase_if(m_state.environment.keccak, [&name](auto&& _item) {
-				return _item.first.first == name || _item.first.second == name || _item.second == name;
-			});
-			cxx20::erase_if(m_state.environment.memory, mapTuple([&name](auto&& /* key */, auto&& value) { return value == name; }));
+			cxx20::erase_if(mutableEnv.keccak, matchesKeccak);
+			cxx20::erase_if(mutableEnv.memory, matchesValue);
 		}
 	}
 
@@ -297,11 +317,11 @@ void DataFlowAnalyzer::handleAssignment(set<YulString> const& _variables, Expres
 			// On the other hand, if we knew the value in the slot
 			// already, then the sload() / mload() would have been replaced by a variable anyway.
 			if (auto key = isSimpleLoad(StoreLoadLocation::Memory, *_value))
-				m_state.environment.memory[*key] = variable;
+				mutableEnvironment().memory[*key] = variable;
 			else if (auto key = isSimpleLoad(StoreLoadLocation::Storage, *_value))
-				m_state.environment.storage[*key] = variable;
+				mutableEnvironment().storage[*key] = variable;
 			else if (auto arguments = isKeccak(*_value))
-				m_state.environment.keccak[*arguments] = variable;
+				mutableEnvironment().keccak[*arguments] = variable;
 		}
 	}
 }
@@ -316,7 +336,7 @@ void DataFlowAnalyzer::popScope()
 	for (auto const& name: m_variableScopes.back().variables)
 	{
 		m_state.value.erase(name);
-		m_state.references.erase(name);
+		eraseReferences(name);
 	}
 	m_variableScopes.pop_back();
 }
@@ -342,26 +362,37 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 	auto eraseCondition = mapTuple([&_variables](auto&& key, auto&& value) {
 		return _variables.count(key) || _variables.count(value);
 	});
-	cxx20::erase_if(m_state.environment.storage, eraseCondition);
-	cxx20::erase_if(m_state.environment.memory, eraseCondition);
-	cxx20::erase_if(m_state.environment.keccak, [&_variables](auto&& _item) {
+	auto keccakEraseCondition = [&_variables](auto&& _item) {
 		return
 			_variables.count(_item.first.first) ||
 			_variables.count(_item.first.second) ||
 			_variables.count(_item.second);
-	});
+	};
+	Environment const& environment = *m_state.environment;
+	if (
+		ranges::any_of(environment.storage, eraseCondition) ||
+		ranges::any_of(environment.memory, eraseCondition) ||
+		ranges::any_of(environment.keccak, keccakEraseCondition)
+	)
+	{
+		Environment& mutableEnv = mutableEnvironment();
+		cxx20::erase_if(mutableEnv.storage, eraseCondition);
+		cxx20::erase_if(mutableEnv.memory, eraseCondition);
+		cxx20::erase_if(mutableEnv.keccak, keccakEraseCondition);
+	}
 
 	// Also clear variables that reference variables to be cleared.
+	// Note that variables added here are visited by the loop as well
+	// if they come later in the order of the set.
 	for (auto const& variableToClear: _variables)
-		for (auto const& [ref, names]: m_state.references)
-			if (names.count(variableToClear))
-				_variables.emplace(ref);
+		if (set<YulString> const* referencing = valueOrNullptr(m_state.referencedBy, variableToClear))
+			_variables += *referencing;
 
 	// Clear the value and update the reference relation.
 	for (auto const& name: _variables)
 	{
 		m_state.value.erase(name);
-		m_state.references.erase(name);
+		eraseReferences(name);
 	}
 }
 
@@ -370,17 +401,54 @@ void DataFlowAnalyzer::assignValue(YulString _variable, Expression const* _value
 	m_state.value[_variable] = {_value, m_loopDepth};
 }
 
+DataFlowAnalyzer::Environment& DataFlowAnalyzer::mutableEnvironment()
+{
+	if (m_state.environment.use_count() > 1)
+		m_state.environment = make_shared<Environment>(*m_state.environment);
+	return *m_state.environment;
+}
+
+void DataFlowAnalyzer::setReferences(YulString _variable, set<YulString> _references)
+{
+	eraseReferences(_variable);
+	for (YulString reference: _references)
+		m_state.referencedBy[reference].insert(_variable);
+	m_state.references[_variable] = std::move(_references);
+}
+
+void DataFlowAnalyzer::eraseReferences(YulString _variable)
+{
+	auto it = m_state.references.find(_variable);
+	if (it == m_state.references.end())
+		return;
+	for (YulString reference: it->second)
+	{
+		auto referencedBy = m_state.referencedBy.find(reference);
+		yulAssert(referencedBy != m_state.referencedBy.end(), "");
+		referencedBy->second.erase(_variable);
+		if (referencedBy->second.empty())
+			m_state.referencedBy.erase(referencedBy);
+	}
+	m_state.references.erase(it);
+}
+
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
 	if (!m_analyzeStores)
 		return;
 	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
-	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
-	if (sideEffects.invalidatesMemory())
+	Environment const& environment = *m_state.environment;
+	if (sideEffects.invalidatesStorage() && !environment.storage.empty())
+	{
+		StorageWritesCollector storageWrites{m_dialect, m_functionStorageWrites};
+		storageWrites(_block);
+		clearStorageKnowledge(storageWrites.storageWrites());
+	}
+	if (sideEffects.invalidatesMemory() && !(environment.memory.empty() && environment.keccak.empty()))
 	{
-		m_state.environment.memory.clear();
-		m_state.environment.keccak.clear();
+		Environment& mutableEnv = mutableEnvironment();
+		mutableEnv.memory.clear();
+		mutableEnv.keccak.clear();
 	}
 }
 
@@ -389,15 +457,36 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 	if (!m_analyzeStores)
 		return;
 	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
-	if (sideEffects.invalidatesStorage())
-		m_state.environment.storage.clear();
-	if (sideEffects.invalidatesMemory())
+	Environment const& environment = *m_state.environment;
+	if (sideEffects.invalidatesStorage() && !environment.storage.empty())
 	{
-		m_state.environment.memory.clear();
-		m_state.environment.keccak.clear();
+		StorageWritesCollector storageWrites{m_dialect, m_functionStorageWrites};
+		storageWrites.visit(_expr);
+		clearStorageKnowledge(storageWrites.storageWrites());
+	}
+	if (sideEffects.invalidatesMemory() && !(environment.memory.empty() && environment.keccak.empty()))
+	{
+		Environment& mutableEnv = mutableEnvironment();
+		mutableEnv.memory.clear();
+		mutableEnv.keccak.clear();
 	}
 }
 
+void DataFlowAnalyzer::clearStorageKnowledge(StorageWrites const& _storageWrites)
+{
+	if (!_storageWrites)
+	{
+		mutableEnvironment().storage.clear();
+		return;
+	}
+	if (_storageWrites->empty())
+		return;
+	cxx20::erase_if(mutableEnvironment().storage, mapTuple([&](auto&& key, auto&& /* value */) {
+		optional<u256> slot = m_knowledgeBase.valueIfKnownConstant(key);
+		return !slot || _storageWrites->count(*slot);
+	}));
+}
+
 bool DataFlowAnalyzer::inScope(YulString _variableName) const
 {
 	for (auto const& scope: m_variableScopes | ranges::views::reverse)
@@ -453,14 +542,18 @@ optional<pair<YulString, YulString>> DataFlowAnalyzer::isKeccak(Expression const
 	return nullopt;
 }
 
-void DataFlowAnalyzer::joinKnowledge(Environment const& _olderEnvironment)
+void DataFlowAnalyzer::joinKnowledge(shared_ptr<Environment> const& _olderEnvironment)
 {
 	if (!m_analyzeStores)
 		return;
-	joinKnowledgeHelper(m_state.environment.storage, _olderEnvironment.storage);
-	joinKnowledgeHelper(m_state.environment.memory, _olderEnvironment.memory);
-	cxx20::erase_if(m_state.environment.keccak, mapTuple([&_olderEnvironment](auto&& key, auto&& currentValue) {
-		YulString const* oldValue = valueOrNullptr(_olderEnvironment.keccak, key);
+	// Nothing changed since the older point.
+	if (m_state.environment == _olderEnvironment)
+		return;
+	Environment& environment = mutableEnvironment();
+	joinKnowledgeHelper(environment.storage, _olderEnvironment->storage);
+	joinKnowledgeHelper(environment.memory, _olderEnvironment->memory);
+	cxx20::erase_if(environment.keccak, mapTuple([&](auto&& key, auto&& currentValue) {
+		YulString const* oldValue = valueOrNullptr(_olderEnvironment->keccak, key);
 		return !oldValue || *oldValue != currentValue;
 	}));
 }
@@ -25,6 +25,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/optimiser/Semantics.h>
 #include <libyul/YulString.h>
 #include <libyul/AST.h> // Needed for m_zero below.
 #include <libyul/SideEffects.h>
@@ -33,7 +34,9 @@
 #include <libsolutil/Common.h>
 
 #include <map>
+#include <memory>
 #include <set>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -86,10 +89,15 @@ public:
 	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
 	///            if this is not provided or the function is not found.
 	///            The parameter is mostly used to determine movability of expressions.
+	/// @param _functionStorageWrites
+	///            Storage slots user-defined functions can write to. Knowledge about other
+	///            slots is kept across calls to them. All knowledge about storage is cleared
+	///            at calls to functions that are not found.
 	explicit DataFlowAnalyzer(
 		Dialect const& _dialect,
 		MemoryAndStorage _analyzeStores,
-		std::map<YulString, SideEffects> _functionSideEffects = {}
+		std::map<YulString, SideEffects> _functionSideEffects = {},
+		std::map<YulString, StorageWrites> _functionStorageWrites = {}
 	);
 
 	using ASTModifier::operator();
@@ -105,7 +113,7 @@ public:
 	/// @returns the current value of the given variable, if known - always movable.
 	AssignedValue const* variableValue(YulString _variable) const { return util::valueOrNullptr(m_state.value, _variable); }
 	std::set<YulString> const* references(YulString _variable) const { return util::valueOrNullptr(m_state.references, _variable); }
-	std::map<YulString, AssignedValue> const& allValues() const { return m_state.value; }
+	std::unordered_map<YulString, AssignedValue> const& allValues() const { return m_state.value; }
 	std::optional<YulString> storageValue(YulString _key) const;
 	std::optional<YulString> memoryValue(YulString _key) const;
 	std::optional<YulString> keccakValue(YulString _start, YulString _length) const;
@@ -132,6 +140,9 @@ protected:
 	/// Clears knowledge about storage or memory if they may be modified inside the expression.
 	void clearKnowledgeIfInvalidated(Expression const& _expression);
 
+	/// Clears knowledge about the storage slots that may be among @a _storageWrites.
+	void clearStorageKnowledge(StorageWrites const& _storageWrites);
+
 	/// Returns true iff the variable is in scope.
 	bool inScope(YulString _variableName) const;
 
@@ -166,6 +177,8 @@ protected:
 	/// Side-effects of user-defined functions. Worst-case side-effects are assumed
 	/// if this is not provided or the function is not found.
 	std::map<YulString, SideEffects> m_functionSideEffects;
+	/// Storage slots user-defined functions can write to.
+	std::map<YulString, StorageWrites> m_functionStorageWrites;
 
 private:
 	struct Environment
@@ -178,18 +191,32 @@ private:
 	struct State
 	{
 		/// Current values of variables, always movable.
-		std::map<YulString, AssignedValue> value;
+		/// Only used for lookups, so the order of the names does not matter.
+		std::unordered_map<YulString, AssignedValue> value;
 		/// m_references[a].contains(b) <=> the current expression assigned to a references b
 		std::unordered_map<YulString, std::set<YulString>> references;
+		/// Inverse of the above: referencedBy[b].contains(a) <=> references[a].contains(b)
+		std::unordered_map<YulString, std::set<YulString>> referencedBy;
 
-		Environment environment;
+		/// Knowledge about storage and memory. It is shared with the snapshots taken at
+		/// control-flow splits and only copied once it is modified (see mutableEnvironment()).
+		std::shared_ptr<Environment> environment = std::make_shared<Environment>();
 	};
 
+	/// @returns the current environment for modification, copying it first if it is
+	/// still shared with a snapshot.
+	Environment& mutableEnvironment();
+
+	/// Sets the variables referenced by the value of @a _variable, keeping the inverse relation up to date.
+	void setReferences(YulString _variable, std::set<YulString> _references);
+	/// Removes @a _variable from the reference relation.
+	void eraseReferences(YulString _variable);
+
 	/// Joins knowledge about storage and memory with an older point in the control-flow.
 	/// This only works if the current state is a direct successor of the older point,
 	/// i.e. `_olderState.storage` and `_olderState.memory` cannot have additional changes.
 	/// Does nothing if memory and storage analysis is disabled / ignored.
-	void joinKnowledge(Environment const& _olderEnvironment);
+	void joinKnowledge(std::shared_ptr<Environment> const& _olderEnvironment);
 
 	static void joinKnowledgeHelper(
 		std::unordered_map<YulString, YulString>& _thisData,
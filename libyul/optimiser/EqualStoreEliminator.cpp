@@ -36,9 +36,11 @@ using namespace solidity::yul;
 
 void EqualStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast)
 {
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
 	EqualStoreEliminator eliminator{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		SideEffectsPropagator::sideEffects(_context.dialect, callGraph),
+		StorageWritesPropagator::storageWrites(_context.dialect, _ast, callGraph)
 	};
 	eliminator(_ast);
 
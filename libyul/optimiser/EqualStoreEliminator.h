@@ -45,9 +45,15 @@ public:
 private:
 	EqualStoreEliminator(
 		Dialect const& _dialect,
-		std::map<YulString, SideEffects> _functionSideEffects
+		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, StorageWrites> _functionStorageWrites
 	):
-		DataFlowAnalyzer(_dialect, MemoryAndStorage::Analyze, std::move(_functionSideEffects))
+		DataFlowAnalyzer(
+			_dialect,
+			MemoryAndStorage::Analyze,
+			std::move(_functionSideEffects),
+			std::move(_functionStorageWrites)
+		)
 	{}
 
 protected:
@@ -31,7 +31,8 @@ using namespace solidity::yul;
 
 void EquivalentFunctionDetector::operator()(FunctionDefinition const& _fun)
 {
-	uint64_t bodyHash = m_blockHashes[&_fun.body];
+	// Only the bodies of the functions are compared, so there is no need to hash the rest of the code.
+	uint64_t bodyHash = BlockHasher::hash(_fun.body);
 	auto& candidates = m_candidates[bodyHash];
 	for (auto const& candidate: candidates)
 		if (SyntacticallyEqual{}.statementEqual(_fun, *candidate))
@@ -24,18 +24,49 @@
 #include <libyul/optimiser/SimplificationRules.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Suite.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
 #include <libevmasm/SemanticInformation.h>
 
+#include <libsolutil/ThreadPool.h>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
 void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	map<string, size_t>* ruleApplications = _context.profile ? &_context.profile->steps[name].counters : nullptr;
+	if (util::ThreadPool::instance().maxThreads() <= 1)
+	{
+		ExpressionSimplifier{_context.dialect, ruleApplications}(_ast);
+		return;
+	}
+
+	// DataFlowAnalyzer starts every function with empty knowledge and restores its state
+	// afterwards, so simplifying the functions separately yields the same result.
+	vector<FunctionDefinition*> functions;
+	ExpressionSimplifier{_context.dialect, ruleApplications, &functions}(_ast);
+	vector<map<string, size_t>> functionRuleApplications(ruleApplications ? functions.size() : 0);
+	util::ThreadPool::instance().parallelFor(functions.size(), [&](size_t _index) {
+		ExpressionSimplifier{
+			_context.dialect,
+			ruleApplications ? &functionRuleApplications[_index] : nullptr
+		}(*functions[_index]);
+	});
+	for (map<string, size_t> const& applications: functionRuleApplications)
+		for (auto const& [rule, count]: applications)
+			(*ruleApplications)[rule] += count;
+}
+
+void ExpressionSimplifier::operator()(FunctionDefinition& _function)
+{
+	if (m_deferredFunctions)
+		m_deferredFunctions->push_back(&_function);
+	else
+		DataFlowAnalyzer::operator()(_function);
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
@@ -47,7 +78,18 @@ void ExpressionSimplifier::visit(Expression& _expression)
 		m_dialect,
 		[this](YulString _var) { return variableValue(_var); }
 	))
+	{
+		if (m_ruleApplications)
+			++(*m_ruleApplications)[match->pattern.toString()];
 		_expression = match->action().toExpression(debugDataOf(_expression), evmVersionFromDialect(m_dialect));
+	}
+
+	if (optional<Identifier> cleanedUpVariable = redundantCleanupArgument(_expression))
+	{
+		if (m_ruleApplications)
+			++(*m_ruleApplications)["redundant cleanup"];
+		_expression = Identifier{debugDataOf(_expression), cleanedUpVariable->name};
+	}
 
 	if (auto* functionCall = get_if<FunctionCall>(&_expression))
 		if (optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, functionCall->functionName.name))
@@ -65,6 +107,65 @@ void ExpressionSimplifier::visit(Expression& _expression)
 				}
 }
 
+optional<Identifier> ExpressionSimplifier::redundantCleanupArgument(Expression const& _expression)
+{
+	// As for the simplification rules, the value that is cleaned up has to be a variable.
+	// Arguments that are variables are resolved to their values to find nested cleanups.
+	auto resolve = [&](Expression const& _argument) -> Expression const* {
+		if (Identifier const* identifier = get_if<Identifier>(&_argument))
+			if (AssignedValue const* value = variableValue(identifier->name))
+				return value->value;
+		return &_argument;
+	};
+	auto cleanedVariable = [&](Expression const& _argument) -> optional<Identifier> {
+		if (Identifier const* identifier = get_if<Identifier>(&_argument))
+			if (inScope(identifier->name))
+				return *identifier;
+		return nullopt;
+	};
+
+	FunctionCall const* functionCall = get_if<FunctionCall>(&_expression);
+	if (!functionCall)
+		return nullopt;
+	optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, functionCall->functionName.name);
+	if (!instruction)
+		return nullopt;
+
+	vector<Expression> const& arguments = functionCall->arguments;
+	switch (*instruction)
+	{
+	case evmasm::Instruction::AND:
+		for (size_t i = 0; i < 2; ++i)
+			if (optional<u256> mask = m_knowledgeBase.valueIfKnownConstant(arguments[i]))
+				if (
+					holds_alternative<Identifier>(arguments[1 - i]) &&
+					(m_knowledgeBase.possiblyNonZeroBits(arguments[1 - i]) & ~*mask) == 0
+				)
+					return cleanedVariable(arguments[1 - i]);
+		break;
+	case evmasm::Instruction::SIGNEXTEND:
+		if (optional<u256> bytes = m_knowledgeBase.valueIfKnownConstant(arguments[0]))
+			if (
+				holds_alternative<Identifier>(arguments[1]) &&
+				m_knowledgeBase.knownToBeSignExtended(arguments[1], *bytes)
+			)
+				return cleanedVariable(arguments[1]);
+		break;
+	case evmasm::Instruction::ISZERO:
+		if (FunctionCall const* inner = get_if<FunctionCall>(resolve(arguments[0])))
+			if (
+				toEVMInstruction(m_dialect, inner->functionName.name) == evmasm::Instruction::ISZERO &&
+				holds_alternative<Identifier>(inner->arguments[0]) &&
+				m_knowledgeBase.possiblyNonZeroBits(inner->arguments[0]) <= 1
+			)
+				return cleanedVariable(inner->arguments[0]);
+		break;
+	default:
+		break;
+	}
+	return nullopt;
+}
+
 bool ExpressionSimplifier::knownToBeZero(Expression const& _expression) const
 {
 	if (auto const* literal = get_if<Literal>(&_expression))
@@ -25,6 +25,10 @@
 
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace solidity::yul
 {
 struct Dialect;
@@ -39,6 +43,15 @@ struct OptimiserStepContext;
  * It tracks the current values of variables using the DataFlowAnalyzer
  * and takes them into account for replacements.
  *
+ * Furthermore, cleanups (``and`` with a constant mask, ``signextend`` and ``iszero(iszero(x))``)
+ * are removed if the KnowledgeBase can show that they do not change the value.
+ *
+ * Function definitions are simplified independently of each other and of the code around
+ * them, so they are distributed over the threads of util::ThreadPool if it is enabled.
+ *
+ * If the optimiser is profiled, the counters of the step are the number of applications of
+ * each simplification rule, indexed by its pattern.
+ *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
  */
 class ExpressionSimplifier: public DataFlowAnalyzer
@@ -48,13 +61,27 @@ public:
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
+	void operator()(FunctionDefinition& _function) override;
 	void visit(Expression& _expression) override;
 
 private:
-	explicit ExpressionSimplifier(Dialect const& _dialect):
-		DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore)
+	explicit ExpressionSimplifier(
+		Dialect const& _dialect,
+		std::map<std::string, size_t>* _ruleApplications,
+		std::vector<FunctionDefinition*>* _deferredFunctions = nullptr
+	):
+		DataFlowAnalyzer(_dialect, MemoryAndStorage::Ignore),
+		m_ruleApplications(_ruleApplications),
+		m_deferredFunctions(_deferredFunctions)
 	{}
 	bool knownToBeZero(Expression const& _expression) const;
+	/// @returns the variable cleaned up by @a _expression if the cleanup does not change its value.
+	std::optional<Identifier> redundantCleanupArgument(Expression const& _expression);
+
+	/// If set, the applications of the simplification rules are counted here.
+	std::map<std::string, size_t>* m_ruleApplications = nullptr;
+	/// If set, function definitions are not visited but collected here.
+	std::vector<FunctionDefinition*>* m_deferredFunctions = nullptr;
 };
 
 }
@@ -0,0 +1,574 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that resolves the value of the free memory pointer statically.
+ */
+
+#include <libyul/optimiser/FreeMemoryPointerResolver.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/FunctionCallFinder.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Memory offset of the free memory pointer.
+u256 const freeMemoryPointerSlot = 64;
+/// Upper bound of the value of ``memoryguard``, even after the StackLimitEvader reserved memory.
+u256 const memoryGuardBound = u256(1) << 40;
+/// Upper bound of the offsets from the value of ``memoryguard`` that are tracked, so that
+/// comparisons of relative values cannot overflow.
+u256 const relativeOffsetBound = u256(1) << 64;
+
+/// Value of a variable, an expression or the free memory pointer in the lattice of the analysis.
+struct Value
+{
+	enum class Kind { Unknown, Constant, Relative, NotConstant };
+
+	static Value makeNotConstant() { return Value{Kind::NotConstant, 0}; }
+	static Value makeConstant(u256 _value) { return Value{Kind::Constant, std::move(_value)}; }
+	/// @returns the value of ``memoryguard`` plus @a _offset. Large offsets are not tracked.
+	static Value makeRelative(u256 _offset)
+	{
+		return _offset < relativeOffsetBound ? Value{Kind::Relative, std::move(_offset)} : makeNotConstant();
+	}
+
+	bool operator==(Value const& _other) const { return kind == _other.kind && number == _other.number; }
+	bool operator!=(Value const& _other) const { return !(*this == _other); }
+
+	bool isKnown() const { return kind == Kind::Constant || kind == Kind::Relative; }
+
+	Kind kind = Kind::Unknown;
+	/// The constant or the offset from the value of ``memoryguard``.
+	u256 number;
+};
+
+/// @returns the combination of the values @a _a and @a _b at a join of control flow.
+Value combine(Value const& _a, Value const& _b)
+{
+	if (_a.kind == Value::Kind::Unknown)
+		return _b;
+	else if (_b.kind == Value::Kind::Unknown || _a == _b)
+		return _a;
+	else
+		return Value::makeNotConstant();
+}
+
+/**
+ * Determines the values of all variables and calls and of the free memory pointer before
+ * each load of it.
+ *
+ * The whole program is traversed repeatedly until the values do not change anymore. The
+ * values of variables, of the free memory pointer at the start and end of functions and
+ * at the start of loop iterations only ever move from unknown to known and from known to
+ * not constant, and functions are only ever added to the executable and writing ones,
+ * so this terminates.
+ */
+class FreeMemoryPointerAnalysis
+{
+public:
+	FreeMemoryPointerAnalysis(Dialect const& _dialect, u256 _memoryGuard, Block const& _ast):
+		m_dialect(_dialect),
+		m_memoryGuard(std::move(_memoryGuard)),
+		m_functions(allFunctionDefinitions(_ast))
+	{
+		do
+		{
+			m_changed = false;
+			// Memory is zero at the start of the execution.
+			m_freeMemoryPointer = Value::makeConstant(0);
+			m_currentFunction = {};
+			visitBlock(_ast);
+			for (YulString function: vector<YulString>(m_executableFunctions.begin(), m_executableFunctions.end()))
+				visitFunction(*m_functions.at(function));
+		}
+		while (m_changed);
+	}
+
+	/// @returns the constant values of variables.
+	map<YulString, u256> constantVariables() const
+	{
+		map<YulString, u256> result;
+		for (auto const& [name, value]: m_values)
+			if (value.kind == Value::Kind::Constant)
+				result[name] = value.number;
+		return result;
+	}
+
+	/// @returns the constant results of function calls that can be executed.
+	map<FunctionCall const*, u256> constantCalls() const
+	{
+		map<FunctionCall const*, u256> result;
+		for (auto const& [call, value]: m_callValues)
+			if (value.kind == Value::Kind::Constant)
+				result[call] = value.number;
+		return result;
+	}
+
+	/// @returns the loads of the free memory pointer that always return the value of ``memoryguard``.
+	set<FunctionCall const*> reservedMemoryLoads() const
+	{
+		set<FunctionCall const*> result;
+		for (FunctionCall const* load: m_freeMemoryPointerLoads)
+			if (util::valueOrDefault(m_callValues, load) == Value::makeRelative(0))
+				result.insert(load);
+		return result;
+	}
+
+private:
+	void visitFunction(FunctionDefinition const& _function)
+	{
+		m_currentFunction = _function.name;
+		m_freeMemoryPointer = util::valueOrDefault(m_functionEntries, _function.name);
+		m_leave = Value{};
+		visitBlock(_function.body);
+		update(m_functionExits[_function.name], combine(m_freeMemoryPointer, m_leave));
+	}
+
+	void visitBlock(Block const& _block)
+	{
+		for (Statement const& statement: _block.statements)
+			visitStatement(statement);
+	}
+
+	void visitStatement(Statement const& _statement)
+	{
+		std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) { evaluate(_expressionStatement.expression); },
+			[&](Assignment const& _assignment) {
+				vector<Value> values = evaluate(*_assignment.value, _assignment.variableNames.size());
+				for (size_t i = 0; i < _assignment.variableNames.size(); ++i)
+					meet(_assignment.variableNames[i].name, values[i]);
+			},
+			[&](VariableDeclaration const& _declaration) {
+				vector<Value> values =
+					_declaration.value ?
+					evaluate(*_declaration.value, _declaration.variables.size()) :
+					vector<Value>(_declaration.variables.size(), Value::makeConstant(0));
+				for (size_t i = 0; i < _declaration.variables.size(); ++i)
+					meet(_declaration.variables[i], values[i]);
+			},
+			[&](FunctionDefinition const&) {},
+			[&](If const& _if) {
+				evaluate(*_if.condition);
+				Value skipped = m_freeMemoryPointer;
+				visitBlock(_if.body);
+				m_freeMemoryPointer = combine(m_freeMemoryPointer, skipped);
+			},
+			[&](Switch const& _switch) {
+				evaluate(*_switch.expression);
+				Value before = m_freeMemoryPointer;
+				Value after;
+				bool hasDefault = false;
+				for (Case const& switchCase: _switch.cases)
+				{
+					hasDefault = hasDefault || !switchCase.value;
+					m_freeMemoryPointer = before;
+					visitBlock(switchCase.body);
+					after = combine(after, m_freeMemoryPointer);
+				}
+				m_freeMemoryPointer = hasDefault ? after : combine(after, before);
+			},
+			[&](ForLoop const& _loop) {
+				visitBlock(_loop.pre);
+				Value& head = m_loopHeads[&_loop];
+				update(head, m_freeMemoryPointer);
+				m_freeMemoryPointer = head;
+				evaluate(*_loop.condition);
+				Value afterLoop = m_freeMemoryPointer;
+				m_loops.emplace_back();
+				visitBlock(_loop.body);
+				m_freeMemoryPointer = combine(m_freeMemoryPointer, m_loops.back().continueValue);
+				visitBlock(_loop.post);
+				update(head, m_freeMemoryPointer);
+				m_freeMemoryPointer = combine(afterLoop, m_loops.back().breakValue);
+				m_loops.pop_back();
+			},
+			[&](Break const&) {
+				m_loops.back().breakValue = combine(m_loops.back().breakValue, m_freeMemoryPointer);
+				m_freeMemoryPointer = Value{};
+			},
+			[&](Continue const&) {
+				m_loops.back().continueValue = combine(m_loops.back().continueValue, m_freeMemoryPointer);
+				m_freeMemoryPointer = Value{};
+			},
+			[&](Leave const&) {
+				m_leave = combine(m_leave, m_freeMemoryPointer);
+				m_freeMemoryPointer = Value{};
+			},
+			[&](Block const& _block) { visitBlock(_block); }
+		}, _statement);
+	}
+
+	/// @returns the values of the @a _count values @a _expression evaluates to.
+	vector<Value> evaluate(Expression const& _expression, size_t _count)
+	{
+		if (_count == 1)
+			return {evaluate(_expression)};
+		else if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+			return evaluate(*call);
+		else
+			return vector<Value>(_count, Value::makeNotConstant());
+	}
+
+	Value evaluate(Expression const& _expression)
+	{
+		if (Literal const* literal = get_if<Literal>(&_expression))
+		{
+			if (!isDefaultType(literal->type) || (literal->kind == LiteralKind::String && literal->value.str().size() > 32))
+				return Value::makeNotConstant();
+			return Value::makeConstant(valueOfLiteral(*literal));
+		}
+		else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+			return util::valueOrDefault(m_values, identifier->name);
+		else
+		{
+			vector<Value> values = evaluate(std::get<FunctionCall>(_expression));
+			return values.size() == 1 ? values.front() : Value::makeNotConstant();
+		}
+	}
+
+	/// @returns the values of the return values of @a _call and updates the free memory pointer.
+	/// Marks called functions as executable and updates the values of their parameters.
+	vector<Value> evaluate(FunctionCall const& _call)
+	{
+		BuiltinFunction const* builtin = m_dialect.builtin(_call.functionName.name);
+		// Arguments are evaluated from right to left.
+		vector<Value> arguments(_call.arguments.size());
+		for (size_t i = _call.arguments.size(); i > 0; --i)
+			if (!builtin || !builtin->literalArgument(i - 1))
+				arguments[i - 1] = evaluate(_call.arguments[i - 1]);
+
+		vector<Value> results;
+		if (builtin)
+			results = evaluateBuiltin(*builtin, _call, arguments);
+		else
+		{
+			FunctionDefinition const* function = m_functions.at(_call.functionName.name);
+			if (m_executableFunctions.insert(function->name).second)
+			{
+				m_changed = true;
+				for (TypedName const& returnVariable: function->returnVariables)
+					meet(returnVariable, Value::makeConstant(0));
+			}
+			yulAssert(function->parameters.size() == arguments.size(), "");
+			for (size_t i = 0; i < arguments.size(); ++i)
+				meet(function->parameters[i], arguments[i]);
+
+			update(m_functionEntries[function->name], m_freeMemoryPointer);
+			// Functions that do not write to the free memory pointer keep its value.
+			if (m_writingFunctions.count(function->name))
+			{
+				markWriting();
+				if (m_freeMemoryPointer.kind != Value::Kind::Unknown)
+					m_freeMemoryPointer = util::valueOrDefault(m_functionExits, function->name);
+			}
+
+			for (TypedName const& returnVariable: function->returnVariables)
+				results.emplace_back(util::valueOrDefault(m_values, returnVariable.name));
+		}
+		if (results.size() == 1)
+			m_callValues[&_call] = results.front();
+		return results;
+	}
+
+	vector<Value> evaluateBuiltin(BuiltinFunction const& _builtin, FunctionCall const& _call, vector<Value> const& _arguments)
+	{
+		YulString name = _builtin.name;
+		if (name == "memoryguard"_yulstring)
+			return {Value::makeRelative(0)};
+		else if (name == "mload"_yulstring)
+		{
+			Value const& offset = _arguments.front();
+			if (offset.kind == Value::Kind::Unknown)
+				return {Value{}};
+			else if (offset == Value::makeConstant(freeMemoryPointerSlot))
+			{
+				m_freeMemoryPointerLoads.insert(&_call);
+				return {m_freeMemoryPointer};
+			}
+			else
+				return {Value::makeNotConstant()};
+		}
+		else if (name == "mstore"_yulstring || name == "mstore8"_yulstring)
+		{
+			Value const& offset = _arguments.front();
+			// Only the free memory pointer itself can be written at non-constant offsets.
+			if (offset.kind == Value::Kind::Constant)
+			{
+				u256 size = name == "mstore"_yulstring ? 32 : 1;
+				if (name == "mstore"_yulstring && offset.number == freeMemoryPointerSlot)
+					storeFreeMemoryPointer(_arguments.back());
+				else if (offset.number < freeMemoryPointerSlot + 32 && offset.number + size > freeMemoryPointerSlot)
+					storeFreeMemoryPointer(Value::makeNotConstant());
+			}
+			return {};
+		}
+		else if (_builtin.name.str().substr(0, 8) == "verbatim")
+		{
+			storeFreeMemoryPointer(Value::makeNotConstant());
+			return vector<Value>(_builtin.returns.size(), Value::makeNotConstant());
+		}
+
+		if (_builtin.returns.size() != 1)
+			return vector<Value>(_builtin.returns.size(), Value::makeNotConstant());
+		for (size_t i = 0; i < _arguments.size(); ++i)
+			if (_builtin.literalArgument(i) || _arguments[i].kind == Value::Kind::NotConstant)
+				return {Value::makeNotConstant()};
+		for (Value const& argument: _arguments)
+			if (argument.kind == Value::Kind::Unknown)
+				return {Value{}};
+
+		bool allConstant = true;
+		vector<u256> constants;
+		for (Value const& argument: _arguments)
+			if (argument.kind == Value::Kind::Constant)
+				constants.emplace_back(argument.number);
+			else
+				allConstant = false;
+		if (allConstant)
+		{
+			if (!_builtin.sideEffects.movable)
+				return {Value::makeNotConstant()};
+			else if (optional<u256> result = fold(name, constants))
+				return {Value::makeConstant(*result)};
+			else
+				return {Value::makeNotConstant()};
+		}
+		return {evaluateRelative(name, _arguments)};
+	}
+
+	/// @returns the result of the builtin @a _builtin applied to @a _arguments, some of which
+	/// are relative to the value of ``memoryguard``.
+	Value evaluateRelative(YulString _builtin, vector<Value> const& _arguments) const
+	{
+		if (_arguments.size() == 1 && _builtin == "iszero"_yulstring)
+		{
+			if (bounds(_arguments.front()).first > 0)
+				return Value::makeConstant(0);
+		}
+		else if (_arguments.size() == 2)
+		{
+			Value const& a = _arguments.front();
+			Value const& b = _arguments.back();
+			bool aRelative = a.kind == Value::Kind::Relative;
+			bool bRelative = b.kind == Value::Kind::Relative;
+			if (_builtin == "add"_yulstring && aRelative != bRelative)
+				return Value::makeRelative(a.number + b.number);
+			else if (_builtin == "sub"_yulstring && aRelative && bRelative)
+				return Value::makeConstant(a.number - b.number);
+			else if (_builtin == "sub"_yulstring && aRelative)
+				return Value::makeRelative(a.number - b.number);
+			else if (_builtin == "lt"_yulstring || _builtin == "gt"_yulstring)
+			{
+				bool lt = _builtin == "lt"_yulstring;
+				if (optional<bool> result = lessThan(lt ? a : b, lt ? b : a))
+					return Value::makeConstant(*result ? 1 : 0);
+			}
+			else if (_builtin == "eq"_yulstring)
+			{
+				if (aRelative && bRelative)
+					return Value::makeConstant(a.number == b.number ? 1 : 0);
+				else if (lessThan(a, b) == true || lessThan(b, a) == true)
+					return Value::makeConstant(0);
+			}
+		}
+		return Value::makeNotConstant();
+	}
+
+	/// @returns true if @a _a is always less than @a _b, false if it is never less than @a _b
+	/// and nullopt if it is not known.
+	optional<bool> lessThan(Value const& _a, Value const& _b) const
+	{
+		if (_a.kind == Value::Kind::Relative && _b.kind == Value::Kind::Relative)
+			return _a.number < _b.number;
+		auto [aMin, aMax] = bounds(_a);
+		auto [bMin, bMax] = bounds(_b);
+		if (aMax < bMin)
+			return true;
+		else if (aMin >= bMax)
+			return false;
+		else
+			return nullopt;
+	}
+
+	/// @returns the smallest and the largest possible value of a constant or relative value.
+	pair<u256, u256> bounds(Value const& _value) const
+	{
+		yulAssert(_value.isKnown(), "");
+		if (_value.kind == Value::Kind::Constant)
+			return {_value.number, _value.number};
+		else
+			return {m_memoryGuard + _value.number, memoryGuardBound - 1 + _value.number};
+	}
+
+	/// @returns the result of the builtin @a _builtin applied to @a _arguments, if the
+	/// simplification rules can compute it.
+	optional<u256> fold(YulString _builtin, vector<u256> const& _arguments)
+	{
+		auto [it, inserted] = m_foldedValues.try_emplace(make_pair(_builtin, _arguments));
+		if (!inserted)
+			return it->second;
+
+		it->second = evaluateBuiltinCall(m_dialect, _builtin, _arguments);
+		return it->second;
+	}
+
+	void storeFreeMemoryPointer(Value const& _value)
+	{
+		markWriting();
+		// Code that cannot be reached so far does not change the free memory pointer.
+		if (m_freeMemoryPointer.kind != Value::Kind::Unknown)
+			m_freeMemoryPointer = _value;
+	}
+
+	/// Marks the current function as writing to the free memory pointer.
+	void markWriting()
+	{
+		if (!m_currentFunction.empty() && m_writingFunctions.insert(m_currentFunction).second)
+			m_changed = true;
+	}
+
+	/// Combines @a _value into @a _current and records a change.
+	void update(Value& _current, Value const& _value)
+	{
+		Value updated = combine(_current, _value);
+		if (updated != _current)
+		{
+			_current = std::move(updated);
+			m_changed = true;
+		}
+	}
+
+	void meet(TypedName const& _variable, Value const& _value)
+	{
+		meet(_variable.name, isDefaultType(_variable.type) ? _value : Value::makeNotConstant());
+	}
+
+	void meet(YulString _variable, Value const& _value)
+	{
+		update(m_values[_variable], _value);
+	}
+
+	bool isDefaultType(YulString _type) const { return _type.empty() || _type == m_dialect.defaultType; }
+
+	/// Values of the free memory pointer at the jumps out of a loop.
+	struct LoopExits
+	{
+		Value breakValue;
+		Value continueValue;
+	};
+
+	Dialect const& m_dialect;
+	u256 m_memoryGuard;
+	map<YulString, FunctionDefinition const*> m_functions;
+	map<YulString, Value> m_values;
+	set<YulString> m_executableFunctions;
+	/// Functions that can change the free memory pointer.
+	set<YulString> m_writingFunctions;
+	map<FunctionCall const*, Value> m_callValues;
+	set<FunctionCall const*> m_freeMemoryPointerLoads;
+	map<pair<YulString, vector<u256>>, optional<u256>> m_foldedValues;
+
+	/// Values of the free memory pointer at the start and at the end of functions.
+	map<YulString, Value> m_functionEntries;
+	map<YulString, Value> m_functionExits;
+	/// Values of the free memory pointer at the start of loop iterations.
+	map<ForLoop const*, Value> m_loopHeads;
+
+	/// Value of the free memory pointer at the current point of the traversal.
+	Value m_freeMemoryPointer;
+	YulString m_currentFunction;
+	vector<LoopExits> m_loops;
+	Value m_leave;
+	bool m_changed = false;
+};
+
+}
+
+void FreeMemoryPointerResolver::run(OptimiserStepContext& _context, Block& _ast)
+{
+	EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (!dialect || !dialect->providesObjectAccess())
+		return;
+
+	vector<FunctionCall*> memoryGuardCalls = FunctionCallFinder::run(_ast, "memoryguard"_yulstring);
+	if (memoryGuardCalls.empty())
+		return;
+	Literal const& memoryGuardArgument = std::get<Literal>(memoryGuardCalls.front()->arguments.front());
+	u256 memoryGuard = valueOfLiteral(memoryGuardArgument);
+	if (memoryGuard >= memoryGuardBound)
+		return;
+	for (FunctionCall const* memoryGuardCall: memoryGuardCalls)
+		if (valueOfLiteral(std::get<Literal>(memoryGuardCall->arguments.front())) != memoryGuard)
+			return;
+
+	FreeMemoryPointerAnalysis analysis{*dialect, memoryGuard, _ast};
+	FreeMemoryPointerResolver{
+		*dialect,
+		memoryGuardArgument,
+		analysis.constantVariables(),
+		analysis.constantCalls(),
+		analysis.reservedMemoryLoads(),
+		SideEffectsPropagator::sideEffects(*dialect, CallGraphGenerator::callGraph(_ast)),
+		MSizeFinder::containsMSize(*dialect, _ast)
+	}(_ast);
+}
+
+void FreeMemoryPointerResolver::visit(Expression& _expression)
+{
+	ASTModifier::visit(_expression);
+
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (u256 const* value = util::valueOrNullptr(m_variableValues, identifier->name))
+			_expression = Literal{identifier->debugData, LiteralKind::Number, YulString{formatNumber(*value)}, {}};
+	}
+	else if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+	{
+		if (u256 const* value = util::valueOrNullptr(m_callValues, call))
+		{
+			SideEffectsCollector sideEffects{m_dialect, _expression, &m_functionSideEffects};
+			if (sideEffects.canBeRemoved(!m_containsMSize) && sideEffects.cannotLoop())
+				_expression = Literal{call->debugData, LiteralKind::Number, YulString{formatNumber(*value)}, {}};
+		}
+		else if (m_reservedMemoryLoads.count(call))
+		{
+			shared_ptr<DebugData const> debugData = call->debugData;
+			Literal argument = m_memoryGuardArgument;
+			argument.debugData = debugData;
+			_expression = FunctionCall{debugData, Identifier{debugData, "memoryguard"_yulstring}, {std::move(argument)}};
+		}
+	}
+}
@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that resolves the value of the free memory pointer statically.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/AST.h>
+#include <libyul/SideEffects.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <set>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Inter-procedural analysis of the value of the free memory pointer at memory offset 64.
+ *
+ * The value of the free memory pointer is tracked along the control flow of the whole program
+ * as either a constant or a constant offset from the value of ``memoryguard``. The values of
+ * variables are tracked as in the ConditionalConstantPropagator and can be relative to the value
+ * of ``memoryguard`` as well. Since the StackLimitEvader can only increase the argument of
+ * ``memoryguard`` and keeps it small, comparisons of such values with constants and with each
+ * other, e.g. the bounds checks of memory allocations, can often be decided, and the difference
+ * of two such values is a constant.
+ *
+ * Functions that do not write to the free memory pointer keep its value across calls. The value
+ * at the start of a function combines the values at all of its calls, so allocations in functions
+ * that are called from several places are only resolved if they are inlined first.
+ *
+ * Afterwards, calls to builtins and removable functions whose result is constant are replaced by
+ * their result and loads of the free memory pointer at the start of the reserved memory area are
+ * replaced by a call to ``memoryguard``.
+ *
+ * The transformation is only performed if the code contains calls to ``memoryguard``, all with
+ * the same argument, i.e. if all of it respects Solidity's memory model. The free memory pointer
+ * is then assumed to be written only by ``mstore`` to a constant offset.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class FreeMemoryPointerResolver: public ASTModifier
+{
+public:
+	static constexpr char const* name{"FreeMemoryPointerResolver"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override;
+
+private:
+	FreeMemoryPointerResolver(
+		Dialect const& _dialect,
+		Literal _memoryGuardArgument,
+		std::map<YulString, u256> _variableValues,
+		std::map<FunctionCall const*, u256> _callValues,
+		std::set<FunctionCall const*> _reservedMemoryLoads,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		bool _containsMSize
+	):
+		m_dialect(_dialect),
+		m_memoryGuardArgument(std::move(_memoryGuardArgument)),
+		m_variableValues(std::move(_variableValues)),
+		m_callValues(std::move(_callValues)),
+		m_reservedMemoryLoads(std::move(_reservedMemoryLoads)),
+		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_containsMSize(_containsMSize)
+	{}
+
+	Dialect const& m_dialect;
+	/// The argument of all calls to ``memoryguard``.
+	Literal m_memoryGuardArgument;
+	std::map<YulString, u256> m_variableValues;
+	/// Constant results of calls with a single return value.
+	std::map<FunctionCall const*, u256> m_callValues;
+	/// Loads of the free memory pointer that always return the value of ``memoryguard``.
+	std::set<FunctionCall const*> m_reservedMemoryLoads;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	bool m_containsMSize = false;
+};
+
+}
@@ -28,6 +28,7 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/Suite.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/Exceptions.h>
@@ -43,14 +44,22 @@ using namespace solidity::yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	FullInliner inliner{_ast, _context.dispenser, _context.dialect, _context.functionExecutionCounts};
+	if (_context.profile)
+		inliner.m_decisions = &_context.profile->steps[name].counters;
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
+FullInliner::FullInliner(
+	Block& _ast,
+	NameDispenser& _dispenser,
+	Dialect const& _dialect,
+	map<YulString, size_t> const* _executionCounts
+):
 	m_ast(_ast),
 	m_recursiveFunctions(CallGraphGenerator::callGraph(_ast).recursiveFunctions()),
+	m_executionCounts(_executionCounts && !_executionCounts->empty() ? _executionCounts : nullptr),
 	m_nameDispenser(_dispenser),
 	m_dialect(_dialect)
 {
@@ -64,7 +73,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 
 	// Store size of global statements.
 	m_functionSizes[YulString{}] = CodeSize::codeSize(_ast);
-	map<YulString, size_t> references = ReferencesCounter::countReferences(m_ast);
+	m_references = ReferencesCounter::countReferences(m_ast);
 	for (auto& statement: m_ast.statements)
 	{
 		if (!holds_alternative<FunctionDefinition>(statement))
@@ -74,7 +83,7 @@ FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const&
 		if (LeaveFinder::containsLeave(fun))
 			m_noInlineFunctions.insert(fun.name);
 		// Always inline functions that are only called once.
-		if (references[fun.name] == 1)
+		if (m_references[fun.name] == 1)
 			m_singleUse.emplace(fun.name);
 		updateCodeSize(fun);
 	}
@@ -173,21 +182,30 @@ map<YulString, size_t> FullInliner::callDepths() const
 
 bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 {
+	// Counts the decisions about the calls to functions in the statistics of the optimiser.
+	auto decide = [&](bool _inline, char const* _reason) {
+		if (m_decisions)
+			++(*m_decisions)[_reason];
+		return _inline;
+	};
+
 	// No recursive inlining
 	if (_funCall.functionName.name == _callSite)
-		return false;
+		return decide(false, "rejectedRecursive");
 
 	FunctionDefinition* calledFunction = function(_funCall.functionName.name);
 	if (!calledFunction)
 		return false;
 
-	if (m_noInlineFunctions.count(_funCall.functionName.name) || recursive(*calledFunction))
-		return false;
+	if (m_noInlineFunctions.count(_funCall.functionName.name))
+		return decide(false, "rejectedLeave");
+	if (recursive(*calledFunction))
+		return decide(false, "rejectedRecursive");
 
 	// Inline really, really tiny functions
 	size_t size = m_functionSizes.at(calledFunction->name);
 	if (size <= 1)
-		return true;
+		return decide(true, "inlinedTiny");
 
 	// In the first pass, only inline tiny functions.
 	if (m_pass == Pass::InlineTiny)
@@ -207,10 +225,23 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 		aggressiveInlining = false;
 
 	if (!aggressiveInlining && m_functionSizes.at(_callSite) > 45)
-		return false;
+		return decide(false, "rejectedLargeCallSite");
 
 	if (m_singleUse.count(calledFunction->name))
-		return true;
+		return decide(true, "inlinedSingleUse");
+
+	size_t sizeLimit = aggressiveInlining ? 8u : 6u;
+	if (m_executionCounts)
+	{
+		// According to the profile, inlining functions that are never executed only increases
+		// the code size, while inlining the executed ones is worth larger functions.
+		if (util::valueOrDefault(*m_executionCounts, calledFunction->name, size_t(0)) == 0)
+			return decide(false, "rejectedNotExecuted");
+		sizeLimit *= 4;
+	}
+
+	if (size < sizeLimit)
+		return decide(true, "inlinedSmall");
 
 	// Constant arguments might provide a means for further optimization, so they cause a bonus.
 	bool constantArg = false;
@@ -224,7 +255,9 @@ bool FullInliner::shallInline(FunctionCall const& _funCall, YulString _callSite)
 			break;
 		}
 
-	return (size < (aggressiveInlining ? 8u : 6u) || (constantArg && size < (aggressiveInlining ? 16u : 12u)));
+	if (constantArg && size < 2 * sizeLimit)
+		return decide(true, "inlinedConstantArguments");
+	return decide(false, "rejectedSize");
 }
 
 void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _callSite)
@@ -232,6 +265,18 @@ void FullInliner::tentativelyUpdateCodeSize(YulString _function, YulString _call
 	m_functionSizes.at(_callSite) += m_functionSizes.at(_function);
 }
 
+bool FullInliner::removeCall(FunctionDefinition const& _function)
+{
+	size_t& references = m_references.at(_function.name);
+	assertThrow(references > 0, OptimizerException, "");
+	if (--references == 0)
+		return true;
+	// The copy of the body adds references.
+	for (auto const& [name, count]: ReferencesCounter::countReferences(_function.body))
+		m_references[name] += count;
+	return false;
+}
+
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 {
 	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
@@ -288,6 +333,13 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 	assertThrow(!!function, OptimizerException, "Attempt to inline invalid function.");
 
 	m_driver.tentativelyUpdateCodeSize(function->name, m_currentFunction);
+	// Variable declarations for the parameters and return variables, the body and the
+	// assignments of the return values.
+	newStatements.reserve(
+		_funCall.arguments.size() +
+		function->body.statements.size() +
+		2 * function->returnVariables.size()
+	);
 
 	// helper function to create a new variable that is supposed to model
 	// an existing variable.
@@ -307,8 +359,18 @@ vector<Statement> InlineModifier::performInline(Statement& _statement, FunctionC
 	for (auto const& var: function->returnVariables)
 		newVariable(var, nullptr);
 
-	Statement newBody = BodyCopier(m_nameDispenser, variableReplacements)(function->body);
-	newStatements += std::move(std::get<Block>(newBody).statements);
+	if (m_driver.removeCall(*function))
+	{
+		// The function is not called anymore, so there is no need to keep its body.
+		BodyRenamer(m_nameDispenser, variableReplacements)(function->body);
+		newStatements += std::move(function->body.statements);
+		function->body.statements.clear();
+	}
+	else
+	{
+		Statement newBody = BodyCopier(m_nameDispenser, variableReplacements)(function->body);
+		newStatements += std::move(std::get<Block>(newBody).statements);
+	}
 
 	std::visit(util::GenericVisitor{
 		util::VisitorFallback<>{},
@@ -361,3 +423,25 @@ YulString BodyCopier::translateIdentifier(YulString _name)
 	else
 		return _name;
 }
+
+void BodyRenamer::operator()(Identifier& _identifier)
+{
+	if (YulString const* replacement = util::valueOrNullptr(m_variableReplacements, _identifier.name))
+		_identifier.name = *replacement;
+}
+
+void BodyRenamer::operator()(VariableDeclaration& _varDecl)
+{
+	for (auto& var: _varDecl.variables)
+	{
+		YulString newName = m_nameDispenser.newName(var.name);
+		m_variableReplacements[var.name] = newName;
+		var.name = newName;
+	}
+	ASTModifier::operator()(_varDecl);
+}
+
+void BodyRenamer::operator()(FunctionDefinition&)
+{
+	assertThrow(false, OptimizerException, "Function hoisting has to be done before function inlining.");
+}
@@ -64,6 +64,12 @@ class NameCollector;
  * code of f, with replacements: a -> f_a, b -> f_b, c -> f_c
  * let z := f_c
  *
+ * If the inlined call is the last call to f, the body of f is moved to the call site
+ * instead of being copied and f is left with an empty body.
+ *
+ * If the optimiser is profiled, the counters of the step are the number of calls that were
+ * inlined or not, indexed by the reason of the decision.
+ *
  * Prerequisites: Disambiguator
  * More efficient if run after: Function Hoister, Expression Splitter
  */
@@ -90,10 +96,20 @@ public:
 	/// should be determined after inlining is completed.
 	void tentativelyUpdateCodeSize(YulString _function, YulString _callSite);
 
+	/// Updates the reference counts for inlining a call to @a _function.
+	/// @returns true if this was the last call to the function, so that its body
+	/// can be moved to the call site instead of being copied.
+	bool removeCall(FunctionDefinition const& _function);
+
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(
+		Block& _ast,
+		NameDispenser& _dispenser,
+		Dialect const& _dialect,
+		std::map<YulString, size_t> const* _executionCounts = nullptr
+	);
 	void run(Pass _pass);
 
 	/// @returns a map containing the maximum depths of a call chain starting at each
@@ -120,6 +136,12 @@ private:
 	/// Variables that are constants (used for inlining heuristic)
 	std::set<YulString> m_constants;
 	std::map<YulString, size_t> m_functionSizes;
+	/// Number of references to each name in the current code.
+	std::map<YulString, size_t> m_references;
+	/// Execution counts of the functions, if a profile is available.
+	std::map<YulString, size_t> const* m_executionCounts = nullptr;
+	/// If set, the number of inlining decisions is counted here, indexed by the decision and its reason.
+	std::map<std::string, size_t>* m_decisions = nullptr;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
 };
@@ -177,5 +199,30 @@ public:
 	std::map<YulString, YulString> m_variableReplacements;
 };
 
+/**
+ * Applies the same replacements and new names as BodyCopier, but modifies the
+ * body of a function in place instead of copying it.
+ */
+class BodyRenamer: public ASTModifier
+{
+public:
+	BodyRenamer(
+		NameDispenser& _nameDispenser,
+		std::map<YulString, YulString> _variableReplacements
+	):
+		m_nameDispenser(_nameDispenser),
+		m_variableReplacements(std::move(_variableReplacements))
+	{}
+
+	using ASTModifier::operator();
+
+	void operator()(Identifier& _identifier) override;
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(FunctionDefinition& _funDef) override;
+
+	NameDispenser& m_nameDispenser;
+	std::map<YulString, YulString> m_variableReplacements;
+};
+
 
 }
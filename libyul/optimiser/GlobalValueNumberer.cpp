@@ -0,0 +1,183 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that replaces expressions by variables that are known to have
+ * the same value, using value numbers for variables that are never re-assigned.
+ */
+
+#include <libyul/optimiser/GlobalValueNumberer.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/CommonData.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void GlobalValueNumberer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	GlobalValueNumberer{
+		_context.dialect,
+		assignedVariableNames(_ast),
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+	}(_ast);
+}
+
+void GlobalValueNumberer::operator()(FunctionDefinition& _function)
+{
+	// Variables of the surrounding code are not accessible inside the function.
+	ScopedSaveAndRestore leaders(m_leaders, {});
+	ScopedSaveAndRestore leaderStack(m_leaderStack, {});
+
+	for (TypedName const& parameter: _function.parameters)
+		if (!m_assignedVariables.count(parameter.name))
+			assignValueNumber(parameter.name, nullopt);
+	ASTModifier::operator()(_function);
+}
+
+void GlobalValueNumberer::operator()(VariableDeclaration& _varDecl)
+{
+	optional<size_t> number;
+	if (_varDecl.value)
+	{
+		visit(*_varDecl.value);
+		if (_varDecl.variables.size() == 1)
+			number = valueNumber(*_varDecl.value);
+	}
+	else if (all_of(
+		_varDecl.variables.begin(),
+		_varDecl.variables.end(),
+		[&](TypedName const& _variable) { return _variable.type.empty() || _variable.type == m_dialect.defaultType; }
+	))
+		number = valueNumber(Literal{{}, LiteralKind::Number, YulString{"0"}, {}});
+
+	for (TypedName const& variable: _varDecl.variables)
+		if (!m_assignedVariables.count(variable.name))
+			assignValueNumber(variable.name, number);
+}
+
+void GlobalValueNumberer::operator()(Block& _block)
+{
+	size_t const leaderCount = m_leaderStack.size();
+	ASTModifier::operator()(_block);
+	while (m_leaderStack.size() > leaderCount)
+	{
+		m_leaders.erase(m_leaderStack.back());
+		m_leaderStack.pop_back();
+	}
+}
+
+void GlobalValueNumberer::visit(Expression& _expression)
+{
+	if (FunctionCall* functionCall = get_if<FunctionCall>(&_expression))
+	{
+		BuiltinFunction const* builtin = m_dialect.builtin(functionCall->functionName.name);
+		for (size_t i = functionCall->arguments.size(); i > 0; i--)
+			// Arguments that have to be literals are not modified.
+			if (!builtin || !builtin->literalArgument(i - 1))
+				visit(functionCall->arguments[i - 1]);
+	}
+	else if (holds_alternative<Literal>(_expression))
+		return;
+
+	if (optional<size_t> number = valueNumber(_expression))
+		if (YulString const* leader = util::valueOrNullptr(m_leaders, *number))
+		{
+			Identifier const* identifier = get_if<Identifier>(&_expression);
+			if (!identifier || identifier->name != *leader)
+				_expression = Identifier{debugDataOf(_expression), *leader};
+		}
+}
+
+optional<size_t> GlobalValueNumberer::valueNumber(Expression const& _expression)
+{
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (size_t const* number = util::valueOrNullptr(m_variableNumbers, identifier->name))
+			return *number;
+		return nullopt;
+	}
+	else if (Literal const* literal = get_if<Literal>(&_expression))
+	{
+		if (
+			(!literal->type.empty() && literal->type != m_dialect.defaultType) ||
+			(literal->kind == LiteralKind::String && literal->value.str().size() > 32)
+		)
+			return nullopt;
+		auto [it, inserted] = m_literalNumbers.try_emplace(valueOfLiteral(*literal), m_nextValueNumber);
+		if (inserted)
+			m_nextValueNumber++;
+		return it->second;
+	}
+
+	FunctionCall const& functionCall = std::get<FunctionCall>(_expression);
+	YulString functionName = functionCall.functionName.name;
+	SideEffects sideEffects;
+	BuiltinFunction const* builtin = m_dialect.builtin(functionName);
+	if (builtin)
+	{
+		if (builtin->returns.size() != 1)
+			return nullopt;
+		for (size_t i = 0; i < functionCall.arguments.size(); ++i)
+			if (builtin->literalArgument(i))
+				return nullopt;
+		sideEffects = builtin->sideEffects;
+	}
+	else if (SideEffects const* functionSideEffects = util::valueOrNullptr(m_functionSideEffects, functionName))
+		sideEffects = *functionSideEffects;
+	else
+		return nullopt;
+	if (!sideEffects.movable || !sideEffects.canBeRemoved)
+		return nullopt;
+
+	vector<size_t> arguments;
+	for (Expression const& argument: functionCall.arguments)
+		if (optional<size_t> number = valueNumber(argument))
+			arguments.emplace_back(*number);
+		else
+			return nullopt;
+	if (optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, functionName))
+		if (evmasm::SemanticInformation::isCommutativeOperation(evmasm::AssemblyItem{*instruction}))
+			sort(arguments.begin(), arguments.end());
+
+	auto [it, inserted] = m_callNumbers.try_emplace(make_pair(functionName, std::move(arguments)), m_nextValueNumber);
+	if (inserted)
+		m_nextValueNumber++;
+	return it->second;
+}
+
+void GlobalValueNumberer::assignValueNumber(YulString _variable, optional<size_t> _valueNumber)
+{
+	size_t number = _valueNumber ? *_valueNumber : m_nextValueNumber++;
+	m_variableNumbers[_variable] = number;
+	if (m_leaders.try_emplace(number, _variable).second)
+		m_leaderStack.emplace_back(number);
+}
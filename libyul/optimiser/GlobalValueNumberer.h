@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that replaces expressions by variables that are known to have
+ * the same value, using value numbers for variables that are never re-assigned.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/SideEffects.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Dominator-based global value numbering.
+ *
+ * Every variable that is never re-assigned gets a value number. Variables whose values are
+ * the same literal or calls to the same movable function with arguments of the same value
+ * numbers get the same value number. The arguments of commutative builtins are ordered,
+ * so that ``add(x, y)`` and ``add(y, x)`` are considered equal.
+ *
+ * The first variable with a certain value number is the leader of that value number while
+ * it is in scope. Since a variable declaration dominates all code in its scope, the leader
+ * can replace all later occurrences of expressions or variables with that value number,
+ * including the ones in nested blocks, loops and after control-flow joins. Leaders are not
+ * visible inside function definitions.
+ *
+ * In contrast to the CommonSubexpressionEliminator, the knowledge about the variables is
+ * never invalidated, but re-assigned variables do not take part at all. Because of that,
+ * the step is most effective on code in SSA form.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class GlobalValueNumberer: public ASTModifier
+{
+public:
+	static constexpr char const* name{"GlobalValueNumberer"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(FunctionDefinition& _function) override;
+	void operator()(VariableDeclaration& _varDecl) override;
+	void operator()(Block& _block) override;
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override;
+
+private:
+	GlobalValueNumberer(
+		Dialect const& _dialect,
+		std::set<YulString> _assignedVariables,
+		std::map<YulString, SideEffects> _functionSideEffects
+	):
+		m_dialect(_dialect),
+		m_assignedVariables(std::move(_assignedVariables)),
+		m_functionSideEffects(std::move(_functionSideEffects))
+	{}
+
+	/// @returns the value number of @a _expression or nullopt if it cannot be numbered,
+	/// creating a new value number for values that have not been encountered yet.
+	std::optional<size_t> valueNumber(Expression const& _expression);
+	/// Assigns the value number @a _valueNumber or a new one to the variable @a _variable
+	/// and makes it the leader of that number if there is no other leader in scope.
+	void assignValueNumber(YulString _variable, std::optional<size_t> _valueNumber);
+
+	Dialect const& m_dialect;
+	std::set<YulString> m_assignedVariables;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+
+	size_t m_nextValueNumber = 0;
+	std::map<YulString, size_t> m_variableNumbers;
+	std::map<u256, size_t> m_literalNumbers;
+	std::map<std::pair<YulString, std::vector<size_t>>, size_t> m_callNumbers;
+	/// Variables in scope that are the first ones with a certain value number.
+	std::map<size_t, YulString> m_leaders;
+	/// Value numbers whose leaders were declared in the current function, in order of declaration.
+	std::vector<size_t> m_leaderStack;
+};
+
+}
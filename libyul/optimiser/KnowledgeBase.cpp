@@ -84,6 +84,36 @@ optional<u256> KnowledgeBase::valueIfKnownConstant(Expression const& _expression
 		return nullopt;
 }
 
+u256 KnowledgeBase::possiblyNonZeroBits(Expression const& _expression)
+{
+	if (Literal const* literal = get_if<Literal>(&_expression))
+		return valueOfLiteral(*literal);
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		return possiblyNonZeroBits(identifier->name);
+	else
+		return possiblyNonZeroBits(std::get<FunctionCall>(_expression));
+}
+
+bool KnowledgeBase::knownToBeSignExtended(Expression const& _expression, u256 const& _bytes)
+{
+	if (_bytes >= 31)
+		return true;
+	unsigned const signBit = 8 * static_cast<unsigned>(_bytes) + 7;
+	if ((possiblyNonZeroBits(_expression) >> signBit) == 0)
+		return true;
+
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (Expression const* value = valueOf(identifier->name))
+			return knownToBeSignExtended(*value, _bytes);
+	}
+	else if (FunctionCall const* functionCall = get_if<FunctionCall>(&_expression))
+		if (functionCall->functionName.name == "signextend"_yulstring)
+			if (optional<u256> bytes = valueIfKnownConstant(functionCall->arguments.front()))
+				return *bytes <= _bytes;
+	return false;
+}
+
 KnowledgeBase::VariableOffset KnowledgeBase::explore(YulString _var)
 {
 	Expression const* value = nullptr;
@@ -149,6 +179,100 @@ optional<KnowledgeBase::VariableOffset> KnowledgeBase::explore(Expression const&
 	return nullopt;
 }
 
+u256 KnowledgeBase::possiblyNonZeroBits(YulString _var)
+{
+	Expression const* value = nullptr;
+	if (m_valuesAreSSA)
+	{
+		if (u256 const* bits = util::valueOrNullptr(m_possiblyNonZeroBits, _var))
+			return *bits;
+		value = valueOf(_var);
+	}
+	else
+	{
+		value = valueOf(_var);
+		if (u256 const* bits = util::valueOrNullptr(m_possiblyNonZeroBits, _var))
+			return *bits;
+	}
+
+	u256 bits = value ? possiblyNonZeroBits(*value) : ~u256(0);
+	m_possiblyNonZeroBits[_var] = bits;
+	return bits;
+}
+
+u256 KnowledgeBase::possiblyNonZeroBits(FunctionCall const& _functionCall)
+{
+	// @returns the mask of all bits up to and including the highest bit of _bits.
+	auto lowerBits = [](u256 const& _bits) -> u256 {
+		if (_bits == 0)
+			return 0;
+		size_t highestBit = boost::multiprecision::msb(_bits);
+		return highestBit == 255 ? ~u256(0) : (u256(1) << (highestBit + 1)) - 1;
+	};
+	auto argumentBits = [&](size_t _index) { return possiblyNonZeroBits(_functionCall.arguments.at(_index)); };
+
+	YulString name = _functionCall.functionName.name;
+	if (name == "and"_yulstring)
+		return argumentBits(0) & argumentBits(1);
+	else if (name == "or"_yulstring || name == "xor"_yulstring)
+		return argumentBits(0) | argumentBits(1);
+	else if (
+		name == "iszero"_yulstring ||
+		name == "eq"_yulstring ||
+		name == "lt"_yulstring ||
+		name == "gt"_yulstring ||
+		name == "slt"_yulstring ||
+		name == "sgt"_yulstring
+	)
+		return 1;
+	else if (name == "byte"_yulstring)
+		return 0xff;
+	else if (name == "shl"_yulstring || name == "shr"_yulstring)
+	{
+		if (optional<u256> shift = valueIfKnownConstant(_functionCall.arguments.front()))
+		{
+			if (*shift >= 256)
+				return 0;
+			unsigned amount = static_cast<unsigned>(*shift);
+			return name == "shl"_yulstring ? argumentBits(1) << amount : argumentBits(1) >> amount;
+		}
+	}
+	else if (name == "div"_yulstring)
+		return lowerBits(argumentBits(0));
+	else if (name == "mod"_yulstring)
+	{
+		u256 bits = lowerBits(argumentBits(0));
+		if (optional<u256> modulus = valueIfKnownConstant(_functionCall.arguments.at(1)))
+			bits &= *modulus == 0 ? 0 : lowerBits(*modulus - 1);
+		return bits;
+	}
+	else if (name == "add"_yulstring)
+	{
+		u256 bits = lowerBits(argumentBits(0) | argumentBits(1));
+		if (!(bits >> 255))
+			return (bits << 1) | 1;
+	}
+	else if (name == "mul"_yulstring)
+	{
+		u256 bits0 = argumentBits(0);
+		u256 bits1 = argumentBits(1);
+		if (bits0 == 0 || bits1 == 0)
+			return 0;
+		size_t length = boost::multiprecision::msb(bits0) + boost::multiprecision::msb(bits1) + 2;
+		if (length < 256)
+			return (u256(1) << length) - 1;
+	}
+	else if (
+		name == "address"_yulstring ||
+		name == "caller"_yulstring ||
+		name == "origin"_yulstring ||
+		name == "coinbase"_yulstring
+	)
+		return (u256(1) << 160) - 1;
+
+	return ~u256(0);
+}
+
 Expression const* KnowledgeBase::valueOf(YulString _var)
 {
 	AssignedValue const* assignedValue = m_variableValues(_var);
@@ -156,10 +280,12 @@ Expression const* KnowledgeBase::valueOf(YulString _var)
 	if (m_valuesAreSSA)
 		return currentValue;
 
-	Expression const* lastValue = m_lastKnownValue[_var];
+	Expression const*& lastValue = m_lastKnownValue[_var];
 	if (lastValue != currentValue)
+	{
 		reset(_var);
-	m_lastKnownValue[_var] = currentValue;
+		lastValue = currentValue;
+	}
 	return currentValue;
 }
 
@@ -167,7 +293,7 @@ void KnowledgeBase::reset(YulString _var)
 {
 	yulAssert(!m_valuesAreSSA);
 
-	m_lastKnownValue.erase(_var);
+	m_possiblyNonZeroBits.erase(_var);
 	if (VariableOffset const* offset = util::valueOrNullptr(m_offsets, _var))
 	{
 		// Remove var from its group
@@ -186,13 +312,14 @@ void KnowledgeBase::reset(YulString _var)
 			// newOffset = newRepresentative - _var
 			for (YulString groupMember: *group)
 			{
-				yulAssert(m_offsets[groupMember].reference == _var);
-				m_offsets[groupMember].reference = newRepresentative;
-				// groupMember = _var + m_offsets[groupMember].offset (old)
-				//             = newRepresentative - newOffset + m_offsets[groupMember].offset (old)
+				VariableOffset& memberOffset = m_offsets[groupMember];
+				yulAssert(memberOffset.reference == _var);
+				memberOffset.reference = newRepresentative;
+				// groupMember = _var + memberOffset.offset (old)
+				//             = newRepresentative - newOffset + memberOffset.offset (old)
 				// so subtracting newOffset from .offset yields the original relation again,
 				// just with _var replaced by newRepresentative
-				m_offsets[groupMember].offset -= newOffset;
+				memberOffset.offset -= newOffset;
 			}
 			m_groupMembers[newRepresentative] = std::move(*group);
 
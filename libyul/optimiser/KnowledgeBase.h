@@ -29,6 +29,7 @@
 
 #include <map>
 #include <functional>
+#include <unordered_map>
 
 namespace solidity::yul
 {
@@ -56,6 +57,9 @@ struct AssignedValue;
  *
  * There is a special group which is the constant values. Those use the
  * empty YulString as representative "variable".
+ *
+ * Independently of that, it determines which bits of a value are known to be zero,
+ * which is used to find cleanup operations that do not change a value.
  */
 class KnowledgeBase
 {
@@ -75,6 +79,14 @@ public:
 	std::optional<u256> valueIfKnownConstant(YulString _a);
 	std::optional<u256> valueIfKnownConstant(Expression const& _expression);
 
+	/// @returns a mask of the bits that can be non-zero in the value of @a _expression.
+	/// All other bits are known to be zero.
+	u256 possiblyNonZeroBits(Expression const& _expression);
+	/// @returns true if the value of @a _expression is known to be equal to
+	/// ``signextend(_bytes, _expression)``, i.e. the bits above the lowest @a _bytes + 1 bytes
+	/// are known to be equal to the highest bit of these bytes.
+	bool knownToBeSignExtended(Expression const& _expression, u256 const& _bytes);
+
 private:
 	/**
 	 * Constant offset relative to a reference variable, or absolute constant if the
@@ -106,11 +118,14 @@ private:
 	Expression const* valueOf(YulString _var);
 
 	/// Resets all information about the variable and removes it from its group,
-	/// potentially finding a new representative.
+	/// potentially finding a new representative. Does not touch the last known value.
 	void reset(YulString _var);
 
 	VariableOffset setOffset(YulString _variable, VariableOffset _value);
 
+	u256 possiblyNonZeroBits(YulString _var);
+	u256 possiblyNonZeroBits(FunctionCall const& _functionCall);
+
 	/// If true, we can assume that variable values never change and skip some steps.
 	bool m_valuesAreSSA = false;
 	/// Callback to retrieve the current value of a variable.
@@ -118,11 +133,16 @@ private:
 
 	/// Offsets for each variable to one representative per group.
 	/// The empty string is the representative of the constant value zero.
-	std::map<YulString, VariableOffset> m_offsets;
+	/// This is the cache of query results: An entry is valid as long as the value
+	/// of the variable is the same as in m_lastKnownValue.
+	std::unordered_map<YulString, VariableOffset> m_offsets;
 	/// Last known value of each variable we queried.
-	std::map<YulString, Expression const*> m_lastKnownValue;
+	std::unordered_map<YulString, Expression const*> m_lastKnownValue;
 	/// For each representative, variables that use it to offset from.
 	std::map<YulString, std::set<YulString>> m_groupMembers;
+	/// Cache of the bits that can be non-zero in the values of variables. An entry is valid
+	/// under the same conditions as an entry of m_offsets.
+	std::unordered_map<YulString, u256> m_possiblyNonZeroBits;
 };
 
 }
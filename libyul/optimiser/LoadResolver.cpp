@@ -45,9 +45,11 @@ using namespace solidity::yul;
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
+	CallGraph callGraph = CallGraphGenerator::callGraph(_ast);
 	LoadResolver{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		SideEffectsPropagator::sideEffects(_context.dialect, callGraph),
+		StorageWritesPropagator::storageWrites(_context.dialect, _ast, callGraph),
 		containsMSize,
 		_context.expectedExecutionsPerDeployment
 	}(_ast);
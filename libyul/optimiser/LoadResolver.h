@@ -50,10 +50,16 @@ private:
 	LoadResolver(
 		Dialect const& _dialect,
 		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, StorageWrites> _functionStorageWrites,
 		bool _containsMSize,
 		std::optional<size_t> _expectedExecutionsPerDeployment
 	):
-		DataFlowAnalyzer(_dialect, MemoryAndStorage::Analyze, std::move(_functionSideEffects)),
+		DataFlowAnalyzer(
+			_dialect,
+			MemoryAndStorage::Analyze,
+			std::move(_functionSideEffects),
+			std::move(_functionStorageWrites)
+		),
 		m_containsMSize(_containsMSize),
 		m_expectedExecutionsPerDeployment(std::move(_expectedExecutionsPerDeployment))
 	{}
@@ -0,0 +1,342 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes overflow checks of loop counters that are implied by the loop condition.
+ */
+
+#include <libyul/optimiser/LoopCounterCheckEliminator.h>
+
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// @returns the call if @a _expression is a call to @a _function with two arguments.
+FunctionCall const* binaryCall(Expression const& _expression, YulString _function)
+{
+	if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+		if (call->functionName.name == _function && call->arguments.size() == 2)
+			return call;
+	return nullptr;
+}
+
+/// @returns the name if @a _expression is an identifier in @a _names.
+optional<YulString> identifierIn(Expression const& _expression, set<YulString> const& _names)
+{
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		if (_names.count(identifier->name))
+			return identifier->name;
+	return nullopt;
+}
+
+/// Determines whether any of the given variables is assigned to.
+class AssignmentFinder: public ASTWalker
+{
+public:
+	explicit AssignmentFinder(set<YulString> const& _variables): m_variables(_variables) {}
+
+	using ASTWalker::operator();
+	void operator()(Assignment const& _assignment) override
+	{
+		for (Identifier const& variable: _assignment.variableNames)
+			m_found = m_found || m_variables.count(variable.name);
+		ASTWalker::operator()(_assignment);
+	}
+
+	bool found() const { return m_found; }
+
+private:
+	set<YulString> const& m_variables;
+	bool m_found = false;
+};
+
+bool assignsAnyOf(Statement const& _statement, set<YulString> const& _variables)
+{
+	AssignmentFinder finder{_variables};
+	finder.visit(_statement);
+	return finder.found();
+}
+
+}
+
+void LoopCounterCheckEliminator::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!_context.dialect.builtin("add"_yulstring))
+		return;
+
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	map<YulString, u256> constants;
+	for (auto const& [variable, value]: ssaValues.values())
+		if (Literal const* literal = get_if<Literal>(value))
+			constants[variable] = valueOfLiteral(*literal);
+
+	LoopCounterCheckEliminator{_context.dialect, allFunctionDefinitions(_ast), std::move(constants)}(_ast);
+}
+
+void LoopCounterCheckEliminator::operator()(ForLoop& _loop)
+{
+	ASTModifier::operator()(_loop);
+
+	optional<CounterBound> bound = counterBound(_loop);
+	if (!bound)
+		return;
+
+	// Copies of the counter that have the same value until the counter is assigned.
+	set<YulString> counters{bound->counter};
+	auto replaceCheckedIncrement = [&](Expression* _value) {
+		if (FunctionCall* call = _value ? get_if<FunctionCall>(_value) : nullptr)
+			if (
+				call->arguments.size() == 1 &&
+				identifierIn(call->arguments.front(), counters) &&
+				isCheckedIncrement(call->functionName.name, *bound)
+			)
+			{
+				call->functionName.name = "add"_yulstring;
+				call->arguments.emplace_back(Literal{call->debugData, LiteralKind::Number, "1"_yulstring, m_dialect.defaultType});
+			}
+	};
+
+	vector<Statement>& statements = _loop.post.statements;
+	set<size_t> removed;
+	for (size_t index = 0; index < statements.size(); ++index)
+	{
+		Statement& statement = statements[index];
+		if (VariableDeclaration* declaration = get_if<VariableDeclaration>(&statement))
+		{
+			replaceCheckedIncrement(declaration->value.get());
+			if (
+				declaration->variables.size() == 1 &&
+				declaration->value &&
+				identifierIn(*declaration->value, counters)
+			)
+				counters.insert(declaration->variables.front().name);
+		}
+		else if (If const* ifStatement = get_if<If>(&statement))
+		{
+			if (knownToBeFalse(*ifStatement->condition, counters, *bound))
+			{
+				removed.insert(index);
+				continue;
+			}
+		}
+		else if (Assignment* assignment = get_if<Assignment>(&statement))
+			replaceCheckedIncrement(assignment->value.get());
+
+		if (assignsAnyOf(statement, counters))
+			break;
+	}
+
+	for (auto it = removed.rbegin(); it != removed.rend(); ++it)
+		statements.erase(statements.begin() + static_cast<ptrdiff_t>(*it));
+}
+
+optional<LoopCounterCheckEliminator::CounterBound> LoopCounterCheckEliminator::counterBound(ForLoop const& _loop) const
+{
+	optional<CounterBound> bound;
+	optional<u256> constantCondition = constantValue(*_loop.condition);
+	if (constantCondition && *constantCondition != 0)
+	{
+		// The condition was moved into the body by ForLoopConditionIntoBody.
+		if (_loop.body.statements.empty())
+			return nullopt;
+		If const* guard = get_if<If>(&_loop.body.statements.front());
+		if (
+			!guard ||
+			guard->body.statements.size() != 1 ||
+			!holds_alternative<Break>(guard->body.statements.front())
+		)
+			return nullopt;
+		FunctionCall const* negation = get_if<FunctionCall>(guard->condition.get());
+		if (!negation || negation->functionName.name != "iszero"_yulstring || negation->arguments.size() != 1)
+			return nullopt;
+		bound = boundFromCondition(negation->arguments.front());
+	}
+	else
+		bound = boundFromCondition(*_loop.condition);
+
+	if (!bound || assignedVariableNames(_loop.body).count(bound->counter))
+		return nullopt;
+	return bound;
+}
+
+optional<LoopCounterCheckEliminator::CounterBound> LoopCounterCheckEliminator::boundFromCondition(
+	Expression const& _condition
+) const
+{
+	for (bool isSigned: {false, true})
+	{
+		Identifier const* counter = nullptr;
+		Expression const* limit = nullptr;
+		if (FunctionCall const* less = binaryCall(_condition, isSigned ? "slt"_yulstring : "lt"_yulstring))
+		{
+			if (m_dialect.builtin(less->functionName.name))
+			{
+				counter = get_if<Identifier>(&less->arguments.front());
+				limit = &less->arguments.back();
+			}
+		}
+		else if (FunctionCall const* greater = binaryCall(_condition, isSigned ? "sgt"_yulstring : "gt"_yulstring))
+			if (m_dialect.builtin(greater->functionName.name))
+			{
+				counter = get_if<Identifier>(&greater->arguments.back());
+				limit = &greater->arguments.front();
+			}
+		if (!counter)
+			continue;
+
+		CounterBound bound{counter->name, isSigned, {}};
+		// The counter is less than the limit, which is at most the maximum value.
+		u256 minimumLimit = isSigned ? u256(bigint(1) << 255) : u256(0);
+		u256 maximumLimit = minimumLimit - 1;
+		u256 limitValue = constantValue(*limit).value_or(maximumLimit);
+		// The loop body is never executed.
+		if (limitValue == minimumLimit)
+			return nullopt;
+		bound.maximum = limitValue - 1;
+		return bound;
+	}
+	return nullopt;
+}
+
+bool LoopCounterCheckEliminator::knownToBeFalse(
+	Expression const& _condition,
+	set<YulString> const& _counters,
+	CounterBound const& _bound
+) const
+{
+	auto exceedsBound = [&](u256 const& _value) {
+		return _bound.isSigned ? u2s(_value) > u2s(_bound.maximum) : _value > _bound.maximum;
+	};
+	auto atLeastBound = [&](u256 const& _value) {
+		return _bound.isSigned ? u2s(_value) >= u2s(_bound.maximum) : _value >= _bound.maximum;
+	};
+
+	if (FunctionCall const* equality = binaryCall(_condition, "eq"_yulstring))
+		for (auto&& [counter, other]: {
+			pair{&equality->arguments.front(), &equality->arguments.back()},
+			pair{&equality->arguments.back(), &equality->arguments.front()}
+		})
+			if (identifierIn(*counter, _counters))
+				if (optional<u256> value = constantValue(*other))
+					if (exceedsBound(*value))
+						return true;
+
+	YulString greater = _bound.isSigned ? "sgt"_yulstring : "gt"_yulstring;
+	YulString less = _bound.isSigned ? "slt"_yulstring : "lt"_yulstring;
+	Expression const* counter = nullptr;
+	Expression const* other = nullptr;
+	if (FunctionCall const* call = binaryCall(_condition, greater))
+		tie(counter, other) = pair{&call->arguments.front(), &call->arguments.back()};
+	else if (FunctionCall const* call = binaryCall(_condition, less))
+		tie(counter, other) = pair{&call->arguments.back(), &call->arguments.front()};
+	if (counter && identifierIn(*counter, _counters))
+		if (optional<u256> value = constantValue(*other))
+			return atLeastBound(*value);
+	return false;
+}
+
+bool LoopCounterCheckEliminator::isCheckedIncrement(YulString _function, CounterBound const& _bound) const
+{
+	FunctionDefinition const* function = valueOrDefault(m_functions, _function, nullptr);
+	if (!function || function->parameters.size() != 1 || function->returnVariables.size() != 1)
+		return false;
+	YulString parameter = function->parameters.front().name;
+	YulString returnVariable = function->returnVariables.front().name;
+
+	vector<Statement> const& statements = function->body.statements;
+	size_t index = 0;
+	// Optional cleanup that does not change the value.
+	if (statements.size() == 3)
+	{
+		Assignment const* cleanup = get_if<Assignment>(&statements.front());
+		if (!cleanup || cleanup->variableNames.size() != 1 || cleanup->variableNames.front().name != parameter)
+			return false;
+		FunctionCall const* call = get_if<FunctionCall>(cleanup->value.get());
+		if (
+			!call ||
+			!isIdentity(call->functionName.name) ||
+			!identifierIn(call->arguments.front(), {parameter})
+		)
+			return false;
+		index = 1;
+	}
+	else if (statements.size() != 2)
+		return false;
+
+	If const* check = get_if<If>(&statements[index]);
+	if (!check || !knownToBeFalse(*check->condition, {parameter}, _bound))
+		return false;
+
+	Assignment const* increment = get_if<Assignment>(&statements[index + 1]);
+	if (!increment || increment->variableNames.size() != 1 || increment->variableNames.front().name != returnVariable)
+		return false;
+	FunctionCall const* addition = binaryCall(*increment->value, "add"_yulstring);
+	if (!addition || !m_dialect.builtin(addition->functionName.name))
+		return false;
+	for (auto&& [value, one]: {
+		pair{&addition->arguments.front(), &addition->arguments.back()},
+		pair{&addition->arguments.back(), &addition->arguments.front()}
+	})
+		if (identifierIn(*value, {parameter}) && constantValue(*one) == u256(1))
+			return true;
+	return false;
+}
+
+bool LoopCounterCheckEliminator::isIdentity(YulString _function) const
+{
+	FunctionDefinition const* function = valueOrDefault(m_functions, _function, nullptr);
+	if (
+		!function ||
+		function->parameters.size() != 1 ||
+		function->returnVariables.size() != 1 ||
+		function->body.statements.size() != 1
+	)
+		return false;
+	Assignment const* assignment = get_if<Assignment>(&function->body.statements.front());
+	return
+		assignment &&
+		assignment->variableNames.size() == 1 &&
+		assignment->variableNames.front().name == function->returnVariables.front().name &&
+		identifierIn(*assignment->value, {function->parameters.front().name});
+}
+
+optional<u256> LoopCounterCheckEliminator::constantValue(Expression const& _expression) const
+{
+	if (Literal const* literal = get_if<Literal>(&_expression))
+		return valueOfLiteral(*literal);
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		if (u256 const* value = valueOrNullptr(m_constants, identifier->name))
+			return *value;
+	if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+		if (call->functionName.name == "not"_yulstring && call->arguments.size() == 1 && m_dialect.builtin(call->functionName.name))
+			if (optional<u256> value = constantValue(call->arguments.front()))
+				return ~*value;
+	return nullopt;
+}
@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that removes overflow checks of loop counters that are implied by the loop condition.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
+#include <set>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Optimisation stage that uses the condition of a for loop to remove overflow checks
+ * from its post block.
+ *
+ * If the condition of the loop is ``lt(i, e)`` and the body does not assign to ``i``,
+ * then ``i`` is less than ``e`` and thus less than ``2**256 - 1`` whenever the post block
+ * is executed. If ``e`` is a constant, the bound is ``e - 1``. Conditions using ``slt``
+ * lead to the corresponding signed bound.
+ *
+ * Until ``i`` is assigned in the post block, the step uses this bound to
+ *  - remove ``if`` statements whose condition compares ``i`` or a copy of it to a constant
+ *    with ``eq``, ``gt`` or ``sgt`` and is false due to the bound, and
+ *  - replace calls to checked increment functions, i.e. functions that only clean up
+ *    their argument with an identity function, revert if it equals a constant the bound
+ *    excludes and return it incremented by one, by an ``add`` of one.
+ *
+ * The condition can also be the first statement of the body in the form
+ * ``if iszero(lt(i, e)) { break }``, as produced by ForLoopConditionIntoBody.
+ *
+ * Code of the form
+ *
+ * for { } lt(i, n) { i := increment(i) } { ... }
+ * function increment(value) -> ret {
+ *     value := cleanup(value)
+ *     if eq(value, 0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff) { panic() }
+ *     ret := add(value, 1)
+ * }
+ *
+ * is transformed into
+ *
+ * for { } lt(i, n) { i := add(i, 1) } { ... }
+ *
+ * Prerequisite: Disambiguator.
+ */
+class LoopCounterCheckEliminator: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopCounterCheckEliminator"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(ForLoop& _loop) override;
+
+private:
+	/// Upper bound of a loop counter in the post block.
+	struct CounterBound
+	{
+		YulString counter;
+		bool isSigned = false;
+		u256 maximum;
+	};
+
+	LoopCounterCheckEliminator(
+		Dialect const& _dialect,
+		std::map<YulString, FunctionDefinition const*> _functions,
+		std::map<YulString, u256> _constants
+	):
+		m_dialect(_dialect),
+		m_functions(std::move(_functions)),
+		m_constants(std::move(_constants))
+	{}
+
+	/// @returns the bound that holds for the loop counter in the post block of @a _loop, if any.
+	std::optional<CounterBound> counterBound(ForLoop const& _loop) const;
+	/// @returns the bound for the counter following from @a _condition being true.
+	std::optional<CounterBound> boundFromCondition(Expression const& _condition) const;
+	/// @returns true if @a _condition is false if all variables in @a _counters satisfy @a _bound.
+	bool knownToBeFalse(Expression const& _condition, std::set<YulString> const& _counters, CounterBound const& _bound) const;
+	/// @returns true if @a _function is a checked increment whose check is excluded by @a _bound.
+	bool isCheckedIncrement(YulString _function, CounterBound const& _bound) const;
+	/// @returns true if @a _function returns its single argument unchanged.
+	bool isIdentity(YulString _function) const;
+	std::optional<u256> constantValue(Expression const& _expression) const;
+
+	Dialect const& m_dialect;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	/// Values of variables that are never reassigned and initialised with a literal.
+	std::map<YulString, u256> m_constants;
+};
+
+}
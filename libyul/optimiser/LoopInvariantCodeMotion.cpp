@@ -19,10 +19,17 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/KnowledgeBase.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <libevmasm/Instruction.h>
+
 #include <libsolutil/CommonData.h>
 
 #include <utility>
@@ -31,13 +38,93 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
+namespace
+{
+
+/**
+ * Collects the locations written to by ``sstore`` and ``mstore`` in a loop. Resets the
+ * locations to nullopt if there are any other writes to storage resp. memory.
+ */
+class LoopWriteCollector: public ASTWalker
+{
+public:
+	LoopWriteCollector(
+		Dialect const& _dialect,
+		map<YulString, SideEffects> const& _functionSideEffects,
+		optional<vector<Expression>>& _storageWrites,
+		optional<vector<Expression>>& _memoryWrites
+	):
+		m_dialect(_dialect),
+		m_functionSideEffects(_functionSideEffects),
+		m_storageWrites(_storageWrites),
+		m_memoryWrites(_memoryWrites)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+
+		SideEffects sideEffects;
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name))
+			sideEffects = builtin->sideEffects;
+		else if (SideEffects const* functionSideEffects = util::valueOrNullptr(m_functionSideEffects, _functionCall.functionName.name))
+			sideEffects = *functionSideEffects;
+		else
+			sideEffects = SideEffects::worst();
+
+		optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, _functionCall.functionName.name);
+		if (sideEffects.storage == SideEffects::Write)
+			record(m_storageWrites, instruction == evmasm::Instruction::SSTORE, _functionCall);
+		if (sideEffects.memory == SideEffects::Write)
+			record(m_memoryWrites, instruction == evmasm::Instruction::MSTORE, _functionCall);
+	}
+
+private:
+	static void record(optional<vector<Expression>>& _locations, bool _isStore, FunctionCall const& _store)
+	{
+		if (!_locations)
+			return;
+		if (
+			_isStore &&
+			(holds_alternative<Identifier>(_store.arguments.front()) || holds_alternative<Literal>(_store.arguments.front()))
+		)
+			_locations->emplace_back(_store.arguments.front());
+		else
+			_locations.reset();
+	}
+
+	Dialect const& m_dialect;
+	map<YulString, SideEffects> const& m_functionSideEffects;
+	optional<vector<Expression>>& m_storageWrites;
+	optional<vector<Expression>>& m_memoryWrites;
+};
+
+}
+
 void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 {
 	map<YulString, SideEffects> functionSideEffects =
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	SSAValueTracker ssaValueTracker;
+	ssaValueTracker(_ast);
+	set<YulString> ssaVars;
+	map<YulString, AssignedValue> ssaValues;
+	for (auto const& [name, value]: ssaValueTracker.values())
+	{
+		ssaVars.insert(name);
+		ssaValues[name] = AssignedValue{value, 0};
+	}
+	KnowledgeBase knowledgeBase{ssaValues};
+	LoopInvariantCodeMotion{
+		_context.dialect,
+		ssaVars,
+		ssaValues,
+		functionSideEffects,
+		containsMSize,
+		knowledgeBase
+	}(_ast);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
@@ -58,13 +145,14 @@ void LoopInvariantCodeMotion::operator()(Block& _block)
 bool LoopInvariantCodeMotion::canBePromoted(
 	VariableDeclaration const& _varDecl,
 	set<YulString> const& _varsDefinedInCurrentScope,
-	SideEffects const& _forLoopSideEffects
+	SideEffects const& _forLoopSideEffects,
+	LoopWrites const& _forLoopWrites
 ) const
 {
 	// A declaration can be promoted iff
 	// 1. Its LHS is a SSA variable
 	// 2. Its RHS only references SSA variables declared outside of the current scope
-	// 3. Its RHS is movable
+	// 3. Its RHS is movable or a load from a location the loop does not write to
 
 	for (auto const& var: _varDecl.variables)
 		if (!m_ssaVariables.count(var.name))
@@ -75,18 +163,86 @@ bool LoopInvariantCodeMotion::canBePromoted(
 			if (_varsDefinedInCurrentScope.count(ref.first) || !m_ssaVariables.count(ref.first))
 				return false;
 		SideEffectsCollector sideEffects{m_dialect, *_varDecl.value, &m_functionSideEffects};
-		if (!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize))
+		if (
+			!sideEffects.movableRelativeTo(_forLoopSideEffects, m_containsMSize) &&
+			!isUnaffectedLoad(*_varDecl.value, _forLoopWrites)
+		)
 			return false;
 	}
 	return true;
 }
 
+bool LoopInvariantCodeMotion::isUnaffectedLoad(Expression const& _value, LoopWrites const& _forLoopWrites) const
+{
+	FunctionCall const* load = get_if<FunctionCall>(&_value);
+	if (!load || load->arguments.size() != 1)
+		return false;
+	Expression const& location = load->arguments.front();
+	if (!holds_alternative<Identifier>(location) && !holds_alternative<Literal>(location))
+		return false;
+
+	optional<evmasm::Instruction> instruction = toEVMInstruction(m_dialect, load->functionName.name);
+	bool const isStorage = instruction == evmasm::Instruction::SLOAD;
+	if (!isStorage && (instruction != evmasm::Instruction::MLOAD || m_containsMSize))
+		return false;
+	optional<vector<Expression>> const& writes = isStorage ? _forLoopWrites.storage : _forLoopWrites.memory;
+	if (!writes || !dependsOnlySSAVariables(location))
+		return false;
+
+	// The KnowledgeBase only relates variables, so literal locations are compared by their value.
+	auto difference = [&](Expression const& _written) -> optional<u256> {
+		if (holds_alternative<Identifier>(location) && holds_alternative<Identifier>(_written))
+			return m_knowledgeBase.differenceIfKnownConstant(
+				std::get<Identifier>(location).name,
+				std::get<Identifier>(_written).name
+			);
+		optional<u256> loaded = m_knowledgeBase.valueIfKnownConstant(location);
+		optional<u256> written = m_knowledgeBase.valueIfKnownConstant(_written);
+		if (loaded && written)
+			return *loaded - *written;
+		return nullopt;
+	};
+	for (Expression const& written: *writes)
+	{
+		if (!dependsOnlySSAVariables(written))
+			return false;
+		optional<u256> offset = difference(written);
+		if (!offset || *offset == 0)
+			return false;
+		if (!isStorage && (*offset < 32 || *offset > u256(0) - 32))
+			return false;
+	}
+	return true;
+}
+
+bool LoopInvariantCodeMotion::dependsOnlySSAVariables(Expression const& _expression) const
+{
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (bool const* result = util::valueOrNullptr(m_dependsOnlyOnSSAVariables, identifier->name))
+			return *result;
+		AssignedValue const* value = util::valueOrNullptr(m_ssaValues, identifier->name);
+		bool result = value && (!value->value || dependsOnlySSAVariables(*value->value));
+		m_dependsOnlyOnSSAVariables[identifier->name] = result;
+		return result;
+	}
+	else if (FunctionCall const* functionCall = get_if<FunctionCall>(&_expression))
+	{
+		for (Expression const& argument: functionCall->arguments)
+			if (!dependsOnlySSAVariables(argument))
+				return false;
+	}
+	return true;
+}
+
 optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 {
 	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
 
 	auto forLoopSideEffects =
 		SideEffectsCollector{m_dialect, _for, &m_functionSideEffects}.sideEffects();
+	LoopWrites forLoopWrites;
+	LoopWriteCollector{m_dialect, m_functionSideEffects, forLoopWrites.storage, forLoopWrites.memory}(_for);
 
 	vector<Statement> replacement;
 	for (Block* block: {&_for.post, &_for.body})
@@ -99,7 +255,7 @@ optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
 				if (holds_alternative<VariableDeclaration>(_s))
 				{
 					VariableDeclaration const& varDecl = std::get<VariableDeclaration>(_s);
-					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects))
+					if (canBePromoted(varDecl, varsDefinedInScope, forLoopSideEffects, forLoopWrites))
 					{
 						replacement.emplace_back(std::move(_s));
 						// Do not add the variables declared here to varsDefinedInScope because we are moving them.
@@ -21,9 +21,15 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimiserStep.h>
 
+#include <optional>
+#include <vector>
+
 namespace solidity::yul
 {
 
+class KnowledgeBase;
+struct AssignedValue;
+
 /**
  * Loop-invariant code motion.
  *
@@ -32,6 +38,10 @@ namespace solidity::yul
  * Only statements at the top level in a loop's body or post block are considered, i.e variable
  * declarations inside conditional branches will not be moved out of the loop.
  *
+ * Declarations of the form ``let x := sload(k)`` or ``let x := mload(k)`` are also moved if the
+ * loop writes to storage resp. memory, as long as all these writes are ``sstore`` resp. ``mstore``
+ * calls to locations that are known to be different from ``k`` (by at least 32 bytes for memory).
+ *
  * Requirements:
  * - The Disambiguator, ForLoopInitRewriter and FunctionHoister must be run upfront.
  * - Expression splitter and SSA transform should be run upfront to obtain better result.
@@ -49,27 +59,48 @@ private:
 	explicit LoopInvariantCodeMotion(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables,
+		std::map<YulString, AssignedValue> const& _ssaValues,
 		std::map<YulString, SideEffects> const& _functionSideEffects,
-		bool _containsMSize
+		bool _containsMSize,
+		KnowledgeBase& _knowledgeBase
 	):
 		m_containsMSize(_containsMSize),
 		m_dialect(_dialect),
 		m_ssaVariables(_ssaVariables),
-		m_functionSideEffects(_functionSideEffects)
+		m_ssaValues(_ssaValues),
+		m_functionSideEffects(_functionSideEffects),
+		m_knowledgeBase(_knowledgeBase)
 	{ }
 
+	/// Locations written to by a loop. Set to nullopt if there are writes to unknown locations.
+	struct LoopWrites
+	{
+		std::optional<std::vector<Expression>> storage = std::vector<Expression>{};
+		std::optional<std::vector<Expression>> memory = std::vector<Expression>{};
+	};
+
 	/// @returns true if the given variable declaration can be moved to in front of the loop.
 	bool canBePromoted(
 		VariableDeclaration const& _varDecl,
 		std::set<YulString> const& _varsDefinedInCurrentScope,
-		SideEffects const& _forLoopSideEffects
+		SideEffects const& _forLoopSideEffects,
+		LoopWrites const& _forLoopWrites
 	) const;
+	/// @returns true if @a _value is a storage or memory load from a location that is not written
+	/// to by the loop.
+	bool isUnaffectedLoad(Expression const& _value, LoopWrites const& _forLoopWrites) const;
+	/// @returns true if the value of @a _expression only depends on SSA variables, so that the
+	/// relations the KnowledgeBase finds hold in all iterations of a loop.
+	bool dependsOnlySSAVariables(Expression const& _expression) const;
 	std::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
 
 	bool m_containsMSize = true;
 	Dialect const& m_dialect;
 	std::set<YulString> const& m_ssaVariables;
+	std::map<YulString, AssignedValue> const& m_ssaValues;
 	std::map<YulString, SideEffects> const& m_functionSideEffects;
+	KnowledgeBase& m_knowledgeBase;
+	mutable std::map<YulString, bool> m_dependsOnlyOnSSAVariables;
 };
 
 }
@@ -0,0 +1,260 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that frees memory allocated in a loop iteration at the end of the iteration.
+ */
+
+#include <libyul/optimiser/LoopMemoryReclaimer.h>
+
+#include <libyul/optimiser/FunctionCallFinder.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
+
+#include <range/v3/algorithm/any_of.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+/**
+ * Determines the variables of a block that can hold references to memory allocated in it
+ * and whether such a reference can escape.
+ */
+class LoopMemoryReclaimer::ReferenceTracker: public ASTWalker
+{
+public:
+	/// @param _references variables that hold references from the start.
+	/// @param _localVariables if given, assigning a reference to any other variable lets it escape.
+	ReferenceTracker(
+		LoopMemoryReclaimer& _reclaimer,
+		set<YulString> _references,
+		set<YulString> const* _localVariables
+	):
+		m_reclaimer(_reclaimer),
+		m_references(std::move(_references)),
+		m_localVariables(_localVariables)
+	{}
+
+	/// Visits the block until the set of variables holding references does not change anymore.
+	void analyse(Block const& _block)
+	{
+		size_t referenceCount = 0;
+		do
+		{
+			referenceCount = m_references.size();
+			(*this)(_block);
+		}
+		while (!m_escapes && m_references.size() != referenceCount);
+	}
+
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		if (_varDecl.value && isReference(*_varDecl.value))
+			for (TypedName const& variable: _varDecl.variables)
+				m_references.insert(variable.name);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		if (!isReference(*_assignment.value))
+			return;
+		for (Identifier const& variable: _assignment.variableNames)
+		{
+			m_references.insert(variable.name);
+			if (m_localVariables && !m_localVariables->count(variable.name))
+				m_escapes = true;
+		}
+	}
+	void operator()(FunctionDefinition const&) override {}
+	void visit(Expression const& _expression) override { isReference(_expression); }
+
+	bool escapes() const { return m_escapes; }
+	bool allocates() const { return m_allocates; }
+	set<YulString> const& references() const { return m_references; }
+
+private:
+	/// @returns true if the value of @a _expression can be a reference to memory allocated
+	/// in the block and records whether evaluating it lets a reference escape.
+	bool isReference(Expression const& _expression)
+	{
+		return std::visit(GenericVisitor{
+			[&](FunctionCall const& _call) { return isReference(_call); },
+			[&](Identifier const& _identifier) { return m_references.count(_identifier.name) > 0; },
+			[&](Literal const&) { return false; }
+		}, _expression);
+	}
+
+	bool isReference(FunctionCall const& _call)
+	{
+		vector<bool> referenceArguments;
+		for (Expression const& argument: _call.arguments)
+			referenceArguments.emplace_back(isReference(argument));
+		bool anyReferenceArgument = ranges::any_of(referenceArguments, [](bool _reference) { return _reference; });
+
+		BuiltinFunctionForEVM const* builtin = m_reclaimer.m_dialect.builtin(_call.functionName.name);
+		if (!builtin)
+		{
+			CallSummary const& summary = m_reclaimer.callSummary(_call.functionName.name, referenceArguments);
+			m_escapes = m_escapes || summary.escapes;
+			m_allocates = m_allocates || summary.allocates;
+			return summary.returnsReference;
+		}
+
+		string const& name = _call.functionName.name.str();
+		if (name == "mload")
+			return m_reclaimer.isFreeMemoryPointerSlot(_call.arguments.front());
+		else if (name == "mstore" && m_reclaimer.isFreeMemoryPointerSlot(_call.arguments.front()))
+			m_allocates = true;
+		else if (name == "mstore" || name == "mstore8" || name == "sstore")
+			m_escapes = m_escapes || referenceArguments.back();
+		else if (!builtin->instruction)
+			// Verbatim and other special builtins could store their arguments anywhere.
+			m_escapes = m_escapes || anyReferenceArgument;
+		else if (name == "sub")
+			// The difference of two references is an offset.
+			return referenceArguments.front() != referenceArguments.back();
+		else if (!nonReferenceResults().count(name))
+			return anyReferenceArgument;
+		return false;
+	}
+
+	/// Builtins that can take references as arguments but only return unrelated values.
+	static set<string> const& nonReferenceResults()
+	{
+		static set<string> const builtins{
+			"lt", "gt", "slt", "sgt", "eq", "iszero", "keccak256",
+			"call", "callcode", "delegatecall", "staticcall", "create", "create2"
+		};
+		return builtins;
+	}
+
+	LoopMemoryReclaimer& m_reclaimer;
+	set<YulString> m_references;
+	set<YulString> const* m_localVariables = nullptr;
+	bool m_escapes = false;
+	bool m_allocates = false;
+};
+
+void LoopMemoryReclaimer::run(OptimiserStepContext& _context, Block& _ast)
+{
+	EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_context.dialect);
+	if (
+		!dialect ||
+		!dialect->providesObjectAccess() ||
+		FunctionCallFinder::run(_ast, "memoryguard"_yulstring).empty() ||
+		MSizeFinder::containsMSize(*dialect, _ast)
+	)
+		return;
+
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	map<YulString, u256> constants;
+	for (auto const& [variable, value]: ssaValues.values())
+		if (Literal const* literal = get_if<Literal>(value))
+			constants[variable] = valueOfLiteral(*literal);
+
+	LoopMemoryReclaimer{*dialect, _context.dispenser, allFunctionDefinitions(_ast), std::move(constants)}(_ast);
+}
+
+void LoopMemoryReclaimer::operator()(ForLoop& _loop)
+{
+	ASTModifier::operator()(_loop);
+
+	// Function definitions are not moved, because other calls refer to them.
+	if (!NameCollector{_loop.body, NameCollector::OnlyFunctions}.names().empty())
+		return;
+
+	set<YulString> localVariables = NameCollector{_loop.body, NameCollector::OnlyVariables}.names();
+	ReferenceTracker tracker{*this, {}, &localVariables};
+	tracker.analyse(_loop.body);
+	if (tracker.escapes() || !tracker.allocates())
+		return;
+
+	shared_ptr<DebugData const> debugData = _loop.debugData;
+	YulString memoryPointer = m_nameDispenser.newName({});
+	auto freeMemoryPointerSlot = [&]() {
+		return Expression{Literal{debugData, LiteralKind::Number, "64"_yulstring, m_dialect.defaultType}};
+	};
+	_loop.body.statements.insert(_loop.body.statements.begin(), VariableDeclaration{
+		debugData,
+		{TypedName{debugData, memoryPointer, m_dialect.defaultType}},
+		make_unique<Expression>(FunctionCall{
+			debugData,
+			Identifier{debugData, m_dialect.memoryLoadFunction({})->name},
+			{freeMemoryPointerSlot()}
+		})
+	});
+	_loop.body.statements.emplace_back(ExpressionStatement{debugData, FunctionCall{
+		debugData,
+		Identifier{debugData, m_dialect.memoryStoreFunction({})->name},
+		{freeMemoryPointerSlot(), Identifier{debugData, memoryPointer}}
+	}});
+}
+
+LoopMemoryReclaimer::CallSummary const& LoopMemoryReclaimer::callSummary(
+	YulString _function,
+	vector<bool> const& _referenceArguments
+)
+{
+	// Recursive and unknown functions are assumed to retain all references.
+	static CallSummary const conservativeSummary{true, true, true};
+
+	auto key = make_pair(_function, _referenceArguments);
+	if (CallSummary const* summary = valueOrNullptr(m_callSummaries, key))
+		return *summary;
+	FunctionDefinition const* function = valueOrDefault(m_functions, _function, nullptr);
+	if (!function || m_summariesInProgress.count(key))
+		return conservativeSummary;
+
+	yulAssert(function->parameters.size() == _referenceArguments.size(), "");
+	set<YulString> references;
+	for (size_t index = 0; index < _referenceArguments.size(); ++index)
+		if (_referenceArguments[index])
+			references.insert(function->parameters[index].name);
+
+	m_summariesInProgress.insert(key);
+	ReferenceTracker tracker{*this, std::move(references), nullptr};
+	tracker.analyse(function->body);
+	m_summariesInProgress.erase(key);
+
+	CallSummary summary;
+	summary.escapes = tracker.escapes();
+	summary.allocates = tracker.allocates();
+	summary.returnsReference = ranges::any_of(function->returnVariables, [&](TypedName const& _variable) {
+		return tracker.references().count(_variable.name) > 0;
+	});
+	return m_callSummaries[key] = summary;
+}
+
+bool LoopMemoryReclaimer::isFreeMemoryPointerSlot(Expression const& _expression) const
+{
+	if (Literal const* literal = get_if<Literal>(&_expression))
+		return valueOfLiteral(*literal) == 64;
+	if (Identifier const* identifier = get_if<Identifier>(&_expression))
+		if (u256 const* value = valueOrNullptr(m_constants, identifier->name))
+			return *value == 64;
+	return false;
+}
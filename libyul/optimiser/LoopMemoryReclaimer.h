@@ -0,0 +1,127 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that frees memory allocated in a loop iteration at the end of the iteration.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct EVMDialect;
+
+/**
+ * Optimisation stage that resets the free memory pointer at the end of the body of a for loop,
+ * if no reference to the memory allocated during an iteration can be retained after it.
+ * Temporary memory structs, arrays and ABI encoding buffers that are created in each
+ * iteration then reuse the same memory instead of expanding memory in every iteration.
+ *
+ * Code of the form
+ *
+ * for { } lt(i, n) { i := add(i, 1) } {
+ *     let p := mload(64)
+ *     mstore(64, add(p, 64))
+ *     mstore(p, i)
+ *     sum := add(sum, mload(p))
+ * }
+ *
+ * is transformed into
+ *
+ * for { } lt(i, n) { i := add(i, 1) } {
+ *     let m := mload(64)
+ *     let p := mload(64)
+ *     mstore(64, add(p, 64))
+ *     mstore(p, i)
+ *     sum := add(sum, mload(p))
+ *     mstore(64, m)
+ * }
+ *
+ * A conservative analysis tracks all values that can be derived from the free memory pointer.
+ * Such a value escapes the iteration if it is assigned to a variable declared outside the loop
+ * body, stored in memory at any location other than the free memory pointer or in storage, or
+ * if it escapes in a function called from the loop body. The difference of two such values is
+ * considered an offset and not a reference. Since references cannot be stored in memory, values
+ * loaded from memory are never references.
+ *
+ * The transformation is only performed if the code contains a call to ``memoryguard``, i.e.
+ * if all of it respects Solidity's memory model, and if it does not use ``msize``.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class LoopMemoryReclaimer: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopMemoryReclaimer"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(ForLoop& _loop) override;
+
+private:
+	/// Summary of a function call for a given choice of references among its arguments.
+	struct CallSummary
+	{
+		/// A reference can be retained by the function.
+		bool escapes = false;
+		/// The function can return a reference.
+		bool returnsReference = false;
+		/// The function can allocate memory.
+		bool allocates = false;
+	};
+
+	class ReferenceTracker;
+
+	LoopMemoryReclaimer(
+		EVMDialect const& _dialect,
+		NameDispenser& _nameDispenser,
+		std::map<YulString, FunctionDefinition const*> _functions,
+		std::map<YulString, u256> _constants
+	):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser),
+		m_functions(std::move(_functions)),
+		m_constants(std::move(_constants))
+	{}
+
+	/// @returns the summary of a call to @a _function where the arguments flagged in
+	/// @a _referenceArguments may be references to newly allocated memory.
+	CallSummary const& callSummary(YulString _function, std::vector<bool> const& _referenceArguments);
+	/// @returns true if @a _expression is the address of the free memory pointer.
+	bool isFreeMemoryPointerSlot(Expression const& _expression) const;
+
+	EVMDialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	std::map<YulString, FunctionDefinition const*> m_functions;
+	/// Values of variables that are never reassigned and initialised with a literal.
+	std::map<YulString, u256> m_constants;
+	std::map<std::pair<YulString, std::vector<bool>>, CallSummary> m_callSummaries;
+	std::set<std::pair<YulString, std::vector<bool>>> m_summariesInProgress;
+};
+
+}
@@ -0,0 +1,254 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that fully unrolls loops with a small constant number of iterations.
+ */
+
+#include <libyul/optimiser/LoopUnroller.h>
+
+#include <libyul/optimiser/FullInliner.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Maximal number of iterations of loops that are unrolled.
+size_t constexpr c_maxIterations = 16;
+/// Cost of the jumps of one iteration of a loop in addition to its condition and post block.
+size_t constexpr c_iterationJumpCost = 2;
+/// Weight of a unit of code size relative to a unit of executed code. Deploying code costs
+/// 200 gas per byte, while most operations cost a few gas.
+size_t constexpr c_codeSizeWeight = 50;
+
+/**
+ * Checks whether a loop body contains function definitions or ``break`` or ``continue``
+ * statements that belong to the loop itself.
+ */
+class UnrollingObstacleFinder: public ASTWalker
+{
+public:
+	static bool containsObstacle(Block const& _body)
+	{
+		UnrollingObstacleFinder finder;
+		finder(_body);
+		return finder.m_found;
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const&) override { m_found = true; }
+	void operator()(Break const&) override { m_found = true; }
+	void operator()(Continue const&) override { m_found = true; }
+	// Break and continue statements of nested loops do not matter.
+	void operator()(ForLoop const& _loop) override
+	{
+		(*this)(_loop.pre);
+		(*this)(_loop.post);
+	}
+
+private:
+	bool m_found = false;
+};
+
+}
+
+void LoopUnroller::run(OptimiserStepContext& _context, Block& _ast)
+{
+	LoopUnroller{_context}(_ast);
+}
+
+void LoopUnroller::operator()(Block& _block)
+{
+	// Unroll inner loops first, so that the costs of the outer loops are known.
+	ASTModifier::operator()(_block);
+
+	size_t index = 0;
+	while (index < _block.statements.size())
+	{
+		optional<vector<Statement>> replacement;
+		if (ForLoop const* loop = get_if<ForLoop>(&_block.statements[index]))
+			replacement = unroll(
+				*loop,
+				index > 0 ? get_if<VariableDeclaration>(&_block.statements[index - 1]) : nullptr
+			);
+
+		if (!replacement)
+		{
+			++index;
+			continue;
+		}
+		auto position = _block.statements.begin() + static_cast<ptrdiff_t>(index);
+		position = _block.statements.erase(position);
+		_block.statements.insert(position, make_move_iterator(replacement->begin()), make_move_iterator(replacement->end()));
+		index += replacement->size();
+	}
+}
+
+optional<vector<Statement>> LoopUnroller::unroll(ForLoop const& _loop, VariableDeclaration const* _previous)
+{
+	VariableDeclaration const* counterDeclaration = nullptr;
+	if (_loop.pre.statements.size() == 1)
+		counterDeclaration = get_if<VariableDeclaration>(&_loop.pre.statements.front());
+	else if (_loop.pre.statements.empty())
+		counterDeclaration = _previous;
+	if (
+		!counterDeclaration ||
+		counterDeclaration->variables.size() != 1 ||
+		!isDefaultType(counterDeclaration->variables.front().type) ||
+		!counterDeclaration->value ||
+		!holds_alternative<Literal>(*counterDeclaration->value)
+	)
+		return nullopt;
+	bool const counterDeclaredInPre = _loop.pre.statements.size() == 1;
+	TypedName const& counter = counterDeclaration->variables.front();
+
+	if (_loop.post.statements.size() != 1)
+		return nullopt;
+	Assignment const* increment = get_if<Assignment>(&_loop.post.statements.front());
+	if (
+		!increment ||
+		increment->variableNames.size() != 1 ||
+		increment->variableNames.front().name != counter.name
+	)
+		return nullopt;
+
+	if (
+		assignedVariableNames(_loop.body).count(counter.name) ||
+		UnrollingObstacleFinder::containsObstacle(_loop.body)
+	)
+		return nullopt;
+
+	optional<u256> value = evaluate(*counterDeclaration->value, counter.name, 0);
+	vector<u256> iterations;
+	while (true)
+	{
+		if (!value)
+			return nullopt;
+		optional<u256> condition = evaluate(*_loop.condition, counter.name, *value);
+		if (!condition)
+			return nullopt;
+		if (*condition == 0)
+			break;
+		if (iterations.size() == c_maxIterations)
+			return nullopt;
+		iterations.emplace_back(*value);
+		value = evaluate(*increment->value, counter.name, *value);
+	}
+
+	if (!profitable(_loop, iterations.size()))
+		return nullopt;
+
+	vector<Statement> statements;
+	for (u256 const& iteration: iterations)
+	{
+		YulString counterCopy = m_nameDispenser.newName(counter.name);
+		Block body = std::get<Block>(BodyCopier{m_nameDispenser, {{counter.name, counterCopy}}}(_loop.body));
+		body.statements.insert(body.statements.begin(), VariableDeclaration{
+			counterDeclaration->debugData,
+			{TypedName{counter.debugData, counterCopy, counter.type}},
+			make_unique<Expression>(Literal{
+				debugDataOf(*counterDeclaration->value),
+				LiteralKind::Number,
+				YulString{formatNumber(iteration)},
+				counter.type
+			})
+		});
+		statements.emplace_back(std::move(body));
+	}
+	if (!counterDeclaredInPre && !iterations.empty())
+		statements.emplace_back(Assignment{
+			increment->debugData,
+			{Identifier{increment->debugData, counter.name}},
+			make_unique<Expression>(Literal{
+				debugDataOf(*increment->value),
+				LiteralKind::Number,
+				YulString{formatNumber(*value)},
+				counter.type
+			})
+		});
+	return statements;
+}
+
+bool LoopUnroller::profitable(ForLoop const& _loop, size_t _iterations) const
+{
+	size_t const conditionSize = CodeSize::codeSize(*_loop.condition);
+	size_t const iterationOverhead = conditionSize + CodeSize::codeSize(_loop.post) + c_iterationJumpCost;
+	// Every copy of the body also declares the value of the counter.
+	size_t const sizeAfter = _iterations * (CodeSize::codeSize(_loop.body) + 1);
+	size_t const sizeBefore =
+		CodeWeights{}.forLoopCost +
+		CodeSize::codeSize(_loop.pre) +
+		conditionSize +
+		CodeSize::codeSize(_loop.post) +
+		CodeSize::codeSize(_loop.body);
+	if (sizeAfter <= sizeBefore)
+		return true;
+
+	// The condition is evaluated once more than the body.
+	bigint const savedCost = bigint(_iterations) * iterationOverhead + conditionSize;
+	bigint const executions = m_expectedExecutionsPerDeployment ? *m_expectedExecutionsPerDeployment : 1;
+	return bigint(sizeAfter - sizeBefore) * c_codeSizeWeight <= savedCost * executions;
+}
+
+optional<u256> LoopUnroller::evaluate(Expression const& _expression, YulString _counter, u256 const& _value) const
+{
+	if (Literal const* literal = get_if<Literal>(&_expression))
+	{
+		if (!isDefaultType(literal->type) || (literal->kind == LiteralKind::String && literal->value.str().size() > 32))
+			return nullopt;
+		return valueOfLiteral(*literal);
+	}
+	else if (Identifier const* identifier = get_if<Identifier>(&_expression))
+	{
+		if (identifier->name == _counter)
+			return _value;
+		return nullopt;
+	}
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	BuiltinFunction const* builtin = m_dialect.builtin(call.functionName.name);
+	if (!builtin || !builtin->sideEffects.movable || builtin->returns.size() != 1)
+		return nullopt;
+	vector<u256> arguments;
+	for (size_t i = 0; i < call.arguments.size(); ++i)
+	{
+		if (builtin->literalArgument(i))
+			return nullopt;
+		optional<u256> argument = evaluate(call.arguments[i], _counter, _value);
+		if (!argument)
+			return nullopt;
+		arguments.emplace_back(std::move(*argument));
+	}
+	return evaluateBuiltinCall(m_dialect, builtin->name, arguments);
+}
+
+bool LoopUnroller::isDefaultType(YulString _type) const
+{
+	return _type.empty() || _type == m_dialect.defaultType;
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that fully unrolls loops with a small constant number of iterations.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/Numeric.h>
+
+#include <optional>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+class NameDispenser;
+
+/**
+ * Optimisation stage that replaces for loops with a small constant number of iterations
+ * by one copy of the loop body per iteration.
+ *
+ * The loop counter has to be declared with a literal value either as the only statement
+ * of the pre block or, as the ForLoopInitRewriter leaves it, directly before the loop.
+ * The post block has to consist of a single assignment to the counter and the body must
+ * not assign to the counter, contain ``break`` or ``continue`` statements of the loop or
+ * function definitions. The number of iterations is determined by evaluating the
+ * condition and the post block, which may only use the counter, literals and builtins.
+ *
+ * Each copy of the body is enclosed in a block that declares a new variable with the value
+ * of the counter in the respective iteration. If the counter was declared before the loop,
+ * its final value is assigned to it afterwards.
+ *
+ * for { let i := 0 } lt(i, 2) { i := add(i, 1) } { mstore(mul(i, 32), i) }
+ *
+ * is transformed into
+ *
+ * { let i_1 := 0 mstore(mul(i_1, 32), i_1) }
+ * { let i_2 := 1 mstore(mul(i_2, 32), i_2) }
+ *
+ * Loops are unrolled only if they have at most 16 iterations and if the growth in code size
+ * is outweighed by the removed overhead of the condition and the post block, weighted by
+ * the expected number of executions per deployment.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class LoopUnroller: public ASTModifier
+{
+public:
+	static constexpr char const* name{"LoopUnroller"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	explicit LoopUnroller(OptimiserStepContext& _context):
+		m_dialect(_context.dialect),
+		m_nameDispenser(_context.dispenser),
+		m_expectedExecutionsPerDeployment(_context.expectedExecutionsPerDeployment)
+	{}
+
+	/// @returns the statements replacing @a _loop, if it can and should be unrolled.
+	/// @param _previous the statement directly before the loop, if it is a variable declaration.
+	std::optional<std::vector<Statement>> unroll(ForLoop const& _loop, VariableDeclaration const* _previous);
+
+	/// @returns true if replacing the loop by @a _iterations copies of its body is worth it.
+	bool profitable(ForLoop const& _loop, size_t _iterations) const;
+
+	/// @returns the value of @a _expression if the counter @a _counter has the value @a _value
+	/// and the expression only consists of the counter, literals and builtins.
+	std::optional<u256> evaluate(Expression const& _expression, YulString _counter, u256 const& _value) const;
+
+	bool isDefaultType(YulString _type) const;
+
+	Dialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
+};
+
+}
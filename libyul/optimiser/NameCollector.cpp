@@ -46,7 +46,7 @@ void NameCollector::operator()(FunctionDefinition const& _funDef)
 		for (auto const& ret: _funDef.returnVariables)
 			m_names.emplace(ret.name);
 	}
-	ASTWalker::operator ()(_funDef);
+	StaticASTWalker::operator()(_funDef);
 }
 
 void ReferencesCounter::operator()(Identifier const& _identifier)
@@ -57,7 +57,7 @@ void ReferencesCounter::operator()(Identifier const& _identifier)
 void ReferencesCounter::operator()(FunctionCall const& _funCall)
 {
 	++m_references[_funCall.functionName.name];
-	ASTWalker::operator()(_funCall);
+	StaticASTWalker::operator()(_funCall);
 }
 
 map<YulString, size_t> ReferencesCounter::countReferences(Block const& _block)
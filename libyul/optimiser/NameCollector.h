@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/StaticASTWalker.h>
 
 #include <map>
 #include <set>
@@ -32,7 +33,7 @@ namespace solidity::yul
 /**
  * Specific AST walker that collects all defined names.
  */
-class NameCollector: public ASTWalker
+class NameCollector: public StaticASTWalker<NameCollector>
 {
 public:
 	enum CollectWhat { VariablesAndFunctions, OnlyVariables, OnlyFunctions };
@@ -55,9 +56,9 @@ public:
 		(*this)(_functionDefinition);
 	}
 
-	using ASTWalker::operator ();
-	void operator()(VariableDeclaration const& _varDecl) override;
-	void operator()(FunctionDefinition const& _funDef) override;
+	using StaticASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl);
+	void operator()(FunctionDefinition const& _funDef);
 
 	std::set<YulString> names() const { return m_names; }
 private:
@@ -68,12 +69,12 @@ private:
 /**
  * Specific AST walker that counts all references to all declarations.
  */
-class ReferencesCounter: public ASTWalker
+class ReferencesCounter: public StaticASTWalker<ReferencesCounter>
 {
 public:
-	using ASTWalker::operator ();
-	void operator()(Identifier const& _identifier) override;
-	void operator()(FunctionCall const& _funCall) override;
+	using StaticASTWalker::operator();
+	void operator()(Identifier const& _identifier);
+	void operator()(FunctionCall const& _funCall);
 
 	static std::map<YulString, size_t> countReferences(Block const& _block);
 	static std::map<YulString, size_t> countReferences(FunctionDefinition const& _function);
@@ -86,11 +87,11 @@ private:
 /**
  * Specific AST walker that counts all references to all variable declarations.
  */
-class VariableReferencesCounter: public ASTWalker
+class VariableReferencesCounter: public StaticASTWalker<VariableReferencesCounter>
 {
 public:
-	using ASTWalker::operator ();
-	void operator()(Identifier const& _identifier) override;
+	using StaticASTWalker::operator();
+	void operator()(Identifier const& _identifier);
 
 	static std::map<YulString, size_t> countReferences(Block const& _block);
 	static std::map<YulString, size_t> countReferences(FunctionDefinition const& _function);
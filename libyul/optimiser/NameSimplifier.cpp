@@ -30,6 +30,20 @@
 using namespace solidity::yul;
 using namespace std;
 
+void NameSimplifier::run(OptimiserStepContext& _context, Block& _ast)
+{
+	NameSimplifier simplifier{_context, _ast};
+	simplifier(_ast);
+
+	if (_context.functionExecutionCounts)
+	{
+		map<YulString, size_t> executionCounts;
+		for (auto const& [function, executionCount]: *_context.functionExecutionCounts)
+			executionCounts[util::valueOrDefault(simplifier.m_translations, function, function)] = executionCount;
+		*_context.functionExecutionCounts = std::move(executionCounts);
+	}
+}
+
 NameSimplifier::NameSimplifier(OptimiserStepContext& _context, Block const& _ast):
 	m_context(_context)
 {
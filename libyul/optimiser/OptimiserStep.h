@@ -20,6 +20,7 @@
 
 #include <libyul/Exceptions.h>
 
+#include <map>
 #include <optional>
 #include <string>
 #include <set>
@@ -31,6 +32,7 @@ struct Dialect;
 struct Block;
 class YulString;
 class NameDispenser;
+struct OptimiserProfile;
 
 struct OptimiserStepContext
 {
@@ -39,6 +41,11 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// If not null, steps can record additional statistics about their runs here.
+	OptimiserProfile* profile = nullptr;
+	/// If not null and not empty, the execution counts of the functions in a profile of
+	/// real workloads. Functions that are not listed have not been executed.
+	std::map<YulString, size_t>* functionExecutionCounts = nullptr;
 };
 
 
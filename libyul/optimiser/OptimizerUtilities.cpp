@@ -21,10 +21,13 @@
 
 #include <libyul/optimiser/OptimizerUtilities.h>
 
+#include <libyul/optimiser/SimplificationRules.h>
+
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libyul/Dialect.h>
 #include <libyul/AST.h>
+#include <libyul/Utilities.h>
 
 #include <liblangutil/Token.h>
 #include <libsolutil/CommonData.h>
@@ -65,6 +68,34 @@ langutil::EVMVersion const yul::evmVersionFromDialect(Dialect const& _dialect)
 	return langutil::EVMVersion();
 }
 
+optional<u256> yul::evaluateBuiltinCall(
+	Dialect const& _dialect,
+	YulString _builtin,
+	vector<u256> const& _arguments
+)
+{
+	FunctionCall call{nullptr, Identifier{nullptr, _builtin}, {}};
+	for (u256 const& argument: _arguments)
+		call.arguments.emplace_back(Literal{nullptr, LiteralKind::Number, YulString{formatNumber(argument)}, {}});
+	Expression expression = std::move(call);
+	// Rules that do not fold the constants directly turn the expression into other operations,
+	// which have to be simplified further.
+	for (size_t i = 0; i < 8 && !holds_alternative<Literal>(expression); ++i)
+	{
+		auto const* rule = SimplificationRules::findFirstMatch(
+			expression,
+			_dialect,
+			[](YulString) -> AssignedValue const* { return nullptr; }
+		);
+		if (!rule)
+			break;
+		expression = rule->action().toExpression(nullptr, evmVersionFromDialect(_dialect));
+	}
+	if (Literal const* literal = get_if<Literal>(&expression))
+		return valueOfLiteral(*literal);
+	return nullopt;
+}
+
 void StatementRemover::operator()(Block& _block)
 {
 	util::iterateReplacing(
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libsolutil/Common.h>
+#include <libsolutil/Numeric.h>
 #include <libyul/ASTForward.h>
 #include <libyul/Dialect.h>
 #include <libyul/YulString.h>
@@ -29,6 +30,7 @@
 #include <liblangutil/EVMVersion.h>
 
 #include <optional>
+#include <vector>
 
 namespace solidity::evmasm
 {
@@ -54,6 +56,14 @@ std::optional<evmasm::Instruction> toEVMInstruction(Dialect const& _dialect, Yul
 /// It returns the default EVM version if dialect is not an EVMDialect.
 langutil::EVMVersion const evmVersionFromDialect(Dialect const& _dialect);
 
+/// @returns the result of a call to the builtin @a _builtin with the constant arguments
+/// @a _arguments, if the simplification rules can compute it, and nullopt otherwise.
+std::optional<u256> evaluateBuiltinCall(
+	Dialect const& _dialect,
+	YulString _builtin,
+	std::vector<u256> const& _arguments
+);
+
 class StatementRemover: public ASTModifier
 {
 public:
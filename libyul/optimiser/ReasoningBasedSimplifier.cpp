@@ -20,6 +20,7 @@
 
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/Suite.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
 
@@ -42,7 +43,17 @@ using namespace solidity::smtutil;
 void ReasoningBasedSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	ReasoningBasedSimplifier{_context.dialect, ssaVars}(_ast);
+	ReasoningBasedSimplifier simplifier{_context.dialect, ssaVars};
+	simplifier(_ast);
+
+	if (_context.profile)
+	{
+		map<string, size_t>& counters = _context.profile->steps[name].counters;
+		counters["queries"] += simplifier.m_statistics.queries;
+		counters["unknownResults"] += simplifier.m_statistics.unknownResults;
+		counters["simplifiedConditions"] += simplifier.m_statistics.simplifiedConditions;
+		counters["skippedConditions"] += simplifier.m_statistics.skippedConditions;
+	}
 }
 
 std::optional<string> ReasoningBasedSimplifier::invalidInCurrentEnvironment()
@@ -63,33 +74,30 @@ void ReasoningBasedSimplifier::operator()(If& _if)
 {
 	if (!SideEffectsCollector{m_dialect, *_if.condition}.movable())
 		return;
+	// Each condition needs up to two queries.
+	if (m_statistics.queries + 2 > MaxQueries)
+	{
+		++m_statistics.skippedConditions;
+		return;
+	}
 
 	smtutil::Expression condition = encodeExpression(*_if.condition);
-	m_solver->push();
-	m_solver->addAssertion(condition == constantValue(0));
-	CheckResult result = m_solver->check({}).first;
-	m_solver->pop();
-	if (result == CheckResult::UNSATISFIABLE)
+	if (unsatisfiable(condition == constantValue(0)))
 	{
+		++m_statistics.simplifiedConditions;
 		Literal trueCondition = m_dialect.trueLiteral();
 		trueCondition.debugData = debugDataOf(*_if.condition);
 		_if.condition = make_unique<yul::Expression>(std::move(trueCondition));
 	}
-	else
+	else if (unsatisfiable(condition != constantValue(0)))
 	{
-		m_solver->push();
-		m_solver->addAssertion(condition != constantValue(0));
-		CheckResult result2 = m_solver->check({}).first;
-		m_solver->pop();
-		if (result2 == CheckResult::UNSATISFIABLE)
-		{
-			Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
-			falseCondition.debugData = debugDataOf(*_if.condition);
-			_if.condition = make_unique<yul::Expression>(std::move(falseCondition));
-			_if.body = yul::Block{};
-			// Nothing left to be done.
-			return;
-		}
+		++m_statistics.simplifiedConditions;
+		Literal falseCondition = m_dialect.zeroLiteralForType(m_dialect.boolType);
+		falseCondition.debugData = debugDataOf(*_if.condition);
+		_if.condition = make_unique<yul::Expression>(std::move(falseCondition));
+		_if.body = yul::Block{};
+		// Nothing left to be done.
+		return;
 	}
 
 	m_solver->push();
@@ -109,6 +117,18 @@ ReasoningBasedSimplifier::ReasoningBasedSimplifier(
 {
 }
 
+bool ReasoningBasedSimplifier::unsatisfiable(smtutil::Expression const& _assertion)
+{
+	++m_statistics.queries;
+	m_solver->push();
+	m_solver->addAssertion(_assertion);
+	CheckResult result = m_solver->check({}).first;
+	m_solver->pop();
+	if (result != CheckResult::SATISFIABLE && result != CheckResult::UNSATISFIABLE)
+		++m_statistics.unknownResults;
+	return result == CheckResult::UNSATISFIABLE;
+}
+
 
 smtutil::Expression ReasoningBasedSimplifier::encodeEVMBuiltin(
 	evmasm::Instruction _instruction,
@@ -45,12 +45,20 @@ namespace solidity::yul
  *
  * It is only effective on the EVM dialect, but safe to use on other dialects.
  *
+ * The cost of the step is bounded: Every query runs with the deterministic resource limit
+ * of the solver and at most MaxQueries queries are made per run. Conditions encountered
+ * after the budget is used up are left unchanged. The number of queries and their
+ * results are recorded in the optimiser profile.
+ *
  * Prerequisite: Disambiguator, SSATransform.
  */
 class ReasoningBasedSimplifier: public ASTModifier, SMTSolver
 {
 public:
 	static constexpr char const* name{"ReasoningBasedSimplifier"};
+	/// Maximum number of solver queries per run of the step.
+	static constexpr size_t MaxQueries = 1000;
+
 	static void run(OptimiserStepContext& _context, Block& _ast);
 	static std::optional<std::string> invalidInCurrentEnvironment();
 
@@ -59,17 +67,30 @@ public:
 	void operator()(If& _if) override;
 
 private:
+	struct Statistics
+	{
+		size_t queries = 0;
+		size_t unknownResults = 0;
+		size_t simplifiedConditions = 0;
+		size_t skippedConditions = 0;
+	};
+
 	explicit ReasoningBasedSimplifier(
 		Dialect const& _dialect,
 		std::set<YulString> const& _ssaVariables
 	);
 
+	/// @returns true if @a _assertion is unsatisfiable together with the current constraints.
+	/// Unknown results and solver errors count as satisfiable.
+	bool unsatisfiable(smtutil::Expression const& _assertion);
+
 	smtutil::Expression encodeEVMBuiltin(
 		evmasm::Instruction _instruction,
 		std::vector<Expression> const& _arguments
 	) override;
 
 	Dialect const& m_dialect;
+	Statistics m_statistics;
 };
 
 }
@@ -22,6 +22,9 @@
 #include <libyul/optimiser/Semantics.h>
 
 #include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/Utilities.h>
 #include <libyul/Exceptions.h>
 #include <libyul/AST.h>
 #include <libyul/Dialect.h>
@@ -32,6 +35,7 @@
 #include <libsolutil/Algorithms.h>
 
 #include <limits>
+#include <list>
 
 using namespace std;
 using namespace solidity;
@@ -123,32 +127,155 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 		ret[function].cannotLoop = false;
 	}
 
+	// The side effects of a function are those of its own code and of all functions it calls.
+	// Compute them as a fixed point, re-evaluating only the callers of functions that changed.
+	map<YulString, set<YulString>> callers;
+	for (auto const& [function, callees]: _directCallGraph.functionCalls)
+		for (YulString callee: callees)
+			if (!_dialect.builtin(callee))
+				callers[callee].insert(function);
+
+	list<YulString> pending;
+	set<YulString> pendingSet;
 	for (auto const& call: _directCallGraph.functionCalls)
 	{
-		YulString funName = call.first;
-		SideEffects sideEffects;
-		auto _visit = [&, visited = std::set<YulString>{}](YulString _function, auto&& _recurse) mutable {
-			if (!visited.insert(_function).second)
+		pending.emplace_back(call.first);
+		pendingSet.insert(call.first);
+	}
+	while (!pending.empty())
+	{
+		YulString function = pending.front();
+		pending.pop_front();
+		pendingSet.erase(function);
+
+		SideEffects sideEffects = ret[function];
+		for (YulString callee: _directCallGraph.functionCalls.at(function))
+			if (BuiltinFunction const* f = _dialect.builtin(callee))
+				sideEffects += f->sideEffects;
+			else if (SideEffects const* calleeSideEffects = util::valueOrNullptr(ret, callee))
+				sideEffects += *calleeSideEffects;
+		if (sideEffects == ret[function])
+			continue;
+		ret[function] = sideEffects;
+		if (set<YulString> const* functionCallers = util::valueOrNullptr(callers, function))
+			for (YulString caller: *functionCallers)
+				if (pendingSet.insert(caller).second)
+					pending.emplace_back(caller);
+	}
+	return ret;
+}
+
+namespace
+{
+
+/// Determines the storage slots the code of a function writes to directly, ignoring the functions it calls.
+class DirectStorageWritesCollector: public ASTWalker
+{
+public:
+	DirectStorageWritesCollector(Dialect const& _dialect, map<YulString, Expression const*> const& _ssaValues):
+		m_dialect(_dialect), m_ssaValues(_ssaValues)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name);
+		if (!m_storageWrites || !builtin || builtin->sideEffects.storage != SideEffects::Write)
+			return;
+
+		BuiltinFunction const* storeFunction = m_dialect.storageStoreFunction({});
+		if (storeFunction && builtin->name == storeFunction->name)
+			if (optional<u256> slot = constantValue(_functionCall.arguments.front()))
+			{
+				m_storageWrites->insert(*slot);
 				return;
-			if (sideEffects == SideEffects::worst())
+			}
+		m_storageWrites.reset();
+	}
+	void operator()(FunctionDefinition const&) override {}
+
+	StorageWrites const& storageWrites() const { return m_storageWrites; }
+
+private:
+	optional<u256> constantValue(Expression const& _expression) const
+	{
+		Expression const* expression = &_expression;
+		if (Identifier const* identifier = get_if<Identifier>(expression))
+			if (Expression const* const* value = util::valueOrNullptr(m_ssaValues, identifier->name))
+				expression = *value;
+		if (expression)
+			if (Literal const* literal = get_if<Literal>(expression))
+				return valueOfLiteral(*literal);
+		return nullopt;
+	}
+
+	Dialect const& m_dialect;
+	map<YulString, Expression const*> const& m_ssaValues;
+	StorageWrites m_storageWrites = set<u256>{};
+};
+
+}
+
+map<YulString, StorageWrites> StorageWritesPropagator::storageWrites(
+	Dialect const& _dialect,
+	Block const& _ast,
+	CallGraph const& _directCallGraph
+)
+{
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+
+	map<YulString, StorageWrites> directWrites;
+	for (auto const& [name, function]: allFunctionDefinitions(_ast))
+	{
+		DirectStorageWritesCollector collector{_dialect, ssaValues.values()};
+		collector(function->body);
+		directWrites[name] = collector.storageWrites();
+	}
+
+	map<YulString, StorageWrites> ret;
+	for (auto const& [name, directWrite]: directWrites)
+	{
+		StorageWrites writes = set<u256>{};
+		auto _visit = [&, visited = std::set<YulString>{}](YulString _function, auto&& _recurse) mutable {
+			if (!writes || !visited.insert(_function).second || _dialect.builtin(_function))
 				return;
-			if (BuiltinFunction const* f = _dialect.builtin(_function))
-				sideEffects += f->sideEffects;
-			else
+			StorageWrites const* functionWrites = util::valueOrNullptr(directWrites, _function);
+			if (!functionWrites || !*functionWrites || !_directCallGraph.functionCalls.count(_function))
 			{
-				if (ret.count(_function))
-					sideEffects += ret[_function];
-				for (YulString callee: _directCallGraph.functionCalls.at(_function))
-					_recurse(callee, _recurse);
+				writes.reset();
+				return;
 			}
+			*writes += **functionWrites;
+			for (YulString callee: _directCallGraph.functionCalls.at(_function))
+				_recurse(callee, _recurse);
 		};
-		for (auto const& _v: call.second)
-			_visit(_v, _visit);
-		ret[funName] += sideEffects;
+		_visit(name, _visit);
+		ret[name] = std::move(writes);
 	}
 	return ret;
 }
 
+void StorageWritesCollector::operator()(FunctionCall const& _functionCall)
+{
+	ASTWalker::operator()(_functionCall);
+	if (!m_storageWrites)
+		return;
+	if (BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name))
+	{
+		if (builtin->sideEffects.storage == SideEffects::Write)
+			m_storageWrites.reset();
+	}
+	else if (
+		StorageWrites const* functionWrites = util::valueOrNullptr(m_functionStorageWrites, _functionCall.functionName.name);
+		functionWrites && *functionWrites
+	)
+		*m_storageWrites += **functionWrites;
+	else
+		m_storageWrites.reset();
+}
+
 MovableChecker::MovableChecker(Dialect const& _dialect, Expression const& _expression):
 	MovableChecker(_dialect)
 {
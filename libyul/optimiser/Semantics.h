@@ -26,6 +26,10 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/AST.h>
 
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <optional>
 #include <set>
 
 namespace solidity::yul
@@ -130,6 +134,53 @@ public:
 	);
 };
 
+/// Storage slots some code can write to. Set to ``std::nullopt`` if they are not all known.
+using StorageWrites = std::optional<std::set<u256>>;
+
+/**
+ * This class can be used to determine the storage slots user-defined functions can write to,
+ * directly or through the functions they call.
+ *
+ * The slots of a function are known if all of its ``sstore`` calls use a literal slot
+ * or a variable that is only ever assigned a literal, it does not call other builtins that
+ * write to storage and the slots of all functions it calls are known.
+ */
+class StorageWritesPropagator
+{
+public:
+	static std::map<YulString, StorageWrites> storageWrites(
+		Dialect const& _dialect,
+		Block const& _ast,
+		CallGraph const& _directCallGraph
+	);
+};
+
+/**
+ * Determines the storage slots some code can write to through calls to user-defined functions.
+ * Calls to builtins that write to storage and to functions without known slots make the
+ * slots unknown.
+ * Does not enter into function definitions.
+ */
+class StorageWritesCollector: public ASTWalker
+{
+public:
+	StorageWritesCollector(
+		Dialect const& _dialect,
+		std::map<YulString, StorageWrites> const& _functionStorageWrites
+	): m_dialect(_dialect), m_functionStorageWrites(_functionStorageWrites) {}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override;
+	void operator()(FunctionDefinition const&) override {}
+
+	StorageWrites const& storageWrites() const { return m_storageWrites; }
+
+private:
+	Dialect const& m_dialect;
+	std::map<YulString, StorageWrites> const& m_functionStorageWrites;
+	StorageWrites m_storageWrites = std::set<u256>{};
+};
+
 /**
  * Class that can be used to find out if certain code contains the MSize instruction
  * or a verbatim bytecode builtin (which is always assumed that it could contain MSize).
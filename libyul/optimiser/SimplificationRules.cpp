@@ -48,7 +48,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules keep the state of the current match, so every thread needs its own copy.
+	thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -129,8 +130,9 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, initializer_list<Pattern
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups& _matchGroups)
 {
+	assertThrow(_group > 0 && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -161,7 +163,7 @@ bool Pattern::matches(
 		Literal const& literal = std::get<Literal>(*expr);
 		if (literal.kind != LiteralKind::Number)
 			return false;
-		if (m_data && *m_data != u256(literal.value.str()))
+		if (m_data && *m_data != valueOfNumberLiteral(literal))
 			return false;
 		assertThrow(m_arguments.empty(), OptimizerException, "");
 	}
@@ -203,11 +205,11 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		Expression const*& match = (*m_matchGroups)[m_matchGroup];
+		if (match)
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
-			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
+			Expression const* firstMatch = match;
 			assertThrow(
 				!holds_alternative<FunctionCall>(_expr) &&
 				!holds_alternative<FunctionCall>(*firstMatch),
@@ -218,12 +220,12 @@ bool Pattern::matches(
 			return SyntacticallyEqual{}(*firstMatch, _expr);
 		}
 		else if (m_kind == PatternKind::Any)
-			(*m_matchGroups)[m_matchGroup] = &_expr;
+			match = &_expr;
 		else
 		{
 			assertThrow(m_kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
 			// We do not use _expr here, because we want the actual number.
-			(*m_matchGroups)[m_matchGroup] = expr;
+			match = expr;
 		}
 	}
 	return true;
@@ -260,6 +262,23 @@ Expression Pattern::toExpression(shared_ptr<DebugData const> const& _debugData,
 	assertThrow(false, OptimizerException, "Pattern of kind 'any', but no match group.");
 }
 
+string Pattern::toString() const
+{
+	// Patterns of the rule list are shown with the names they have there, e.g. "ADD(X, 0)".
+	if (m_matchGroup && m_arguments.empty())
+		return string(1, evmasm::matchGroupName(m_matchGroup));
+	if (m_kind == PatternKind::Constant)
+		return m_data ? formatNumber(*m_data) : "CONSTANT";
+	else if (m_kind == PatternKind::Operation)
+	{
+		string result = instructionInfo(m_instruction, EVMVersion()).name + "(";
+		for (size_t i = 0; i < m_arguments.size(); ++i)
+			result += (i > 0 ? ", " : "") + m_arguments[i].toString();
+		return result + ")";
+	}
+	return "ANY";
+}
+
 u256 Pattern::d() const
 {
 	return valueOfNumberLiteral(std::get<Literal>(matchGroupValue()));
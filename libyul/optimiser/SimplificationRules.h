@@ -32,6 +32,7 @@
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -42,6 +43,10 @@ struct Dialect;
 struct AssignedValue;
 class Pattern;
 
+/// Expressions bound to the match groups of a rule, indexed by the match group number.
+/// Match group zero means "no match group" and is unused.
+using MatchGroups = std::array<Expression const*, 8>;
+
 /**
  * Container for all simplification rules.
  */
@@ -76,9 +81,9 @@ private:
 	void addRules(std::vector<Rule> const& _rules);
 	void addRule(Rule const& _rule);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
+	MatchGroups m_matchGroups{};
 	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
 };
 
@@ -114,7 +119,7 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
@@ -133,6 +138,9 @@ public:
 	/// for patterns resulting from an action, i.e. with match groups assigned.
 	Expression toExpression(std::shared_ptr<DebugData const> const& _debugData, langutil::EVMVersion _evmVersion) const;
 
+	/// @returns the pattern in the syntax of the rule list, e.g. "ADD(X, 0)".
+	std::string toString() const;
+
 private:
 	Expression const& matchGroupValue() const;
 
@@ -141,7 +149,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups* m_matchGroups = nullptr;
 };
 
 }
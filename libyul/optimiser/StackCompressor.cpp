@@ -27,7 +27,8 @@
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/Semantics.h>
 
-#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/StackAnalysisCache.h>
 #include <libyul/backends/evm/StackHelpers.h>
 #include <libyul/backends/evm/StackLayoutGenerator.h>
 
@@ -39,6 +40,7 @@
 #include <libyul/AST.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Visitor.h>
 
 using namespace std;
 using namespace solidity;
@@ -182,7 +184,8 @@ void eliminateVariables(
 	UnusedPruner::runUntilStabilised(_dialect, _ast, _allowMSizeOptimization, nullptr, allFunctions);
 }
 
-void eliminateVariablesOptimizedCodegen(
+/// @returns false if there are no stack too deep errors and the code was not modified.
+bool eliminateVariablesOptimizedCodegen(
 	Dialect const& _dialect,
 	Block& _ast,
 	map<YulString, vector<StackLayoutGenerator::StackTooDeep>> const& _unreachables,
@@ -190,7 +193,7 @@ void eliminateVariablesOptimizedCodegen(
 )
 {
 	if (std::all_of(_unreachables.begin(), _unreachables.end(), [](auto const& _item) { return _item.second.empty(); }))
-		return;
+		return false;
 
 	RematCandidateSelector selector{_dialect};
 	selector(_ast);
@@ -232,15 +235,150 @@ void eliminateVariablesOptimizedCodegen(
 	// Do not remove functions.
 	set<YulString> allFunctions = NameCollector{_ast, NameCollector::OnlyFunctions}.names();
 	UnusedPruner::runUntilStabilised(_dialect, _ast, _allowMSizeOptimization, nullptr, allFunctions);
+	return true;
 }
 
+/**
+ * Computes an upper bound on the stack height within the main code and each function as
+ * generated by the EVM code transform, counting from the start of the respective stack frame.
+ * The code transform only needs to reach variables inside the current frame, so if the bound
+ * does not exceed 16, no variable is too deep in the stack.
+ *
+ * Prerequisite: Disambiguator
+ */
+class StackHeightBound
+{
+public:
+	/// @returns the bound for the whole code or nullopt if it could not be determined.
+	static optional<size_t> run(Dialect const& _dialect, Block const& _ast)
+	{
+		StackHeightBound bound{_dialect, allFunctionDefinitions(_ast)};
+		bound.visitBlock(_ast, 0);
+		if (bound.m_failed)
+			return nullopt;
+		return bound.m_maximum;
+	}
+
+private:
+	StackHeightBound(Dialect const& _dialect, map<YulString, FunctionDefinition const*> _functions):
+		m_dialect(_dialect),
+		m_functions(std::move(_functions))
+	{}
+
+	/// Visits the statements at stack height @a _height and @returns the height after them,
+	/// including the variables they declare.
+	size_t visitStatements(vector<Statement> const& _statements, size_t _height)
+	{
+		for (Statement const& statement: _statements)
+			_height = visit(statement, _height);
+		return _height;
+	}
+
+	void visitBlock(Block const& _block, size_t _height)
+	{
+		visitStatements(_block.statements, _height);
+	}
+
+	/// Visits @a _statement at stack height @a _height and @returns the height after it.
+	size_t visit(Statement const& _statement, size_t _height)
+	{
+		return std::visit(util::GenericVisitor{
+			[&](ExpressionStatement const& _expressionStatement) {
+				update(_height + expressionHeight(_expressionStatement.expression));
+				return _height;
+			},
+			[&](Assignment const& _assignment) {
+				update(_height + expressionHeight(*_assignment.value));
+				return _height;
+			},
+			[&](VariableDeclaration const& _declaration) {
+				size_t variables = _declaration.variables.size();
+				update(_height + (_declaration.value ? max(variables, expressionHeight(*_declaration.value)) : variables));
+				return _height + variables;
+			},
+			[&](If const& _if) {
+				update(_height + expressionHeight(*_if.condition));
+				visitBlock(_if.body, _height);
+				return _height;
+			},
+			[&](Switch const& _switch) {
+				update(_height + expressionHeight(*_switch.expression));
+				// The value of the expression, the value of a case and a copy of the former for the comparison.
+				update(_height + 3);
+				for (Case const& switchCase: _switch.cases)
+					visitBlock(switchCase.body, _height + 1);
+				return _height;
+			},
+			[&](ForLoop const& _loop) {
+				size_t height = visitStatements(_loop.pre.statements, _height);
+				update(height + expressionHeight(*_loop.condition));
+				visitBlock(_loop.body, height);
+				visitBlock(_loop.post, height);
+				return _height;
+			},
+			[&](FunctionDefinition const& _function) {
+				// The return label, the arguments and the return variables form a new stack frame.
+				visitBlock(_function.body, 1 + _function.parameters.size() + _function.returnVariables.size());
+				return _height;
+			},
+			[&](Block const& _block) {
+				visitBlock(_block, _height);
+				return _height;
+			},
+			[&](auto const&) { return _height; }
+		}, _statement);
+	}
+
+	/// @returns the maximum number of stack slots used while evaluating @a _expression,
+	/// which is at least the number of its values.
+	size_t expressionHeight(Expression const& _expression)
+	{
+		FunctionCall const* call = get_if<FunctionCall>(&_expression);
+		if (!call)
+			return 1;
+
+		size_t pushed = 0;
+		size_t returns = 0;
+		BuiltinFunction const* builtin = m_dialect.builtin(call->functionName.name);
+		if (builtin)
+			returns = builtin->returns.size();
+		else if (FunctionDefinition const* function = util::valueOrDefault(m_functions, call->functionName.name, nullptr))
+		{
+			// The return label.
+			pushed = 1;
+			returns = function->returnVariables.size();
+		}
+		else
+			m_failed = true;
+
+		size_t maximum = pushed;
+		// The arguments are evaluated from the last to the first.
+		for (size_t index = call->arguments.size(); index > 0; --index)
+		{
+			if (builtin && builtin->literalArgument(index - 1))
+				continue;
+			maximum = max(maximum, pushed + expressionHeight(call->arguments[index - 1]));
+			++pushed;
+		}
+		return max(maximum, returns);
+	}
+
+	void update(size_t _height) { m_maximum = max(m_maximum, _height); }
+
+	Dialect const& m_dialect;
+	map<YulString, FunctionDefinition const*> m_functions;
+	size_t m_maximum = 0;
+	bool m_failed = false;
+};
+
 }
 
 bool StackCompressor::run(
 	Dialect const& _dialect,
 	Object& _object,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations
+	size_t _maxIterations,
+	StackAnalysisCache* _stackAnalysis
 )
 {
 	yulAssert(
@@ -248,25 +386,34 @@ bool StackCompressor::run(
 		_object.code->statements.size() > 0 && holds_alternative<Block>(_object.code->statements.at(0)),
 		"Need to run the function grouper before the stack compressor."
 	);
-	bool usesOptimizedCodeGenerator = false;
-	if (auto evmDialect = dynamic_cast<EVMDialect const*>(&_dialect))
-		usesOptimizedCodeGenerator =
-			_optimizeStackAllocation &&
-			evmDialect->evmVersion().canOverchargeGasForCall() &&
-			evmDialect->providesObjectAccess();
+	auto evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
+	bool usesOptimizedCodeGenerator =
+		evmDialect &&
+		_optimizeStackAllocation &&
+		evmDialect->evmVersion().canOverchargeGasForCall() &&
+		evmDialect->providesObjectAccess();
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
 	if (usesOptimizedCodeGenerator)
 	{
-		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
-		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, _dialect, *_object.code);
-		eliminateVariablesOptimizedCodegen(
+		optional<StackAnalysisCache> localStackAnalysis;
+		if (!_stackAnalysis)
+			_stackAnalysis = &localStackAnalysis.emplace(*evmDialect, _object);
+		if (eliminateVariablesOptimizedCodegen(
 			_dialect,
 			*_object.code,
-			StackLayoutGenerator::reportStackTooDeep(*cfg),
+			_stackAnalysis->stackTooDeepErrors(),
 			allowMSizeOptimzation
-		);
+		))
+			_stackAnalysis->invalidate();
 	}
 	else
+	{
+		// Skip the code generation of the compilability checker if the stack cannot get too deep.
+		if (evmDialect)
+			if (optional<size_t> stackHeight = StackHeightBound::run(_dialect, *_object.code))
+				if (*stackHeight <= 16)
+					return true;
+
 		for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 		{
 			map<YulString, int> stackSurplus = CompilabilityChecker(_dialect, _object, _optimizeStackAllocation).stackDeficit;
@@ -279,6 +426,7 @@ bool StackCompressor::run(
 				allowMSizeOptimzation
 			);
 		}
+	}
 	return false;
 }
 
@@ -32,6 +32,7 @@ namespace solidity::yul
 struct Dialect;
 struct Object;
 struct FunctionDefinition;
+class StackAnalysisCache;
 
 /**
  * Optimisation stage that aggressively rematerializes certain variables in a function to free
@@ -45,12 +46,15 @@ class StackCompressor
 {
 public:
 	/// Try to remove local variables until the AST is compilable.
+	/// If @a _stackAnalysis is given, it is used to determine the stack too deep errors for the
+	/// optimized code generator and invalidated if the code is modified.
 	/// @returns true if it was successful.
 	static bool run(
 		Dialect const& _dialect,
 		Object& _object,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		StackAnalysisCache* _stackAnalysis = nullptr
 	);
 };
 
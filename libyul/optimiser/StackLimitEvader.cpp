@@ -16,14 +16,14 @@
 */
 
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/StackToMemoryMover.h>
-#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
 #include <libyul/backends/evm/EVMDialect.h>
-#include <libyul/AsmAnalysis.h>
+#include <libyul/backends/evm/StackAnalysisCache.h>
 #include <libyul/AST.h>
 #include <libyul/CompilabilityChecker.h>
 #include <libyul/Exceptions.h>
@@ -36,12 +36,88 @@
 #include <range/v3/view/concat.hpp>
 #include <range/v3/view/take.hpp>
 
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Determines the ranges in which the variables of a function are live, as intervals of positions
+ * in the order of evaluation. A variable is live from its declaration to its last reference. If a
+ * reference is inside a loop that does not contain the declaration, the range extends to the end
+ * of that loop, since the variable is still needed in the next iteration. Parameters are live from
+ * the start and return variables until the end of the function.
+ * Nested function definitions are skipped.
+ */
+class LiveRangeCollector: public ASTWalker
+{
+public:
+	static map<YulString, pair<uint64_t, uint64_t>> run(Block const& _body, FunctionDefinition const* _function)
+	{
+		LiveRangeCollector collector;
+		if (_function)
+			for (TypedName const& parameter: _function->parameters)
+				collector.m_ranges[parameter.name] = {0, 0};
+		collector(_body);
+		if (_function)
+			for (TypedName const& returnVariable: _function->returnVariables)
+				collector.m_ranges[returnVariable.name] = {0, ++collector.m_position};
+		return std::move(collector.m_ranges);
+	}
+
+	using ASTWalker::operator();
+	void operator()(FunctionDefinition const&) override {}
+	void operator()(Identifier const& _identifier) override { reference(_identifier.name); }
+	void operator()(Assignment const& _assignment) override
+	{
+		visit(*_assignment.value);
+		++m_position;
+		for (Identifier const& variable: _assignment.variableNames)
+			reference(variable.name);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		ASTWalker::operator()(_varDecl);
+		++m_position;
+		for (TypedName const& variable: _varDecl.variables)
+			m_ranges[variable.name] = {m_position, m_position};
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		(*this)(_loop.pre);
+		m_loops.push_back({++m_position, {}});
+		visit(*_loop.condition);
+		(*this)(_loop.body);
+		(*this)(_loop.post);
+		auto [start, referencedVariables] = std::move(m_loops.back());
+		m_loops.pop_back();
+		uint64_t end = ++m_position;
+		for (YulString variable: referencedVariables)
+			if (auto* range = util::valueOrNullptr(m_ranges, variable); range && range->first < start)
+				range->second = end;
+		if (!m_loops.empty())
+			m_loops.back().second += referencedVariables;
+	}
+
+private:
+	void reference(YulString _variable)
+	{
+		if (auto* range = util::valueOrNullptr(m_ranges, _variable))
+			range->second = ++m_position;
+		if (!m_loops.empty())
+			m_loops.back().second.insert(_variable);
+	}
+
+	uint64_t m_position = 0;
+	map<YulString, pair<uint64_t, uint64_t>> m_ranges;
+	/// Start positions of the enclosing loops and the variables referenced in them.
+	vector<pair<uint64_t, set<YulString>>> m_loops;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -52,8 +128,9 @@ namespace
  * - Determine the maximum value ``n`` of the values of ``slotsRequiredForFunction`` among the children.
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
- * - If not, assign each variable its slot starting from ``n`` (incrementing it).
- * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
+ * - If not, assign each variable the lowest slot starting from ``n`` that is not used by another
+ *   variable of the function whose live range overlaps with its own.
+ * - Assign ``n`` plus the number of slots used by the function to ``slotsRequiredForFunction`` of the function.
  */
 struct MemoryOffsetAllocator
 {
@@ -72,7 +149,9 @@ struct MemoryOffsetAllocator
 
 		if (auto const* unreachables = util::valueOrNullptr(unreachableVariables, _function))
 		{
-			if (FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy))
+			vector<YulString> variables;
+			FunctionDefinition const* functionDefinition = util::valueOrDefault(functionDefinitions, _function, nullptr, util::allow_copy);
+			if (functionDefinition)
 				if (
 					size_t totalArgCount = functionDefinition->returnVariables.size() + functionDefinition->parameters.size();
 					totalArgCount > 16
@@ -81,20 +160,58 @@ struct MemoryOffsetAllocator
 						functionDefinition->parameters,
 						functionDefinition->returnVariables
 					) | ranges::views::take(totalArgCount - 16))
-						slotAllocations[var.name] = requiredSlots++;
+						variables.emplace_back(var.name);
 
 			// Assign slots for all variables that become unreachable in the function body, if the above did not
 			// assign a slot for them already.
 			for (YulString variable: *unreachables)
 				// The empty case is a function with too many arguments or return values,
 				// which was already handled above.
-				if (!variable.empty() && !slotAllocations.count(variable))
-					slotAllocations[variable] = requiredSlots++;
+				if (!variable.empty() && !util::contains(variables, variable))
+					variables.emplace_back(variable);
+
+			requiredSlots += assignSlots(
+				variables,
+				LiveRangeCollector::run(functionDefinition ? functionDefinition->body : mainBlock, functionDefinition),
+				requiredSlots
+			);
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
 	}
 
+	/// Assigns each of @a _variables, in order, the lowest slot starting from @a _firstSlot
+	/// that is not used by a variable with an overlapping live range.
+	/// Variables without a known live range are assumed to be live everywhere.
+	/// @returns the number of slots used.
+	uint64_t assignSlots(
+		vector<YulString> const& _variables,
+		map<YulString, pair<uint64_t, uint64_t>> const& _liveRanges,
+		uint64_t _firstSlot
+	)
+	{
+		auto liveRange = [&](YulString _variable) {
+			return util::valueOrDefault(_liveRanges, _variable, make_pair(uint64_t(0), numeric_limits<uint64_t>::max()), util::allow_copy);
+		};
+		vector<vector<YulString>> slots;
+		for (YulString variable: _variables)
+		{
+			pair<uint64_t, uint64_t> range = liveRange(variable);
+			size_t slot = 0;
+			for (; slot < slots.size(); ++slot)
+				if (none_of(slots[slot].begin(), slots[slot].end(), [&](YulString _other) {
+					pair<uint64_t, uint64_t> otherRange = liveRange(_other);
+					return range.first <= otherRange.second && otherRange.first <= range.second;
+				}))
+					break;
+			if (slot == slots.size())
+				slots.emplace_back();
+			slots[slot].emplace_back(variable);
+			slotAllocations[variable] = _firstSlot + slot;
+		}
+		return slots.size();
+	}
+
 	/// Maps function names to the set of unreachable variables in that function.
 	/// An empty variable name means that the function has too many arguments or return variables.
 	map<YulString, set<YulString>> const& unreachableVariables;
@@ -102,6 +219,8 @@ struct MemoryOffsetAllocator
 	map<YulString, set<YulString>> const& callGraph;
 	/// Maps the name of each user-defined function to its definition.
 	map<YulString, FunctionDefinition const*> const& functionDefinitions;
+	/// The code outside of functions.
+	Block const& mainBlock;
 
 	/// Maps variable names to the memory slot the respective variable is assigned.
 	map<YulString, uint64_t> slotAllocations{};
@@ -130,9 +249,8 @@ void StackLimitEvader::run(
 	);
 	if (evmDialect && evmDialect->evmVersion().canOverchargeGasForCall())
 	{
-		yul::AsmAnalysisInfo analysisInfo = yul::AsmAnalyzer::analyzeStrictAssertCorrect(*evmDialect, _object);
-		unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *evmDialect, *_object.code);
-		run(_context, _object, StackLayoutGenerator::reportStackTooDeep(*cfg));
+		StackAnalysisCache stackAnalysis{*evmDialect, _object};
+		run(_context, _object, stackAnalysis);
 	}
 	else
 		run(_context, _object, CompilabilityChecker{
@@ -143,6 +261,17 @@ void StackLimitEvader::run(
 
 }
 
+void StackLimitEvader::run(
+	OptimiserStepContext& _context,
+	Object& _object,
+	StackAnalysisCache& _stackAnalysis
+)
+{
+	run(_context, _object, _stackAnalysis.stackTooDeepErrors());
+	// The code may have been modified.
+	_stackAnalysis.invalidate();
+}
+
 void StackLimitEvader::run(
 	OptimiserStepContext& _context,
 	Object& _object,
@@ -195,7 +324,12 @@ void StackLimitEvader::run(
 
 	map<YulString, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(*_object.code);
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
+	MemoryOffsetAllocator memoryOffsetAllocator{
+		_unreachableVariables,
+		callGraph.functionCalls,
+		functionDefinitions,
+		*_object.code
+	};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 	yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
 
@@ -28,6 +28,7 @@ namespace solidity::yul
 {
 
 struct Object;
+class StackAnalysisCache;
 
 /**
  * Optimisation stage that assigns memory offsets to variables that would become unreachable if
@@ -41,6 +42,7 @@ struct Object;
  *
  * Offsets are assigned to the variables, s.t. on every path through the call graph each variable gets a unique offset
  * in memory. However, distinct paths through the call graph can use the same memory offsets for their variables.
+ * Variables of the same function whose live ranges do not overlap can share an offset as well.
  *
  * The current arguments to the ``memoryguard`` calls are used as base memory offset and then replaced by the offset past
  * the last memory offset used for a variable on any path through the call graph.
@@ -72,6 +74,16 @@ public:
 		Object& _object,
 		std::map<YulString, std::vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors
 	);
+	/// Uses the stack too deep errors determined by @a _stackAnalysis and invalidates it afterwards.
+	/// Can only be run on the EVM dialect with objects and an EVM version that supports the optimized code generator.
+	/// Abort and do nothing, if no ``memoryguard`` call or several ``memoryguard`` calls
+	/// with non-matching arguments are found, or if any of the stack too deep errors
+	/// are contained in a recursive function.
+	static void run(
+		OptimiserStepContext& _context,
+		Object& _object,
+		StackAnalysisCache& _stackAnalysis
+	);
 	/// Determines stack too deep errors using the appropriate code generation backend.
 	/// Can only be run on the EVM dialect with objects.
 	/// Abort and do nothing, if no ``memoryguard`` call or several ``memoryguard`` calls
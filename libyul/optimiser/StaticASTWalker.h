@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Generic AST walker with static dispatch.
+ */
+
+#pragma once
+
+#include <libyul/AST.h>
+
+#include <variant>
+
+namespace solidity::yul
+{
+
+/**
+ * Generic AST walker that visits the nodes in the same order as ASTWalker, but dispatches
+ * statically, so that the traversal can be inlined into the derived class.
+ *
+ * Derived classes pass themselves as @a Derived, declare
+ * ``using StaticASTWalker<Derived>::operator();`` and define the operators for the node types
+ * they are interested in, which hide the ones of this class. They continue the traversal below
+ * a node by calling ``StaticASTWalker::operator()`` explicitly.
+ */
+template <class Derived>
+class StaticASTWalker
+{
+public:
+	void operator()(Literal const&) {}
+	void operator()(Identifier const&) {}
+	void operator()(FunctionCall const& _funCall)
+	{
+		// Does not visit _funCall.functionName on purpose
+		for (auto it = _funCall.arguments.rbegin(); it != _funCall.arguments.rend(); ++it)
+			visit(*it);
+	}
+	void operator()(ExpressionStatement const& _statement)
+	{
+		visit(_statement.expression);
+	}
+	void operator()(Assignment const& _assignment)
+	{
+		for (auto const& name: _assignment.variableNames)
+			derived()(name);
+		visit(*_assignment.value);
+	}
+	void operator()(VariableDeclaration const& _varDecl)
+	{
+		if (_varDecl.value)
+			visit(*_varDecl.value);
+	}
+	void operator()(If const& _if)
+	{
+		visit(*_if.condition);
+		derived()(_if.body);
+	}
+	void operator()(Switch const& _switch)
+	{
+		visit(*_switch.expression);
+		for (auto const& _case: _switch.cases)
+		{
+			if (_case.value)
+				derived()(*_case.value);
+			derived()(_case.body);
+		}
+	}
+	void operator()(FunctionDefinition const& _fun)
+	{
+		derived()(_fun.body);
+	}
+	void operator()(ForLoop const& _for)
+	{
+		derived()(_for.pre);
+		visit(*_for.condition);
+		derived()(_for.body);
+		derived()(_for.post);
+	}
+	void operator()(Break const&) {}
+	void operator()(Continue const&) {}
+	void operator()(Leave const&) {}
+	void operator()(Block const& _block)
+	{
+		for (auto const& statement: _block.statements)
+			visit(statement);
+	}
+
+	void visit(Statement const& _st)
+	{
+		std::visit([this](auto const& _node) { derived()(_node); }, _st);
+	}
+	void visit(Expression const& _e)
+	{
+		std::visit([this](auto const& _node) { derived()(_node); }, _e);
+	}
+
+protected:
+	StaticASTWalker() = default;
+	~StaticASTWalker() = default;
+
+private:
+	Derived& derived() { return static_cast<Derived&>(*this); }
+};
+
+}
@@ -0,0 +1,204 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that combines read-modify-write sequences on the same storage slot.
+ */
+
+#include <libyul/optimiser/StorageWriteCombiner.h>
+
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/SyntacticalEquality.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+
+#include <libsolutil/CommonData.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+/// Variable name that can never appear in actual Yul code.
+YulString const placeholder{"@ value"};
+
+/// Replaces all loads from the given slot by a variable.
+class LoadReplacer: public ASTModifier
+{
+public:
+	LoadReplacer(YulString _loadFunction, Expression const& _slot, YulString _value):
+		m_loadFunction(_loadFunction), m_slot(_slot), m_value(_value)
+	{}
+
+	using ASTModifier::visit;
+	void visit(Expression& _expression) override
+	{
+		if (FunctionCall const* call = get_if<FunctionCall>(&_expression))
+			if (
+				call->functionName.name == m_loadFunction &&
+				call->arguments.size() == 1 &&
+				SyntacticallyEqual{}(call->arguments.front(), m_slot)
+			)
+			{
+				_expression = Identifier{call->debugData, m_value};
+				return;
+			}
+		ASTModifier::visit(_expression);
+	}
+
+private:
+	YulString m_loadFunction;
+	Expression const& m_slot;
+	YulString m_value;
+};
+
+/// Determines whether an expression contains a call that can terminate successfully.
+class TerminatingCallFinder: public ASTWalker
+{
+public:
+	TerminatingCallFinder(
+		Dialect const& _dialect,
+		map<YulString, ControlFlowSideEffects> const& _functionSideEffects
+	):
+		m_dialect(_dialect), m_functionSideEffects(_functionSideEffects)
+	{}
+
+	using ASTWalker::operator();
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		ASTWalker::operator()(_functionCall);
+		if (BuiltinFunction const* builtin = m_dialect.builtin(_functionCall.functionName.name))
+			m_found = m_found || builtin->controlFlowSideEffects.canTerminate;
+		else
+			m_found = m_found || m_functionSideEffects.at(_functionCall.functionName.name).canTerminate;
+	}
+
+	bool found() const { return m_found; }
+
+private:
+	Dialect const& m_dialect;
+	map<YulString, ControlFlowSideEffects> const& m_functionSideEffects;
+	bool m_found = false;
+};
+
+}
+
+void StorageWriteCombiner::run(OptimiserStepContext& _context, Block& _ast)
+{
+	if (!_context.dialect.storageStoreFunction({}) || !_context.dialect.storageLoadFunction({}))
+		return;
+
+	StorageWriteCombiner{
+		_context.dialect,
+		_context.dispenser,
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+	}(_ast);
+}
+
+void StorageWriteCombiner::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	for (size_t index = 0; index < _block.statements.size(); ++index)
+		combineWithNextStore(_block.statements, index);
+}
+
+FunctionCall* StorageWriteCombiner::storeCall(Statement& _statement) const
+{
+	if (ExpressionStatement* expressionStatement = get_if<ExpressionStatement>(&_statement))
+		if (FunctionCall* call = get_if<FunctionCall>(&expressionStatement->expression))
+			if (call->functionName.name == m_dialect.storageStoreFunction({})->name)
+				return call;
+	return nullptr;
+}
+
+bool StorageWriteCombiner::combineWithNextStore(vector<Statement>& _statements, size_t _index)
+{
+	FunctionCall* store = storeCall(_statements[_index]);
+	if (!store)
+		return false;
+	yulAssert(store->arguments.size() == 2, "");
+	Expression const& slot = store->arguments.front();
+	if (!SideEffectsCollector(m_dialect, slot, &m_functionSideEffects).movable())
+		return false;
+	set<YulString> slotVariables = keys(VariableReferencesCounter::countReferences(slot));
+	YulString loadFunction = m_dialect.storageLoadFunction({})->name;
+
+	for (size_t next = _index + 1; next < _statements.size(); ++next)
+	{
+		// Check the statement as it would look like after the replacement.
+		Statement candidate = ASTCopier{}.translate(_statements[next]);
+		LoadReplacer{loadFunction, slot, placeholder}.visit(candidate);
+
+		if (FunctionCall* nextStore = storeCall(candidate))
+		{
+			if (
+				!SyntacticallyEqual{}(nextStore->arguments.front(), slot) ||
+				!canBeMovedAcross(nextStore->arguments.back())
+			)
+				return false;
+
+			YulString value = m_nameDispenser.newName({});
+			for (size_t replaced = _index + 1; replaced <= next; ++replaced)
+				LoadReplacer{loadFunction, slot, value}.visit(_statements[replaced]);
+			shared_ptr<DebugData const> debugData = store->debugData;
+			Expression storedValue = std::move(store->arguments.back());
+			_statements[_index] = VariableDeclaration{
+				debugData,
+				{TypedName{debugData, value, {}}},
+				make_unique<Expression>(std::move(storedValue))
+			};
+			return true;
+		}
+
+		Expression const* expression = nullptr;
+		if (VariableDeclaration const* declaration = get_if<VariableDeclaration>(&candidate))
+			expression = declaration->value.get();
+		else if (Assignment const* assignment = get_if<Assignment>(&candidate))
+		{
+			for (Identifier const& variable: assignment->variableNames)
+				if (slotVariables.count(variable.name))
+					return false;
+			expression = assignment->value.get();
+		}
+		else if (ExpressionStatement const* expressionStatement = get_if<ExpressionStatement>(&candidate))
+			expression = &expressionStatement->expression;
+		else
+			return false;
+
+		if (expression && !canBeMovedAcross(*expression))
+			return false;
+	}
+	return false;
+}
+
+bool StorageWriteCombiner::canBeMovedAcross(Expression const& _expression) const
+{
+	if (SideEffectsCollector(m_dialect, _expression, &m_functionSideEffects).sideEffects().storage != SideEffects::None)
+		return false;
+	TerminatingCallFinder finder{m_dialect, m_controlFlowSideEffects};
+	finder.visit(_expression);
+	return !finder.found();
+}
@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that combines read-modify-write sequences on the same storage slot.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/SideEffects.h>
+
+#include <map>
+#include <optional>
+
+namespace solidity::yul
+{
+
+struct Dialect;
+
+/**
+ * Optimisation stage that combines several writes to the same storage slot into one,
+ * as they are generated for consecutive assignments to fields packed into one slot.
+ *
+ * Code of the form
+ *
+ * sstore(k, or(and(sload(k), not(0xff)), a))
+ * let x := calldataload(0)
+ * sstore(k, or(and(sload(k), not(0xff00)), shl(8, x)))
+ *
+ * is transformed into
+ *
+ * let v := or(and(sload(k), not(0xff)), a)
+ * let x := calldataload(0)
+ * sstore(k, or(and(v, not(0xff00)), shl(8, x)))
+ *
+ * i.e. the value of the first store is kept in a variable that replaces the loads
+ * from the slot until the next store to the same slot, which makes the first store redundant.
+ *
+ * This is only done if the slot expression is movable and its variables are not
+ * reassigned in between, and if the statements in between are variable declarations,
+ * assignments or expression statements that neither access storage except for loads
+ * from the slot nor can terminate successfully. Statements in between that revert
+ * are fine, because the reverted store would not have been visible anyway.
+ *
+ * Works best if the code is not in SSA form, i.e. after ExpressionJoiner.
+ *
+ * Prerequisite: Disambiguator.
+ */
+class StorageWriteCombiner: public ASTModifier
+{
+public:
+	static constexpr char const* name{"StorageWriteCombiner"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	StorageWriteCombiner(
+		Dialect const& _dialect,
+		NameDispenser& _nameDispenser,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		std::map<YulString, ControlFlowSideEffects> _controlFlowSideEffects
+	):
+		m_dialect(_dialect),
+		m_nameDispenser(_nameDispenser),
+		m_functionSideEffects(std::move(_functionSideEffects)),
+		m_controlFlowSideEffects(std::move(_controlFlowSideEffects))
+	{}
+
+	/// @returns the call if @a _statement is an expression statement calling sstore.
+	FunctionCall* storeCall(Statement& _statement) const;
+	/// Tries to combine the store at @a _index with a later store to the same slot.
+	/// @returns true on success.
+	bool combineWithNextStore(std::vector<Statement>& _statements, size_t _index);
+	/// @returns true if evaluating @a _expression does not access storage and cannot
+	/// terminate successfully.
+	bool canBeMovedAcross(Expression const& _expression) const;
+
+	Dialect const& m_dialect;
+	NameDispenser& m_nameDispenser;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	std::map<YulString, ControlFlowSideEffects> m_controlFlowSideEffects;
+};
+
+}
@@ -27,6 +27,7 @@
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ControlFlowSimplifier.h>
+#include <libyul/optimiser/ConditionalConstantPropagator.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
 #include <libyul/optimiser/DeadCodeEliminator.h>
@@ -37,33 +38,41 @@
 #include <libyul/optimiser/ExpressionSplitter.h>
 #include <libyul/optimiser/ExpressionJoiner.h>
 #include <libyul/optimiser/ExpressionInliner.h>
+#include <libyul/optimiser/FreeMemoryPointerResolver.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopConditionOutOfBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/GlobalValueNumberer.h>
 #include <libyul/optimiser/ReasoningBasedSimplifier.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedFunctionParameterPruner.h>
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/ColdCodeOutliner.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/StorageWriteCombiner.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/UnusedAssignEliminator.h>
 #include <libyul/optimiser/UnusedStoreEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
 #include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopCounterCheckEliminator.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopMemoryReclaimer.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
+#include <libyul/backends/evm/StackAnalysisCache.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/AsmPrinter.h>
@@ -74,34 +83,35 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/TraceEvents.h>
 
 #include <libyul/CompilabilityChecker.h>
 
 #include <range/v3/view/map.hpp>
 #include <range/v3/action/remove.hpp>
 
+#include <chrono>
 #include <limits>
 #include <tuple>
 
 #ifdef PROFILE_OPTIMIZER_STEPS
-#include <chrono>
 #include <fmt/format.h>
 #endif
 
 using namespace std;
+using namespace std::chrono;
 using namespace solidity;
 using namespace solidity::yul;
-#ifdef PROFILE_OPTIMIZER_STEPS
-using namespace std::chrono;
-#endif
 
 namespace
 {
 
 #ifdef PROFILE_OPTIMIZER_STEPS
-void outputPerformanceMetrics(map<string, int64_t> const& _metrics)
+void outputPerformanceMetrics(OptimiserProfile const& _profile)
 {
-	vector<pair<string, int64_t>> durations(_metrics.begin(), _metrics.end());
+	vector<pair<string, int64_t>> durations;
+	for (auto&& [step, statistics]: _profile.steps)
+		durations.emplace_back(step, statistics.durationInMicroseconds);
 	sort(
 		durations.begin(),
 		durations.end(),
@@ -133,7 +143,7 @@ void outputPerformanceMetrics(map<string, int64_t> const& _metrics)
 }
 
 
-void OptimiserSuite::run(
+bool OptimiserSuite::run(
 	Dialect const& _dialect,
 	GasMeter const* _meter,
 	Object& _object,
@@ -141,9 +151,24 @@ void OptimiserSuite::run(
 	string_view _optimisationSequence,
 	string_view _optimisationCleanupSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	OptimiserProfile* _profile,
+	map<string, size_t> const& _functionExecutionCounts,
+	optional<milliseconds> _timeBudget
 )
 {
+	steady_clock::time_point startTime = steady_clock::now();
+#ifdef PROFILE_OPTIMIZER_STEPS
+	OptimiserProfile localProfile;
+	if (!_profile)
+		_profile = &localProfile;
+#endif
+	if (_profile)
+	{
+		_profile->objectName = _object.name.str();
+		_profile->codeSizeBefore = CodeSize::codeSizeIncludingFunctions(*_object.code);
+	}
+
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
 	bool usesOptimizedCodeGenerator =
 		_optimizeStackAllocation &&
@@ -161,9 +186,19 @@ void OptimiserSuite::run(
 	Block& ast = *_object.code;
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	map<YulString, size_t> functionExecutionCounts;
+	for (auto const& [function, executionCount]: _functionExecutionCounts)
+		functionExecutionCounts[YulString{function}] = executionCount;
+	OptimiserStepContext context{
+		_dialect,
+		dispenser,
+		reservedIdentifiers,
+		_expectedExecutionsPerDeployment,
+		_profile,
+		&functionExecutionCounts
+	};
 
-	OptimiserSuite suite(context, Debug::None);
+	OptimiserSuite suite(context, Debug::None, _profile);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -171,7 +206,10 @@ void OptimiserSuite::run(
 
 	NameSimplifier::run(suite.m_context, ast);
 	// Now the user-supplied part
+	if (_timeBudget)
+		suite.m_deadline = startTime + *_timeBudget;
 	suite.runSequence(_optimisationSequence, ast);
+	suite.m_deadline.reset();
 
 	// This is a tuning parameter, but actually just prevents infinite loops.
 	size_t stackCompressorMaxIterations = 16;
@@ -189,6 +227,10 @@ void OptimiserSuite::run(
 
 	// Run the user-supplied clean up sequence
 	suite.runSequence(_optimisationCleanupSequence, ast);
+	// Creation code is only executed once, so only its size matters. Combine the helper functions
+	// that became equivalent during the optimization and remove the copies that are no longer used.
+	if (!_expectedExecutionsPerDeployment)
+		suite.runSequence("vu", ast);
 	// Hard-coded FunctionGrouper step is used to bring the AST into a canonical form required by the StackCompressor
 	// and StackLimitEvader. This is hard-coded as the last step, as some previously executed steps may break the
 	// aforementioned form, thus causing the StackCompressor/StackLimitEvader to throw.
@@ -200,14 +242,17 @@ void OptimiserSuite::run(
 		ConstantOptimiser{*evmDialect, *_meter}(ast);
 		if (usesOptimizedCodeGenerator)
 		{
+			// Unless the stack compressor modifies the code, the stack limit evader reuses its analysis.
+			StackAnalysisCache stackAnalysis{*evmDialect, _object};
 			StackCompressor::run(
 				_dialect,
 				_object,
 				_optimizeStackAllocation,
-				stackCompressorMaxIterations
+				stackCompressorMaxIterations,
+				&stackAnalysis
 			);
 			if (evmDialect->providesObjectAccess())
-				StackLimitEvader::run(suite.m_context, _object);
+				StackLimitEvader::run(suite.m_context, _object, stackAnalysis);
 		}
 		else if (evmDialect->providesObjectAccess() && _optimizeStackAllocation)
 			StackLimitEvader::run(suite.m_context, _object);
@@ -224,11 +269,18 @@ void OptimiserSuite::run(
 	NameSimplifier::run(suite.m_context, ast);
 	VarNameCleaner::run(suite.m_context, ast);
 
+	if (_profile)
+	{
+		_profile->codeSizeAfter = CodeSize::codeSizeIncludingFunctions(ast);
+		_profile->durationInMicroseconds = duration_cast<microseconds>(steady_clock::now() - startTime).count();
+		_profile->timeBudgetExhausted = suite.m_deadlinePassed;
+	}
 #ifdef PROFILE_OPTIMIZER_STEPS
-	outputPerformanceMetrics(suite.m_durationPerStepInMicroseconds);
+	outputPerformanceMetrics(*_profile);
 #endif
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+	return suite.m_deadlinePassed;
 }
 
 namespace
@@ -257,7 +309,9 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 		instance = optimiserStepCollection<
 			BlockFlattener,
 			CircularReferencesPruner,
+			ColdCodeOutliner,
 			CommonSubexpressionEliminator,
+			ConditionalConstantPropagator,
 			ConditionalSimplifier,
 			ConditionalUnsimplifier,
 			ControlFlowSimplifier,
@@ -271,19 +325,25 @@ map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 			ForLoopConditionIntoBody,
 			ForLoopConditionOutOfBody,
 			ForLoopInitRewriter,
+			FreeMemoryPointerResolver,
 			FullInliner,
 			FunctionGrouper,
 			FunctionHoister,
 			FunctionSpecializer,
+			GlobalValueNumberer,
 			LiteralRematerialiser,
 			LoadResolver,
+			LoopCounterCheckEliminator,
 			LoopInvariantCodeMotion,
+			LoopMemoryReclaimer,
+			LoopUnroller,
 			UnusedAssignEliminator,
 			UnusedStoreEliminator,
 			ReasoningBasedSimplifier,
 			Rematerialiser,
 			SSAReverser,
 			SSATransform,
+			StorageWriteCombiner,
 			StructuralSimplifier,
 			UnusedFunctionParameterPruner,
 			UnusedPruner,
@@ -299,7 +359,9 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 	static map<string, char> lookupTable{
 		{BlockFlattener::name,                'f'},
 		{CircularReferencesPruner::name,      'l'},
+		{ColdCodeOutliner::name,              'Q'},
 		{CommonSubexpressionEliminator::name, 'c'},
+		{ConditionalConstantPropagator::name, 'P'},
 		{ConditionalSimplifier::name,         'C'},
 		{ConditionalUnsimplifier::name,       'U'},
 		{ControlFlowSimplifier::name,         'n'},
@@ -313,19 +375,25 @@ map<string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{ForLoopConditionIntoBody::name,      'I'},
 		{ForLoopConditionOutOfBody::name,     'O'},
 		{ForLoopInitRewriter::name,           'o'},
+		{FreeMemoryPointerResolver::name,     'y'},
 		{FullInliner::name,                   'i'},
 		{FunctionGrouper::name,               'g'},
 		{FunctionHoister::name,               'h'},
 		{FunctionSpecializer::name,           'F'},
+		{GlobalValueNumberer::name,           'G'},
 		{LiteralRematerialiser::name,         'T'},
 		{LoadResolver::name,                  'L'},
+		{LoopCounterCheckEliminator::name,    'K'},
 		{LoopInvariantCodeMotion::name,       'M'},
+		{LoopMemoryReclaimer::name,           'A'},
+		{LoopUnroller::name,                  'N'},
 		{ReasoningBasedSimplifier::name,      'R'},
 		{UnusedAssignEliminator::name,        'r'},
 		{UnusedStoreEliminator::name,         'S'},
 		{Rematerialiser::name,                'm'},
 		{SSAReverser::name,                   'V'},
 		{SSATransform::name,                  'a'},
+		{StorageWriteCombiner::name,          'W'},
 		{StructuralSimplifier::name,          't'},
 		{UnusedFunctionParameterPruner::name, 'p'},
 		{UnusedPruner::name,                  'u'},
@@ -475,9 +543,12 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 				runSequence(abbreviationsToSteps(subsequence), _ast);
 		}
 
-		if (!_repeatUntilStable)
+		if (!_repeatUntilStable || deadlinePassed())
 			break;
 
+		if (m_profile)
+			++m_profile->repeatIterations;
+
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
 		if (newSize == codeSize)
 			break;
@@ -492,16 +563,23 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
 	for (string const& step: _steps)
 	{
+		if (deadlinePassed())
+			return;
+		util::TraceSpan span(step, "yulOptimizerStep");
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point startTime = steady_clock::now();
-#endif
-		allSteps().at(step)->run(m_context, _ast);
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point endTime = steady_clock::now();
-		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
-#endif
+		if (m_profile)
+		{
+			OptimiserProfile::StepStatistics& statistics = m_profile->steps[step];
+			statistics.codeSizeBefore += CodeSize::codeSizeIncludingFunctions(_ast);
+			steady_clock::time_point startTime = steady_clock::now();
+			allSteps().at(step)->run(m_context, _ast);
+			statistics.durationInMicroseconds += duration_cast<microseconds>(steady_clock::now() - startTime).count();
+			statistics.codeSizeAfter += CodeSize::codeSizeIncludingFunctions(_ast);
+			++statistics.runs;
+		}
+		else
+			allSteps().at(step)->run(m_context, _ast);
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -516,3 +594,12 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 		}
 	}
 }
+
+bool OptimiserSuite::deadlinePassed()
+{
+	if (!m_deadline)
+		return false;
+	if (!m_deadlinePassed && steady_clock::now() >= *m_deadline)
+		m_deadlinePassed = true;
+	return m_deadlinePassed;
+}
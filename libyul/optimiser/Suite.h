@@ -27,6 +27,9 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <chrono>
+#include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
@@ -40,6 +43,35 @@ struct Dialect;
 class GasMeter;
 struct Object;
 
+/**
+ * Execution statistics of the optimiser suite collected for a single object.
+ * Code sizes are measured with the default CodeSize metric, which approximates the number of AST nodes.
+ */
+struct OptimiserProfile
+{
+	struct StepStatistics
+	{
+		size_t runs = 0;
+		int64_t durationInMicroseconds = 0;
+		/// Sum of the code sizes before and after each run of the step.
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+		/// Step-specific event counters, summed over all runs of the step.
+		std::map<std::string, size_t> counters;
+	};
+
+	std::string objectName;
+	/// Wall time spent in OptimiserSuite::run, including the hard-coded steps.
+	int64_t durationInMicroseconds = 0;
+	size_t codeSizeBefore = 0;
+	size_t codeSizeAfter = 0;
+	/// Total number of rounds executed by all repeat-until-stable (bracketed) subsequences.
+	size_t repeatIterations = 0;
+	/// Whether steps of the optimisation sequence were skipped because the time budget ran out.
+	bool timeBudgetExhausted = false;
+	std::map<std::string, StepStatistics> steps;
+};
+
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
@@ -59,10 +91,25 @@ public:
 		PrintStep,
 		PrintChanges
 	};
-	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
+	OptimiserSuite(
+		OptimiserStepContext& _context,
+		Debug _debug = Debug::None,
+		OptimiserProfile* _profile = nullptr
+	):
+		m_context(_context),
+		m_debug(_debug),
+		m_profile(_profile)
+	{}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
-	static void run(
+	/// If @a _profile is not null, timing and code size statistics of all steps are recorded in it.
+	/// @a _functionExecutionCounts are the execution counts of the functions of the unoptimised
+	/// code in a profile of real workloads. If not empty, they guide the inlining heuristic.
+	/// If @a _timeBudget is set, the optimisation sequence stops as soon as it is exceeded and the
+	/// remaining steps, including further rounds of bracketed subsequences, are skipped. The
+	/// clean-up sequence and the hard-coded steps are always run.
+	/// @returns true if the time budget was exhausted.
+	static bool run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
@@ -70,7 +117,10 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimiserProfile* _profile = nullptr,
+		std::map<std::string, size_t> const& _functionExecutionCounts = {},
+		std::optional<std::chrono::milliseconds> _timeBudget = std::nullopt
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -85,11 +135,16 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	/// @returns true if a deadline is set and has passed. Once this happened, it keeps returning
+	/// true as long as the deadline is set.
+	bool deadlinePassed();
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
-#ifdef PROFILE_OPTIMIZER_STEPS
-	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
-#endif
+	OptimiserProfile* m_profile = nullptr;
+	/// Point in time after which no further steps are run by runSequence.
+	std::optional<std::chrono::steady_clock::time_point> m_deadline;
+	bool m_deadlinePassed = false;
 };
 
 }
@@ -107,11 +107,16 @@ void UnusedPruner::operator()(Block& _block)
 					statement = Block{std::move(varDecl.debugData), {}};
 				}
 				else if (varDecl.variables.size() == 1 && m_dialect.discardFunction(varDecl.variables.front().type))
+				{
+					YulString discardFunction = m_dialect.discardFunction(varDecl.variables.front().type)->name;
+					// Keep the reference counts in sync with the code for the next iteration.
+					++m_references[discardFunction];
 					statement = ExpressionStatement{varDecl.debugData, FunctionCall{
 						varDecl.debugData,
-						{varDecl.debugData, m_dialect.discardFunction(varDecl.variables.front().type)->name},
+						{varDecl.debugData, discardFunction},
 						{*std::move(varDecl.value)}
 					}};
+				}
 			}
 		}
 		else if (holds_alternative<ExpressionStatement>(statement))
@@ -140,11 +145,13 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
+	// The reference counts are updated while pruning, so they are only computed once.
+	UnusedPruner pruner(
+		_dialect, _ast, _allowMSizeOptimization, _functionSideEffects,
+						_externallyUsedFunctions);
 	while (true)
 	{
-		UnusedPruner pruner(
-			_dialect, _ast, _allowMSizeOptimization, _functionSideEffects,
-							_externallyUsedFunctions);
+		pruner.m_shouldRunAgain = false;
 		pruner(_ast);
 		if (!pruner.shouldRunAgain())
 			return;
@@ -170,9 +177,10 @@ void UnusedPruner::runUntilStabilised(
 	set<YulString> const& _externallyUsedFunctions
 )
 {
+	UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
 	while (true)
 	{
-		UnusedPruner pruner(_dialect, _function, _allowMSizeOptimization, _externallyUsedFunctions);
+		pruner.m_shouldRunAgain = false;
 		pruner(_function);
 		if (!pruner.shouldRunAgain())
 			return;
@@ -175,7 +175,9 @@ void UnusedStoreEliminator::visit(Statement const& _statement)
 		*instruction == Instruction::RETURNDATACOPY ||
 		*instruction == Instruction::MSTORE ||
 		*instruction == Instruction::MSTORE8;
+	// mcopy also reads memory, so it is never treated as a plain store.
 	bool isCandidateForRemoval =
+		*instruction != Instruction::MCOPY &&
 		SemanticInformation::otherState(*instruction) != SemanticInformation::Write && (
 			SemanticInformation::storage(*instruction) == SemanticInformation::Write ||
 			(!m_ignoreMemory && SemanticInformation::memory(*instruction) == SemanticInformation::Write)
@@ -41,6 +41,7 @@ source "${SCRIPT_DIR}/common.sh"
 function build() {
     local build_dir="$1"
     local prerelease_source="${2:-ci}"
+    local threads_simd="$3"
 
     cd /root/project
 
@@ -66,6 +67,15 @@ function build() {
     # TODO: This can be removed if and when all usages of `move()` in our codebase use the `std::` qualifier.
     CMAKE_CXX_FLAGS="-Wno-unqualified-std-cast-call"
 
+    # The threaded build needs SharedArrayBuffer, i.e. cross-origin isolation in browsers,
+    # and the SIMD build needs a runtime with WebAssembly SIMD support (e.g. Node.js >= 16.4).
+    # The plain build runs everywhere and remains the default.
+    local variant_flags=(-DSOLJSON_THREADS=OFF -DSOLJSON_SIMD=OFF)
+    if [[ $threads_simd == true ]]
+    then
+        variant_flags=(-DSOLJSON_THREADS=ON -DSOLJSON_SIMD=ON)
+    fi
+
     mkdir -p "$build_dir"
     cd "$build_dir"
     emcmake cmake \
@@ -74,6 +84,7 @@ function build() {
         -DBoost_USE_STATIC_RUNTIME=1 \
         -DCMAKE_CXX_FLAGS="${CMAKE_CXX_FLAGS}" \
         -DTESTS=0 \
+        "${variant_flags[@]}" \
     ..
     make soljson
 
@@ -81,6 +92,12 @@ function build() {
     mkdir -p upload
     scripts/ci/pack_soljson.sh "$build_dir/libsolc/soljson.js" "$build_dir/libsolc/soljson.wasm" upload/soljson.js
     cp upload/soljson.js ./
+    # Emscripten versions before 3.1.58 put the code that starts the workers into a separate file.
+    if [[ -f "$build_dir/libsolc/soljson.worker.js" ]]
+    then
+        cp "$build_dir/libsolc/soljson.worker.js" upload/
+        cp upload/soljson.worker.js ./
+    fi
 
     OUTPUT_SIZE=$(ls -la soljson.js)
 
@@ -94,12 +111,14 @@ Build Solidity emscripten binary
     -h | --help          Display this help message
     --build-dir          The emscripten build directory
     --prerelease-source  The prerelease source string. E.g. 'nightly' or 'ci'.
+    --threads-simd       Build with WebAssembly threads and SIMD instead of the plain build.
 EOF
 }
 
 function main() {
     local build_dir="emscripten_build"
     local prerelease_source=""
+    local threads_simd=false
 
     while (( $# > 0 )); do
         case "$1" in
@@ -117,10 +136,14 @@ function main() {
                 prerelease_source="$2"
                 shift 2
                 ;;
+            --threads-simd)
+                threads_simd=true
+                shift
+                ;;
             *) fail "Invalid option: $1" ;;
         esac
     done
-    build "$build_dir" "$prerelease_source"
+    build "$build_dir" "$prerelease_source" "$threads_simd"
 }
 
 main "$@"
@@ -32,6 +32,7 @@
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -56,10 +57,16 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/ThreadPool.h>
+#include <libsolutil/TraceEvents.h>
 
 #include <algorithm>
 #include <fstream>
+#include <iomanip>
 #include <memory>
+#include <sstream>
+#include <string_view>
+#include <unordered_map>
 
 #include <range/v3/view/map.hpp>
 
@@ -95,6 +102,25 @@ set<frontend::InputMode> const CompilerInputModes{
 	frontend::InputMode::CompilerWithASTImport
 };
 
+/// @returns a table of the durations and peak memory increases of @a _phases.
+string formatTimeReport(vector<PhaseStatistics> const& _phases)
+{
+	ostringstream report;
+	report << left << setw(32) << "Phase" << right << setw(12) << "Time (ms)" << setw(28) << "Peak memory increase (KiB)" << endl;
+	chrono::microseconds total{0};
+	for (PhaseStatistics const& phase: _phases)
+	{
+		report <<
+			left << setw(32) << phase.name <<
+			right << setw(12) << fixed << setprecision(3) << static_cast<double>(phase.duration.count()) / 1000.0 <<
+			setw(28) << (phase.peakMemoryIncreaseInKiB ? to_string(*phase.peakMemoryIncreaseInKiB) : "-") <<
+			endl;
+		total += phase.duration;
+	}
+	report << left << setw(32) << "Total" << right << setw(12) << fixed << setprecision(3) << static_cast<double>(total.count()) / 1000.0 << endl;
+	return report.str();
+}
+
 } // anonymous namespace
 
 namespace solidity::frontend
@@ -157,7 +183,9 @@ static bool needsHumanTargetedStdout(CommandLineOptions const& _options)
 		_options.compiler.outputs.natspecDev ||
 		_options.compiler.outputs.opcodes ||
 		_options.compiler.outputs.signatureHashes ||
-		_options.compiler.outputs.storageLayout;
+		_options.compiler.outputs.storageLayout ||
+		_options.compiler.timeReport ||
+		_options.optimizer.profile;
 }
 
 static bool coloredOutput(CommandLineOptions const& _options)
@@ -346,6 +374,55 @@ void CommandLineInterface::handleStorageLayout(string const& _contract)
 		sout() << "Contract Storage Layout:" << endl << data << endl;
 }
 
+void CommandLineInterface::handleOptimizerProfile(string const& _contract)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.optimizer.profile)
+		return;
+
+	string data = jsonPrint(m_compiler->optimiserProfile(_contract), m_options.formatting.json);
+	string assemblyData = jsonPrint(m_compiler->assemblyOptimiserProfile(_contract), m_options.formatting.json);
+	if (!m_options.output.dir.empty())
+	{
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_optimizer_profile.json", data);
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_assembly_optimizer_profile.json", assemblyData);
+	}
+	else
+	{
+		sout() << "Optimizer profile:" << endl << data << endl;
+		sout() << "Assembly optimizer profile:" << endl << assemblyData << endl;
+	}
+}
+
+void CommandLineInterface::handleTimeReport(string const& _contract)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.compiler.timeReport || m_compiler->state() < CompilerStack::State::AnalysisPerformed)
+		return;
+
+	string data = formatTimeReport(m_compiler->phaseStatistics(_contract));
+	if (!m_options.output.dir.empty())
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_time_report.txt", data);
+	else
+		sout() << "Time report:" << endl << data;
+}
+
+void CommandLineInterface::handleSharedTimeReport()
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.compiler.timeReport)
+		return;
+
+	string data = formatTimeReport(m_compiler->sharedPhaseStatistics());
+	if (!m_options.output.dir.empty())
+		createFile("time_report.txt", data);
+	else
+		sout() << endl << "======= Time report of parsing and analysis =======" << endl << data;
+}
+
 void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -393,7 +470,7 @@ void CommandLineInterface::handleGasEstimation(string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
 
-	Json::Value estimates = m_compiler->gasEstimates(_contract);
+	Json::Value estimates = m_compiler->gasEstimates(_contract, m_options.compiler.gasPathBudget);
 	sout() << "Gas estimation:" << endl;
 
 	if (estimates["creation"].isObject())
@@ -530,6 +607,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::Server &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -637,6 +715,9 @@ bool CommandLineInterface::parseArguments(int _argc, char const* const* _argv)
 
 void CommandLineInterface::processInput()
 {
+	ThreadPool::instance().setMaxThreads(m_options.optimizer.threads);
+	TraceEvents::instance().enable(!m_options.compiler.traceEventsFile.empty());
+
 	switch (m_options.input.mode)
 	{
 	case InputMode::Help:
@@ -653,13 +734,17 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << endl;
+		compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << endl;
 		m_standardJsonInput.reset();
 		break;
 	}
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
+	case InputMode::Server:
+		serveStandardJsonRequests();
+		break;
 	case InputMode::Assembler:
 		assemble(m_options.assembly.inputLanguage, m_options.assembly.targetMachine);
 		break;
@@ -672,6 +757,18 @@ void CommandLineInterface::processInput()
 		compile();
 		outputCompilationResults();
 	}
+
+	if (!m_options.compiler.traceEventsFile.empty())
+		writeTraceEvents();
+}
+
+void CommandLineInterface::writeTraceEvents()
+{
+	string const pathName = m_options.compiler.traceEventsFile.string();
+	ofstream outFile(pathName);
+	outFile << TraceEvents::instance().toJson();
+	if (!outFile)
+		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
 }
 
 void CommandLineInterface::printVersion()
@@ -709,12 +806,16 @@ void CommandLineInterface::compile()
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
+		if (!m_options.output.cacheDir.empty())
+			m_compiler->setCompilationCache(make_shared<FileSystemCompilationCache>(m_options.output.cacheDir));
 		if (m_options.output.debugInfoSelection.has_value())
 			m_compiler->selectDebugInfo(m_options.output.debugInfoSelection.value());
 		// TODO: Perhaps we should not compile unless requested
 
 		m_compiler->enableIRGeneration(m_options.compiler.outputs.ir || m_options.compiler.outputs.irOptimized);
 		m_compiler->enableEwasmGeneration(m_options.compiler.outputs.ewasm);
+		m_compiler->enableOptimiserProfiling(m_options.optimizer.profile);
+		m_compiler->enablePhaseStatistics(m_options.compiler.timeReport);
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
 			m_options.compiler.outputs.asm_ ||
@@ -925,6 +1026,32 @@ void CommandLineInterface::handleAst()
 	}
 }
 
+void CommandLineInterface::serveStandardJsonRequests()
+{
+	// Cache entries are addressed by a hash of everything that determines them,
+	// so they stay valid even if the sources and settings differ between requests.
+	shared_ptr<CompilationCache> cache;
+	if (m_options.output.cacheDir.empty())
+		cache = make_shared<MemoryCompilationCache>();
+	else
+		cache = make_shared<FileSystemCompilationCache>(m_options.output.cacheDir);
+
+	StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
+	compiler.setCompilationCache(cache);
+
+	string request;
+	while (getline(m_sin, request))
+	{
+		if (request.find_first_not_of(" \t\r") == string::npos)
+			continue;
+
+		// Files read through the import callback may have changed since the last request.
+		m_fileReader.setSourceUnits({});
+		compiler.compile(request, sout());
+		sout() << endl;
+	}
+}
+
 void CommandLineInterface::serveLSP()
 {
 	lsp::StdioTransport transport;
@@ -956,13 +1083,29 @@ void CommandLineInterface::link()
 		librariesReplacements[replacement] = library.second;
 	}
 
+	// The hex representations of the addresses and the hints are the same for all files.
+	unordered_map<string_view, string> placeholderReplacements;
+	for (auto const& [placeholder, address]: librariesReplacements)
+		placeholderReplacements.emplace(placeholder, util::toHex(address.asBytes()));
+	vector<string> libraryHints;
+	for (auto const& library: m_options.linker.libraries)
+		libraryHints.emplace_back("\n" + libraryPlaceholderHint(library.first));
+
 	FileReader::StringMap sourceCodes = m_fileReader.sourceUnits();
+	vector<FileReader::StringMap::value_type*> sources;
 	for (auto& src: sourceCodes)
-	{
+		sources.push_back(&src);
+
+	// The files are linked in parallel. Messages and errors are collected per file and
+	// reported in the order of the files so that the output does not depend on the scheduling.
+	vector<string> messages(sources.size());
+	vector<optional<string>> linkErrors(sources.size());
+	ThreadPool::instance().parallelFor(sources.size(), [&](size_t _index) {
+		auto& src = *sources[_index];
 		auto end = src.second.end();
 		for (auto it = src.second.begin(); it != end;)
 		{
-			while (it != end && *it != '_') ++it;
+			it = find(it, end, '_');
 			if (it == end) break;
 			if (
 				end - it < placeholderSize ||
@@ -970,27 +1113,34 @@ void CommandLineInterface::link()
 				*(it + placeholderSize - 2) != '_' ||
 				*(it + placeholderSize - 1) != '_'
 			)
-				solThrow(
-					CommandLineExecutionError,
-					"Error in binary object file " + src.first + " at position " + to_string(it - src.second.begin()) + "\n" +
-					'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference."
-				);
-
-			string foundPlaceholder(it, it + placeholderSize);
-			if (librariesReplacements.count(foundPlaceholder))
 			{
-				string hexStr(util::toHex(librariesReplacements.at(foundPlaceholder).asBytes()));
-				copy(hexStr.begin(), hexStr.end(), it);
+				linkErrors[_index] =
+					"Error in binary object file " + src.first + " at position " + to_string(it - src.second.begin()) + "\n" +
+					'"' + string(it, it + min(placeholderSize, static_cast<int>(end - it))) + "\" is not a valid link reference.";
+				return;
 			}
+
+			string_view foundPlaceholder(&*it, placeholderSize);
+			if (auto replacement = placeholderReplacements.find(foundPlaceholder); replacement != placeholderReplacements.end())
+				copy(replacement->second.begin(), replacement->second.end(), it);
 			else
-				serr() << "Reference \"" << foundPlaceholder << "\" in file \"" << src.first << "\" still unresolved." << endl;
+				messages[_index] += "Reference \"" + string(foundPlaceholder) + "\" in file \"" + src.first + "\" still unresolved.\n";
 			it += placeholderSize;
 		}
 		// Remove hints for resolved libraries.
-		for (auto const& library: m_options.linker.libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
+		if (src.second.find("\n//") != string::npos)
+			for (string const& hint: libraryHints)
+				boost::algorithm::erase_all(src.second, hint);
 		while (!src.second.empty() && *prev(src.second.end()) == '\n')
 			src.second.resize(src.second.size() - 1);
+	});
+
+	for (size_t index = 0; index < sources.size(); ++index)
+	{
+		if (!messages[index].empty())
+			serr() << messages[index];
+		if (linkErrors[index])
+			solThrow(CommandLineExecutionError, *linkErrors[index]);
 	}
 	m_fileReader.setSourceUnits(std::move(sourceCodes));
 }
@@ -1033,14 +1183,20 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 {
 	solAssert(m_options.input.mode == InputMode::Assembler);
 
-	bool successful = true;
-	map<string, yul::YulStack> yulStacks;
-	for (auto const& src: m_fileReader.sourceUnits())
-	{
-		// --no-optimize-yul option is not accepted in assembly mode.
-		solAssert(!m_options.optimizer.noOptimizeYul);
+	// --no-optimize-yul option is not accepted in assembly mode.
+	solAssert(!m_options.optimizer.noOptimizeYul);
 
-		auto& stack = yulStacks[src.first] = yul::YulStack(
+	vector<FileReader::StringMap::value_type const*> sources;
+	for (auto const& src: m_fileReader.sourceUnits())
+		sources.push_back(&src);
+
+	// The files are independent of each other, so they are parsed, optimized and assembled
+	// in parallel. The output of each file is buffered and printed in the order of the files.
+	vector<yul::YulStack> yulStacks(sources.size());
+	// Not vector<bool> since its elements cannot be written to from different threads.
+	vector<char> analysisSuccessful(sources.size(), false);
+	ThreadPool::instance().parallelFor(sources.size(), [&](size_t _index) {
+		auto& stack = yulStacks[_index] = yul::YulStack(
 			m_options.output.evmVersion,
 			m_options.output.eofVersion,
 			_language,
@@ -1050,15 +1206,14 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 				DebugInfoSelection::Default()
 		);
 
-		if (!stack.parseAndAnalyze(src.first, src.second))
-			successful = false;
-		else
+		analysisSuccessful[_index] = stack.parseAndAnalyze(sources[_index]->first, sources[_index]->second);
+		if (analysisSuccessful[_index])
 			stack.optimize();
-	}
+	});
 
-	for (auto const& sourceAndStack: yulStacks)
+	bool successful = all_of(analysisSuccessful.begin(), analysisSuccessful.end(), [](char _successful) { return _successful; });
+	for (auto const& stack: yulStacks)
 	{
-		auto const& stack = sourceAndStack.second;
 		SourceReferenceFormatter formatter(serr(false), stack, coloredOutput(m_options), m_options.formatting.withErrorIds);
 
 		for (auto const& error: stack.errors())
@@ -1076,21 +1231,25 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 		solThrow(CommandLineExecutionError, "");
 	}
 
-	for (auto const& src: m_fileReader.sourceUnits())
-	{
+	vector<ostringstream> outputs(sources.size());
+	vector<ostringstream> errorOutputs(sources.size());
+	ThreadPool::instance().parallelFor(sources.size(), [&](size_t _index) {
+		ostringstream& out = outputs[_index];
+		ostringstream& err = errorOutputs[_index];
 		string machine =
 			_targetMachine == yul::YulStack::Machine::EVM ? "EVM" :
 			"Ewasm";
-		sout() << endl << "======= " << src.first << " (" << machine << ") =======" << endl;
+		out << endl << "======= " << sources[_index]->first << " (" << machine << ") =======" << endl;
 
-		yul::YulStack& stack = yulStacks[src.first];
+		yul::YulStack& stack = yulStacks[_index];
 
 		if (m_options.compiler.outputs.irOptimized)
 		{
 			// NOTE: This actually outputs unoptimized code when the optimizer is disabled but
 			// 'ir' output in StandardCompiler works the same way.
-			sout() << endl << "Pretty printed source:" << endl;
-			sout() << stack.print() << endl;
+			out << endl << "Pretty printed source:" << endl;
+			stack.print(out);
+			out << endl;
 		}
 
 		if (_language != yul::YulStack::Language::Ewasm && _targetMachine == yul::YulStack::Machine::Ewasm)
@@ -1100,9 +1259,10 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 
 			if (m_options.compiler.outputs.ewasmIR)
 			{
-				sout() << endl << "==========================" << endl;
-				sout() << endl << "Translated source:" << endl;
-				sout() << stack.print() << endl;
+				out << endl << "==========================" << endl;
+				out << endl << "Translated source:" << endl;
+				stack.print(out);
+				out << endl;
 			}
 		}
 
@@ -1112,11 +1272,11 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 
 		if (m_options.compiler.outputs.binary)
 		{
-			sout() << endl << "Binary representation:" << endl;
+			out << endl << "Binary representation:" << endl;
 			if (object.bytecode)
-				sout() << object.bytecode->toHex() << endl;
+				out << object.bytecode->toHex() << endl;
 			else
-				serr() << "No binary representation found." << endl;
+				err << "No binary representation found." << endl;
 		}
 
 		solAssert(_targetMachine == yul::YulStack::Machine::Ewasm || _targetMachine == yul::YulStack::Machine::EVM, "");
@@ -1125,12 +1285,19 @@ void CommandLineInterface::assemble(yul::YulStack::Language _language, yul::YulS
 			(_targetMachine == yul::YulStack::Machine::Ewasm && m_options.compiler.outputs.ewasm)
 		)
 		{
-			sout() << endl << "Text representation:" << endl;
+			out << endl << "Text representation:" << endl;
 			if (!object.assembly.empty())
-				sout() << object.assembly << endl;
+				out << object.assembly << endl;
 			else
-				serr() << "No text representation found." << endl;
+				err << "No text representation found." << endl;
 		}
+	});
+
+	for (size_t index = 0; index < sources.size(); ++index)
+	{
+		sout() << outputs[index].str();
+		if (!errorOutputs[index].str().empty())
+			serr() << errorOutputs[index].str();
 	}
 }
 
@@ -1138,6 +1305,30 @@ void CommandLineInterface::outputCompilationResults()
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
 
+	// The artifacts that only need the analysis are generated for all contracts up front,
+	// which lets their independent parts run in parallel.
+	CompilerStack::ArtifactSelection selection;
+	selection.abi = m_options.compiler.outputs.abi;
+	selection.storageLayout = m_options.compiler.outputs.storageLayout;
+	selection.natspecUser = m_options.compiler.outputs.natspecUser;
+	selection.natspecDev = m_options.compiler.outputs.natspecDev;
+	selection.metadata = m_options.compiler.outputs.metadata;
+	if (auto const& requests = m_options.compiler.combinedJsonRequests)
+	{
+		selection.abi = selection.abi || requests->abi;
+		selection.storageLayout = selection.storageLayout || (requests->storageLayout && m_compiler->compilationSuccessful());
+		selection.natspecUser = selection.natspecUser || requests->natspecUser;
+		selection.natspecDev = selection.natspecDev || requests->natspecDev;
+		selection.metadata = selection.metadata || requests->metadata;
+	}
+	if (m_compiler->state() >= CompilerStack::AnalysisPerformed)
+	{
+		map<string, CompilerStack::ArtifactSelection> artifacts;
+		for (string const& contract: m_compiler->contractNames())
+			artifacts[contract] = selection;
+		m_compiler->generateArtifacts(artifacts);
+	}
+
 	handleCombinedJSON();
 
 	// do we need AST output?
@@ -1184,10 +1375,14 @@ void CommandLineInterface::outputCompilationResults()
 		handleMetadata(contract);
 		handleABI(contract);
 		handleStorageLayout(contract);
+		handleOptimizerProfile(contract);
 		handleNatspec(true, contract);
 		handleNatspec(false, contract);
+		handleTimeReport(contract);
 	} // end of contracts iteration
 
+	handleSharedTimeReport();
+
 	if (!m_hasOutput)
 	{
 		if (!m_options.output.dir.empty())
@@ -85,6 +85,8 @@ private:
 	void printLicense();
 	void compile();
 	void serveLSP();
+	/// Compiles the Standard JSON requests read line by line from standard input until it is closed.
+	void serveStandardJsonRequests();
 	void link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -110,6 +112,9 @@ private:
 	void handleNatspec(bool _natspecDev, std::string const& _contract);
 	void handleGasEstimation(std::string const& _contract);
 	void handleStorageLayout(std::string const& _contract);
+	void handleOptimizerProfile(std::string const& _contract);
+	void handleTimeReport(std::string const& _contract);
+	void handleSharedTimeReport();
 
 	/// Tries to read @ m_sourceCodes as a JSONs holding ASTs
 	/// such that they can be imported into the compiler  (importASTs())
@@ -127,6 +132,9 @@ private:
 	/// @arg _json json string to be written
 	void createJson(std::string const& _fileName, std::string const& _json);
 
+	/// Writes the recorded trace events to the file given by --trace-events.
+	void writeTraceEvents();
+
 	/// Returns the stream that should receive normal output. Sets m_hasOutput to true if the
 	/// stream has ever been used unless @arg _markAsUsed is set to false.
 	std::ostream& sout(bool _markAsUsed = true);
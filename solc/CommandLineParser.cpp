@@ -42,6 +42,7 @@ static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
 static string const g_strIncludePath = "include-path";
 static string const g_strAssemble = "assemble";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strErrorRecovery = "error-recovery";
 static string const g_strEVM = "evm";
@@ -51,6 +52,7 @@ static string const g_strEOFVersion = "experimental-eof-version";
 static string const g_strViaIR = "via-ir";
 static string const g_strExperimentalViaIR = "experimental-via-ir";
 static string const g_strGas = "gas";
+static string const g_strGasPathBudget = "gas-path-budget";
 static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
@@ -66,20 +68,25 @@ static string const g_strMachine = "machine";
 static string const g_strNoCBORMetadata = "no-cbor-metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerBudget = "model-checker-budget";
 static string const g_strModelCheckerContracts = "model-checker-contracts";
 static string const g_strModelCheckerDivModNoSlacks = "model-checker-div-mod-no-slacks";
 static string const g_strModelCheckerEngine = "model-checker-engine";
 static string const g_strModelCheckerExtCalls = "model-checker-ext-calls";
 static string const g_strModelCheckerInvariants = "model-checker-invariants";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
 static string const g_strModelCheckerShowUnproved = "model-checker-show-unproved";
 static string const g_strModelCheckerSolvers = "model-checker-solvers";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
+static string const g_strModelCheckerVerdictsOnly = "model-checker-verdicts-only";
 static string const g_strNone = "none";
 static string const g_strNoOptimizeYul = "no-optimize-yul";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strOptimizerProfile = "optimizer-profile";
+static string const g_strOptimizerThreads = "optimizer-threads";
 static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
@@ -96,11 +103,14 @@ static set<string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static string const g_strServer = "server";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
+static string const g_strTimeReport = "time-report";
+static string const g_strTraceEvents = "trace-events";
 static string const g_strPrettyJson = "pretty-json";
 static string const g_strJsonIndent = "json-indent";
 static string const g_strVersion = "version";
@@ -141,6 +151,7 @@ static map<InputMode, string> const g_inputModeName = {
 	{InputMode::StandardJson, "standard JSON"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
+	{InputMode::Server, "batch compilation server"},
 };
 
 void CommandLineParser::checkMutuallyExclusive(vector<string> const& _optionNames)
@@ -234,6 +245,7 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
 		output.eofVersion == _other.output.eofVersion &&
+		output.cacheDir == _other.output.cacheDir &&
 		input.mode == _other.input.mode &&
 		assembly.targetMachine == _other.assembly.targetMachine &&
 		assembly.inputLanguage == _other.assembly.inputLanguage &&
@@ -243,6 +255,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		formatting.withErrorIds == _other.formatting.withErrorIds &&
 		compiler.outputs == _other.compiler.outputs &&
 		compiler.estimateGas == _other.compiler.estimateGas &&
+		compiler.gasPathBudget == _other.compiler.gasPathBudget &&
+		compiler.timeReport == _other.compiler.timeReport &&
+		compiler.traceEventsFile == _other.compiler.traceEventsFile &&
 		compiler.combinedJsonRequests == _other.compiler.combinedJsonRequests &&
 		metadata.format == _other.metadata.format &&
 		metadata.hash == _other.metadata.hash &&
@@ -251,6 +266,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.noOptimizeYul == _other.optimizer.noOptimizeYul &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
+		optimizer.profile == _other.optimizer.profile &&
+		optimizer.threads == _other.optimizer.threads &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
 		modelChecker.settings == _other.modelChecker.settings;
 }
@@ -304,7 +321,7 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				if (!remapping.has_value())
 					solThrow(CommandLineValidationError, "Invalid remapping: \"" + positionalArg + "\".");
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 					solThrow(
 						CommandLineValidationError,
 						"Import remappings are not accepted on the command line in Standard JSON mode.\n"
@@ -331,7 +348,16 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::Server)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"No input files are accepted with --" + g_strServer + ".\n"
+				"The requests are read from standard input."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -480,6 +506,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::Server:
 		case InputMode::Linker:
 			return false;
 		}
@@ -591,7 +618,7 @@ General Information)").c_str(),
 			g_strEVMVersion.c_str(),
 			po::value<string>()->value_name("version")->default_value(EVMVersion{}.name()),
 			"Select desired EVM version. Either homestead, tangerineWhistle, spuriousDragon, "
-			"byzantium, constantinople, petersburg, istanbul, berlin, london or paris."
+			"byzantium, constantinople, petersburg, istanbul, berlin, london, paris, shanghai or cancun."
 		)
 	;
 	if (!_forHelp) // Note: We intentionally keep this undocumented for now.
@@ -630,6 +657,13 @@ General Information)").c_str(),
 			po::value<string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Store optimized Yul IR and answers of the model checker solvers in the given directory "
+			"and reuse them in later runs to skip the Yul optimizer for contracts whose IR and settings "
+			"did not change and the solvers for queries that did not change."
+		)
 	;
 	desc.add(outputOptions);
 
@@ -669,6 +703,12 @@ General Information)").c_str(),
 			"Supported Inputs is the output of the --" + g_strStandardJSON + " or the one produced by "
 			"--" + g_strCombinedJson + " " + CombinedJsonRequests::componentName(&CombinedJsonRequests::ast)).c_str()
 		)
+		(
+			g_strServer.c_str(),
+			("Switch to batch compilation server mode. Reads Standard JSON requests from standard input, "
+			"one per line, and writes the output for each of them as a single line to standard output. "
+			"Artifacts cached during one compilation are reused by later ones, also without --" + g_strCacheDir + ".").c_str()
+		)
 		(
 			g_strLSP.c_str(),
 			"Switch to language server mode (\"LSP\"). Allows the compiler to be used as an analysis backend "
@@ -757,6 +797,25 @@ General Information)").c_str(),
 			g_strGas.c_str(),
 			"Print an estimate of the maximal gas usage for each function."
 		)
+		(
+			g_strGasPathBudget.c_str(),
+			po::value<unsigned>()->value_name("paths"),
+			"Set the maximal number of code paths explored for the estimate of each function by --gas. "
+			"Functions that need more paths are reported with infinite gas usage."
+		)
+		(
+			g_strTimeReport.c_str(),
+			"Print the wall time and the increase of the peak memory usage of the parsing and analysis phases "
+			"and, for each contract, of the code generation, optimization, assembly and metadata phases."
+		)
+		(
+			g_strTraceEvents.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write a timeline of the compilation to the given file in the trace event format of Chrome, "
+			"which can be viewed with Perfetto or chrome://tracing. It contains the compilation phases, "
+			"the code generation of each contract, the Yul optimizer steps run on each object, the "
+			"optimization of each EVM assembly and the queries of the model checker on every thread."
+		)
 		(
 			g_strCombinedJson.c_str(),
 			po::value<string>()->value_name(util::joinHumanReadable(CombinedJsonRequests::componentMap() | ranges::views::keys, ",")),
@@ -810,11 +869,33 @@ General Information)").c_str(),
 			po::value<string>()->value_name("steps"),
 			"Forces yul optimizer to use the specified sequence of optimization steps instead of the built-in one."
 		)
+		(
+			g_strOptimizerProfile.c_str(),
+			po::value<string>()->value_name("json"),
+			"Output the time spent in and the code size changes caused by each Yul optimizer step, "
+			"separately for every Yul object optimized as part of the IR of a contract, "
+			"as well as the number of applications of each optimization of the assembly optimizer. "
+			"The only supported format is \"json\"."
+		)
+		(
+			g_strOptimizerThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads the compiler may use to process independent parts of the code in parallel. "
+			"The compiled output does not depend on the number of threads, "
+			"but counterexamples found by the CHC engine of the model checker can."
+		)
 	;
 	desc.add(optimizerOptions);
 
 	po::options_description smtCheckerOptions("Model Checker Options");
 	smtCheckerOptions.add_options()
+		(
+			g_strModelCheckerBudget.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Set the wall-clock time in milliseconds the model checker may spend in total. "
+			"Queries are given short timeouts first and unresolved targets are retried with longer ones "
+			"as long as the budget lasts. --model-checker-timeout limits the timeout of a single query."
+		)
 		(
 			g_strModelCheckerContracts.c_str(),
 			po::value<string>()->value_name("default,<source>:<contract>")->default_value("default"),
@@ -845,6 +926,11 @@ General Information)").c_str(),
 			" Multiple types of invariants can be selected at the same time, separated by a comma and no spaces."
 			" By default no invariants are reported."
 		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run the enabled SMT solvers concurrently on every BMC query and use the first answer"
+			" instead of running them one after another and checking that they agree."
+		)
 		(
 			g_strModelCheckerShowUnproved.c_str(),
 			"Show all unproved targets separately."
@@ -868,6 +954,11 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerVerdictsOnly.c_str(),
+			"Only report whether the targets are safe, unsafe or unproved, without counterexamples."
+			" The answers of unsafe queries are then stored in the compilation cache as well."
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -916,7 +1007,8 @@ void CommandLineParser::processArgs()
 		g_strStrictAssembly,
 		g_strYul,
 		g_strImportAst,
-		g_strLSP
+		g_strLSP,
+		g_strServer
 	});
 
 	if (m_args.count(g_strHelp) > 0)
@@ -929,6 +1021,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::StandardJson;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
+	else if (m_args.count(g_strServer))
+		m_options.input.mode = InputMode::Server;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0 || m_args.count(g_strYul) > 0)
 		m_options.input.mode = InputMode::Assembler;
 	else if (m_args.count(g_strLink) > 0)
@@ -948,6 +1042,11 @@ void CommandLineParser::processArgs()
 	map<string, set<InputMode>> validOptionInputModeCombinations = {
 		// TODO: This should eventually contain all options.
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCacheDir, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::Server}},
+		{g_strOptimizerProfile, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strTimeReport, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strTraceEvents, {InputMode::Compiler, InputMode::CompilerWithASTImport, InputMode::StandardJson, InputMode::Assembler}},
+		{g_strGasPathBudget, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -957,8 +1056,11 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerDivModNoSlacks, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerEngine, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerInvariants, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerRaceSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerSolvers, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerVerdictsOnly, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strModelCheckerBudget, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
 	};
@@ -1066,6 +1168,13 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strOutputDir))
 		m_options.output.dir = m_args.at(g_strOutputDir).as<string>();
 
+	if (m_args.count(g_strCacheDir))
+	{
+		m_options.output.cacheDir = m_args.at(g_strCacheDir).as<string>();
+		if (m_options.output.cacheDir.empty())
+			solThrow(CommandLineValidationError, "Empty value is not allowed in --" + g_strCacheDir + ".");
+	}
+
 	m_options.output.overwriteFiles = (m_args.count(g_strOverwrite) > 0);
 
 	if (m_args.count(g_strPrettyJson) > 0)
@@ -1081,6 +1190,19 @@ void CommandLineParser::processArgs()
 	parseOutputSelection();
 
 	m_options.compiler.estimateGas = (m_args.count(g_strGas) > 0);
+	if (m_args.count(g_strGasPathBudget))
+	{
+		if (!m_options.compiler.estimateGas)
+			solThrow(CommandLineValidationError, "--" + g_strGasPathBudget + " requires --" + g_strGas + ".");
+		m_options.compiler.gasPathBudget = m_args[g_strGasPathBudget].as<unsigned>();
+	}
+	m_options.compiler.timeReport = (m_args.count(g_strTimeReport) > 0);
+	if (m_args.count(g_strTraceEvents))
+	{
+		m_options.compiler.traceEventsFile = m_args.at(g_strTraceEvents).as<string>();
+		if (m_options.compiler.traceEventsFile.empty())
+			solThrow(CommandLineValidationError, "Empty value is not allowed in --" + g_strTraceEvents + ".");
+	}
 
 	if (m_args.count(g_strBasePath))
 		m_options.input.basePath = m_args[g_strBasePath].as<string>();
@@ -1115,9 +1237,20 @@ void CommandLineParser::processArgs()
 			m_options.output.stopAfter = CompilerStack::State::Parsed;
 	}
 
+	m_options.optimizer.threads = m_args[g_strOptimizerThreads].as<unsigned>();
+	if (m_options.optimizer.threads == 0)
+		solThrow(CommandLineValidationError, "--" + g_strOptimizerThreads + " must be at least 1.");
+
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::Server && m_options.formatting.json.format != util::JsonFormat::Compact)
+		solThrow(
+			CommandLineValidationError,
+			"--" + g_strPrettyJson + " and --" + g_strJsonIndent + " are not supported with --" + g_strServer + ", "
+			"since every output has to fit on a single line."
+		);
+
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -1171,6 +1304,15 @@ void CommandLineParser::processArgs()
 		m_options.optimizer.yulSteps = m_args[g_strYulOptimizations].as<string>();
 	}
 
+	if (m_args.count(g_strOptimizerProfile))
+	{
+		string format = m_args[g_strOptimizerProfile].as<string>();
+		if (format != "json")
+			solThrow(CommandLineValidationError, "Invalid format for --" + g_strOptimizerProfile + ": " + format + ". The only supported format is \"json\".");
+
+		m_options.optimizer.profile = true;
+	}
+
 	if (m_options.input.mode == InputMode::Assembler)
 	{
 		vector<string> const nonAssemblyModeOptions = {
@@ -1275,6 +1417,9 @@ void CommandLineParser::processArgs()
 		m_options.metadata.format = CompilerStack::MetadataFormat::NoMetadata;
 	}
 
+	if (m_args.count(g_strModelCheckerBudget))
+		m_options.modelChecker.settings.budget = m_args[g_strModelCheckerBudget].as<unsigned>();
+
 	if (m_args.count(g_strModelCheckerContracts))
 	{
 		string contractsStr = m_args[g_strModelCheckerContracts].as<string>();
@@ -1314,6 +1459,9 @@ void CommandLineParser::processArgs()
 		m_options.modelChecker.settings.invariants = *invs;
 	}
 
+	if (m_args.count(g_strModelCheckerRaceSolvers))
+		m_options.modelChecker.settings.raceSolvers = true;
+
 	if (m_args.count(g_strModelCheckerShowUnproved))
 		m_options.modelChecker.settings.showUnproved = true;
 
@@ -1338,17 +1486,23 @@ void CommandLineParser::processArgs()
 	if (m_args.count(g_strModelCheckerTimeout))
 		m_options.modelChecker.settings.timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_strModelCheckerVerdictsOnly))
+		m_options.modelChecker.settings.verdictsOnly = true;
+
 	m_options.metadata.literalSources = (m_args.count(g_strMetadataLiteral) > 0);
 	m_options.modelChecker.initialize =
+		m_args.count(g_strModelCheckerBudget) ||
 		m_args.count(g_strModelCheckerContracts) ||
 		m_args.count(g_strModelCheckerDivModNoSlacks) ||
 		m_args.count(g_strModelCheckerEngine) ||
 		m_args.count(g_strModelCheckerExtCalls) ||
 		m_args.count(g_strModelCheckerInvariants) ||
+		m_args.count(g_strModelCheckerRaceSolvers) ||
 		m_args.count(g_strModelCheckerShowUnproved) ||
 		m_args.count(g_strModelCheckerSolvers) ||
 		m_args.count(g_strModelCheckerTargets) ||
-		m_args.count(g_strModelCheckerTimeout);
+		m_args.count(g_strModelCheckerTimeout) ||
+		m_args.count(g_strModelCheckerVerdictsOnly);
 	m_options.output.viaIR = (m_args.count(g_strExperimentalViaIR) > 0 || m_args.count(g_strViaIR) > 0);
 	if (m_options.input.mode == InputMode::Compiler)
 		m_options.input.errorRecovery = (m_args.count(g_strErrorRecovery) > 0);
@@ -56,7 +56,8 @@ enum class InputMode
 	StandardJson,
 	Linker,
 	Assembler,
-	LanguageServer
+	LanguageServer,
+	Server
 };
 
 struct CompilerOutputs
@@ -187,6 +188,7 @@ struct CommandLineOptions
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
 		std::optional<uint8_t> eofVersion;
+		boost::filesystem::path cacheDir;
 	} output;
 
 	struct
@@ -211,6 +213,9 @@ struct CommandLineOptions
 	{
 		CompilerOutputs outputs;
 		bool estimateGas = false;
+		std::optional<size_t> gasPathBudget;
+		bool timeReport = false;
+		boost::filesystem::path traceEventsFile;
 		std::optional<CombinedJsonRequests> combinedJsonRequests;
 	} compiler;
 
@@ -227,6 +232,8 @@ struct CommandLineOptions
 		std::optional<unsigned> expectedExecutionsPerDeployment;
 		bool noOptimizeYul = false;
 		std::optional<std::string> yulSteps;
+		bool profile = false;
+		unsigned threads = 1;
 	} optimizer;
 
 	struct
@@ -31,6 +31,8 @@
 #include <libsolutil/Keccak256.h>
 #include <libsolutil/picosha2.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -40,7 +42,8 @@ using namespace evmc::literals;
 evmc::VM& EVMHost::getVM(string const& _path)
 {
 	static evmc::VM NullVM{nullptr};
-	static map<string, unique_ptr<evmc::VM>> vms;
+	// VM instances must not be shared between threads running test cases in parallel.
+	thread_local map<string, unique_ptr<evmc::VM>> vms;
 	if (vms.count(_path) == 0)
 	{
 		evmc_loader_error_code errorCode = {};
@@ -124,6 +127,10 @@ EVMHost::EVMHost(langutil::EVMVersion _evmVersion, evmc::VM& _vm):
 		m_evmRevision = EVMC_LONDON;
 	else if (_evmVersion == langutil::EVMVersion::paris())
 		m_evmRevision = EVMC_PARIS;
+	else if (_evmVersion == langutil::EVMVersion::shanghai())
+		m_evmRevision = EVMC_SHANGHAI;
+	else if (_evmVersion == langutil::EVMVersion::cancun())
+		m_evmRevision = EVMC_CANCUN;
 	else
 		assertThrow(false, Exception, "Unsupported EVM version");
 
@@ -157,6 +164,7 @@ void EVMHost::reset()
 	recorded_calls.clear();
 	// Clear EIP-2929 account access indicator
 	recorded_account_accesses.clear();
+	m_journal.clear();
 
 	// Mark all precompiled contracts as existing. Existing here means to have a balance (as per EIP-161).
 	// NOTE: keep this in sync with `EVMHost::call` below.
@@ -175,6 +183,18 @@ void EVMHost::reset()
 	}
 }
 
+void EVMHost::restore(Snapshot const& _snapshot)
+{
+	accounts = _snapshot.accounts;
+	tx_context = _snapshot.txContext;
+	recorded_selfdestructs.clear();
+	recorded_calls.clear();
+	recorded_account_accesses.clear();
+	recorded_blockhashes.clear();
+	recorded_logs.clear();
+	m_journal.clear();
+}
+
 void EVMHost::newTransactionFrame()
 {
 	// Clear EIP-2929 account access indicator
@@ -203,61 +223,160 @@ bool EVMHost::selfdestruct(const evmc::address& _addr, const evmc::address& _ben
 {
 	// TODO actual selfdestruct is even more complicated.
 
+	journalAccount(_addr);
+	journalAccount(_beneficiary);
 	transfer(accounts[_addr], accounts[_beneficiary], convertFromEVMC(accounts[_addr].balance));
 
 	// Record self destructs. Clearing will be done in newTransactionFrame().
 	return MockedHost::selfdestruct(_addr, _beneficiary);
 }
 
+evmc_storage_status EVMHost::set_storage(
+	evmc::address const& _addr,
+	evmc::bytes32 const& _key,
+	evmc::bytes32 const& _value
+) noexcept
+{
+	journalStorage(_addr, _key);
+	return MockedHost::set_storage(_addr, _key, _value);
+}
+
+evmc_access_status EVMHost::access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept
+{
+	journalStorage(_addr, _key);
+	return MockedHost::access_storage(_addr, _key);
+}
+
 void EVMHost::recordCalls(evmc_message const& _message) noexcept
 {
 	if (recorded_calls.size() < max_recorded_calls)
 		recorded_calls.emplace_back(_message);
 }
 
-// NOTE: this is used for both internal and external calls.
-// External calls are triggered from ExecutionFramework and contain only EVMC_CREATE or EVMC_CALL.
-evmc::Result EVMHost::call(evmc_message const& _message) noexcept
+void EVMHost::journalAccount(evmc::address const& _addr)
 {
-	recordCalls(_message);
-	if (_message.recipient == 0x0000000000000000000000000000000000000001_address)
-		return precompileECRecover(_message);
-	else if (_message.recipient == 0x0000000000000000000000000000000000000002_address)
-		return precompileSha256(_message);
-	else if (_message.recipient == 0x0000000000000000000000000000000000000003_address)
-		return precompileRipeMD160(_message);
-	else if (_message.recipient == 0x0000000000000000000000000000000000000004_address)
-		return precompileIdentity(_message);
-	else if (_message.recipient == 0x0000000000000000000000000000000000000005_address && m_evmVersion >= langutil::EVMVersion::byzantium())
-		return precompileModExp(_message);
-	else if (_message.recipient == 0x0000000000000000000000000000000000000006_address && m_evmVersion >= langutil::EVMVersion::byzantium())
+	JournalEntry entry{_addr, nullopt, nullopt, nullopt, false};
+	if (auto account = accounts.find(_addr); account != accounts.end())
 	{
-		if (m_evmVersion <= langutil::EVMVersion::istanbul())
-			return precompileALTBN128G1Add<EVMC_ISTANBUL>(_message);
-		else
-			return precompileALTBN128G1Add<EVMC_LONDON>(_message);
+		entry.account = evmc::MockedAccount{};
+		entry.account->nonce = account->second.nonce;
+		// Code is only ever set on accounts without code, so it does not have to be copied.
+		entry.hadCode = !account->second.code.empty();
+		entry.account->codehash = account->second.codehash;
+		entry.account->balance = account->second.balance;
 	}
-	else if (_message.recipient == 0x0000000000000000000000000000000000000007_address && m_evmVersion >= langutil::EVMVersion::byzantium())
+	m_journal.emplace_back(std::move(entry));
+}
+
+void EVMHost::journalStorage(evmc::address const& _addr, evmc::bytes32 const& _key)
+{
+	auto account = accounts.find(_addr);
+	if (account == accounts.end())
 	{
-		if (m_evmVersion <= langutil::EVMVersion::istanbul())
-			return precompileALTBN128G1Mul<EVMC_ISTANBUL>(_message);
-		else
-			return precompileALTBN128G1Mul<EVMC_LONDON>(_message);
+		// Reverting the creation of the account also removes the slot.
+		journalAccount(_addr);
+		return;
 	}
-	else if (_message.recipient == 0x0000000000000000000000000000000000000008_address && m_evmVersion >= langutil::EVMVersion::byzantium())
+
+	JournalEntry entry{_addr, _key, nullopt, nullopt, false};
+	if (auto slot = account->second.storage.find(_key); slot != account->second.storage.end())
+		entry.storageValue = slot->second;
+	m_journal.emplace_back(std::move(entry));
+}
+
+void EVMHost::revertJournal(size_t _checkpoint)
+{
+	for (; m_journal.size() > _checkpoint; m_journal.pop_back())
 	{
-		if (m_evmVersion <= langutil::EVMVersion::istanbul())
-			return precompileALTBN128PairingProduct<EVMC_ISTANBUL>(_message);
+		JournalEntry& entry = m_journal.back();
+		if (entry.key.has_value())
+		{
+			auto account = accounts.find(entry.address);
+			if (account == accounts.end())
+				continue;
+			if (entry.storageValue.has_value())
+				account->second.storage[*entry.key] = *entry.storageValue;
+			else
+				account->second.storage.erase(*entry.key);
+		}
+		else if (entry.account.has_value())
+		{
+			evmc::MockedAccount& account = accounts[entry.address];
+			account.nonce = entry.account->nonce;
+			if (!entry.hadCode)
+				account.code.clear();
+			account.codehash = entry.account->codehash;
+			account.balance = entry.account->balance;
+		}
 		else
-			return precompileALTBN128PairingProduct<EVMC_LONDON>(_message);
+			accounts.erase(entry.address);
 	}
+}
 
-	auto const stateBackup = accounts;
+// NOTE: this is used for both internal and external calls.
+// External calls are triggered from ExecutionFramework and contain only EVMC_CREATE or EVMC_CALL.
+evmc::Result EVMHost::call(evmc_message const& _message) noexcept
+{
+	recordCalls(_message);
+	// Precompiles live at the addresses 1 to 8, so they are dispatched on the last byte
+	// once the leading bytes are known to be zero instead of comparing whole addresses.
+	evmc::address const& recipient = _message.recipient;
+	if (all_of(begin(recipient.bytes), end(recipient.bytes) - 1, [](uint8_t _byte) { return _byte == 0; }))
+	{
+		bool const byzantium = m_evmVersion >= langutil::EVMVersion::byzantium();
+		bool const istanbul = m_evmVersion <= langutil::EVMVersion::istanbul();
+		switch (recipient.bytes[sizeof(recipient.bytes) - 1])
+		{
+		case 1:
+			return precompileECRecover(_message);
+		case 2:
+			return precompileSha256(_message);
+		case 3:
+			return precompileRipeMD160(_message);
+		case 4:
+			return precompileIdentity(_message);
+		case 5:
+			if (byzantium)
+				return precompileModExp(_message);
+			break;
+		case 6:
+			if (byzantium)
+				return istanbul ?
+					precompileALTBN128G1Add<EVMC_ISTANBUL>(_message) :
+					precompileALTBN128G1Add<EVMC_LONDON>(_message);
+			break;
+		case 7:
+			if (byzantium)
+				return istanbul ?
+					precompileALTBN128G1Mul<EVMC_ISTANBUL>(_message) :
+					precompileALTBN128G1Mul<EVMC_LONDON>(_message);
+			break;
+		case 8:
+			if (byzantium)
+				return istanbul ?
+					precompileALTBN128PairingProduct<EVMC_ISTANBUL>(_message) :
+					precompileALTBN128PairingProduct<EVMC_LONDON>(_message);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Changes made by this call (including nested calls) are undone if it fails.
+	size_t const journalCheckpoint = m_journal.size();
+	auto revertState = [&]() {
+		revertJournal(journalCheckpoint);
+		if (_message.depth == 0)
+			m_journal.clear();
+	};
 
 	u256 value{convertFromEVMC(_message.value)};
+	journalAccount(_message.sender);
 	auto& sender = accounts[_message.sender];
 
-	evmc::bytes code;
+	// The code is executed in place: the init code of a creation is the input of the message
+	// and the code of an existing account does not change while it runs.
+	evmc::bytes_view code;
 
 	evmc_message message = _message;
 	if (message.depth == 0)
@@ -269,7 +388,7 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::Result result;
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertState();
 			return result;
 		}
 	}
@@ -307,7 +426,7 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		message.recipient = convertToEVMC(createAddress);
 		assertThrow(accounts.count(message.recipient) == 0, Exception, "Account cannot exist");
 
-		code = evmc::bytes(message.input_data, message.input_data + message.input_size);
+		code = {message.input_data, message.input_size};
 	}
 	else if (message.kind == EVMC_CREATE2)
 	{
@@ -326,15 +445,21 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::Result result;
 			result.status_code = EVMC_OUT_OF_GAS;
-			accounts = stateBackup;
+			revertState();
 			return result;
 		}
 
-		code = evmc::bytes(message.input_data, message.input_data + message.input_size);
+		code = {message.input_data, message.input_size};
 	}
 	else
+	{
+		journalAccount(message.code_address);
+		// References into the account map stay valid when it grows, the account is not removed
+		// before this call returns and reverting the journal never replaces existing code.
 		code = accounts[message.code_address].code;
+	}
 
+	journalAccount(message.recipient);
 	auto& destination = accounts[message.recipient];
 
 	if (value != 0 && message.kind != EVMC_DELEGATECALL && message.kind != EVMC_CALLCODE)
@@ -343,7 +468,7 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 		{
 			evmc::Result result;
 			result.status_code = EVMC_INSUFFICIENT_BALANCE;
-			accounts = stateBackup;
+			revertState();
 			return result;
 		}
 		transfer(sender, destination, value);
@@ -377,7 +502,9 @@ evmc::Result EVMHost::call(evmc_message const& _message) noexcept
 	}
 
 	if (result.status_code != EVMC_SUCCESS)
-		accounts = stateBackup;
+		revertState();
+	else if (_message.depth == 0)
+		m_journal.clear();
 
 	return result;
 }
@@ -48,7 +48,6 @@ public:
 	// Verbatim features of MockedHost.
 	using MockedHost::account_exists;
 	using MockedHost::get_storage;
-	using MockedHost::set_storage;
 	using MockedHost::get_balance;
 	using MockedHost::get_code_size;
 	using MockedHost::get_code_hash;
@@ -56,9 +55,14 @@ public:
 	using MockedHost::get_tx_context;
 	using MockedHost::emit_log;
 	using MockedHost::access_account;
-	using MockedHost::access_storage;
 
 	// Modified features of MockedHost.
+	evmc_storage_status set_storage(
+		evmc::address const& _addr,
+		evmc::bytes32 const& _key,
+		evmc::bytes32 const& _value
+	) noexcept final;
+	evmc_access_status access_storage(evmc::address const& _addr, evmc::bytes32 const& _key) noexcept final;
 	bool selfdestruct(evmc::address const& _addr, evmc::address const& _beneficiary) noexcept final;
 	evmc::Result call(evmc_message const& _message) noexcept final;
 	evmc::bytes32 get_block_hash(int64_t number) const noexcept final;
@@ -66,6 +70,7 @@ public:
 	// Solidity testing specific features.
 
 	/// Tries to dynamically load an evmc vm supporting evm1 or ewasm and caches the loaded VM.
+	/// Every thread gets its own instance.
 	/// @returns vmc::VM(nullptr) on failure.
 	static evmc::VM& getVM(std::string const& _path = {});
 
@@ -81,6 +86,20 @@ public:
 	/// Reset entire state (including accounts).
 	void reset();
 
+	/// Accounts and transaction context of the host, as returned by snapshot().
+	struct Snapshot
+	{
+		std::unordered_map<evmc::address, evmc::MockedAccount> accounts;
+		evmc_tx_context txContext;
+	};
+
+	/// @returns a copy of the current accounts and transaction context.
+	/// Restoring it is cheaper than constructing a new host, which lets fuzzers reuse a single host.
+	Snapshot snapshot() const { return {accounts, tx_context}; }
+
+	/// Returns to the state of @a _snapshot and clears all records.
+	void restore(Snapshot const& _snapshot);
+
 	/// Start new block.
 	void newBlock()
 	{
@@ -109,6 +128,15 @@ private:
 	/// Records calls made via @param _message.
 	void recordCalls(evmc_message const& _message) noexcept;
 
+	/// Records the current state of the account, except for its storage, in the journal.
+	/// Must be called before the account is created or modified during a call.
+	void journalAccount(evmc::address const& _addr);
+	/// Records the current state of the storage slot in the journal.
+	/// Must be called before the slot is created or modified during a call.
+	void journalStorage(evmc::address const& _addr, evmc::bytes32 const& _key);
+	/// Undoes the changes recorded in the journal after it had @a _checkpoint entries.
+	void revertJournal(size_t _checkpoint);
+
 	static evmc::Result precompileECRecover(evmc_message const& _message) noexcept;
 	static evmc::Result precompileSha256(evmc_message const& _message) noexcept;
 	static evmc::Result precompileRipeMD160(evmc_message const& _message) noexcept;
@@ -127,6 +155,25 @@ private:
 	static evmc::Result resultWithGas(int64_t gas_limit, int64_t gas_required, bytes const& _data) noexcept;
 	static evmc::Result resultWithFailure() noexcept;
 
+	/// State of an account or a storage slot before it was changed by a call.
+	struct JournalEntry
+	{
+		evmc::address address;
+		/// The changed storage slot or nullopt if the entry is about the account itself.
+		std::optional<evmc::bytes32> key;
+		/// The account without its storage and code or nullopt if it did not exist.
+		std::optional<evmc::MockedAccount> account;
+		/// The value of the slot or nullopt if it did not exist.
+		std::optional<evmc::StorageValue> storageValue;
+		/// Whether the account had code. Existing code is never changed, so reverting only
+		/// has to remove the code of accounts that had none.
+		bool hadCode = false;
+	};
+
+	/// Changes to the accounts made in the current transaction. Lets a failing call undo its
+	/// changes without keeping a copy of the whole state for every call frame.
+	std::vector<JournalEntry> m_journal;
+
 	evmc::VM& m_vm;
 	/// EVM version requested by the testing tool
 	langutil::EVMVersion m_evmVersion;
@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+
+"""
+Measures the compilation time of a corpus of contracts and detects regressions.
+
+Every benchmark is compiled with the optimizer, once with the legacy pipeline and once via IR.
+For each pipeline, the report contains the wall time and peak memory of the compiler process
+and the time spent in each compilation phase, as reported by the ``evm.compilationStats``
+output of the Standard JSON interface. Every compilation is repeated and the median of each
+measurement is stored together with the spread of the samples.
+
+Usage:
+
+    test/benchmarks/compile_time.py run [--solc PATH] [--repeat N] [--corpus PATH ...] [--output FILE]
+    test/benchmarks/compile_time.py compare BASE_REPORT REPORT [--threshold PERCENT]
+
+The corpus consists of ``chains.sol``, ``OptimizorClub.sol`` and ``verifier.sol`` from this
+directory and every PATH given with ``--corpus``. A PATH can be a single source file or a
+directory, e.g. the checkout of an external test project. All ``.sol`` files in a directory
+are compiled together, with imports resolved relative to the directory and its
+``node_modules`` subdirectory.
+
+``compare`` exits with a non-zero status if a measurement of REPORT exceeds the one of
+BASE_REPORT by more than PERCENT percent (10 by default). Phases that took less than
+10 milliseconds in the base report are not checked, because their timing is dominated by noise.
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+BENCHMARKS_DIR = REPO_ROOT / 'test' / 'benchmarks'
+BENCHMARKS = ['chains.sol', 'OptimizorClub.sol', 'verifier.sol']
+PIPELINES = {'legacy': False, 'via-ir': True}
+MIN_CHECKED_PHASE_DURATION_IN_MICROSECONDS = 10000
+
+
+def corpus(paths):
+    """Yields the name, base path and source files of every benchmark."""
+    for benchmark in BENCHMARKS:
+        yield benchmark, BENCHMARKS_DIR, [BENCHMARKS_DIR / benchmark]
+
+    for name in paths:
+        path = Path(name).resolve()
+        if path.is_dir():
+            sources = sorted(
+                source for source in path.rglob('*.sol')
+                if 'node_modules' not in source.relative_to(path).parts
+            )
+            yield name, path, sources
+        else:
+            yield name, path.parent, [path]
+
+
+def compile_once(solc, base_path, sources, via_ir):
+    """Compiles the sources once and returns the measurements of this run."""
+    standard_json = {
+        'language': 'Solidity',
+        'sources': {
+            str(source.relative_to(base_path)): {'content': source.read_text(encoding='utf8')}
+            for source in sources
+        },
+        'settings': {
+            'optimizer': {'enabled': True},
+            'viaIR': via_ir,
+            'outputSelection': {'*': {'*': ['evm.bytecode.object', 'evm.compilationStats']}},
+        },
+    }
+
+    command = [solc, '--standard-json', '--base-path', str(base_path)]
+    if (base_path / 'node_modules').is_dir():
+        command += ['--include-path', str(base_path / 'node_modules')]
+
+    start = time.perf_counter()
+    with subprocess.Popen(command, stdin=subprocess.PIPE, stdout=subprocess.PIPE, encoding='utf8') as process:
+        # The compiler reads all of its input before it writes anything.
+        process.stdin.write(json.dumps(standard_json))
+        process.stdin.close()
+        output = process.stdout.read()
+        # Unlike getrusage(RUSAGE_CHILDREN), wait4() reports the peak memory of this process only.
+        _, status, usage = os.wait4(process.pid, 0)
+        process.returncode = os.waitstatus_to_exitcode(status)
+    wall_time = time.perf_counter() - start
+
+    result = json.loads(output)
+    errors = [error['formattedMessage'] for error in result.get('errors', []) if error['severity'] == 'error']
+
+    phases = {}
+    shared_phases_counted = False
+    for source_contracts in result.get('contracts', {}).values():
+        for contract in source_contracts.values():
+            stats = contract.get('evm', {}).get('compilationStats', {})
+            # The shared phases are reported for every contract, but ran only once.
+            phase_lists = [stats.get('phases', [])]
+            if not shared_phases_counted and 'sharedPhases' in stats:
+                phase_lists.append(stats['sharedPhases'])
+                shared_phases_counted = True
+            for phase_list in phase_lists:
+                for phase in phase_list:
+                    phases[phase['name']] = phases.get(phase['name'], 0) + phase['durationInMicroseconds']
+
+    return {
+        'wallTimeInMicroseconds': round(wall_time * 1000000),
+        # ru_maxrss is in KiB on Linux.
+        'peakMemoryInKiB': usage.ru_maxrss,
+        'phases': phases,
+    }, errors
+
+
+def summarize(samples):
+    """Returns the median and the relative spread of the samples."""
+    median = statistics.median(samples)
+    return {
+        'median': median,
+        'spreadInPercent': round((max(samples) - min(samples)) / median * 100, 1) if median != 0 else 0.0,
+    }
+
+
+def run_benchmark(solc, base_path, sources, via_ir, repeat):
+    """Compiles the sources repeatedly and returns the summarized measurements."""
+    runs = []
+    errors = []
+    for _ in range(repeat):
+        measurements, errors = compile_once(solc, base_path, sources, via_ir)
+        runs.append(measurements)
+
+    phase_names = sorted({name for measurements in runs for name in measurements['phases']})
+    return {
+        'wallTimeInMicroseconds': summarize([measurements['wallTimeInMicroseconds'] for measurements in runs]),
+        'peakMemoryInKiB': summarize([measurements['peakMemoryInKiB'] for measurements in runs]),
+        'phases': {
+            name: summarize([measurements['phases'].get(name, 0) for measurements in runs])
+            for name in phase_names
+        },
+        'errors': errors,
+    }
+
+
+def solc_version(solc):
+    return subprocess.run([solc, '--version'], stdout=subprocess.PIPE, encoding='utf8', check=True).stdout.strip().splitlines()[-1]
+
+
+def run(args):
+    report = {
+        'solc': solc_version(args.solc),
+        'repeat': args.repeat,
+        'benchmarks': {},
+    }
+    for name, base_path, sources in corpus(args.corpus):
+        report['benchmarks'][name] = {}
+        for pipeline, via_ir in PIPELINES.items():
+            print(f'Running {name} ({pipeline})...', file=sys.stderr)
+            report['benchmarks'][name][pipeline] = run_benchmark(args.solc, base_path, sources, via_ir, args.repeat)
+
+    output = json.dumps(report, indent=4, sort_keys=True) + '\n'
+    if args.output is None:
+        sys.stdout.write(output)
+    else:
+        Path(args.output).write_text(output, encoding='utf8')
+
+
+def measurements(result):
+    """Yields the name, median and whether to check for regressions of every measurement of a result."""
+    yield 'wallTimeInMicroseconds', result['wallTimeInMicroseconds']['median'], True
+    yield 'peakMemoryInKiB', result['peakMemoryInKiB']['median'], True
+    for name, phase in result['phases'].items():
+        yield f'phases.{name}', phase['median'], phase['median'] >= MIN_CHECKED_PHASE_DURATION_IN_MICROSECONDS
+
+
+def compare(args):
+    base = json.loads(Path(args.base).read_text(encoding='utf8'))
+    new = json.loads(Path(args.report).read_text(encoding='utf8'))
+
+    regressions = []
+    for name in sorted(set(base['benchmarks']) | set(new['benchmarks'])):
+        if name not in base['benchmarks'] or name not in new['benchmarks']:
+            print(f'{name}: only in {"the new" if name in new["benchmarks"] else "the base"} report')
+            continue
+        for pipeline in PIPELINES:
+            base_result = base['benchmarks'][name].get(pipeline)
+            new_result = new['benchmarks'][name].get(pipeline)
+            if base_result is None or new_result is None:
+                continue
+            print(f'{name} ({pipeline})')
+            new_values = {counter: value for counter, value, _ in measurements(new_result)}
+            for counter, base_value, checked in measurements(base_result):
+                if counter not in new_values:
+                    continue
+                new_value = new_values[counter]
+                change = (new_value - base_value) / base_value * 100 if base_value != 0 else 0.0
+                regression = checked and change > args.threshold
+                if regression:
+                    regressions.append(f'{name} ({pipeline}) {counter}: {change:+.1f}%')
+                print(f'    {counter:<40} {base_value:>14} {new_value:>14} {change:>+8.1f}%{" REGRESSION" if regression else ""}')
+
+    if regressions:
+        print(f'\n{len(regressions)} measurement(s) regressed by more than {args.threshold}%:', file=sys.stderr)
+        for regression in regressions:
+            print(f'    {regression}', file=sys.stderr)
+        sys.exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser('run', help='Run the benchmarks and write a report.')
+    run_parser.add_argument(
+        '--solc',
+        default=str(Path(os.environ.get('SOLIDITY_BUILD_DIR', REPO_ROOT / 'build')) / 'solc' / 'solc'),
+        help='Path to the compiler. Defaults to $SOLIDITY_BUILD_DIR/solc/solc.',
+    )
+    run_parser.add_argument('--repeat', type=int, default=5, help='Number of compilations of each benchmark.')
+    run_parser.add_argument(
+        '--corpus',
+        nargs='+',
+        default=[],
+        metavar='PATH',
+        help='Additional source files or directories to compile.',
+    )
+    run_parser.add_argument('--output', help='File to write the report to instead of stdout.')
+    run_parser.set_defaults(function=run)
+
+    compare_parser = subparsers.add_parser('compare', help='Compare two reports and fail on regressions.')
+    compare_parser.add_argument('base')
+    compare_parser.add_argument('report')
+    compare_parser.add_argument(
+        '--threshold',
+        type=float,
+        default=10.0,
+        metavar='PERCENT',
+        help='Largest accepted increase of a measurement in percent.',
+    )
+    compare_parser.set_defaults(function=compare)
+
+    args = parser.parse_args()
+    if args.command == 'run' and args.repeat < 1:
+        parser.error('--repeat must be at least 1.')
+    args.function(args)
+
+
+if __name__ == '__main__':
+    main()
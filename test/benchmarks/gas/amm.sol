@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+/// Constant product market maker. The token balances are kept in the pool itself
+/// instead of in separate token contracts.
+contract Pool {
+    mapping(address => uint256) public balance0;
+    mapping(address => uint256) public balance1;
+    mapping(address => uint256) public shares;
+    uint256 public reserve0;
+    uint256 public reserve1;
+    uint256 public totalShares;
+
+    function faucet(uint256 amount0, uint256 amount1) external {
+        balance0[msg.sender] += amount0;
+        balance1[msg.sender] += amount1;
+    }
+
+    function addLiquidity(uint256 amount0, uint256 amount1) external returns (uint256 minted) {
+        balance0[msg.sender] -= amount0;
+        balance1[msg.sender] -= amount1;
+        if (totalShares == 0)
+            minted = sqrt(amount0 * amount1);
+        else
+            minted = min(amount0 * totalShares / reserve0, amount1 * totalShares / reserve1);
+        require(minted > 0);
+        shares[msg.sender] += minted;
+        totalShares += minted;
+        reserve0 += amount0;
+        reserve1 += amount1;
+    }
+
+    function swap0For1(uint256 amountIn) external returns (uint256 amountOut) {
+        balance0[msg.sender] -= amountIn;
+        amountOut = amountAfterSwap(amountIn, reserve0, reserve1);
+        reserve0 += amountIn;
+        reserve1 -= amountOut;
+        balance1[msg.sender] += amountOut;
+    }
+
+    function swap1For0(uint256 amountIn) external returns (uint256 amountOut) {
+        balance1[msg.sender] -= amountIn;
+        amountOut = amountAfterSwap(amountIn, reserve1, reserve0);
+        reserve1 += amountIn;
+        reserve0 -= amountOut;
+        balance0[msg.sender] += amountOut;
+    }
+
+    function removeLiquidity(uint256 amount) external returns (uint256 amount0, uint256 amount1) {
+        amount0 = amount * reserve0 / totalShares;
+        amount1 = amount * reserve1 / totalShares;
+        shares[msg.sender] -= amount;
+        totalShares -= amount;
+        reserve0 -= amount0;
+        reserve1 -= amount1;
+        balance0[msg.sender] += amount0;
+        balance1[msg.sender] += amount1;
+    }
+
+    function amountAfterSwap(uint256 amountIn, uint256 reserveIn, uint256 reserveOut) internal pure returns (uint256) {
+        uint256 amountInWithFee = amountIn * 997;
+        return amountInWithFee * reserveOut / (reserveIn * 1000 + amountInWithFee);
+    }
+
+    function min(uint256 x, uint256 y) internal pure returns (uint256) {
+        return x < y ? x : y;
+    }
+
+    function sqrt(uint256 y) internal pure returns (uint256 z) {
+        if (y > 3) {
+            z = y;
+            uint256 x = y / 2 + 1;
+            while (x < z) {
+                z = x;
+                x = (y / x + x) / 2;
+            }
+        } else if (y != 0)
+            z = 1;
+    }
+}
+// ----
+// faucet(uint256,uint256): 1000000, 4000000 ->
+// addLiquidity(uint256,uint256): 100000, 400000 -> 200000
+// swap0For1(uint256): 1000 -> 3948
+// swap1For0(uint256): 5000 -> 1255
+// addLiquidity(uint256,uint256): 10000, 40000 -> 19947
+// removeLiquidity(uint256): 50000 -> 24948, 100263
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+contract Token {
+    event Transfer(address indexed from, address indexed to, uint256 value);
+    event Approval(address indexed owner, address indexed spender, uint256 value);
+
+    mapping(address => uint256) public balanceOf;
+    mapping(address => mapping(address => uint256)) public allowance;
+    uint256 public totalSupply;
+
+    constructor(uint256 supply) {
+        balanceOf[msg.sender] = supply;
+        totalSupply = supply;
+        emit Transfer(address(0), msg.sender, supply);
+    }
+
+    function transfer(address to, uint256 value) external returns (bool) {
+        balanceOf[msg.sender] -= value;
+        balanceOf[to] += value;
+        emit Transfer(msg.sender, to, value);
+        return true;
+    }
+
+    function approve(address spender, uint256 value) external returns (bool) {
+        allowance[msg.sender][spender] = value;
+        emit Approval(msg.sender, spender, value);
+        return true;
+    }
+
+    function transferFrom(address from, address to, uint256 value) external returns (bool) {
+        uint256 allowed = allowance[from][msg.sender];
+        if (allowed != type(uint256).max)
+            allowance[from][msg.sender] = allowed - value;
+        balanceOf[from] -= value;
+        balanceOf[to] += value;
+        emit Transfer(from, to, value);
+        return true;
+    }
+}
+// ----
+// constructor(): 1000000 ->
+// transfer(address,uint256): 0x1234, 1000 -> true
+// transfer(address,uint256): 0x1234, 500 -> true
+// approve(address,uint256): 0x1212121212121212121212121212120000000012, 300 -> true
+// transferFrom(address,address,uint256): 0x1212121212121212121212121212120000000012, 0x5678, 200 -> true
+// approve(address,uint256): 0x1212121212121212121212121212120000000012, -1 -> true
+// transferFrom(address,address,uint256): 0x1212121212121212121212121212120000000012, 0x5678, 300 -> true
+// balanceOf(address): 0x1234 -> 1500
+// transfer(address,uint256): 0x1234, 2000000 -> FAILURE, hex"4e487b71", 0x11
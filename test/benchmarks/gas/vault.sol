@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.8.0;
+
+/// Vault that issues shares for deposited ether. Yield paid into the vault
+/// increases the value of all shares.
+contract Vault {
+    mapping(address => uint256) public sharesOf;
+    uint256 public totalShares;
+
+    function deposit() external payable returns (uint256 minted) {
+        uint256 assets = address(this).balance - msg.value;
+        minted = totalShares == 0 ? msg.value : msg.value * totalShares / assets;
+        sharesOf[msg.sender] += minted;
+        totalShares += minted;
+    }
+
+    function harvest() external payable {}
+
+    function withdraw(uint256 shares) external returns (uint256 assets) {
+        assets = shares * address(this).balance / totalShares;
+        sharesOf[msg.sender] -= shares;
+        totalShares -= shares;
+        payable(msg.sender).transfer(assets);
+    }
+}
+// ----
+// deposit(), 1000 wei -> 1000
+// harvest(), 500 wei ->
+// deposit(), 300 wei -> 200
+// withdraw(uint256): 600 -> 900
+// withdraw(uint256): 700 -> FAILURE, hex"4e487b71", 0x11
@@ -0,0 +1,337 @@
+#!/usr/bin/env python3
+
+"""
+Measures the latency of the language server (``solc --lsp``) on a large workspace.
+
+The benchmark starts the language server on a workspace, opens some of its files and replays
+an editing session: every step edits one of the open files and then requests hover information,
+the definition, the references, a rename and the semantic tokens at a call site in that file.
+The report contains the median (p50) and the 99th percentile (p99) of the latency of each
+kind of message and the peak memory of the language server process.
+
+Requests are timed until their response arrives. Notifications that trigger a compilation
+(``initialized``, ``textDocument/didOpen`` and ``textDocument/didChange``) are timed until the
+first ``textDocument/publishDiagnostics`` notification that follows them, so their latency
+includes the debounce interval of the server before it starts compiling.
+
+By default the workspace is generated: a chain of FILES source files, each of which imports the
+previous one and calls into it. A directory given with ``--workspace`` is used instead, e.g. the
+checkout of an external test project.
+
+Usage:
+
+    test/benchmarks/lsp_latency.py [--solc PATH] [--workspace PATH | --files FILES] [--open N] [--steps N] [--output FILE]
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+
+# Identifiers that are called or whose members are accessed, i.e. references to declarations.
+REFERENCE_PATTERN = re.compile(r'\b([A-Za-z_]\w*)\s*[.(]')
+NOT_REFERENCES = {
+    'assert', 'require', 'revert', 'returns', 'function', 'if', 'for', 'while', 'return',
+    'emit', 'mapping', 'abi', 'msg', 'block', 'tx', 'type', 'new', 'payable', 'address',
+    'keccak256', 'modifier', 'event', 'error', 'constructor', 'super', 'this',
+}
+
+
+def generated_source(index, functions):
+    """Returns the source of the ``index``-th file of the generated workspace."""
+    lines = [
+        '// SPDX-License-Identifier: GPL-3.0',
+        'pragma solidity >=0.8.0;',
+        '',
+    ]
+    if index > 0:
+        lines += [f'import "./Unit{index - 1}.sol";', '']
+    lines += [
+        f'library Math{index} {{',
+        '    function mix(uint a, uint b) internal pure returns (uint) {',
+        f'        return (a ^ b) * {index + 3} + (a >> 3);',
+        '    }',
+        '}',
+        '',
+        f'contract Unit{index} {{',
+        '    struct Entry { uint value; address owner; }',
+        '    mapping(uint => Entry) entries;',
+        '    uint total;',
+        '    event Updated(uint indexed key, uint value);',
+        '',
+    ]
+    for function in range(functions):
+        call = f'Math{index - 1}.mix' if index > 0 else f'Math{index}.mix'
+        lines += [
+            f'    function update{function}(uint key, uint value) public returns (uint) {{',
+            '        Entry storage entry = entries[key];',
+            f'        entry.value = {call}(entry.value, value);',
+            '        entry.owner = msg.sender;',
+            f'        total = Math{index}.mix(total, entry.value);',
+            '        emit Updated(key, entry.value);',
+            '        return total;',
+            '    }',
+            '',
+        ]
+    lines += ['}', '']
+    return '\n'.join(lines)
+
+
+def generate_workspace(directory, files, functions):
+    for index in range(files):
+        (directory / f'Unit{index}.sol').write_text(generated_source(index, functions), encoding='utf8')
+
+
+def reference_positions(text):
+    """Returns the line and character of the references to declarations in the source."""
+    positions = []
+    for line_number, line in enumerate(text.splitlines()):
+        stripped = line.strip()
+        if stripped.startswith(('//', '/*', '*', 'import', 'pragma')):
+            continue
+        for match in REFERENCE_PATTERN.finditer(line):
+            if match.group(1) not in NOT_REFERENCES:
+                positions.append({'line': line_number, 'character': match.start(1)})
+    return positions
+
+
+class LanguageServer:
+    """A ``solc --lsp`` process, talking JSON-RPC over its standard input and output."""
+
+    def __init__(self, solc):
+        self.process = subprocess.Popen(
+            [solc, '--lsp'],
+            stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.DEVNULL,
+        )
+        self.next_id = 1
+
+    def send(self, message):
+        message['jsonrpc'] = '2.0'
+        content = json.dumps(message).encode('utf8')
+        self.process.stdin.write(f'Content-Length: {len(content)}\r\n\r\n'.encode('utf8') + content)
+        self.process.stdin.flush()
+
+    def receive(self):
+        size = None
+        while True:
+            line = self.process.stdout.readline()
+            if len(line) == 0:
+                raise RuntimeError('The language server quit unexpectedly.')
+            line = line.decode('utf8').rstrip('\r\n')
+            if line == '':
+                break
+            if line.startswith('Content-Length: '):
+                size = int(line[len('Content-Length: '):])
+        if size is None:
+            raise RuntimeError('Message without a Content-Length header.')
+        return json.loads(self.process.stdout.read(size).decode('utf8'))
+
+    def request(self, method, params, check=True):
+        """Sends a request and returns its response, skipping notifications sent in the meantime."""
+        request_id = self.next_id
+        self.next_id += 1
+        self.send({'id': request_id, 'method': method, 'params': params})
+        while True:
+            message = self.receive()
+            if message.get('id') == request_id and 'method' not in message:
+                if check and 'error' in message:
+                    raise RuntimeError(f'{method} failed: {message["error"]}')
+                return message.get('result')
+
+    def notify(self, method, params):
+        self.send({'method': method, 'params': params})
+
+    def wait_for_diagnostics(self):
+        """Waits for the first diagnostics of the next compilation."""
+        while self.receive().get('method') != 'textDocument/publishDiagnostics':
+            pass
+
+    def synchronize(self):
+        """Skips the messages the server sent so far, e.g. the rest of the diagnostics of a compilation."""
+        # The server handles messages in order, so the response to this request follows
+        # everything sent before. The error response to the unknown method is all that is needed.
+        self.request('$/synchronize', None, check=False)
+
+    def shutdown(self):
+        """Stops the server and returns its peak memory in KiB."""
+        self.request('shutdown', None)
+        self.notify('exit', None)
+        self.process.stdin.close()
+        # Unlike getrusage(RUSAGE_CHILDREN), wait4() reports the peak memory of this process only.
+        _, _, usage = os.wait4(self.process.pid, 0)
+        self.process.stdout.close()
+        # ru_maxrss is in KiB on Linux.
+        return usage.ru_maxrss
+
+
+def timed(samples, method, function, *args):
+    start = time.perf_counter()
+    result = function(*args)
+    samples.setdefault(method, []).append(time.perf_counter() - start)
+    return result
+
+
+def percentile(sorted_samples, fraction):
+    return sorted_samples[min(len(sorted_samples) - 1, int(fraction * len(sorted_samples)))]
+
+
+def summarize(samples):
+    ordered = sorted(samples)
+    return {
+        'count': len(ordered),
+        'p50InMicroseconds': round(statistics.median(ordered) * 1000000),
+        'p99InMicroseconds': round(percentile(ordered, 0.99) * 1000000),
+    }
+
+
+def run_session(solc, workspace, open_count, steps):
+    files = sorted(
+        source for source in workspace.rglob('*.sol')
+        if 'node_modules' not in source.relative_to(workspace).parts
+    )
+    if len(files) == 0:
+        raise RuntimeError(f'No source files in {workspace}.')
+    # Open the files at the end of the import chain of the generated workspace, they depend
+    # on all the others.
+    opened = [
+        {'uri': source.as_uri(), 'text': source.read_text(encoding='utf8'), 'version': 1}
+        for source in sorted(files, key=lambda source: (len(str(source)), str(source)))[-open_count:]
+    ]
+    for document in opened:
+        document['positions'] = reference_positions(document['text'])
+
+    samples = {}
+    server = LanguageServer(solc)
+    try:
+        timed(samples, 'initialize', server.request, 'initialize', {
+            'processId': None,
+            'rootUri': workspace.as_uri(),
+            'capabilities': {},
+            'initializationOptions': {'file-load-strategy': 'project-directory'},
+        })
+        server.notify('initialized', {})
+        timed(samples, 'initialized', server.wait_for_diagnostics)
+        server.synchronize()
+
+        for document in opened:
+            server.notify('textDocument/didOpen', {'textDocument': {
+                'uri': document['uri'],
+                'languageId': 'solidity',
+                'version': document['version'],
+                'text': document['text'],
+            }})
+            timed(samples, 'textDocument/didOpen', server.wait_for_diagnostics)
+            server.synchronize()
+
+        for step in range(steps):
+            document = opened[step % len(opened)]
+            # Append a line, so that the positions of the references stay valid.
+            last_line = document['text'].count('\n')
+            last_character = len(document['text']) - (document['text'].rfind('\n') + 1)
+            edit = f'\n// edit {step}'
+            document['text'] += edit
+            document['version'] += 1
+            server.notify('textDocument/didChange', {
+                'textDocument': {'uri': document['uri'], 'version': document['version']},
+                'contentChanges': [{
+                    'range': {
+                        'start': {'line': last_line, 'character': last_character},
+                        'end': {'line': last_line, 'character': last_character},
+                    },
+                    'text': edit,
+                }],
+            })
+            timed(samples, 'textDocument/didChange', server.wait_for_diagnostics)
+            server.synchronize()
+
+            text_document = {'uri': document['uri']}
+            if len(document['positions']) > 0:
+                position = document['positions'][step % len(document['positions'])]
+                for method in ['textDocument/hover', 'textDocument/definition']:
+                    timed(samples, method, server.request, method, {
+                        'textDocument': text_document,
+                        'position': position,
+                    })
+                timed(samples, 'textDocument/references', server.request, 'textDocument/references', {
+                    'textDocument': text_document,
+                    'position': position,
+                    'context': {'includeDeclaration': True},
+                })
+                timed(samples, 'textDocument/rename', server.request, 'textDocument/rename', {
+                    'textDocument': text_document,
+                    'position': position,
+                    'newName': f'renamed{step}',
+                })
+            timed(samples, 'textDocument/semanticTokens/full', server.request, 'textDocument/semanticTokens/full', {
+                'textDocument': text_document,
+            })
+    finally:
+        if server.process.poll() is None:
+            peak_memory = server.shutdown()
+        else:
+            peak_memory = None
+
+    return {
+        'files': len(files),
+        'openFiles': len(opened),
+        'steps': steps,
+        'peakMemoryInKiB': peak_memory,
+        'latency': {method: summarize(method_samples) for method, method_samples in samples.items()},
+    }
+
+
+def solc_version(solc):
+    return subprocess.run([solc, '--version'], stdout=subprocess.PIPE, encoding='utf8', check=True).stdout.strip().splitlines()[-1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        '--solc',
+        default=str(Path(os.environ.get('SOLIDITY_BUILD_DIR', REPO_ROOT / 'build')) / 'solc' / 'solc'),
+        help='Path to the compiler. Defaults to $SOLIDITY_BUILD_DIR/solc/solc.',
+    )
+    parser.add_argument('--workspace', help='Directory to use as the workspace instead of a generated one.')
+    parser.add_argument('--files', type=int, default=200, help='Number of files of the generated workspace.')
+    parser.add_argument('--functions', type=int, default=10, help='Number of functions per file of the generated workspace.')
+    parser.add_argument('--open', type=int, default=5, help='Number of files opened in the editor.')
+    parser.add_argument('--steps', type=int, default=100, help='Number of edits in the session.')
+    parser.add_argument('--output', help='File to write the report to instead of stdout.')
+    args = parser.parse_args()
+    for name in ['files', 'functions', 'open', 'steps']:
+        if getattr(args, name) < 1:
+            parser.error(f'--{name} must be at least 1.')
+
+    report = {'solc': solc_version(args.solc)}
+    if args.workspace is not None:
+        report['workspace'] = args.workspace
+        report.update(run_session(args.solc, Path(args.workspace).resolve(), args.open, args.steps))
+    else:
+        workspace = Path(tempfile.mkdtemp(prefix='solc-lsp-benchmark-'))
+        try:
+            generate_workspace(workspace, args.files, args.functions)
+            report['workspace'] = f'generated ({args.files} files, {args.functions} functions each)'
+            report.update(run_session(args.solc, workspace, args.open, args.steps))
+        finally:
+            shutil.rmtree(workspace)
+
+    output = json.dumps(report, indent=4, sort_keys=True) + '\n'
+    if args.output is None:
+        sys.stdout.write(output)
+    else:
+        Path(args.output).write_text(output, encoding='utf8')
+
+
+if __name__ == '__main__':
+    main()
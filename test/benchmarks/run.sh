@@ -51,17 +51,17 @@ do
     solc_command_via_ir=("${solc}" --via-ir --optimize --bin --color "${input_path}")
 
     # Legacy can fail.
-    "${time_bin_path}" --output "${result_legacy_file}" --format "%e" "${solc_command_legacy[@]}" >/dev/null 2>>"${warnings_and_errors_file}"
-    "${time_bin_path}" --output "${result_via_ir_file}" --format "%e" "${solc_command_via_ir[@]}" >/dev/null 2>>"${warnings_and_errors_file}"
+    "${time_bin_path}" --output "${result_legacy_file}" --format "%e %M" "${solc_command_legacy[@]}" >/dev/null 2>>"${warnings_and_errors_file}"
+    "${time_bin_path}" --output "${result_via_ir_file}" --format "%e %M" "${solc_command_via_ir[@]}" >/dev/null 2>>"${warnings_and_errors_file}"
 
-    time_legacy=$(<"${result_legacy_file}")
-    time_via_ir=$(<"${result_via_ir_file}")
+    read -r time_legacy memory_legacy <"${result_legacy_file}"
+    read -r time_via_ir memory_via_ir <"${result_via_ir_file}"
 
     echo "======================================================="
     echo "            ${input_file}"
     echo "-------------------------------------------------------"
-    echo "legacy pipeline took ${time_legacy} seconds to execute."
-    echo "via-ir pipeline took ${time_via_ir} seconds to execute."
+    echo "legacy pipeline took ${time_legacy} seconds to execute (peak memory ${memory_legacy} KiB)."
+    echo "via-ir pipeline took ${time_via_ir} seconds to execute (peak memory ${memory_via_ir} KiB)."
     echo "======================================================="
 done
 
@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+
+"""
+Runs the SMTChecker on a corpus of benchmark contracts and reports where the time goes.
+
+For every benchmark, the report contains the wall time and peak memory of the compiler run
+and, for every contract, the encoding time, solver time and number of queries of each engine,
+as reported by the ``modelCheckerProfile`` output of the Standard JSON interface.
+
+Usage:
+
+    test/benchmarks/smtchecker.py run [--solc PATH] [--timeout MS] [--smtchecker-tests [FILTER]] [--output FILE]
+    test/benchmarks/smtchecker.py compare BASE_REPORT REPORT
+
+The corpus consists of ``chains.sol`` and ``verifier.sol`` from this directory and, with
+``--smtchecker-tests``, the single-source tests in ``test/libsolidity/smtCheckerTests``
+whose path contains FILTER. Reports of two commits made with the same options can be
+compared with the ``compare`` command.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+BENCHMARKS_DIR = REPO_ROOT / 'test' / 'benchmarks'
+SMTCHECKER_TESTS_DIR = REPO_ROOT / 'test' / 'libsolidity' / 'smtCheckerTests'
+BENCHMARKS = ['chains.sol', 'verifier.sol']
+ENGINES = ['bmc', 'chc']
+
+
+def smtchecker_test_source(path: Path):
+    """
+    Returns the source code and the model checker engine of an SMTChecker test,
+    or None if the test consists of multiple sources.
+    """
+    source = []
+    engine = 'all'
+    in_settings = False
+    for line in path.read_text(encoding='utf8').splitlines():
+        if line.startswith('==== Source:'):
+            return None
+        if line.startswith('// ===='):
+            in_settings = True
+        elif line.startswith('// ----'):
+            break
+        elif in_settings and line.startswith('// SMTEngine:'):
+            engine = line.split(':', 1)[1].strip()
+        elif not in_settings:
+            source.append(line)
+    return '\n'.join(source), engine
+
+
+def corpus(smtchecker_tests_filter):
+    """Yields the name, source code and engine of every benchmark."""
+    for benchmark in BENCHMARKS:
+        yield benchmark, (BENCHMARKS_DIR / benchmark).read_text(encoding='utf8'), 'all'
+
+    if smtchecker_tests_filter is None:
+        return
+    for path in sorted(SMTCHECKER_TESTS_DIR.rglob('*.sol')):
+        name = str(path.relative_to(SMTCHECKER_TESTS_DIR))
+        if smtchecker_tests_filter not in name:
+            continue
+        test = smtchecker_test_source(path)
+        if test is not None:
+            yield (name, *test)
+
+
+def run_benchmark(solc, name, source, engine, timeout):
+    """Compiles a benchmark with the SMTChecker enabled and returns its measurements."""
+    standard_json = {
+        'language': 'Solidity',
+        'sources': {name: {'content': source}},
+        'settings': {
+            'modelChecker': {'engine': engine},
+            'outputSelection': {'*': {'*': ['modelCheckerProfile']}},
+        },
+    }
+
+    if timeout is not None:
+        standard_json['settings']['modelChecker']['timeout'] = timeout
+
+    start = time.perf_counter()
+    with subprocess.Popen(
+        [solc, '--standard-json'],
+        stdin=subprocess.PIPE,
+        stdout=subprocess.PIPE,
+        encoding='utf8',
+    ) as process:
+        # The compiler reads all of its input before it writes anything.
+        process.stdin.write(json.dumps(standard_json))
+        process.stdin.close()
+        output = process.stdout.read()
+        # Unlike getrusage(RUSAGE_CHILDREN), wait4() reports the peak memory of this process only.
+        _, status, usage = os.wait4(process.pid, 0)
+        process.returncode = os.waitstatus_to_exitcode(status)
+    wall_time = time.perf_counter() - start
+
+    result = json.loads(output)
+    errors = [error['formattedMessage'] for error in result.get('errors', []) if error['severity'] == 'error']
+    contracts = {
+        f'{source_name}:{contract_name}': contract.get('modelCheckerProfile', {})
+        for source_name, source_contracts in result.get('contracts', {}).items()
+        for contract_name, contract in source_contracts.items()
+    }
+    return {
+        'wallTimeInSeconds': round(wall_time, 3),
+        # ru_maxrss is in KiB on Linux.
+        'peakMemoryInKiB': usage.ru_maxrss,
+        'errors': errors,
+        'contracts': contracts,
+    }
+
+
+def solc_version(solc):
+    return subprocess.run([solc, '--version'], stdout=subprocess.PIPE, encoding='utf8', check=True).stdout.strip().splitlines()[-1]
+
+
+def run(args):
+    report = {
+        'solc': solc_version(args.solc),
+        'timeout': args.timeout,
+        'benchmarks': {},
+    }
+    for name, source, engine in corpus(args.smtchecker_tests):
+        print(f'Running {name}...', file=sys.stderr)
+        report['benchmarks'][name] = run_benchmark(args.solc, name, source, engine, args.timeout)
+
+    output = json.dumps(report, indent=4, sort_keys=True) + '\n'
+    if args.output is None:
+        sys.stdout.write(output)
+    else:
+        Path(args.output).write_text(output, encoding='utf8')
+
+
+def totals(benchmark):
+    """Sums up the measurements of all contracts of a benchmark."""
+    result = {
+        'wallTimeInSeconds': benchmark['wallTimeInSeconds'],
+        'peakMemoryInKiB': benchmark['peakMemoryInKiB'],
+    }
+    for engine in ENGINES:
+        for counter in ['encodingTimeInMicroseconds', 'solverTimeInMicroseconds', 'queries']:
+            result[f'{engine}.{counter}'] = sum(
+                profile.get(engine, {}).get(counter, 0)
+                for profile in benchmark['contracts'].values()
+            )
+    return result
+
+
+def compare(args):
+    base = json.loads(Path(args.base).read_text(encoding='utf8'))
+    new = json.loads(Path(args.report).read_text(encoding='utf8'))
+    if base['timeout'] != new['timeout']:
+        print('Warning: The reports were made with different timeouts.', file=sys.stderr)
+
+    for name in sorted(set(base['benchmarks']) | set(new['benchmarks'])):
+        if name not in base['benchmarks'] or name not in new['benchmarks']:
+            print(f'{name}: only in {"the new" if name in new["benchmarks"] else "the base"} report')
+            continue
+        print(name)
+        base_totals = totals(base['benchmarks'][name])
+        new_totals = totals(new['benchmarks'][name])
+        for counter, base_value in base_totals.items():
+            new_value = new_totals[counter]
+            change = f'{(new_value - base_value) / base_value * 100:+.1f}%' if base_value != 0 else ''
+            print(f'    {counter:<34} {base_value:>14} {new_value:>14} {change:>9}')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    run_parser = subparsers.add_parser('run', help='Run the benchmarks and write a report.')
+    run_parser.add_argument(
+        '--solc',
+        default=str(Path(os.environ.get('SOLIDITY_BUILD_DIR', REPO_ROOT / 'build')) / 'solc' / 'solc'),
+        help='Path to the compiler. Defaults to $SOLIDITY_BUILD_DIR/solc/solc.',
+    )
+    run_parser.add_argument('--timeout', type=int, help='Timeout of each solver query in milliseconds.')
+    run_parser.add_argument(
+        '--smtchecker-tests',
+        nargs='?',
+        const='',
+        default=None,
+        metavar='FILTER',
+        help='Also run the SMTChecker tests whose path contains FILTER.',
+    )
+    run_parser.add_argument('--output', help='File to write the report to instead of stdout.')
+    run_parser.set_defaults(function=run)
+
+    compare_parser = subparsers.add_parser('compare', help='Compare the totals of two reports.')
+    compare_parser.add_argument('base')
+    compare_parser.add_argument('report')
+    compare_parser.set_defaults(function=compare)
+
+    args = parser.parse_args()
+    args.function(args)
+
+
+if __name__ == '__main__':
+    main()
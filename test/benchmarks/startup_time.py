@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+
+"""
+Measures the time of short compiler invocations that are dominated by its startup.
+
+Each invocation is run repeatedly and the report contains the median wall time of the runs
+together with the spread of the samples. The invocations are ``solc --version``, ``solc --abi``
+and ``solc --bin`` on a small contract and a Standard JSON compilation of the same contract.
+
+Usage:
+
+    test/benchmarks/startup_time.py [--solc PATH] [--repeat N]
+"""
+
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+REPO_ROOT = Path(__file__).resolve().parents[2]
+
+SOURCE = """
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+contract C {
+    uint x;
+    function f(uint a) public returns (uint) { x += a; return x; }
+}
+"""
+
+STANDARD_JSON = json.dumps({
+    'language': 'Solidity',
+    'sources': {'C.sol': {'content': SOURCE}},
+    'settings': {'outputSelection': {'*': {'*': ['abi', 'evm.bytecode.object']}}},
+})
+
+
+def invocations(source_file):
+    """Yields the name, command line and standard input of every invocation."""
+    yield 'version', ['--version'], None
+    yield 'abi', ['--abi', str(source_file)], None
+    yield 'bin', ['--bin', str(source_file)], None
+    yield 'standard-json', ['--standard-json'], STANDARD_JSON
+
+
+def measure(solc, arguments, stdin, repeat):
+    samples = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        subprocess.run(
+            [solc] + arguments,
+            input=stdin,
+            stdout=subprocess.DEVNULL,
+            stderr=subprocess.DEVNULL,
+            encoding='utf8',
+            check=True,
+        )
+        samples.append(time.perf_counter() - start)
+    median = statistics.median(samples)
+    return {
+        'medianInMicroseconds': round(median * 1000000),
+        'spreadInPercent': round((max(samples) - min(samples)) / median * 100, 1),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        '--solc',
+        default=str(Path(os.environ.get('SOLIDITY_BUILD_DIR', REPO_ROOT / 'build')) / 'solc' / 'solc'),
+        help='Path to the compiler. Defaults to $SOLIDITY_BUILD_DIR/solc/solc.',
+    )
+    parser.add_argument('--repeat', type=int, default=50, help='Number of runs of each invocation.')
+    args = parser.parse_args()
+    if args.repeat < 1:
+        parser.error('--repeat must be at least 1.')
+
+    source_file = Path(os.environ.get('TMPDIR', '/tmp')) / f'solc-startup-{os.getpid()}.sol'
+    source_file.write_text(SOURCE, encoding='utf8')
+    try:
+        report = {
+            name: measure(args.solc, arguments, stdin, args.repeat)
+            for name, arguments, stdin in invocations(source_file)
+        }
+    finally:
+        source_file.unlink()
+
+    json.dump(report, sys.stdout, indent=4, sort_keys=True)
+    sys.stdout.write('\n')
+
+
+if __name__ == '__main__':
+    main()
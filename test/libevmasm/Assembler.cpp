@@ -61,16 +61,16 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 		{ "verbatim.asm", 2 }
 	};
 	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
-	Assembly _assembly{evmVersion, false, {}};
-	auto root_asm = make_shared<string>("root.asm");
+	Assembly _assembly{evmVersion, false, {}, {}};
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
-	Assembly _subAsm{evmVersion, false, {}};
-	auto sub_asm = make_shared<string>("sub.asm");
+	Assembly _subAsm{evmVersion, false, {}, {}};
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 
-	Assembly _verbatimAsm(evmVersion, true, "");
-	auto verbatim_asm = make_shared<string>("verbatim.asm");
+	Assembly _verbatimAsm(evmVersion, true, {}, "");
+	auto verbatim_asm = internSourceName("verbatim.asm");
 	_verbatimAsm.setSourceLocation({8, 18, verbatim_asm});
 
 	// PushImmutable
@@ -238,15 +238,15 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 				NumSubs +                  // PUSH <addr> for every sub assembly
 				1;                         // INVALID
 
-			auto assemblyName = make_shared<string>("root.asm");
-			auto subName = make_shared<string>("sub.asm");
+			auto assemblyName = internSourceName("root.asm");
+			auto subName = internSourceName("sub.asm");
 
 			map<string, unsigned> indices = {
 				{ *assemblyName, 0 },
 				{ *subName, 1 }
 			};
 
-			auto subAsm = make_shared<Assembly>(evmVersion, false, string{});
+			auto subAsm = make_shared<Assembly>(evmVersion, false, nullopt, string{});
 			for (char i = 0; i < numImmutables; ++i)
 			{
 				for (int r = 0; r < numActualRefs; ++r)
@@ -256,7 +256,7 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 				}
 			}
 
-			Assembly assembly{evmVersion, true, {}};
+			Assembly assembly{evmVersion, true, {}, {}};
 			for (char i = 1; i <= numImmutables; ++i)
 			{
 				assembly.setSourceLocation({10*i, 10*i + 3+i, assemblyName});
@@ -299,6 +299,48 @@ BOOST_AUTO_TEST_CASE(immutables_and_its_source_maps)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(immutable_with_many_references)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	map<string, unsigned> indices = {
+		{ "root.asm", 0 },
+		{ "sub.asm", 1 }
+	};
+	auto const numReferences = 40;
+
+	auto subAsm = make_shared<Assembly>(evmVersion, false, nullopt, string{});
+	subAsm->setSourceLocation({6, 8, internSourceName("sub.asm")});
+	for (int i = 0; i < numReferences; ++i)
+		subAsm->appendImmutable("someImmutable");
+
+	Assembly assembly{evmVersion, true, {}, {}};
+	assembly.setSourceLocation({1, 3, internSourceName("root.asm")});
+	assembly.append(u256(42));
+	assembly.append(u256(0));
+	assembly.appendImmutableAssignment("someImmutable");
+	assembly.appendSubroutine(subAsm);
+
+	LinkerObject const& obj = assembly.assemble();
+	bytes const& subBytecode = assembly.sub(0).assemble().bytecode;
+	size_t const creationSize = obj.bytecode.size() - subBytecode.size();
+	string const disassembly = disassemble(
+		bytes(obj.bytecode.begin(), obj.bytecode.begin() + static_cast<ptrdiff_t>(creationSize)),
+		evmVersion,
+		"\n"
+	);
+	string const sourceMappings = AssemblyItem::computeSourceMapping(assembly.items(), indices);
+
+	// The references are assigned in loops, which is cheaper than a store for each of them.
+	BOOST_CHECK(disassembly.find("PC") != string::npos);
+	// PUSH PUSH (DUP2 DUP2 PUSH2 <offset> ADD MSTORE)* PUSH2 <offset> ADD MSTORE INVALID
+	BOOST_CHECK(creationSize < 4 + (numReferences - 1) * 7 + 5 + 1);
+	// Every opcode but the INVALID has a source mapping.
+	BOOST_CHECK_EQUAL(
+		std::count(sourceMappings.begin(), sourceMappings.end(), ';'),
+		std::count(disassembly.begin(), disassembly.end(), '\n') - 1
+	);
+}
+
 BOOST_AUTO_TEST_CASE(immutable)
 {
 	map<string, unsigned> indices = {
@@ -306,12 +348,12 @@ BOOST_AUTO_TEST_CASE(immutable)
 		{ "sub.asm", 1 }
 	};
 	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
-	Assembly _assembly{evmVersion, true, {}};
-	auto root_asm = make_shared<string>("root.asm");
+	Assembly _assembly{evmVersion, true, {}, {}};
+	auto root_asm = internSourceName("root.asm");
 	_assembly.setSourceLocation({1, 3, root_asm});
 
-	Assembly _subAsm{evmVersion, false, {}};
-	auto sub_asm = make_shared<string>("sub.asm");
+	Assembly _subAsm{evmVersion, false, {}, {}};
+	auto sub_asm = internSourceName("sub.asm");
 	_subAsm.setSourceLocation({6, 8, sub_asm});
 	_subAsm.appendImmutable("someImmutable");
 	_subAsm.appendImmutable("someOtherImmutable");
@@ -400,10 +442,10 @@ BOOST_AUTO_TEST_CASE(immutable)
 BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 {
 	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
-	Assembly assembly{evmVersion, true, {}};
+	Assembly assembly{evmVersion, true, {}, {}};
 
-	shared_ptr<Assembly> subAsmPtr = make_shared<Assembly>(evmVersion, false, string{});
-	shared_ptr<Assembly> subSubAsmPtr = make_shared<Assembly>(evmVersion, false, string{});
+	shared_ptr<Assembly> subAsmPtr = make_shared<Assembly>(evmVersion, false, nullopt, string{});
+	shared_ptr<Assembly> subSubAsmPtr = make_shared<Assembly>(evmVersion, false, nullopt, string{});
 
 	assembly.appendSubroutine(subAsmPtr);
 	subAsmPtr->appendSubroutine(subSubAsmPtr);
@@ -416,6 +458,58 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(eof_relative_jumps)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	Assembly assembly{evmVersion, false, 1, {}};
+	AssemblyItem loop = assembly.newTag();
+	AssemblyItem forward = assembly.newTag();
+	AssemblyItem target = assembly.newTag();
+
+	// Jumps to a tag pushed right before them become relative jumps and tags that are only targeted
+	// by relative jumps do not get a JUMPDEST.
+	assembly.append(loop);
+	assembly.append(u256(1));
+	assembly.appendJumpI(loop);
+	assembly.append(target.pushTag());
+	assembly.appendJump(forward);
+	assembly.append(Instruction::STOP);
+	assembly.append(forward);
+	assembly.append(Instruction::JUMP);
+	assembly.append(target);
+	assembly.append(Instruction::STOP);
+
+	BOOST_CHECK_EQUAL(
+		assembly.assemble().toHex(),
+		// PUSH1 1 RJUMPI -5 PUSH1 12 RJUMP 1 STOP JUMP JUMPDEST STOP
+		"6001" "e1fffb" "600c" "e00001" "00" "56" "5b" "00"
+	);
+}
+
+BOOST_AUTO_TEST_CASE(disassemble_instructions)
+{
+	bytes const bytecode{0x60, 0x00, 0x61, 0x01, 0x00, 0x0c, 0x44, 0x62, 0xab};
+
+	BOOST_CHECK_EQUAL(
+		disassemble(bytecode, EVMVersion::paris()),
+		"PUSH1 0x0 PUSH2 0x100 0xC PREVRANDAO PUSH3 0xAB0000 "
+	);
+	BOOST_CHECK_EQUAL(
+		disassemble(bytecode, EVMVersion::london(), "\n"),
+		"PUSH1 0x0\nPUSH2 0x100\n0xC\nDIFFICULTY\nPUSH3 0xAB0000\n"
+	);
+
+	vector<size_t> positions;
+	vector<size_t> missingImmediateSizes;
+	for (DecodedInstruction const& instruction: InstructionRange{bytecode})
+	{
+		positions.push_back(instruction.position);
+		missingImmediateSizes.push_back(instruction.missingImmediateSize);
+	}
+	BOOST_CHECK((positions == vector<size_t>{0, 2, 5, 6, 7}));
+	BOOST_CHECK((missingImmediateSizes == vector<size_t>{0, 0, 0, 0, 2}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -29,12 +29,15 @@
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
+#include <libevmasm/BlockIndex.h>
 #include <libevmasm/Assembly.h>
+#include <libevmasm/TailMerger.h>
 
 #include <boost/test/unit_test.hpp>
 
 #include <range/v3/algorithm/any_of.hpp>
 
+#include <limits>
 #include <string>
 #include <tuple>
 #include <memory>
@@ -975,6 +978,140 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(tail_merger)
+{
+	AssemblyItems panic{
+		u256(0x4e487b71),
+		u256(224),
+		Instruction::SHL,
+		u256(0),
+		Instruction::MSTORE,
+		u256(0x32),
+		u256(4),
+		Instruction::MSTORE,
+		u256(0x24),
+		u256(0),
+		Instruction::REVERT
+	};
+	AssemblyItems input =
+		AssemblyItems{AssemblyItem(Tag, 1)} +
+		panic +
+		AssemblyItems{
+			AssemblyItem(Tag, 2),
+			u256(1),
+			u256(2),
+			Instruction::SSTORE
+		} +
+		panic;
+	AssemblyItems expectation =
+		AssemblyItems{AssemblyItem(Tag, 1)} +
+		panic +
+		AssemblyItems{
+			AssemblyItem(Tag, 2),
+			u256(1),
+			u256(2),
+			Instruction::SSTORE,
+			AssemblyItem(PushTag, 1),
+			Instruction::JUMP
+		};
+	TailMerger tailMerger{input, []() { return AssemblyItem(Tag, 3); }, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}};
+	BOOST_CHECK(tailMerger.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+}
+
+BOOST_AUTO_TEST_CASE(tail_merger_new_tag)
+{
+	AssemblyItems input{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		u256(0x24),
+		u256(0),
+		Instruction::REVERT,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		u256(0),
+		Instruction::SSTORE,
+		u256(0x24),
+		u256(0),
+		Instruction::REVERT
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		AssemblyItem(Tag, 3),
+		u256(0),
+		Instruction::SSTORE,
+		u256(0x24),
+		u256(0),
+		Instruction::REVERT,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP
+	};
+	TailMerger tailMerger{input, []() { return AssemblyItem(Tag, 3); }, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}};
+	BOOST_CHECK(tailMerger.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+}
+
+BOOST_AUTO_TEST_CASE(tail_merger_too_short)
+{
+	AssemblyItems input{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(0),
+		Instruction::REVERT,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		u256(0),
+		Instruction::REVERT
+	};
+	AssemblyItems expectation = input;
+	TailMerger tailMerger{input, []() { return AssemblyItem(Tag, 3); }, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}};
+	BOOST_CHECK(!tailMerger.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+}
+
+BOOST_AUTO_TEST_CASE(tail_merger_return_runs)
+{
+	AssemblyItems input{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		u256(0x20),
+		u256(0x40),
+		Instruction::MLOAD,
+		Instruction::RETURN,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		u256(0x20),
+		u256(0x40),
+		Instruction::MLOAD,
+		Instruction::RETURN
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		u256(1),
+		AssemblyItem(Tag, 3),
+		u256(0x20),
+		u256(0x40),
+		Instruction::MLOAD,
+		Instruction::RETURN,
+		AssemblyItem(Tag, 2),
+		u256(2),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP
+	};
+	// For many runs, the added jump costs more than the saved byte of code.
+	AssemblyItems manyRuns = input;
+	TailMerger{manyRuns, []() { return AssemblyItem(Tag, 3); }, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}}.optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(manyRuns.begin(), manyRuns.end(), input.begin(), input.end());
+
+	TailMerger{input, []() { return AssemblyItem(Tag, 3); }, 1, false, {}}.optimise();
+	BOOST_CHECK_EQUAL_COLLECTIONS(input.begin(), input.end(), expectation.begin(), expectation.end());
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1049,6 +1186,24 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 	BOOST_CHECK(items.empty());
 }
 
+BOOST_AUTO_TEST_CASE(peephole_method_applications)
+{
+	AssemblyItems items{
+		u256(4),
+		Instruction::CALLDATASIZE,
+		Instruction::LT,
+		Instruction::POP,
+		u256(5),
+		u256(5)
+	};
+	map<string, size_t> applications;
+	PeepholeOptimiser peepOpt(items, &applications);
+	while (peepOpt.optimise())
+		;
+	map<string, size_t> expectation{{"DoublePush", 1}, {"OpPop", 2}, {"PushPop", 1}};
+	BOOST_CHECK(applications == expectation);
+}
+
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
 {
 	vector<Instruction> ops{
@@ -1243,6 +1398,41 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(block_index)
+{
+	AssemblyItem pushSubTag(PushTag);
+	pushSubTag.setPushTagSubIdAndTag(0, 4);
+	AssemblyItems items{
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 1),
+		u256(5),
+		AssemblyItem(Tag, 10),
+		AssemblyItem(Tag, 3),
+		u256(6),
+		AssemblyItem(Tag, 1),
+		Instruction::JUMP,
+		pushSubTag,
+		AssemblyItem(PushTag, 1),
+	};
+	BlockIndex index{items};
+
+	BOOST_CHECK((index.referencedTags(numeric_limits<size_t>::max()) == set<size_t>{1}));
+	BOOST_CHECK((index.referencedTags(0) == set<size_t>{4}));
+	BOOST_CHECK(index.referencedTags(1).empty());
+
+	BOOST_REQUIRE(index.block(1));
+	BOOST_CHECK_EQUAL(index.block(1)->start.value(), size_t(6));
+	BOOST_CHECK_EQUAL(index.block(1)->end.value(), size_t(8));
+	BOOST_CHECK((index.block(1)->pushTagPositions == vector<size_t>{1, 9}));
+
+	BOOST_REQUIRE(index.block(10));
+	BOOST_CHECK_EQUAL(index.block(10)->start.value(), size_t(3));
+	BOOST_CHECK_EQUAL(index.block(10)->end.value(), size_t(5));
+	BOOST_CHECK(index.block(10)->pushTagPositions.empty());
+
+	BOOST_CHECK(!index.block(4));
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 {
 	// This tests that tags from subassemblies are not removed
@@ -1260,8 +1450,8 @@ BOOST_AUTO_TEST_CASE(jumpdest_removal_subassemblies)
 	settings.evmVersion = solidity::test::CommonOptions::get().evmVersion();
 	settings.expectedExecutionsPerDeployment = OptimiserSettings{}.expectedExecutionsPerDeployment;
 
-	Assembly main{settings.evmVersion, false, {}};
-	AssemblyPointer sub = make_shared<Assembly>(settings.evmVersion, true, string{});
+	Assembly main{settings.evmVersion, false, {}, {}};
+	AssemblyPointer sub = make_shared<Assembly>(settings.evmVersion, true, nullopt, string{});
 
 	sub->append(u256(1));
 	auto t1 = sub->newTag();
@@ -1687,6 +1877,57 @@ BOOST_AUTO_TEST_CASE(inliner)
 }
 
 
+BOOST_AUTO_TEST_CASE(inliner_code_size_budget)
+{
+	AssemblyItem jumpInto{Instruction::JUMP};
+	jumpInto.setJumpType(AssemblyItem::JumpType::IntoFunction);
+	AssemblyItem jumpOutOf{Instruction::JUMP};
+	jumpOutOf.setJumpType(AssemblyItem::JumpType::OutOfFunction);
+	AssemblyItems const body{
+		Instruction::CALLVALUE,
+		Instruction::CALLVALUE,
+		Instruction::ADD,
+		Instruction::CALLVALUE,
+		Instruction::ADD,
+		Instruction::SWAP1,
+	};
+	AssemblyItems const original =
+		AssemblyItems{
+			AssemblyItem(PushTag, 1),
+			AssemblyItem(PushTag, 2),
+			jumpInto,
+			AssemblyItem(Tag, 1),
+			Instruction::STOP,
+			AssemblyItem(Tag, 2)
+		} +
+		body +
+		AssemblyItems{jumpOutOf};
+	// Inlining replaces the four bytes of the jump by the seven bytes of the function body.
+	AssemblyItems items = original;
+	BOOST_CHECK(!Inliner(items, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}, 2).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		original.begin(), original.end()
+	);
+
+	AssemblyItems expectation =
+		AssemblyItems{AssemblyItem(PushTag, 1)} +
+		body +
+		AssemblyItems{
+			Instruction::JUMP,
+			AssemblyItem(Tag, 1),
+			Instruction::STOP,
+			AssemblyItem(Tag, 2)
+		} +
+		body +
+		AssemblyItems{jumpOutOf};
+	BOOST_CHECK(Inliner(items, {}, Assembly::OptimiserSettings{}.expectedExecutionsPerDeployment, false, {}, 3).optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
 BOOST_AUTO_TEST_CASE(inliner_no_inline_type)
 {
 	// Will not inline due to jump types.
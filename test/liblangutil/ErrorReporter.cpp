@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the ErrorReporter class.
+ */
+
+#include <liblangutil/ErrorReporter.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::langutil::test
+{
+
+namespace
+{
+
+/// Reports @a _warnings warnings followed by @a _errors type errors, numbered from @a _first.
+void report(ErrorReporter& _errorReporter, size_t _first, size_t _warnings, size_t _errors = 0)
+{
+	for (size_t i = _first; i < _first + _warnings; ++i)
+		_errorReporter.warning(1000_error, "warning " + to_string(i));
+	for (size_t i = _first; i < _first + _errors; ++i)
+		_errorReporter.typeError(1001_error, SourceLocation{}, "error " + to_string(i));
+}
+
+vector<string> messages(ErrorList const& _errors)
+{
+	vector<string> result;
+	for (auto const& error: _errors)
+		result.emplace_back(error->what());
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ErrorReporterTest)
+
+BOOST_AUTO_TEST_CASE(append_with_limits_matches_sequential_reporting)
+{
+	ErrorList sequentialErrors;
+	ErrorReporter sequential(sequentialErrors);
+	report(sequential, 0, 200);
+	report(sequential, 200, 200);
+
+	ErrorList firstErrors;
+	ErrorList secondErrors;
+	ErrorList mergedErrors;
+	ErrorReporter first(firstErrors);
+	ErrorReporter second(secondErrors);
+	ErrorReporter merged(mergedErrors);
+	report(first, 0, 200);
+	report(second, 200, 200);
+	merged.appendWithLimits(firstErrors);
+	merged.appendWithLimits(secondErrors);
+
+	BOOST_CHECK(messages(mergedErrors) == messages(sequentialErrors));
+}
+
+BOOST_AUTO_TEST_CASE(append_with_limits_throws_on_too_many_errors)
+{
+	ErrorList sequentialErrors;
+	ErrorReporter sequential(sequentialErrors);
+	report(sequential, 0, 0, 10);
+	BOOST_CHECK_THROW(report(sequential, 10, 0, 300), FatalError);
+
+	ErrorList firstErrors;
+	ErrorList secondErrors;
+	ErrorList mergedErrors;
+	ErrorReporter first(firstErrors);
+	ErrorReporter second(secondErrors);
+	ErrorReporter merged(mergedErrors);
+	report(first, 0, 0, 10);
+	BOOST_CHECK_THROW(report(second, 10, 0, 300), FatalError);
+	merged.appendWithLimits(firstErrors);
+	BOOST_CHECK_THROW(merged.appendWithLimits(secondErrors), FatalError);
+
+	BOOST_CHECK(messages(mergedErrors) == messages(sequentialErrors));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -166,6 +166,33 @@ struct TestScanner
 	decltype(auto) currentLocation() { return scanner->currentLocation(); }
 };
 
+BOOST_AUTO_TEST_CASE(comments_and_identifiers_across_long_input)
+{
+	string longIdentifier(1000, 'x');
+	TestScanner scanner(
+		"a \t\n /* ** * / ** */ " + longIdentifier + "_$9 // comment \xc2\xa0 \xe2\x80\xaf\n"
+		"b // line separator \xe2\x80\xa8 c"
+	);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "a");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), longIdentifier + "_$9");
+	BOOST_CHECK_EQUAL(scanner.currentLocation().start, 21);
+	BOOST_CHECK_EQUAL(scanner.currentLocation().end, 1024);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "b");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalToken);
+}
+
+BOOST_AUTO_TEST_CASE(unterminated_multiline_comment_with_stars)
+{
+	TestScanner scanner("a /* ** * /");
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Illegal);
+	BOOST_CHECK_EQUAL(scanner.currentError(), ScannerError::IllegalCommentTerminator);
+}
+
 BOOST_AUTO_TEST_CASE(string_escapes_legal_before_080)
 {
 	TestScanner scanner("  { \"a\\b");
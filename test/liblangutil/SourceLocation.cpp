@@ -34,9 +34,9 @@ BOOST_AUTO_TEST_SUITE(SourceLocationTest)
 
 BOOST_AUTO_TEST_CASE(test_fail)
 {
-	auto const source = std::make_shared<std::string>("source");
-	auto const sourceA = std::make_shared<std::string>("sourceA");
-	auto const sourceB = std::make_shared<std::string>("sourceB");
+	auto const source = internSourceName("source");
+	auto const sourceA = internSourceName("sourceA");
+	auto const sourceB = internSourceName("sourceB");
 
 	BOOST_CHECK(SourceLocation{} == SourceLocation{});
 	BOOST_CHECK((SourceLocation{0, 3, sourceA} != SourceLocation{0, 3, sourceB}));
@@ -46,6 +46,15 @@ BOOST_AUTO_TEST_CASE(test_fail)
 	BOOST_CHECK((SourceLocation{3, 7, sourceA} < SourceLocation{4, 6, sourceB}));
 }
 
+BOOST_AUTO_TEST_CASE(interned_source_names)
+{
+	std::string const name = "source";
+	BOOST_CHECK(internSourceName(name) == internSourceName("source"));
+	BOOST_CHECK(internSourceName(name) != &name);
+	BOOST_CHECK(internSourceName("sourceA") != internSourceName("sourceB"));
+	BOOST_CHECK_EQUAL(*internSourceName(name), name);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
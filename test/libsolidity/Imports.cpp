@@ -113,6 +113,30 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(remapping_precedence)
+{
+	ImportRemapper remapper;
+	remapper.setRemappings({
+		{"", "x", "a"},
+		{"", "x/y", "b"},
+		{"c", "x", "c"},
+		{"", "x/y", "d"},
+		{"c/e", "x/y/z", "e"},
+	});
+	// Longest prefix, the last one of equal remappings.
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "g/main.sol"), "d/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/f.sol", "g/main.sol"), "a/f.sol");
+	// A longer context beats a longer prefix.
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "c/main.sol"), "c/y/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/z/f.sol", "c/e/main.sol"), "e/f.sol");
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "c/e/main.sol"), "c/y/f.sol");
+	// No matching prefix.
+	BOOST_CHECK_EQUAL(remapper.apply("y/f.sol", "c/main.sol"), "y/f.sol");
+
+	remapper.clear();
+	BOOST_CHECK_EQUAL(remapper.apply("x/y/f.sol", "g/main.sol"), "x/y/f.sol");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
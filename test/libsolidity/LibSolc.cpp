@@ -21,6 +21,8 @@
  */
 
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -179,6 +181,53 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_contexts)
+{
+	CStyleReadFileCallback callback{
+		[](void* _context, char const*, char const* _path, char** o_contents, char** o_error)
+		{
+			// Every thread passes its own index as the read context.
+			string content = "contract B" + to_string(*static_cast<size_t*>(_context)) + " {}";
+			*o_contents = string(_path) == "imported.sol" ? stringToSolidity(content) : nullptr;
+			*o_error = nullptr;
+		}
+	};
+
+	size_t const threadCount = 4;
+	vector<Json::Value> results(threadCount);
+	vector<size_t> indices(threadCount);
+	vector<thread> threads;
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		indices[i] = i;
+		threads.emplace_back([&, i]() {
+			solidity_context* context = solidity_create_context();
+			string input = R"({
+				"language": "Solidity",
+				"sources": {"fileA": {"content": "import \"imported.sol\"; contract A)" + to_string(i) + R"( is B)" + to_string(i) + R"( {}"}},
+				"settings": {"outputSelection": {"*": {"*": ["evm.bytecode.object"]}}}
+			})";
+			char* output = solidity_compile_ctx(context, input.c_str(), callback, &indices[i]);
+			bool parsed = util::jsonParseStrict(output, results[i]);
+			solidity_free_ctx(context, output);
+			// Results that were not freed explicitly are freed with the context.
+			solidity_compile_ctx(context, input.c_str(), callback, &indices[i]);
+			solidity_destroy_context(context);
+			if (!parsed)
+				results[i] = Json::nullValue;
+		});
+	}
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		string const contractName = "A" + to_string(i);
+		BOOST_REQUIRE(results[i].isObject());
+		BOOST_CHECK(results[i]["contracts"]["fileA"][contractName]["evm"]["bytecode"]["object"].isString());
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
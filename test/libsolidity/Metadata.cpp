@@ -340,6 +340,34 @@ BOOST_AUTO_TEST_CASE(metadata_relevant_sources_imports)
 	BOOST_CHECK(metadata["sources"].isMember("C"));
 }
 
+BOOST_AUTO_TEST_CASE(metadata_relevant_sources_diamond_imports)
+{
+	// A source imported along several paths is listed once, with the same hashes
+	// in the metadata of every contract.
+	CompilerStack compilerStack;
+	compilerStack.setSources({
+		{"A", "pragma solidity >=0.0; contract A {}"},
+		{"B", "pragma solidity >=0.0; import \"./A\"; contract B is A {}"},
+		{"C", "pragma solidity >=0.0; import \"./A\"; contract C is A {}"},
+		{"D", "pragma solidity >=0.0; import \"./B\"; import \"./C\"; contract D is B, C {}"}
+	});
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	compilerStack.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+
+	Json::Value metadataB;
+	Json::Value metadataD;
+	BOOST_REQUIRE(util::jsonParseStrict(compilerStack.metadata("B"), metadataB));
+	BOOST_REQUIRE(util::jsonParseStrict(compilerStack.metadata("D"), metadataD));
+	BOOST_CHECK(solidity::test::isValidMetadata(metadataD));
+
+	BOOST_CHECK_EQUAL(metadataB["sources"].size(), 2);
+	BOOST_CHECK_EQUAL(metadataD["sources"].size(), 4);
+	for (char const* source: {"A", "B", "C", "D"})
+		BOOST_CHECK(metadataD["sources"].isMember(source));
+	BOOST_CHECK(metadataB["sources"]["A"] == metadataD["sources"]["A"]);
+}
+
 BOOST_AUTO_TEST_CASE(metadata_useLiteralContent)
 {
 	// Check that the metadata contains "useLiteralContent"
@@ -51,6 +51,37 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(reset_code_generation)
+{
+	char const* sourceCode = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		library L { function f() external {} }
+		contract C { function g() public { L.f(); } }
+	)";
+	CompilerStack compilerStack;
+	compilerStack.setSources({{"A.sol", sourceCode}});
+	compilerStack.setOptimiserSettings(solidity::test::CommonOptions::get().optimize);
+	compilerStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+	BOOST_CHECK(!compilerStack.object("C").linkReferences.empty());
+	BOOST_CHECK(compilerStack.yulIR("C").empty());
+	size_t warnings = compilerStack.errors().size();
+
+	BOOST_CHECK_THROW(compilerStack.setLibraries({{"A.sol:L", util::h160(1)}}), langutil::CompilerError);
+	compilerStack.resetCodeGeneration();
+	BOOST_CHECK(compilerStack.state() == CompilerStack::AnalysisPerformed);
+	BOOST_CHECK_THROW(compilerStack.object("C"), langutil::CompilerError);
+	compilerStack.setLibraries({{"A.sol:L", util::h160(1)}});
+	compilerStack.enableEvmBytecodeGeneration(false);
+	compilerStack.enableIRGeneration(true);
+	BOOST_REQUIRE_MESSAGE(compilerStack.compile(), "Compiling contract failed");
+	BOOST_CHECK(!compilerStack.yulIR("C").empty());
+	BOOST_CHECK(compilerStack.object("C").bytecode.empty());
+	BOOST_CHECK(compilerStack.metadata("C").find("A.sol:L") != string::npos);
+	BOOST_CHECK_EQUAL(compilerStack.errors().size(), warnings);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -39,6 +39,26 @@ using namespace solidity::langutil;
 using namespace solidity::test;
 using namespace std;
 
+namespace
+{
+
+/// @returns true if @a _compiler was given exactly @a _sources.
+bool hasSources(CompilerStack const& _compiler, map<string, string> const& _sources)
+{
+	vector<string> sourceNames = _compiler.sourceNames();
+	if (sourceNames.size() != _sources.size())
+		return false;
+	for (string const& sourceName: sourceNames)
+	{
+		auto it = _sources.find(sourceName);
+		if (it == _sources.end() || it->second != _compiler.charStream(sourceName).source())
+			return false;
+	}
+	return true;
+}
+
+}
+
 bytes SolidityExecutionFramework::multiSourceCompileContract(
 	map<string, string> const& _sourceCode,
 	optional<string> const& _mainSourceName,
@@ -52,21 +72,39 @@ bytes SolidityExecutionFramework::multiSourceCompileContract(
 	for (auto& entry: sourcesWithPreamble)
 		entry.second = addPreamble(entry.second);
 
-	m_compiler.reset();
+	AnalysisSettings analysisSettings{
+		m_evmVersion,
+		m_optimiserSettings,
+		m_revertStrings,
+		m_metadataHash
+	};
+	if (
+		m_analysisSettings == analysisSettings &&
+		m_compiler.state() >= CompilerStack::AnalysisPerformed &&
+		!m_compiler.hasError() &&
+		hasSources(m_compiler, sourcesWithPreamble)
+	)
+		m_compiler.resetCodeGeneration();
+	else
+	{
+		m_compiler.reset();
+		m_compiler.setSources(sourcesWithPreamble);
+		m_compiler.setRevertStringBehaviour(m_revertStrings);
+		m_compiler.setEVMVersion(m_evmVersion);
+		m_compiler.setOptimiserSettings(m_optimiserSettings);
+		m_compiler.setMetadataHash(m_metadataHash);
+		m_analysisSettings = analysisSettings;
+	}
 	m_compiler.enableEwasmGeneration(m_compileToEwasm);
-	m_compiler.setSources(sourcesWithPreamble);
 	m_compiler.setLibraries(_libraryAddresses);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	m_compiler.setEVMVersion(m_evmVersion);
 	m_compiler.setEOFVersion(m_eofVersion);
-	m_compiler.setOptimiserSettings(m_optimiserSettings);
 	m_compiler.enableEvmBytecodeGeneration(!m_compileViaYul);
 	m_compiler.enableIRGeneration(m_compileViaYul);
-	m_compiler.setRevertStringBehaviour(m_revertStrings);
-	if (!m_appendCBORMetadata) {
-		m_compiler.setMetadataFormat(CompilerStack::MetadataFormat::NoMetadata);
-	}
-	m_compiler.setMetadataHash(m_metadataHash);
+	m_compiler.setMetadataFormat(
+		m_appendCBORMetadata ?
+		CompilerStack::defaultMetadataFormat() :
+		CompilerStack::MetadataFormat::NoMetadata
+	);
 	if (!m_compiler.compile())
 	{
 		// The testing framework expects an exception for
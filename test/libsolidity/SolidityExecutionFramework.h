@@ -92,6 +92,28 @@ protected:
 	bool m_appendCBORMetadata = true;
 	CompilerStack::MetadataHash m_metadataHash = CompilerStack::MetadataHash::IPFS;
 	RevertStrings m_revertStrings = RevertStrings::Default;
+
+private:
+	/// Settings the analysis in m_compiler was performed with. As long as they and the sources
+	/// do not change, only the code generation is re-run, e.g. between the legacy and the via-IR
+	/// runs of a semantic test or for deployments that only differ in the linked libraries.
+	struct AnalysisSettings
+	{
+		langutil::EVMVersion evmVersion;
+		OptimiserSettings optimiserSettings;
+		RevertStrings revertStrings;
+		CompilerStack::MetadataHash metadataHash;
+
+		bool operator==(AnalysisSettings const& _other) const
+		{
+			return
+				evmVersion == _other.evmVersion &&
+				optimiserSettings == _other.optimiserSettings &&
+				revertStrings == _other.revertStrings &&
+				metadataHash == _other.metadataHash;
+		}
+	};
+	std::optional<AnalysisSettings> m_analysisSettings;
 };
 
 } // end namespaces
@@ -27,6 +27,8 @@
 #include <libsolutil/Keccak256.h>
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 using namespace std;
 using namespace solidity::langutil;
 
@@ -222,6 +224,55 @@ BOOST_AUTO_TEST_CASE(type_identifiers)
 	BOOST_CHECK_EQUAL(InaccessibleDynamicType().identifier(), "t_inaccessible");
 }
 
+BOOST_AUTO_TEST_CASE(type_interning)
+{
+	Type const* uint24 = TypeProvider::uint(24);
+	ArrayType const* dynamicArray = TypeProvider::array(DataLocation::Memory, uint24);
+	BOOST_CHECK(dynamicArray == TypeProvider::array(DataLocation::Memory, uint24));
+	BOOST_CHECK(dynamicArray != TypeProvider::array(DataLocation::Storage, uint24));
+	BOOST_CHECK(dynamicArray != TypeProvider::array(DataLocation::Memory, uint24, 1));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint24, 1) == TypeProvider::array(DataLocation::Memory, uint24, 1));
+	BOOST_CHECK(TypeProvider::array(DataLocation::Memory, uint24, 1) != TypeProvider::array(DataLocation::Memory, uint24, 2));
+	BOOST_CHECK(TypeProvider::arraySlice(*dynamicArray) == TypeProvider::arraySlice(*dynamicArray));
+
+	BOOST_CHECK(
+		TypeProvider::withLocation(dynamicArray, DataLocation::Memory, false) ==
+		TypeProvider::withLocation(dynamicArray, DataLocation::Memory, false)
+	);
+	BOOST_CHECK(
+		TypeProvider::withLocation(dynamicArray, DataLocation::Memory, false) !=
+		TypeProvider::withLocation(dynamicArray, DataLocation::Storage, false)
+	);
+
+	Type const* uint256 = TypeProvider::uint256();
+	BOOST_CHECK(TypeProvider::mapping(uint24, "", uint256, "") == TypeProvider::mapping(uint24, "", uint256, ""));
+	// Names of mapping parameters are part of the type.
+	BOOST_CHECK(TypeProvider::mapping(uint24, "key", uint256, "") != TypeProvider::mapping(uint24, "", uint256, ""));
+
+	BOOST_CHECK(TypeProvider::tuple({uint24, dynamicArray}) == TypeProvider::tuple({uint24, dynamicArray}));
+	BOOST_CHECK(TypeProvider::tuple({uint24, dynamicArray}) != TypeProvider::tuple({dynamicArray, uint24}));
+}
+
+BOOST_AUTO_TEST_CASE(type_provider_per_thread)
+{
+	ArrayType const* array = TypeProvider::array(DataLocation::Memory, TypeProvider::uint256());
+	Type const* otherUint256 = nullptr;
+	ArrayType const* otherArray = nullptr;
+	string otherIdentifier;
+	// Boost.Test assertions are not thread-safe, so only collect the results in the thread.
+	thread([&]() {
+		otherUint256 = TypeProvider::uint256();
+		otherArray = TypeProvider::array(DataLocation::Memory, otherUint256);
+		otherIdentifier = otherArray->identifier();
+		TypeProvider::reset();
+	}).join();
+	BOOST_CHECK(otherUint256 != TypeProvider::uint256());
+	BOOST_CHECK(otherArray != array);
+	BOOST_CHECK_EQUAL(otherIdentifier, "t_array$_t_uint256_$dyn_memory_ptr");
+	BOOST_CHECK(array == TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()));
+	BOOST_CHECK_EQUAL(array->identifier(), "t_array$_t_uint256_$dyn_memory_ptr");
+}
+
 BOOST_AUTO_TEST_CASE(encoded_sizes)
 {
 	BOOST_CHECK_EQUAL(IntegerType(16).calldataEncodedSize(true), 32);
@@ -22,6 +22,7 @@
 
 #include <string>
 #include <boost/test/unit_test.hpp>
+#include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
@@ -31,6 +32,7 @@
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -319,6 +321,126 @@ BOOST_AUTO_TEST_CASE(error_recovery_field)
 	BOOST_CHECK(containsAtMostWarnings(result));
 }
 
+BOOST_AUTO_TEST_CASE(skip_unreferenced_sources)
+{
+	auto input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"skipUnreferencedSources": "1"
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.skipUnreferencedSources\" must be a Boolean."));
+
+	input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"skipUnreferencedSources": true,
+			"outputSelection": {
+				"a.sol": { "A": ["abi"] }
+			}
+		},
+		"sources": {
+			"a.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"b.sol\";\ncontract A is B {}"
+			},
+			"b.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"c.sol\";\ncontract B {}"
+			},
+			"c.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\ncontract C {}"
+			},
+			"unreferenced.sol": {
+				"content": "this is not valid Solidity"
+			}
+		}
+	}
+	)";
+
+	result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"].isMember("a.sol"));
+	BOOST_CHECK(result["sources"].isMember("b.sol"));
+	BOOST_CHECK(result["sources"].isMember("c.sol"));
+	BOOST_CHECK(!result["sources"].isMember("unreferenced.sol"));
+	BOOST_CHECK(result["contracts"]["a.sol"]["A"]["abi"].isArray());
+}
+
+BOOST_AUTO_TEST_CASE(deduplicate_sources)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"deduplicateSources": "1"
+		},
+		"sources": {
+			"empty": {
+				"content": ""
+			}
+		}
+	}
+	)";
+
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.deduplicateSources\" must be a Boolean."));
+
+	// The copies in x and y are identical including their imports. The copy in z imports a
+	// different library, so it is not a duplicate.
+	input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"deduplicateSources": true,
+			"skipUnreferencedSources": true,
+			"outputSelection": {
+				"a.sol": { "A": ["abi"] }
+			}
+		},
+		"sources": {
+			"a.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"x/lib.sol\" as X;\nimport \"y/lib.sol\" as Y;\nimport \"z/lib.sol\" as Z;\ncontract A { function f() public pure returns (uint) { return X.L.f() + Y.L.f() + Z.L.f(); } }"
+			},
+			"x/lib.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"./dep.sol\";\nlibrary L { function f() internal pure returns (uint) { return D.g(); } }"
+			},
+			"x/dep.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nlibrary D { function g() internal pure returns (uint) { return 1; } }"
+			},
+			"y/lib.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"./dep.sol\";\nlibrary L { function f() internal pure returns (uint) { return D.g(); } }"
+			},
+			"y/dep.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nlibrary D { function g() internal pure returns (uint) { return 1; } }"
+			},
+			"z/lib.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"./dep.sol\";\nlibrary L { function f() internal pure returns (uint) { return D.g(); } }"
+			},
+			"z/dep.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nlibrary D { function g() internal pure returns (uint) { return 2; } }"
+			}
+		}
+	}
+	)";
+
+	result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	for (string const source: {"a.sol", "x/lib.sol", "x/dep.sol", "z/lib.sol", "z/dep.sol"})
+		BOOST_CHECK(result["sources"].isMember(source));
+	BOOST_CHECK(!result["sources"].isMember("y/lib.sol"));
+	BOOST_CHECK(!result["sources"].isMember("y/dep.sol"));
+	BOOST_CHECK(result["contracts"]["a.sol"]["A"]["abi"].isArray());
+}
+
 BOOST_AUTO_TEST_CASE(optimizer_enabled_not_boolean)
 {
 	char const* input = R"(
@@ -1257,6 +1379,194 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_call_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.deployedBytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "callProfile": { "e2179b8e": 9, "0x26121ff0": 1 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public {} function g() public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	BOOST_CHECK(contract["metadata"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(optimizer["enabled"].asBool() == true);
+	BOOST_CHECK(!optimizer.isMember("details"));
+	BOOST_CHECK(optimizer["callProfile"]["26121ff0"].asUInt() == 1);
+	BOOST_CHECK(optimizer["callProfile"]["e2179b8e"].asUInt() == 9);
+
+	// The more frequently called g() is checked first.
+	string bytecode = contract["evm"]["deployedBytecode"]["object"].asString();
+	size_t f = bytecode.find("6326121ff0");
+	size_t g = bytecode.find("63e2179b8e");
+	BOOST_REQUIRE(f != string::npos && g != string::npos);
+	BOOST_CHECK(g < f);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_call_profile_decoder)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "ir" ] }
+			},
+			"optimizer": { "callProfile": { "724658c1": 1 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(address a, uint b) public {} function g(uint x) public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract["ir"].isString());
+	string ir = contract["ir"].asString();
+
+	// Only the profiled f(address,uint256) decodes its parameters without a function per element.
+	BOOST_CHECK(ir.find("function abi_decode_tuple_t_addresst_uint256_inline(headStart, dataEnd)") != string::npos);
+	BOOST_CHECK(ir.find("function abi_decode_tuple_t_uint256(headStart, dataEnd)") != string::npos);
+	BOOST_CHECK(ir.find("abi_decode_tuple_t_uint256_inline") == string::npos);
+	BOOST_CHECK(ir.find("abi_decode_t_address(") == string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_call_profile_encoder)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "ir" ] }
+			},
+			"optimizer": { "callProfile": { "26121ff0": 1 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public returns (address a, uint b) {} function g() public returns (uint) {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_REQUIRE(contract["ir"].isString());
+	string ir = contract["ir"].asString();
+
+	// Only the profiled f() stores its return values without a function per element.
+	BOOST_CHECK(ir.find("function abi_encode_tuple_t_address_t_uint256__to_t_address_t_uint256__fromStack_inline(") != string::npos);
+	BOOST_CHECK(ir.find("mstore(add(headStart, 0), cleanup_t_address(value0))") != string::npos);
+	BOOST_CHECK(ir.find("mstore(add(headStart, 32), cleanup_t_uint256(value1))") != string::npos);
+	BOOST_CHECK(ir.find("function abi_encode_tuple_t_uint256__to_t_uint256__fromStack(") != string::npos);
+	BOOST_CHECK(ir.find("abi_encode_tuple_t_uint256__to_t_uint256__fromStack_inline") == string::npos);
+	BOOST_CHECK(ir.find("abi_encode_t_address_to_t_address_fromStack(") == string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_invalid_call_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "callProfile": { "e2179b": 9 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"Invalid function selector in \"callProfile\": \"e2179b\". Expected 8 hex digits."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_yul_inliner_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "enabled": true, "details": { "yul": true, "yulDetails": {
+				"inlinerProfile": { "fun_f_6": 120, "fun_g_10": 0 }
+			} } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public {} function g() public {} }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract["metadata"].isString());
+	Json::Value metadata;
+	BOOST_CHECK(util::jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(!optimizer.isMember("enabled"));
+	Json::Value const& inlinerProfile = optimizer["details"]["yulDetails"]["inlinerProfile"];
+	BOOST_CHECK(inlinerProfile.isObject());
+	BOOST_CHECK_EQUAL(inlinerProfile.getMemberNames().size(), 2);
+	BOOST_CHECK(inlinerProfile["fun_f_6"].asUInt() == 120);
+	BOOST_CHECK(inlinerProfile["fun_g_10"].asUInt() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_invalid_yul_inliner_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "details": { "yul": true, "yulDetails": {
+				"inlinerProfile": { "fun_f_6": "often" }
+			} } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"The execution count of \"fun_f_6\" in \"inlinerProfile\" must be an unsigned number."
+	));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1815,6 +2125,467 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { function f(uint x) public pure returns (uint) { return x + 1; } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"A.sol": {
+					"C": ["optimizerProfile"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	Json::Value const& profile = result["contracts"]["A.sol"]["C"]["optimizerProfile"];
+	BOOST_REQUIRE(profile.isArray());
+	BOOST_REQUIRE(profile.size() > 0);
+	for (Json::Value const& object: profile)
+	{
+		BOOST_CHECK(object["name"].isString());
+		BOOST_CHECK(object["durationInMicroseconds"].isInt64());
+		BOOST_CHECK(object["repeatIterations"].asUInt64() > 0);
+		BOOST_REQUIRE(object["steps"].isObject());
+		BOOST_CHECK(object["steps"]["ExpressionSimplifier"]["runs"].asUInt64() > 0);
+	}
+
+	// Profiling is not selected by the wildcard.
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"][0] = "*";
+	result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	BOOST_CHECK(!result["contracts"]["A.sol"]["C"].isMember("optimizerProfile"));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_time_budget)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { function f(uint x) public pure returns (uint) { return x + 1; } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true, "details": { "timeBudget": 0 } },
+			"outputSelection": {
+				"A.sol": {
+					"C": ["evm.bytecode.object", "optimizerProfile"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	BOOST_CHECK(!result["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["object"].asString().empty());
+	BOOST_CHECK(containsAtMostWarnings(result));
+	size_t budgetWarnings = 0;
+	for (Json::Value const& error: result["errors"])
+		if (error["errorCode"].asString() == "4958")
+			++budgetWarnings;
+	BOOST_CHECK(budgetWarnings == 1);
+
+	// Only the clean-up sequence and the hard-coded steps were run.
+	Json::Value const& profile = result["contracts"]["A.sol"]["C"]["optimizerProfile"];
+	BOOST_REQUIRE(profile.isArray());
+	BOOST_REQUIRE(profile.size() > 0);
+	for (Json::Value const& object: profile)
+	{
+		BOOST_CHECK(object["timeBudgetExhausted"].asBool());
+		BOOST_CHECK(object["repeatIterations"].asUInt64() == 0);
+		BOOST_CHECK(!object["steps"].isMember("ExpressionSimplifier"));
+	}
+
+	parsedInput["settings"]["optimizer"]["details"]["timeBudget"] = "fast";
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizer.details.timeBudget\" must be an unsigned number."));
+}
+
+BOOST_AUTO_TEST_CASE(assembly_optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { mapping(uint => uint) m; function f(uint x) public returns (uint) { m[x] = x + 1; return m[x & 0xff]; } }"
+			}
+		},
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"A.sol": {
+					"C": ["assemblyOptimizerProfile"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	Json::Value const& profile = result["contracts"]["A.sol"]["C"]["assemblyOptimizerProfile"];
+	BOOST_REQUIRE(profile.isObject());
+	BOOST_REQUIRE(profile.isMember("PeepholeOptimiser"));
+	BOOST_REQUIRE(profile.isMember("CommonSubexpressionEliminator"));
+	for (string const& component: profile.getMemberNames())
+		for (string const& optimisation: profile[component].getMemberNames())
+			BOOST_CHECK(profile[component][optimisation].asUInt64() > 0);
+
+	// Profiling is not selected by the wildcard.
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"][0] = "*";
+	result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	BOOST_CHECK(!result["contracts"]["A.sol"]["C"].isMember("assemblyOptimizerProfile"));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { function f(uint x) public pure { assert(x >= 0); } }"
+			}
+		},
+		"settings": {
+			"modelChecker": { "engine": "all" },
+			"outputSelection": {
+				"A.sol": {
+					"C": ["modelCheckerProfile"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	Json::Value const& profile = result["contracts"]["A.sol"]["C"]["modelCheckerProfile"];
+	BOOST_REQUIRE(profile.isObject());
+	// The engines only analyze the contract if a solver is available.
+	if (ModelChecker::availableSolvers().z3)
+	{
+		BOOST_CHECK(profile.isMember("bmc"));
+		BOOST_CHECK(profile["chc"]["queries"].asUInt64() > 0);
+	}
+	for (string const& engine: profile.getMemberNames())
+	{
+		BOOST_CHECK(profile[engine]["encodingTimeInMicroseconds"].isInt64());
+		BOOST_CHECK(profile[engine]["solverTimeInMicroseconds"].isInt64());
+		BOOST_CHECK(profile[engine]["queries"].isUInt64());
+	}
+
+	// The profile is not selected by the wildcard.
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"][0] = "*";
+	result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	BOOST_CHECK(!result["contracts"]["A.sol"]["C"].isMember("modelCheckerProfile"));
+}
+
+BOOST_AUTO_TEST_CASE(compilation_stats)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { function f() public pure returns (uint) { return 42; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"A.sol": {
+					"C": ["evm.compilationStats", "evm.bytecode.object"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"]["evm"].isObject());
+	Json::Value const& stats = result["contracts"]["A.sol"]["C"]["evm"]["compilationStats"];
+	BOOST_REQUIRE(stats["sharedPhases"].isArray());
+	BOOST_REQUIRE(stats["phases"].isArray());
+	auto phaseNames = [](Json::Value const& _phases) {
+		vector<string> names;
+		for (Json::Value const& phase: _phases)
+		{
+			BOOST_CHECK(phase["durationInMicroseconds"].isInt64());
+			names.push_back(phase["name"].asString());
+		}
+		return names;
+	};
+	vector<string> sharedPhases = phaseNames(stats["sharedPhases"]);
+	BOOST_REQUIRE(!sharedPhases.empty());
+	BOOST_CHECK(sharedPhases.front() == "parsing");
+	BOOST_CHECK(find(sharedPhases.begin(), sharedPhases.end(), "typeChecking") != sharedPhases.end());
+	vector<string> expectedPhases{"metadata", "evmCodeGeneration", "evmasmOptimization", "assembly"};
+	BOOST_CHECK(phaseNames(stats["phases"]) == expectedPhases);
+
+	// The statistics are selected neither by the wildcard nor by "evm".
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"] = Json::arrayValue;
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"].append("*");
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"].append("evm");
+	result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"]["evm"].isObject());
+	BOOST_CHECK(!result["contracts"]["A.sol"]["C"]["evm"].isMember("compilationStats"));
+}
+
+BOOST_AUTO_TEST_CASE(gas_map)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { uint x; function f(uint a) public returns (uint) { x = g(a); return x; } function g(uint a) internal pure returns (uint) { return a * 7; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"A.sol": {
+					"C": ["evm.gasMap", "evm.deployedBytecode.object"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	for (bool viaIR: {false, true})
+	{
+		parsedInput["settings"]["viaIR"] = viaIR;
+		Json::Value result = compiler.compile(parsedInput);
+
+		Json::Value const& evm = result["contracts"]["A.sol"]["C"]["evm"];
+		BOOST_REQUIRE(evm["gasMap"]["creation"].isObject());
+		Json::Value const& runtime = evm["gasMap"]["runtime"];
+		BOOST_REQUIRE(runtime["sourceRanges"].isArray());
+		BOOST_REQUIRE(runtime["functions"].isObject());
+
+		uint64_t totalBytes = 0;
+		bool containsStore = false;
+		for (Json::Value const& range: runtime["sourceRanges"])
+		{
+			BOOST_CHECK(range["start"].isInt());
+			BOOST_CHECK(range["length"].isInt());
+			BOOST_CHECK(range["source"].isInt());
+			totalBytes += range["bytes"].asUInt64();
+			// One of the ranges contains the storage write.
+			if (range["gas"].asUInt64() >= 20000)
+				containsStore = true;
+		}
+		BOOST_CHECK(containsStore);
+		BOOST_CHECK(totalBytes > 0);
+		BOOST_CHECK(totalBytes <= evm["deployedBytecode"]["object"].asString().size() / 2);
+		BOOST_CHECK(!runtime["functions"].empty());
+		for (string const& name: runtime["functions"].getMemberNames())
+			BOOST_CHECK(runtime["functions"][name]["gas"].isUInt64());
+	}
+
+	// The gas map is selected neither by the wildcard nor by "evm".
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"] = Json::arrayValue;
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"].append("*");
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"].append("evm");
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"]["evm"].isObject());
+	BOOST_CHECK(!result["contracts"]["A.sol"]["C"]["evm"].isMember("gasMap"));
+}
+
+BOOST_AUTO_TEST_CASE(storage_packing_advice)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { struct S { bool x; uint y; bool z; } uint a; uint128 b; uint c; uint128 d; S s; function f() public { b = 1; d = 2; s.x = true; s.z = true; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"A.sol": {
+					"C": ["storagePackingAdvice"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+
+	Json::Value const& advice = result["contracts"]["A.sol"]["C"]["storagePackingAdvice"];
+	BOOST_REQUIRE(advice.isObject());
+	Json::Value const& storage = advice["storage"];
+	BOOST_CHECK_EQUAL(storage["slots"].asString(), "7");
+	BOOST_CHECK_EQUAL(storage["suggestedSlots"].asString(), "6");
+	BOOST_CHECK_EQUAL(storage["slotsSaved"].asString(), "1");
+	vector<string> order;
+	for (Json::Value const& field: storage["suggestedOrder"])
+		order.push_back(field["label"].asString());
+	BOOST_CHECK((order == vector<string>{"a", "c", "s", "b", "d"}));
+	BOOST_REQUIRE_EQUAL(storage["writtenTogether"].size(), 1);
+	BOOST_CHECK_EQUAL(storage["writtenTogether"][0]["function"].asString(), "f");
+	BOOST_REQUIRE_EQUAL(storage["writtenTogether"][0]["fields"].size(), 2);
+	BOOST_CHECK_EQUAL(storage["writtenTogether"][0]["fields"][0]["label"].asString(), "b");
+	BOOST_CHECK_EQUAL(storage["writtenTogether"][0]["fields"][0]["slot"].asString(), "1");
+	BOOST_CHECK_EQUAL(storage["writtenTogether"][0]["fields"][1]["label"].asString(), "d");
+	BOOST_CHECK_EQUAL(storage["writtenTogether"][0]["fields"][1]["slot"].asString(), "3");
+
+	BOOST_REQUIRE_EQUAL(advice["types"].size(), 1);
+	Json::Value const& structAdvice = advice["types"][advice["types"].getMemberNames().front()];
+	BOOST_CHECK_EQUAL(structAdvice["label"].asString(), "struct C.S");
+	BOOST_CHECK_EQUAL(structAdvice["slots"].asString(), "3");
+	BOOST_CHECK_EQUAL(structAdvice["suggestedSlots"].asString(), "2");
+	BOOST_REQUIRE_EQUAL(structAdvice["writtenTogether"].size(), 1);
+	BOOST_CHECK_EQUAL(structAdvice["writtenTogether"][0]["fields"].size(), 2);
+
+	// The advice is not selected by the wildcard.
+	parsedInput["settings"]["outputSelection"]["A.sol"]["C"][0] = "*";
+	result = compiler.compile(parsedInput);
+	BOOST_REQUIRE(result["contracts"]["A.sol"]["C"].isObject());
+	BOOST_CHECK(!result["contracts"]["A.sol"]["C"].isMember("storagePackingAdvice"));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract A { function f() public {} } contract B {}"
+			},
+			"B.sol": {
+				"content": "import \"A.sol\"; contract C is A {}"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["abi", "evm.bytecode.object"],
+					"": ["ast"]
+				}
+			}
+		}
+	}
+	)";
+
+	solidity::frontend::StandardCompiler compiler;
+	string const expected = compiler.compile(string(input));
+	ostringstream streamed;
+	compiler.compile(string(input), streamed);
+
+	Json::Value expectedOutput;
+	Json::Value streamedOutput;
+	BOOST_REQUIRE(util::jsonParseStrict(expected, expectedOutput));
+	BOOST_REQUIRE(util::jsonParseStrict(streamed.str(), streamedOutput));
+	BOOST_REQUIRE(streamedOutput["contracts"]["A.sol"]["A"].isObject());
+	BOOST_REQUIRE(streamedOutput["contracts"]["A.sol"]["B"].isObject());
+	BOOST_REQUIRE(streamedOutput["contracts"]["B.sol"]["C"].isObject());
+	BOOST_CHECK(streamedOutput == expectedOutput);
+	BOOST_CHECK(streamed.str().find("{\"contracts\":{\"A.sol\":{\"A\":") == 0);
+}
+
+BOOST_AUTO_TEST_CASE(released_intermediates)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "contract C { uint[] x; function f() public { x.push(1); } } contract D { function g() public returns (C) { return new C(); } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["evm.bytecode.object", "evm.bytecode.sourceMap", "evm.deployedBytecode.generatedSources"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	for (bool viaIR: {false, true})
+	{
+		parsedInput["settings"]["viaIR"] = viaIR;
+		parsedInput["settings"]["outputSelection"]["*"]["*"].resize(3);
+		solidity::frontend::StandardCompiler compiler;
+		// Only the bytecode, source mappings and generated sources are kept.
+		Json::Value released = compiler.compile(parsedInput);
+		parsedInput["settings"]["outputSelection"]["*"]["*"].append("evm.assembly");
+		parsedInput["settings"]["outputSelection"]["*"]["*"].append("irOptimized");
+		Json::Value retained = compiler.compile(parsedInput);
+		BOOST_REQUIRE(containsAtMostWarnings(released));
+		BOOST_REQUIRE(containsAtMostWarnings(retained));
+
+		for (char const* contractName: {"C", "D"})
+		{
+			Json::Value const& releasedEvm = released["contracts"]["A.sol"][contractName]["evm"];
+			Json::Value const& retainedEvm = retained["contracts"]["A.sol"][contractName]["evm"];
+			BOOST_REQUIRE(!releasedEvm["bytecode"]["object"].asString().empty());
+			BOOST_CHECK(releasedEvm["bytecode"] == retainedEvm["bytecode"]);
+			BOOST_CHECK(releasedEvm["deployedBytecode"] == retainedEvm["deployedBytecode"]);
+			BOOST_CHECK(!retainedEvm["assembly"].asString().empty());
+			BOOST_CHECK(!retained["contracts"]["A.sol"][contractName]["irOptimized"].asString().empty());
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
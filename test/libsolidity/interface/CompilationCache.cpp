@@ -0,0 +1,155 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/interface/CompilationCache.h
+
+#include <libsolidity/formal/ModelChecker.h>
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+using namespace std;
+using namespace solidity::util;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+/// In-memory cache that records how it is being used.
+class RecordingCompilationCache: public CompilationCache
+{
+public:
+	optional<string> load(h256 const& _key) override
+	{
+		++loads;
+		if (entries.count(_key))
+			return entries.at(_key);
+		return nullopt;
+	}
+	void store(h256 const& _key, string const& _artifact) override
+	{
+		++stores;
+		entries[_key] = _artifact;
+	}
+
+	map<h256, string> entries;
+	size_t loads = 0;
+	size_t stores = 0;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(CompilationCacheTest)
+
+BOOST_AUTO_TEST_CASE(file_system_cache_round_trip)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	FileSystemCompilationCache cache(tempDir.path() / "cache");
+
+	BOOST_TEST(!cache.load(keccak256("a")).has_value());
+
+	cache.store(keccak256("a"), "artifact a");
+	cache.store(keccak256("b"), "");
+	BOOST_TEST(boost::filesystem::is_directory(tempDir.path() / "cache"));
+	BOOST_TEST((cache.load(keccak256("a")) == optional<string>("artifact a")));
+	BOOST_TEST((cache.load(keccak256("b")) == optional<string>("")));
+
+	cache.store(keccak256("a"), "replaced");
+	BOOST_TEST((FileSystemCompilationCache(tempDir.path() / "cache").load(keccak256("a")) == optional<string>("replaced")));
+}
+
+BOOST_AUTO_TEST_CASE(optimized_ir_is_reused)
+{
+	auto cache = make_shared<RecordingCompilationCache>();
+	auto compile = [&](string const& _source) {
+		CompilerStack compiler;
+		compiler.setSources({{"a.sol", _source}});
+		compiler.setOptimiserSettings(true);
+		compiler.setViaIR(true);
+		compiler.setCompilationCache(cache);
+		BOOST_REQUIRE(compiler.compile());
+		return make_pair(compiler.yulIROptimized("C"), compiler.object("C").bytecode);
+	};
+
+	string const source = "pragma solidity >=0.0; contract C { function f(uint x) public pure returns (uint) { return x * 2; } }";
+	auto const [firstIR, firstBytecode] = compile(source);
+	BOOST_TEST(cache->loads == 1);
+	BOOST_TEST(cache->stores == 1);
+
+	auto const [secondIR, secondBytecode] = compile(source);
+	BOOST_TEST(cache->loads == 2);
+	BOOST_TEST(cache->stores == 1);
+	BOOST_TEST(firstIR == secondIR);
+	BOOST_TEST((firstBytecode == secondBytecode));
+
+	compile("pragma solidity >=0.0; contract C { function f(uint x) public pure returns (uint) { return x * 3; } }");
+	BOOST_TEST(cache->loads == 3);
+	BOOST_TEST(cache->stores == 2);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_skips_unchanged_functions)
+{
+	if (!ModelChecker::availableSolvers().z3)
+		return;
+
+	auto cache = make_shared<RecordingCompilationCache>();
+	auto analyze = [&](string const& _f) {
+		ModelCheckerSettings settings;
+		settings.engine = ModelCheckerEngine::BMC();
+		CompilerStack compiler;
+		compiler.setSources({{"a.sol",
+			"pragma solidity >=0.0;\n"
+			"contract C {\n"
+			"	uint x;\n"
+			"	function f() public pure returns (uint) { return " + _f + "; }\n"
+			"	function g(uint a) public { x = a; assert(x == a); }\n"
+			"}\n"
+		}});
+		compiler.setModelCheckerSettings(settings);
+		compiler.setCompilationCache(cache);
+		BOOST_REQUIRE(compiler.parseAndAnalyze());
+		BOOST_TEST(compiler.errors().empty());
+	};
+
+	analyze("1");
+	size_t stores = cache->stores;
+	BOOST_TEST(stores > 2);
+
+	// Both functions were proved safe before.
+	analyze("1");
+	BOOST_TEST(cache->stores == stores);
+
+	// Only the changed function is analyzed again. It has no targets and therefore needs no query.
+	analyze("2");
+	BOOST_TEST(cache->stores == stores + 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
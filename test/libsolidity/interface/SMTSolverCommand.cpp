@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+/// Unit tests for libsolidity/interface/SMTSolverCommand.h
+
+#include <libsolidity/interface/SMTSolverCommand.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/TemporaryDirectory.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity::util;
+
+#define TEST_CASE_NAME (boost::unit_test::framework::current_test_case().p_name)
+
+namespace solidity::frontend::test
+{
+
+#if defined(__linux) || defined(__APPLE__)
+
+namespace
+{
+
+/// Creates a fake solver that answers `sat` to every `(check-sat)` and records the id of each of
+/// its processes in `pids`. Without arguments it speaks the interactive protocol.
+boost::filesystem::path createFakeSolver(boost::filesystem::path const& _directory)
+{
+	boost::filesystem::path solver = _directory / "solver";
+	boost::filesystem::ofstream(solver) <<
+		"#!/bin/sh\n"
+		"echo $$ >> \"" << (_directory / "pids").string() << "\"\n"
+		"if [ \"$1\" != \"-in\" ]; then echo sat; exit 0; fi\n"
+		"while read -r line; do\n"
+		"  case \"$line\" in\n"
+		"    \"(check-sat)\") echo sat ;;\n"
+		"    \"(echo \"*) m=\"${line#(echo \\\"}\"; echo \"${m%\\\")}\" ;;\n"
+		"    \"(exit)\") exit 0 ;;\n"
+		"  esac\n"
+		"done\n";
+	boost::filesystem::permissions(solver, boost::filesystem::owner_all);
+	return solver;
+}
+
+size_t countLines(boost::filesystem::path const& _file)
+{
+	string content = readFileAsString(_file);
+	return static_cast<size_t>(count(content.begin(), content.end(), '\n'));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SMTSolverCommandTest)
+
+BOOST_AUTO_TEST_CASE(new_process_per_query)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	SMTSolverCommand solver(createFakeSolver(tempDir.path()).string());
+	string const kind = ReadCallback::kindString(ReadCallback::Kind::SMTQuery);
+
+	for (size_t i = 0; i < 2; ++i)
+	{
+		ReadCallback::Result result = solver.solve(kind, "(assert true)\n(check-sat)\n");
+		BOOST_TEST(result.success);
+		BOOST_TEST(result.responseOrErrorMessage == "sat");
+	}
+	BOOST_TEST(countLines(tempDir.path() / "pids") == 2);
+}
+
+BOOST_AUTO_TEST_CASE(interactive_process_is_reused)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	{
+		SMTSolverCommand solver(createFakeSolver(tempDir.path()).string(), {"-in"});
+		string const kind = ReadCallback::kindString(ReadCallback::Kind::SMTQuery);
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			ReadCallback::Result result = solver.solve(kind, "(assert true)\n(check-sat)\n");
+			BOOST_TEST(result.success);
+			BOOST_TEST(result.responseOrErrorMessage == "sat");
+		}
+	}
+	BOOST_TEST(countLines(tempDir.path() / "pids") == 1);
+}
+
+BOOST_AUTO_TEST_CASE(missing_solver)
+{
+	SMTSolverCommand solver("solc-test-solver-that-does-not-exist", {"-in"});
+	ReadCallback::Result result = solver.solve(ReadCallback::kindString(ReadCallback::Kind::SMTQuery), "(check-sat)\n");
+	BOOST_TEST(!result.success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
+
+}
@@ -0,0 +1,28 @@
+contract C {
+    uint256[] a;
+    bytes32[3] b;
+    int256[] c;
+
+    function fromCalldata(uint256[] calldata x, bytes32[3] calldata y) external returns (uint256, uint256, bytes32) {
+        a = x;
+        b = y;
+        return (a.length, a[a.length - 1], b[2]);
+    }
+
+    function fromMemory() external returns (uint256, int256, int256) {
+        int256[] memory x = new int256[](4);
+        x[0] = -1;
+        x[3] = type(int256).min;
+        c = x;
+        return (c.length, c[0], c[3]);
+    }
+
+    function shrink() external returns (uint256, uint256) {
+        a = new uint256[](1);
+        return (a.length, a[0]);
+    }
+}
+// ----
+// fromCalldata(uint256[],bytes32[3]): 0x80, 1, 2, 3, 3, 7, 8, 9 -> 3, 9, 3
+// fromMemory() -> 4, -1, -57896044618658097711785492504343953926634992332820282019728792003956564819968
+// shrink() -> 1, 0
@@ -0,0 +1,38 @@
+contract C {
+    uint public x;
+    function f0() public returns (uint) { return 0; }
+    function f1() public returns (uint) { return 1; }
+    function f2() public returns (uint) { return 2; }
+    function f3() public returns (uint) { return 3; }
+    function f4() public returns (uint) { return 4; }
+    function f5() public returns (uint) { return 5; }
+    function f6() public returns (uint) { return 6; }
+    function f7() public returns (uint) { return 7; }
+    function f8() public returns (uint) { return 8; }
+    function f9() public returns (uint) { return 9; }
+    function f10() public returns (uint) { return 10; }
+    function f11() public returns (uint) { return 11; }
+    fallback() external { x = 42; }
+}
+// ====
+// allowNonExistingFunctions: true
+// ----
+// f0() -> 0
+// f1() -> 1
+// f2() -> 2
+// f3() -> 3
+// f4() -> 4
+// f5() -> 5
+// f6() -> 6
+// f7() -> 7
+// f8() -> 8
+// f9() -> 9
+// f10() -> 10
+// f11() -> 11
+// x() -> 0
+// i_am_not_there() ->
+// x() -> 42
+// (): hex"00000000"
+// x() -> 42
+// (): hex"ffffffff"
+// x() -> 42
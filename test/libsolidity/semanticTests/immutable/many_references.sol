@@ -0,0 +1,50 @@
+contract C {
+	uint256 immutable a;
+	address immutable owner;
+	constructor() {
+		a = 0x0102030405060708091011121314151617181920212223242526272829303132;
+		owner = address(0x1234567890123456789012345678901234567890);
+	}
+	function f0() public view returns (uint256) { return a; }
+	function f1() public view returns (uint256) { return a + 1; }
+	function f2() public view returns (uint256) { return a - 2; }
+	function f3() public view returns (uint256) { return a ^ 3; }
+	function f4() public view returns (uint256) { return a >> 4; }
+	function f5() public view returns (uint256) { return a << 5; }
+	function f6() public view returns (uint256) { return a / 6; }
+	function f7() public view returns (uint256) { return a % 7; }
+	function f8() public view returns (uint256) { return a & 8; }
+	function f9() public view returns (uint256) { return a | 9; }
+	function f10() public view returns (uint256) { return a / 10; }
+	function f11() public view returns (uint256) { return a % 11; }
+	function f12() public view returns (uint256) { return a - 12; }
+	function f13() public view returns (uint256) { return a + 13; }
+	function f14() public view returns (uint256) { return a ^ 14; }
+	function f15() public view returns (uint256) { return a >> 15; }
+	function f16() public view returns (uint256) { return a << 16; }
+	function f17() public view returns (uint256) { return a / 17; }
+	function f18() public view returns (uint256) { return a % 18; }
+	function f19() public view returns (uint256) { return a | 19; }
+	function g0() public view returns (address) { return owner; }
+	function g1() public view returns (bool) { return msg.sender == owner; }
+	function g2() public view returns (uint160) { return uint160(owner) + 2; }
+	function g3() public view returns (uint160) { return uint160(owner) - 3; }
+}
+// ----
+// f0() -> 0x0102030405060708091011121314151617181920212223242526272829303132
+// f1() -> 0x0102030405060708091011121314151617181920212223242526272829303133
+// f2() -> 0x0102030405060708091011121314151617181920212223242526272829303130
+// f3() -> 0x0102030405060708091011121314151617181920212223242526272829303131
+// f4() -> 0x10203040506070809101112131415161718192021222324252627282930313
+// f5() -> 0x20406080a0c0e101220222426282a2c2e303240424446484a4c4e50526062640
+// f8() -> 0
+// f9() -> 0x010203040506070809101112131415161718192021222324252627282930313b
+// f12() -> 0x0102030405060708091011121314151617181920212223242526272829303126
+// f13() -> 0x010203040506070809101112131415161718192021222324252627282930313f
+// f14() -> 0x010203040506070809101112131415161718192021222324252627282930313c
+// f16() -> 0x0304050607080910111213141516171819202122232425262728293031320000
+// f19() -> 0x0102030405060708091011121314151617181920212223242526272829303133
+// g0() -> 0x1234567890123456789012345678901234567890
+// g1() -> false
+// g2() -> 0x1234567890123456789012345678901234567892
+// g3() -> 0x123456789012345678901234567890123456788d
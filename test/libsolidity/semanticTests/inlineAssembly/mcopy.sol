@@ -0,0 +1,20 @@
+contract C {
+    function overlapping() external pure returns (bytes32 a, bytes32 b) {
+        assembly {
+            mstore(0, 0x0102030405060708091011121314151617181920212223242526272829303132)
+            mstore(32, 0)
+            mcopy(1, 0, 33)
+            a := mload(0)
+            b := mload(32)
+        }
+    }
+
+    function concatenate(bytes memory x, bytes memory y) external pure returns (bytes memory) {
+        return bytes.concat(x, y, x);
+    }
+}
+// ====
+// EVMVersion: >=cancun
+// ----
+// overlapping() -> 0x0101020304050607080910111213141516171819202122232425262728293031, 0x3200000000000000000000000000000000000000000000000000000000000000
+// concatenate(bytes,bytes): 0x40, 0x80, 3, "abc", 2, "de" -> 0x20, 8, "abcdeabc"
@@ -0,0 +1,17 @@
+contract C {
+    uint public l;
+    constructor() {
+        string memory s = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ!?abcdefghijklmnopqrstuvwxyz0123456789";
+        l = bytes(s).length + uint8(bytes(s)[99]);
+    }
+    function f() public pure returns (string memory) {
+        return "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ!?abcdefghijklmnopqrstuvwxyz0123456789";
+    }
+    function g() public pure {
+        revert("abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ!?abcdefghijklmnopqrstuvwxyz0123456789");
+    }
+}
+// ----
+// l() -> 157
+// f() -> 0x20, 100, "abcdefghijklmnopqrstuvwxyz012345", "6789ABCDEFGHIJKLMNOPQRSTUVWXYZ!?", "abcdefghijklmnopqrstuvwxyz012345", "6789"
+// g() -> FAILURE, hex"08c379a0", 0x20, 100, "abcdefghijklmnopqrstuvwxyz012345", "6789ABCDEFGHIJKLMNOPQRSTUVWXYZ!?", "abcdefghijklmnopqrstuvwxyz012345", "6789"
@@ -0,0 +1,29 @@
+contract A {
+	uint x;
+	function f() public view {
+		assert(x < 10); // fails only for B
+	}
+	function g(uint a) public {
+		require(a < 10);
+		x = a;
+	}
+}
+
+contract B is A {
+	uint y;
+	constructor() {
+		x = 20;
+	}
+}
+
+contract C is A {
+	uint z;
+	function h() public {
+		z = 1;
+	}
+}
+// ====
+// SMTEngine: all
+// SMTIgnoreCex: yes
+// ----
+// Warning 6328: (52-66): CHC: Assertion violation happens here.
@@ -0,0 +1,13 @@
+contract C {
+    int8 constant a = (-2)**7;
+    int8 constant b = (-2)**7 - 1;
+    uint8 constant c = 2**8;
+    uint256 constant d = 2**256 - 1;
+    uint256 constant e = 2**256;
+    uint[6 / 3 * 4 - 2**3 + 1] x;
+    uint[(-4)**3 / 2**5 + 3] y;
+}
+// ----
+// TypeError 7407: (66-77): Type int_const -129 is not implicitly convertible to expected type int8. Literal is too large to fit in int8.
+// TypeError 7407: (102-106): Type int_const 256 is not implicitly convertible to expected type uint8. Literal is too large to fit in uint8.
+// TypeError 7407: (170-176): Type int_const 1157...(70 digits omitted)...9936 is not implicitly convertible to expected type uint256. Literal is too large to fit in uint256.
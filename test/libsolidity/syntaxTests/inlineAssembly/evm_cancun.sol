@@ -0,0 +1,12 @@
+contract C {
+    function f() pure external returns (bytes32 r) {
+        assembly {
+            mstore(0, 42)
+            mcopy(32, 0, 32)
+            r := mload(32)
+        }
+    }
+}
+// ====
+// EVMVersion: >=cancun
+// ----
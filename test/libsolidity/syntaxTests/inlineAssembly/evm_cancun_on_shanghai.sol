@@ -0,0 +1,13 @@
+contract C {
+    function f() pure external returns (bytes32 r) {
+        assembly {
+            mstore(0, 42)
+            mcopy(32, 0, 32)
+            r := mload(32)
+        }
+    }
+}
+// ====
+// EVMVersion: =shanghai
+// ----
+// TypeError 7755: (123-128): The "mcopy" instruction is only available for Cancun-compatible VMs (you are currently compiling for "shanghai").
@@ -0,0 +1,123 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for FixedU256, which compare the results with those of u256.
+ */
+
+#include <libsolutil/FixedU256.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// @returns a random number that is often small, has all bits of a limb set or is close to a power of two.
+u256 randomNumber(mt19937_64& _generator)
+{
+	u256 result = 0;
+	size_t const limbs = 1 + _generator() % 4;
+	for (size_t i = 0; i < limbs; ++i)
+	{
+		uint64_t limb = _generator();
+		switch (_generator() % 8)
+		{
+		case 0: limb = 0; break;
+		case 1: limb = ~uint64_t(0); break;
+		case 2: limb = 1; break;
+		default: break;
+		}
+		result = (result << 64) | limb;
+	}
+	if (_generator() % 4 == 0)
+		result >>= static_cast<unsigned>(_generator() % 256);
+	return result;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(FixedU256Test)
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+	for (u256 value: {u256(0), u256(1), u256(0xffffffff), (u256(1) << 64), (u256(1) << 255), ~u256(0)})
+	{
+		BOOST_CHECK_EQUAL(FixedU256(value).toU256(), value);
+		BOOST_CHECK_EQUAL(FixedU256(value).isZero(), value == 0);
+		BOOST_CHECK_EQUAL(FixedU256(value).bitLength(), value == 0 ? 0 : boost::multiprecision::msb(value) + 1);
+	}
+	BOOST_CHECK(FixedU256(u256(1) << 200).bit(200));
+	BOOST_CHECK(!FixedU256(u256(1) << 200).bit(199));
+}
+
+BOOST_AUTO_TEST_CASE(division_by_zero)
+{
+	BOOST_CHECK((FixedU256(7) / FixedU256(0)).isZero());
+	BOOST_CHECK((FixedU256(7) % FixedU256(0)).isZero());
+}
+
+BOOST_AUTO_TEST_CASE(exponentiation)
+{
+	BOOST_CHECK_EQUAL(FixedU256::exp(2, 255).toU256(), u256(1) << 255);
+	BOOST_CHECK(FixedU256::exp(2, 256).isZero());
+	BOOST_CHECK_EQUAL(FixedU256::exp(0, 0).toU256(), 1);
+	BOOST_CHECK_EQUAL(FixedU256::exp(10, 18).toU256(), u256("1000000000000000000"));
+	BOOST_CHECK_EQUAL(FixedU256::exp(FixedU256(~u256(0)), 3).toU256(), ~u256(0));
+}
+
+BOOST_AUTO_TEST_CASE(differential)
+{
+	mt19937_64 generator(42);
+	for (size_t i = 0; i < 20000; ++i)
+	{
+		u256 const a = randomNumber(generator);
+		// Divisors close to the dividend exercise the correction steps of the division.
+		u256 const b = i % 5 == 0 ? (a >> static_cast<unsigned>(generator() % 8)) : randomNumber(generator);
+		size_t const shift = generator() % 300;
+		FixedU256 const fixedA(a);
+		FixedU256 const fixedB(b);
+
+		BOOST_REQUIRE_EQUAL((fixedA + fixedB).toU256(), u256(a + b));
+		BOOST_REQUIRE_EQUAL((fixedA - fixedB).toU256(), u256(a - b));
+		BOOST_REQUIRE_EQUAL((fixedA * fixedB).toU256(), u256(a * b));
+		BOOST_REQUIRE_EQUAL((fixedA / fixedB).toU256(), b == 0 ? u256(0) : u256(a / b));
+		BOOST_REQUIRE_EQUAL((fixedA % fixedB).toU256(), b == 0 ? u256(0) : u256(a % b));
+		BOOST_REQUIRE_EQUAL((fixedA & fixedB).toU256(), u256(a & b));
+		BOOST_REQUIRE_EQUAL((fixedA | fixedB).toU256(), u256(a | b));
+		BOOST_REQUIRE_EQUAL((fixedA ^ fixedB).toU256(), u256(a ^ b));
+		BOOST_REQUIRE_EQUAL((~fixedA).toU256(), u256(~a));
+		BOOST_REQUIRE_EQUAL((fixedA << shift).toU256(), shift >= 256 ? u256(0) : u256(a << static_cast<unsigned>(shift)));
+		BOOST_REQUIRE_EQUAL((fixedA >> shift).toU256(), shift >= 256 ? u256(0) : u256(a >> static_cast<unsigned>(shift)));
+		BOOST_REQUIRE_EQUAL(fixedA < fixedB, a < b);
+		BOOST_REQUIRE_EQUAL(fixedA == fixedB, a == b);
+		BOOST_REQUIRE_EQUAL(
+			FixedU256::exp(fixedA, fixedB).toU256(),
+			u256(boost::multiprecision::powm(bigint(a), bigint(b), bigint(1) << 256))
+		);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -106,6 +106,20 @@ BOOST_AUTO_TEST_CASE(test_multi_level_tree)
 	BOOST_CHECK_EQUAL(ipfsHashBase58(data), "QmaTb1sT9hrSXJLmf8bxJ9NuwndiHuMLsgNLgkS2eXu3Xj");
 }
 
+BOOST_AUTO_TEST_CASE(test_streaming)
+{
+	string data;
+	for (size_t i = 0; i < 1024 * 256 * 3 + 17; ++i)
+		data.push_back(static_cast<char>(i * 7 + i / 251));
+	for (size_t pieceSize: {1ul, 1000ul, 1024ul * 256ul, 1024ul * 256ul + 1ul})
+	{
+		IpfsHasher hasher;
+		for (size_t offset = 0; offset < data.size(); offset += pieceSize)
+			hasher.update(bytesConstRef(data).cropped(offset, min(pieceSize, data.size() - offset)));
+		BOOST_CHECK(hasher.finalize() == ipfsHash(data));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
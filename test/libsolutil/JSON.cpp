@@ -118,6 +118,30 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_compact_print_escaping)
+{
+	Json::Value json;
+	json["a"] = string("\"\\/\b\f\n\r\t\x01\x1f\0x", 12);
+	json["b"] = "\xf0\x9f\x98\x80 \xe2\x82\xac \xc0\x80";
+	json["c"] = Json::arrayValue;
+	json["d"] = Json::objectValue;
+	json["e"].append(Json::Value());
+	json["e"].append(true);
+	json["e"].append(Json::Int64(-9223372036854775807 - 1));
+	json["e"].append(Json::UInt64(18446744073709551615u));
+	json["e"].append(0.5);
+	json[string("f\0g", 3)] = "";
+
+	BOOST_CHECK_EQUAL(
+		jsonCompactPrint(json),
+		"{\"a\":\"\\\"\\\\/\\b\\f\\n\\r\\t\\u0001\\u001f\\u0000x\","
+		"\"b\":\"\\ud83d\\ude00 \\u20ac \\ufffd\","
+		"\"c\":[],\"d\":{},"
+		"\"e\":[null,true,-9223372036854775808,18446744073709551615,0.5],"
+		"\"f\\u0000g\":\"\"}"
+	);
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
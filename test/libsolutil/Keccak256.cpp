@@ -69,6 +69,36 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(batch)
+{
+	BOOST_CHECK(keccak256Batch({}).empty());
+
+	// Lengths around the block size of 136 bytes, in groups of equal and of different numbers of blocks.
+	vector<bytes> inputs;
+	for (size_t length = 0; length < 3 * 136 + 2; ++length)
+	{
+		bytes input(length);
+		for (size_t i = 0; i < length; ++i)
+			input[i] = static_cast<uint8_t>(length * 31 + i);
+		inputs.emplace_back(std::move(input));
+	}
+	inputs.emplace_back(bytes(135, 0xff));
+	inputs.emplace_back(bytes(136, 0xff));
+
+	vector<bytesConstRef> refs;
+	for (bytes const& input: inputs)
+		refs.emplace_back(&input);
+	vector<h256> hashes = keccak256Batch(refs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+
+	BOOST_CHECK_EQUAL(
+		keccak256Batch({bytesConstRef("test"), bytesConstRef("test"), bytesConstRef("test"), bytesConstRef("test")}).back(),
+		FixedHash<32>("0x9c22ff5f21f0b81b113e63f7db6da94fedef11b2119b4088b89664fb9a3cb658")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for sha256.
+ */
+#include <libsolutil/SHA256.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(SHA256, *boost::unit_test::label("nooptions"))
+
+BOOST_AUTO_TEST_CASE(strings)
+{
+	BOOST_CHECK_EQUAL(
+		sha256(bytes()),
+		FixedHash<32>("0xe3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")
+	);
+	BOOST_CHECK_EQUAL(
+		sha256(asBytes("abc")),
+		FixedHash<32>("0xba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")
+	);
+	// Needs a second block for the padding.
+	BOOST_CHECK_EQUAL(
+		sha256(asBytes("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")),
+		FixedHash<32>("0x248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1")
+	);
+	BOOST_CHECK_EQUAL(
+		sha256(bytes(1000000, 'a')),
+		FixedHash<32>("0xcdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(pieces)
+{
+	bytes data;
+	for (size_t i = 0; i < 4 * 256; ++i)
+		data.push_back(uint8_t(i));
+	data.push_back('x');
+	h256 const expectation("0x8b22d5427688462387bbd8fcef9d2a1f1cb3a8886cd48e604b29e2913b663399");
+	BOOST_CHECK_EQUAL(sha256(data), expectation);
+
+	for (size_t pieceSize: {1u, 7u, 63u, 64u, 65u, 200u})
+	{
+		SHA256Hasher hasher;
+		for (size_t offset = 0; offset < data.size(); offset += pieceSize)
+			hasher.update(bytesConstRef(&data).cropped(offset, min(pieceSize, data.size() - offset)));
+		BOOST_CHECK_EQUAL(hasher.finalize(), expectation);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -103,6 +103,21 @@ BOOST_AUTO_TEST_CASE(bzz_hash_nonzero)
 	BOOST_CHECK_EQUAL(bzzr1HashHex(sequence(4096 * 130)), "59de730bf6c67a941f3b2ffa2f920acfaa1713695ad5deea12b4a121e5f23fa1");
 }
 
+BOOST_AUTO_TEST_CASE(bzz_hash_streaming)
+{
+	for (size_t length: {0ul, 65ul, 4096ul * 128ul + 31ul, 4096ul * 128ul * 2ul + 4097ul})
+	{
+		bytes data = sequence(length);
+		for (size_t pieceSize: {1ul, 100ul, 4096ul, 4097ul})
+		{
+			Bzzr1Hasher hasher;
+			for (size_t offset = 0; offset < data.size(); offset += pieceSize)
+				hasher.update(bytesConstRef(&data).cropped(offset, min(pieceSize, data.size() - offset)));
+			BOOST_CHECK_EQUAL(toHex(hasher.finalize().asBytes()), bzzr1HashHex(data));
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
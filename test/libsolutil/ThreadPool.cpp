@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// Sets the number of threads of the pool for the lifetime of the object.
+class ScopedMaxThreads
+{
+public:
+	explicit ScopedMaxThreads(size_t _threads): m_previous(ThreadPool::instance().maxThreads())
+	{
+		ThreadPool::instance().setMaxThreads(_threads);
+	}
+	~ScopedMaxThreads() { ThreadPool::instance().setMaxThreads(m_previous); }
+
+private:
+	size_t m_previous;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(sequential_by_default)
+{
+	BOOST_CHECK_EQUAL(ThreadPool::instance().maxThreads(), size_t(1));
+	vector<size_t> order;
+	ThreadPool::instance().parallelFor(5, [&](size_t _index) { order.push_back(_index); });
+	BOOST_TEST(order == (vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(all_indices_processed)
+{
+	ScopedMaxThreads threads(4);
+	for (size_t count: vector<size_t>{0, 1, 3, 100, 1000})
+	{
+		vector<size_t> result(count, 0);
+		ThreadPool::instance().parallelFor(count, [&](size_t _index) { result[_index] += _index + 1; });
+		for (size_t i = 0; i < count; ++i)
+			BOOST_CHECK_EQUAL(result[i], i + 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(nested_loops)
+{
+	ScopedMaxThreads threads(4);
+	vector<vector<size_t>> result(20, vector<size_t>(20, 0));
+	ThreadPool::instance().parallelFor(result.size(), [&](size_t _outer) {
+		ThreadPool::instance().parallelFor(result[_outer].size(), [&](size_t _inner) {
+			result[_outer][_inner] = _outer * _inner;
+		});
+	});
+	for (size_t i = 0; i < result.size(); ++i)
+		for (size_t j = 0; j < result[i].size(); ++j)
+			BOOST_CHECK_EQUAL(result[i][j], i * j);
+}
+
+BOOST_AUTO_TEST_CASE(exception_is_rethrown)
+{
+	ScopedMaxThreads threads(4);
+	BOOST_CHECK_THROW(
+		ThreadPool::instance().parallelFor(100, [&](size_t _index) {
+			if (_index == 42)
+				throw runtime_error("failure");
+		}),
+		runtime_error
+	);
+	// The pool is still usable afterwards.
+	vector<size_t> result(10, 0);
+	ThreadPool::instance().parallelFor(result.size(), [&](size_t _index) { result[_index] = 1; });
+	BOOST_TEST(result == vector<size_t>(10, 1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
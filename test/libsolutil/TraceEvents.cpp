@@ -0,0 +1,114 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/TraceEvents.h>
+
+#include <libsolutil/JSON.h>
+#include <libsolutil/PhaseStatistics.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// Enables the recording of trace events for the lifetime of the object.
+class ScopedTraceEvents
+{
+public:
+	ScopedTraceEvents()
+	{
+		TraceEvents::instance().clear();
+		TraceEvents::instance().enable();
+	}
+	~ScopedTraceEvents()
+	{
+		TraceEvents::instance().enable(false);
+		TraceEvents::instance().clear();
+	}
+};
+
+Json::Value recordedEvents()
+{
+	Json::Value trace;
+	BOOST_REQUIRE(jsonParseStrict(TraceEvents::instance().toJson(), trace));
+	BOOST_REQUIRE(trace["traceEvents"].isArray());
+	return trace["traceEvents"];
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TraceEventsTest)
+
+BOOST_AUTO_TEST_CASE(disabled_by_default)
+{
+	BOOST_CHECK(!TraceEvents::instance().enabled());
+	{
+		TraceSpan span("span", "test");
+	}
+	BOOST_CHECK_EQUAL(recordedEvents().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(spans_and_phases)
+{
+	ScopedTraceEvents traceEvents;
+	{
+		TraceSpan outer("outer", "test", {{"contract", "C"}});
+		PhaseRecorder phases("first", nullptr);
+		phases.start("second");
+	}
+
+	Json::Value events = recordedEvents();
+	BOOST_REQUIRE_EQUAL(events.size(), 3);
+	// Spans are recorded when they end.
+	BOOST_CHECK_EQUAL(events[0]["name"].asString(), "first");
+	BOOST_CHECK_EQUAL(events[0]["cat"].asString(), "phase");
+	BOOST_CHECK_EQUAL(events[1]["name"].asString(), "second");
+	BOOST_CHECK_EQUAL(events[2]["name"].asString(), "outer");
+	BOOST_CHECK_EQUAL(events[2]["args"]["contract"].asString(), "C");
+	for (Json::Value const& event: events)
+	{
+		BOOST_CHECK_EQUAL(event["ph"].asString(), "X");
+		BOOST_CHECK(event["tid"] == events[0]["tid"]);
+	}
+	BOOST_CHECK(events[0]["ts"].asInt64() >= events[2]["ts"].asInt64());
+	BOOST_CHECK(events[1]["ts"].asInt64() >= events[0]["ts"].asInt64() + events[0]["dur"].asInt64());
+}
+
+BOOST_AUTO_TEST_CASE(thread_ids)
+{
+	ScopedTraceEvents traceEvents;
+	{
+		TraceSpan span("main", "test");
+	}
+	thread([] { TraceSpan span("worker", "test"); }).join();
+
+	Json::Value events = recordedEvents();
+	BOOST_REQUIRE_EQUAL(events.size(), 2);
+	BOOST_CHECK(events[0]["tid"] != events[1]["tid"]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
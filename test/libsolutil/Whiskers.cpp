@@ -241,6 +241,26 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(reused_template)
+{
+	string templ = "<?c><a><!c>-</c><#l><x></l>";
+	for (size_t i = 0; i < 3; ++i)
+	{
+		string result = Whiskers(templ)
+			("a", to_string(i))
+			("c", i % 2 == 0)
+			("l", vector<map<string, string>>(i, {{"x", "x"}}))
+			.render();
+		BOOST_CHECK_EQUAL(result, (i % 2 == 0 ? to_string(i) : "-") + string(i, 'x'));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(unterminated_blocks_rendered)
+{
+	string templ = "<#l>a</m> <?c>b <a>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A").render(), "<#l>a</m> <?c>b A");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -127,6 +127,36 @@ BOOST_AUTO_TEST_CASE(difference)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(known_bits)
+{
+	yul::KnowledgeBase kb = constructKnowledgeBase(R"({
+		let x := calldataload(0)
+		let a := and(x, 0xff)
+		let b := add(a, shr(248, x))
+		let c := shl(8, b)
+		let d := lt(x, 7)
+		let e := signextend(1, x)
+		let f := caller()
+	})");
+
+	auto bits = [&](string const& _name) { return kb.possiblyNonZeroBits(Identifier{{}, YulString{_name}}); };
+	BOOST_CHECK(bits("x") == ~u256(0));
+	BOOST_CHECK(bits("a") == 0xff);
+	BOOST_CHECK(bits("b") == 0x1ff);
+	BOOST_CHECK(bits("c") == 0x1ff00);
+	BOOST_CHECK(bits("d") == 1);
+	BOOST_CHECK(bits("f") == (u256(1) << 160) - 1);
+
+	auto signExtended = [&](string const& _name, unsigned _bytes) {
+		return kb.knownToBeSignExtended(Identifier{{}, YulString{_name}}, _bytes);
+	};
+	BOOST_CHECK(signExtended("a", 1));
+	BOOST_CHECK(!signExtended("a", 0));
+	BOOST_CHECK(signExtended("e", 1));
+	BOOST_CHECK(signExtended("e", 2));
+	BOOST_CHECK(!signExtended("e", 0));
+	BOOST_CHECK(!signExtended("x", 30));
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,126 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the binary representation of Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/ObjectSerialiser.h>
+#include <libyul/YulStack.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+YulStack makeStack()
+{
+	return YulStack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::All()
+	);
+}
+
+string const c_source = R"(
+	/// @use-src 0:"a.sol", 1:"b.sol"
+	object "A" {
+		code {
+			/// @src 0:10:20
+			function f(a, b) -> c {
+				/// @src 1:30:40 @ast-id 7
+				switch a
+				case 0 { c := b }
+				case "abc" { leave }
+				default { c := add(a, 0x20) }
+			}
+			for { let i := 0 } lt(i, 10) { i := add(i, 1) } {
+				if eq(i, 5) { continue }
+				if true { break }
+			}
+			let x, y
+			{ sstore(0, f(1, 2)) }
+			datacopy(0, dataoffset("A_deployed"), datasize("A_deployed"))
+			return(0, datasize("A_deployed"))
+		}
+		/// @use-src 0:"a.sol"
+		object "A_deployed" {
+			code { mstore(0, 42) return(0, 32) }
+			data "d" hex"0102"
+		}
+		data ".metadata" "meta"
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectSerialiser)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	YulStack stack = makeStack();
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", c_source));
+	bytes serialised = stack.serialise();
+	BOOST_CHECK(ObjectDeserialiser::isSerialisedObject(bytesConstRef(&serialised)));
+
+	YulStack loadedStack = makeStack();
+	BOOST_REQUIRE(loadedStack.loadAndAnalyze("source", serialised));
+	BOOST_CHECK_EQUAL(loadedStack.print(), stack.print());
+	BOOST_CHECK(loadedStack.serialise() == serialised);
+	BOOST_CHECK(
+		loadedStack.assemble(YulStack::Machine::EVM).bytecode->bytecode ==
+		stack.assemble(YulStack::Machine::EVM).bytecode->bytecode
+	);
+}
+
+BOOST_AUTO_TEST_CASE(malformed)
+{
+	YulStack stack = makeStack();
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", c_source));
+	bytes serialised = stack.serialise();
+
+	YulStack loadedStack = makeStack();
+	BOOST_CHECK_THROW(loadedStack.loadAndAnalyze("source", util::asBytes("object \"A\" { code {} }")), ObjectDeserialisationError);
+	for (size_t length: {size_t(0), size_t(5), serialised.size() / 2, serialised.size() - 1})
+		BOOST_CHECK_THROW(
+			loadedStack.loadAndAnalyze("source", bytes(serialised.begin(), serialised.begin() + static_cast<ptrdiff_t>(length))),
+			ObjectDeserialisationError
+		);
+	serialised.push_back(0);
+	BOOST_CHECK_THROW(loadedStack.loadAndAnalyze("source", serialised), ObjectDeserialisationError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
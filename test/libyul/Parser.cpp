@@ -58,9 +58,9 @@ shared_ptr<Block> parse(string const& _source, Dialect const& _dialect, ErrorRep
 	try
 	{
 		auto stream = CharStream(_source, "");
-		map<unsigned, shared_ptr<string const>> indicesToSourceNames;
-		indicesToSourceNames[0] = make_shared<string const>("source0");
-		indicesToSourceNames[1] = make_shared<string const>("source1");
+		map<unsigned, string const*> indicesToSourceNames;
+		indicesToSourceNames[0] = internSourceName("source0");
+		indicesToSourceNames[1] = internSourceName("source1");
 
 		auto parserResult = yul::Parser(
 			errorReporter,
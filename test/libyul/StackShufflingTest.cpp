@@ -49,6 +49,48 @@ BOOST_AUTO_TEST_CASE(swap_cycle)
 	createStackLayout(sourceStack, targetStack, [](auto){}, [](auto){}, [](){});
 }
 
+BOOST_AUTO_TEST_CASE(optimal_small_layouts)
+{
+	std::vector<Scope::Variable> scopeVariables;
+	std::vector<VariableSlot> v;
+	for (size_t i = 0; i < 4; ++i)
+		scopeVariables.emplace_back(Scope::Variable{""_yulstring, YulString{"v" + to_string(i)}});
+	for (size_t i = 0; i < 4; ++i)
+		v.emplace_back(VariableSlot{scopeVariables[i]});
+
+	auto shufflingCost = [](auto _createStackLayout, Stack _sourceStack, Stack const& _targetStack) {
+		unsigned cost = 0;
+		_createStackLayout(
+			_sourceStack,
+			_targetStack,
+			[&](unsigned) { cost += 3; },
+			[&](StackSlot const&) { cost += 3; },
+			[&]() { cost += 2; }
+		);
+		return cost;
+	};
+	auto greedyCost = [&](Stack const& _sourceStack, Stack const& _targetStack) {
+		return shufflingCost([](auto&&... _args) { createStackLayout(_args...); }, _sourceStack, _targetStack);
+	};
+	auto optimalCost = [&](Stack const& _sourceStack, Stack const& _targetStack) {
+		return shufflingCost([](auto&&... _args) { createOptimalStackLayout(_args...); }, _sourceStack, _targetStack);
+	};
+
+	std::vector<std::pair<Stack, Stack>> layouts{
+		{{v[0], v[1], v[2]}, {v[1], v[2], v[0]}},
+		{{v[0], v[1], v[2], v[3]}, {v[3], LiteralSlot{1}, v[0]}},
+		{{v[0], v[1], v[2]}, {v[0], v[2], v[2], v[1]}},
+		{{v[0], v[1], v[2], v[3]}, {JunkSlot{}, v[1], v[0], JunkSlot{}}},
+		{{v[0], v[1], v[2], v[3]}, {v[3], v[2], v[1], v[0]}}
+	};
+	for (auto const& [sourceStack, targetStack]: layouts)
+		BOOST_CHECK_LE(optimalCost(sourceStack, targetStack), greedyCost(sourceStack, targetStack));
+
+	BOOST_CHECK_EQUAL(optimalCost({v[0], v[1], v[2]}, {v[1], v[2], v[0]}), 6u);
+	BOOST_CHECK_EQUAL(optimalCost({v[0], v[1], v[2]}, {v[0], v[2], v[2], v[1]}), 6u);
+	BOOST_CHECK_EQUAL(optimalCost({v[0], v[1], v[2], v[3]}, {JunkSlot{}, v[1], v[0], JunkSlot{}}), 6u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -26,7 +26,9 @@
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/CircularReferencesPruner.h>
 #include <libyul/optimiser/ConditionalUnsimplifier.h>
+#include <libyul/optimiser/ConditionalConstantPropagator.h>
 #include <libyul/optimiser/ConditionalSimplifier.h>
+#include <libyul/optimiser/ColdCodeOutliner.h>
 #include <libyul/optimiser/CommonSubexpressionEliminator.h>
 #include <libyul/optimiser/EqualStoreEliminator.h>
 #include <libyul/optimiser/EquivalentFunctionCombiner.h>
@@ -34,14 +36,20 @@
 #include <libyul/optimiser/FunctionGrouper.h>
 #include <libyul/optimiser/FunctionHoister.h>
 #include <libyul/optimiser/FunctionSpecializer.h>
+#include <libyul/optimiser/GlobalValueNumberer.h>
 #include <libyul/optimiser/ExpressionInliner.h>
+#include <libyul/optimiser/FreeMemoryPointerResolver.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopConditionIntoBody.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopCounterCheckEliminator.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
+#include <libyul/optimiser/LoopMemoryReclaimer.h>
+#include <libyul/optimiser/LoopUnroller.h>
 #include <libyul/optimiser/MainFunction.h>
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/StorageWriteCombiner.h>
 #include <libyul/optimiser/NameDisplacer.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -130,6 +138,10 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			disambiguate();
 			ConditionalUnsimplifier::run(*m_context, *m_ast);
 		}},
+		{"conditionalConstantPropagator", [&]() {
+			disambiguate();
+			ConditionalConstantPropagator::run(*m_context, *m_ast);
+		}},
 		{"conditionalSimplifier", [&]() {
 			disambiguate();
 			ConditionalSimplifier::run(*m_context, *m_ast);
@@ -158,10 +170,18 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_object->code);
 			FunctionSpecializer::run(*m_context, *m_object->code);
 		}},
+		{"globalValueNumberer", [&]() {
+			disambiguate();
+			GlobalValueNumberer::run(*m_context, *m_ast);
+		}},
 		{"expressionInliner", [&]() {
 			disambiguate();
 			ExpressionInliner::run(*m_context, *m_ast);
 		}},
+		{"freeMemoryPointerResolver", [&]() {
+			disambiguate();
+			FreeMemoryPointerResolver::run(*m_context, *m_ast);
+		}},
 		{"fullInliner", [&]() {
 			disambiguate();
 			FunctionHoister::run(*m_context, *m_ast);
@@ -223,6 +243,11 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			CircularReferencesPruner::run(*m_context, *m_ast);
 		}},
+		{"coldCodeOutliner", [&]() {
+			disambiguate();
+			FunctionHoister::run(*m_context, *m_ast);
+			ColdCodeOutliner::run(*m_context, *m_ast);
+		}},
 		{"deadCodeEliminator", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -253,6 +278,10 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			ForLoopInitRewriter::run(*m_context, *m_ast);
 			EqualStoreEliminator::run(*m_context, *m_ast);
 		}},
+		{"storageWriteCombiner", [&]() {
+			disambiguate();
+			StorageWriteCombiner::run(*m_context, *m_ast);
+		}},
 		{"ssaPlusCleanup", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -279,6 +308,18 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(
 			FunctionHoister::run(*m_context, *m_ast);
 			LoopInvariantCodeMotion::run(*m_context, *m_ast);
 		}},
+		{"loopCounterCheckEliminator", [&]() {
+			disambiguate();
+			LoopCounterCheckEliminator::run(*m_context, *m_ast);
+		}},
+		{"loopMemoryReclaimer", [&]() {
+			disambiguate();
+			LoopMemoryReclaimer::run(*m_context, *m_ast);
+		}},
+		{"loopUnroller", [&]() {
+			disambiguate();
+			LoopUnroller::run(*m_context, *m_ast);
+		}},
 		{"controlFlowSimplifier", [&]() {
 			disambiguate();
 			ForLoopInitRewriter::run(*m_context, *m_ast);
@@ -0,0 +1,105 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a{"yul_string_test_a"};
+	YulString b{"yul_string_test_b"};
+	BOOST_CHECK(a != b);
+	BOOST_CHECK(a == YulString{"yul_string_test_a"});
+	BOOST_CHECK_EQUAL(a.str(), "yul_string_test_a");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("yul_string_test_a"));
+	BOOST_CHECK(YulString{}.empty());
+	BOOST_CHECK(YulString{""} == YulString{});
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	// Enough strings to span several storage chunks.
+	vector<YulString> strings;
+	for (size_t i = 0; i < 20000; ++i)
+		strings.emplace_back("yul_string_test_many_" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(strings[i].str(), "yul_string_test_many_" + to_string(i));
+		BOOST_CHECK(strings[i] == YulString{"yul_string_test_many_" + to_string(i)});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 5000;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("yul_string_test_concurrent_" + to_string(i));
+		});
+	for (auto& t: threads)
+		t.join();
+
+	for (size_t i = 0; i < stringCount; ++i)
+	{
+		BOOST_CHECK_EQUAL(results[0][i].str(), "yul_string_test_concurrent_" + to_string(i));
+		for (size_t t = 1; t < threadCount; ++t)
+			BOOST_CHECK(results[t][i] == results[0][i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(persistent_strings)
+{
+	YulString persistent;
+	{
+		YulStringRepository::PersistentScope persistentScope;
+		persistent = YulString{"yul_string_test_persistent"};
+	}
+	YulString transient{"yul_string_test_transient"};
+	BOOST_CHECK(transient != persistent);
+
+	YulStringRepository::reset();
+	BOOST_CHECK_EQUAL(persistent.str(), "yul_string_test_persistent");
+	BOOST_CHECK(persistent == YulString{"yul_string_test_persistent"});
+	// Removed strings are interned again without clashing with the persistent ones.
+	transient = YulString{"yul_string_test_transient"};
+	BOOST_CHECK_EQUAL(transient.str(), "yul_string_test_transient");
+	BOOST_CHECK(transient != persistent);
+	BOOST_CHECK(YulString{"yul_string_test_transient"} == transient);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -1157,6 +1157,79 @@ BOOST_AUTO_TEST_CASE(standard_json_include_paths)
 	BOOST_TEST(result.reader.basePath() == expectedWorkDir / "base/");
 }
 
+BOOST_AUTO_TEST_CASE(server_mode)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	TemporaryWorkingDirectory tempWorkDir(tempDir);
+
+	string const preamble =
+		"// SPDX-License-Identifier: GPL-3.0\n"
+		"pragma solidity >=0.0;\n";
+	createFilesWithParentDirs({tempDir.path() / "imported.sol"}, preamble + "contract I {}\n");
+
+	// Both requests import the same file through the callback and the second one is not valid JSON.
+	string const request =
+		R"({"language": "Solidity", "sources": {"main.sol": {"content": ")" + preamble +
+		R"(import 'imported.sol'; contract C is I {}"}}, "settings": {"outputSelection": {"*": {"*": ["abi"]}}}})";
+	string const standardInput = request + "\n\n" + request + "\n" + "{\n";
+
+	OptionsReaderAndMessages result = runCLI({"solc", "--server", "--base-path=."}, standardInput);
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(result.stderrContent == "");
+
+	vector<string> responses;
+	boost::split(responses, result.stdoutContent, boost::is_any_of("\n"));
+	BOOST_REQUIRE(responses.size() == 4);
+	BOOST_TEST(responses.back() == "");
+	for (size_t i = 0; i < 3; ++i)
+	{
+		Json::Value response;
+		BOOST_REQUIRE(util::jsonParseStrict(responses[i], response));
+		if (i < 2)
+		{
+			for (Json::Value const& errorDict: response["errors"])
+				// The error list might contain pre-release compiler warning
+				BOOST_TEST(errorDict["severity"] != "error");
+			BOOST_TEST(response["contracts"]["main.sol"]["C"]["abi"].isArray());
+			BOOST_TEST(response["sources"].isMember("imported.sol"));
+		}
+		else
+			BOOST_TEST(response["errors"][0]["type"] == "JSONError");
+	}
+}
+
+BOOST_AUTO_TEST_CASE(assemble_and_link_multiple_files_in_parallel)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	TemporaryWorkingDirectory tempWorkDir(tempDir);
+
+	vector<string> yulFiles;
+	for (size_t i = 0; i < 8; ++i)
+	{
+		yulFiles.push_back("input" + to_string(i) + ".yul");
+		createFilesWithParentDirs({tempDir.path() / yulFiles.back()}, "{ sstore(" + to_string(i) + ", calldataload(0)) }");
+	}
+
+	vector<string> assemblerCommandLine = {"solc", "--strict-assembly", "--bin", "--optimize"};
+	assemblerCommandLine += yulFiles;
+	OptionsReaderAndMessages sequential = runCLI(assemblerCommandLine);
+	OptionsReaderAndMessages parallel = runCLI(assemblerCommandLine + vector<string>{"--optimizer-threads=4"});
+	BOOST_REQUIRE(sequential.success);
+	BOOST_REQUIRE(parallel.success);
+	BOOST_TEST(parallel.stdoutContent == sequential.stdoutContent);
+	BOOST_TEST(parallel.stderrContent == sequential.stderrContent);
+
+	string const placeholder = "__$" + string(34, 'a') + "$__";
+	createFilesWithParentDirs({tempDir.path() / "a.bin"}, "6000" + placeholder + "6000");
+	createFilesWithParentDirs({tempDir.path() / "b.bin"}, "6001" + placeholder + "6001");
+	OptionsReaderAndMessages linked = runCLI({"solc", "--link", "--optimizer-threads=4", "a.bin", "b.bin"});
+	BOOST_REQUIRE(linked.success);
+	BOOST_TEST(linked.stderrContent ==
+		"Reference \"" + placeholder + "\" in file \"a.bin\" still unresolved.\n"
+		"Reference \"" + placeholder + "\" in file \"b.bin\" still unresolved.\n"
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cli_include_paths_empty_path)
 {
 	TemporaryDirectory tempDir({"base/", "include/"}, TEST_CASE_NAME);
@@ -124,6 +124,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--experimental-via-ir",
 			"--revert-strings=strip",
 			"--debug-info=location",
+			"--cache-dir=/tmp/solc-cache",
 			"--pretty-json",
 			"--json-indent=7",
 			"--no-color",
@@ -134,6 +135,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
 			"--ir", "--ir-optimized", "--ewasm", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
 			"--gas",
+			"--gas-path-budget=1000",
+			"--time-report",
+			"--trace-events=/tmp/trace.json",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,generated-sources,generated-sources-runtime,"
 				"srcmap,srcmap-runtime,function-debug,function-debug-runtime,hashes,devdoc,userdoc,ast",
@@ -142,15 +146,20 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--optimize",
 			"--optimize-runs=1000",
 			"--yul-optimizations=agf",
+			"--optimizer-profile=json",
+			"--optimizer-threads=4",
+			"--model-checker-budget=60000",
 			"--model-checker-contracts=contract1.yul:A,contract2.yul:B",
 			"--model-checker-div-mod-no-slacks",
 			"--model-checker-engine=bmc",
 			"--model-checker-ext-calls=trusted",
 			"--model-checker-invariants=contract,reentrancy",
+			"--model-checker-race-solvers",
 			"--model-checker-show-unproved",
 			"--model-checker-solvers=z3,smtlib2",
 			"--model-checker-targets=underflow,divByZero",
 			"--model-checker-timeout=5",
+			"--model-checker-verdicts-only",
 		};
 
 		if (inputMode == InputMode::CompilerWithASTImport)
@@ -180,6 +189,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.viaIR = true;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
+		expectedOptions.output.cacheDir = "/tmp/solc-cache";
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
 		expectedOptions.linker.libraries = {
 			{"dir1/file1.sol:L", h160("1234567890123456789012345678901234567890")},
@@ -195,6 +205,9 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		};
 		expectedOptions.compiler.outputs.ewasmIR = false;
 		expectedOptions.compiler.estimateGas = true;
+		expectedOptions.compiler.gasPathBudget = 1000;
+		expectedOptions.compiler.timeReport = true;
+		expectedOptions.compiler.traceEventsFile = "/tmp/trace.json";
 		expectedOptions.compiler.combinedJsonRequests = {
 			true, true, true, true, true,
 			true, true, true, true, true,
@@ -206,18 +219,23 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.optimizer.enabled = true;
 		expectedOptions.optimizer.expectedExecutionsPerDeployment = 1000;
 		expectedOptions.optimizer.yulSteps = "agf";
+		expectedOptions.optimizer.profile = true;
+		expectedOptions.optimizer.threads = 4;
 
 		expectedOptions.modelChecker.initialize = true;
 		expectedOptions.modelChecker.settings = {
+			60000,
 			{{{"contract1.yul", {"A"}}, {"contract2.yul", {"B"}}}},
 			true,
 			{true, false},
 			{ModelCheckerExtCalls::Mode::TRUSTED},
 			{{InvariantType::Contract, InvariantType::Reentrancy}},
 			true,
+			true,
 			{false, false, true, true},
 			{{VerificationTargetType::Underflow, VerificationTargetType::DivByZero}},
 			5,
+			true,
 		};
 
 		CommandLineOptions parsedOptions = parseCommandLine(commandLine);
@@ -401,6 +419,26 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	BOOST_TEST(parsedOptions == expectedOptions);
 }
 
+BOOST_AUTO_TEST_CASE(server_mode_options)
+{
+	CommandLineOptions expectedOptions;
+	expectedOptions.input.mode = InputMode::Server;
+	expectedOptions.input.basePath = "/home/user/";
+	expectedOptions.output.cacheDir = "/tmp/cache";
+	expectedOptions.modelChecker.initialize = false;
+
+	CommandLineOptions parsedOptions = parseCommandLine({"solc", "--server", "--base-path=/home/user/", "--cache-dir=/tmp/cache"});
+	BOOST_TEST(parsedOptions == expectedOptions);
+
+	for (vector<string> const& commandLine: vector<vector<string>>{
+		{"solc", "--server", "input.json"},
+		{"solc", "--server", "-"},
+		{"solc", "--server", "--pretty-json"},
+		{"solc", "--server", "--standard-json"},
+	})
+		BOOST_CHECK_THROW(parseCommandLine(commandLine), CommandLineValidationError);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 {
 	map<string, vector<string>> invalidOptionInputModeCombinations = {
@@ -414,8 +452,11 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		{"--model-checker-div-mod-no-slacks", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-engine=bmc", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-invariants=contract,reentrancy", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-budget=60000", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-race-solvers", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-solvers=z3,smtlib2", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-timeout=5", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--model-checker-verdicts-only", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-contracts=contract1.yul:A,contract2.yul:B", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-targets=underflow,divByZero", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}}
 	};
@@ -521,6 +562,22 @@ BOOST_AUTO_TEST_CASE(invalid_optimiser_sequences)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(invalid_optimizer_profile_format)
+{
+	vector<string> const commandLineOptions = {"solc", "contract.sol", "--optimizer-profile=text"};
+	string const expectedErrorMessage = "Invalid format for --optimizer-profile: text. The only supported format is \"json\".";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedErrorMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine(commandLineOptions), CommandLineValidationError, hasCorrectMessage);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_optimizer_threads)
+{
+	vector<string> const commandLineOptions = {"solc", "contract.sol", "--optimizer-threads=0"};
+	string const expectedErrorMessage = "--optimizer-threads must be at least 1.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedErrorMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine(commandLineOptions), CommandLineValidationError, hasCorrectMessage);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace solidity::frontend::test
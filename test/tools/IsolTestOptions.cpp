@@ -69,6 +69,7 @@ void IsolTestOptions::addOptions()
 		("help", po::bool_switch(&showHelp)->default_value(showHelp), "Show this help screen.")
 		("no-color", po::bool_switch(&noColor)->default_value(noColor), "Don't use colors.")
 		("accept-updates", po::bool_switch(&acceptUpdates)->default_value(acceptUpdates), "Automatically accept expectation updates.")
+		("threads,j", po::value<size_t>(&threads)->default_value(threads), "Number of test cases to run in parallel. Their results are reported in the usual order.")
 		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
 }
 
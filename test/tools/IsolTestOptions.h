@@ -32,6 +32,7 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	bool acceptUpdates = false;
+	size_t threads = 1;
 	std::string testFilter = std::string{};
 	std::string editor = std::string{};
 
@@ -105,15 +105,18 @@ void FuzzerUtil::testCompiler(
 	{
 		forceSMT(_input);
 		compiler.setModelCheckerSettings({
+			/*budget=*/std::nullopt,
 			frontend::ModelCheckerContracts::Default(),
 			/*divModWithSlacks*/true,
 			frontend::ModelCheckerEngine::All(),
 			frontend::ModelCheckerExtCalls{},
 			frontend::ModelCheckerInvariants::All(),
+			/*raceSolvers=*/false,
 			/*showUnproved=*/false,
 			smtutil::SMTSolverChoice::All(),
 			frontend::ModelCheckerTargets::Default(),
-			/*timeout=*/1
+			/*timeout=*/1,
+			/*verdictsOnly=*/false
 		});
 	}
 	compiler.setSources(_input);
@@ -190,7 +193,7 @@ void FuzzerUtil::testConstantOptimizer(string const& _input, bool _quiet)
 
 	for (bool isCreation: {false, true})
 	{
-		Assembly assembly{langutil::EVMVersion{}, isCreation, {}};
+		Assembly assembly{langutil::EVMVersion{}, isCreation, {}, {}};
 		for (u256 const& n: numbers)
 		{
 			if (!_quiet)
@@ -18,6 +18,7 @@
 
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/AnsiColorized.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <memory>
 #include <test/Common.h>
@@ -113,7 +114,9 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case and writes the results to @a _stream. Can be called for several
+	/// test tools in parallel.
+	Result process(ostream& _stream);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -146,7 +149,7 @@ private:
 
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool formatted{!m_options.noColor};
 
@@ -154,7 +157,7 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_path, m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{
 				m_path.string(),
@@ -171,22 +174,22 @@ TestTool::Result TestTool::process()
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printSettings(cout, "    ", formatted);
+						AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_stream, "    ", formatted);
+						m_test->printSettings(_stream, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_stream << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -195,19 +198,19 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unknown exception during test: " << boost::current_exception_diagnostic_information() << endl;
 		return Result::Exception;
 	}
@@ -276,6 +279,7 @@ TestStats TestTool::processPath(
 {
 	std::queue<fs::path> paths;
 	paths.push(_path);
+	vector<fs::path> testPaths;
 	int successCount = 0;
 	int testCount = 0;
 	int skippedCount = 0;
@@ -283,11 +287,11 @@ TestStats TestTool::processPath(
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -296,55 +300,71 @@ TestStats TestTool::processPath(
 					paths.push(currentPath / entry.path().filename());
 		}
 		else if (m_exitRequested)
-		{
 			++testCount;
-			paths.pop();
-		}
 		else if (!_batcher.checkAndAdvance())
-		{
-			paths.pop();
 			++skippedCount;
-		}
 		else
+			testPaths.push_back(currentPath);
+	}
+
+	// Test cases are run in chunks, several of them in parallel. Their output is buffered and
+	// printed in order, so failures are reported (and can be handled interactively) as soon as
+	// the chunk they belong to has finished. Without parallelism every chunk contains one test case.
+	size_t const threads = util::ThreadPool::instance().maxThreads();
+	size_t const chunkSize = threads > 1 ? 4 * threads : 1;
+	for (size_t chunkStart = 0; chunkStart < testPaths.size(); chunkStart += chunkSize)
+	{
+		size_t const chunkEnd = min(chunkStart + chunkSize, testPaths.size());
+		vector<unique_ptr<TestTool>> testTools(chunkEnd - chunkStart);
+		vector<ostringstream> outputs(chunkEnd - chunkStart);
+		vector<Result> results(chunkEnd - chunkStart);
+
+		if (!m_exitRequested)
+			util::ThreadPool::instance().parallelFor(testTools.size(), [&](size_t _index) {
+				fs::path const& currentPath = testPaths[chunkStart + _index];
+				testTools[_index] = make_unique<TestTool>(
+					_testCaseCreator,
+					_options,
+					_basepath / currentPath,
+					currentPath.generic_path().string()
+				);
+				results[_index] = testTools[_index]->process(outputs[_index]);
+				// Keep the test cases only as long as they are needed for updating the expectations.
+				if (results[_index] == Result::Success || results[_index] == Result::Skipped)
+					testTools[_index].reset();
+			});
+
+		for (size_t index = 0; index < testTools.size(); ++index)
 		{
 			++testCount;
-			TestTool testTool(
-				_testCaseCreator,
-				_options,
-				fullpath,
-				currentPath.generic_path().string()
-			);
-			auto result = testTool.process();
+			if (m_exitRequested)
+				continue;
 
-			switch(result)
+			cout << outputs[index].str();
+			cout.flush();
+
+			Result result = results[index];
+			while (result == Result::Failure || result == Result::Exception)
 			{
-			case Result::Failure:
-			case Result::Exception:
-				switch(testTool.handleResponse(result == Result::Exception))
+				Request request = testTools[index]->handleResponse(result == Result::Exception);
+				if (request == Request::Rerun)
 				{
-				case Request::Quit:
-					paths.pop();
-					m_exitRequested = true;
-					break;
-				case Request::Rerun:
 					cout << "Re-running test case..." << endl;
-					--testCount;
-					break;
-				case Request::Skip:
-					paths.pop();
-					++skippedCount;
-					break;
+					result = testTools[index]->process(cout);
+					continue;
 				}
+
+				if (request == Request::Quit)
+					m_exitRequested = true;
+				else
+					++skippedCount;
 				break;
-			case Result::Success:
-				paths.pop();
+			}
+
+			if (result == Result::Success)
 				++successCount;
-				break;
-			case Result::Skipped:
-				paths.pop();
+			else if (result == Result::Skipped)
 				++skippedCount;
-				break;
-			}
 		}
 	}
 
@@ -438,6 +458,7 @@ int main(int argc, char const *argv[])
 				return EXIT_SUCCESS;
 
 			options->validate();
+			util::ThreadPool::instance().setMaxThreads(options->threads);
 			CommonOptions::setSingleton(std::move(options));
 		}
 
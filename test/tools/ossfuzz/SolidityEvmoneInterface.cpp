@@ -18,6 +18,8 @@
 
 #include <test/tools/ossfuzz/SolidityEvmoneInterface.h>
 
+#include <libsolidity/interface/CompilationCache.h>
+
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceReferenceFormatter.h>
 
@@ -30,22 +32,139 @@ using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace std;
 
+CompilerOutputCache& CompilerOutputCache::instance()
+{
+	static CompilerOutputCache cache;
+	return cache;
+}
+
+optional<CompilerOutput> const* CompilerOutputCache::find(
+	h256 const& _key,
+	OptimiserSettings const& _optimiserSettings
+) const
+{
+	auto it = m_entries.find(_key);
+	if (it == m_entries.end() || !(it->second.optimiserSettings == _optimiserSettings))
+		return nullptr;
+	return &it->second.output;
+}
+
+void CompilerOutputCache::insert(
+	h256 const& _key,
+	OptimiserSettings _optimiserSettings,
+	optional<CompilerOutput> _output
+)
+{
+	if (m_entries.size() >= maxEntries)
+		m_entries.clear();
+	m_entries[_key] = Entry{std::move(_optimiserSettings), std::move(_output)};
+}
+
+FuzzerStatistics& FuzzerStatistics::instance()
+{
+	static FuzzerStatistics statistics;
+	return statistics;
+}
+
+void FuzzerStatistics::executionFinished()
+{
+	++executions;
+	static bool const enabled = getenv("SOL_FUZZER_STATS") != nullptr;
+	if (!enabled || executions % reportInterval != 0)
+		return;
+
+	auto seconds = [](Clock::duration _duration) {
+		return chrono::duration_cast<chrono::duration<double>>(_duration).count();
+	};
+	double elapsed = seconds(Clock::now() - start);
+	cerr <<
+		"Executions: " << executions <<
+		" (" << static_cast<double>(executions) / elapsed << " exec/s)" <<
+		", compilations: " << compilations <<
+		", cache hits: " << cacheHits <<
+		", compiling: " << seconds(compilationTime) << "s" <<
+		", executing: " << seconds(executionTime) << "s" <<
+		endl;
+}
+
+SolidityCompilationFramework::WarmCompiler::WarmCompiler()
+{
+	stack.setCompilationCache(make_shared<MemoryCompilationCache>(64 * 1024 * 1024));
+}
+
+SolidityCompilationFramework::WarmCompiler& SolidityCompilationFramework::warmCompiler()
+{
+	static WarmCompiler compiler;
+	return compiler;
+}
+
+h256 SolidityCompilationFramework::analysisKey() const
+{
+	string key = m_compilerInput.evmVersion.name() + (m_compilerInput.viaIR ? "+viaIR" : "");
+	for (auto const& [name, content]: m_compilerInput.sourceCode)
+		key += '\0' + name + '\0' + to_string(content.size()) + '\0' + content;
+	return keccak256(key);
+}
+
+h256 SolidityCompilationFramework::compilationKey() const
+{
+	string key = analysisKey().hex() + '\0' + m_compilerInput.contractName;
+	for (auto const& [name, address]: m_compilerInput.libraryAddresses)
+		key += '\0' + name + '=' + address.hex();
+	return keccak256(key);
+}
+
 optional<CompilerOutput> SolidityCompilationFramework::compileContract()
 {
-	m_compiler.setSources(m_compilerInput.sourceCode);
-	m_compiler.setLibraries(m_compilerInput.libraryAddresses);
-	m_compiler.setEVMVersion(m_compilerInput.evmVersion);
-	m_compiler.setOptimiserSettings(m_compilerInput.optimiserSettings);
-	m_compiler.setViaIR(m_compilerInput.viaIR);
-	if (!m_compiler.compile())
+	FuzzerStatistics& statistics = FuzzerStatistics::instance();
+	CompilerOutputCache& cache = CompilerOutputCache::instance();
+	h256 key = compilationKey();
+	if (auto const* cachedOutput = cache.find(key, m_compilerInput.optimiserSettings))
+	{
+		++statistics.cacheHits;
+		return *cachedOutput;
+	}
+
+	auto start = FuzzerStatistics::Clock::now();
+	optional<CompilerOutput> output = compile();
+	statistics.compilationTime += FuzzerStatistics::Clock::now() - start;
+	++statistics.compilations;
+	cache.insert(key, m_compilerInput.optimiserSettings, output);
+	return output;
+}
+
+optional<CompilerOutput> SolidityCompilationFramework::compile()
+{
+	CompilerStack& compiler = m_compiler.stack;
+	h256 analysisKey = this->analysisKey();
+	if (
+		compiler.state() >= CompilerStack::AnalysisPerformed &&
+		!compiler.hasError() &&
+		m_compiler.analysisKey == analysisKey &&
+		m_compiler.optimiserSettings == m_compilerInput.optimiserSettings
+	)
+		compiler.resetCodeGeneration();
+	else
+	{
+		// All settings that differ between inputs are set below.
+		compiler.reset(true);
+		m_compiler.analysisKey = analysisKey;
+		m_compiler.optimiserSettings = m_compilerInput.optimiserSettings;
+		compiler.setSources(m_compilerInput.sourceCode);
+		compiler.setEVMVersion(m_compilerInput.evmVersion);
+		compiler.setOptimiserSettings(m_compilerInput.optimiserSettings);
+		compiler.setViaIR(m_compilerInput.viaIR);
+	}
+	compiler.setLibraries(m_compilerInput.libraryAddresses);
+	if (!compiler.compile())
 	{
 		if (m_compilerInput.debugFailure)
 		{
 			cerr << "Compiling contract failed" << endl;
-			for (auto const& error: m_compiler.errors())
+			for (auto const& error: compiler.errors())
 				cerr << SourceReferenceFormatter::formatErrorInformation(
 					*error,
-					m_compiler
+					compiler
 				);
 		}
 		return {};
@@ -54,11 +173,11 @@ optional<CompilerOutput> SolidityCompilationFramework::compileContract()
 	{
 		string contractName;
 		if (m_compilerInput.contractName.empty())
-			contractName = m_compiler.lastContractName();
+			contractName = compiler.lastContractName();
 		else
 			contractName = m_compilerInput.contractName;
-		evmasm::LinkerObject obj = m_compiler.object(contractName);
-		Json::Value methodIdentifiers = m_compiler.interfaceSymbols(contractName)["methods"];
+		evmasm::LinkerObject obj = compiler.object(contractName);
+		Json::Value methodIdentifiers = compiler.interfaceSymbols(contractName)["methods"];
 		return CompilerOutput{obj.bytecode, methodIdentifiers};
 	}
 }
@@ -107,6 +226,7 @@ evmc::Result EvmoneUtility::deployAndExecute(
 	string const& _hexEncodedInput
 )
 {
+	auto start = FuzzerStatistics::Clock::now();
 	// Deploy contract and signal failure if deploy failed
 	evmc::Result createResult = deployContract(_byteCode);
 	solAssert(
@@ -120,6 +240,9 @@ evmc::Result EvmoneUtility::deployAndExecute(
 		util::fromHex(_hexEncodedInput),
 		createResult.create_address
 	);
+	FuzzerStatistics& statistics = FuzzerStatistics::instance();
+	statistics.executionTime += FuzzerStatistics::Clock::now() - start;
+	statistics.executionFinished();
 
 	// We don't care about EVM One failures other than EVMC_REVERT
 	solAssert(
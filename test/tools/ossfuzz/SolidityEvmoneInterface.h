@@ -28,6 +28,8 @@
 
 #include <evmone/evmone.h>
 
+#include <chrono>
+
 namespace solidity::test::fuzzer
 {
 struct CompilerOutput
@@ -73,10 +75,71 @@ struct CompilerInput
 	bool viaIR;
 };
 
+/**
+ * Compilation outputs of earlier fuzzer inputs, keyed by a hash of the sources and all
+ * settings except the optimiser settings, which are compared on lookup. Different inputs
+ * are often converted to the same source, which then only has to be compiled once.
+ */
+class CompilerOutputCache
+{
+public:
+	/// @returns the cache shared by all compilations of the fuzzer process.
+	static CompilerOutputCache& instance();
+
+	/// @returns the cached output or nullptr if there is none.
+	/// A cached failure is represented by a pointer to nullopt.
+	std::optional<CompilerOutput> const* find(
+		util::h256 const& _key,
+		frontend::OptimiserSettings const& _optimiserSettings
+	) const;
+	void insert(
+		util::h256 const& _key,
+		frontend::OptimiserSettings _optimiserSettings,
+		std::optional<CompilerOutput> _output
+	);
+
+private:
+	/// The cache is cleared once it has this many entries, to bound its memory usage.
+	static size_t constexpr maxEntries = 4096;
+
+	struct Entry
+	{
+		frontend::OptimiserSettings optimiserSettings;
+		std::optional<CompilerOutput> output;
+	};
+	std::map<util::h256, Entry> m_entries;
+};
+
+/**
+ * Counters of the work done by the fuzzer, printed to stderr periodically
+ * if the environment variable SOL_FUZZER_STATS is set.
+ */
+struct FuzzerStatistics
+{
+	using Clock = std::chrono::steady_clock;
+
+	/// @returns the statistics of the fuzzer process.
+	static FuzzerStatistics& instance();
+
+	/// Counts an execution and prints the statistics every reportInterval executions.
+	void executionFinished();
+
+	static size_t constexpr reportInterval = 1000;
+
+	size_t executions = 0;
+	size_t compilations = 0;
+	size_t cacheHits = 0;
+	Clock::duration compilationTime{};
+	Clock::duration executionTime{};
+	Clock::time_point start = Clock::now();
+};
+
 class SolidityCompilationFramework
 {
 public:
-	SolidityCompilationFramework(CompilerInput _input): m_compilerInput(_input)
+	SolidityCompilationFramework(CompilerInput _input):
+		m_compiler(warmCompiler()),
+		m_compilerInput(_input)
 	{}
 	/// Sets contract name to @param _contractName.
 	void contractName(std::string const& _contractName)
@@ -88,17 +151,35 @@ public:
 	{
 		m_compilerInput.libraryAddresses = std::move(_libraryAddresses);
 	}
-	/// @returns method identifiers in contract called @param _contractName.
-	Json::Value methodIdentifiers(std::string const& _contractName)
-	{
-		return m_compiler.interfaceSymbols(_contractName)["methods"];
-	}
 	/// @returns Compilation output comprising EVM bytecode and list of
 	/// method identifiers in contract if compilation is successful,
 	/// null value otherwise.
+	/// The output is taken from the compilation cache if the same input was compiled before.
+	/// If only the contract name or the libraries differ from the previous compilation,
+	/// the analysis of the sources is reused.
 	std::optional<CompilerOutput> compileContract();
 private:
-	frontend::CompilerStack m_compiler;
+	/// The compiler stack that is reused by all compilations of the fuzzer process,
+	/// together with the inputs of its last analysis. Artifacts of the code generation
+	/// are kept in an in-memory compilation cache.
+	struct WarmCompiler
+	{
+		WarmCompiler();
+
+		frontend::CompilerStack stack;
+		std::optional<util::h256> analysisKey;
+		frontend::OptimiserSettings optimiserSettings;
+	};
+	static WarmCompiler& warmCompiler();
+	/// @returns a hash of the sources and the settings that have to be set before parsing,
+	/// except the optimiser settings.
+	util::h256 analysisKey() const;
+	/// @returns a hash of everything the output of compileContract() depends on,
+	/// except the optimiser settings.
+	util::h256 compilationKey() const;
+	std::optional<CompilerOutput> compile();
+
+	WarmCompiler& m_compiler;
 	CompilerInput m_compilerInput;
 };
 
@@ -63,8 +63,10 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	// Do not fuzz the EVM Version field.
 	// See https://github.com/ethereum/solidity/issues/12590
 	langutil::EVMVersion version;
-	EVMHost hostContext(version, evmone);
-	hostContext.reset();
+	// The host is shared by all inputs and returned to its initial state for each of them.
+	static EVMHost hostContext(version, evmone);
+	static EVMHost::Snapshot const initialState = hostContext.snapshot();
+	hostContext.restore(initialState);
 
 	if (const char* dump_path = getenv("PROTO_FUZZER_DUMP_PATH"))
 	{
@@ -131,7 +133,7 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 	}
 
 	// Reset host before running optimised code.
-	hostContext.reset();
+	hostContext.restore(initialState);
 	evmc::Result deployResultOpt = YulEvmoneUtility{}.deployCode(optimisedByteCode, hostContext);
 	solAssert(
 		deployResultOpt.status_code == EVMC_SUCCESS,
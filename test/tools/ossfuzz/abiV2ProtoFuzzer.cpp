@@ -47,7 +47,10 @@ DEFINE_PROTO_FUZZER(Contract const& _input)
 
 	// We target the default EVM which is the latest
 	langutil::EVMVersion version;
-	EVMHost hostContext(version, evmone);
+	// The host is shared by all inputs and returned to its initial state for each of them.
+	static EVMHost hostContext(version, evmone);
+	static EVMHost::Snapshot const initialState = hostContext.snapshot();
+	hostContext.restore(initialState);
 	string contractName = "C";
 	string methodName = "test()";
 	StringMap source({{"test.sol", contract_source}});
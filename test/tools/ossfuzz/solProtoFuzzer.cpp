@@ -65,7 +65,10 @@ DEFINE_PROTO_FUZZER(Program const& _input)
 
 	// We target the default EVM which is the latest
 	langutil::EVMVersion version;
-	EVMHost hostContext(version, evmone);
+	// The host is shared by all inputs and returned to its initial state for each of them.
+	static EVMHost hostContext(version, evmone);
+	static EVMHost::Snapshot const initialState = hostContext.snapshot();
+	hostContext.restore(initialState);
 	string contractName = "C";
 	string libraryName = converter.libraryTest() ? converter.libraryName() : "";
 	string methodName = "test()";
@@ -0,0 +1,362 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of the gas used at runtime by contracts compiled with the legacy and the via-IR
+ * pipeline, each with and without the optimizer.
+ */
+
+#include <test/Common.h>
+#include <test/ExecutionFramework.h>
+#include <test/TestCaseReader.h>
+#include <test/libsolidity/util/SoltestTypes.h>
+#include <test/libsolidity/util/TestFileParser.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend::test;
+using namespace solidity::test;
+
+namespace fs = boost::filesystem;
+namespace po = boost::program_options;
+
+namespace
+{
+
+auto const description = R"(solgasbench, runtime gas benchmark of the compiler pipelines.
+Usage: solgasbench [Options]
+Deploys the benchmark contracts, replays their transactions on evmone and prints the gas
+used by every transaction with each pipeline as JSON. The transactions follow the source
+after a "// ----" line, in the same format as in semantic tests. Files without transactions
+are only deployed.
+
+Allowed options)";
+
+struct GasBenchOptions: CommonOptions
+{
+	bool showHelp = false;
+	vector<fs::path> benchmarks;
+	fs::path output;
+
+	GasBenchOptions(): CommonOptions(description) {}
+
+	void addOptions() override
+	{
+		CommonOptions::addOptions();
+		options.add_options()
+			("help", po::bool_switch(&showHelp)->default_value(showHelp), "Show this help screen.")
+			(
+				"benchmark",
+				po::value<vector<fs::path>>(&benchmarks),
+				"Benchmark file or directory of benchmark files, can be supplied multiple times. "
+				"Defaults to the benchmarks and benchmarks/gas directories in the test path."
+			)
+			("output", po::value<fs::path>(&output), "Write the report to this file instead of stdout.");
+	}
+
+	bool parse(int _argc, char const* const* _argv) override
+	{
+		bool const shouldContinue = CommonOptions::parse(_argc, _argv);
+		if (showHelp || !shouldContinue)
+		{
+			cout << options << endl;
+			return false;
+		}
+		if (benchmarks.empty())
+			benchmarks = {testPath / "benchmarks", testPath / "benchmarks" / "gas"};
+		return true;
+	}
+};
+
+/// A way of compiling the benchmark contracts. Its name is used as the key in the report,
+/// matching the names of the gas expectations in semantic tests.
+struct Pipeline
+{
+	string name;
+	bool viaIR;
+	bool optimize;
+};
+
+vector<Pipeline> const pipelines{
+	{"legacy", false, false},
+	{"legacyOptimized", false, true},
+	{"ir", true, false},
+	{"irOptimized", true, true}
+};
+
+/// Outcome of one transaction of a benchmark.
+struct Transaction
+{
+	u256 gasUsed;
+	/// Whether the status and the output of the transaction match the expectations.
+	bool asExpected = true;
+};
+
+/**
+ * Deploys the contracts of a benchmark file and replays its transactions, with the contracts
+ * compiled by one of the pipelines. The contracts are compiled without metadata, so that the
+ * deployment costs do not change with every compiler commit.
+ */
+class GasBenchmark: public ExecutionFramework
+{
+public:
+	GasBenchmark(SourceMap const& _sources, Pipeline const& _pipeline):
+		ExecutionFramework(CommonOptions::get().evmVersion(), CommonOptions::get().vmPaths),
+		m_sources(_sources),
+		m_viaIR(_pipeline.viaIR)
+	{
+		// The settings of `solc --optimize`.
+		m_optimiserSettings = _pipeline.optimize ? frontend::OptimiserSettings::standard() : frontend::OptimiserSettings::minimal();
+	}
+
+	bytes const& compileAndRunWithoutCheck(
+		map<string, string> const& _sourceCode,
+		u256 const& _value = 0,
+		string const& _contractName = "",
+		bytes const& _arguments = {},
+		map<string, Address> const& _libraryAddresses = {},
+		optional<string> const& _sourceName = nullopt
+	) override
+	{
+		m_compiler.reset();
+		m_compiler.setSources(_sourceCode);
+		m_compiler.setEVMVersion(m_evmVersion);
+		m_compiler.setEOFVersion(CommonOptions::get().eofVersion());
+		m_compiler.setOptimiserSettings(m_optimiserSettings);
+		m_compiler.setViaIR(m_viaIR);
+		m_compiler.setLibraries(_libraryAddresses);
+		m_compiler.setMetadataFormat(frontend::CompilerStack::MetadataFormat::NoMetadata);
+		if (!m_compiler.compile())
+		{
+			langutil::SourceReferenceFormatter{cerr, m_compiler, false, false}
+				.printErrorInformation(m_compiler.errors());
+			BOOST_THROW_EXCEPTION(runtime_error("Compilation failed."));
+		}
+		string contractName = _contractName.empty() ? m_compiler.lastContractName(_sourceName) : _contractName;
+		sendMessage(m_compiler.object(contractName).bytecode + _arguments, true, _value);
+		return m_output;
+	}
+
+	/// Deploys the main contract, preceded by the libraries among @a _calls, and executes
+	/// the remaining calls. @returns the outcome of each deployment and call.
+	vector<Transaction> run(vector<FunctionCall> const& _calls)
+	{
+		reset();
+		vector<Transaction> transactions;
+		map<string, Address> libraries;
+		bool deployed = false;
+		auto deploy = [&](u256 const& _value, bytes const& _arguments) {
+			compileAndRunWithoutCheck(m_sources.sources, _value, "", _arguments, libraries, m_sources.mainSourceFile);
+			deployed = true;
+		};
+
+		for (FunctionCall const& call: _calls)
+		{
+			if (call.kind == FunctionCall::Kind::Library)
+			{
+				compileAndRunWithoutCheck(m_sources.sources, 0, call.signature, {}, libraries, m_sources.mainSourceFile);
+				libraries[call.libraryFile + ":" + call.signature] = m_contractAddress;
+				transactions.push_back({m_gasUsed, m_transactionSuccessful});
+				continue;
+			}
+
+			if (call.kind == FunctionCall::Kind::Constructor)
+				deploy(call.value.value, call.arguments.rawBytes());
+			else
+			{
+				if (!deployed)
+				{
+					deploy(0, {});
+					transactions.push_back({m_gasUsed, m_transactionSuccessful});
+				}
+				if (call.kind == FunctionCall::Kind::LowLevel)
+					callLowLevel(call.arguments.rawBytes(), call.value.value);
+				else
+					callContractFunctionWithValueNoEncoding(call.signature, call.value.value, call.arguments.rawBytes());
+			}
+			bool outputMatches = call.kind == FunctionCall::Kind::Constructor || m_output == call.expectations.rawBytes();
+			transactions.push_back({
+				m_gasUsed,
+				m_transactionSuccessful == !call.expectations.failure && outputMatches
+			});
+		}
+		if (!deployed)
+		{
+			deploy(0, {});
+			transactions.push_back({m_gasUsed, m_transactionSuccessful});
+		}
+		return transactions;
+	}
+
+private:
+	SourceMap const& m_sources;
+	bool m_viaIR = false;
+	frontend::CompilerStack m_compiler;
+};
+
+/// @returns the label of @a _call in the report.
+string describe(FunctionCall const& _call)
+{
+	if (_call.kind == FunctionCall::Kind::Library)
+		return "library: " + _call.signature;
+	string description = _call.kind == FunctionCall::Kind::LowLevel ? "()" : _call.signature;
+	if (!_call.arguments.parameters.empty())
+	{
+		description += ":";
+		for (Parameter const& parameter: _call.arguments.parameters)
+			description += " " + parameter.rawString;
+	}
+	if (_call.value.value > 0)
+		description += ", " + _call.value.value.str() + " wei";
+	return description;
+}
+
+/// Runs the benchmark in @a _file with every pipeline and stores the gas used by each
+/// transaction in @a o_report.
+/// @returns false if one of the pipelines failed or a transaction did not meet its expectations.
+bool runBenchmark(fs::path const& _file, Json::Value& o_report)
+{
+	TestCaseReader reader(_file.string());
+	SourceMap sources = reader.sources();
+	vector<FunctionCall> calls = TestFileParser{reader.stream(), {}}.parseFunctionCalls(reader.lineNumber());
+
+	vector<string> labels;
+	bool hasConstructorCall = false;
+	for (FunctionCall const& call: calls)
+	{
+		if (call.kind == FunctionCall::Kind::Constructor)
+			hasConstructorCall = true;
+		else if (call.kind != FunctionCall::Kind::Library && !hasConstructorCall)
+		{
+			labels.emplace_back("constructor()");
+			hasConstructorCall = true;
+		}
+		labels.emplace_back(describe(call));
+	}
+	if (!hasConstructorCall)
+		labels.emplace_back("constructor()");
+
+	bool success = true;
+	o_report = Json::arrayValue;
+	for (string const& label: labels)
+	{
+		Json::Value row;
+		row["transaction"] = label;
+		o_report.append(std::move(row));
+	}
+	for (Pipeline const& pipeline: pipelines)
+	{
+		vector<Transaction> transactions;
+		try
+		{
+			transactions = GasBenchmark{sources, pipeline}.run(calls);
+		}
+		catch (std::exception const& _exception)
+		{
+			cerr << _file.string() << " (" << pipeline.name << "): " << _exception.what() << endl;
+			success = false;
+		}
+		for (size_t i = 0; i < labels.size(); ++i)
+			if (i < transactions.size())
+			{
+				o_report[static_cast<Json::ArrayIndex>(i)][pipeline.name] =
+					Json::Value(static_cast<Json::UInt64>(transactions[i].gasUsed));
+				if (!transactions[i].asExpected)
+				{
+					cerr << _file.string() << " (" << pipeline.name << "): " << labels[i] << " did not meet its expectations." << endl;
+					success = false;
+				}
+			}
+			else
+				o_report[static_cast<Json::ArrayIndex>(i)][pipeline.name] = Json::nullValue;
+	}
+	return success;
+}
+
+}
+
+int main(int argc, char const* argv[])
+{
+	try
+	{
+		{
+			auto options = make_unique<GasBenchOptions>();
+			if (!options->parse(argc, argv))
+				return EXIT_SUCCESS;
+			options->validate();
+			CommonOptions::setSingleton(std::move(options));
+		}
+		auto const& options = dynamic_cast<GasBenchOptions const&>(CommonOptions::get());
+		if (!loadVMs(options))
+			return EXIT_FAILURE;
+
+		vector<fs::path> files;
+		for (fs::path const& benchmark: options.benchmarks)
+			if (fs::is_directory(benchmark))
+			{
+				for (fs::directory_entry const& entry: fs::directory_iterator(benchmark))
+					if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+						files.push_back(entry.path());
+			}
+			else
+				files.push_back(benchmark);
+		sort(files.begin(), files.end());
+
+		bool success = true;
+		Json::Value report = Json::objectValue;
+		for (fs::path const& file: files)
+		{
+			string name = fs::relative(file, options.testPath).generic_string();
+			if (!runBenchmark(file, report[name]))
+				success = false;
+		}
+
+		if (options.output.empty())
+			cout << util::jsonPrettyPrint(report) << endl;
+		else
+			ofstream(options.output.string()) << util::jsonPrettyPrint(report) << endl;
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	catch (ConfigException const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return EXIT_FAILURE;
+	}
+	catch (std::runtime_error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return EXIT_FAILURE;
+	}
+}
@@ -78,12 +78,14 @@ namespace solidity::yul::test
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	InterpreterMemory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+	bytes data(_size, 0);
+	for (size_t i = 0; i < _size && _sourceOffset + i < _source.size(); ++i)
+		data[i] = _source[_sourceOffset + i];
+	_target.write(_targetOffset, data);
 }
 
 }
@@ -284,6 +286,11 @@ u256 EVMInstructionInterpreter::eval(
 		accessMemory(arg[0], 1);
 		m_state.memory[arg[0]] = uint8_t(arg[1] & 0xff);
 		return 0;
+	case Instruction::MCOPY:
+		if (accessMemory(arg[1], arg[2]) && accessMemory(arg[0], arg[2]))
+			m_state.memory.write(arg[0], m_state.memory.read(arg[1], size_t(arg[2])));
+		logTrace(_instruction, arg);
+		return 0;
 	case Instruction::SLOAD:
 		return m_state.storage[h256(arg[0])];
 	case Instruction::SSTORE:
@@ -525,10 +532,7 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= s_maxRangeSize, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
@@ -538,8 +542,7 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	m_state.memory.write(_offset, h256(_value).asBytes());
 }
 
 
@@ -600,7 +603,7 @@ std::pair<bool, size_t> EVMInstructionInterpreter::isInputMemoryPtrModified(
 	}
 	else if (
 		_pseudoInstruction == "RETURNDATACOPY" || _pseudoInstruction == "CALLDATACOPY"
-		|| _pseudoInstruction == "CODECOPY")
+		|| _pseudoInstruction == "CODECOPY" || _pseudoInstruction == "MCOPY")
 	{
 		if (_arguments[2] == 0)
 			return {true, 0};
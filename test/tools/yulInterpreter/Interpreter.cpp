@@ -46,6 +46,83 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 
+uint8_t& InterpreterMemory::operator[](u256 const& _offset)
+{
+	if (_offset < c_contiguousLimit)
+	{
+		size_t offset = static_cast<size_t>(_offset);
+		if (offset >= m_contiguous.size())
+			m_contiguous.resize((offset / c_pageSize + 1) * c_pageSize, 0);
+		return m_contiguous[offset];
+	}
+	Page& page = m_pages.try_emplace(_offset / c_pageSize, Page{}).first->second;
+	return page[static_cast<size_t>(_offset % c_pageSize)];
+}
+
+uint8_t InterpreterMemory::at(u256 const& _offset) const
+{
+	if (_offset < c_contiguousLimit)
+	{
+		size_t offset = static_cast<size_t>(_offset);
+		return offset < m_contiguous.size() ? m_contiguous[offset] : 0;
+	}
+	auto page = m_pages.find(_offset / c_pageSize);
+	return page != m_pages.end() ? page->second[static_cast<size_t>(_offset % c_pageSize)] : 0;
+}
+
+bytes InterpreterMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, 0);
+	if (isContiguous(_offset, _size))
+	{
+		size_t offset = static_cast<size_t>(_offset);
+		if (offset < m_contiguous.size())
+		{
+			auto begin = m_contiguous.begin() + static_cast<ptrdiff_t>(offset);
+			copy(begin, begin + static_cast<ptrdiff_t>(min(_size, m_contiguous.size() - offset)), data.begin());
+		}
+	}
+	else
+		for (size_t i = 0; i < _size; ++i)
+			data[i] = at(_offset + i);
+	return data;
+}
+
+void InterpreterMemory::write(u256 const& _offset, bytes const& _data)
+{
+	if (_data.empty())
+		return;
+	if (isContiguous(_offset, _data.size()))
+	{
+		size_t offset = static_cast<size_t>(_offset);
+		// Makes sure that the last byte is allocated.
+		(*this)[offset + _data.size() - 1];
+		copy(_data.begin(), _data.end(), m_contiguous.begin() + static_cast<ptrdiff_t>(offset));
+	}
+	else
+		for (size_t i = 0; i < _data.size(); ++i)
+			(*this)[_offset + i] = _data[i];
+}
+
+map<u256, u256> InterpreterMemory::nonZeroWords() const
+{
+	map<u256, u256> words;
+	auto addWords = [&](u256 const& _offset, uint8_t const* _data, size_t _size) {
+		for (size_t wordOffset = 0; wordOffset < _size; wordOffset += 0x20)
+		{
+			u256 word;
+			for (size_t i = 0; i < 0x20; ++i)
+				word = (word << 8) | _data[wordOffset + i];
+			if (word != 0)
+				words[_offset + wordOffset] = word;
+		}
+	};
+	addWords(0, m_contiguous.data(), m_contiguous.size());
+	for (auto const& [index, page]: m_pages)
+		addWords(index * c_pageSize, page.data(), page.size());
+	return words;
+}
+
 void InterpreterState::dumpStorage(ostream& _out) const
 {
 	for (auto const& slot: storage)
@@ -61,12 +138,8 @@ void InterpreterState::dumpTraceAndState(ostream& _out, bool _disableMemoryTrace
 	if (!_disableMemoryTrace)
 	{
 		_out << "Memory dump:\n";
-		map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
-		for (auto const& [offset, value]: words)
-			if (value != 0)
-				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+		for (auto const& [offset, value]: memory.nonZeroWords())
+			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
 	}
 	_out << "Storage dump:" << endl;
 	dumpStorage(_out);
@@ -304,16 +377,18 @@ void ExpressionEvaluator::operator()(Identifier const& _identifier)
 
 void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 {
+	// The builtin is looked up only once, since this is on the hot path of every function call.
+	BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name);
 	vector<optional<LiteralKind>> const* literalArguments = nullptr;
-	if (BuiltinFunction const* builtin = m_dialect.builtin(_funCall.functionName.name))
-		if (!builtin->literalArguments.empty())
-			literalArguments = &builtin->literalArguments;
+	if (builtin && !builtin->literalArguments.empty())
+		literalArguments = &builtin->literalArguments;
 	evaluateArgs(_funCall.arguments, literalArguments);
 
 	if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
 	{
-		if (BuiltinFunctionForEVM const* fun = dialect->builtin(_funCall.functionName.name))
+		if (builtin)
 		{
+			auto const* fun = static_cast<BuiltinFunctionForEVM const*>(builtin);
 			EVMInstructionInterpreter interpreter(dialect->evmVersion(), m_state, m_disableMemoryTrace);
 
 			u256 const value = interpreter.evalBuiltin(*fun, _funCall.arguments, values());
@@ -329,21 +404,21 @@ void ExpressionEvaluator::operator()(FunctionCall const& _funCall)
 			return;
 		}
 	}
-	else if (WasmDialect const* dialect = dynamic_cast<WasmDialect const*>(&m_dialect))
-		if (dialect->builtin(_funCall.functionName.name))
+	else if (dynamic_cast<WasmDialect const*>(&m_dialect))
+		if (builtin)
 		{
 			EwasmBuiltinInterpreter interpreter(m_state);
 			setValue(interpreter.evalBuiltin(_funCall.functionName.name, _funCall.arguments, values()));
 			return;
 		}
 
-	Scope* scope = &m_scope;
-	for (; scope; scope = scope->parent)
-		if (scope->names.count(_funCall.functionName.name))
+	FunctionDefinition const* fun = nullptr;
+	for (Scope* scope = &m_scope; scope; scope = scope->parent)
+		if (auto it = scope->names.find(_funCall.functionName.name); it != scope->names.end())
+		{
+			fun = it->second;
 			break;
-	yulAssert(scope, "");
-
-	FunctionDefinition const* fun = scope->names.at(_funCall.functionName.name);
+		}
 	yulAssert(fun, "Function not found.");
 	yulAssert(m_values.size() == fun->parameters.size(), "");
 	map<YulString, u256> variables;
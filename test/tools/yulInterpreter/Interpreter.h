@@ -31,6 +31,7 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <array>
 #include <map>
 
 namespace solidity::yul
@@ -73,11 +74,48 @@ enum class ControlFlowState
 	Leave
 };
 
+/**
+ * Memory of the interpreter. Offsets below c_contiguousLimit are stored in a single buffer
+ * that grows on demand, higher offsets in pages that are allocated on first access.
+ * Bytes that were never written read as zero. Offsets wrap around at 2**256.
+ */
+class InterpreterMemory
+{
+public:
+	/// @returns the byte at @a _offset, allocating storage for it if necessary.
+	uint8_t& operator[](u256 const& _offset);
+	/// @returns the byte at @a _offset without allocating storage for it.
+	uint8_t at(u256 const& _offset) const;
+
+	/// @returns the @a _size bytes starting at @a _offset.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Writes @a _data to the memory starting at @a _offset.
+	void write(u256 const& _offset, bytes const& _data);
+
+	/// @returns the 32 byte words at offsets divisible by 32 that are not zero, keyed by their offset.
+	std::map<u256, u256> nonZeroWords() const;
+
+private:
+	static constexpr size_t c_pageSize = 0x1000;
+	static constexpr size_t c_contiguousLimit = 0x100000;
+	using Page = std::array<uint8_t, c_pageSize>;
+
+	/// @returns true if the range of @a _size bytes starting at @a _offset lies completely
+	/// below c_contiguousLimit.
+	static bool isContiguous(u256 const& _offset, size_t _size)
+	{
+		return _offset < c_contiguousLimit && c_contiguousLimit - static_cast<size_t>(_offset) >= _size;
+	}
+
+	bytes m_contiguous;
+	std::map<u256, Page> m_pages;
+};
+
 struct InterpreterState
 {
 	bytes calldata;
 	bytes returndata;
-	std::map<u256, uint8_t> memory;
+	InterpreterMemory memory;
 	/// This is different than memory.size() because we ignore gas.
 	u256 msize;
 	std::map<util::h256, util::h256> storage;
@@ -122,10 +160,7 @@ struct InterpreterState
 	bytes readMemory(u256 const& _offset, u256 const& _size)
 	{
 		yulAssert(_size <= 0xffff, "Too large read.");
-		bytes data(size_t(_size), uint8_t(0));
-		for (size_t i = 0; i < data.size(); ++i)
-			data[i] = memory[_offset + i];
-		return data;
+		return memory.read(_offset, static_cast<size_t>(_size));
 	}
 };
 
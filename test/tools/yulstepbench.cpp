@@ -0,0 +1,436 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark of individual Yul optimiser steps on synthetic code of increasing size.
+ */
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/CharStreamProvider.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libyul/AST.h>
+#include <libyul/AsmAnalysis.h>
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/FunctionGrouper.h>
+#include <libyul/optimiser/FunctionHoister.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/Suite.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Generators of synthetic Yul code whose size grows linearly with the parameter.
+map<string, function<string(size_t)>> const& shapes()
+{
+	static map<string, function<string(size_t)>> const shapes{
+		{"straight", [](size_t _size) {
+			// Long straight-line code with many live variables.
+			ostringstream code;
+			code << "{\n\tlet x0 := calldataload(0)\n";
+			for (size_t i = 1; i < _size; ++i)
+			{
+				code << "\tlet x" << i << " := add(mul(x" << i - 1 << ", " << i << "), calldataload(" << 32 * i << "))\n";
+				if (i % 4 == 0)
+					code << "\tsstore(" << i << ", x" << i << ")\n";
+			}
+			code << "\tsstore(0, x" << _size - 1 << ")\n}\n";
+			return code.str();
+		}},
+		{"nesting", [](size_t _size) {
+			// Deeply nested blocks.
+			ostringstream code;
+			code << "{\n\tlet x := calldataload(0)\n";
+			for (size_t i = 0; i < _size; ++i)
+				code << "\tif lt(x, " << i + 1 << ") { x := add(x, mload(" << 32 * i << "))\n";
+			for (size_t i = 0; i < _size; ++i)
+				code << "\t}\n";
+			code << "\tsstore(0, x)\n}\n";
+			return code.str();
+		}},
+		{"functions", [](size_t _size) {
+			// Many functions calling each other.
+			ostringstream code;
+			code << "{\n\tsstore(0, f" << _size - 1 << "(calldataload(0)))\n";
+			code << "\tfunction f0(a) -> r { r := calldataload(a) }\n";
+			for (size_t i = 1; i < _size; ++i)
+				code << "\tfunction f" << i << "(a) -> r { r := add(f" << i - 1 << "(a), mul(a, " << i << ")) }\n";
+			code << "}\n";
+			return code.str();
+		}},
+		{"switch", [](size_t _size) {
+			// A huge switch statement.
+			ostringstream code;
+			code << "{\n\tlet x := calldataload(0)\n\tswitch x\n";
+			for (size_t i = 0; i < _size; ++i)
+				code << "\tcase " << i << " { sstore(" << i << ", add(x, calldataload(" << 32 * i << "))) }\n";
+			code << "\tdefault { sstore(0, 0) }\n}\n";
+			return code.str();
+		}},
+		{"sourceLocations", [](size_t _size) {
+			// Straight-line code with source location comments like in the IR output.
+			ostringstream code;
+			code << "{\n\t/// @src 0:0:10\n\tlet x0 := calldataload(0)\n";
+			for (size_t i = 1; i < _size; ++i)
+			{
+				code << "\t/// @src 0:" << 10 * i << ":" << 10 * i + 8 << "  \"x" << i << " = ...\"\n";
+				code << "\tlet x" << i << " := add(x" << i - 1 << ", 0x" << hex << i << dec << ")\n";
+				code << "\tsstore(x" << i << ", x" << i - 1 << ")\n";
+			}
+			code << "}\n";
+			return code.str();
+		}},
+	};
+	return shapes;
+}
+
+/// Parses, analyses and disambiguates @a _source and brings it into the form expected by
+/// the optimiser steps, the same way yul-phaser does.
+Block prepare(Dialect const& _dialect, string const& _source)
+{
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	CharStream charStream(_source, "");
+	shared_ptr<Block> ast = yul::Parser(errorReporter, _dialect).parse(charStream);
+	AsmAnalysisInfo analysisInfo;
+	if (!ast || !errorReporter.errors().empty() || !AsmAnalyzer(analysisInfo, errorReporter, _dialect).analyze(*ast))
+	{
+		SourceReferenceFormatter{cerr, SingletonCharStreamProvider(charStream), true, false}
+			.printErrorInformation(errors);
+		throw runtime_error("Generated code is invalid.");
+	}
+
+	Block block = get<Block>(Disambiguator(_dialect, analysisInfo)(*ast));
+	set<YulString> const reservedIdentifiers;
+	NameDispenser nameDispenser(_dialect, block, reservedIdentifiers);
+	OptimiserStepContext context{
+		_dialect,
+		nameDispenser,
+		reservedIdentifiers,
+		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+	};
+	for (char const* step: {FunctionHoister::name, FunctionGrouper::name, ForLoopInitRewriter::name})
+		OptimiserSuite::allSteps().at(step)->run(context, block);
+	return block;
+}
+
+/// @returns the shortest time in microseconds spent parsing @a _source out of @a _repeat runs.
+/// Source location comments are taken into account, as for the IR output.
+double measureParser(Dialect const& _dialect, string const& _source, size_t _repeat)
+{
+	string const sourceName = "benchmark.sol";
+	double best = numeric_limits<double>::infinity();
+	for (size_t i = 0; i < _repeat; ++i)
+	{
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		CharStream charStream(_source, "");
+
+		auto start = chrono::steady_clock::now();
+		shared_ptr<Block> ast = yul::Parser(
+			errorReporter,
+			_dialect,
+			map<unsigned, string const*>{{0, &sourceName}}
+		).parse(charStream);
+		chrono::duration<double, micro> duration = chrono::steady_clock::now() - start;
+		if (!ast || !errors.empty())
+			throw runtime_error("Generated code is invalid.");
+		best = min(best, duration.count());
+	}
+	return best;
+}
+
+/// @returns the shortest time in microseconds spent running @a _step on @a _ast out of @a _repeat runs.
+double measure(Dialect const& _dialect, OptimiserStep const& _step, Block const& _ast, size_t _repeat)
+{
+	double best = numeric_limits<double>::infinity();
+	for (size_t i = 0; i < _repeat; ++i)
+	{
+		Block ast = ASTCopier{}.translate(_ast);
+		set<YulString> const reservedIdentifiers;
+		NameDispenser nameDispenser(_dialect, ast, reservedIdentifiers);
+		OptimiserStepContext context{
+			_dialect,
+			nameDispenser,
+			reservedIdentifiers,
+			frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+		};
+
+		auto start = chrono::steady_clock::now();
+		_step.run(context, ast);
+		chrono::duration<double, micro> duration = chrono::steady_clock::now() - start;
+		best = min(best, duration.count());
+	}
+	return best;
+}
+
+/// Estimates k in time = c * size^k by a least squares fit in log-log space.
+/// Measurements below one microsecond are ignored, because they are dominated by noise.
+optional<double> complexityExponent(vector<size_t> const& _sizes, vector<double> const& _times)
+{
+	vector<pair<double, double>> points;
+	for (size_t i = 0; i < _sizes.size(); ++i)
+		if (_times[i] >= 1.0)
+			points.emplace_back(log(static_cast<double>(_sizes[i])), log(_times[i]));
+	if (points.size() < 2)
+		return nullopt;
+
+	double meanX = 0;
+	double meanY = 0;
+	for (auto const& [x, y]: points)
+	{
+		meanX += x;
+		meanY += y;
+	}
+	meanX /= static_cast<double>(points.size());
+	meanY /= static_cast<double>(points.size());
+
+	double covariance = 0;
+	double variance = 0;
+	for (auto const& [x, y]: points)
+	{
+		covariance += (x - meanX) * (y - meanY);
+		variance += (x - meanX) * (x - meanX);
+	}
+	if (variance == 0)
+		return nullopt;
+	return covariance / variance;
+}
+
+vector<string> splitList(string const& _list)
+{
+	vector<string> items;
+	boost::split(items, _list, boost::is_any_of(","));
+	return items;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		string stepAbbreviations;
+		string shapeList;
+		string sizeList;
+		size_t repeat = 3;
+		double maxExponent = 0;
+		po::options_description options(
+			R"(yulstepbench, benchmark of the Yul optimiser steps.
+	Usage: yulstepbench [Options]
+	Generates synthetic Yul code of increasing size in several shapes and
+	measures the time each optimiser step takes on it. For every step and
+	shape, the exponent k of the best fit of time = c * size^k is reported
+	as the empirical complexity. With --parser, the time taken by the
+	parser is measured instead and its throughput on the largest input
+	is reported as well.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"steps",
+				po::value<string>(&stepAbbreviations),
+				"Abbreviations of the steps to benchmark. All steps by default."
+			)
+			(
+				"shapes",
+				po::value<string>(&shapeList)->default_value("straight,nesting,functions,switch"),
+				"Comma-separated list of the shapes of the generated code."
+			)
+			(
+				"sizes",
+				po::value<string>(&sizeList)->default_value("32,64,128,256"),
+				"Comma-separated list of the sizes of the generated code."
+			)
+			(
+				"repeat",
+				po::value<size_t>(&repeat)->default_value(repeat),
+				"Number of runs of each step on each input. The fastest run is reported."
+			)
+			(
+				"max-exponent",
+				po::value<double>(&maxExponent),
+				"Exit with an error if the empirical complexity exponent of a step exceeds this value."
+			)
+			(
+				"parser",
+				"Benchmark the Yul parser instead of the optimiser steps."
+			)
+			("help,h", "Show this help screen.");
+
+		po::variables_map arguments;
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help"))
+		{
+			cout << options;
+			return 0;
+		}
+
+		if (repeat == 0)
+		{
+			cerr << "The number of runs must be at least one." << endl;
+			return 1;
+		}
+
+		vector<size_t> sizes;
+		for (string const& size: splitList(sizeList))
+		{
+			sizes.push_back(stoul(size));
+			if (sizes.back() == 0)
+			{
+				cerr << "Sizes must be positive." << endl;
+				return 1;
+			}
+		}
+
+		for (string const& shape: splitList(shapeList))
+			if (!shapes().count(shape))
+			{
+				cerr << "Unknown shape: " << shape << endl;
+				return 1;
+			}
+
+		vector<string> steps;
+		if (arguments.count("steps"))
+		{
+			OptimiserSuite::validateSequence(stepAbbreviations);
+			for (char abbreviation: stepAbbreviations)
+				steps.push_back(OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation));
+		}
+		else
+			for (auto const& [name, step]: OptimiserSuite::allSteps())
+				steps.push_back(name);
+
+		Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(EVMVersion{});
+
+		cout << left << setw(32) << "step" << setw(12) << "shape";
+		for (size_t size: sizes)
+			cout << right << setw(12) << size;
+		cout << right << setw(12) << "exponent" << endl;
+
+		bool exceeded = false;
+		auto report = [&](string const& _name, string const& _shape, vector<double> const& _times) {
+			optional<double> exponent = complexityExponent(sizes, _times);
+
+			cout << left << setw(32) << _name << setw(12) << _shape << right << fixed << setprecision(1);
+			for (double time: _times)
+				cout << setw(12) << time;
+			cout << setw(12);
+			if (exponent)
+				cout << setprecision(2) << *exponent;
+			else
+				cout << "-";
+			if (arguments.count("max-exponent") && exponent && *exponent > maxExponent)
+			{
+				cout << "  exceeds " << maxExponent;
+				exceeded = true;
+			}
+		};
+
+		for (string const& shape: splitList(shapeList))
+		{
+			if (arguments.count("parser"))
+			{
+				vector<string> sources;
+				vector<double> times;
+				for (size_t size: sizes)
+				{
+					sources.push_back(shapes().at(shape)(size));
+					times.push_back(measureParser(dialect, sources.back(), repeat));
+				}
+				report("Parser", shape, times);
+				// Bytes per microsecond are megabytes per second.
+				cout << setprecision(1) << setw(12) << static_cast<double>(sources.back().size()) / times.back() << " MB/s" << endl;
+				continue;
+			}
+
+			vector<Block> inputs;
+			for (size_t size: sizes)
+				inputs.push_back(prepare(dialect, shapes().at(shape)(size)));
+
+			for (string const& stepName: steps)
+			{
+				OptimiserStep const& step = *OptimiserSuite::allSteps().at(stepName);
+				if (step.invalidInCurrentEnvironment())
+					continue;
+
+				vector<double> times;
+				for (Block const& input: inputs)
+					times.push_back(measure(dialect, step, input, repeat));
+				report(stepName, shape, times);
+				cout << endl;
+			}
+		}
+		cout << "Times are in microseconds." << endl;
+
+		return exceeded ? 1 : 0;
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	catch (std::invalid_argument const& _exception)
+	{
+		cerr << "Invalid number: " << _exception.what() << endl;
+		return 1;
+	}
+	catch (...)
+	{
+		cerr << endl << "Exception:" << endl;
+		cerr << boost::current_exception_diagnostic_information() << endl;
+		return 1;
+	}
+}
@@ -325,6 +325,7 @@ BOOST_FIXTURE_TEST_CASE(run_should_print_cache_stats_if_requested, AlgorithmRunn
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Round\d+:\d+entries)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Totalhits:\d+)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Totalmisses:\d+)")));
+		BOOST_TEST(nextLineMatches(m_output, regex(R"(Totalevictions:\d+)")));
 		BOOST_TEST(nextLineMatches(m_output, regex(R"(Sizeofcachedcode:\d+)")));
 	}
 
@@ -339,6 +340,7 @@ BOOST_FIXTURE_TEST_CASE(run_should_print_cache_stats_if_requested, AlgorithmRunn
 	BOOST_TEST(nextLineMatches(m_output, regex("Round" + toString(round) + ":" + toString(stats.roundEntryCounts[round]) + "entries")));
 	BOOST_TEST(nextLineMatches(m_output, regex("Totalhits:" + toString(stats.hits))));
 	BOOST_TEST(nextLineMatches(m_output, regex("Totalmisses:" + toString(stats.misses))));
+	BOOST_TEST(nextLineMatches(m_output, regex("Totalevictions:" + toString(stats.evictions))));
 	BOOST_TEST(nextLineMatches(m_output, regex("Sizeofcachedcode:" + toString(stats.totalCodeSize))));
 	BOOST_TEST(m_output.peek() == EOF);
 }
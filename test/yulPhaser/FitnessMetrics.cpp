@@ -44,6 +44,19 @@ public:
 	size_t evaluate(Chromosome const&) override { return 0; }
 };
 
+/// Metric that returns the length of the chromosome and counts how often it was evaluated.
+class CountingMetric: public FitnessMetric
+{
+public:
+	size_t evaluate(Chromosome const& _chromosome) override
+	{
+		++evaluations;
+		return _chromosome.length();
+	}
+
+	size_t evaluations = 0;
+};
+
 class ProgramBasedMetricFixture
 {
 protected:
@@ -176,6 +189,33 @@ BOOST_FIXTURE_TEST_CASE(evaluate_should_not_optimise_if_number_of_repetitions_is
 	BOOST_TEST(fitness != m_optimisedProgram.codeSize(m_weights));
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(ProgramGasTest)
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_compute_gas_cost_of_the_optimised_program, ProgramBasedMetricFixture)
+{
+	size_t fitness = ProgramGas(m_program, nullptr, 200, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness != m_program.gasCost(200));
+	BOOST_TEST(fitness == m_optimisedProgram.gasCost(200));
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_be_able_to_use_program_cache_if_available, ProgramBasedMetricFixture)
+{
+	size_t fitness = ProgramGas(nullopt, m_programCache, 200, m_weights).evaluate(m_chromosome);
+
+	BOOST_TEST(fitness == m_optimisedProgram.gasCost(200));
+	BOOST_TEST(m_programCache->size() == m_chromosome.length());
+}
+
+BOOST_FIXTURE_TEST_CASE(evaluate_should_weigh_execution_costs_by_expected_executions, ProgramBasedMetricFixture)
+{
+	size_t deploymentCost = ProgramGas(m_program, nullptr, 0, m_weights).evaluate(m_chromosome);
+	size_t singleExecutionCost = ProgramGas(m_program, nullptr, 1, m_weights).evaluate(m_chromosome) - deploymentCost;
+
+	BOOST_TEST(ProgramGas(m_program, nullptr, 50, m_weights).evaluate(m_chromosome) == deploymentCost + 50 * singleExecutionCost);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(RelativeProgramSizeTest)
 
@@ -277,6 +317,39 @@ BOOST_FIXTURE_TEST_CASE(FitnessMetricMinimum_evaluate_should_compute_minimum_of_
 	BOOST_TEST(metric.metrics() == m_simpleMetrics);
 }
 
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(StoredFitnessMetricTest)
+
+BOOST_AUTO_TEST_CASE(evaluate_should_evaluate_each_chromosome_only_once_per_database)
+{
+	auto countingMetric = make_shared<CountingMetric>();
+	auto database = make_shared<frontend::MemoryCompilationCache>();
+	Chromosome chromosome("aaf");
+
+	StoredFitnessMetric metric(countingMetric, database, "metric");
+	BOOST_TEST(metric.evaluate(chromosome) == 3);
+	BOOST_TEST(metric.evaluate(chromosome) == 3);
+	BOOST_TEST(countingMetric->evaluations == 1);
+
+	// Another metric sharing the database, e.g. in a later run.
+	BOOST_TEST(StoredFitnessMetric(countingMetric, database, "metric").evaluate(chromosome) == 3);
+	BOOST_TEST(countingMetric->evaluations == 1);
+
+	BOOST_TEST(metric.evaluate(Chromosome("a")) == 1);
+	BOOST_TEST(countingMetric->evaluations == 2);
+}
+
+BOOST_AUTO_TEST_CASE(evaluate_should_keep_values_of_different_metrics_apart)
+{
+	auto countingMetric = make_shared<CountingMetric>();
+	auto database = make_shared<frontend::MemoryCompilationCache>();
+	Chromosome chromosome("aaf");
+
+	BOOST_TEST(StoredFitnessMetric(countingMetric, database, "metric 1").evaluate(chromosome) == 3);
+	BOOST_TEST(StoredFitnessMetric(countingMetric, database, "metric 2").evaluate(chromosome) == 3);
+	BOOST_TEST(countingMetric->evaluations == 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
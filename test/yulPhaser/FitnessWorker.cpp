@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <tools/yulPhaser/FitnessWorker.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace solidity::phaser::test
+{
+
+class FitnessWorkerFixture
+{
+protected:
+	CharStream m_sourceStream = CharStream("{ let x := 1 let y := add(x, 2) mstore(y, x) }", "");
+	Program m_program = get<Program>(Program::load(m_sourceStream));
+	shared_ptr<ProgramCache> m_programCache = make_shared<ProgramCache>(m_program);
+	shared_ptr<FitnessMetric> m_fitnessMetric = make_shared<ProgramSize>(nullopt, m_programCache, CodeWeights{});
+	ProgramSize m_referenceMetric{m_program, nullptr, CodeWeights{}};
+	istringstream m_input;
+	ostringstream m_output;
+};
+
+BOOST_AUTO_TEST_SUITE(Phaser, *boost::unit_test::label("nooptions"))
+BOOST_AUTO_TEST_SUITE(FitnessWorkerTest)
+
+BOOST_FIXTURE_TEST_CASE(processRequest_should_return_fitness_of_all_chromosomes_in_order, FitnessWorkerFixture)
+{
+	FitnessWorker worker(m_fitnessMetric, {m_programCache}, m_input, m_output);
+
+	BOOST_TEST(worker.processRequest(" sj \t xsrj  L ") == (
+		toString(m_referenceMetric.evaluate(Chromosome("sj"))) + " " +
+		toString(m_referenceMetric.evaluate(Chromosome("xsrj"))) + " " +
+		toString(m_referenceMetric.evaluate(Chromosome("L")))
+	));
+}
+
+BOOST_FIXTURE_TEST_CASE(processRequest_should_report_invalid_genes, FitnessWorkerFixture)
+{
+	FitnessWorker worker(m_fitnessMetric, {m_programCache}, m_input, m_output);
+
+	BOOST_TEST(worker.processRequest("sj #x") == "error: Invalid optimisation step abbreviation '#' in chromosome '#x'.");
+	BOOST_TEST(m_programCache->currentRound() == 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(processRequest_should_start_a_new_cache_round_for_each_non_empty_request, FitnessWorkerFixture)
+{
+	FitnessWorker worker(m_fitnessMetric, {m_programCache}, m_input, m_output);
+
+	BOOST_TEST(worker.processRequest("").empty());
+	BOOST_TEST(m_programCache->currentRound() == 0);
+
+	worker.processRequest("sj");
+	BOOST_TEST(m_programCache->currentRound() == 1);
+	worker.processRequest("xs");
+	BOOST_TEST(m_programCache->currentRound() == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(run_should_respond_to_every_line_of_input, FitnessWorkerFixture)
+{
+	m_input.str("sj xs\n\nx\n");
+	FitnessWorker worker(m_fitnessMetric, {m_programCache}, m_input, m_output);
+
+	worker.run();
+
+	BOOST_TEST(m_output.str() == (
+		toString(m_referenceMetric.evaluate(Chromosome("sj"))) + " " +
+		toString(m_referenceMetric.evaluate(Chromosome("xs"))) + "\n" +
+		"\n" +
+		toString(m_referenceMetric.evaluate(Chromosome("x"))) + "\n"
+	));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -237,6 +237,24 @@ BOOST_FIXTURE_TEST_CASE(build_should_set_relative_metric_scale, FitnessMetricFac
 	BOOST_TEST(relativeProgramSizeMetric->fixedPointPrecision() == m_options.relativeMetricScale);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_set_expected_executions_of_gas_metric, FitnessMetricFactoryFixture)
+{
+	m_options.metric = MetricChoice::Gas;
+	m_options.metricAggregator = MetricAggregatorChoice::Average;
+	m_options.expectedExecutions = 1000;
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(m_options, {m_programs[0]}, {nullptr}, m_weights);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto averageMetric = dynamic_cast<FitnessMetricAverage*>(metric.get());
+	BOOST_REQUIRE(averageMetric != nullptr);
+	BOOST_REQUIRE(averageMetric->metrics().size() == 1);
+	BOOST_REQUIRE(averageMetric->metrics()[0] != nullptr);
+
+	auto programGasMetric = dynamic_cast<ProgramGas*>(averageMetric->metrics()[0].get());
+	BOOST_REQUIRE(programGasMetric != nullptr);
+	BOOST_TEST(programGasMetric->expectedExecutions() == m_options.expectedExecutions);
+}
+
 BOOST_FIXTURE_TEST_CASE(build_should_create_metric_for_each_input_program, FitnessMetricFactoryFixture)
 {
 	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
@@ -277,6 +295,53 @@ BOOST_FIXTURE_TEST_CASE(build_should_pass_program_caches_to_metrics, FitnessMetr
 	}
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_store_values_of_each_program_in_evaluation_database, FitnessMetricFactoryFixture)
+{
+	auto database = make_shared<frontend::MemoryCompilationCache>();
+	unique_ptr<FitnessMetric> metric = FitnessMetricFactory::build(
+		m_options,
+		m_programs,
+		vector<shared_ptr<ProgramCache>>(m_programs.size(), nullptr),
+		m_weights,
+		database
+	);
+	BOOST_REQUIRE(metric != nullptr);
+
+	auto combinedMetric = dynamic_cast<FitnessMetricCombination*>(metric.get());
+	BOOST_REQUIRE(combinedMetric != nullptr);
+	BOOST_REQUIRE(combinedMetric->metrics().size() == m_programs.size());
+
+	for (size_t i = 0; i < m_programs.size(); ++i)
+	{
+		auto storedMetric = dynamic_cast<StoredFitnessMetric*>(combinedMetric->metrics()[i].get());
+		BOOST_REQUIRE(storedMetric != nullptr);
+		BOOST_TEST(dynamic_cast<ProgramSize*>(storedMetric->metric().get()) != nullptr);
+		BOOST_TEST(storedMetric->metricKey() == FitnessMetricFactory::metricKey(m_options, m_programs[i], m_weights));
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE(metricKey_should_depend_on_program_metric_and_weights, FitnessMetricFactoryFixture)
+{
+	string key = FitnessMetricFactory::metricKey(m_options, m_programs[0], m_weights);
+	BOOST_TEST(FitnessMetricFactory::metricKey(m_options, m_programs[0], m_weights) == key);
+	BOOST_TEST(FitnessMetricFactory::metricKey(m_options, m_programs[1], m_weights) != key);
+
+	CodeWeights weights = m_weights;
+	weights.ifCost += 1;
+	BOOST_TEST(FitnessMetricFactory::metricKey(m_options, m_programs[0], weights) != key);
+
+	FitnessMetricFactory::Options options = m_options;
+	options.chromosomeRepetitions += 1;
+	BOOST_TEST(FitnessMetricFactory::metricKey(options, m_programs[0], m_weights) != key);
+	options = m_options;
+	options.metric = MetricChoice::Gas;
+	BOOST_TEST(FitnessMetricFactory::metricKey(options, m_programs[0], m_weights) != key);
+	// Options that do not affect the metric do not change the key.
+	options = m_options;
+	options.expectedExecutions += 1;
+	BOOST_TEST(FitnessMetricFactory::metricKey(options, m_programs[0], m_weights) == key);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(PopulationFactoryTest)
 
@@ -410,6 +475,19 @@ BOOST_FIXTURE_TEST_CASE(build_should_return_nullptr_for_each_input_program_if_ca
 		BOOST_TEST(caches[i] == nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE(build_should_pass_the_size_limit_to_each_cache, FixtureWithPrograms)
+{
+	ProgramCacheFactory::Options options{/* programCacheEnabled = */ true, /* maxTotalCodeSize = */ 100};
+	vector<shared_ptr<ProgramCache>> caches = ProgramCacheFactory::build(options, m_programs);
+
+	BOOST_TEST(caches.size() == m_programs.size());
+	for (size_t i = 0; i < m_programs.size(); ++i)
+	{
+		BOOST_REQUIRE(caches[i] != nullptr);
+		BOOST_CHECK(caches[i]->maxTotalCodeSize() == 100);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE(ProgramFactoryTest)
 
@@ -31,6 +31,9 @@
 
 #include <liblangutil/CharStream.h>
 
+#include <libsolutil/Common.h>
+#include <libsolutil/ThreadPool.h>
+
 #include <boost/test/unit_test.hpp>
 
 #include <cmath>
@@ -210,6 +213,31 @@ BOOST_FIXTURE_TEST_CASE(makeRandom_should_compute_fitness, PopulationFixture)
 	BOOST_TEST(population.individuals()[2].fitness == m_fitnessMetric->evaluate(population.individuals()[2].chromosome));
 }
 
+BOOST_AUTO_TEST_CASE(fitness_computed_on_multiple_threads_should_not_depend_on_the_number_of_threads)
+{
+	CharStream sourceStream(
+		"{\n"
+		"    let x := calldataload(0)\n"
+		"    for { let i := 0 } lt(i, x) { i := add(i, 1) } { mstore(i, add(x, 2)) }\n"
+		"    if gt(x, 3) { sstore(x, mul(x, 0)) }\n"
+		"}\n",
+		""
+	);
+	Program program = get<Program>(Program::load(sourceStream));
+
+	auto evolve = [&](size_t _threads) {
+		util::ThreadPool::instance().setMaxThreads(_threads);
+		SimulationRNG::reset(1);
+		auto fitnessMetric = make_shared<ProgramSize>(nullopt, make_shared<ProgramCache>(program), CodeWeights{});
+		Population population = Population::makeRandom(fitnessMetric, 20, 0, 20);
+		return population.mutate(RandomSelection(1.0), geneRandomisation(0.3)).individuals();
+	};
+
+	size_t const maxThreads = util::ThreadPool::instance().maxThreads();
+	ScopeGuard resetThreads([&] { util::ThreadPool::instance().setMaxThreads(maxThreads); });
+	BOOST_CHECK(evolve(4) == evolve(1));
+}
+
 BOOST_FIXTURE_TEST_CASE(plus_operator_should_add_two_populations, PopulationFixture)
 {
 	BOOST_CHECK_EQUAL(
@@ -404,6 +404,31 @@ BOOST_AUTO_TEST_CASE(codeSize)
 	BOOST_TEST(program.codeSize(CodeWeights{}) == CodeSize::codeSizeIncludingFunctions(program.ast()));
 }
 
+BOOST_AUTO_TEST_CASE(gasCost_should_add_execution_costs_for_each_expected_execution)
+{
+	CharStream sourceStream("{ let a := calldataload(0) if a { sstore(0, a) } }", current_test_case().p_name);
+	Program program = get<Program>(Program::load(sourceStream));
+
+	size_t deploymentCost = program.gasCost(0);
+	size_t executionCost = program.gasCost(1) - deploymentCost;
+
+	BOOST_TEST(deploymentCost > 0);
+	BOOST_TEST(executionCost > 0);
+	BOOST_TEST(program.gasCost(10) == deploymentCost + 10 * executionCost);
+}
+
+BOOST_AUTO_TEST_CASE(gasCost_should_depend_on_the_costs_of_instructions)
+{
+	CharStream mstoreStream("{ mstore(0, 1) }", current_test_case().p_name);
+	CharStream sstoreStream("{ sstore(0, 1) }", current_test_case().p_name);
+	Program mstoreProgram = get<Program>(Program::load(mstoreStream));
+	Program sstoreProgram = get<Program>(Program::load(sstoreStream));
+
+	BOOST_TEST(mstoreProgram.codeSize(CodeWeights{}) == sstoreProgram.codeSize(CodeWeights{}));
+	BOOST_TEST(mstoreProgram.gasCost(0) == sstoreProgram.gasCost(0));
+	BOOST_TEST(mstoreProgram.gasCost(1) < sstoreProgram.gasCost(1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -76,9 +76,9 @@ BOOST_AUTO_TEST_SUITE(ProgramCacheTest)
 
 BOOST_AUTO_TEST_CASE(CacheStats_operator_plus_should_add_stats_together)
 {
-	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}};
-	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}};
-	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}};
+	CacheStats statsA{11, 12, 13, {{1, 14}, {2, 15}}, 16};
+	CacheStats statsB{21, 22, 23, {{2, 24}, {3, 25}}, 26};
+	CacheStats statsC{32, 34, 36, {{1, 14}, {2, 39}, {3, 25}}, 42};
 
 	BOOST_CHECK(statsA + statsB == statsC);
 }
@@ -252,6 +252,62 @@ BOOST_FIXTURE_TEST_CASE(gatherStats_should_return_cache_statistics, ProgramCache
 	BOOST_CHECK(m_programCache.gatherStats() == expectedStats5);
 }
 
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_evict_least_recently_used_entries_when_over_the_size_limit, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+	ProgramCache limitedCache(m_program, sizeI + sizeIu);
+
+	limitedCache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(limitedCache) == set<string>{"I", "Iu"}));
+	BOOST_TEST(limitedCache.gatherStats().evictions == 0);
+
+	limitedCache.optimiseProgram("L");
+	BOOST_TEST(limitedCache.gatherStats().totalCodeSize <= sizeI + sizeIu);
+	BOOST_TEST(limitedCache.contains("L"));
+	BOOST_TEST(!limitedCache.contains("I"));
+	BOOST_TEST(limitedCache.gatherStats().evictions == (sizeL > sizeI ? 2 : 1));
+}
+
+BOOST_FIXTURE_TEST_CASE(optimiseProgram_should_reuse_longer_prefixes_after_a_shorter_one_was_evicted, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	ProgramCache limitedCache(m_program, max(sizeI, sizeIu));
+
+	limitedCache.optimiseProgram("Iu");
+	BOOST_REQUIRE((cachedKeys(limitedCache) == set<string>{"Iu"}));
+	CacheStats stats = limitedCache.gatherStats();
+	BOOST_TEST(stats.misses == 2);
+	BOOST_TEST(stats.evictions == 1);
+
+	Program cachedProgram = limitedCache.optimiseProgram("IuO");
+
+	BOOST_TEST(toString(cachedProgram) == toString(optimisedProgram(m_program, "IuO")));
+	BOOST_TEST(limitedCache.gatherStats().hits == 1);
+	BOOST_TEST(limitedCache.gatherStats().misses == 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(startRound_and_clear_should_keep_the_total_code_size_up_to_date, ProgramCacheFixture)
+{
+	size_t sizeI = optimisedProgram(m_program, "I").codeSize(CacheStats::StorageWeights);
+	size_t sizeIu = optimisedProgram(m_program, "Iu").codeSize(CacheStats::StorageWeights);
+	size_t sizeL = optimisedProgram(m_program, "L").codeSize(CacheStats::StorageWeights);
+
+	m_programCache.optimiseProgram("Iu");
+	m_programCache.startRound(1);
+	m_programCache.optimiseProgram("L");
+	BOOST_TEST(m_programCache.gatherStats().totalCodeSize == sizeI + sizeIu + sizeL);
+
+	m_programCache.startRound(2);
+	BOOST_REQUIRE((cachedKeys(m_programCache) == set<string>{"L"}));
+	BOOST_TEST(m_programCache.gatherStats().totalCodeSize == sizeL);
+
+	m_programCache.clear();
+	BOOST_TEST(m_programCache.gatherStats().totalCodeSize == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_AUTO_TEST_SUITE_END()
 
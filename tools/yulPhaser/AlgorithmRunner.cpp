@@ -116,6 +116,7 @@ void AlgorithmRunner::printCacheStats() const
 			m_outputStream << "Round " << round << ": " << count << " entries" << endl;
 		m_outputStream << "Total hits: " << totalStats.hits << endl;
 		m_outputStream << "Total misses: " << totalStats.misses << endl;
+		m_outputStream << "Total evictions: " << totalStats.evictions << endl;
 		m_outputStream << "Size of cached code: " << totalStats.totalCodeSize << endl;
 	}
 
@@ -19,6 +19,9 @@
 #include <tools/yulPhaser/FitnessMetrics.h>
 
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/lexical_cast.hpp>
 
 #include <cmath>
 
@@ -75,6 +78,11 @@ size_t RelativeProgramSize::evaluate(Chromosome const& _chromosome)
 	));
 }
 
+size_t ProgramGas::evaluate(Chromosome const& _chromosome)
+{
+	return optimisedProgram(_chromosome).gasCost(m_expectedExecutions);
+}
+
 size_t FitnessMetricAverage::evaluate(Chromosome const& _chromosome)
 {
 	assert(m_metrics.size() > 0);
@@ -118,3 +126,23 @@ size_t FitnessMetricMinimum::evaluate(Chromosome const& _chromosome)
 
 	return minimum;
 }
+
+size_t StoredFitnessMetric::evaluate(Chromosome const& _chromosome)
+{
+	h256 const key = keccak256("yul-phaser-fitness\n" + m_metricKey + "\n" + toString(_chromosome));
+	if (optional<string> storedValue = m_database->load(key))
+	{
+		try
+		{
+			return boost::lexical_cast<size_t>(*storedValue);
+		}
+		catch (boost::bad_lexical_cast const&)
+		{
+			// Corrupted entries are simply evaluated again and overwritten.
+		}
+	}
+
+	size_t value = m_metric->evaluate(_chromosome);
+	m_database->store(key, to_string(value));
+	return value;
+}
@@ -25,10 +25,14 @@
 #include <tools/yulPhaser/Program.h>
 #include <tools/yulPhaser/ProgramCache.h>
 
+#include <libsolidity/interface/CompilationCache.h>
+
 #include <libyul/optimiser/Metrics.h>
 
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <string>
 
 namespace solidity::phaser
 {
@@ -39,6 +43,7 @@ namespace solidity::phaser
  * The main feature is the @a evaluate() method that can tell how good a given chromosome is.
  * The lower the value, the better the fitness is. The result should be deterministic and depend
  * only on the chromosome and metric's state (which is constant).
+ * @a evaluate() can be called from several threads at once.
  */
 class FitnessMetric
 {
@@ -132,6 +137,35 @@ private:
 	size_t m_fixedPointPrecision;
 };
 
+/**
+ * Fitness metric based on the gas needed to deploy a specific program and to run it
+ * @a _expectedExecutions times after applying the optimisations from the chromosome to it.
+ *
+ * The gas is estimated statically from the syntax tree (see @a Program::gasCost()), so it is only
+ * a rough approximation of the real execution costs. The deployment costs are proportional to the
+ * code size, so @a _expectedExecutions determines how the two are weighted against each other.
+ */
+class ProgramGas: public ProgramBasedMetric
+{
+public:
+	explicit ProgramGas(
+		std::optional<Program> _program,
+		std::shared_ptr<ProgramCache> _programCache,
+		size_t _expectedExecutions,
+		yul::CodeWeights const& _weights,
+		size_t _repetitionCount = 1
+	):
+		ProgramBasedMetric(std::move(_program), std::move(_programCache), _weights, _repetitionCount),
+		m_expectedExecutions(_expectedExecutions) {}
+
+	size_t expectedExecutions() const { return m_expectedExecutions; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	size_t m_expectedExecutions;
+};
+
 /**
  * Abstract base class for fitness metrics that compute their value based on values of multiple
  * other, nested metrics.
@@ -188,4 +222,38 @@ public:
 	size_t evaluate(Chromosome const& _chromosome) override;
 };
 
+/**
+ * Fitness metric that keeps the values of a nested metric in a database, so that every chromosome
+ * is evaluated only once across all runs sharing the database, e.g. resumed runs or repeated
+ * campaigns over the same programs.
+ *
+ * The values are addressed by the chromosome and @a _metricKey, which must identify everything
+ * the nested metric depends on: its type and parameters, the program and the compiler version.
+ */
+class StoredFitnessMetric: public FitnessMetric
+{
+public:
+	explicit StoredFitnessMetric(
+		std::shared_ptr<FitnessMetric> _metric,
+		std::shared_ptr<frontend::CompilationCache> _database,
+		std::string _metricKey
+	):
+		m_metric(std::move(_metric)),
+		m_database(std::move(_database)),
+		m_metricKey(std::move(_metricKey))
+	{
+		assert(m_metric != nullptr && m_database != nullptr);
+	}
+
+	std::shared_ptr<FitnessMetric> const& metric() const { return m_metric; }
+	std::string const& metricKey() const { return m_metricKey; }
+
+	size_t evaluate(Chromosome const& _chromosome) override;
+
+private:
+	std::shared_ptr<FitnessMetric> m_metric;
+	std::shared_ptr<frontend::CompilationCache> m_database;
+	std::string m_metricKey;
+};
+
 }
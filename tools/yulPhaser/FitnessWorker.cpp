@@ -0,0 +1,74 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <tools/yulPhaser/FitnessWorker.h>
+
+#include <libyul/optimiser/Suite.h>
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/trim.hpp>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+using namespace solidity::phaser;
+
+void FitnessWorker::run()
+{
+	string request;
+	while (getline(m_inputStream, request))
+		// Flush after every response so that the coordinator does not wait on a buffered pipe.
+		m_outputStream << processRequest(request) << endl;
+}
+
+string FitnessWorker::processRequest(string const& _request)
+{
+	vector<string> geneSequences;
+	string trimmedRequest = boost::trim_copy(_request);
+	if (!trimmedRequest.empty())
+		boost::split(geneSequences, trimmedRequest, boost::is_any_of(" \t"), boost::token_compress_on);
+
+	for (string const& genes: geneSequences)
+		for (char gene: genes)
+			if (OptimiserSuite::stepAbbreviationToNameMap().count(gene) == 0)
+				return "error: Invalid optimisation step abbreviation '" + string(1, gene) + "' in chromosome '" + genes + "'.";
+
+	if (!geneSequences.empty())
+		cacheStartRound(++m_round);
+
+	vector<size_t> fitness(geneSequences.size());
+	ThreadPool::instance().parallelFor(geneSequences.size(), [&](size_t _index) {
+		fitness[_index] = m_fitnessMetric->evaluate(Chromosome(geneSequences[_index]));
+	});
+
+	vector<string> response;
+	for (size_t value: fitness)
+		response.push_back(to_string(value));
+	return boost::join(response, " ");
+}
+
+void FitnessWorker::cacheStartRound(size_t _roundNumber)
+{
+	for (auto& cache: m_programCaches)
+		if (cache != nullptr)
+			cache->startRound(_roundNumber);
+}
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Contains the implementation of a class that evaluates chromosomes on behalf of another process.
+ */
+
+#pragma once
+
+#include <tools/yulPhaser/FitnessMetrics.h>
+#include <tools/yulPhaser/ProgramCache.h>
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace solidity::phaser
+{
+
+/**
+ * Evaluates chromosomes read from a stream with a fitness metric and writes their fitness back.
+ * Allows an external coordinator to distribute the evaluation of a population among workers
+ * running on several hosts, e.g. started over ssh.
+ *
+ * The protocol is line-based. Each request is a line containing one or more chromosomes separated
+ * with spaces. The response is a line with their fitness values in the same order or a single line
+ * starting with "error:" if the request is invalid. The chromosomes of one request are evaluated in
+ * parallel and each request counts as one round for the purpose of purging the program caches.
+ * The worker stops at the end of the input.
+ */
+class FitnessWorker
+{
+public:
+	FitnessWorker(
+		std::shared_ptr<FitnessMetric> _fitnessMetric,
+		std::vector<std::shared_ptr<ProgramCache>> _programCaches,
+		std::istream& _inputStream,
+		std::ostream& _outputStream
+	):
+		m_fitnessMetric(std::move(_fitnessMetric)),
+		m_programCaches(std::move(_programCaches)),
+		m_inputStream(_inputStream),
+		m_outputStream(_outputStream) {}
+
+	void run();
+
+	/// @returns the response to a single request, without the trailing newline.
+	std::string processRequest(std::string const& _request);
+
+private:
+	void cacheStartRound(size_t _roundNumber);
+
+	std::shared_ptr<FitnessMetric> m_fitnessMetric;
+	std::vector<std::shared_ptr<ProgramCache>> m_programCaches;
+	std::istream& m_inputStream;
+	std::ostream& m_outputStream;
+	size_t m_round = 0;
+};
+
+}
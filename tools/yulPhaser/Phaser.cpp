@@ -22,6 +22,7 @@
 #include <tools/yulPhaser/Common.h>
 #include <tools/yulPhaser/Exceptions.h>
 #include <tools/yulPhaser/FitnessMetrics.h>
+#include <tools/yulPhaser/FitnessWorker.h>
 #include <tools/yulPhaser/GeneticAlgorithms.h>
 #include <tools/yulPhaser/Program.h>
 #include <tools/yulPhaser/SimulationRNG.h>
@@ -31,9 +32,14 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 #include <liblangutil/Scanner.h>
 
+#include <libsolidity/interface/CompilationCache.h>
+#include <libsolidity/interface/Version.h>
+
 #include <libsolutil/Assertions.h>
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <iostream>
 
@@ -54,6 +60,7 @@ map<PhaserMode, string> const PhaserModeToStringMap =
 	{PhaserMode::RunAlgorithm, "run-algorithm"},
 	{PhaserMode::PrintOptimisedPrograms, "print-optimised-programs"},
 	{PhaserMode::PrintOptimisedASTs, "print-optimised-asts"},
+	{PhaserMode::EvaluateFitness, "evaluate-fitness"},
 };
 map<string, PhaserMode> const StringToPhaserModeMap = invertMap(PhaserModeToStringMap);
 
@@ -69,6 +76,7 @@ map<MetricChoice, string> MetricChoiceToStringMap =
 {
 	{MetricChoice::CodeSize, "code-size"},
 	{MetricChoice::RelativeCodeSize, "relative-code-size"},
+	{MetricChoice::Gas, "gas"},
 };
 map<string, MetricChoice> const StringToMetricChoiceMap = invertMap(MetricChoiceToStringMap);
 
@@ -219,6 +227,7 @@ FitnessMetricFactory::Options FitnessMetricFactory::Options::fromCommandLine(po:
 		_arguments["metric-aggregator"].as<MetricAggregatorChoice>(),
 		_arguments["relative-metric-scale"].as<size_t>(),
 		_arguments["chromosome-repetitions"].as<size_t>(),
+		_arguments["expected-executions"].as<size_t>(),
 	};
 }
 
@@ -226,12 +235,18 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 	Options const& _options,
 	vector<Program> _programs,
 	vector<shared_ptr<ProgramCache>> _programCaches,
-	CodeWeights const& _weights
+	CodeWeights const& _weights,
+	shared_ptr<frontend::CompilationCache> _evaluationDatabase
 )
 {
 	assert(_programCaches.size() == _programs.size());
 	assert(_programs.size() > 0 && "Validations should prevent this from being executed with zero files.");
 
+	vector<string> metricKeys;
+	if (_evaluationDatabase)
+		for (Program const& program: _programs)
+			metricKeys.push_back(metricKey(_options, program, _weights));
+
 	vector<shared_ptr<FitnessMetric>> metrics;
 	switch (_options.metric)
 	{
@@ -259,10 +274,26 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 				));
 			break;
 		}
+		case MetricChoice::Gas:
+		{
+			for (size_t i = 0; i < _programs.size(); ++i)
+				metrics.push_back(make_unique<ProgramGas>(
+					_programCaches[i] != nullptr ? optional<Program>{} : std::move(_programs[i]),
+					std::move(_programCaches[i]),
+					_options.expectedExecutions,
+					_weights,
+					_options.chromosomeRepetitions
+				));
+			break;
+		}
 		default:
 			assertThrow(false, solidity::util::Exception, "Invalid MetricChoice value.");
 	}
 
+	if (_evaluationDatabase)
+		for (size_t i = 0; i < metrics.size(); ++i)
+			metrics[i] = make_shared<StoredFitnessMetric>(std::move(metrics[i]), _evaluationDatabase, std::move(metricKeys[i]));
+
 	switch (_options.metricAggregator)
 	{
 		case MetricAggregatorChoice::Average:
@@ -281,6 +312,45 @@ unique_ptr<FitnessMetric> FitnessMetricFactory::build(
 	util::unreachable();
 }
 
+string FitnessMetricFactory::metricKey(
+	Options const& _options,
+	Program const& _program,
+	CodeWeights const& _weights
+)
+{
+	// The optimiser steps change between compiler versions, so their results depend on the version too.
+	string key =
+		"compiler: " + frontend::VersionString + "\n" +
+		"metric: " + toString(_options.metric) + "\n" +
+		"chromosome-repetitions: " + to_string(_options.chromosomeRepetitions) + "\n";
+	if (_options.metric == MetricChoice::RelativeCodeSize)
+		key += "relative-metric-scale: " + to_string(_options.relativeMetricScale) + "\n";
+	if (_options.metric == MetricChoice::Gas)
+		key += "expected-executions: " + to_string(_options.expectedExecutions) + "\n";
+	key += "weights:";
+	for (size_t weight: {
+		_weights.expressionStatementCost,
+		_weights.assignmentCost,
+		_weights.variableDeclarationCost,
+		_weights.functionDefinitionCost,
+		_weights.ifCost,
+		_weights.switchCost,
+		_weights.caseCost,
+		_weights.forLoopCost,
+		_weights.breakCost,
+		_weights.continueCost,
+		_weights.leaveCost,
+		_weights.blockCost,
+		_weights.functionCallCost,
+		_weights.identifierCost,
+		_weights.literalCost,
+		_weights.literalZeroCost,
+	})
+		key += " " + to_string(weight);
+	key += "\nprogram: " + keccak256(toString(_program)).hex();
+	return key;
+}
+
 PopulationFactory::Options PopulationFactory::Options::fromCommandLine(po::variables_map const& _arguments)
 {
 	return {
@@ -361,6 +431,9 @@ ProgramCacheFactory::Options ProgramCacheFactory::Options::fromCommandLine(po::v
 {
 	return {
 		_arguments["program-cache"].as<bool>(),
+		_arguments.count("max-program-cache-size") > 0 ?
+			static_cast<optional<size_t>>(_arguments["max-program-cache-size"].as<size_t>()) :
+			nullopt,
 	};
 }
 
@@ -371,7 +444,11 @@ vector<shared_ptr<ProgramCache>> ProgramCacheFactory::build(
 {
 	vector<shared_ptr<ProgramCache>> programCaches;
 	for (Program& program: _programs)
-		programCaches.push_back(_options.programCacheEnabled ? make_shared<ProgramCache>(std::move(program)) : nullptr);
+		programCaches.push_back(
+			_options.programCacheEnabled ?
+			make_shared<ProgramCache>(std::move(program), _options.maxTotalCodeSize) :
+			nullptr
+		);
 
 	return programCaches;
 }
@@ -421,6 +498,7 @@ void Phaser::main(int _argc, char** _argv)
 		return;
 
 	initialiseRNG(arguments.value());
+	ThreadPool::instance().setMaxThreads(arguments.value()["threads"].as<size_t>());
 
 	runPhaser(arguments.value());
 }
@@ -466,17 +544,27 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<NUM>"),
 			"The number of rounds after which the algorithm should stop. (default=no limit)."
 		)
+		(
+			"threads",
+			po::value<size_t>()->value_name("<NUM>")->default_value(1),
+			"The number of threads used to evaluate the fitness of the individuals of a population in parallel. "
+			"The results do not depend on the number of threads."
+		)
 		(
 			"mode",
 			po::value<PhaserMode>()->value_name("<NAME>")->default_value(PhaserMode::RunAlgorithm),
 			(
 				"Mode of operation. The default is to run the algorithm but you can also tell phaser "
 				"to do something else with its parameters, e.g. just print the optimised programs and exit.\n"
+				"In the " + toString(PhaserMode::EvaluateFitness) + " mode phaser reads lines of space-separated "
+				"chromosomes from the standard input and for each line prints the fitness of the chromosomes "
+				"on the given programs. This allows distributing the evaluation among several hosts.\n"
 				"\n"
 				"AVAILABLE MODES:\n"
 				"* " + toString(PhaserMode::RunAlgorithm) + "\n" +
 				"* " + toString(PhaserMode::PrintOptimisedPrograms) + "\n" +
-				"* " + toString(PhaserMode::PrintOptimisedASTs)
+				"* " + toString(PhaserMode::PrintOptimisedASTs) + "\n" +
+				"* " + toString(PhaserMode::EvaluateFitness)
 			).c_str()
 		)
 	;
@@ -648,7 +736,8 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 				"\n"
 				"AVAILABLE METRICS:\n"
 				"* " + toString(MetricChoice::CodeSize) + "\n" +
-				"* " + toString(MetricChoice::RelativeCodeSize)
+				"* " + toString(MetricChoice::RelativeCodeSize) + "\n" +
+				"* " + toString(MetricChoice::Gas)
 			).c_str()
 		)
 		(
@@ -682,6 +771,15 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::value<size_t>()->value_name("<COUNT>")->default_value(1),
 			"Number of times to repeat the sequence optimisation steps represented by a chromosome."
 		)
+		(
+			"expected-executions",
+			po::value<size_t>()->value_name("<COUNT>")->default_value(200),
+			(
+				"Number of times the code is expected to run after deployment. "
+				"Used by the " + toString(MetricChoice::Gas) + " metric to weigh the execution costs "
+				"against the deployment costs, which depend on the code size."
+			).c_str()
+		)
 	;
 	keywordDescription.add(metricsDescription);
 
@@ -714,8 +812,25 @@ Phaser::CommandLineDescription Phaser::buildCommandLineDescription()
 			po::bool_switch(),
 			"Enables caching of intermediate programs corresponding to chromosome prefixes.\n"
 			"This speeds up fitness evaluation by a lot but eats tons of memory if the chromosomes are long. "
-			"Disabled by default since there's currently no way to set an upper limit on memory usage but "
-			"highly recommended if your computer has enough RAM."
+			"Disabled by default but highly recommended if your computer has enough RAM or "
+			"if used together with --max-program-cache-size."
+		)
+		(
+			"max-program-cache-size",
+			po::value<size_t>()->value_name("<SIZE>"),
+			"Upper limit on the total size of the code stored in the cache of each program. "
+			"The size is the number of AST nodes, which is roughly proportional to the memory they use. "
+			"When the limit is exceeded, the least recently used programs are evicted. "
+			"No limit by default."
+		)
+		(
+			"evaluation-database",
+			po::value<string>()->value_name("<DIRECTORY>"),
+			"Directory in which the fitness of every evaluated chromosome is stored, separately for each "
+			"input program. Runs using the same directory, e.g. resumed runs or repeated campaigns over "
+			"the same programs, take the values from there instead of evaluating the chromosomes again. "
+			"The values depend on the metric, its options and weights, the program and the compiler "
+			"version, so a changed setting only causes the affected values to be computed again."
 		)
 	;
 	keywordDescription.add(cacheDescription);
@@ -817,12 +932,25 @@ void Phaser::runPhaser(po::variables_map const& _arguments)
 	vector<Program> programs = ProgramFactory::build(programOptions);
 	vector<shared_ptr<ProgramCache>> programCaches = ProgramCacheFactory::build(cacheOptions, programs);
 	CodeWeights codeWeights = CodeWeightFactory::buildFromCommandLine(_arguments);
+	shared_ptr<frontend::CompilationCache> evaluationDatabase;
+	if (_arguments.count("evaluation-database") > 0)
+		evaluationDatabase = make_shared<frontend::FileSystemCompilationCache>(
+			_arguments["evaluation-database"].as<string>()
+		);
 	unique_ptr<FitnessMetric> fitnessMetric = FitnessMetricFactory::build(
 		metricOptions,
 		programs,
 		programCaches,
-		codeWeights
+		codeWeights,
+		std::move(evaluationDatabase)
 	);
+
+	if (_arguments["mode"].as<PhaserMode>() == PhaserMode::EvaluateFitness)
+	{
+		FitnessWorker(std::move(fitnessMetric), std::move(programCaches), cin, cout).run();
+		return;
+	}
+
 	Population population = PopulationFactory::build(populationOptions, std::move(fitnessMetric));
 
 	if (_arguments["mode"].as<PhaserMode>() == PhaserMode::RunAlgorithm)
@@ -49,6 +49,13 @@ struct CodeWeights;
 
 }
 
+namespace solidity::frontend
+{
+
+class CompilationCache;
+
+}
+
 namespace solidity::phaser
 {
 
@@ -63,6 +70,7 @@ enum class PhaserMode
 	RunAlgorithm,
 	PrintOptimisedPrograms,
 	PrintOptimisedASTs,
+	EvaluateFitness,
 };
 
 enum class Algorithm
@@ -76,6 +84,7 @@ enum class MetricChoice
 {
 	CodeSize,
 	RelativeCodeSize,
+	Gas,
 };
 
 enum class MetricAggregatorChoice
@@ -158,14 +167,26 @@ public:
 		MetricAggregatorChoice metricAggregator;
 		size_t relativeMetricScale;
 		size_t chromosomeRepetitions;
+		size_t expectedExecutions = 200;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
 
+	/// @param _evaluationDatabase if not null, the values of the metric of each program are
+	/// stored in it and reused by later runs (see @a StoredFitnessMetric).
 	static std::unique_ptr<FitnessMetric> build(
 		Options const& _options,
 		std::vector<Program> _programs,
 		std::vector<std::shared_ptr<ProgramCache>> _programCaches,
+		yul::CodeWeights const& _weights,
+		std::shared_ptr<frontend::CompilationCache> _evaluationDatabase = nullptr
+	);
+
+	/// @returns a description of everything the values of the metric built for @a _program
+	/// depend on, used to address them in the evaluation database.
+	static std::string metricKey(
+		Options const& _options,
+		Program const& _program,
 		yul::CodeWeights const& _weights
 	);
 };
@@ -216,6 +237,7 @@ public:
 	struct Options
 	{
 		bool programCacheEnabled;
+		std::optional<size_t> maxTotalCodeSize = std::nullopt;
 
 		static Options fromCommandLine(boost::program_options::variables_map const& _arguments);
 	};
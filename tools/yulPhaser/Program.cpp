@@ -31,6 +31,8 @@
 #include <libyul/ObjectParser.h>
 #include <libyul/YulString.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
 #include <libyul/optimiser/FunctionGrouper.h>
@@ -60,6 +62,121 @@ ostream& operator<<(ostream& _stream, Program const& _program);
 
 }
 
+namespace
+{
+
+/**
+ * Static estimate of the gas needed to deploy a program and to execute every statement in it once.
+ * Costs of the EVM instructions come from @a GasMeterVisitor. Control flow and calls to user-defined
+ * functions are approximated with the jumps that the code transform generates for them.
+ */
+class ProgramGasMeter: public ASTWalker
+{
+public:
+	explicit ProgramGasMeter(EVMDialect const& _dialect): m_dialect(_dialect) {}
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override { add(GasMeterVisitor::costs(Expression{_literal}, m_dialect, false)); }
+	void operator()(Identifier const& _identifier) override { add(GasMeterVisitor::costs(Expression{_identifier}, m_dialect, false)); }
+
+	void operator()(FunctionCall const& _functionCall) override
+	{
+		BuiltinFunctionForEVM const* builtin = m_dialect.builtin(_functionCall.functionName.name);
+		for (size_t i = _functionCall.arguments.size(); i > 0; --i)
+			if (!builtin || !builtin->literalArgument(i - 1).has_value())
+				visit(_functionCall.arguments[i - 1]);
+
+		if (builtin && builtin->instruction)
+			addInstruction(*builtin->instruction);
+		else if (builtin)
+			// Builtins without an instruction (datasize(), loadimmutable() etc.) mostly compile to a push.
+			addInstruction(evmasm::Instruction::PUSH1);
+		else
+			// Push of the return label, push of the target, jump there and jump back.
+			addInstructions({
+				evmasm::Instruction::PUSH1,
+				evmasm::Instruction::PUSH1,
+				evmasm::Instruction::JUMP,
+				evmasm::Instruction::JUMPDEST,
+				evmasm::Instruction::JUMP,
+				evmasm::Instruction::JUMPDEST,
+			});
+	}
+
+	void operator()(Assignment const& _assignment) override
+	{
+		ASTWalker::operator()(_assignment);
+		for (size_t i = 0; i < _assignment.variableNames.size(); ++i)
+			addInstructions({evmasm::Instruction::SWAP1, evmasm::Instruction::POP});
+	}
+
+	void operator()(If const& _if) override
+	{
+		ASTWalker::operator()(_if);
+		addInstructions({
+			evmasm::Instruction::ISZERO,
+			evmasm::Instruction::PUSH1,
+			evmasm::Instruction::JUMPI,
+			evmasm::Instruction::JUMPDEST,
+		});
+	}
+
+	void operator()(Switch const& _switch) override
+	{
+		ASTWalker::operator()(_switch);
+		for (size_t i = 0; i < _switch.cases.size(); ++i)
+			addInstructions({
+				evmasm::Instruction::DUP1,
+				evmasm::Instruction::PUSH1,
+				evmasm::Instruction::EQ,
+				evmasm::Instruction::PUSH1,
+				evmasm::Instruction::JUMPI,
+				evmasm::Instruction::JUMPDEST,
+			});
+		addInstruction(evmasm::Instruction::POP);
+	}
+
+	void operator()(ForLoop const& _forLoop) override
+	{
+		ASTWalker::operator()(_forLoop);
+		addInstructions({
+			evmasm::Instruction::JUMPDEST,
+			evmasm::Instruction::ISZERO,
+			evmasm::Instruction::PUSH1,
+			evmasm::Instruction::JUMPI,
+			evmasm::Instruction::PUSH1,
+			evmasm::Instruction::JUMP,
+			evmasm::Instruction::JUMPDEST,
+		});
+	}
+
+	/// @returns the costs of running the code once and the costs of deploying it.
+	pair<bigint, bigint> costs() const { return {m_runGas, m_dataGas}; }
+
+private:
+	void add(pair<bigint, bigint> const& _costs)
+	{
+		m_runGas += _costs.first;
+		m_dataGas += _costs.second;
+	}
+	void addInstruction(evmasm::Instruction _instruction)
+	{
+		add(GasMeterVisitor::instructionCosts(_instruction, m_dialect));
+	}
+	void addInstructions(vector<evmasm::Instruction> const& _instructions)
+	{
+		for (evmasm::Instruction instruction: _instructions)
+			addInstruction(instruction);
+	}
+
+	EVMDialect const& m_dialect;
+	bigint m_runGas = 0;
+	bigint m_dataGas = 0;
+};
+
+}
+
 Program::Program(Program const& program):
 	m_ast(make_unique<Block>(get<Block>(ASTCopier{}(*program.m_ast)))),
 	m_dialect{program.m_dialect},
@@ -210,3 +327,14 @@ size_t Program::computeCodeSize(Block const& _ast, CodeWeights const& _weights)
 {
 	return CodeSize::codeSizeIncludingFunctions(_ast, _weights);
 }
+
+size_t Program::computeGasCost(Dialect const& _dialect, Block const& _ast, size_t _expectedExecutions)
+{
+	auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
+	assert(evmDialect && "Gas costs can only be computed for EVM programs.");
+
+	ProgramGasMeter gasMeter(*evmDialect);
+	gasMeter(_ast);
+	auto [runGas, dataGas] = gasMeter.costs();
+	return static_cast<size_t>(runGas * _expectedExecutions + dataGas);
+}
@@ -76,6 +76,9 @@ public:
 	void optimise(std::vector<std::string> const& _optimisationSteps);
 
 	size_t codeSize(yul::CodeWeights const& _weights) const { return computeCodeSize(*m_ast, _weights); }
+	/// @returns a static estimate of the gas needed to deploy the program and to run it
+	/// @a _expectedExecutions times, assuming that every statement is executed once per run.
+	size_t gasCost(size_t _expectedExecutions) const { return computeGasCost(m_dialect, *m_ast, _expectedExecutions); }
 	yul::Block const& ast() const { return *m_ast; }
 
 	friend std::ostream& operator<<(std::ostream& _stream, Program const& _program);
@@ -111,6 +114,7 @@ private:
 		std::vector<std::string> const& _optimisationSteps
 	);
 	static size_t computeCodeSize(yul::Block const& _ast, yul::CodeWeights const& _weights);
+	static size_t computeGasCost(yul::Dialect const& _dialect, yul::Block const& _ast, size_t _expectedExecutions);
 
 	std::unique_ptr<yul::Block> m_ast;
 	yul::Dialect const& m_dialect;
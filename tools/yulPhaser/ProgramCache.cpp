@@ -31,6 +31,7 @@ CacheStats& CacheStats::operator+=(CacheStats const& _other)
 	hits += _other.hits;
 	misses += _other.misses;
 	totalCodeSize += _other.totalCodeSize;
+	evictions += _other.evictions;
 
 	for (auto& [round, count]: _other.roundEntryCounts)
 		if (roundEntryCounts.find(round) != roundEntryCounts.end())
@@ -47,7 +48,8 @@ bool CacheStats::operator==(CacheStats const& _other) const
 		hits == _other.hits &&
 		misses == _other.misses &&
 		totalCodeSize == _other.totalCodeSize &&
-		roundEntryCounts == _other.roundEntryCounts;
+		roundEntryCounts == _other.roundEntryCounts &&
+		evictions == _other.evictions;
 }
 
 Program ProgramCache::optimiseProgram(
@@ -60,31 +62,45 @@ Program ProgramCache::optimiseProgram(
 		targetOptimisations += _abbreviatedOptimisationSteps;
 
 	size_t prefixSize = 0;
-	for (size_t i = 1; i <= targetOptimisations.size(); ++i)
-	{
-		auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
-		if (pair != m_entries.end())
+	Program intermediateProgram = [&]() {
+		lock_guard lock(m_mutex);
+		// Shorter prefixes may have been evicted while longer ones are still cached.
+		for (size_t i = targetOptimisations.size(); i >= 1 && prefixSize == 0; --i)
+			if (m_entries.count(targetOptimisations.substr(0, i)) > 0)
+				prefixSize = i;
+
+		for (size_t i = 1; i <= prefixSize; ++i)
 		{
-			pair->second.roundNumber = m_currentRound;
-			++prefixSize;
-			++m_hits;
+			auto const& pair = m_entries.find(targetOptimisations.substr(0, i));
+			if (pair != m_entries.end())
+			{
+				pair->second.roundNumber = m_currentRound;
+				touch(pair);
+				++m_hits;
+			}
 		}
-		else
-			break;
-	}
 
-	Program intermediateProgram = (
-		prefixSize == 0 ?
-		m_program :
-		m_entries.at(targetOptimisations.substr(0, prefixSize)).program
-	);
+		return (
+			prefixSize == 0 ?
+			m_program :
+			m_entries.at(targetOptimisations.substr(0, prefixSize)).program
+		);
+	}();
 
 	for (size_t i = prefixSize + 1; i <= targetOptimisations.size(); ++i)
 	{
 		string stepName = OptimiserSuite::stepAbbreviationToNameMap().at(targetOptimisations[i - 1]);
 		intermediateProgram.optimise({stepName});
 
-		m_entries.insert({targetOptimisations.substr(0, i), {intermediateProgram, m_currentRound}});
+		CacheEntry entry{intermediateProgram, m_currentRound};
+		lock_guard lock(m_mutex);
+		auto [pair, inserted] = m_entries.emplace(targetOptimisations.substr(0, i), std::move(entry));
+		if (inserted)
+		{
+			m_totalCodeSize += pair->second.codeSize;
+			touch(pair);
+			evictIfOverLimit();
+		}
 		++m_misses;
 	}
 
@@ -101,7 +117,7 @@ void ProgramCache::startRound(size_t _roundNumber)
 		assert(pair->second.roundNumber < m_currentRound);
 
 		if (pair->second.roundNumber < m_currentRound - 1)
-			m_entries.erase(pair++);
+			erase(pair++);
 		else
 			++pair;
 	}
@@ -110,6 +126,8 @@ void ProgramCache::startRound(size_t _roundNumber)
 void ProgramCache::clear()
 {
 	m_entries.clear();
+	m_keysByLastUse.clear();
+	m_totalCodeSize = 0;
 	m_currentRound = 0;
 }
 
@@ -127,20 +145,12 @@ CacheStats ProgramCache::gatherStats() const
 	return {
 		/* hits = */ m_hits,
 		/* misses = */ m_misses,
-		/* totalCodeSize = */ calculateTotalCachedCodeSize(),
+		/* totalCodeSize = */ m_totalCodeSize,
 		/* roundEntryCounts = */ countRoundEntries(),
+		/* evictions = */ m_evictions,
 	};
 }
 
-size_t ProgramCache::calculateTotalCachedCodeSize() const
-{
-	size_t size = 0;
-	for (auto const& pair: m_entries)
-		size += pair.second.program.codeSize(CacheStats::StorageWeights);
-
-	return size;
-}
-
 map<size_t, size_t> ProgramCache::countRoundEntries() const
 {
 	map<size_t, size_t> counts;
@@ -152,3 +162,29 @@ map<size_t, size_t> ProgramCache::countRoundEntries() const
 
 	return counts;
 }
+
+void ProgramCache::touch(map<string, CacheEntry>::iterator _entry)
+{
+	m_keysByLastUse.erase(_entry->second.lastUse);
+	_entry->second.lastUse = ++m_useCounter;
+	m_keysByLastUse.emplace(_entry->second.lastUse, _entry->first);
+}
+
+void ProgramCache::erase(map<string, CacheEntry>::iterator _entry)
+{
+	m_keysByLastUse.erase(_entry->second.lastUse);
+	m_totalCodeSize -= _entry->second.codeSize;
+	m_entries.erase(_entry);
+}
+
+void ProgramCache::evictIfOverLimit()
+{
+	if (!m_maxTotalCodeSize.has_value())
+		return;
+
+	while (m_totalCodeSize > m_maxTotalCodeSize.value() && !m_keysByLastUse.empty())
+	{
+		erase(m_entries.find(m_keysByLastUse.begin()->second));
+		++m_evictions;
+	}
+}
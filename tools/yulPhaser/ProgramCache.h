@@ -24,25 +24,13 @@
 
 #include <cstddef>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 
 namespace solidity::phaser
 {
 
-/**
- * Structure used by @a ProgramCache to store intermediate programs and metadata associated
- * with them.
- */
-struct CacheEntry
-{
-	Program program;
-	size_t roundNumber;
-
-	CacheEntry(Program _program, size_t _roundNumber):
-		program(std::move(_program)),
-		roundNumber(_roundNumber) {}
-};
-
 /**
  * Stores statistics about current cache usage.
  */
@@ -75,6 +63,7 @@ struct CacheStats
 	size_t misses;
 	size_t totalCodeSize;
 	std::map<size_t, size_t> roundEntryCounts;
+	size_t evictions = 0;
 
 	CacheStats& operator+=(CacheStats const& _other);
 	CacheStats operator+(CacheStats const& _other) const { return CacheStats(*this) += _other; }
@@ -83,6 +72,25 @@ struct CacheStats
 	bool operator!=(CacheStats const& _other) const { return !(*this == _other); }
 };
 
+/**
+ * Structure used by @a ProgramCache to store intermediate programs and metadata associated
+ * with them.
+ */
+struct CacheEntry
+{
+	Program program;
+	size_t roundNumber;
+	/// Size of the program measured with @a CacheStats::StorageWeights.
+	size_t codeSize;
+	/// Value of the cache's use counter the last time the entry was stored or reused.
+	size_t lastUse = 0;
+
+	CacheEntry(Program _program, size_t _roundNumber):
+		program(std::move(_program)),
+		roundNumber(_roundNumber),
+		codeSize(program.codeSize(CacheStats::StorageWeights)) {}
+};
+
 /**
  * Class that optimises programs one step at a time which allows it to store and later reuse the
  * results of the intermediate steps.
@@ -99,15 +107,22 @@ struct CacheStats
  * experiments) but there's room for improvement. We could fit more useful programs in
  * the cache by being more picky about which ones we choose.
  *
- * There is currently no way to purge entries without starting a new round. Since the programs
- * take a lot of memory, this may lead to the cache eating up all the available RAM if sequences are
- * long and programs large. A limiter based on entry count or total program size would be useful.
+ * Since the programs take a lot of memory, the cache can be given an upper limit on the total size
+ * of the cached code, measured with @a CacheStats::StorageWeights. When a new entry makes the cache
+ * exceed it, the least recently used entries are evicted until it fits again. Without a limit the
+ * cache may eat up all the available RAM within a round if sequences are long and programs large.
+ * An evicted prefix does not make its longer cached extensions unreachable.
+ *
+ * @a optimiseProgram() can be called from several threads at once. The other members must not be
+ * called while it runs. The optimisation steps are applied without holding the lock, so two threads
+ * may compute the same entry. The results are identical, so this only affects the hit and miss counts.
  */
 class ProgramCache
 {
 public:
-	explicit ProgramCache(Program _program):
-		m_program(std::move(_program)) {}
+	explicit ProgramCache(Program _program, std::optional<size_t> _maxTotalCodeSize = std::nullopt):
+		m_program(std::move(_program)),
+		m_maxTotalCodeSize(_maxTotalCodeSize) {}
 
 	Program optimiseProgram(
 		std::string const& _abbreviatedOptimisationSteps,
@@ -125,20 +140,37 @@ public:
 	std::map<std::string, CacheEntry> const& entries() const { return m_entries; }
 	Program const& program() const { return m_program; }
 	size_t currentRound() const { return m_currentRound; }
+	std::optional<size_t> maxTotalCodeSize() const { return m_maxTotalCodeSize; }
 
 private:
-	size_t calculateTotalCachedCodeSize() const;
 	std::map<size_t, size_t> countRoundEntries() const;
 
+	/// Marks the entry as the most recently used one. Requires @a m_mutex to be held.
+	void touch(std::map<std::string, CacheEntry>::iterator _entry);
+	/// Removes the entry and its bookkeeping. Requires @a m_mutex to be held.
+	void erase(std::map<std::string, CacheEntry>::iterator _entry);
+	/// Evicts least recently used entries until the cache fits within @a m_maxTotalCodeSize.
+	/// Requires @a m_mutex to be held.
+	void evictIfOverLimit();
+
 	// The best matching data structure here would be a trie of chromosome prefixes but since
 	// the programs are orders of magnitude larger than the prefixes, it does not really matter.
 	// A map should be good enough.
 	std::map<std::string, CacheEntry> m_entries;
 
+	/// Keys of all the entries, ordered by @a CacheEntry::lastUse.
+	std::map<size_t, std::string> m_keysByLastUse;
+
 	Program m_program;
+	std::optional<size_t> m_maxTotalCodeSize;
+	size_t m_totalCodeSize = 0;
 	size_t m_currentRound = 0;
+	size_t m_useCounter = 0;
 	size_t m_hits = 0;
 	size_t m_misses = 0;
+	size_t m_evictions = 0;
+	/// Guards the entries and the counters in @a optimiseProgram().
+	std::mutex m_mutex;
 };
 
 }